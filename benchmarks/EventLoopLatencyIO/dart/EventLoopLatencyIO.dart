@@ -0,0 +1,228 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Measures the tail latency of request-response exchanges with dart:io
+// servers over loopback, so that changes to the event handler and to the
+// socket read and write paths can be judged by their effect on the slowest
+// requests and not only on averages.
+//
+// The servers run in the main isolate. Load is generated by client isolates
+// (4 by default, or the optional first argument), each of which keeps its
+// connections (100 by default, or the optional second argument) busy with one
+// outstanding request per connection. Note that every connection uses two
+// file descriptors, which can exceed the default limit of open files. For
+// every protocol reported are:
+//
+//   EventLoopLatencyIO_<Protocol>(RunTimeRaw): wall time for all requests.
+//   EventLoopLatencyIO_<Protocol>.Percentile50(RunTimeRaw): and likewise
+//       Percentile99, Percentile999 and Max of the request latencies.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+const int messageSize = 64;
+const int requestsPerConnection = 200;
+
+abstract class Protocol {
+  String get name;
+
+  // Starts the server and returns its port.
+  Future<int> start();
+  Future<void> stop();
+
+  // Runs [requests] requests on a new connection to [port] and records their
+  // latencies. Runs in a client isolate.
+  Future<void> runConnection(int port, int requests, Latencies latencies);
+}
+
+// Echoes every message back on the same connection.
+class Tcp extends Protocol {
+  @override
+  String get name => 'Tcp';
+
+  ServerSocket? server;
+
+  @override
+  Future<int> start() async {
+    final server = this.server =
+        await ServerSocket.bind(InternetAddress.loopbackIPv4, 0, backlog: 1024);
+    server.listen((socket) {
+      socket.setOption(SocketOption.tcpNoDelay, true);
+      socket.listen(socket.add, onDone: socket.destroy);
+    });
+    return server.port;
+  }
+
+  @override
+  Future<void> stop() => server!.close();
+
+  @override
+  Future<void> runConnection(
+      int port, int requests, Latencies latencies) async {
+    final socket = await Socket.connect(InternetAddress.loopbackIPv4, port);
+    socket.setOption(SocketOption.tcpNoDelay, true);
+    final request = Uint8List(messageSize);
+    int pending = 0;
+    Completer<void>? reply;
+    final subscription = socket.listen((data) {
+      pending -= data.length;
+      if (pending == 0) reply!.complete();
+    });
+    for (int i = 0; i < requests; i++) {
+      reply = Completer<void>();
+      pending = messageSize;
+      final start = latencies.now;
+      socket.add(request);
+      await reply.future;
+      latencies.add(latencies.now - start);
+    }
+    await subscription.cancel();
+    socket.destroy();
+  }
+}
+
+// Serves a small response to every request over persistent connections.
+class Http extends Protocol {
+  @override
+  String get name => 'Http';
+
+  HttpServer? server;
+  static final body = Uint8List(messageSize);
+
+  @override
+  Future<int> start() async {
+    final server = this.server =
+        await HttpServer.bind(InternetAddress.loopbackIPv4, 0, backlog: 1024);
+    server.listen((request) {
+      request.response
+        ..contentLength = body.length
+        ..add(body);
+      unawaited(request.response.close());
+    });
+    return server.port;
+  }
+
+  @override
+  Future<void> stop() => server!.close(force: true);
+
+  @override
+  Future<void> runConnection(
+      int port, int requests, Latencies latencies) async {
+    // A client per connection, so every connection is kept alive by its own
+    // request loop.
+    final client = HttpClient()..maxConnectionsPerHost = 1;
+    final uri = Uri.http('${InternetAddress.loopbackIPv4.address}:$port', '/');
+    for (int i = 0; i < requests; i++) {
+      final start = latencies.now;
+      final request = await client.getUrl(uri);
+      final response = await request.close();
+      await response.drain<void>();
+      latencies.add(latencies.now - start);
+    }
+    client.close(force: true);
+  }
+}
+
+final protocols = <Protocol>[Tcp(), Http()];
+
+// Request latencies in microseconds.
+class Latencies {
+  final Uint64List values;
+  final Stopwatch watch = Stopwatch()..start();
+  int length = 0;
+
+  Latencies(int capacity) : values = Uint64List(capacity);
+
+  int get now => watch.elapsedMicroseconds;
+
+  void add(int latency) => values[length++] = latency;
+}
+
+class ClientArgs {
+  final int protocol;
+  final int port;
+  final int connections;
+  final int requests;
+  final SendPort replyPort;
+
+  ClientArgs(this.protocol, this.port, this.connections, this.requests,
+      this.replyPort);
+}
+
+// Waits for the start signal, runs all connections concurrently and replies
+// with the latencies of their requests.
+Future<void> client(ClientArgs args) async {
+  final startPort = ReceivePort();
+  args.replyPort.send(startPort.sendPort);
+  await startPort.first;
+
+  final protocol = protocols[args.protocol];
+  final latencies = Latencies(args.connections * args.requests);
+  await Future.wait([
+    for (int i = 0; i < args.connections; i++)
+      protocol.runConnection(args.port, args.requests, latencies),
+  ]);
+  args.replyPort.send(latencies.values);
+}
+
+int percentile(Uint64List sorted, int perMille) =>
+    sorted[perMille * sorted.length ~/ 1000];
+
+// Runs [clients] client isolates with [connections] connections each against
+// the server of [protocol] and reports the request latencies.
+Future<void> runProtocol(int protocol, int clients, int connections,
+    int requests, {bool report = true}) async {
+  final port = await protocols[protocol].start();
+  final replies = ReceivePort();
+  final inbox = StreamIterator<dynamic>(replies);
+  for (int i = 0; i < clients; i++) {
+    await Isolate.spawn(client,
+        ClientArgs(protocol, port, connections, requests, replies.sendPort));
+  }
+  final startPorts = <SendPort>[];
+  for (int i = 0; i < clients; i++) {
+    await inbox.moveNext();
+    startPorts.add(inbox.current as SendPort);
+  }
+
+  final watch = Stopwatch()..start();
+  for (final port in startPorts) {
+    port.send(null);
+  }
+  final all = Uint64List(clients * connections * requests);
+  for (int i = 0; i < clients; i++) {
+    await inbox.moveNext();
+    final latencies = inbox.current as Uint64List;
+    all.setRange(i * latencies.length, (i + 1) * latencies.length, latencies);
+  }
+  final elapsed = watch.elapsedMicroseconds;
+  await inbox.cancel();
+  await protocols[protocol].stop();
+
+  if (report) {
+    all.sort();
+    final name = 'EventLoopLatencyIO_${protocols[protocol].name}';
+    print('$name(RunTimeRaw): $elapsed us.');
+    print('$name.Percentile50(RunTimeRaw): ${percentile(all, 500)} us.');
+    print('$name.Percentile99(RunTimeRaw): ${percentile(all, 990)} us.');
+    print('$name.Percentile999(RunTimeRaw): ${percentile(all, 999)} us.');
+    print('$name.Max(RunTimeRaw): ${all.last} us.');
+  }
+}
+
+Future<void> main(List<String> args) async {
+  final clients = args.isEmpty ? 4 : int.parse(args[0]);
+  final connections = args.length < 2 ? 100 : int.parse(args[1]);
+
+  // Warm up so the measured runs use optimized code.
+  for (int i = 0; i < protocols.length; i++) {
+    await runProtocol(i, 1, 10, requestsPerConnection, report: false);
+  }
+
+  for (int i = 0; i < protocols.length; i++) {
+    await runProtocol(i, clients, connections, requestsPerConnection);
+  }
+}
@@ -0,0 +1,222 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Measures how work in isolates of one isolate group scales with the number
+// of isolates, to make contention in the heap, the port map, the thread pool
+// and group-wide tables visible.
+//
+// For every workload and isolate count N (1, 2, 4, ... up to the optional
+// first argument, 64 by default) each of the N isolates does the same fixed
+// amount of work, so with perfect scaling the run time stays constant as
+// long as N does not exceed the number of cores. Reported are:
+//
+//   IsolateScaling_<Workload>_<N>(RunTimeRaw): wall time for all isolates.
+//   IsolateScaling_<Workload>_<N>.Stalls(RunTimeRaw): average time per
+//       isolate spent in work units that took over 1ms, which is dominated
+//       by safepoints for GC and other group-wide operations (and by
+//       preemption once N exceeds the number of cores).
+//
+// Use --timeline_streams=GC,Isolate to attribute stalls in more detail.
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:isolate';
+
+// Work units are a few to a few hundred microseconds, so any unit longer
+// than this was most likely stopped.
+const int stallThresholdUs = 1000;
+
+abstract class Workload {
+  String get name;
+
+  // The number of work units done by each isolate.
+  int get units;
+
+  // Does one unit of work. Runs in a worker isolate.
+  void runUnit(int worker, int unit);
+}
+
+// Allocates short-lived objects and keeps a window of them alive, so both
+// scavenges and old-space collections happen.
+class Allocation extends Workload {
+  String get name => 'Allocation';
+  int get units => 20000;
+
+  final retained = List<Object?>.filled(4096, null);
+
+  void runUnit(int worker, int unit) {
+    final nodes = <List<Object>>[];
+    for (int i = 0; i < 64; i++) {
+      nodes.add([i, 'node', nodes.isEmpty ? const [] : nodes.last]);
+    }
+    retained[unit % retained.length] = nodes;
+  }
+}
+
+// Creates regular expressions from new patterns, which interns the patterns
+// in the symbol table and the regular expressions in the canonical table
+// shared by the isolate group.
+class Interning extends Workload {
+  String get name => 'Interning';
+  int get units => 20000;
+
+  void runUnit(int worker, int unit) {
+    final re = RegExp('w${worker}_u${unit % 2000}_[a-z]+');
+    if (re.hasMatch('no match')) throw 'Unexpected match';
+  }
+}
+
+// Decodes a JSON document, which allocates a lot of maps, lists and strings.
+class JsonDecode extends Workload {
+  String get name => 'JsonDecode';
+  int get units => 2000;
+
+  static final String document = jsonEncode({
+    for (int i = 0; i < 50; i++)
+      'key$i': {
+        'id': i,
+        'name': 'item $i',
+        'tags': ['a', 'b', 'c'],
+        'value': i * 1.5,
+      },
+  });
+
+  void runUnit(int worker, int unit) {
+    final decoded = jsonDecode(document) as Map;
+    if (decoded.length != 50) throw 'Unexpected result';
+  }
+}
+
+final workloads = <Workload>[Allocation(), Interning(), JsonDecode()];
+
+class WorkerArgs {
+  final int workload;
+  final int worker;
+  final SendPort replyPort;
+
+  WorkerArgs(this.workload, this.worker, this.replyPort);
+}
+
+// Waits for the start signal, runs all units of the workload and replies
+// with the time spent in stalled units.
+Future<void> unitWorker(WorkerArgs args) async {
+  final startPort = ReceivePort();
+  args.replyPort.send(startPort.sendPort);
+  await startPort.first;
+
+  final workload = workloads[args.workload];
+  final watch = Stopwatch()..start();
+  int stalledUs = 0;
+  int last = 0;
+  for (int unit = 0; unit < workload.units; unit++) {
+    workload.runUnit(args.worker, unit);
+    final now = watch.elapsedMicroseconds;
+    if (now - last > stallThresholdUs) stalledUs += now - last;
+    last = now;
+  }
+  args.replyPort.send(stalledUs);
+}
+
+// Spawns [count] workers for [workload], starts them together once all are
+// running and reports their results.
+Future<void> runUnits(int workload, int count, {bool report = true}) async {
+  final replies = ReceivePort();
+  final inbox = StreamIterator<dynamic>(replies);
+  for (int i = 0; i < count; i++) {
+    await Isolate.spawn(unitWorker, WorkerArgs(workload, i, replies.sendPort));
+  }
+  final startPorts = <SendPort>[];
+  for (int i = 0; i < count; i++) {
+    await inbox.moveNext();
+    startPorts.add(inbox.current as SendPort);
+  }
+
+  final watch = Stopwatch()..start();
+  for (final port in startPorts) {
+    port.send(null);
+  }
+  int stalledUs = 0;
+  for (int i = 0; i < count; i++) {
+    await inbox.moveNext();
+    stalledUs += inbox.current as int;
+  }
+  final elapsed = watch.elapsedMicroseconds;
+  await inbox.cancel();
+
+  if (report) {
+    final name = 'IsolateScaling_${workloads[workload].name}_$count';
+    print('$name(RunTimeRaw): $elapsed us.');
+    print('$name.Stalls(RunTimeRaw): ${stalledUs ~/ count} us.');
+  }
+}
+
+const int messagesPerWorker = 2000;
+
+// Echoes every message back to the sender until it gets null.
+void echoWorker(SendPort replyPort) {
+  final port = RawReceivePort();
+  port.handler = (message) {
+    if (message == null) {
+      port.close();
+      return;
+    }
+    replyPort.send(message);
+  };
+  replyPort.send(port.sendPort);
+}
+
+// Sends messages to all workers in turn (fan-out) and receives all the
+// replies on a single port (fan-in).
+Future<void> runMessaging(int count, {bool report = true}) async {
+  final replies = ReceivePort();
+  final inbox = StreamIterator<dynamic>(replies);
+  for (int i = 0; i < count; i++) {
+    await Isolate.spawn(echoWorker, replies.sendPort);
+  }
+  final workers = <SendPort>[];
+  for (int i = 0; i < count; i++) {
+    await inbox.moveNext();
+    workers.add(inbox.current as SendPort);
+  }
+
+  final watch = Stopwatch()..start();
+  final payload = List<int>.generate(16, (i) => i);
+  for (int i = 0; i < messagesPerWorker; i++) {
+    for (final worker in workers) {
+      worker.send([i, 'message', payload]);
+    }
+  }
+  for (int i = 0; i < messagesPerWorker * count; i++) {
+    await inbox.moveNext();
+  }
+  final elapsed = watch.elapsedMicroseconds;
+  for (final worker in workers) {
+    worker.send(null);
+  }
+  await inbox.cancel();
+
+  if (report) {
+    print('IsolateScaling_Messaging_$count(RunTimeRaw): $elapsed us.');
+  }
+}
+
+Future<void> main(List<String> args) async {
+  final maxIsolates = args.isEmpty ? 64 : int.parse(args[0]);
+  final counts = <int>[for (int n = 1; n <= maxIsolates; n *= 2) n];
+
+  // Warm up so the measured runs use optimized code.
+  for (int i = 0; i < workloads.length; i++) {
+    await runUnits(i, 2, report: false);
+  }
+  await runMessaging(2, report: false);
+
+  for (int i = 0; i < workloads.length; i++) {
+    for (final count in counts) {
+      await runUnits(i, count);
+    }
+  }
+  for (final count in counts) {
+    await runMessaging(count);
+  }
+}
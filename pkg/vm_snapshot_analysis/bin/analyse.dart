@@ -9,6 +9,7 @@ import 'package:args/command_runner.dart';
 
 import 'package:vm_snapshot_analysis/src/commands/compare.dart';
 import 'package:vm_snapshot_analysis/src/commands/explain.dart';
+import 'package:vm_snapshot_analysis/src/commands/report.dart';
 import 'package:vm_snapshot_analysis/src/commands/summary.dart';
 import 'package:vm_snapshot_analysis/src/commands/treemap.dart';
 
@@ -36,7 +37,8 @@ final runner = CommandRunner(
   ..addCommand(TreemapCommand())
   ..addCommand(CompareCommand())
   ..addCommand(SummaryCommand())
-  ..addCommand(ExplainCommand());
+  ..addCommand(ExplainCommand())
+  ..addCommand(ReportCommand());
 
 void main(List<String> args) async {
   try {
@@ -160,6 +160,9 @@ class ProgramInfoNode {
 
   NodeType get type => NodeType.values[_type];
 
+  /// Name of [type] used in the JSON representation of this node.
+  String get typeName => _typeToJson(type);
+
   Map<String, dynamic> toJson() => {
         if (size != null) '#size': size,
         if (_type != NodeType.other.index) '#type': _typeToJson(type),
@@ -0,0 +1,195 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+/// Size reports break down the bytes that a V8 snapshot profile attributes to
+/// every package, library, class and function of the program by the kind of
+/// data they are (see [SizeCategory]).
+///
+/// Reports are plain JSON maps shaped like [ProgramInfo.toJson], so that CI
+/// can store them and compare them with the reports of later builds using
+/// [compareSizeReports]:
+///
+///     {
+///       '#sizes': {'instructions': ..., ..., 'total': ...},
+///       'package:foo': {
+///         '#type': 'package',
+///         '#sizes': {...},
+///         'package:foo/foo.dart': {
+///           '#type': 'library',
+///           '#sizes': {...},
+///           '#retainedBy': 'package:bar/bar.dart',
+///           ...
+///         },
+///       },
+///       ...
+///     }
+///
+/// The sizes of a node include the sizes of its children.
+library vm_snapshot_analysis.size_report;
+
+import 'package:vm_snapshot_analysis/precompiler_trace.dart';
+import 'package:vm_snapshot_analysis/program_info.dart';
+import 'package:vm_snapshot_analysis/v8_profile.dart';
+
+/// Kinds of snapshot bytes distinguished by size reports.
+enum SizeCategory {
+  /// Machine code.
+  instructions,
+
+  /// Object pools, which hold the objects and entry points used by machine
+  /// code.
+  objectPool,
+
+  /// Other objects in the read-only data section, e.g. PC descriptors, stack
+  /// maps and code source maps.
+  readOnlyData,
+
+  /// All other objects: the program structure (libraries, classes, functions,
+  /// fields, code objects) and the constants and strings it refers to.
+  metadata,
+}
+
+const _categoryNames = {
+  SizeCategory.instructions: 'instructions',
+  SizeCategory.objectPool: 'objectPool',
+  SizeCategory.readOnlyData: 'readOnlyData',
+  SizeCategory.metadata: 'metadata',
+};
+
+const _totalName = 'total';
+
+/// Returns the [SizeCategory] of the bytes of the given [node].
+SizeCategory categoryOf(Node node) {
+  switch (node.type) {
+    case '(RO) Instructions':
+    case '(RO) InstructionsSection':
+    case '(RO) Trampoline':
+      return SizeCategory.instructions;
+    case 'ObjectPool':
+      return SizeCategory.objectPool;
+  }
+  return node.type.startsWith('(RO) ')
+      ? SizeCategory.readOnlyData
+      : SizeCategory.metadata;
+}
+
+/// Builds the size report for [info], which must have been loaded from a V8
+/// snapshot profile.
+///
+/// If a [precompilerTrace] (`--trace-precompiler-to` output) is given, every
+/// library also records the library which retains it, i.e. the library
+/// through which all dependencies on it go (see
+/// [generateCallGraphWithDominators]).
+Map<String, dynamic> buildSizeReport(ProgramInfo info,
+    {Object? precompilerTrace}) {
+  final snapshotInfo = info.snapshotInfo;
+  if (snapshotInfo == null) {
+    throw ArgumentError(
+        'Size reports require a profile produced by '
+        '--write-v8-snapshot-profile-to');
+  }
+
+  // Sizes attributed to every node itself, by category.
+  final selfSizes = <int, List<int>>{};
+  for (var node in snapshotInfo.snapshot.nodes) {
+    if (node.selfSize > 0) {
+      final sizes =
+          selfSizes.putIfAbsent(snapshotInfo.ownerOf(node).id, _emptySizes);
+      sizes[categoryOf(node).index] += node.selfSize;
+    }
+  }
+
+  final retainers = <String, String>{};
+  if (precompilerTrace != null) {
+    final callGraph =
+        generateCallGraphWithDominators(precompilerTrace, NodeType.libraryNode);
+    for (var n in callGraph.nodes) {
+      final dominator = n.dominator;
+      if (n.data is ProgramInfoNode &&
+          dominator != null &&
+          dominator != callGraph.root &&
+          dominator.data is ProgramInfoNode) {
+        retainers[n.data.name] = dominator.data.qualifiedName;
+      }
+    }
+  }
+
+  // Returns the report for [node] and adds the sizes of [node], including
+  // its children, to [sizes].
+  Map<String, dynamic> nodeReport(ProgramInfoNode node, List<int> sizes) {
+    final json = <String, dynamic>{};
+    for (var child in node.children.values) {
+      final childSizes = _emptySizes();
+      final childJson = nodeReport(child, childSizes);
+      if (childSizes.any((size) => size != 0)) {
+        json[child.name] = childJson;
+      }
+      _addSizes(sizes, childSizes);
+    }
+    _addSizes(sizes, selfSizes[node.id]);
+    final retainer = retainers[node.name];
+    return {
+      if (node.type != NodeType.other) '#type': node.typeName,
+      '#sizes': _sizesToJson(sizes),
+      if (node.type == NodeType.libraryNode && retainer != null)
+        '#retainedBy': retainer,
+      ...json,
+    };
+  }
+
+  return nodeReport(info.root, _emptySizes())..remove('#type');
+}
+
+List<int> _emptySizes() => List<int>.filled(SizeCategory.values.length, 0);
+
+void _addSizes(List<int> sizes, List<int>? other) {
+  if (other != null) {
+    for (var i = 0; i < sizes.length; i++) {
+      sizes[i] += other[i];
+    }
+  }
+}
+
+Map<String, int> _sizesToJson(List<int> sizes) => {
+      for (var category in SizeCategory.values)
+        _categoryNames[category]!: sizes[category.index],
+      _totalName: sizes.fold(0, (sum, size) => sum + size),
+    };
+
+/// Compares two reports produced by [buildSizeReport] and returns a report of
+/// the same shape which only contains the nodes whose sizes changed, with
+/// the differences as sizes.
+Map<String, dynamic> compareSizeReports(
+    Map<String, dynamic> oldReport, Map<String, dynamic> newReport) {
+  Map<String, int> diffSizes(Map? oldSizes, Map? newSizes) => {
+        for (var name in [..._categoryNames.values, _totalName])
+          name: (newSizes?[name] ?? 0) - (oldSizes?[name] ?? 0) as int,
+      };
+
+  Map<String, dynamic>? diffNode(Map? oldNode, Map? newNode) {
+    final json = <String, dynamic>{};
+    for (var key in <String>{...?oldNode?.keys, ...?newNode?.keys}) {
+      if (key.startsWith('#')) {
+        continue;
+      }
+      final child = diffNode(oldNode?[key], newNode?[key]);
+      if (child != null) {
+        json[key] = child;
+      }
+    }
+    final sizes = diffSizes(oldNode?['#sizes'], newNode?['#sizes']);
+    if (json.isEmpty && sizes.values.every((size) => size == 0)) {
+      return null;
+    }
+    final type = newNode?['#type'] ?? oldNode?['#type'];
+    return {
+      if (type != null) '#type': type,
+      '#sizes': sizes,
+      ...json,
+    };
+  }
+
+  return diffNode(oldReport, newReport) ??
+      {'#sizes': diffSizes(oldReport['#sizes'], newReport['#sizes'])};
+}
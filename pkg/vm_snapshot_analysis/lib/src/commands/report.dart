@@ -0,0 +1,99 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+/// This tool generates a JSON size report from a V8 snapshot profile produced
+/// by the AOT compiler's --write-v8-snapshot-profile-to flag, or compares
+/// such reports.
+library vm_snapshot_analysis.report;
+
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:args/command_runner.dart';
+
+import 'package:vm_snapshot_analysis/size_report.dart';
+import 'package:vm_snapshot_analysis/utils.dart';
+
+import 'utils.dart';
+
+class ReportCommand extends Command<void> {
+  @override
+  final name = 'report';
+
+  @override
+  final description = '''
+Generate a JSON size report from a V8 snapshot profile.
+
+The report attributes the bytes of an AOT snapshot to packages, libraries,
+classes and functions, and breaks them down into instructions, object pool,
+read-only data and metadata. It is meant to be stored by CI: pass the report
+of an earlier build to --compare-to to only report the sizes that changed.
+
+This tool processes snapshot profiles produced by the
+--write-v8-snapshot-profile-to=profile.heapsnapshot flag.
+''';
+
+  ReportCommand() {
+    argParser
+      ..addOption('output',
+          abbr: 'o', help: 'Write the report to the given file.')
+      ..addOption('compare-to',
+          help: 'Report the differences to the given earlier report.')
+      ..addOption('precompiler-trace',
+          abbr: 't',
+          help: 'Precompiler trace to record which library retains each '
+              'library.')
+      ..addFlag('collapse-anonymous-closures',
+          help: 'Collapse all anonymous closures from the same scope into a '
+              'single entry (see compare --help).');
+  }
+
+  @override
+  String get invocation =>
+      super.invocation.replaceAll('[arguments]', '<profile.json>');
+
+  @override
+  Future<void> run() async {
+    final args = argResults!;
+
+    if (args.rest.length != 1) {
+      usageException('Need to specify input profile.');
+    }
+
+    final input = _checkExists(args.rest[0]);
+    final info = loadProgramInfoFromJson(await loadJsonFromFile(input),
+        collapseAnonymousClosures: args['collapse-anonymous-closures']);
+    if (info.snapshotInfo == null) {
+      usageException(
+          'Input must be produced by --write-v8-snapshot-profile-to.');
+    }
+
+    final traceJson = args['precompiler-trace'];
+    var report = buildSizeReport(info,
+        precompilerTrace: traceJson != null
+            ? await loadJsonFromFile(_checkExists(traceJson))
+            : null);
+
+    final baseline = args['compare-to'];
+    if (baseline != null) {
+      final oldReport = await loadJsonFromFile(_checkExists(baseline));
+      report = compareSizeReports(oldReport as Map<String, dynamic>, report);
+    }
+
+    final output = const JsonEncoder.withIndent('  ').convert(report);
+    if (args['output'] != null) {
+      await File(args['output']).writeAsString(output);
+    } else {
+      print(output);
+    }
+  }
+
+  File _checkExists(String path) {
+    final file = File(path);
+    if (!file.existsSync()) {
+      usageException('File $path does not exist!');
+    }
+    return file;
+  }
+}
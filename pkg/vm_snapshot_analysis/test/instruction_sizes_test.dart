@@ -9,6 +9,7 @@ import 'package:test/test.dart';
 import 'package:vm_snapshot_analysis/instruction_sizes.dart'
     as instruction_sizes;
 import 'package:vm_snapshot_analysis/program_info.dart';
+import 'package:vm_snapshot_analysis/size_report.dart';
 import 'package:vm_snapshot_analysis/treemap.dart';
 import 'package:vm_snapshot_analysis/utils.dart';
 import 'package:vm_snapshot_analysis/v8_profile.dart';
@@ -849,6 +850,40 @@ void main() async {
       });
     });
 
+    test('size-report', () async {
+      await withV8Profile(testSource, (profileJson) async {
+        await withV8Profile(testSourceModified, (modifiedProfileJson) async {
+          final info = loadProgramInfoFromJson(
+              await loadJson(File(profileJson)));
+          final modifiedInfo = loadProgramInfoFromJson(
+              await loadJson(File(modifiedProfileJson)));
+          final report = buildSizeReport(info);
+          final modifiedReport = buildSizeReport(modifiedInfo);
+
+          expect(report['#sizes']['total'], equals(info.totalSize));
+          final inputLib =
+              report['package:input']['package:input/input.dart'];
+          expect(inputLib['#type'], equals('library'));
+          expect(inputLib['#sizes']['instructions'], greaterThan(0));
+          expect(inputLib['A']['tornOff']['#sizes']['instructions'],
+              greaterThan(0));
+
+          // Comparing a report with itself leaves nothing but the totals.
+          final sameDiff = compareSizeReports(report, report);
+          expect(sameDiff.keys, equals(['#sizes']));
+          expect(sameDiff['#sizes']['total'], equals(0));
+
+          final diff = compareSizeReports(report, modifiedReport);
+          expect(diff['#sizes']['total'],
+              equals(modifiedInfo.totalSize - info.totalSize));
+          expect(
+              diff['package:input']['package:input/input.dart']['A']
+                  ['tornOff']['#sizes']['total'],
+              greaterThan(0));
+        });
+      });
+    });
+
     test('dominators', () async {
       await withV8Profile(chainOfStaticCalls, (profileJson) async {
         // Note: computing dominators also verifies that we don't have
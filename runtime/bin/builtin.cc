@@ -37,6 +37,8 @@ void Builtin::SetNativeResolver(BuiltinLibraryId id) {
     Dart_Handle result =
         Dart_SetNativeResolver(library, NativeLookup, NativeSymbol);
     ASSERT(!Dart_IsError(result));
+    result = Dart_SetFfiNativeResolver(library, FfiNativeLookup);
+    ASSERT(!Dart_IsError(result));
   }
 }
 
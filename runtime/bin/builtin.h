@@ -21,6 +21,14 @@ namespace bin {
 #define DECLARE_FUNCTION(name, count)                                          \
   extern void FUNCTION_NAME(name)(Dart_NativeArguments args);
 
+// Natives bound with @FfiNative are called with unboxed arguments, without
+// Dart_NativeArguments.
+#define FFI_FUNCTION_NAME(name) Builtin_Ffi_##name
+#define REGISTER_FFI_FUNCTION(name, return_type, argument_types)               \
+  {"" #name, reinterpret_cast<void*>(FFI_FUNCTION_NAME(name))},
+#define DECLARE_FFI_FUNCTION(name, return_type, argument_types)                \
+  extern return_type FFI_FUNCTION_NAME(name) argument_types;
+
 class Builtin {
  public:
   // Note: Changes to this enum should be accompanied with changes to
@@ -48,6 +56,9 @@ class Builtin {
 
   static const uint8_t* NativeSymbol(Dart_NativeFunction nf);
 
+  // For use with @FfiNative.
+  static void* FfiNativeLookup(const char* name, uintptr_t argument_count);
+
   static const int num_libs_;
 
   typedef struct {
@@ -58,6 +58,10 @@ const uint8_t* Builtin::NativeSymbol(Dart_NativeFunction nf) {
   return IONativeSymbol(nf);
 }
 
+void* Builtin::FfiNativeLookup(const char* name, uintptr_t argument_count) {
+  return IOFfiNativeLookup(name, argument_count);
+}
+
 // Implementation of native functions which are used for some
 // test/debug functionality in standalone dart mode.
 void FUNCTION_NAME(Builtin_PrintString)(Dart_NativeArguments args) {
@@ -84,5 +84,9 @@ const uint8_t* LookupIONativeSymbol(Dart_NativeFunction nf) {
   return IONativeSymbol(nf);
 }
 
+void* LookupIOFfiNative(const char* name, uintptr_t argument_count) {
+  return IOFfiNativeLookup(name, argument_count);
+}
+
 }  // namespace bin
 }  // namespace dart
@@ -396,9 +396,9 @@ CObject* Directory::ListNextRequest(const CObjectArray& request) {
   if (dir_listing->IsEmpty()) {
     return new CObjectArray(CObject::NewArray(0));
   }
-  const int kArraySize = 128;
-  CObjectArray* response = new CObjectArray(CObject::NewArray(kArraySize));
-  dir_listing->SetArray(response, kArraySize);
+  const intptr_t array_size = dir_listing->NextBatchLength();
+  CObjectArray* response = new CObjectArray(CObject::NewArray(array_size));
+  dir_listing->SetArray(response, array_size);
   Directory::List(dir_listing);
   // In case the listing ended before it hit the buffer length, we need to
   // override the array length.
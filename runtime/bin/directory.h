@@ -164,6 +164,11 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
     kListDone = 4
   };
 
+  // Number of array slots of the first and the largest ListNext responses.
+  // Each entry takes two slots.
+  static constexpr intptr_t kInitialBatchLength = 128;
+  static constexpr intptr_t kMaxBatchLength = 8192;
+
   AsyncDirectoryListing(Namespace* namespc,
                         const char* dir_name,
                         bool recursive,
@@ -172,7 +177,8 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
         DirectoryListing(namespc, dir_name, recursive, follow_links),
         array_(nullptr),
         index_(0),
-        length_(0) {}
+        length_(0),
+        batch_length_(kInitialBatchLength) {}
 
   virtual bool HandleDirectory(const char* dir_name);
   virtual bool HandleFile(const char* file_name);
@@ -189,12 +195,24 @@ class AsyncDirectoryListing : public ReferenceCounted<AsyncDirectoryListing>,
 
   intptr_t index() const { return index_; }
 
+  // Returns the array length for the next ListNext response. Responses
+  // start small so that the first entries arrive quickly, and then grow so
+  // that listing a large tree takes few round trips.
+  intptr_t NextBatchLength() {
+    intptr_t length = batch_length_;
+    if (batch_length_ < kMaxBatchLength) {
+      batch_length_ *= 2;
+    }
+    return length;
+  }
+
  private:
   virtual ~AsyncDirectoryListing() {}
   bool AddFileSystemEntityToResponse(Response response, const char* arg);
   CObjectArray* array_;
   intptr_t index_;
   intptr_t length_;
+  intptr_t batch_length_;
 
   friend class ReferenceCounted<AsyncDirectoryListing>;
   DISALLOW_IMPLICIT_CONSTRUCTORS(AsyncDirectoryListing);
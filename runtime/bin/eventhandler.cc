@@ -15,17 +15,41 @@
 namespace dart {
 namespace bin {
 
-static EventHandler* event_handler = nullptr;
+static EventHandler* event_handlers = nullptr;
+static intptr_t num_event_handlers = 0;
 static Monitor* shutdown_monitor = nullptr;
 
+bool EventHandler::use_io_uring_ = false;
+intptr_t EventHandler::thread_count_ = 1;
+
+// Returns the event handler watching the descriptor of [id].
+static EventHandler* EventHandlerFor(intptr_t id) {
+  if (num_event_handlers == 1 || id == kTimerId) {
+    return &event_handlers[0];
+  }
+  // The descriptor is only closed by the event handler in response to a
+  // close command, after which any other command for the socket is ignored.
+  // So it doesn't matter which event handler gets those.
+  const intptr_t fd = reinterpret_cast<Socket*>(id)->fd();
+  const uintptr_t hash = static_cast<uintptr_t>(fd);
+  return &event_handlers[hash % num_event_handlers];
+}
+
 void EventHandler::Start() {
   // Initialize global socket registry.
   ListeningSocketRegistry::Initialize();
 
-  ASSERT(event_handler == nullptr);
+  ASSERT(event_handlers == nullptr);
   shutdown_monitor = new Monitor();
-  event_handler = new EventHandler();
-  event_handler->delegate_.Start(event_handler);
+#if defined(DART_HOST_OS_LINUX)
+  num_event_handlers = thread_count_ > 0 ? thread_count_ : 1;
+#else
+  num_event_handlers = 1;
+#endif
+  event_handlers = new EventHandler[num_event_handlers];
+  for (intptr_t i = 0; i < num_event_handlers; i++) {
+    event_handlers[i].delegate_.Start(&event_handlers[i]);
+  }
 
   if (!SocketBase::Initialize()) {
     FATAL("Failed to initialize sockets");
@@ -38,22 +62,23 @@ void EventHandler::NotifyShutdownDone() {
 }
 
 void EventHandler::Stop() {
-  if (event_handler == nullptr) {
+  if (event_handlers == nullptr) {
     return;
   }
 
-  // Wait until it has stopped.
-  {
+  // Wait until they have stopped.
+  for (intptr_t i = 0; i < num_event_handlers; i++) {
     MonitorLocker ml(shutdown_monitor);
 
     // Signal to event handler that we want it to stop.
-    event_handler->delegate_.Shutdown();
+    event_handlers[i].delegate_.Shutdown();
     ml.Wait(Monitor::kNoTimeout);
   }
 
   // Cleanup
-  delete event_handler;
-  event_handler = nullptr;
+  delete[] event_handlers;
+  event_handlers = nullptr;
+  num_event_handlers = 0;
   delete shutdown_monitor;
   shutdown_monitor = nullptr;
 
@@ -62,14 +87,14 @@ void EventHandler::Stop() {
 }
 
 EventHandlerImplementation* EventHandler::delegate() {
-  if (event_handler == nullptr) {
+  if (event_handlers == nullptr) {
     return nullptr;
   }
-  return &event_handler->delegate_;
+  return &event_handlers[0].delegate_;
 }
 
 void EventHandler::SendFromNative(intptr_t id, Dart_Port port, int64_t data) {
-  event_handler->SendData(id, port, data);
+  EventHandlerFor(id)->SendData(id, port, data);
 }
 
 /*
@@ -98,7 +123,7 @@ void FUNCTION_NAME(EventHandler_SendData)(Dart_NativeArguments args) {
     id = reinterpret_cast<intptr_t>(socket);
   }
   int64_t data = DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
-  event_handler->SendData(id, dart_port, data);
+  EventHandlerFor(id)->SendData(id, dart_port, data);
 }
 
 void FUNCTION_NAME(EventHandler_TimerMillisecondClock)(
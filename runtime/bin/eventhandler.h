@@ -602,6 +602,8 @@ class DescriptorInfoMultipleMixin : public DI {
 namespace dart {
 namespace bin {
 
+// The event handlers of the process. There is one per event handler thread,
+// each with its own delegate watching a disjoint set of descriptors.
 class EventHandler {
  public:
   EventHandler() {}
@@ -625,14 +627,35 @@ class EventHandler {
    */
   static void Stop();
 
+  // The delegate of the first event handler, which handles timers and,
+  // without sharding, all descriptors.
   static EventHandlerImplementation* delegate();
 
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  // Whether the event handler should use io_uring instead of epoll where the
+  // kernel supports it. Only honored on Linux and must be set before Start().
+  static bool use_io_uring() { return use_io_uring_; }
+  static void set_use_io_uring(bool use_io_uring) {
+    use_io_uring_ = use_io_uring;
+  }
+
+  // The number of event handler threads. Descriptors are assigned to the
+  // threads by their file descriptor so that all sockets sharing a
+  // descriptor are handled by the same thread. Only honored on Linux and
+  // must be set before Start().
+  static intptr_t thread_count() { return thread_count_; }
+  static void set_thread_count(intptr_t thread_count) {
+    thread_count_ = thread_count;
+  }
+
  private:
   friend class EventHandlerImplementation;
   EventHandlerImplementation delegate_;
 
+  static bool use_io_uring_;
+  static intptr_t thread_count_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
 
@@ -12,11 +12,14 @@
 #include <fcntl.h>        // NOLINT
 #include <pthread.h>      // NOLINT
 #include <stdio.h>        // NOLINT
-#include <string.h>       // NOLINT
-#include <sys/epoll.h>    // NOLINT
-#include <sys/stat.h>     // NOLINT
-#include <sys/timerfd.h>  // NOLINT
-#include <unistd.h>       // NOLINT
+#include <linux/io_uring.h>  // NOLINT
+#include <string.h>          // NOLINT
+#include <sys/epoll.h>       // NOLINT
+#include <sys/mman.h>        // NOLINT
+#include <sys/stat.h>        // NOLINT
+#include <sys/syscall.h>     // NOLINT
+#include <sys/timerfd.h>     // NOLINT
+#include <unistd.h>          // NOLINT
 
 #include "bin/dartutils.h"
 #include "bin/fdutils.h"
@@ -30,6 +33,202 @@
 namespace dart {
 namespace bin {
 
+// A minimal io_uring submission/completion ring, driven directly through the
+// io_uring_setup/io_uring_enter system calls so that no liburing dependency
+// is needed.
+//
+// Submissions are only queued by GetSqe(); they reach the kernel in a single
+// batch on the next SubmitAndWait(), which also blocks for completions.
+class IoUring {
+ public:
+  static IoUring* Create(uint32_t entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = NO_RETRY_EXPECTED(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) {
+      return nullptr;
+    }
+    // Multishot poll requests (IORING_POLL_ADD_MULTI) were added in Linux
+    // 5.13, which has no dedicated feature bit. IORING_FEAT_RSRC_TAGS was
+    // introduced in the same release, so use it as the version probe.
+    const uint32_t kRequiredFeatures = IORING_FEAT_SINGLE_MMAP |
+                                       IORING_FEAT_NODROP |
+                                       IORING_FEAT_RSRC_TAGS;
+    if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+      close(fd);
+      return nullptr;
+    }
+    IoUring* ring = new IoUring(fd, params);
+    if (!ring->Map()) {
+      delete ring;
+      return nullptr;
+    }
+    return ring;
+  }
+
+  ~IoUring() {
+    if (sqes_ != nullptr) {
+      munmap(sqes_, sqes_size_);
+    }
+    if (ring_ != nullptr) {
+      munmap(ring_, ring_size_);
+    }
+    close(fd_);
+  }
+
+  int fd() const { return fd_; }
+
+  // Returns a zeroed submission queue entry. If the queue is full the pending
+  // entries are handed to the kernel first.
+  struct io_uring_sqe* GetSqe() {
+    if (sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >=
+        sq_entries_) {
+      Submit(0);
+      if (sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >=
+          sq_entries_) {
+        FATAL("io_uring submission queue overflow");
+      }
+    }
+    const uint32_t index = sqe_tail_ & sq_mask_;
+    struct io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    sqe_tail_++;
+    return sqe;
+  }
+
+  // Submits all queued entries and waits until at least [wait_nr]
+  // completions are available.
+  void SubmitAndWait(uint32_t wait_nr) { Submit(wait_nr); }
+
+  // Invokes [callback] for every available completion and then releases them
+  // back to the kernel.
+  template <typename Callback>
+  void ForEachCompletion(Callback callback) {
+    uint32_t head = *cq_head_;
+    const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+      const struct io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      callback(cqe.user_data, cqe.res, cqe.flags);
+      head++;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+ private:
+  IoUring(int fd, const struct io_uring_params& params)
+      : fd_(fd), params_(params) {}
+
+  bool Map() {
+    const size_t sq_size =
+        params_.sq_off.array + params_.sq_entries * sizeof(uint32_t);
+    const size_t cq_size =
+        params_.cq_off.cqes + params_.cq_entries * sizeof(struct io_uring_cqe);
+    // With IORING_FEAT_SINGLE_MMAP both rings share one mapping.
+    ring_size_ = Utils::Maximum(sq_size, cq_size);
+    void* ring = mmap(nullptr, ring_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED) {
+      return false;
+    }
+    ring_ = reinterpret_cast<uint8_t*>(ring);
+    sqes_size_ = params_.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      return false;
+    }
+    sqes_ = reinterpret_cast<struct io_uring_sqe*>(sqes);
+
+    sq_head_ = reinterpret_cast<uint32_t*>(ring_ + params_.sq_off.head);
+    sq_tail_ = reinterpret_cast<uint32_t*>(ring_ + params_.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(ring_ + params_.sq_off.ring_mask);
+    sq_entries_ = params_.sq_entries;
+    sq_array_ = reinterpret_cast<uint32_t*>(ring_ + params_.sq_off.array);
+    cq_head_ = reinterpret_cast<uint32_t*>(ring_ + params_.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t*>(ring_ + params_.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(ring_ + params_.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(ring_ + params_.cq_off.cqes);
+    sqe_tail_ = *sq_tail_;
+    return true;
+  }
+
+  void Submit(uint32_t wait_nr) {
+    __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+    uint32_t to_submit = sqe_tail_ - submitted_tail_;
+    const uint32_t flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (to_submit > 0 || wait_nr > 0) {
+      intptr_t result = syscall(__NR_io_uring_enter, fd_, to_submit, wait_nr,
+                                flags, nullptr, 0);
+      if (result >= 0) {
+        submitted_tail_ += result;
+        to_submit -= result;
+        if (wait_nr > 0 || to_submit == 0) {
+          // The kernel consumes all entries before waiting, so a successful
+          // waiting call is done.
+          return;
+        }
+      } else if (errno == EINTR) {
+        // A signal interrupted the wait before anything was submitted. Any
+        // remaining entries go out with the next call.
+        if (wait_nr > 0) {
+          return;
+        }
+      } else if (errno == EBUSY || errno == EAGAIN) {
+        // The completion queue is backed up. Return so that the caller can
+        // reap completions before submitting more.
+        return;
+      } else {
+        FATAL("io_uring_enter failed: %d", errno);
+      }
+    }
+  }
+
+  const int fd_;
+  const struct io_uring_params params_;
+
+  uint8_t* ring_ = nullptr;
+  size_t ring_size_ = 0;
+  struct io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  struct io_uring_cqe* cqes_ = nullptr;
+
+  // Local copy of the submission tail, published on Submit().
+  uint32_t sqe_tail_ = 0;
+  uint32_t submitted_tail_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+// The low 32 bits of an io_uring request's user_data hold a file descriptor
+// or one of the reserved tags below, the high 32 bits hold a generation which
+// lets stale completions (for polls that were cancelled or re-armed, or for
+// descriptors that were closed and reused) be recognized and dropped.
+static constexpr uint32_t kInterruptTag = 0xFFFFFFFF;
+static constexpr uint32_t kTimeoutTag = 0xFFFFFFFE;
+static constexpr uint32_t kIgnoredTag = 0xFFFFFFFD;
+
+static uint64_t MakeUserData(uint32_t generation, uint32_t tag) {
+  return (static_cast<uint64_t>(generation) << 32) | tag;
+}
+
+static uint32_t UserDataGeneration(uint64_t user_data) {
+  return static_cast<uint32_t>(user_data >> 32);
+}
+
+static uint32_t UserDataTag(uint64_t user_data) {
+  return static_cast<uint32_t>(user_data & 0xFFFFFFFF);
+}
+
 intptr_t DescriptorInfo::GetPollEvents() {
   // Do not ask for EPOLLERR and EPOLLHUP explicitly as they are
   // triggered anyway.
@@ -71,7 +270,13 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
 }
 
 EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
+    : socket_map_(&SimpleHashMap::SamePointerValue, 16),
+      epoll_fd_(-1),
+      timer_fd_(-1),
+      uring_(nullptr),
+      next_poll_generation_(1),
+      timeout_generation_(0),
+      timeout_dirty_(false) {
   intptr_t result;
   result = NO_RETRY_EXPECTED(pipe(interrupt_fds_));
   if (result != 0) {
@@ -87,6 +292,9 @@ EventHandlerImplementation::EventHandlerImplementation()
     FATAL("Failed to set pipe fd close on exec\n");
   }
   shutdown_ = false;
+  if (EventHandler::use_io_uring() && InitializeIoUring()) {
+    return;
+  }
   // The initial size passed to epoll_create is ignore on newer (>=
   // 2.6.8) Linux versions
   const int kEpollInitialSize = 64;
@@ -127,16 +335,41 @@ static void DeleteDescriptorInfo(void* info) {
   delete di;
 }
 
+bool EventHandlerImplementation::InitializeIoUring() {
+  // Each registered descriptor has at most one poll request in flight, so the
+  // ring only bounds how many submissions are batched per io_uring_enter.
+  const uint32_t kIoUringEntries = 256;
+  uring_ = IoUring::Create(kIoUringEntries);
+  if (uring_ == nullptr) {
+    // Older kernels, or io_uring disabled by seccomp or sysctl. Fall back to
+    // epoll.
+    return false;
+  }
+  if (!FDUtils::SetCloseOnExec(uring_->fd())) {
+    FATAL("Failed to set io_uring fd close on exec\n");
+  }
+  ArmInterruptPoll();
+  return true;
+}
+
 EventHandlerImplementation::~EventHandlerImplementation() {
   socket_map_.Clear(DeleteDescriptorInfo);
-  close(epoll_fd_);
-  close(timer_fd_);
+  if (uring_ != nullptr) {
+    delete uring_;
+  } else {
+    close(epoll_fd_);
+    close(timer_fd_);
+  }
   close(interrupt_fds_[0]);
   close(interrupt_fds_[1]);
 }
 
 void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
                                                      DescriptorInfo* di) {
+  if (uring_ != nullptr) {
+    UpdateIoUringPoll(di);
+    return;
+  }
   intptr_t new_mask = di->Mask();
   if ((old_mask != 0) && (new_mask == 0)) {
     RemoveFromEpollInstance(epoll_fd_, di);
@@ -200,7 +433,12 @@ void EventHandlerImplementation::HandleInterruptFd() {
   for (ssize_t i = 0; i < bytes / kInterruptMessageSize; i++) {
     if (msg[i].id == kTimerId) {
       timeout_queue_.UpdateTimeout(msg[i].dart_port, msg[i].data);
-      UpdateTimerFd();
+      if (uring_ != nullptr) {
+        // Re-armed once per loop iteration, see PollIoUring.
+        timeout_dirty_ = true;
+      } else {
+        UpdateTimerFd();
+      }
     } else if (msg[i].id == kShutdownId) {
       shutdown_ = true;
     } else {
@@ -393,6 +631,13 @@ void EventHandlerImplementation::Poll(uword args) {
   EventHandlerImplementation* handler_impl = &handler->delegate_;
   ASSERT(handler_impl != nullptr);
 
+  if (handler_impl->uring_ != nullptr) {
+    PollIoUring(handler);
+    DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
+    handler->NotifyShutdownDone();
+    return;
+  }
+
   while (!handler_impl->shutdown_) {
     intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
         epoll_wait(handler_impl->epoll_fd_, events, kMaxEvents, -1));
@@ -409,6 +654,175 @@ void EventHandlerImplementation::Poll(uword args) {
   handler->NotifyShutdownDone();
 }
 
+void EventHandlerImplementation::UpdateIoUringPoll(DescriptorInfo* di) {
+  const intptr_t events = di->Mask() != 0 ? di->GetPollEvents() : 0;
+  const uint32_t armed = di->poll_generation();
+  if (armed != 0 && events == di->poll_events()) {
+    return;
+  }
+  if (armed != 0) {
+    struct io_uring_sqe* sqe = uring_->GetSqe();
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->addr = MakeUserData(armed, di->fd());
+    sqe->user_data = MakeUserData(0, kIgnoredTag);
+    di->set_poll(0, 0);
+  }
+  if (events == 0) {
+    return;
+  }
+  const uint32_t generation = next_poll_generation_++;
+  if (next_poll_generation_ == 0) {
+    next_poll_generation_ = 1;
+  }
+  struct io_uring_sqe* sqe = uring_->GetSqe();
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = di->fd();
+  uint32_t poll_events = EPOLLRDHUP | events;
+  if (!di->IsListeningSocket()) {
+    // Mirror the edge-triggered epoll registration: a multishot poll stays
+    // armed and reports every new readiness transition. Listening sockets
+    // use level-triggered one-shot polls which are re-armed on completion.
+    poll_events |= EPOLLET;
+    sqe->len = IORING_POLL_ADD_MULTI;
+  }
+  sqe->poll32_events = poll_events;
+  sqe->user_data = MakeUserData(generation, di->fd());
+  di->set_poll(generation, events);
+}
+
+void EventHandlerImplementation::ArmInterruptPoll() {
+  struct io_uring_sqe* sqe = uring_->GetSqe();
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = interrupt_fds_[0];
+  sqe->poll32_events = EPOLLIN;
+  sqe->len = IORING_POLL_ADD_MULTI;
+  sqe->user_data = MakeUserData(0, kInterruptTag);
+}
+
+void EventHandlerImplementation::ArmIoUringTimeout() {
+  // The timespec is read by the kernel when the request is submitted, which
+  // happens before the next call to this function.
+  static struct __kernel_timespec timeout_spec;
+  if (timeout_generation_ != 0) {
+    struct io_uring_sqe* sqe = uring_->GetSqe();
+    sqe->opcode = IORING_OP_TIMEOUT_REMOVE;
+    sqe->addr = MakeUserData(timeout_generation_, kTimeoutTag);
+    sqe->user_data = MakeUserData(0, kIgnoredTag);
+    timeout_generation_ = 0;
+  }
+  if (!timeout_queue_.HasTimeout()) {
+    return;
+  }
+  const int64_t millis = timeout_queue_.CurrentTimeout();
+  timeout_spec.tv_sec = millis / 1000;
+  timeout_spec.tv_nsec = (millis % 1000) * 1000000;
+  timeout_generation_ = next_poll_generation_++;
+  if (next_poll_generation_ == 0) {
+    next_poll_generation_ = 1;
+  }
+  struct io_uring_sqe* sqe = uring_->GetSqe();
+  sqe->opcode = IORING_OP_TIMEOUT;
+  sqe->addr = reinterpret_cast<uint64_t>(&timeout_spec);
+  sqe->len = 1;
+  // Absolute CLOCK_MONOTONIC deadline, the same clock as
+  // TimerUtils::GetCurrentMonotonicMillis.
+  sqe->timeout_flags = IORING_TIMEOUT_ABS;
+  sqe->user_data = MakeUserData(timeout_generation_, kTimeoutTag);
+}
+
+void EventHandlerImplementation::HandleCompletion(uint64_t user_data,
+                                                  int32_t res,
+                                                  uint32_t flags,
+                                                  bool* interrupt_seen) {
+  const uint32_t tag = UserDataTag(user_data);
+  const uint32_t generation = UserDataGeneration(user_data);
+  if (tag == kIgnoredTag) {
+    return;
+  }
+  if (tag == kInterruptTag) {
+    *interrupt_seen = true;
+    if ((flags & IORING_CQE_F_MORE) == 0) {
+      ArmInterruptPoll();
+    }
+    return;
+  }
+  if (tag == kTimeoutTag) {
+    if (generation != timeout_generation_) {
+      return;
+    }
+    timeout_generation_ = 0;
+    if (res == -ETIME && timeout_queue_.HasTimeout()) {
+      DartUtils::PostNull(timeout_queue_.CurrentPort());
+      timeout_queue_.RemoveCurrent();
+    }
+    timeout_dirty_ = true;
+    return;
+  }
+
+  const intptr_t fd = tag;
+  SimpleHashMap::Entry* entry = socket_map_.Lookup(
+      GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd), false);
+  if (entry == nullptr) {
+    return;
+  }
+  DescriptorInfo* di = reinterpret_cast<DescriptorInfo*>(entry->value);
+  if (di == nullptr || di->poll_generation() != generation) {
+    return;
+  }
+  if ((flags & IORING_CQE_F_MORE) == 0) {
+    // The request is finished (one-shot, or a multishot poll which the
+    // kernel terminated). UpdateEpollInstance below re-arms it if needed.
+    di->set_poll(0, 0);
+  }
+  const intptr_t old_mask = di->Mask();
+  if (res < 0) {
+    if (res != -ECANCELED) {
+      // Same as epoll rejecting the descriptor: report it as closed so that
+      // the Dart side handles it accordingly.
+      di->NotifyAllDartPorts(1 << kCloseEvent);
+    }
+    UpdateEpollInstance(old_mask, di);
+    return;
+  }
+  const intptr_t event_mask = GetPollEvents(res, di);
+  if ((event_mask & (1 << kErrorEvent)) != 0) {
+    di->NotifyAllDartPorts(event_mask);
+    UpdateEpollInstance(old_mask, di);
+  } else if (event_mask != 0) {
+    Dart_Port port = di->NextNotifyDartPort(event_mask);
+    ASSERT(port != 0);
+    UpdateEpollInstance(old_mask, di);
+    DartUtils::PostInt32(port, event_mask);
+  } else {
+    UpdateEpollInstance(old_mask, di);
+  }
+}
+
+void EventHandlerImplementation::PollIoUring(EventHandler* handler) {
+  EventHandlerImplementation* handler_impl = &handler->delegate_;
+  IoUring* uring = handler_impl->uring_;
+  while (!handler_impl->shutdown_) {
+    if (handler_impl->timeout_dirty_) {
+      handler_impl->timeout_dirty_ = false;
+      handler_impl->ArmIoUringTimeout();
+    }
+    // Hands every request queued by the previous iteration to the kernel in
+    // one system call, then blocks until something completes.
+    uring->SubmitAndWait(1);
+    bool interrupt_seen = false;
+    uring->ForEachCompletion(
+        [&](uint64_t user_data, int32_t res, uint32_t flags) {
+          handler_impl->HandleCompletion(user_data, res, flags,
+                                         &interrupt_seen);
+        });
+    if (interrupt_seen) {
+      // Handle after socket events, so we avoid closing a socket before we
+      // handle the current events.
+      handler_impl->HandleInterruptFd();
+    }
+  }
+}
+
 void EventHandlerImplementation::Start(EventHandler* handler) {
   int result =
       Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
@@ -20,9 +20,12 @@
 namespace dart {
 namespace bin {
 
+class IoUring;
+
 class DescriptorInfo : public DescriptorInfoBase {
  public:
-  explicit DescriptorInfo(intptr_t fd) : DescriptorInfoBase(fd) {}
+  explicit DescriptorInfo(intptr_t fd)
+      : DescriptorInfoBase(fd), poll_generation_(0), poll_events_(0) {}
 
   virtual ~DescriptorInfo() {}
 
@@ -33,7 +36,20 @@ class DescriptorInfo : public DescriptorInfoBase {
     fd_ = -1;
   }
 
+  // When the event handler is backed by io_uring, the generation of the poll
+  // request currently armed for this descriptor (0 if none) and the events it
+  // was armed with.
+  uint32_t poll_generation() const { return poll_generation_; }
+  intptr_t poll_events() const { return poll_events_; }
+  void set_poll(uint32_t generation, intptr_t events) {
+    poll_generation_ = generation;
+    poll_events_ = events;
+  }
+
  private:
+  uint32_t poll_generation_;
+  intptr_t poll_events_;
+
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfo);
 };
 
@@ -72,9 +88,20 @@ class EventHandlerImplementation {
   void Start(EventHandler* handler);
   void Shutdown();
 
+  // Whether readiness notifications are delivered through io_uring rather
+  // than epoll. Decided once when the event handler is created.
+  bool UsesIoUring() const { return uring_ != nullptr; }
+
  private:
   void HandleEvents(struct epoll_event* events, int size);
   static void Poll(uword args);
+  static void PollIoUring(EventHandler* handler);
+  bool InitializeIoUring();
+  void HandleCompletion(uint64_t user_data, int32_t res, uint32_t flags,
+                        bool* interrupt_seen);
+  void UpdateIoUringPoll(DescriptorInfo* di);
+  void ArmInterruptPoll();
+  void ArmIoUringTimeout();
   void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
   void HandleInterruptFd();
   void UpdateTimerFd();
@@ -90,6 +117,12 @@ class EventHandlerImplementation {
   int epoll_fd_;
   int timer_fd_;
 
+  // Only used when the io_uring backend is active.
+  IoUring* uring_;
+  uint32_t next_poll_generation_;
+  uint32_t timeout_generation_;
+  bool timeout_dirty_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
 
@@ -24,6 +24,7 @@
 #include <mutex>               // NOLINT(build/c++11)
 #include <queue>               // NOLINT(build/c++11)
 #include <thread>              // NOLINT(build/c++11)
+#include <vector>              // NOLINT(build/c++11)
 
 #include <setjmp.h>  // NOLINT
 #include <signal.h>  // NOLINT
@@ -1315,4 +1316,75 @@ DART_EXPORT bool IsNull(Dart_Handle object) {
   return Dart_IsNull(object);
 }
 
+// Calls [fn] [count] times from each of [threads] new threads, without
+// waiting for Dart to handle the calls.
+DART_EXPORT void CallListenerFromThreads(void (*fn)(int32_t, int32_t, void*),
+                                         int32_t threads,
+                                         int32_t count) {
+  std::vector<std::thread> helpers;
+  for (int32_t t = 0; t < threads; t++) {
+    helpers.emplace_back([fn, t, count]() {
+      for (int32_t i = 0; i < count; i++) {
+        fn(t, i, reinterpret_cast<void*>(static_cast<intptr_t>(t + 1)));
+      }
+    });
+  }
+  for (auto& helper : helpers) {
+    helper.join();
+  }
+}
+
+// Calls [fn] for 0 to [count] - 1 from each of [threads] new threads, and
+// returns the sum of the results.
+DART_EXPORT int64_t CallGroupCallbackFromThreads(int64_t (*fn)(int64_t),
+                                                 int32_t threads,
+                                                 int32_t count) {
+  std::vector<std::thread> helpers;
+  std::vector<int64_t> sums(threads, 0);
+  for (int32_t t = 0; t < threads; t++) {
+    helpers.emplace_back([fn, t, count, &sums]() {
+      for (int32_t i = 0; i < count; i++) {
+        sums[t] += fn(i);
+      }
+    });
+  }
+  int64_t sum = 0;
+  for (int32_t t = 0; t < threads; t++) {
+    helpers[t].join();
+    sum += sums[t];
+  }
+  return sum;
+}
+
+// Adds values[start] up to values[length - 1] to [sum], and returns the index
+// it stopped at. Stops early when a safepoint is requested, after making some
+// progress.
+DART_EXPORT intptr_t SumUntilSafepoint(const int64_t* values,
+                                       intptr_t start,
+                                       intptr_t length,
+                                       int64_t* sum) {
+  const intptr_t kChunk = 1024;
+  for (intptr_t i = start; i < length; i++) {
+    if (i > start && (i % kChunk) == 0 && Dart_IsSafepointRequested_DL()) {
+      return i;
+    }
+    *sum += values[i];
+  }
+  return length;
+}
+
+// Calls [callback], which may run the GC, then doubles the bytes and returns
+// their sum.
+DART_EXPORT int64_t DoubleBytesAfterCallback(uint8_t* bytes,
+                                             intptr_t length,
+                                             void (*callback)()) {
+  callback();
+  int64_t sum = 0;
+  for (intptr_t i = 0; i < length; i++) {
+    sum += bytes[i];
+    bytes[i] *= 2;
+  }
+  return sum;
+}
+
 }  // namespace dart
@@ -68,8 +68,9 @@ void FUNCTION_NAME(File_GetPointer)(Dart_NativeArguments args) {
   Dart_SetIntegerReturnValue(args, file_pointer);
 }
 
-void FUNCTION_NAME(File_GetFD)(Dart_NativeArguments args) {
-  Dart_SetIntegerReturnValue(args, GetFile(args)->GetFD());
+// Leaf call, must not call into the VM.
+intptr_t FFI_FUNCTION_NAME(File_GetFD)(void* file_pointer) {
+  return reinterpret_cast<File*>(file_pointer)->GetFD();
 }
 
 static void ReleaseFile(void* isolate_callback_data, void* peer) {
@@ -326,31 +327,22 @@ void FUNCTION_NAME(File_WriteFrom)(Dart_NativeArguments args) {
   }
 }
 
-void FUNCTION_NAME(File_Position)(Dart_NativeArguments args) {
-  File* file = GetFile(args);
-  ASSERT(file != nullptr);
+Dart_Handle FFI_FUNCTION_NAME(File_Position)(void* file_pointer) {
+  File* file = reinterpret_cast<File*>(file_pointer);
   intptr_t return_value = file->Position();
   if (return_value >= 0) {
-    Dart_SetIntegerReturnValue(args, return_value);
-  } else {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return Dart_NewInteger(return_value);
   }
+  return DartUtils::NewDartOSError();
 }
 
-void FUNCTION_NAME(File_SetPosition)(Dart_NativeArguments args) {
-  File* file = GetFile(args);
-  ASSERT(file != nullptr);
-  int64_t position = 0;
-  if (DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &position)) {
-    if (file->SetPosition(position)) {
-      Dart_SetBooleanReturnValue(args, true);
-    } else {
-      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-    }
-  } else {
-    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+Dart_Handle FFI_FUNCTION_NAME(File_SetPosition)(void* file_pointer,
+                                                int64_t position) {
+  File* file = reinterpret_cast<File*>(file_pointer);
+  if (file->SetPosition(position)) {
+    return Dart_True();
   }
+  return DartUtils::NewDartOSError();
 }
 
 void FUNCTION_NAME(File_Truncate)(Dart_NativeArguments args) {
@@ -369,15 +361,13 @@ void FUNCTION_NAME(File_Truncate)(Dart_NativeArguments args) {
   }
 }
 
-void FUNCTION_NAME(File_Length)(Dart_NativeArguments args) {
-  File* file = GetFile(args);
-  ASSERT(file != nullptr);
+Dart_Handle FFI_FUNCTION_NAME(File_Length)(void* file_pointer) {
+  File* file = reinterpret_cast<File*>(file_pointer);
   int64_t return_value = file->Length();
   if (return_value >= 0) {
-    Dart_SetIntegerReturnValue(args, return_value);
-  } else {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return Dart_NewInteger(return_value);
   }
+  return DartUtils::NewDartOSError();
 }
 
 void FUNCTION_NAME(File_LengthFromPath)(Dart_NativeArguments args) {
@@ -529,6 +519,50 @@ void FUNCTION_NAME(File_Lock)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
 }
 
+static void MappedMemoryFinalizer(void* isolate_callback_data, void* peer) {
+  delete reinterpret_cast<MappedMemory*>(peer);
+}
+
+void FUNCTION_NAME(File_Map)(Dart_NativeArguments args) {
+  File* file = GetFile(args);
+  ASSERT(file != nullptr);
+  int64_t position;
+  int64_t length;
+  if (!DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &position) ||
+      !DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 2), &length) ||
+      (position < 0) || (length <= 0) ||
+      (length > kIntptrMax - File::MapAlignment())) {
+    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    return;
+  }
+  const bool sequential =
+      DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 3));
+
+  // Map whole pages and point the list at the requested range within them.
+  const int64_t offset = position % File::MapAlignment();
+  MappedMemory* mapping =
+      file->Map(File::kReadOnly, position - offset, offset + length);
+  if (mapping == nullptr) {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return;
+  }
+  if (sequential) {
+    mapping->AdviseSequential();
+  }
+  // The pages of the mapping are backed by the file and can be dropped by the
+  // OS at any time, so they are not reported as external allocation.
+  Dart_Handle result = Dart_NewUnmodifiableExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8,
+      reinterpret_cast<const uint8_t*>(mapping->address()) + offset, length,
+      mapping, /*external_allocation_size=*/0, MappedMemoryFinalizer);
+  if (Dart_IsError(result)) {
+    delete mapping;
+    Dart_PropagateError(result);
+  }
+  Dart_SetReturnValue(args, result);
+}
+
 void FUNCTION_NAME(File_Create)(Dart_NativeArguments args) {
   Namespace* namespc = Namespace::GetNamespace(args, 0);
   Dart_Handle path_handle = Dart_GetNativeArgument(args, 1);
@@ -1597,6 +1631,18 @@ CObject* File::LockRequest(const CObjectArray& request) {
              : CObject::NewOSError();
 }
 
+CObject* File::AdviseSequentialRequest(const CObjectArray& request) {
+  if ((request.Length() != 1) || !request[0]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  File* file = CObjectToFilePointer(request[0]);
+  RefCntReleaseScope<File> rs(file);
+  if (file->IsClosed()) {
+    return CObject::FileClosedError();
+  }
+  return file->AdviseSequential() ? CObject::True() : CObject::NewOSError();
+}
+
 // Inspired by sdk/lib/core/uri.dart
 UriDecoder::UriDecoder(const char* uri) : uri_(uri) {
   const char* ch = uri;
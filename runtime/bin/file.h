@@ -35,6 +35,9 @@ class MappedMemory {
   intptr_t size() const { return size_; }
   uword start() const { return reinterpret_cast<uword>(address()); }
 
+  // Tells the OS that the mapping will be read sequentially.
+  void AdviseSequential();
+
  private:
   void Unmap();
 
@@ -143,6 +146,9 @@ class File : public ReferenceCounted<File> {
                     int64_t length,
                     void* start = nullptr);
 
+  // The alignment required for the 'position' passed to Map().
+  static intptr_t MapAlignment();
+
   // Read at most 'num_bytes' from the file. It may read less than 'num_bytes'
   // even when EOF is not encountered. If no data is available then `Read`
   // will block waiting for input (e.g. if the file represents a pipe that
@@ -182,6 +188,10 @@ class File : public ReferenceCounted<File> {
   // Set the byte position in the file.
   bool SetPosition(int64_t position);
 
+  // Tells the OS that the file will be read sequentially so that it can
+  // read ahead more aggressively. Returns false on failure.
+  bool AdviseSequential();
+
   // Truncate (or extend) the file to the given length in bytes.
   bool Truncate(int64_t length);
 
@@ -331,6 +341,7 @@ class File : public ReferenceCounted<File> {
   static CObject* IdenticalRequest(const CObjectArray& request);
   static CObject* StatRequest(const CObjectArray& request);
   static CObject* LockRequest(const CObjectArray& request);
+  static CObject* AdviseSequentialRequest(const CObjectArray& request);
 
  private:
   explicit File(FileHandle* handle)
@@ -111,6 +111,10 @@ MappedMemory* File::Map(MapType type,
   return new MappedMemory(addr, length, /*should_unmap=*/start == nullptr);
 }
 
+intptr_t File::MapAlignment() {
+  return sysconf(_SC_PAGESIZE);
+}
+
 void MappedMemory::Unmap() {
   int result = munmap(address_, size_);
   ASSERT(result == 0);
@@ -118,6 +122,10 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::AdviseSequential() {
+  // Read ahead is left to the VMO backing the mapping.
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return NO_RETRY_EXPECTED(read(handle_->fd(), buffer, num_bytes));
@@ -158,6 +166,12 @@ bool File::SetPosition(int64_t position) {
   return NO_RETRY_EXPECTED(lseek(handle_->fd(), position, SEEK_SET)) >= 0;
 }
 
+bool File::AdviseSequential() {
+  // Read ahead is left to the file system.
+  ASSERT(handle_->fd() >= 0);
+  return true;
+}
+
 bool File::Truncate(int64_t length) {
   ASSERT(handle_->fd() >= 0);
   return NO_RETRY_EXPECTED(ftruncate(handle_->fd(), length) != -1);
@@ -108,6 +108,10 @@ MappedMemory* File::Map(MapType type,
   return new MappedMemory(addr, length, /*should_unmap=*/start == nullptr);
 }
 
+intptr_t File::MapAlignment() {
+  return sysconf(_SC_PAGESIZE);
+}
+
 void MappedMemory::Unmap() {
   int result = munmap(address_, size_);
   ASSERT(result == 0);
@@ -115,6 +119,10 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::AdviseSequential() {
+  NO_RETRY_EXPECTED(madvise(address_, size_, MADV_SEQUENTIAL));
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
@@ -155,6 +163,18 @@ bool File::SetPosition(int64_t position) {
   return NO_RETRY_EXPECTED(lseek64(handle_->fd(), position, SEEK_SET)) >= 0;
 }
 
+bool File::AdviseSequential() {
+  ASSERT(handle_->fd() >= 0);
+  // posix_fadvise returns the error instead of setting errno.
+  const int result =
+      posix_fadvise(handle_->fd(), 0, 0, POSIX_FADV_SEQUENTIAL);
+  if (result != 0) {
+    errno = result;
+    return false;
+  }
+  return true;
+}
+
 bool File::Truncate(int64_t length) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(ftruncate64(handle_->fd(), length) != -1);
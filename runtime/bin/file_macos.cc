@@ -153,6 +153,10 @@ MappedMemory* File::Map(MapType type,
   return new MappedMemory(addr, length, /*should_unmap=*/start == nullptr);
 }
 
+intptr_t File::MapAlignment() {
+  return sysconf(_SC_PAGESIZE);
+}
+
 void MappedMemory::Unmap() {
   int result = munmap(address_, size_);
   ASSERT(result == 0);
@@ -160,6 +164,10 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::AdviseSequential() {
+  NO_RETRY_EXPECTED(madvise(address_, size_, MADV_SEQUENTIAL));
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
@@ -201,6 +209,11 @@ bool File::SetPosition(int64_t position) {
   return lseek(handle_->fd(), position, SEEK_SET) >= 0;
 }
 
+bool File::AdviseSequential() {
+  ASSERT(handle_->fd() >= 0);
+  return NO_RETRY_EXPECTED(fcntl(handle_->fd(), F_RDAHEAD, 1)) != -1;
+}
+
 bool File::Truncate(int64_t length) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(ftruncate(handle_->fd(), length)) != -1;
@@ -103,8 +103,11 @@ static int InotifyEventToMask(struct inotify_event* e) {
 Dart_Handle FileSystemWatcher::ReadEvents(intptr_t id, intptr_t path_id) {
   USE(path_id);
   const intptr_t kEventSize = sizeof(struct inotify_event);
-  const intptr_t kBufferSize = kEventSize + NAME_MAX + 1;
-  uint8_t buffer[kBufferSize];
+  // Read many events at once, so that a burst of changes in a large tree
+  // needs few reads and calls from Dart. A read returns at least one event
+  // if it fits the buffer.
+  const intptr_t kBufferSize = 64 * (kEventSize + NAME_MAX + 1);
+  alignas(struct inotify_event) uint8_t buffer[kBufferSize];
   intptr_t bytes =
       SocketBase::Read(id, buffer, kBufferSize, SocketBase::kAsync);
   if (bytes < 0) {
@@ -138,6 +138,11 @@ MappedMemory* File::Map(File::MapType type,
   return new MappedMemory(addr, length, /*should_unmap=*/start == nullptr);
 }
 
+intptr_t File::MapAlignment() {
+  // Map() reads the file into allocated memory, so any position will do.
+  return 1;
+}
+
 void MappedMemory::Unmap() {
   BOOL result = VirtualFree(address_, 0, MEM_RELEASE);
   ASSERT(result);
@@ -145,6 +150,10 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::AdviseSequential() {
+  // The mapping is already populated by Map().
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return Utils::Read(handle_->fd(), buffer, num_bytes);
@@ -224,6 +233,13 @@ bool File::SetPosition(int64_t position) {
                           /*lpNewFilePointer=*/nullptr, FILE_BEGIN);
 }
 
+bool File::AdviseSequential() {
+  // Sequential scans can only be requested when opening a file
+  // (FILE_FLAG_SEQUENTIAL_SCAN), so leave read ahead to the cache manager.
+  ASSERT(handle_->fd() >= 0);
+  return true;
+}
+
 bool File::Truncate(int64_t length) {
   if (!SetPosition(length)) {
     return false;
@@ -237,25 +237,47 @@ void FUNCTION_NAME(Filter_Processed)(Dart_NativeArguments args) {
     Dart_PropagateError(err);
   }
 
-  intptr_t read = filter->Processed(
-      filter->processed_buffer(), filter->processed_buffer_size(), flush, end);
+  uint8_t* buffer = filter->processed_buffer();
+  if (buffer == nullptr) {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    return;
+  }
+  const intptr_t size = filter->processed_buffer_size();
+  intptr_t read = filter->Processed(buffer, size, flush, end);
   if (read < 0) {
     Dart_ThrowException(
         DartUtils::NewDartFormatException("Filter error, bad data"));
   } else if (read == 0) {
     Dart_SetReturnValue(args, Dart_Null());
   } else {
-    uint8_t* io_buffer;
-    Dart_Handle result = IOBuffer::Allocate(read, &io_buffer);
-    if (Dart_IsNull(result)) {
-      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-      return;
+    // Hand the buffer to Dart instead of copying the processed bytes out of
+    // it. Shrink it when a good part of it is unused.
+    buffer = filter->ReleaseProcessedBuffer();
+    if ((size - read) >= (size >> 2)) {
+      uint8_t* shrunk = IOBuffer::Reallocate(buffer, read);
+      if (shrunk != nullptr) {
+        buffer = shrunk;
+      }
+    }
+    Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+        Dart_TypedData_kUint8, buffer, read, buffer, read, IOBuffer::Finalizer);
+    if (Dart_IsError(result)) {
+      IOBuffer::Free(buffer);
+      Dart_PropagateError(result);
     }
-    memmove(io_buffer, filter->processed_buffer(), read);
     Dart_SetReturnValue(args, result);
   }
 }
 
+uint8_t* Filter::processed_buffer() {
+  if (processed_buffer_ == nullptr) {
+    // Not cleared, as only the bytes written by Processed are handed out.
+    processed_buffer_ =
+        reinterpret_cast<uint8_t*>(malloc(processed_buffer_size()));
+  }
+  return processed_buffer_;
+}
+
 static void DeleteFilter(void* isolate_data, void* filter_pointer) {
   Filter* filter = reinterpret_cast<Filter*>(filter_pointer);
   delete filter;
@@ -270,8 +292,10 @@ Dart_Handle Filter::SetFilterAndCreateFinalizer(Dart_Handle filter,
   if (Dart_IsError(err)) {
     return err;
   }
+  // Account for the processed buffer, which is allocated separately.
   Dart_NewFinalizableHandle(filter, reinterpret_cast<void*>(filter_pointer),
-                            size, DeleteFilter);
+                            size + filter_pointer->processed_buffer_size(),
+                            DeleteFilter);
   return err;
 }
 
@@ -15,7 +15,7 @@ namespace bin {
 
 class Filter {
  public:
-  virtual ~Filter() {}
+  virtual ~Filter() { free(processed_buffer_); }
 
   virtual bool Init() = 0;
 
@@ -38,15 +38,26 @@ class Filter {
 
   bool initialized() const { return initialized_; }
   void set_initialized(bool value) { initialized_ = value; }
-  uint8_t* processed_buffer() { return processed_buffer_; }
+
+  // Returns the buffer to pass to Processed, or nullptr if it cannot be
+  // allocated. The buffer is reused until it is released.
+  uint8_t* processed_buffer();
   intptr_t processed_buffer_size() const { return kFilterBufferSize; }
 
+  // Transfers ownership of the processed buffer to the caller, who must free
+  // it with IOBuffer::Free.
+  uint8_t* ReleaseProcessedBuffer() {
+    uint8_t* buffer = processed_buffer_;
+    processed_buffer_ = nullptr;
+    return buffer;
+  }
+
  protected:
-  Filter() : initialized_(false) {}
+  Filter() : processed_buffer_(nullptr), initialized_(false) {}
 
  private:
   static constexpr intptr_t kFilterBufferSize = 64 * KB;
-  uint8_t processed_buffer_[kFilterBufferSize];
+  uint8_t* processed_buffer_;
   bool initialized_;
 
   DISALLOW_COPY_AND_ASSIGN(Filter);
@@ -5,6 +5,7 @@
 // Generate a snapshot file after loading all the scripts specified on the
 // command line.
 
+#include <setjmp.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -40,7 +41,7 @@ namespace bin {
 
 #define CHECK_RESULT(result)                                                   \
   if (Dart_IsError(result)) {                                                  \
-    intptr_t exit_code = 0;                                                    \
+    int exit_code = 0;                                                         \
     Syslog::PrintErr("Error: %s\n", Dart_GetError(result));                    \
     if (Dart_IsCompilationError(result)) {                                     \
       exit_code = kCompilationErrorExitCode;                                   \
@@ -49,9 +50,7 @@ namespace bin {
     } else {                                                                   \
       exit_code = kErrorExitCode;                                              \
     }                                                                          \
-    Dart_ExitScope();                                                          \
-    Dart_ShutdownIsolate();                                                    \
-    exit(exit_code);                                                           \
+    ShutdownIsolateAndExit(exit_code);                                         \
   }
 
 // The environment provided through the command line using -D options.
@@ -117,6 +116,7 @@ static const char* const kSnapshotKindNames[] = {
   V(compile_all, compile_all)                                                  \
   V(help, help)                                                                \
   V(obfuscate, obfuscate)                                                      \
+  V(serve, serve)                                                              \
   V(strip, strip)                                                              \
   V(verbose, verbose)                                                          \
   V(version, version)
@@ -183,6 +183,15 @@ static void PrintUsage() {
 "using --save-obfuscation-map=<filename> option. See dartbug.com/30524       \n"
 "for implementation details and limitations of the obfuscation pass.         \n"
 "                                                                            \n"
+"To serve snapshot requests from a single VM:                                \n"
+"--serve                                                                     \n"
+"--snapshot_kind=<kind>                                                      \n"
+"[--load_vm_snapshot_data=<file> and the other --load options]               \n"
+"  Every line read from stdin is a request holding the options and inputs of \n"
+"  one snapshot of the given kind, separated by whitespace. The exit code of \n"
+"  each request is written to stdout on a line of its own. VM flags, the     \n"
+"  snapshot kind and the snapshots to load are fixed for all requests.       \n"
+"                                                                            \n"
 "\n");
   if (verbose) {
     Syslog::PrintErr(
@@ -195,6 +204,8 @@ static void PrintUsage() {
 }
 // clang-format on
 
+static int CheckSnapshotOptions(const CommandLineOptions& inputs);
+
 // Parse out the command line arguments. Returns -1 if the arguments
 // are incorrect, 0 otherwise.
 static int ParseArguments(int argc,
@@ -228,8 +239,23 @@ static int ParseArguments(int argc,
     Platform::Exit(0);
   }
 
-  // Verify consistency of arguments.
-  if (inputs->count() < 1) {
+  if (serve) {
+    // Everything else is specified by the requests.
+    if ((inputs->count() > 0) || (environment != nullptr)) {
+      Syslog::PrintErr(
+          "Inputs and -D options are specified by the requests of --serve.\n");
+      return -1;
+    }
+    return 0;
+  }
+
+  return CheckSnapshotOptions(*inputs);
+}
+
+// Verify consistency of the options of a snapshot. Returns -1 if they are
+// incorrect, 0 otherwise.
+static int CheckSnapshotOptions(const CommandLineOptions& inputs) {
+  if (inputs.count() < 1) {
     Syslog::PrintErr("At least one input is required\n");
     return -1;
   }
@@ -324,15 +350,33 @@ static int ParseArguments(int argc,
   return 0;
 }
 
+// Set while serving a request of --serve, so that errors fail the request
+// instead of exiting.
+static jmp_buf* request_error_jump = nullptr;
+static int request_exit_code = 0;
+
+// Shuts down the current isolate, if any, and exits with [exit_code]. While
+// serving a request, this returns to ServeRequest instead. Resources held by
+// the frames in between are not released.
+static void ShutdownIsolateAndExit(int exit_code) {
+  if (Dart_CurrentIsolate() != nullptr) {
+    Dart_ExitScope();
+    Dart_ShutdownIsolate();
+  }
+  if (request_error_jump != nullptr) {
+    request_exit_code = exit_code;
+    longjmp(*request_error_jump, 1);
+  }
+  exit(exit_code);
+}
+
 PRINTF_ATTRIBUTE(1, 2) static void PrintErrAndExit(const char* format, ...) {
   va_list args;
   va_start(args, format);
   Syslog::VPrintErr(format, args);
   va_end(args);
 
-  Dart_ExitScope();
-  Dart_ShutdownIsolate();
-  exit(kErrorExitCode);
+  ShutdownIsolateAndExit(kErrorExitCode);
 }
 
 static File* OpenFile(const char* filename) {
@@ -730,10 +774,15 @@ static void CreateAndWritePrecompiledSnapshot() {
   }
 }
 
-static int CreateIsolateAndSnapshot(const CommandLineOptions& inputs) {
+static int CreateIsolateAndSnapshot(const CommandLineOptions& inputs,
+                                    IsolateGroupData* isolate_group_data) {
   uint8_t* kernel_buffer = nullptr;
   intptr_t kernel_buffer_size = 0;
   ReadFile(inputs.GetArgument(0), &kernel_buffer, &kernel_buffer_size);
+  // The caller owns the isolate group data, so the kernel is also freed when
+  // a request of --serve fails.
+  isolate_group_data->SetKernelBufferNewlyOwned(kernel_buffer,
+                                                kernel_buffer_size);
 
   Dart_IsolateFlags isolate_flags;
   Dart_IsolateFlagsInitialize(&isolate_flags);
@@ -744,8 +793,6 @@ static int CreateIsolateAndSnapshot(const CommandLineOptions& inputs) {
     isolate_flags.obfuscate = obfuscate;
   }
 
-  auto isolate_group_data = std::unique_ptr<IsolateGroupData>(
-      new IsolateGroupData(nullptr, nullptr, nullptr, false));
   Dart_Isolate isolate;
   char* error = nullptr;
 
@@ -756,18 +803,17 @@ static int CreateIsolateAndSnapshot(const CommandLineOptions& inputs) {
     isolate_flags.load_vmservice_library = true;
     isolate = Dart_CreateIsolateGroupFromKernel(
         nullptr, nullptr, kernel_buffer, kernel_buffer_size, &isolate_flags,
-        isolate_group_data.get(), /*isolate_data=*/nullptr, &error);
+        isolate_group_data, /*isolate_data=*/nullptr, &error);
     loading_kernel_failed = (isolate == nullptr);
   } else {
     isolate = Dart_CreateIsolateGroup(nullptr, nullptr, isolate_snapshot_data,
                                       isolate_snapshot_instructions,
-                                      &isolate_flags, isolate_group_data.get(),
+                                      &isolate_flags, isolate_group_data,
                                       /*isolate_data=*/nullptr, &error);
   }
   if (isolate == nullptr) {
     Syslog::PrintErr("%s\n", error);
     free(error);
-    free(kernel_buffer);
     // The only real reason when `gen_snapshot` fails to create an isolate from
     // a valid kernel file is if loading the kernel results in a "compile-time"
     // error.
@@ -838,8 +884,140 @@ static int CreateIsolateAndSnapshot(const CommandLineOptions& inputs) {
 
   Dart_ExitScope();
   Dart_ShutdownIsolate();
+  return 0;
+}
+
+// Resets the options that every request of --serve specifies for itself.
+static void ResetRequestOptions() {
+  vm_snapshot_data_filename = nullptr;
+  vm_snapshot_instructions_filename = nullptr;
+  isolate_snapshot_data_filename = nullptr;
+  isolate_snapshot_instructions_filename = nullptr;
+  blobs_container_filename = nullptr;
+  assembly_filename = nullptr;
+  elf_filename = nullptr;
+  loading_unit_manifest_filename = nullptr;
+  debugging_info_filename = nullptr;
+  obfuscation_map_filename = nullptr;
+  compile_all = false;
+  obfuscate = false;
+  strip = false;
+  if (environment != nullptr) {
+    for (SimpleHashMap::Entry* p = environment->Start(); p != nullptr;
+         p = environment->Next(p)) {
+      free(p->key);
+      free(p->value);
+    }
+    delete environment;
+    environment = nullptr;
+  }
+}
 
-  free(kernel_buffer);
+// Parses a request of --serve into the options above and [inputs]. Returns -1
+// if the request is incorrect, 0 otherwise.
+static int ParseRequest(const CommandLineOptions& arguments,
+                        CommandLineOptions* inputs) {
+  ResetRequestOptions();
+  const SnapshotKind server_snapshot_kind = snapshot_kind;
+  const char* const server_snapshots[] = {
+      load_vm_snapshot_data_filename, load_vm_snapshot_instructions_filename,
+      load_isolate_snapshot_data_filename,
+      load_isolate_snapshot_instructions_filename};
+
+  // The options of gen_snapshot do not add VM flags, so these are ignored.
+  CommandLineOptions vm_options(arguments.count());
+  int i = 0;
+  while ((i < arguments.count()) &&
+         OptionProcessor::IsValidShortFlag(arguments.GetArgument(i))) {
+    if (!OptionProcessor::TryProcess(arguments.GetArgument(i), &vm_options)) {
+      Syslog::PrintErr("VM flags cannot be changed by a request: %s\n",
+                       arguments.GetArgument(i));
+      return -1;
+    }
+    i++;
+  }
+  while (i < arguments.count()) {
+    inputs->AddArgument(arguments.GetArgument(i));
+    i++;
+  }
+  DartUtils::SetEnvironment(environment);
+
+  if ((snapshot_kind != server_snapshot_kind) ||
+      (load_vm_snapshot_data_filename != server_snapshots[0]) ||
+      (load_vm_snapshot_instructions_filename != server_snapshots[1]) ||
+      (load_isolate_snapshot_data_filename != server_snapshots[2]) ||
+      (load_isolate_snapshot_instructions_filename != server_snapshots[3])) {
+    Syslog::PrintErr(
+        "The snapshot kind and the snapshots to load cannot be changed by a "
+        "request.\n");
+    return -1;
+  }
+  return CheckSnapshotOptions(*inputs);
+}
+
+static int ServeRequest(const CommandLineOptions& inputs) {
+  IsolateGroupData isolate_group_data(nullptr, nullptr, nullptr, false);
+  jmp_buf error_jump;
+  if (setjmp(error_jump) != 0) {
+    request_error_jump = nullptr;
+    return request_exit_code;
+  }
+  request_error_jump = &error_jump;
+  const int result = CreateIsolateAndSnapshot(inputs, &isolate_group_data);
+  request_error_jump = nullptr;
+  return result;
+}
+
+// Reads a line from stdin into [line], without its terminator. Returns false
+// at the end of the input.
+static bool ReadRequestLine(TextBuffer* line) {
+  line->Clear();
+  int ch;
+  while (((ch = fgetc(stdin)) != EOF) && (ch != '\n')) {
+    if (ch != '\r') {
+      line->AddChar(ch);
+    }
+  }
+  return (ch != EOF) || (line->length() > 0);
+}
+
+// Serves the requests read from stdin until its end (see --serve), so that
+// the VM is initialized and the snapshots to load are mapped only once for
+// all of them. Every request creates and snapshots an isolate group of its
+// own.
+static int ServeRequests() {
+  TextBuffer line(KB);
+  while (ReadRequestLine(&line)) {
+    // Split the request at whitespace. The arguments point into [line].
+    CommandLineOptions arguments(line.length() / 2 + 1);
+    auto is_space = [](char ch) { return (ch == ' ') || (ch == '\t'); };
+    char* cursor = line.buffer();
+    while (*cursor != '\0') {
+      while (is_space(*cursor)) {
+        *cursor++ = '\0';
+      }
+      if (*cursor != '\0') {
+        arguments.AddArgument(cursor);
+      }
+      while ((*cursor != '\0') && !is_space(*cursor)) {
+        cursor++;
+      }
+    }
+    if (arguments.count() == 0) {
+      continue;
+    }
+
+    CommandLineOptions inputs(arguments.count());
+    int result = ParseRequest(arguments, &inputs);
+    if (result == 0) {
+      result = ServeRequest(inputs);
+    } else {
+      result = kErrorExitCode;
+    }
+    printf("%d\n", result);
+    fflush(stdout);
+  }
+  ResetRequestOptions();
   return 0;
 }
 
@@ -938,7 +1116,13 @@ int main(int argc, char** argv) {
     return kErrorExitCode;
   }
 
-  int result = CreateIsolateAndSnapshot(inputs);
+  int result;
+  if (serve) {
+    result = ServeRequests();
+  } else {
+    IsolateGroupData isolate_group_data(nullptr, nullptr, nullptr, false);
+    result = CreateIsolateAndSnapshot(inputs, &isolate_group_data);
+  }
   if (result != 0) {
     return result;
   }
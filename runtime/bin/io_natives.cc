@@ -46,18 +46,16 @@ namespace bin {
   V(File_Exists, 2)                                                            \
   V(File_Flush, 1)                                                             \
   V(File_GetPointer, 1)                                                        \
-  V(File_GetFD, 1)                                                             \
   V(File_GetStdioHandleType, 1)                                                \
   V(File_GetType, 3)                                                           \
   V(File_LastAccessed, 2)                                                      \
   V(File_LastModified, 2)                                                      \
-  V(File_Length, 1)                                                            \
   V(File_LengthFromPath, 2)                                                    \
   V(File_LinkTarget, 2)                                                        \
   V(File_Lock, 4)                                                              \
+  V(File_Map, 4)                                                               \
   V(File_Open, 3)                                                              \
   V(File_OpenStdio, 1)                                                         \
-  V(File_Position, 1)                                                          \
   V(File_Read, 2)                                                              \
   V(File_ReadByte, 1)                                                          \
   V(File_ReadInto, 4)                                                          \
@@ -67,7 +65,6 @@ namespace bin {
   V(File_SetLastAccessed, 3)                                                   \
   V(File_SetLastModified, 3)                                                   \
   V(File_SetPointer, 2)                                                        \
-  V(File_SetPosition, 2)                                                       \
   V(File_Stat, 2)                                                              \
   V(File_Truncate, 2)                                                          \
   V(File_WriteByte, 2)                                                         \
@@ -143,7 +140,6 @@ namespace bin {
   V(ServerSocket_CreateBindListen, 7)                                          \
   V(ServerSocket_CreateUnixDomainBindListen, 5)                                \
   V(SocketBase_IsBindError, 2)                                                 \
-  V(Socket_Available, 1)                                                       \
   V(Socket_AvailableDatagram, 1)                                               \
   V(Socket_CreateBindConnect, 6)                                               \
   V(Socket_CreateUnixDomainBindConnect, 4)                                     \
@@ -204,7 +200,18 @@ namespace bin {
   V(X509_StartValidity, 1)                                                     \
   V(X509_EndValidity, 1)
 
+// Lists the dart:io natives bound with @FfiNative. These take unboxed
+// arguments and the native peer of a NativeFieldWrapperClass1 receiver as a
+// pointer, so hot paths avoid Dart_NativeArguments and handle allocation.
+#define IO_FFI_NATIVE_LIST(V)                                                  \
+  V(File_GetFD, intptr_t, (void*))                                             \
+  V(File_Length, Dart_Handle, (void*))                                         \
+  V(File_Position, Dart_Handle, (void*))                                       \
+  V(File_SetPosition, Dart_Handle, (void*, int64_t))                           \
+  V(Socket_Available, intptr_t, (void*))
+
 IO_NATIVE_LIST(DECLARE_FUNCTION);
+IO_FFI_NATIVE_LIST(DECLARE_FFI_FUNCTION);
 
 static const struct NativeEntries {
   const char* name_;
@@ -212,6 +219,11 @@ static const struct NativeEntries {
   int argument_count_;
 } IOEntries[] = {IO_NATIVE_LIST(REGISTER_FUNCTION)};
 
+static const struct FfiNativeEntries {
+  const char* name_;
+  void* function_;
+} IOFfiEntries[] = {IO_FFI_NATIVE_LIST(REGISTER_FFI_FUNCTION)};
+
 Dart_NativeFunction IONativeLookup(Dart_Handle name,
                                    int argument_count,
                                    bool* auto_setup_scope) {
@@ -243,5 +255,16 @@ const uint8_t* IONativeSymbol(Dart_NativeFunction nf) {
   return nullptr;
 }
 
+void* IOFfiNativeLookup(const char* name, uintptr_t argument_count) {
+  int num_entries = sizeof(IOFfiEntries) / sizeof(struct FfiNativeEntries);
+  for (int i = 0; i < num_entries; i++) {
+    const struct FfiNativeEntries* entry = &(IOFfiEntries[i]);
+    if (strcmp(name, entry->name_) == 0) {
+      return entry->function_;
+    }
+  }
+  return nullptr;
+}
+
 }  // namespace bin
 }  // namespace dart
@@ -0,0 +1,159 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/kernel_cache.h"
+
+#include <memory>
+
+#include "bin/directory.h"
+#include "bin/file.h"
+#include "bin/process.h"
+#include "include/dart_api.h"
+#include "platform/text_buffer.h"
+#include "platform/utils.h"
+
+namespace dart {
+namespace bin {
+
+static constexpr const char* kMagic = "dart-kernel-cache 1\n";
+
+KernelCache::KernelCache(const char* cache_dir, const char* key)
+    : filename_(nullptr), key_(Utils::StrDup(key)) {
+  const uint32_t hash = Utils::StringHash(key, strlen(key));
+  filename_ = Utils::SCreate("%s%s%08x.dill", cache_dir,
+                             File::PathSeparator(), hash);
+  // The directory usually exists already. If it cannot be created, storing
+  // fails and is ignored.
+  Directory::Create(nullptr, cache_dir);
+}
+
+KernelCache::~KernelCache() {
+  free(filename_);
+  free(key_);
+}
+
+// Returns whether the file at [path] still has the given modification time
+// and size.
+static bool IsUnchanged(const char* path, int64_t modified, int64_t size) {
+  int64_t stat[File::kStatSize];
+  File::Stat(nullptr, path, stat);
+  return (stat[File::kType] == File::kIsFile) &&
+         (stat[File::kModifiedTime] == modified) && (stat[File::kSize] == size);
+}
+
+uint8_t* KernelCache::Lookup(intptr_t* kernel_size) const {
+  File* file = File::Open(nullptr, filename_, File::kRead);
+  if (file == nullptr) {
+    return nullptr;
+  }
+  const int64_t length = file->Length();
+  uint8_t* buffer = (length > 0) ? reinterpret_cast<uint8_t*>(malloc(length))
+                                 : nullptr;
+  const bool read = (buffer != nullptr) && file->ReadFully(buffer, length);
+  file->Release();
+  if (!read) {
+    free(buffer);
+    return nullptr;
+  }
+
+  // Validates the header and returns the offset of the kernel, or -1.
+  auto parse_header = [&]() -> intptr_t {
+    const char* cursor = reinterpret_cast<const char*>(buffer);
+    const char* end = cursor + length;
+    const intptr_t magic_length = strlen(kMagic);
+    const intptr_t key_length = strlen(key_) + 1;
+    if ((end - cursor < magic_length + key_length) ||
+        (memcmp(cursor, kMagic, magic_length) != 0) ||
+        (memcmp(cursor + magic_length, key_, key_length) != 0)) {
+      return -1;
+    }
+    cursor += magic_length + key_length;
+    // Every dependency is on a line of its own: "<modified> <size> <path>".
+    const char* line_end;
+    while ((line_end = static_cast<const char*>(
+                memchr(cursor, '\n', end - cursor))) != cursor) {
+      if (line_end == nullptr) {
+        return -1;
+      }
+      char* line = Utils::StrNDup(cursor, line_end - cursor);
+      char* path = nullptr;
+      const int64_t modified = strtoll(line, &path, 10);
+      const int64_t size = strtoll(path, &path, 10);
+      const bool unchanged =
+          (*path == ' ') && IsUnchanged(path + 1, modified, size);
+      free(line);
+      if (!unchanged) {
+        return -1;
+      }
+      cursor = line_end + 1;
+    }
+    // Skip the empty line ending the dependencies.
+    return (cursor + 1) - reinterpret_cast<const char*>(buffer);
+  };
+  const intptr_t offset = parse_header();
+  if ((offset < 0) || !Dart_IsKernel(buffer + offset, length - offset)) {
+    free(buffer);
+    return nullptr;
+  }
+  *kernel_size = length - offset;
+  memmove(buffer, buffer + offset, *kernel_size);
+  return buffer;
+}
+
+void KernelCache::Store(const uint8_t* kernel,
+                        intptr_t kernel_size,
+                        const char* dependencies,
+                        intptr_t dependencies_size) const {
+  TextBuffer header(4 * KB);
+  header.AddString(kMagic);
+  header.AddRaw(reinterpret_cast<const uint8_t*>(key_), strlen(key_) + 1);
+
+  // The dependencies are separated by spaces, and spaces and backslashes in
+  // paths are escaped with backslashes.
+  std::unique_ptr<char[]> path(new char[dependencies_size + 1]);
+  intptr_t i = 0;
+  while (i < dependencies_size) {
+    intptr_t path_length = 0;
+    for (; (i < dependencies_size) && (dependencies[i] != ' '); i++) {
+      if ((dependencies[i] == '\\') && (i + 1 < dependencies_size)) {
+        i++;
+      }
+      path[path_length++] = dependencies[i];
+    }
+    i++;  // Skip the separator.
+    if (path_length == 0) {
+      continue;
+    }
+    path[path_length] = '\0';
+    if (strchr(path.get(), '\n') != nullptr) {
+      return;
+    }
+    int64_t stat[File::kStatSize];
+    File::Stat(nullptr, path.get(), stat);
+    if (stat[File::kType] != File::kIsFile) {
+      return;
+    }
+    header.Printf("%" Pd64 " %" Pd64 " %s\n", stat[File::kModifiedTime],
+                  stat[File::kSize], path.get());
+  }
+  header.AddChar('\n');
+
+  // Write a temporary file and rename it, so that concurrent runs never see
+  // a partially written entry.
+  char* temp_filename = Utils::SCreate("%s.%" Pd ".tmp", filename_,
+                                       Process::CurrentProcessId());
+  File* file = File::Open(nullptr, temp_filename, File::kWriteTruncate);
+  if (file != nullptr) {
+    const bool written = file->WriteFully(header.buffer(), header.length()) &&
+                         file->WriteFully(kernel, kernel_size);
+    file->Release();
+    if (!written || !File::Rename(nullptr, temp_filename, filename_)) {
+      File::Delete(nullptr, temp_filename);
+    }
+  }
+  free(temp_filename);
+}
+
+}  // namespace bin
+}  // namespace dart
@@ -0,0 +1,50 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_KERNEL_CACHE_H_
+#define RUNTIME_BIN_KERNEL_CACHE_H_
+
+#include "platform/globals.h"
+
+namespace dart {
+namespace bin {
+
+// Caches the kernel that the frontend compiles for a script in a directory
+// shared by all runs that use it (--kernel-cache), so that running a script
+// whose sources did not change skips the frontend.
+//
+// Each entry is a single file named by a hash of its key, which describes
+// everything besides the sources that the compilation depends on (VM version,
+// script, package config and VM flags). The file holds the key, then the
+// modification time and size of every source file and package config that
+// the compilation read, then the kernel. It is only used if none of these
+// files changed.
+class KernelCache {
+ public:
+  KernelCache(const char* cache_dir, const char* key);
+  ~KernelCache();
+
+  // Returns the cached kernel if it is still valid, or nullptr. The caller
+  // owns the returned buffer.
+  uint8_t* Lookup(intptr_t* kernel_size) const;
+
+  // Stores [kernel], compiled from the files listed in [dependencies] in the
+  // format of Dart_KernelListDependencies. Failures are ignored: the next run
+  // compiles the script again.
+  void Store(const uint8_t* kernel,
+             intptr_t kernel_size,
+             const char* dependencies,
+             intptr_t dependencies_size) const;
+
+ private:
+  char* filename_;
+  char* key_;
+
+  DISALLOW_COPY_AND_ASSIGN(KernelCache);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // RUNTIME_BIN_KERNEL_CACHE_H_
@@ -22,6 +22,7 @@
 #include "bin/file.h"
 #include "bin/gzip.h"
 #include "bin/isolate_data.h"
+#include "bin/kernel_cache.h"
 #include "bin/loader.h"
 #include "bin/main_options.h"
 #include "bin/platform.h"
@@ -74,6 +75,10 @@ static const uint8_t* app_isolate_snapshot_instructions = nullptr;
 static bool kernel_isolate_is_running = false;
 
 static Dart_Isolate main_isolate = nullptr;
+#if !defined(DART_PRECOMPILED_RUNTIME)
+// The --kernel-cache entry for the main script, if it runs from source.
+static KernelCache* kernel_cache = nullptr;
+#endif
 
 #define SAVE_ERROR_AND_EXIT(result)                                            \
   *error = Utils::StrDup(Dart_GetError(result));                               \
@@ -133,6 +138,85 @@ static void WriteDepsFile() {
   file->Release();
 }
 
+// A --jit-cache snapshot is only reused by the VM that wrote it, which is
+// recorded in a stamp file next to it once the snapshot is complete.
+static char* JitCacheStampFilename() {
+  return Utils::SCreate("%s.stamp", Options::jit_cache_filename());
+}
+
+static void WriteJitCacheStamp() {
+  if (Options::jit_cache_filename() == nullptr) {
+    return;
+  }
+  char* stamp_filename = JitCacheStampFilename();
+  File* file = File::Open(nullptr, stamp_filename, File::kWriteTruncate);
+  free(stamp_filename);
+  if (file == nullptr) {
+    // The cache is best effort: the next run trains it again.
+    return;
+  }
+  const char* version = Dart_VersionString();
+  file->WriteFully(version, strlen(version));
+  file->Release();
+}
+
+static bool IsJitCacheUsable(const char* script_name) {
+  const time_t cache_time =
+      File::LastModified(nullptr, Options::jit_cache_filename());
+  const time_t script_time = File::LastModified(nullptr, script_name);
+  if ((cache_time < 0) || (script_time < 0) || (cache_time < script_time)) {
+    return false;
+  }
+  char* stamp_filename = JitCacheStampFilename();
+  File* file = File::Open(nullptr, stamp_filename, File::kRead);
+  free(stamp_filename);
+  if (file == nullptr) {
+    return false;
+  }
+  RefCntReleaseScope<File> rs(file);
+  const char* version = Dart_VersionString();
+  const intptr_t length = strlen(version);
+  if (file->Length() != length) {
+    return false;
+  }
+  std::unique_ptr<char[]> contents(new char[length]);
+  return file->ReadFully(contents.get(), length) &&
+         (memcmp(contents.get(), version, length) == 0);
+}
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+// Besides the sources, the kernel compiled for a script depends on the VM
+// and its flags.
+static KernelCache* CreateKernelCache(const char* script_name,
+                                      const CommandLineOptions& vm_options) {
+  char script_path[PATH_MAX];
+  if (File::GetCanonicalPath(nullptr, script_name, script_path, PATH_MAX) ==
+      nullptr) {
+    return nullptr;
+  }
+  const char* packages_file = Options::packages_file();
+  TextBuffer key(KB);
+  key.Printf("%s\n%s\n%s", Dart_VersionString(), script_path,
+             (packages_file != nullptr) ? packages_file : "");
+  for (int i = 0; i < vm_options.count(); i++) {
+    key.Printf("\n%s", vm_options.arguments()[i]);
+  }
+  return new KernelCache(Options::kernel_cache_dir(), key.buffer());
+}
+
+// Must be called in the main isolate right after compiling the script.
+static void StoreKernelCache(const uint8_t* kernel, intptr_t kernel_size) {
+  Dart_KernelCompilationResult result = Dart_KernelListDependencies();
+  if (result.status == Dart_KernelCompilationStatus_Ok) {
+    kernel_cache->Store(kernel, kernel_size,
+                        reinterpret_cast<const char*>(result.kernel),
+                        result.kernel_size);
+  }
+  free(result.kernel);
+  free(result.error);
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 static void OnExitHook(int64_t exit_code) {
   if (Dart_CurrentIsolate() != main_isolate) {
     Syslog::PrintErr(
@@ -144,6 +228,7 @@ static void OnExitHook(int64_t exit_code) {
   if (exit_code == 0) {
     if (Options::gen_snapshot_kind() == kAppJIT) {
       Snapshot::GenerateAppJIT(Options::snapshot_filename());
+      WriteJitCacheStamp();
     }
     WriteDepsFile();
   }
@@ -310,6 +395,9 @@ static Dart_Isolate IsolateSetupHelper(Dart_Isolate isolate,
         application_kernel_buffer, application_kernel_buffer_size);
     kernel_buffer = application_kernel_buffer;
     kernel_buffer_size = application_kernel_buffer_size;
+    if (is_main_isolate && (kernel_cache != nullptr)) {
+      StoreKernelCache(kernel_buffer, kernel_buffer_size);
+    }
   }
   if (kernel_buffer != nullptr) {
     Dart_Handle uri = Dart_NewStringFromCString(script_uri);
@@ -751,6 +839,15 @@ static Dart_Isolate CreateIsolateGroupAndSetupHelper(
     kernel_buffer_size = parent_isolate_group_data->kernel_buffer_size();
   }
 
+  if ((kernel_buffer == nullptr) && !isolate_run_app_snapshot &&
+      is_main_isolate && (kernel_cache != nullptr)) {
+    kernel_buffer = kernel_cache->Lookup(&kernel_buffer_size);
+    if (kernel_buffer != nullptr) {
+      // The cached kernel is still valid, so there is nothing to store.
+      delete kernel_cache;
+      kernel_cache = nullptr;
+    }
+  }
   if (kernel_buffer == nullptr && !isolate_run_app_snapshot) {
     dfe.ReadScript(script_uri, &kernel_buffer, &kernel_buffer_size,
                    /*decode_uri=*/true, &kernel_buffer_ptr);
@@ -1097,6 +1194,7 @@ void RunMainIsolate(const char* script_name,
   if (Options::gen_snapshot_kind() == kAppJIT) {
     if (!Dart_IsCompilationError(result)) {
       Snapshot::GenerateAppJIT(Options::snapshot_filename());
+      WriteJitCacheStamp();
     }
   }
   CHECK_RESULT(result);
@@ -1273,6 +1371,20 @@ void main(int argc, char** argv) {
     if (!CheckForInvalidPath(script_name)) {
       Platform::Exit(0);
     }
+    if (Options::jit_cache_filename() != nullptr) {
+      if (IsJitCacheUsable(script_name)) {
+        app_snapshot = Snapshot::TryReadAppSnapshot(
+            Options::jit_cache_filename(), /*force_load_elf_from_memory=*/false,
+            /*decode_uri=*/false);
+      }
+      if (app_snapshot == nullptr) {
+        // Invalidate the cache until the new snapshot is completely written.
+        char* stamp_filename = JitCacheStampFilename();
+        File::Delete(nullptr, stamp_filename);
+        free(stamp_filename);
+        Options::TrainJitCache();
+      }
+    }
     try_load_snapshots_lambda();
   }
 
@@ -1322,6 +1434,12 @@ void main(int argc, char** argv) {
       dfe.set_application_kernel_buffer(application_kernel_buffer,
                                         application_kernel_buffer_size);
       Options::dfe()->set_use_dfe();
+    } else if (!vm_run_app_snapshot &&
+               (Options::kernel_cache_dir() != nullptr) &&
+               (Options::depfile() == nullptr)) {
+      // A depfile lists the sources the frontend read, so it needs a
+      // compilation.
+      kernel_cache = CreateKernelCache(script_name, vm_options);
     }
   }
 #endif
@@ -10,6 +10,7 @@
 
 #include "bin/dartdev_isolate.h"
 #include "bin/error_exit.h"
+#include "bin/eventhandler.h"
 #include "bin/file_system_watcher.h"
 #include "bin/options.h"
 #include "bin/platform.h"
@@ -80,6 +81,14 @@ ENUM_OPTIONS_LIST(ENUM_OPTION_DEFINITION)
 CB_OPTIONS_LIST(CB_OPTION_DEFINITION)
 #undef CB_OPTION_DEFINITION
 
+DEFINE_STRING_OPTION_CB(event_handler_threads, {
+  EventHandler::set_thread_count(atoi(value));
+});
+
+DEFINE_STRING_OPTION_CB(dns_cache_ttl, {
+  Socket::set_lookup_cache_seconds(atoi(value));
+});
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
 DFE* Options::dfe_ = nullptr;
 
@@ -178,6 +187,13 @@ void Options::PrintUsage() {
 "    <snapshot-kind> controls the kind of snapshot, it could be\n"
 "                    kernel(default) or app-jit\n"
 "    <file_name> specifies the file into which the snapshot is written\n"
+"--jit-cache=<file_name>\n"
+"  Run from the app-jit snapshot in <file_name> if this VM wrote it after\n"
+"  the script last changed. Otherwise run the script from source and write\n"
+"  the snapshot there when it exits normally.\n"
+"--kernel-cache=<directory>\n"
+"  Reuse the kernel compiled for the script by an earlier run sharing\n"
+"  <directory> if none of its sources changed, instead of compiling it.\n"
 "--version\n"
 "  Print the SDK version.\n");
   } else {
@@ -237,6 +253,9 @@ void Options::PrintUsage() {
 "--root-certs-cache=<path>\n"
 "  The path to a cache directory containing the trusted root certificates to\n"
 "  use for secure socket connections.\n"
+"--dns-cache-ttl=<seconds>\n"
+"  Reuse the addresses found for a host name for the given number of seconds\n"
+"  in all isolates, instead of resolving the name on every lookup.\n"
 #if defined(DART_HOST_OS_LINUX) || \
     defined(DART_HOST_OS_ANDROID) || \
     defined(DART_HOST_OS_FUCHSIA)
@@ -244,6 +263,14 @@ void Options::PrintUsage() {
 "  The path to a directory that dart:io calls will treat as the root of the\n"
 "  filesystem.\n"
 #endif  // defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+#if defined(DART_HOST_OS_LINUX)
+"--enable-io-uring\n"
+"  Use io_uring instead of epoll for dart:io event notifications when the\n"
+"  kernel supports it (Linux 5.13 or later).\n"
+"--event-handler-threads=<count>\n"
+"  The number of threads dispatching dart:io events (defaults to 1).\n"
+"  Sockets are spread over the threads by their file descriptor.\n"
+#endif  // defined(DART_HOST_OS_LINUX)
 "\n"
 "The following options are only used for VM development and may\n"
 "be changed in any future version:\n");
@@ -516,6 +543,7 @@ bool Options::ParseArguments(int argc,
 
   Socket::set_short_socket_read(Options::short_socket_read());
   Socket::set_short_socket_write(Options::short_socket_write());
+  EventHandler::set_use_io_uring(Options::enable_io_uring());
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLCertContext::set_root_certs_file(Options::root_certs_file());
   SSLCertContext::set_root_certs_cache(Options::root_certs_cache());
@@ -728,6 +756,13 @@ bool Options::ParseArguments(int argc,
         " (--depfile-output-filename or --snapshot).\n");
     return false;
   }
+  if ((jit_cache_filename_ != nullptr) &&
+      ((gen_snapshot_kind_ != kNone) || vm_run_app_snapshot)) {
+    Syslog::PrintErr(
+        "--jit-cache cannot be combined with generating or running a"
+        " snapshot.\n");
+    return false;
+  }
   if ((gen_snapshot_kind_ != kNone) && vm_run_app_snapshot) {
     Syslog::PrintErr(
         "Specifying an option to generate a snapshot and"
@@ -26,7 +26,9 @@ namespace bin {
   V(root_certs_file, root_certs_file)                                          \
   V(root_certs_cache, root_certs_cache)                                        \
   V(namespace, namespc)                                                        \
-  V(write_service_info, vm_write_service_info_filename)
+  V(write_service_info, vm_write_service_info_filename)                        \
+  V(jit_cache, jit_cache_filename)                                             \
+  V(kernel_cache, kernel_cache_dir)
 
 // As STRING_OPTIONS_LIST but for boolean valued options. The default value is
 // always false, and the presence of the flag switches the value to true.
@@ -39,6 +41,7 @@ namespace bin {
   V(trace_loading, trace_loading)                                              \
   V(short_socket_read, short_socket_read)                                      \
   V(short_socket_write, short_socket_write)                                    \
+  V(enable_io_uring, enable_io_uring)                                          \
   V(disable_exit, exit_disabled)                                               \
   V(preview_dart_2, nop_option)                                                \
   V(suppress_core_dump, suppress_core_dump)                                    \
@@ -151,6 +154,13 @@ class Options {
   static void set_dfe(DFE* dfe) { dfe_ = dfe; }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
+  // Makes this run generate an app-jit snapshot into the --jit-cache file
+  // when it exits.
+  static void TrainJitCache() {
+    gen_snapshot_kind_ = kAppJIT;
+    snapshot_filename_ = jit_cache_filename_;
+  }
+
   static void PrintUsage();
   static void PrintVersion();
 
@@ -10,6 +10,7 @@
 #include <errno.h>         // NOLINT
 #include <fcntl.h>         // NOLINT
 #include <poll.h>          // NOLINT
+#include <spawn.h>         // NOLINT
 #include <stdio.h>         // NOLINT
 #include <stdlib.h>        // NOLINT
 #include <string.h>        // NOLINT
@@ -73,6 +74,13 @@ class ProcessInfoList {
 
   static void AddProcess(pid_t pid, intptr_t fd) {
     MutexLocker locker(mutex_);
+    AddProcessLocked(pid, fd);
+  }
+
+  // Adds a process while the caller holds mutex(). Holding the mutex while
+  // creating the process keeps the exit code handler from looking up the
+  // process before it is added.
+  static void AddProcessLocked(pid_t pid, intptr_t fd) {
     ProcessInfo* info = new ProcessInfo(pid, fd);
     info->set_next(active_processes_);
     active_processes_ = info;
@@ -90,6 +98,8 @@ class ProcessInfoList {
     return 0;
   }
 
+  static Mutex* mutex() { return mutex_; }
+
   static void RemoveProcess(pid_t pid) {
     MutexLocker locker(mutex_);
     ProcessInfo* prev = nullptr;
@@ -311,6 +321,127 @@ class ProcessStarter {
       return err;
     }
 
+    pid_t pid;
+    if (CanSpawn()) {
+      err = SpawnProcess(&pid);
+    } else {
+      err = ForkProcess(&pid);
+    }
+    if (err != 0) {
+      return err;
+    }
+
+    if (Process::ModeHasStdio(mode_)) {
+      // Connect stdio, stdout and stderr.
+      FDUtils::SetNonBlocking(read_in_[0]);
+      *in_ = read_in_[0];
+      close(read_in_[1]);
+      FDUtils::SetNonBlocking(write_out_[1]);
+      *out_ = write_out_[1];
+      close(write_out_[0]);
+      FDUtils::SetNonBlocking(read_err_[0]);
+      *err_ = read_err_[0];
+      close(read_err_[1]);
+    } else {
+      // Close all fds.
+      close(read_in_[0]);
+      close(read_in_[1]);
+      ASSERT(write_out_[0] == -1);
+      ASSERT(write_out_[1] == -1);
+      ASSERT(read_err_[0] == -1);
+      ASSERT(read_err_[1] == -1);
+    }
+    ASSERT(exec_control_[0] == -1);
+    ASSERT(exec_control_[1] == -1);
+
+    *id_ = pid;
+    return 0;
+  }
+
+ private:
+  static constexpr int kErrorBufferSize = 1024;
+
+  // Tells whether the process can be created with posix_spawn instead of
+  // fork. Forking a parent with a large heap has to copy its page tables,
+  // while glibc's posix_spawn uses vfork semantics and reports exec errors
+  // through its result. Working directories, namespaces and detached modes
+  // need code run in the child, and a PATH search with a new environment
+  // would use the parent's PATH, so those still fork.
+  bool CanSpawn() const {
+#if defined(__GLIBC__) &&                                                      \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 24))
+    return Process::ModeIsAttached(mode_) && working_directory_ == nullptr &&
+           Namespace::IsDefault(namespc_) &&
+           (program_environment_ == nullptr || strchr(path_, '/') != nullptr);
+#else
+    return false;
+#endif
+  }
+
+  int SpawnProcess(pid_t* pid) {
+    ASSERT(Process::ModeIsAttached(mode_));
+    // The exec control pipe is only used by forked children.
+    ClosePipe(exec_control_);
+
+    posix_spawn_file_actions_t actions;
+    int result = posix_spawn_file_actions_init(&actions);
+    if (result != 0) {
+      errno = result;
+      return CleanupAndReturnError();
+    }
+    if (mode_ == kNormal) {
+      // The pipes are close-on-exec, but dup2 clears that flag on the copies.
+      if ((result = posix_spawn_file_actions_adddup2(
+               &actions, write_out_[0], STDIN_FILENO)) != 0 ||
+          (result = posix_spawn_file_actions_adddup2(&actions, read_in_[1],
+                                                     STDOUT_FILENO)) != 0 ||
+          (result = posix_spawn_file_actions_adddup2(&actions, read_err_[1],
+                                                     STDERR_FILENO)) != 0) {
+        posix_spawn_file_actions_destroy(&actions);
+        errno = result;
+        return CleanupAndReturnError();
+      }
+    } else {
+      ASSERT(mode_ == kInheritStdio);
+    }
+
+    int event_fds[2];
+    if (TEMP_FAILURE_RETRY(pipe2(event_fds, O_CLOEXEC)) < 0) {
+      posix_spawn_file_actions_destroy(&actions);
+      return CleanupAndReturnError();
+    }
+
+    ExitCodeHandler::ProcessStarted();
+    char* const* argv = const_cast<char* const*>(program_arguments_);
+    char* const* envp =
+        program_environment_ != nullptr ? program_environment_ : environ;
+    {
+      // Register the process before the exit code handler can reap it.
+      MutexLocker locker(ProcessInfoList::mutex());
+      if (strchr(path_, '/') == nullptr) {
+        result = posix_spawnp(pid, path_, &actions, nullptr, argv, envp);
+      } else {
+        result = posix_spawn(pid, path_, &actions, nullptr, argv, envp);
+      }
+      if (result == 0) {
+        ProcessInfoList::AddProcessLocked(*pid, event_fds[1]);
+      }
+    }
+    posix_spawn_file_actions_destroy(&actions);
+
+    if (result != 0) {
+      // No child is left to report an exit code.
+      close(event_fds[0]);
+      close(event_fds[1]);
+      errno = result;
+      return CleanupAndReturnError();
+    }
+    *exit_event_ = event_fds[0];
+    FDUtils::SetNonBlocking(event_fds[0]);
+    return 0;
+  }
+
+  int ForkProcess(pid_t* result) {
     // Fork to create the new process.
     pid_t pid = TEMP_FAILURE_RETRY(fork());
     if (pid < 0) {
@@ -326,6 +457,7 @@ class ProcessStarter {
     // If the child process is not started in detached mode, be sure to
     // listen for exit-codes, now that we have a non detached child process
     // and also Register this child process.
+    int err;
     if (Process::ModeIsAttached(mode_)) {
       ExitCodeHandler::ProcessStarted();
       err = RegisterProcess(pid);
@@ -370,36 +502,10 @@ class ProcessStarter {
       return err;
     }
 
-    if (Process::ModeHasStdio(mode_)) {
-      // Connect stdio, stdout and stderr.
-      FDUtils::SetNonBlocking(read_in_[0]);
-      *in_ = read_in_[0];
-      close(read_in_[1]);
-      FDUtils::SetNonBlocking(write_out_[1]);
-      *out_ = write_out_[1];
-      close(write_out_[0]);
-      FDUtils::SetNonBlocking(read_err_[0]);
-      *err_ = read_err_[0];
-      close(read_err_[1]);
-    } else {
-      // Close all fds.
-      close(read_in_[0]);
-      close(read_in_[1]);
-      ASSERT(write_out_[0] == -1);
-      ASSERT(write_out_[1] == -1);
-      ASSERT(read_err_[0] == -1);
-      ASSERT(read_err_[1] == -1);
-    }
-    ASSERT(exec_control_[0] == -1);
-    ASSERT(exec_control_[1] == -1);
-
-    *id_ = pid;
+    *result = pid;
     return 0;
   }
 
- private:
-  static constexpr int kErrorBufferSize = 1024;
-
   int CreatePipes() {
     int result;
     result = TEMP_FAILURE_RETRY(pipe2(exec_control_, O_CLOEXEC));
@@ -75,6 +75,13 @@ void Benchmark::RunBenchmark() {
     this->Run();
     Syslog::Print("%s(%s): %" Pd64 "\n", this->name(), this->score_kind(),
                   this->score());
+    if (this->has_perf_counters()) {
+      for (intptr_t i = 0; i < kNumPerfCounters; i++) {
+        const PerfCounter counter = static_cast<PerfCounter>(i);
+        Syslog::Print("%s(%s): %" Pd64 "\n", this->name(),
+                      PerfCounterName(counter), this->perf_counter(counter));
+      }
+    }
     run_matches++;
   } else if (run_filter == kList) {
     Syslog::Print("%s Pass\n", this->name());
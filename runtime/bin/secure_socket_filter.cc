@@ -277,70 +277,93 @@ bool SSLFilter::ProcessAllBuffers(int starts[kNumBuffers],
                                   int ends[kNumBuffers],
                                   bool in_handshake) {
   for (int i = 0; i < kNumBuffers; ++i) {
-    if (in_handshake && (i == kReadPlaintext || i == kWritePlaintext)) continue;
-    int start = starts[i];
-    int end = ends[i];
     int size = IsBufferEncrypted(i) ? encrypted_buffer_size_ : buffer_size_;
-    if (start < 0 || end < 0 || start >= size || end >= size) {
+    if (starts[i] < 0 || ends[i] < 0 || starts[i] >= size || ends[i] >= size) {
       FATAL("Out-of-bounds internal buffer access in dart:io SecureSocket");
     }
-    switch (i) {
-      case kReadPlaintext:
-      case kWriteEncrypted:
-        // Write data to the circular buffer's free space.  If the buffer
-        // is full, neither if statement is executed and nothing happens.
-        if (start <= end) {
-          // If the free space may be split into two segments,
-          // then the first is [end, size), unless start == 0.
-          // Then, since the last free byte is at position start - 2,
-          // the interval is [end, size - 1).
-          int buffer_end = (start == 0) ? size - 1 : size;
-          int bytes = (i == kReadPlaintext)
-                          ? ProcessReadPlaintextBuffer(end, buffer_end)
-                          : ProcessWriteEncryptedBuffer(end, buffer_end);
-          if (bytes < 0) return false;
-          end += bytes;
-          ASSERT(end <= size);
-          if (end == size) end = 0;
-        }
-        if (start > end + 1) {
-          int bytes = (i == kReadPlaintext)
-                          ? ProcessReadPlaintextBuffer(end, start - 1)
-                          : ProcessWriteEncryptedBuffer(end, start - 1);
-          if (bytes < 0) return false;
-          end += bytes;
-          ASSERT(end < start);
-        }
-        ends[i] = end;
-        break;
-      case kReadEncrypted:
-      case kWritePlaintext:
-        // Read/Write data from circular buffer.  If the buffer is empty,
-        // neither if statement's condition is true.
-        if (end < start) {
-          // Data may be split into two segments.  In this case,
-          // the first is [start, size).
-          int bytes = (i == kReadEncrypted)
-                          ? ProcessReadEncryptedBuffer(start, size)
-                          : ProcessWritePlaintextBuffer(start, size);
-          if (bytes < 0) return false;
-          start += bytes;
-          ASSERT(start <= size);
-          if (start == size) start = 0;
-        }
-        if (start < end) {
-          int bytes = (i == kReadEncrypted)
-                          ? ProcessReadEncryptedBuffer(start, end)
-                          : ProcessWritePlaintextBuffer(start, end);
-          if (bytes < 0) return false;
-          start += bytes;
-          ASSERT(start <= end);
-        }
-        starts[i] = start;
-        break;
-      default:
-        UNREACHABLE();
+  }
+  // Process the buffers in the order in which data flows through the filter,
+  // so that encrypted data from the socket is decrypted, and plaintext from
+  // Dart is encrypted, by the same request. Repeat while data moves, as
+  // draining BoringSSL makes room for more data.
+  static constexpr BufferIndex kDataFlowOrder[] = {
+      kReadEncrypted, kReadPlaintext, kWritePlaintext, kWriteEncrypted};
+  bool progress;
+  do {
+    progress = false;
+    for (BufferIndex i : kDataFlowOrder) {
+      if (in_handshake && (i == kReadPlaintext || i == kWritePlaintext)) {
+        continue;
+      }
+      const int start = starts[i];
+      const int end = ends[i];
+      if (!ProcessBuffer(i, &starts[i], &ends[i])) return false;
+      progress = progress || (starts[i] != start) || (ends[i] != end);
     }
+  } while (progress);
+  return true;
+}
+
+bool SSLFilter::ProcessBuffer(BufferIndex i, int* start_ptr, int* end_ptr) {
+  int start = *start_ptr;
+  int end = *end_ptr;
+  int size = IsBufferEncrypted(i) ? encrypted_buffer_size_ : buffer_size_;
+  switch (i) {
+    case kReadPlaintext:
+    case kWriteEncrypted:
+      // Write data to the circular buffer's free space.  If the buffer
+      // is full, neither if statement is executed and nothing happens.
+      if (start <= end) {
+        // If the free space may be split into two segments,
+        // then the first is [end, size), unless start == 0.
+        // Then, since the last free byte is at position start - 2,
+        // the interval is [end, size - 1).
+        int buffer_end = (start == 0) ? size - 1 : size;
+        int bytes = (i == kReadPlaintext)
+                        ? ProcessReadPlaintextBuffer(end, buffer_end)
+                        : ProcessWriteEncryptedBuffer(end, buffer_end);
+        if (bytes < 0) return false;
+        end += bytes;
+        ASSERT(end <= size);
+        if (end == size) end = 0;
+      }
+      if (start > end + 1) {
+        int bytes = (i == kReadPlaintext)
+                        ? ProcessReadPlaintextBuffer(end, start - 1)
+                        : ProcessWriteEncryptedBuffer(end, start - 1);
+        if (bytes < 0) return false;
+        end += bytes;
+        ASSERT(end < start);
+      }
+      *end_ptr = end;
+      break;
+    case kReadEncrypted:
+    case kWritePlaintext:
+      // Read/Write data from circular buffer.  If the buffer is empty,
+      // neither if statement's condition is true.
+      if (end < start) {
+        // Data may be split into two segments.  In this case,
+        // the first is [start, size).
+        int bytes = (i == kReadEncrypted)
+                        ? ProcessReadEncryptedBuffer(start, size)
+                        : ProcessWritePlaintextBuffer(start, size);
+        if (bytes < 0) return false;
+        start += bytes;
+        ASSERT(start <= size);
+        if (start == size) start = 0;
+      }
+      if (start < end) {
+        int bytes = (i == kReadEncrypted)
+                        ? ProcessReadEncryptedBuffer(start, end)
+                        : ProcessWritePlaintextBuffer(start, end);
+        if (bytes < 0) return false;
+        start += bytes;
+        ASSERT(start <= end);
+      }
+      *start_ptr = start;
+      break;
+    default:
+      UNREACHABLE();
   }
   return true;
 }
@@ -544,6 +567,11 @@ void SSLFilter::Connect(const char* hostname,
                                          hostname_, strlen(hostname_));
     SecureSocketUtils::CheckStatusSSL(
         status, "TlsException", "Set hostname for certificate checking", ssl_);
+    SSL_SESSION* session = context->LookupClientSession(hostname_);
+    if (session != nullptr) {
+      SSL_set_session(ssl_, session);
+      SSL_SESSION_free(session);
+    }
   }
   // Make the connection:
   if (is_server_) {
@@ -628,6 +656,8 @@ int SSLFilter::Handshake(Dart_Port reply_port) {
     int result = SSL_get_verify_result(ssl_);
     if (SSL_LOG_STATUS) {
       Syslog::Print("Handshake verification status: %d\n", result);
+      Syslog::Print("Handshake resumed session: %d\n",
+                    SSL_session_reused(ssl_));
       X509* peer_certificate = SSL_get_peer_certificate(ssl_);
       if (peer_certificate == nullptr) {
         Syslog::Print("No peer certificate received\n");
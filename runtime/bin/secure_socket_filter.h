@@ -99,6 +99,7 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   bool ProcessAllBuffers(int starts[kNumBuffers],
                          int ends[kNumBuffers],
                          bool in_handshake);
+  bool ProcessBuffer(BufferIndex index, int* start, int* end);
   Dart_Handle PeerCertificate();
   static void InitializeLibrary();
   Dart_Handle callback_error;
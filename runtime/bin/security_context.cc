@@ -92,6 +92,64 @@ void SSLCertContext::KeyLogCallback(const SSL* ssl, const char* line) {
   }
 }
 
+int SSLCertContext::NewSessionCallback(SSL* ssl, SSL_SESSION* session) {
+  SSLFilter* filter = static_cast<SSLFilter*>(
+      SSL_get_ex_data(ssl, SSLFilter::filter_ssl_index));
+  SSLCertContext* context = static_cast<SSLCertContext*>(
+      SSL_get_ex_data(ssl, SSLFilter::ssl_cert_context_index));
+  // Resuming a session skips the certificate checks, so only keep sessions
+  // whose certificate was trusted, rather than accepted by onBadCertificate.
+  if ((filter == nullptr) || (context == nullptr) ||
+      (filter->hostname() == nullptr) ||
+      (SSL_get_verify_result(ssl) != X509_V_OK) ||
+      !SSL_SESSION_is_resumable(session)) {
+    return 0;
+  }
+  context->CacheClientSession(filter->hostname(), session);
+  // Keeps the reference to the session.
+  return 1;
+}
+
+void SSLCertContext::CacheClientSession(const char* hostname,
+                                        SSL_SESSION* session) {
+  MutexLocker ml(&client_sessions_mutex_);
+  ClientSession* entry = nullptr;
+  for (ClientSession& candidate : client_sessions_) {
+    if ((candidate.hostname != nullptr) &&
+        (strcmp(candidate.hostname, hostname) == 0)) {
+      entry = &candidate;
+      break;
+    }
+  }
+  if (entry == nullptr) {
+    entry = &client_sessions_[next_client_session_];
+    next_client_session_ = (next_client_session_ + 1) % kClientSessionCacheSize;
+    free(entry->hostname);
+    entry->hostname = Utils::StrDup(hostname);
+  }
+  SSL_SESSION_free(entry->session);
+  entry->session = session;
+}
+
+SSL_SESSION* SSLCertContext::LookupClientSession(const char* hostname) {
+  MutexLocker ml(&client_sessions_mutex_);
+  for (ClientSession& entry : client_sessions_) {
+    if ((entry.session == nullptr) || (strcmp(entry.hostname, hostname) != 0)) {
+      continue;
+    }
+    SSL_SESSION* session = entry.session;
+    if (SSL_SESSION_should_be_single_use(session)) {
+      // TLS 1.3 tickets are only used once, so that connections cannot be
+      // linked by their ticket.
+      entry.session = nullptr;
+    } else {
+      SSL_SESSION_up_ref(session);
+    }
+    return session;
+  }
+  return nullptr;
+}
+
 SSLCertContext* SSLCertContext::GetSecurityContext(Dart_NativeArguments args) {
   SSLCertContext* context;
   Dart_Handle dart_this = ThrowIfError(Dart_GetNativeArgument(args, 0));
@@ -824,6 +882,15 @@ void FUNCTION_NAME(SecurityContext_Allocate)(Dart_NativeArguments args) {
   SSL_CTX_set_keylog_callback(ctx, SSLCertContext::KeyLogCallback);
   SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
   SSL_CTX_set_cipher_list(ctx, "HIGH:MEDIUM");
+  // Clients keep the sessions of their connections to resume them when
+  // connecting to the same host again. Servers use BoringSSL's session cache
+  // and session tickets, whose keys BoringSSL rotates itself. The session id
+  // context lets servers that verify client certificates resume sessions.
+  static const uint8_t kSessionIdContext[] = {'d', 'a', 'r', 't'};
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_BOTH);
+  SSL_CTX_sess_set_new_cb(ctx, SSLCertContext::NewSessionCallback);
+  SSL_CTX_set_session_id_context(ctx, kSessionIdContext,
+                                 sizeof(kSessionIdContext));
   SSLCertContext* context = new SSLCertContext(ctx);
   Dart_Handle err = SetSecurityContext(args, context);
   if (Dart_IsError(err)) {
@@ -35,12 +35,17 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
         allow_tls_renegotiation_(false) {}
 
   ~SSLCertContext() {
+    for (ClientSession& entry : client_sessions_) {
+      free(entry.hostname);
+      SSL_SESSION_free(entry.session);
+    }
     SSL_CTX_free(context_);
     free(alpn_protocol_string_);
   }
 
   static int CertificateCallback(int preverify_ok, X509_STORE_CTX* store_ctx);
   static void KeyLogCallback(const SSL* ssl, const char* line);
+  static int NewSessionCallback(SSL* ssl, SSL_SESSION* session);
 
   static SSLCertContext* GetSecurityContext(Dart_NativeArguments args);
   static const char* GetPasswordArgument(Dart_NativeArguments args,
@@ -91,6 +96,10 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
   void set_trust_builtin(bool trust_builtin) { trust_builtin_ = trust_builtin; }
 
   void RegisterCallbacks(SSL* ssl);
+
+  // Returns a session of an earlier client connection to 'hostname' to
+  // resume, or nullptr. The caller owns the returned reference.
+  SSL_SESSION* LookupClientSession(const char* hostname);
   TrustEvaluateHandlerFunc GetTrustEvaluateHandler() const;
 
   static bool long_ssl_cert_evaluation() { return long_ssl_cert_evaluation_; }
@@ -107,6 +116,16 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
   }
 
  private:
+  // The number of hosts for which a client session is kept.
+  static constexpr intptr_t kClientSessionCacheSize = 32;
+
+  struct ClientSession {
+    char* hostname = nullptr;
+    SSL_SESSION* session = nullptr;
+  };
+
+  void CacheClientSession(const char* hostname, SSL_SESSION* session);
+
   void AddCompiledInCerts();
   void LoadRootCertFile(const char* file);
   void LoadRootCertCache(const char* cache);
@@ -119,6 +138,14 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
 
   bool trust_builtin_;
   bool allow_tls_renegotiation_;
+
+  // Sessions of client connections, replaced in round robin order. Guarded
+  // by client_sessions_mutex_, as BoringSSL reports sessions from the IO
+  // service threads running the filters.
+  Mutex client_sessions_mutex_;
+  ClientSession client_sessions_[kClientSessionCacheSize];
+  intptr_t next_client_session_ = 0;
+
   static bool long_ssl_cert_evaluation_;
   static bool bypass_trusting_system_roots_;
 
@@ -29,6 +29,7 @@ ListeningSocketRegistry* globalTcpListeningSocketRegistry = nullptr;
 
 bool Socket::short_socket_read_ = false;
 bool Socket::short_socket_write_ = false;
+intptr_t Socket::lookup_cache_seconds_ = 0;
 
 void ListeningSocketRegistry::Initialize() {
   ASSERT(globalTcpListeningSocketRegistry == nullptr);
@@ -516,17 +517,16 @@ void FUNCTION_NAME(Socket_CreateBindDatagram)(Dart_NativeArguments args) {
   }
 }
 
-void FUNCTION_NAME(Socket_Available)(Dart_NativeArguments args) {
-  Socket* socket =
-      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+// Leaf call, must not call into the VM.
+intptr_t FFI_FUNCTION_NAME(Socket_Available)(void* socket_pointer) {
+  Socket* socket = reinterpret_cast<Socket*>(socket_pointer);
   intptr_t available = SocketBase::Available(socket->fd());
   if (available >= 0) {
-    Dart_SetIntegerReturnValue(args, available);
-  } else {
-    // Available failed. Mark socket as having data, to trigger a future read
-    // event where the actual error can be reported.
-    Dart_SetIntegerReturnValue(args, 1);
+    return available;
   }
+  // Available failed. Mark socket as having data, to trigger a future read
+  // event where the actual error can be reported.
+  return 1;
 }
 
 void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
@@ -1038,6 +1038,81 @@ void FUNCTION_NAME(ServerSocket_Accept)(Dart_NativeArguments args) {
   }
 }
 
+// Addresses found by LookupRequest, shared by all isolates and kept for
+// --dns-cache-ttl seconds. getaddrinfo does not report the TTL of the DNS
+// records, so the lifetime is fixed.
+class LookupCache : public AllStatic {
+ public:
+  // Returns a copy of the addresses cached for 'host', or nullptr.
+  static AddressList<SocketAddress>* Lookup(const char* host, int type) {
+    const int64_t now = TimerUtils::GetCurrentMonotonicMillis();
+    MutexLocker ml(mutex_);
+    for (Entry& entry : entries_) {
+      if ((entry.host == nullptr) || (entry.type != type) ||
+          (strcmp(entry.host, host) != 0)) {
+        continue;
+      }
+      if (entry.expiry <= now) return nullptr;
+      auto addresses = new AddressList<SocketAddress>(entry.count);
+      for (intptr_t i = 0; i < entry.count; i++) {
+        addresses->SetAt(i, new SocketAddress(&entry.addresses[i].addr));
+      }
+      return addresses;
+    }
+    return nullptr;
+  }
+
+  static void Add(const char* host,
+                  int type,
+                  const AddressList<SocketAddress>& addresses) {
+    const int64_t lifetime =
+        Socket::lookup_cache_seconds() * kMillisecondsPerSecond;
+    const int64_t expiry = TimerUtils::GetCurrentMonotonicMillis() + lifetime;
+    MutexLocker ml(mutex_);
+    Entry* entry = nullptr;
+    for (Entry& candidate : entries_) {
+      if ((candidate.host != nullptr) && (candidate.type == type) &&
+          (strcmp(candidate.host, host) == 0)) {
+        entry = &candidate;
+        break;
+      }
+    }
+    if (entry == nullptr) {
+      entry = &entries_[next_entry_];
+      next_entry_ = (next_entry_ + 1) % kNumEntries;
+      free(entry->host);
+      entry->host = Utils::StrDup(host);
+      entry->type = type;
+    }
+    delete[] entry->addresses;
+    entry->count = addresses.count();
+    entry->addresses = new RawAddr[entry->count];
+    for (intptr_t i = 0; i < entry->count; i++) {
+      entry->addresses[i] = addresses.GetAt(i)->addr();
+    }
+    entry->expiry = expiry;
+  }
+
+ private:
+  static constexpr intptr_t kNumEntries = 64;
+
+  struct Entry {
+    char* host = nullptr;
+    int type = 0;
+    int64_t expiry = 0;
+    intptr_t count = 0;
+    RawAddr* addresses = nullptr;
+  };
+
+  static Mutex* mutex_;
+  static Entry entries_[kNumEntries];
+  static intptr_t next_entry_;
+};
+
+Mutex* LookupCache::mutex_ = new Mutex();
+LookupCache::Entry LookupCache::entries_[LookupCache::kNumEntries];
+intptr_t LookupCache::next_entry_ = 0;
+
 CObject* Socket::LookupRequest(const CObjectArray& request) {
   if ((request.Length() == 2) && request[0]->IsString() &&
       request[1]->IsInt32()) {
@@ -1045,8 +1120,17 @@ CObject* Socket::LookupRequest(const CObjectArray& request) {
     CObjectInt32 type(request[1]);
     CObject* result = nullptr;
     OSError* os_error = nullptr;
+    const bool use_cache = lookup_cache_seconds() > 0;
     AddressList<SocketAddress>* addresses =
-        SocketBase::LookupAddress(host.CString(), type.Value(), &os_error);
+        use_cache ? LookupCache::Lookup(host.CString(), type.Value())
+                  : nullptr;
+    if (addresses == nullptr) {
+      addresses =
+          SocketBase::LookupAddress(host.CString(), type.Value(), &os_error);
+      if (use_cache && (addresses != nullptr)) {
+        LookupCache::Add(host.CString(), type.Value(), *addresses);
+      }
+    }
     if (addresses != nullptr) {
       CObjectArray* array =
           new CObjectArray(CObject::NewArray(addresses->count() + 1));
@@ -1321,7 +1405,10 @@ enum _RawSocketOptions : int64_t {
   DART_IPPROTO_IPV6 = 3,
   DART_IPV6_MULTICAST_IF = 4,
   DART_IPPROTO_TCP = 5,
-  DART_IPPROTO_UDP = 6
+  DART_IPPROTO_UDP = 6,
+  DART_TCP_CORK = 7,
+  DART_TCP_NOTSENT_LOWAT = 8,
+  DART_SO_BUSY_POLL = 9
 };
 
 void FUNCTION_NAME(RawSocketOption_GetOptionValue)(Dart_NativeArguments args) {
@@ -1349,6 +1436,28 @@ void FUNCTION_NAME(RawSocketOption_GetOptionValue)(Dart_NativeArguments args) {
     case DART_IPPROTO_UDP:
       Dart_SetIntegerReturnValue(args, IPPROTO_UDP);
       break;
+    // The remaining options are only available on some platforms.
+    case DART_TCP_CORK:
+#if defined(TCP_CORK)
+      Dart_SetIntegerReturnValue(args, TCP_CORK);
+#else
+      Dart_SetIntegerReturnValue(args, -1);
+#endif
+      break;
+    case DART_TCP_NOTSENT_LOWAT:
+#if defined(TCP_NOTSENT_LOWAT)
+      Dart_SetIntegerReturnValue(args, TCP_NOTSENT_LOWAT);
+#else
+      Dart_SetIntegerReturnValue(args, -1);
+#endif
+      break;
+    case DART_SO_BUSY_POLL:
+#if defined(SO_BUSY_POLL)
+      Dart_SetIntegerReturnValue(args, SO_BUSY_POLL);
+#else
+      Dart_SetIntegerReturnValue(args, -1);
+#endif
+      break;
     default:
       Dart_PropagateError(Dart_NewApiError(
           "option to getOptionValue() is outside expected range"));
@@ -108,6 +108,13 @@ class Socket : public ReferenceCounted<Socket> {
     short_socket_write_ = short_socket_write;
   }
 
+  // The number of seconds for which the addresses found by LookupRequest are
+  // reused for the same host, or 0 to always look them up.
+  static intptr_t lookup_cache_seconds() { return lookup_cache_seconds_; }
+  static void set_lookup_cache_seconds(intptr_t seconds) {
+    lookup_cache_seconds_ = seconds;
+  }
+
   static bool IsSignalSocketFlag(intptr_t flag) {
     return ((flag & (0x1 << kInternalSignalSocket)) != 0);
   }
@@ -123,6 +130,7 @@ class Socket : public ReferenceCounted<Socket> {
 
   static bool short_socket_read_;
   static bool short_socket_write_;
+  static intptr_t lookup_cache_seconds_;
 
   intptr_t fd_;
   Dart_Port isolate_port_;
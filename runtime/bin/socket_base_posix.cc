@@ -133,7 +133,7 @@ intptr_t SocketBase::ReceiveMessage(intptr_t fd,
   int flags = 0;
 #ifdef MSG_CMSG_CLOEXEC
   // MSG_CMSG_CLOEXEC is not supported on macOS.
-  flags &= MSG_CMSG_CLOEXEC;
+  flags |= MSG_CMSG_CLOEXEC;
 #endif
   ssize_t read_bytes = TEMP_FAILURE_RETRY(recvmsg(fd, &msg, flags));
   if ((sync == kAsync) && (read_bytes == -1) && (errno == EWOULDBLOCK)) {
@@ -169,14 +169,17 @@ intptr_t SocketBase::ReceiveMessage(intptr_t fd,
     new (control_message) SocketControlMessage(
         cmsg->cmsg_level, cmsg->cmsg_type, copied_data, data_length);
 
-    int fd;
-    memmove(&fd, CMSG_DATA(cmsg), sizeof(int));
-
 #ifndef MSG_CMSG_CLOEXEC
-    // MSG_CMSG_CLOEXEC is not supported on macOS.
-    if (!FDUtils::SetCloseOnExec(fd)) {
-      FDUtils::SaveErrorAndClose(fd);
-      return -1;
+    // MSG_CMSG_CLOEXEC is not supported on macOS. A single message can pass
+    // several descriptors, all of which need the flag.
+    for (size_t offset = 0; offset + sizeof(int) <= data_length;
+         offset += sizeof(int)) {
+      int fd;
+      memmove(&fd, reinterpret_cast<uint8_t*>(data) + offset, sizeof(int));
+      if (!FDUtils::SetCloseOnExec(fd)) {
+        FDUtils::SaveErrorAndClose(fd);
+        return -1;
+      }
     }
 #endif
   }
@@ -63,6 +63,11 @@ Dart_NativeFunction LookupIONative(Dart_Handle name,
 // a valid I/O native function.
 const uint8_t* LookupIONativeSymbol(Dart_NativeFunction nf);
 
+// Performs a lookup of the I/O native function bound with @FfiNative with a
+// specified 'name'. Returns NULL if no such function is found. Embedders
+// should install it with Dart_SetFfiNativeResolver on dart:io.
+void* LookupIOFfiNative(const char* name, uintptr_t argument_count);
+
 }  // namespace bin
 }  // namespace dart
 
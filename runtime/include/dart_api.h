@@ -849,7 +849,7 @@ typedef Dart_Handle (*Dart_GetVMServiceAssetsArchive)(void);
  * The current version of the Dart_InitializeFlags. Should be incremented every
  * time Dart_InitializeFlags changes in a binary incompatible way.
  */
-#define DART_INITIALIZE_PARAMS_CURRENT_VERSION (0x00000007)
+#define DART_INITIALIZE_PARAMS_CURRENT_VERSION (0x00000008)
 
 /** Forward declaration */
 struct Dart_CodeObserver;
@@ -905,6 +905,47 @@ typedef const char* (*Dart_RegisterKernelBlobCallback)(
  */
 typedef void (*Dart_UnregisterKernelBlobCallback)(const char* kernel_blob_uri);
 
+/**
+ * A hint for scheduling tasks the VM posts to the embedder's executor.
+ */
+typedef enum {
+  /** Concurrent marking and sweeping, background compilation. */
+  Dart_TaskPriority_Low = 0,
+  /** Native ports, isolate startup and shutdown, and other VM work. */
+  Dart_TaskPriority_Normal = 1,
+  /**
+   * Running isolates, and helping the GC while all isolates of a group are
+   * stopped.
+   */
+  Dart_TaskPriority_High = 2,
+} Dart_TaskPriority;
+
+/** A task of the VM, see Dart_PostTaskCallback. */
+typedef struct _Dart_Task* Dart_Task;
+
+/**
+ * Optional callback provided by the embedder to run the VM's tasks on its own
+ * threads instead of threads started by the VM.
+ *
+ * The embedder must eventually call Dart_RunTask(task) exactly once, on any
+ * thread that is not currently running a Dart_Task. Tasks may block for a
+ * long time, e.g. while an isolate runs Dart code, and may wait for other
+ * tasks they posted, so the executor must not limit the number of tasks
+ * running at the same time to a fixed number of threads.
+ *
+ * \param executor_data The value of Dart_InitializeParams.executor_data.
+ * \param task The task to run.
+ * \param priority A hint on how urgent the task is.
+ */
+typedef void (*Dart_PostTaskCallback)(void* executor_data,
+                                      Dart_Task task,
+                                      Dart_TaskPriority priority);
+
+/**
+ * Runs a task posted with Dart_PostTaskCallback and frees it.
+ */
+DART_EXPORT void Dart_RunTask(Dart_Task task);
+
 /**
  * Describes how to initialize the VM. Used with Dart_Initialize.
  */
@@ -992,6 +1033,13 @@ typedef struct {
    * Kernel blob unregistration callback function. See Dart_UnregisterKernelBlobCallback.
    */
   Dart_UnregisterKernelBlobCallback unregister_kernel_blob;
+
+  /**
+   * An executor for the VM's tasks, or NULL to let the VM start its own
+   * worker threads. See Dart_PostTaskCallback.
+   */
+  Dart_PostTaskCallback post_task;
+  void* executor_data;
 } Dart_InitializeParams;
 
 /**
@@ -1281,6 +1329,16 @@ DART_EXPORT void Dart_KillIsolate(Dart_Isolate isolate);
  */
 DART_EXPORT void Dart_NotifyIdle(int64_t deadline);
 
+/**
+ * Sets a goal for the duration of new-space collections in the current
+ * isolate's group. When |goal_micros| is positive, the VM sizes new-space from
+ * the observed scavenge pause time and promotion rate to stay under the goal.
+ * A value of zero restores the default survival-based sizing.
+ *
+ * Requires there to be a current isolate.
+ */
+DART_EXPORT void Dart_SetNewSpacePauseGoal(int64_t goal_micros);
+
 typedef void (*Dart_HeapSamplingReportCallback)(void* context,
                                                 const char* cls_name,
                                                 void* data);
@@ -1366,6 +1424,9 @@ DART_EXPORT void Dart_NotifyDestroyed(void);
 /**
  * Notifies the VM that the system is running low on memory.
  *
+ * The VM returns cached and free heap memory of all isolate groups to the
+ * OS.
+ *
  * Does not require a current isolate. Only valid after calling Dart_Initialize.
  */
 DART_EXPORT void Dart_NotifyLowMemory(void);
@@ -2724,6 +2785,28 @@ DART_EXPORT Dart_Handle Dart_NewUnmodifiableExternalTypedDataWithFinalizer(
     intptr_t external_allocation_size,
     Dart_HandleFinalizer callback);
 
+/**
+ * Returns a view of the desired type onto a region of an existing TypedData
+ * object.
+ *
+ * Views keep their backing object alive, so a single external TypedData
+ * created with Dart_NewExternalTypedDataWithFinalizer can serve as an arena
+ * for many short-lived views: the whole region is accounted for and
+ * finalized once, after the last view onto it has been collected.
+ *
+ * \param typed_data The backing TypedData object or a view onto one.
+ * \param type The type of the view.
+ * \param offset_in_bytes The offset of the view into typed_data. Must be a
+ *   multiple of the element size of type.
+ * \param length The length of the view (length in type units).
+ *
+ * \return The view if no error occurs. Otherwise returns an error handle.
+ */
+DART_EXPORT Dart_Handle Dart_NewTypedDataView(Dart_Handle typed_data,
+                                              Dart_TypedData_Type type,
+                                              intptr_t offset_in_bytes,
+                                              intptr_t length);
+
 /**
  * Returns a ByteBuffer object for the typed data.
  *
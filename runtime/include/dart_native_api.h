@@ -136,6 +136,24 @@ DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message);
  */
 DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message);
 
+/**
+ * Returns whether a safepoint operation, such as a garbage collection, is
+ * waiting for the current thread.
+ *
+ * A native function called through a leaf FFI call blocks safepoint
+ * operations of its whole isolate group until it returns. Long running leaf
+ * functions should poll this, and return early when it is true, so that the
+ * caller can resume the work with another call. The Dart code making the
+ * calls reaches a safepoint in between.
+ *
+ * This function does not allocate or block, and may be called from leaf
+ * calls and from threads which have no current isolate, in which case it
+ * returns false.
+ *
+ * \return True if a safepoint operation is waiting for the current thread.
+ */
+DART_EXPORT bool Dart_IsSafepointRequested(void);
+
 /**
  * A native message handler.
  *
@@ -158,7 +176,9 @@ typedef void (*Dart_NativeMessageHandler)(Dart_Port dest_port_id,
  * \param name The name of this port in debugging messages.
  * \param handler The C handler to run when messages arrive on the port.
  * \param handle_concurrently Is it okay to process requests on this
- *                            native port concurrently?
+ *                            native port concurrently? If so, messages are
+ *                            handled on the VM's thread pool in parallel
+ *                            and possibly out of order.
  *
  * \return If successful, returns the port id for the native port.  In
  *   case of error, returns ILLEGAL_PORT.
@@ -166,7 +186,6 @@ typedef void (*Dart_NativeMessageHandler)(Dart_Port dest_port_id,
 DART_EXPORT Dart_Port Dart_NewNativePort(const char* name,
                                          Dart_NativeMessageHandler handler,
                                          bool handle_concurrently);
-/* TODO(turnidge): Currently handle_concurrently is ignored. */
 
 /**
  * Closes the native port with the given id.
@@ -481,6 +481,124 @@ DART_EXPORT int64_t
 Dart_IsolateGroupHeapNewCapacityMetric(Dart_IsolateGroup group);  // Byte
 DART_EXPORT int64_t
 Dart_IsolateGroupHeapNewExternalMetric(Dart_IsolateGroup group);  // Byte
+DART_EXPORT int64_t
+Dart_IsolateGroupHeapOldAllocatedMetric(Dart_IsolateGroup group);  // Byte
+DART_EXPORT int64_t
+Dart_IsolateGroupHeapNewAllocatedMetric(Dart_IsolateGroup group);  // Byte
+DART_EXPORT int64_t Dart_IsolateGroupScavengePauseP50Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupScavengePauseP99Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupScavengePauseMaxMetric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupMarkPauseP50Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupMarkPauseP99Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupMarkPauseMaxMetric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupCompactPauseP50Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupCompactPauseP99Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupCompactPauseMaxMetric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupSweepPauseP50Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupSweepPauseP99Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupSweepPauseMaxMetric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupSafepointPauseP50Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupSafepointPauseP99Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupSafepointPauseMaxMetric(
+    Dart_IsolateGroup group);  // Microsecond
+
+/**
+ * Returns the CPU time spent by the threads that ran |isolate|. Time spent by
+ * a thread that is still running the isolate is only included when called
+ * from that thread.
+ */
+DART_EXPORT int64_t Dart_IsolateCPUTimeMetric(
+    Dart_Isolate isolate);  // Microsecond
+
+/**
+ * Returns the bytes allocated by |isolate| in new space. The count is updated
+ * whenever a thread-local allocation buffer of the isolate fills up and
+ * before every scavenge.
+ */
+DART_EXPORT int64_t Dart_IsolateAllocatedMetric(Dart_Isolate isolate);  // Byte
+
+#define DART_METRICS_PAGE_VERSION 1
+
+/**
+ * Process-wide counters that the VM copies into memory owned by the embedder
+ * at a fixed period, see Dart_SetMetricsPage. The page may live in shared
+ * memory, so that agents in other processes can sample it at a high
+ * frequency without the service protocol and without any work in the VM
+ * besides the periodic update.
+ *
+ * |sequence| is odd while the VM updates the page. A consistent snapshot is
+ * read by reading |sequence|, copying the page, and retrying if |sequence|
+ * was odd or has changed since.
+ *
+ * Heap sizes are summed and pause percentiles are the maximum over all
+ * isolate groups. Counters since startup only grow.
+ */
+typedef struct {
+  int32_t version;  // DART_METRICS_PAGE_VERSION
+  int32_t size;     // sizeof(Dart_MetricsPage)
+  volatile uint64_t sequence;
+  int64_t timestamp_micros;  // Dart_TimelineGetMicros() of the last update.
+
+  int64_t isolate_groups;
+  int64_t isolates;
+
+  int64_t heap_new_used;  // Byte
+  int64_t heap_new_capacity;
+  int64_t heap_new_external;
+  int64_t heap_old_used;
+  int64_t heap_old_capacity;
+  int64_t heap_old_external;
+
+  int64_t scavenges;  // Count since startup
+  int64_t old_collections;
+  int64_t scavenge_pause_p99;  // Microsecond
+  int64_t scavenge_pause_max;
+  int64_t mark_pause_p99;
+  int64_t mark_pause_max;
+  int64_t compact_pause_p99;
+  int64_t compact_pause_max;
+  int64_t sweep_pause_p99;
+  int64_t sweep_pause_max;
+  int64_t safepoint_pause_p99;
+  int64_t safepoint_pause_max;
+
+  int64_t functions_compiled;  // Count since startup
+  int64_t functions_optimized;
+
+  int64_t thread_pool_workers;
+  int64_t thread_pool_idle_workers;
+  int64_t thread_pool_pending_tasks;
+
+  int64_t queued_messages;  // In all message queues
+} Dart_MetricsPage;
+
+/**
+ * Makes the VM update |page| every |period_micros| until the next call or
+ * Dart_Cleanup. Passing NULL stops the updates. The page is filled in before
+ * this function returns.
+ *
+ * Requires the VM to be initialized. |page| must stay valid until updates are
+ * stopped.
+ *
+ * \return NULL on success, or an error message that the caller must free.
+ */
+DART_EXPORT DART_WARN_UNUSED_RESULT char* Dart_SetMetricsPage(
+    Dart_MetricsPage* page,
+    int64_t period_micros);
 
 /*
  * ========
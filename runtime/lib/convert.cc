@@ -0,0 +1,443 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/bootstrap_natives.h"
+
+#include "vm/dart_entry.h"
+#include "vm/double_conversion.h"
+#include "vm/exceptions.h"
+#include "vm/growable_array.h"
+#include "vm/native_entry.h"
+#include "vm/object.h"
+#include "vm/object_store.h"
+
+namespace dart {
+
+// Parses JSON text straight into the objects that _JsonListener in
+// convert_patch.dart would build: Map<String, dynamic>, List<dynamic>,
+// String, int, double, bool and null.
+//
+// Rejects any input it does not accept instead of reporting an error, so
+// that the caller can fall back to the Dart parser and its error messages.
+template <typename CharType>
+class JsonParser : public ValueObject {
+ public:
+  JsonParser(Thread* thread, const CharType* chars, intptr_t length)
+      : thread_(thread),
+        zone_(thread->zone()),
+        chars_(chars),
+        length_(length),
+        position_(0),
+        depth_(0),
+        type_arguments_(TypeArguments::Handle(
+            zone_,
+            thread->isolate_group()
+                ->object_store()
+                ->type_argument_string_dynamic())),
+        maps_(GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())),
+        keys_(Array::Handle(zone_, Array::New(kKeyCacheSize))),
+        key_(String::Handle(zone_)),
+        buffer_(zone_, 64) {
+    memset(key_hashes_, 0, sizeof(key_hashes_));
+  }
+
+  bool Parse(Object* result) {
+    SkipWhitespace();
+    if (!ParseValue(result)) return false;
+    SkipWhitespace();
+    if (position_ != length_) return false;
+    if (maps_.Length() > 0) {
+      // Maps are built with their entries in place but without an index.
+      const Object& error = Object::Handle(
+          zone_, DartLibraryCalls::RehashObjectsInDartCollection(thread_, maps_));
+      if (error.IsError()) {
+        Exceptions::PropagateError(Error::Cast(error));
+      }
+    }
+    return true;
+  }
+
+ private:
+  // Deeper documents are left to the Dart parser, which does not recurse.
+  static constexpr intptr_t kMaxDepth = 512;
+  // Number of recently seen object keys that are reused instead of being
+  // allocated again. Must be a power of two.
+  static constexpr intptr_t kKeyCacheSize = 64;
+  static constexpr intptr_t kMaxCachedKeyLength = 32;
+  // Keep in sync with _HashBase._INITIAL_INDEX_SIZE in compact_hash.dart.
+  static constexpr intptr_t kInitialMapDataLength = 8;
+
+  static bool IsDigit(CharType c) { return c >= '0' && c <= '9'; }
+
+  bool Peek(CharType c) const {
+    return position_ < length_ && chars_[position_] == c;
+  }
+
+  bool Consume(CharType c) {
+    if (!Peek(c)) return false;
+    position_++;
+    return true;
+  }
+
+  bool ConsumeDigits() {
+    const intptr_t start = position_;
+    while (position_ < length_ && IsDigit(chars_[position_])) {
+      position_++;
+    }
+    return position_ > start;
+  }
+
+  void SkipWhitespace() {
+    while (position_ < length_) {
+      const CharType c = chars_[position_];
+      if (c != ' ' && c != '\n' && c != '\r' && c != '\t') return;
+      position_++;
+    }
+  }
+
+  bool ParseValue(Object* value) {
+    if (position_ == length_) return false;
+    switch (chars_[position_]) {
+      case '{':
+        return ParseObject(value);
+      case '[':
+        return ParseArray(value);
+      case '"':
+        return ParseString(value, /*is_key=*/false);
+      case 't':
+        return ParseLiteral("true", Bool::True(), value);
+      case 'f':
+        return ParseLiteral("false", Bool::False(), value);
+      case 'n':
+        return ParseLiteral("null", Object::null_object(), value);
+      default:
+        return ParseNumber(value);
+    }
+  }
+
+  bool ParseLiteral(const char* literal,
+                    const Object& literal_value,
+                    Object* value) {
+    for (intptr_t i = 0; literal[i] != '\0'; i++) {
+      if (!Consume(literal[i])) return false;
+    }
+    *value = literal_value.ptr();
+    return true;
+  }
+
+  bool ParseObject(Object* value) {
+    if (++depth_ > kMaxDepth) return false;
+    HANDLESCOPE(thread_);
+    position_++;  // '{'
+    Array& data = Array::Handle(zone_);
+    intptr_t used_data = 0;
+    SkipWhitespace();
+    if (!Consume('}')) {
+      data = Array::New(kInitialMapDataLength);
+      Object& element = Object::Handle(zone_);
+      do {
+        SkipWhitespace();
+        if (!Peek('"') || !ParseString(&element, /*is_key=*/true)) {
+          return false;
+        }
+        if (used_data == data.Length()) {
+          data = Array::Grow(data, 2 * data.Length());
+        }
+        data.SetAt(used_data++, element);
+        SkipWhitespace();
+        if (!Consume(':')) return false;
+        SkipWhitespace();
+        if (!ParseValue(&element)) return false;
+        data.SetAt(used_data++, element);
+        SkipWhitespace();
+      } while (Consume(','));
+      if (!Consume('}')) return false;
+    }
+    depth_--;
+    Map& map = Map::Handle(zone_);
+    if (used_data == 0) {
+      map = Map::NewDefault();
+    } else {
+      // The data length is a power of two, so it can be used as the index
+      // size when the index is regenerated. Duplicate keys are resolved then
+      // too, just like _JsonListener: the last value wins, at the position
+      // of the first occurrence.
+      map = Map::New(kMapCid, data, TypedData::Handle(zone_),
+                     /*hash_mask=*/0, used_data, /*deleted_keys=*/0);
+      maps_.Add(map);
+    }
+    map.SetTypeArguments(type_arguments_);
+    *value = map.ptr();
+    return true;
+  }
+
+  bool ParseArray(Object* value) {
+    if (++depth_ > kMaxDepth) return false;
+    HANDLESCOPE(thread_);
+    position_++;  // '['
+    const GrowableObjectArray& list =
+        GrowableObjectArray::Handle(zone_, GrowableObjectArray::New());
+    SkipWhitespace();
+    if (!Consume(']')) {
+      Object& element = Object::Handle(zone_);
+      do {
+        SkipWhitespace();
+        if (!ParseValue(&element)) return false;
+        list.Add(element);
+        SkipWhitespace();
+      } while (Consume(','));
+      if (!Consume(']')) return false;
+    }
+    depth_--;
+    *value = list.ptr();
+    return true;
+  }
+
+  bool ParseString(Object* value, bool is_key) {
+    position_++;  // '"'
+    const intptr_t start = position_;
+    while (true) {
+      if (position_ == length_) return false;
+      const CharType c = chars_[position_];
+      if (c == '"') break;
+      if (c == '\\') return ParseEscapedString(value, start);
+      if (c < 0x20) return false;
+      position_++;
+    }
+    const intptr_t length = position_ - start;
+    position_++;  // '"'
+    if (is_key && length <= kMaxCachedKeyLength) {
+      *value = LookupKey(chars_ + start, length);
+    } else {
+      *value = NewString(chars_ + start, length);
+    }
+    return true;
+  }
+
+  // Continues a string at the first backslash, decoding into [buffer_].
+  bool ParseEscapedString(Object* value, intptr_t start) {
+    buffer_.Clear();
+    for (intptr_t i = start; i < position_; i++) {
+      buffer_.Add(chars_[i]);
+    }
+    while (true) {
+      if (position_ == length_) return false;
+      const CharType c = chars_[position_++];
+      if (c == '"') break;
+      if (c < 0x20) return false;
+      if (c != '\\') {
+        buffer_.Add(c);
+        continue;
+      }
+      if (position_ == length_) return false;
+      switch (chars_[position_++]) {
+        case '"':
+          buffer_.Add('"');
+          break;
+        case '\\':
+          buffer_.Add('\\');
+          break;
+        case '/':
+          buffer_.Add('/');
+          break;
+        case 'b':
+          buffer_.Add('\b');
+          break;
+        case 'f':
+          buffer_.Add('\f');
+          break;
+        case 'n':
+          buffer_.Add('\n');
+          break;
+        case 'r':
+          buffer_.Add('\r');
+          break;
+        case 't':
+          buffer_.Add('\t');
+          break;
+        case 'u': {
+          if (length_ - position_ < 4) return false;
+          uint16_t code_unit = 0;
+          for (intptr_t i = 0; i < 4; i++) {
+            const CharType digit = chars_[position_++];
+            code_unit <<= 4;
+            if (IsDigit(digit)) {
+              code_unit |= digit - '0';
+            } else if ((digit | 0x20) >= 'a' && (digit | 0x20) <= 'f') {
+              code_unit |= (digit | 0x20) - 'a' + 10;
+            } else {
+              return false;
+            }
+          }
+          buffer_.Add(code_unit);
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    *value = String::FromUTF16(buffer_.data(), buffer_.length());
+    return true;
+  }
+
+  static uword HashChars(const uint8_t* chars, intptr_t length) {
+    return String::Hash(reinterpret_cast<const char*>(chars), length);
+  }
+
+  static uword HashChars(const uint16_t* chars, intptr_t length) {
+    return String::Hash(chars, length);
+  }
+
+  static bool EqualsChars(const String& str,
+                          const uint8_t* chars,
+                          intptr_t length) {
+    return str.EqualsLatin1(chars, length);
+  }
+
+  static bool EqualsChars(const String& str,
+                          const uint16_t* chars,
+                          intptr_t length) {
+    return str.Equals(chars, length);
+  }
+
+  static StringPtr NewString(const uint8_t* chars, intptr_t length) {
+    return String::FromLatin1(chars, length);
+  }
+
+  static StringPtr NewString(const uint16_t* chars, intptr_t length) {
+    return String::FromUTF16(chars, length);
+  }
+
+  // Object keys repeat across the objects of a document, so reuse the
+  // string allocated for a recent occurrence of the same key.
+  StringPtr LookupKey(const CharType* chars, intptr_t length) {
+    const uword hash = HashChars(chars, length);
+    const intptr_t slot = hash & (kKeyCacheSize - 1);
+    if (key_hashes_[slot] == hash) {
+      key_ ^= keys_.At(slot);
+      if (EqualsChars(key_, chars, length)) {
+        return key_.ptr();
+      }
+    }
+    key_ = NewString(chars, length);
+    keys_.SetAt(slot, key_);
+    key_hashes_[slot] = hash;
+    return key_.ptr();
+  }
+
+  bool ParseNumber(Object* value) {
+    const intptr_t start = position_;
+    const bool is_negative = Consume('-');
+    if (position_ == length_ || !IsDigit(chars_[position_])) return false;
+    // A leading zero cannot be followed by more digits, which the caller
+    // rejects as trailing input.
+    uint64_t magnitude = 0;
+    intptr_t digits = 0;
+    if (!Consume('0')) {
+      while (position_ < length_ && IsDigit(chars_[position_])) {
+        if (digits < 19) {
+          magnitude = magnitude * 10 + (chars_[position_] - '0');
+        }
+        digits++;
+        position_++;
+      }
+    }
+    bool is_double = false;
+    if (Consume('.')) {
+      if (!ConsumeDigits()) return false;
+      is_double = true;
+    }
+    if (Consume('e') || Consume('E')) {
+      if (!Consume('+')) Consume('-');
+      if (!ConsumeDigits()) return false;
+      is_double = true;
+    }
+    if (!is_double && digits <= 19) {
+      const uint64_t limit =
+          static_cast<uint64_t>(kMaxInt64) + (is_negative ? 1 : 0);
+      if (magnitude <= limit) {
+        *value = Integer::New(is_negative
+                                  ? static_cast<int64_t>(0 - magnitude)
+                                  : static_cast<int64_t>(magnitude));
+        return true;
+      }
+    }
+    // Integers that do not fit in 64 bits are doubles, like in the Dart
+    // parser.
+    const intptr_t length = position_ - start;
+    char* buffer = zone_->Alloc<char>(length);
+    for (intptr_t i = 0; i < length; i++) {
+      buffer[i] = static_cast<char>(chars_[start + i]);
+    }
+    double result;
+    if (!CStringToDouble(buffer, length, &result)) return false;
+    *value = Double::New(result);
+    return true;
+  }
+
+  Thread* const thread_;
+  Zone* const zone_;
+  const CharType* const chars_;
+  const intptr_t length_;
+  intptr_t position_;
+  intptr_t depth_;
+  const TypeArguments& type_arguments_;
+  // Non-empty maps whose index has to be regenerated.
+  const GrowableObjectArray& maps_;
+  const Array& keys_;
+  uword key_hashes_[kKeyCacheSize];
+  String& key_;
+  GrowableArray<uint16_t> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonParser);
+};
+
+class JsonDecoder : public AllStatic {
+ public:
+  // Returns false if [source] is not accepted by JsonParser.
+  static bool Decode(Thread* thread, const String& source, Object* result) {
+    Zone* zone = thread->zone();
+    const intptr_t length = source.Length();
+    // Parsing allocates, which may move the characters of a heap string.
+    if (source.IsOneByteString()) {
+      uint8_t* chars = zone->Alloc<uint8_t>(length);
+      {
+        NoSafepointScope no_safepoint;
+        memmove(chars, OneByteString::DataStart(source), length);
+      }
+      return JsonParser<uint8_t>(thread, chars, length).Parse(result);
+    }
+    if (source.IsTwoByteString()) {
+      uint16_t* chars = zone->Alloc<uint16_t>(length);
+      {
+        NoSafepointScope no_safepoint;
+        memmove(chars, TwoByteString::DataStart(source),
+                length * sizeof(uint16_t));
+      }
+      return JsonParser<uint16_t>(thread, chars, length).Parse(result);
+    }
+    if (source.IsExternalOneByteString()) {
+      return JsonParser<uint8_t>(
+                 thread, ExternalOneByteString::DataStart(source), length)
+          .Parse(result);
+    }
+    ASSERT(source.IsExternalTwoByteString());
+    return JsonParser<uint16_t>(
+               thread, ExternalTwoByteString::DataStart(source), length)
+        .Parse(result);
+  }
+};
+
+DEFINE_NATIVE_ENTRY(Json_parse, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(String, source, arguments->NativeArgAt(0));
+  Object& result = Object::Handle(zone);
+  if (!JsonDecoder::Decode(thread, source, &result)) {
+    // Returning the source tells the caller to use the Dart parser, which
+    // also reports the error if the source is malformed.
+    return source.ptr();
+  }
+  return result.ptr();
+}
+
+}  // namespace dart
@@ -166,6 +166,33 @@ DEFINE_NATIVE_ENTRY(Double_parse, 0, 3) {
   return Object::null();
 }
 
+DEFINE_NATIVE_ENTRY(Double_parseBytes, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(TypedDataBase, bytes, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, startValue, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, endValue, arguments->NativeArgAt(2));
+  ASSERT(bytes.ElementSizeInBytes() == 1);
+
+  const intptr_t start = startValue.AsTruncatedUint32Value();
+  const intptr_t end = endValue.AsTruncatedUint32Value();
+  const intptr_t len = bytes.LengthInBytes();
+
+  // Indices should be inside the list, and 0 <= start < end <= len.
+  if (0 <= start && start < end && end <= len) {
+    double double_value;
+    bool is_valid;
+    {
+      NoSafepointScope no_safepoint;
+      is_valid = CStringToDouble(
+          reinterpret_cast<const char*>(bytes.DataAddr(start)), end - start,
+          &double_value);
+    }
+    if (is_valid) {
+      return Double::New(double_value);
+    }
+  }
+  return Object::null();
+}
+
 DEFINE_NATIVE_ENTRY(Double_toString, 0, 1) {
   const Number& number = Number::CheckedHandle(zone, arguments->NativeArgAt(0));
   return number.ToString(Heap::kNew);
@@ -13,8 +13,13 @@
 #include "vm/class_id.h"
 #include "vm/compiler/ffi/native_type.h"
 #include "vm/exceptions.h"
+#include "vm/dart_api_state.h"
+#include "vm/ffi_callback_listener.h"
+#include "vm/ffi_isolate_group_callback.h"
+#include "vm/ffi_native_arena.h"
 #include "vm/flags.h"
 #include "vm/heap/gc_shared.h"
+#include "vm/heap/safepoint.h"
 #include "vm/log.h"
 #include "vm/native_arguments.h"
 #include "vm/native_entry.h"
@@ -113,6 +118,367 @@ DEFINE_NATIVE_ENTRY(Ffi_pointerFromFunction, 1, 1) {
   return Pointer::New(entry_point);
 }
 
+DEFINE_NATIVE_ENTRY(Ffi_createCallbackListener, 1, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, port, arguments->NativeArgAt(0));
+  const auto& type_arg =
+      AbstractType::Handle(zone, arguments->NativeTypeArgAt(0));
+  if (!type_arg.IsFunctionType()) {
+    Exceptions::ThrowArgumentError(String::Handle(
+        zone, String::New("Expected a native function type.")));
+  }
+  const char* error = nullptr;
+  const intptr_t slot = FfiCallbackListener::Create(
+      zone, isolate, FunctionType::Cast(type_arg), port.AsInt64Value(), &error);
+  if (slot < 0) {
+    Exceptions::ThrowArgumentError(String::Handle(zone, String::New(error)));
+  }
+  return Smi::New(slot);
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_callbackListenerFunction, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, slot, arguments->NativeArgAt(0));
+  return Pointer::New(FfiCallbackListener::EntryPoint(isolate, slot.Value()));
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_drainCallbackListener, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, slot, arguments->NativeArgAt(0));
+  return FfiCallbackListener::Drain(isolate, slot.Value());
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_closeCallbackListener, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, slot, arguments->NativeArgAt(0));
+  FfiCallbackListener::Close(isolate, slot.Value());
+  return Object::null();
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_createIsolateGroupCallback, 1, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Closure, callback, arguments->NativeArgAt(0));
+  const auto& type_arg =
+      AbstractType::Handle(zone, arguments->NativeTypeArgAt(0));
+  if (!type_arg.IsFunctionType()) {
+    Exceptions::ThrowArgumentError(String::Handle(
+        zone, String::New("Expected a native function type.")));
+  }
+  // Only the code of the callback is shared by the isolates of the group, so
+  // it must not capture any state.
+  const auto& function = Function::Handle(zone, callback.function());
+  if (!function.IsImplicitStaticClosureFunction() || function.IsGeneric()) {
+    Exceptions::ThrowArgumentError(String::Handle(
+        zone, String::New("The callback must be a static or top-level "
+                          "function which is not generic.")));
+  }
+  const auto& target = Function::Handle(zone, function.parent_function());
+  const char* error = nullptr;
+  const intptr_t slot = FfiIsolateGroupCallback::Create(
+      zone, isolate, FunctionType::Cast(type_arg), target, &error);
+  if (slot < 0) {
+    Exceptions::ThrowArgumentError(String::Handle(zone, String::New(error)));
+  }
+  return Smi::New(slot);
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_isolateGroupCallbackFunction, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, slot, arguments->NativeArgAt(0));
+  return Pointer::New(
+      FfiIsolateGroupCallback::EntryPoint(isolate, slot.Value()));
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_closeIsolateGroupCallback, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, slot, arguments->NativeArgAt(0));
+  FfiIsolateGroupCallback::Close(thread, slot.Value());
+  return Object::null();
+}
+
+static void NativeArenaFinalizer(void* isolate_callback_data, void* peer) {
+  delete reinterpret_cast<FfiNativeArena*>(peer);
+}
+
+static FfiNativeArena* NativeArenaOf(const Pointer& pointer) {
+  return reinterpret_cast<FfiNativeArena*>(pointer.NativeAddress());
+}
+
+// Reports the capacity of [arena] as the external size of its owner, so
+// that native memory held by unreachable arenas triggers a GC.
+static void UpdateNativeArenaSize(IsolateGroup* isolate_group,
+                                  FfiNativeArena* arena) {
+  arena->handle()->UpdateExternalSize(arena->capacity(), isolate_group);
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_createNativeArena, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, owner, arguments->NativeArgAt(0));
+  FfiNativeArena* arena = new FfiNativeArena();
+  arena->set_handle(FinalizablePersistentHandle::New(
+      isolate->group(), owner, arena, &NativeArenaFinalizer,
+      /*external_size=*/0, /*auto_delete=*/true));
+  return Pointer::New(reinterpret_cast<uword>(arena));
+}
+
+// Takes the owner of the arena to keep it, and thereby the arena, alive for
+// the duration of the call.
+DEFINE_NATIVE_ENTRY(Ffi_nativeArenaAllocate, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Pointer, pointer, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, byte_count, arguments->NativeArgAt(2));
+  FfiNativeArena* arena = NativeArenaOf(pointer);
+  const int64_t size = byte_count.AsInt64Value();
+  if (size < 0 || size > kMaxInt32) {
+    Exceptions::ThrowRangeError("byteCount", byte_count, 0, kMaxInt32);
+  }
+  const intptr_t capacity = arena->capacity();
+  void* result = arena->Allocate(size);
+  if (result == nullptr) {
+    Exceptions::ThrowOOM();
+  }
+  if (arena->capacity() != capacity) {
+    UpdateNativeArenaSize(isolate->group(), arena);
+  }
+  return Pointer::New(reinterpret_cast<uword>(result));
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_nativeArenaFree, 0, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Pointer, pointer, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Pointer, block, arguments->NativeArgAt(2));
+  FfiNativeArena* arena = NativeArenaOf(pointer);
+  const intptr_t capacity = arena->capacity();
+  arena->Free(reinterpret_cast<void*>(block.NativeAddress()));
+  if (arena->capacity() != capacity) {
+    UpdateNativeArenaSize(isolate->group(), arena);
+  }
+  return Object::null();
+}
+
+DEFINE_NATIVE_ENTRY(Ffi_nativeArenaReleaseAll, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Pointer, pointer, arguments->NativeArgAt(1));
+  FfiNativeArena* arena = NativeArenaOf(pointer);
+  arena->ReleaseAll();
+  UpdateNativeArenaSize(isolate->group(), arena);
+  return Object::null();
+}
+
+enum class TypedDataPinning {
+  // The bytes never move: external typed data or typed data in a snapshot.
+  kStable,
+  // Typed data in old space, which the compactor must not move.
+  kPin,
+  // Typed data in new space, which moves on every scavenge.
+  kCopy,
+};
+
+// Classifies the object holding the bytes of [data] and returns it in
+// [backing].
+static TypedDataPinning PinningOf(const TypedDataBase& data,
+                                  Instance* backing) {
+  *backing = data.ptr();
+  const intptr_t cid = data.GetClassId();
+  if (IsTypedDataViewClassId(cid) || IsUnmodifiableTypedDataViewClassId(cid)) {
+    *backing = TypedDataView::Data(TypedDataView::Cast(data));
+  }
+  if (!IsTypedDataClassId(backing->GetClassId())) {
+    return TypedDataPinning::kStable;
+  }
+  if (!backing->IsOld()) {
+    return TypedDataPinning::kCopy;
+  }
+  if (backing->InVMIsolateHeap() ||
+      IsolateGroup::Current()->heap()->old_space()->IsObjectFromImagePages(
+          backing->ptr())) {
+    return TypedDataPinning::kStable;
+  }
+  return TypedDataPinning::kPin;
+}
+
+// Returns an address of the bytes of [data] which stays valid until the
+// matching Ffi_unpinTypedData, even if the GC runs in between.
+//
+// External typed data and typed data in old space are passed without copying.
+// The latter is pinned, so the compactor does not move it. Typed data in new
+// space would be moved by the next scavenge, so its bytes are copied to a
+// malloc'd buffer instead. Large typed data is always allocated in old space.
+DEFINE_NATIVE_ENTRY(Ffi_pinTypedData, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(TypedDataBase, data, arguments->NativeArgAt(0));
+  auto& backing = Instance::Handle(zone);
+  const intptr_t length = data.LengthInBytes();
+  void* address = data.DataAddr(0);
+  switch (PinningOf(data, &backing)) {
+    case TypedDataPinning::kStable:
+      break;
+    case TypedDataPinning::kPin:
+      isolate->group()->heap()->old_space()->PinObject(backing.ptr());
+      break;
+    case TypedDataPinning::kCopy: {
+      void* copy = malloc(Utils::Maximum(length, static_cast<intptr_t>(1)));
+      if (copy == nullptr) {
+        Exceptions::ThrowOOM();
+      }
+      memmove(copy, address, length);
+      address = copy;
+      break;
+    }
+  }
+  return Integer::NewFromUint64(reinterpret_cast<uword>(address));
+}
+
+// Releases an address returned by Ffi_pinTypedData. Bytes of typed data that
+// were copied are copied back, since native code may have written them.
+DEFINE_NATIVE_ENTRY(Ffi_unpinTypedData, 0, 2) {
+  GET_NON_NULL_NATIVE_ARGUMENT(TypedDataBase, data, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, address, arguments->NativeArgAt(1));
+  void* pinned = reinterpret_cast<void*>(address.AsInt64Value());
+  void* current = data.DataAddr(0);
+  if (pinned != current) {
+    // Copied from new space. The typed data may have been promoted since.
+    memmove(current, pinned, data.LengthInBytes());
+    free(pinned);
+    return Object::null();
+  }
+  auto& backing = Instance::Handle(zone);
+  if (PinningOf(data, &backing) == TypedDataPinning::kPin) {
+    isolate->group()->heap()->old_space()->UnpinObject(backing.ptr());
+  }
+  return Object::null();
+}
+
+static constexpr intptr_t kMaxBatchCallArguments = 6;
+
+// Whether a value of the native type of class [cid] is passed in one integer
+// register or stack slot.
+static bool IsWordSizedIntegerType(intptr_t cid) {
+  switch (cid) {
+    case kFfiInt8Cid:
+    case kFfiInt16Cid:
+    case kFfiInt32Cid:
+    case kFfiUint8Cid:
+    case kFfiUint16Cid:
+    case kFfiUint32Cid:
+    case kFfiBoolCid:
+    case kPointerCid:
+      return true;
+    case kFfiInt64Cid:
+    case kFfiUint64Cid:
+      return kWordSize == 8;
+    default:
+      return false;
+  }
+}
+
+// The callee only defines the low bits of results narrower than a word.
+static intptr_t ExtendBatchCallResult(intptr_t cid, uword result) {
+  switch (cid) {
+    case kFfiInt8Cid:
+      return static_cast<int8_t>(result);
+    case kFfiInt16Cid:
+      return static_cast<int16_t>(result);
+    case kFfiInt32Cid:
+      return static_cast<int32_t>(result);
+    case kFfiUint8Cid:
+      return static_cast<uint8_t>(result);
+    case kFfiUint16Cid:
+      return static_cast<uint16_t>(result);
+    case kFfiUint32Cid:
+      return static_cast<uint32_t>(result);
+    case kFfiBoolCid:
+      return static_cast<uint8_t>(result) != 0 ? 1 : 0;
+    default:
+      return static_cast<intptr_t>(result);
+  }
+}
+
+static uword CallWithWords(uword function,
+                           intptr_t arity,
+                           const intptr_t* a) {
+  switch (arity) {
+    case 0:
+      return reinterpret_cast<uword (*)()>(function)();
+    case 1:
+      return reinterpret_cast<uword (*)(intptr_t)>(function)(a[0]);
+    case 2:
+      return reinterpret_cast<uword (*)(intptr_t, intptr_t)>(function)(a[0],
+                                                                       a[1]);
+    case 3:
+      return reinterpret_cast<uword (*)(intptr_t, intptr_t, intptr_t)>(
+          function)(a[0], a[1], a[2]);
+    case 4:
+      return reinterpret_cast<uword (*)(intptr_t, intptr_t, intptr_t,
+                                        intptr_t)>(function)(a[0], a[1], a[2],
+                                                             a[3]);
+    case 5:
+      return reinterpret_cast<uword (*)(intptr_t, intptr_t, intptr_t,
+                                        intptr_t, intptr_t)>(function)(
+          a[0], a[1], a[2], a[3], a[4]);
+    case 6:
+      return reinterpret_cast<uword (*)(intptr_t, intptr_t, intptr_t,
+                                        intptr_t, intptr_t, intptr_t)>(
+          function)(a[0], a[1], a[2], a[3], a[4], a[5]);
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+// Calls a native function [count] times with a single transition to native
+// code. Row i of [arguments] holds the arguments of call i, one word each,
+// and its result is stored to [results][i].
+DEFINE_NATIVE_ENTRY(Ffi_callNativeBatch, 1, 4) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Pointer, function, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Pointer, args, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Pointer, results, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, count, arguments->NativeArgAt(3));
+  const auto& type_arg =
+      AbstractType::Handle(zone, arguments->NativeTypeArgAt(0));
+  if (!type_arg.IsFunctionType()) {
+    Exceptions::ThrowArgumentError(String::Handle(
+        zone, String::New("Expected a native function type.")));
+  }
+  const auto& signature = FunctionType::Cast(type_arg);
+  const intptr_t first = signature.num_implicit_parameters();
+  const intptr_t arity = signature.NumParameters() - first;
+  if (arity > kMaxBatchCallArguments) {
+    Exceptions::ThrowArgumentError(String::Handle(
+        zone, String::New("Batch calls take at most 6 arguments.")));
+  }
+  auto& type = AbstractType::Handle(zone);
+  for (intptr_t i = 0; i < arity; i++) {
+    type = signature.ParameterTypeAt(first + i);
+    if (!type.IsType() || !IsWordSizedIntegerType(type.type_class_id())) {
+      Exceptions::ThrowArgumentError(String::Handle(
+          zone, String::New("Batch calls only take integer, Bool and Pointer "
+                            "arguments of at most word size.")));
+    }
+  }
+  type = signature.result_type();
+  const intptr_t result_cid =
+      type.IsType() ? type.type_class_id() : kIllegalCid;
+  const bool returns_void = result_cid == kFfiVoidCid;
+  if (!returns_void && !IsWordSizedIntegerType(result_cid)) {
+    Exceptions::ThrowArgumentError(String::Handle(
+        zone, String::New("Batch calls only return Void, integers, Bool and "
+                          "Pointer of at most word size.")));
+  }
+  const int64_t n = count.AsInt64Value();
+  if (n < 0) {
+    Exceptions::ThrowRangeError("count", count, 0, kIntptrMax);
+  }
+  const uword target = function.NativeAddress();
+  const intptr_t* argument_words =
+      reinterpret_cast<const intptr_t*>(args.NativeAddress());
+  intptr_t* result_words = reinterpret_cast<intptr_t*>(results.NativeAddress());
+  if (n > 0 && (target == 0 || (arity > 0 && argument_words == nullptr) ||
+                (!returns_void && result_words == nullptr))) {
+    Exceptions::ThrowArgumentError(String::Handle(
+        zone, String::New("Batch call pointers must not be null.")));
+  }
+
+  {
+    TransitionVMToNative transition(thread);
+    for (int64_t i = 0; i < n; i++) {
+      const uword result = CallWithWords(target, arity, argument_words);
+      argument_words += arity;
+      if (!returns_void) {
+        result_words[i] = ExtendBatchCallResult(result_cid, result);
+      }
+    }
+  }
+  return Object::null();
+}
+
 DEFINE_NATIVE_ENTRY(DartNativeApiFunctionPointer, 0, 1) {
   GET_NON_NULL_NATIVE_ARGUMENT(String, name_dart, arguments->NativeArgAt(0));
   const char* name = name_dart.ToCString();
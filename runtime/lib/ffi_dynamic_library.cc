@@ -11,10 +11,13 @@
 #include <tchar.h>
 #endif
 
+#include "lib/ffi_dynamic_library.h"
+
 #include "vm/bootstrap_natives.h"
 #include "vm/dart_api_impl.h"
 #include "vm/exceptions.h"
 #include "vm/ffi/native_assets.h"
+#include "vm/flags.h"
 #include "vm/globals.h"
 #include "vm/hash_table.h"
 #include "vm/native_entry.h"
@@ -29,6 +32,12 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            ffi_preload_native_assets,
+            false,
+            "Load the dynamic libraries of all native assets when an isolate "
+            "group starts, instead of when their first @Native is called.");
+
 #if defined(USING_SIMULATOR) || (defined(DART_PRECOMPILER) && !defined(TESTING))
 
 DART_NORETURN static void SimulatorUnsupported() {
@@ -63,6 +72,8 @@ DEFINE_NATIVE_ENTRY(Ffi_GetFfiNativeResolver, 1, 0) {
   SimulatorUnsupported();
 }
 
+void PreloadNativeAssets(Thread* thread) {}
+
 #else  // defined(USING_SIMULATOR) ||                                          \
        // (defined(DART_PRECOMPILER) && !defined(TESTING))
 
@@ -311,10 +322,9 @@ static ArrayPtr GetAssetLocation(Thread* const thread, const String& asset) {
 // The |asset_location| is formatted as follows:
 // ['<path_type>', '<path (optional)>']
 // The |asset_location| is conform to: pkg/vm/lib/native_assets/validator.dart
-static void* FfiResolveAsset(Thread* const thread,
-                             const Array& asset_location,
-                             const String& symbol,
-                             char** error) {
+static void* LoadAssetLibrary(Thread* const thread,
+                              const Array& asset_location,
+                              char** error) {
   Zone* const zone = thread->zone();
 
   const auto& asset_type =
@@ -366,20 +376,71 @@ static void* FfiResolveAsset(Thread* const thread,
                          "Failed to load dynamic library '%s': %s",
                          path.ToCString(), inner_error);
     free(inner_error);
-  } else {
-    void* const result = ResolveSymbol(handle, symbol.ToCString(), error);
+    return nullptr;
+  }
+  return handle;
+}
+
+// If an error occurs populates |error| with an error message
+// (caller must free this message when it is no longer needed).
+//
+// Each asset is loaded once per isolate group.
+static void* FfiResolveAsset(Thread* const thread,
+                             const String& asset,
+                             const Array& asset_location,
+                             const String& symbol,
+                             char** error) {
+  FfiNativeCache* const cache = thread->isolate_group()->ffi_native_cache();
+  void* handle = nullptr;
+  if (!cache->LookupLibrary(asset.ToCString(), &handle)) {
+    handle = LoadAssetLibrary(thread, asset_location, error);
     if (*error != nullptr) {
-      char* inner_error = *error;
-      *error = OS::SCreate(/*use malloc*/ nullptr,
-                           "Failed to lookup symbol '%s': %s",
-                           symbol.ToCString(), inner_error);
-      free(inner_error);
-    } else {
-      return result;
+      return nullptr;
     }
+    cache->InsertLibrary(asset.ToCString(), handle);
   }
-  ASSERT(*error != nullptr);
-  return nullptr;
+  void* const result = ResolveSymbol(handle, symbol.ToCString(), error);
+  if (*error != nullptr) {
+    char* inner_error = *error;
+    *error = OS::SCreate(/*use malloc*/ nullptr,
+                         "Failed to lookup symbol '%s': %s",
+                         symbol.ToCString(), inner_error);
+    free(inner_error);
+    return nullptr;
+  }
+  return result;
+}
+
+void PreloadNativeAssets(Thread* thread) {
+  Zone* const zone = thread->zone();
+  const auto& native_assets_map =
+      Array::Handle(zone, GetNativeAssetsMap(thread));
+  if (native_assets_map.IsNull()) {
+    return;
+  }
+  FfiNativeCache* const cache = thread->isolate_group()->ffi_native_cache();
+  auto& asset = String::Handle(zone);
+  auto& asset_location = Array::Handle(zone);
+  NativeAssetsMap map(native_assets_map.ptr());
+  NativeAssetsMap::Iterator it(&map);
+  while (it.MoveNext()) {
+    const intptr_t entry = it.Current();
+    asset = String::RawCast(map.GetKey(entry));
+    asset_location = Array::RawCast(map.GetPayload(entry, 0));
+    void* handle = nullptr;
+    if (cache->LookupLibrary(asset.ToCString(), &handle)) {
+      continue;
+    }
+    char* error = nullptr;
+    handle = LoadAssetLibrary(thread, asset_location, &error);
+    if (error != nullptr) {
+      // Reported when a native of this asset is first called.
+      free(error);
+      continue;
+    }
+    cache->InsertLibrary(asset.ToCString(), handle);
+  }
+  map.Release();
 }
 
 // Frees |error|.
@@ -415,15 +476,24 @@ static intptr_t FfiResolve(Dart_Handle asset_handle,
     return reinterpret_cast<intptr_t>(ffi_native_result);
   }
 
+  // Symbols resolved by an earlier isolate of this group.
+  FfiNativeCache* const cache = thread->isolate_group()->ffi_native_cache();
+  uword cached = 0;
+  if (cache->LookupSymbol(asset.ToCString(), symbol.ToCString(), &cached)) {
+    return static_cast<intptr_t>(cached);
+  }
+
   // Native assets resolution.
   const auto& asset_location =
       Array::Handle(zone, GetAssetLocation(thread, asset));
   if (!asset_location.IsNull()) {
     void* asset_result =
-        FfiResolveAsset(thread, asset_location, symbol, &error);
+        FfiResolveAsset(thread, asset, asset_location, symbol, &error);
     if (error != nullptr) {
       ThrowFfiResolveError(symbol, asset, error);
     }
+    cache->InsertSymbol(asset.ToCString(), symbol.ToCString(),
+                        reinterpret_cast<uword>(asset_result));
     return reinterpret_cast<intptr_t>(asset_result);
   }
 
@@ -437,6 +507,8 @@ static intptr_t FfiResolve(Dart_Handle asset_handle,
   if (error != nullptr) {
     ThrowFfiResolveError(symbol, asset, error);
   }
+  cache->InsertSymbol(asset.ToCString(), symbol.ToCString(),
+                      reinterpret_cast<uword>(result));
   return reinterpret_cast<intptr_t>(result);
 }
 
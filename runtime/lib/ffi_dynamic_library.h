@@ -0,0 +1,21 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_LIB_FFI_DYNAMIC_LIBRARY_H_
+#define RUNTIME_LIB_FFI_DYNAMIC_LIBRARY_H_
+
+namespace dart {
+
+class Thread;
+
+// Loads the dynamic libraries of all native assets of the current isolate
+// group, so that the first call of an @Native function only has to look up
+// its symbol. Libraries that fail to load are reported when first used.
+//
+// Used with --ffi_preload_native_assets.
+void PreloadNativeAssets(Thread* thread);
+
+}  // namespace dart
+
+#endif  // RUNTIME_LIB_FFI_DYNAMIC_LIBRARY_H_
@@ -81,6 +81,30 @@ DEFINE_NATIVE_ENTRY(GrowableList_setData, 0, 2) {
   return Object::null();
 }
 
+DEFINE_NATIVE_ENTRY(GrowableList_tryGrowDataInPlace, 0, 2) {
+  const GrowableObjectArray& array =
+      GrowableObjectArray::CheckedHandle(zone, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, capacity, arguments->NativeArgAt(1));
+  const Array& data = Array::Handle(zone, array.data());
+  ASSERT(capacity.Value() > data.Length());
+  // The shared empty backing array must never grow.
+  if (data.Length() == 0) {
+    return Bool::False().ptr();
+  }
+  return Bool::Get(data.TryGrowInPlace(capacity.Value())).ptr();
+}
+
+DEFINE_NATIVE_ENTRY(GrowableList_truncateData, 0, 2) {
+  const GrowableObjectArray& array =
+      GrowableObjectArray::CheckedHandle(zone, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, capacity, arguments->NativeArgAt(1));
+  const Array& data = Array::Handle(zone, array.data());
+  ASSERT((capacity.Value() > 0) && (capacity.Value() <= data.Length()));
+  ASSERT(capacity.Value() >= array.Length());
+  data.Truncate(capacity.Value());
+  return Object::null();
+}
+
 DEFINE_NATIVE_ENTRY(Internal_makeListFixedLength, 0, 1) {
   GET_NON_NULL_NATIVE_ARGUMENT(GrowableObjectArray, array,
                                arguments->NativeArgAt(0));
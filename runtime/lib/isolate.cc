@@ -151,6 +151,13 @@ static ObjectPtr ValidateMessageObject(Zone* zone,
       if (!obj->IsHeapObject() || obj->untag()->IsCanonical()) {
         return;
       }
+      // Shared objects and typed data hold no unsendable objects, so don't
+      // track them. In large messages most leaves (e.g. strings and boxed
+      // numbers) are such.
+      if (CanShareObjectAcrossIsolates(obj) ||
+          IsTypedDataClassId(obj->GetClassId())) {
+        return;
+      }
       if (visited_->GetValueExclusive(obj) == 1) {
         return;
       }
@@ -1236,10 +1243,10 @@ DEFINE_NATIVE_ENTRY(TransferableTypedData_factory, 0, 2) {
   return TransferableTypedData::New(data, total_bytes);
 }
 
-DEFINE_NATIVE_ENTRY(TransferableTypedData_materialize, 0, 1) {
-  GET_NON_NULL_NATIVE_ARGUMENT(TransferableTypedData, t,
-                               arguments->NativeArgAt(0));
-
+// Moves the bytes of [t] into a new external typed data.
+static ExternalTypedDataPtr MaterializeTransferableTypedData(
+    Thread* thread,
+    const TransferableTypedData& t) {
   void* peer;
   {
     NoSafepointScope no_safepoint;
@@ -1273,4 +1280,24 @@ DEFINE_NATIVE_ENTRY(TransferableTypedData_materialize, 0, 1) {
   return typed_data.ptr();
 }
 
+DEFINE_NATIVE_ENTRY(TransferableTypedData_materialize, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(TransferableTypedData, t,
+                               arguments->NativeArgAt(0));
+  return MaterializeTransferableTypedData(thread, t);
+}
+
+DEFINE_NATIVE_ENTRY(TransferableTypedData_materializeUnmodifiable, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(TransferableTypedData, t,
+                               arguments->NativeArgAt(0));
+  const auto& typed_data = ExternalTypedData::Handle(
+      zone, MaterializeTransferableTypedData(thread, t));
+  // No isolate can modify the bytes anymore, so the backing store can be
+  // passed by reference to other isolates of the group (see
+  // CanShareObject in object_graph_copy.cc). The finalizer frees the bytes
+  // once no isolate refers to them.
+  typed_data.SetImmutable();
+  return TypedDataView::New(kUnmodifiableTypedDataUint8ArrayViewCid,
+                            typed_data, 0, typed_data.Length());
+}
+
 }  // namespace dart
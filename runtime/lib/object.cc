@@ -34,25 +34,18 @@ DEFINE_NATIVE_ENTRY(Object_equals, 0, 1) {
   return Object::null();
 }
 
-static intptr_t GetHash(Isolate* isolate, const ObjectPtr obj) {
-#if defined(HASH_IN_OBJECT_HEADER)
-  return Object::GetCachedHash(obj);
-#else
-  Heap* heap = isolate->group()->heap();
-  ASSERT(obj->IsDartInstance());
-  return heap->GetHash(obj);
-#endif
-}
-
 DEFINE_NATIVE_ENTRY(Object_getHash, 0, 1) {
+#if defined(HASH_IN_OBJECT_HEADER)
   // Please note that no handle is created for the argument.
   // This is safe since the argument is only used in a tail call.
   // The performance benefit is more than 5% when using hashCode.
-  intptr_t hash = GetHash(isolate, arguments->NativeArgAt(0));
+  intptr_t hash = Object::GetCachedHash(arguments->NativeArgAt(0));
   if (LIKELY(hash != 0)) {
     return Smi::New(hash);
   }
-
+#endif
+  // Without a hash in the header, IdentityHashCode looks the hash up and sets
+  // it under a single lock of the weak table.
   const Instance& instance =
       Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
   return instance.IdentityHashCode(arguments->thread());
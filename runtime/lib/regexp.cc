@@ -10,6 +10,7 @@
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/regexp_assembler_bytecode.h"
+#include "vm/regexp_linear.h"
 #include "vm/regexp_parser.h"
 #include "vm/reusable_handles.h"
 #include "vm/symbols.h"
@@ -147,10 +148,23 @@ static ObjectPtr ExecuteMatch(Zone* zone,
   GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(1));
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
 
+  if (FLAG_linear_regexp && LinearRegExp::CanExecute(regexp, zone)) {
+    return LinearRegExp::Execute(regexp, subject, start_index,
+                                 /*sticky=*/sticky, zone);
+  }
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
   if (!FLAG_interpret_irregexp) {
-    return IRRegExpMacroAssembler::Execute(regexp, subject, start_index,
-                                           /*sticky=*/sticky, zone);
+    // Regexps run in the bytecode interpreter until they have run often
+    // enough to be worth compiling. The count is kept on the regexp, which is
+    // shared by all isolates of the group, and so is the compiled code.
+    const intptr_t threshold =
+        Utils::Minimum<intptr_t>(FLAG_regexp_compilation_threshold, kMaxUint16);
+    if (regexp.IsCompiled(subject.GetClassId(), sticky) ||
+        regexp.IncrementInterpretedExecutions() > threshold) {
+      return IRRegExpMacroAssembler::Execute(regexp, subject, start_index,
+                                             /*sticky=*/sticky, zone);
+    }
   }
 #endif
   return BytecodeRegExpMacroAssembler::Interpret(regexp, subject, start_index,
@@ -167,4 +181,25 @@ DEFINE_NATIVE_ENTRY(RegExp_ExecuteMatchSticky, 0, 3) {
   return ExecuteMatch(zone, arguments, /*sticky=*/true);
 }
 
+DEFINE_NATIVE_ENTRY(RegExp_skipUntilCharacter, 0, 4) {
+  GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, index, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, character, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, mask, arguments->NativeArgAt(3));
+  return Smi::New(RegExpMacroAssembler::FindCharacterAfterAnd(
+      subject, index.Value(), character.Value(), mask.Value()));
+}
+
+DEFINE_NATIVE_ENTRY(RegExp_skipUntilBitInTable, 0, 4) {
+  GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, index, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(TypedData, table, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, skip, arguments->NativeArgAt(3));
+  ASSERT(table.LengthInBytes() == RegExpMacroAssembler::kTableSize);
+  NoSafepointScope no_safepoint;
+  return Smi::New(RegExpMacroAssembler::FindBitInTable(
+      subject, index.Value(), skip.Value(),
+      reinterpret_cast<const uint8_t*>(table.DataAddr(0))));
+}
+
 }  // namespace dart
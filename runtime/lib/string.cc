@@ -467,6 +467,10 @@ DEFINE_NATIVE_ENTRY(String_concat, 0, 2) {
   const String& receiver =
       String::CheckedHandle(zone, arguments->NativeArgAt(0));
   GET_NON_NULL_NATIVE_ARGUMENT(String, b, arguments->NativeArgAt(1));
+  // Strings are immutable, so appending an empty string needs no copy. This
+  // keeps builder loops which start from "" from copying their first part.
+  if (b.Length() == 0) return receiver.ptr();
+  if (receiver.Length() == 0) return b.ptr();
   return String::Concat(receiver, b);
 }
 
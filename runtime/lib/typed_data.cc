@@ -152,6 +152,140 @@ DEFINE_NATIVE_ENTRY(TypedDataBase_setRange, 0, 7) {
   return CopyData(dst, src, dst_start, src_start, length, needs_clamping);
 }
 
+// Stores each element of [src] into [dst] like the [] operator of the
+// destination list would: integers are truncated and doubles are rounded to
+// the destination type. Written as plain loops so that the C++ compiler can
+// vectorize them.
+template <typename Dst, typename Src>
+static void ConvertElements(void* dst, const void* src, intptr_t count) {
+  Dst* dst_data = reinterpret_cast<Dst*>(dst);
+  const Src* src_data = reinterpret_cast<const Src*>(src);
+  for (intptr_t i = 0; i < count; i++) {
+    dst_data[i] = static_cast<Dst>(src_data[i]);
+  }
+}
+
+template <typename Src>
+static void ClampElements(void* dst, const void* src, intptr_t count) {
+  uint8_t* dst_data = reinterpret_cast<uint8_t*>(dst);
+  const Src* src_data = reinterpret_cast<const Src*>(src);
+  for (intptr_t i = 0; i < count; i++) {
+    const int64_t value = src_data[i];
+    dst_data[i] = value < 0 ? 0 : (value > 0xFF ? 0xFF : value);
+  }
+}
+
+// Elements of Uint64List are read as signed integers in Dart.
+#define FOR_EACH_INTEGER_ELEMENT(V)                                            \
+  V(Int8, int8_t)                                                              \
+  V(Uint8, uint8_t)                                                            \
+  V(Uint8Clamped, uint8_t)                                                     \
+  V(Int16, int16_t)                                                            \
+  V(Uint16, uint16_t)                                                          \
+  V(Int32, int32_t)                                                            \
+  V(Uint32, uint32_t)                                                          \
+  V(Int64, int64_t)                                                            \
+  V(Uint64, int64_t)
+
+using ConvertElementsFunction = void (*)(void* dst,
+                                         const void* src,
+                                         intptr_t count);
+
+template <typename Dst>
+static ConvertElementsFunction IntegerConversion(TypedDataElementType src) {
+  switch (src) {
+#define CASE(name, type)                                                       \
+  case k##name##ArrayElement:                                                  \
+    return ConvertElements<Dst, type>;
+    FOR_EACH_INTEGER_ELEMENT(CASE)
+#undef CASE
+    default:
+      return nullptr;
+  }
+}
+
+static ConvertElementsFunction ClampConversion(TypedDataElementType src) {
+  switch (src) {
+#define CASE(name, type)                                                       \
+  case k##name##ArrayElement:                                                  \
+    return ClampElements<type>;
+    FOR_EACH_INTEGER_ELEMENT(CASE)
+#undef CASE
+    default:
+      return nullptr;
+  }
+}
+
+static ConvertElementsFunction ElementConversion(TypedDataElementType dst,
+                                                 TypedDataElementType src) {
+  switch (dst) {
+    case kUint8ClampedArrayElement:
+      return ClampConversion(src);
+#define CASE(name, type)                                                       \
+  case k##name##ArrayElement:                                                  \
+    return IntegerConversion<type>(src);
+      CASE(Int8, int8_t)
+      CASE(Uint8, uint8_t)
+      CASE(Int16, int16_t)
+      CASE(Uint16, uint16_t)
+      CASE(Int32, int32_t)
+      CASE(Uint32, uint32_t)
+      CASE(Int64, int64_t)
+      CASE(Uint64, int64_t)
+#undef CASE
+    case kFloat32ArrayElement:
+      if (src == kFloat64ArrayElement) return ConvertElements<float, double>;
+      if (src == kFloat32ArrayElement) return ConvertElements<float, float>;
+      return nullptr;
+    case kFloat64ArrayElement:
+      if (src == kFloat32ArrayElement) return ConvertElements<double, float>;
+      if (src == kFloat64ArrayElement) return ConvertElements<double, double>;
+      return nullptr;
+    default:
+      return nullptr;
+  }
+}
+
+#undef FOR_EACH_INTEGER_ELEMENT
+
+DEFINE_NATIVE_ENTRY(TypedDataBase_setConvertedRange, 0, 5) {
+  const TypedDataBase& dst =
+      TypedDataBase::CheckedHandle(zone, arguments->NativeArgAt(0));
+  const Smi& dst_start = Smi::CheckedHandle(zone, arguments->NativeArgAt(1));
+  const Smi& count = Smi::CheckedHandle(zone, arguments->NativeArgAt(2));
+  const TypedDataBase& src =
+      TypedDataBase::CheckedHandle(zone, arguments->NativeArgAt(3));
+  const Smi& src_start = Smi::CheckedHandle(zone, arguments->NativeArgAt(4));
+
+  const intptr_t length = count.Value();
+  ASSERT(Utils::RangeCheck(dst_start.Value(), length, dst.Length()));
+  ASSERT(Utils::RangeCheck(src_start.Value(), length, src.Length()));
+  const ConvertElementsFunction convert =
+      ElementConversion(dst.ElementType(), src.ElementType());
+  ASSERT(convert != nullptr);
+  if (length <= 0) {
+    return Object::null();
+  }
+
+  const intptr_t dst_size = length * dst.ElementSizeInBytes();
+  const intptr_t src_size = length * src.ElementSizeInBytes();
+  NoSafepointScope no_safepoint;
+  uint8_t* dst_data = reinterpret_cast<uint8_t*>(
+      dst.DataAddr(dst_start.Value() * dst.ElementSizeInBytes()));
+  const uint8_t* src_data = reinterpret_cast<const uint8_t*>(
+      src.DataAddr(src_start.Value() * src.ElementSizeInBytes()));
+  if ((dst_data < src_data + src_size) && (src_data < dst_data + dst_size)) {
+    // The ranges overlap, so convert from a copy of the source.
+    uint8_t* copy = reinterpret_cast<uint8_t*>(malloc(src_size));
+    memmove(copy, src_data, src_size);
+    convert(dst_data, copy, length);
+    free(copy);
+  } else {
+    convert(dst_data, src_data, length);
+  }
+  return Object::null();
+}
+
 // Native methods for typed data allocation are recognized and implemented
 // in FlowGraphBuilder::BuildGraphOfRecognizedMethod.
 // These bodies exist only to assert that they are not used.
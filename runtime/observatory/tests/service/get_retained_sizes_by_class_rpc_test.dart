@@ -0,0 +1,74 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'package:observatory/service_io.dart';
+import 'package:test/test.dart';
+
+import 'test_helper.dart';
+
+class _TestClass {
+  _TestClass(this.x);
+  // Make sure this field is not removed by the tree shaker.
+  @pragma("vm:entry-point")
+  var x;
+}
+
+@pragma("vm:entry-point")
+var myVar;
+
+@pragma("vm:entry-point")
+invoke1() => myVar = <_TestClass>[new _TestClass(null)];
+
+@pragma("vm:entry-point")
+invoke2() => myVar.add(new _TestClass(new _TestClass(null)));
+
+invoke(Isolate isolate, String selector) async {
+  Map params = {
+    'targetId': isolate.rootLibrary.id,
+    'selector': selector,
+    'argumentIds': <String>[],
+  };
+  return await isolate.invokeRpcNoUpgrade('invoke', params);
+}
+
+Map? findTestClass(Map result) {
+  for (Map member in result['members']) {
+    if (member['class']['name'] == '_TestClass') {
+      return member;
+    }
+  }
+  return null;
+}
+
+var tests = <IsolateTest>[
+  (Isolate isolate) async {
+    await invoke(isolate, 'invoke1');
+    var result = await isolate.invokeRpcNoUpgrade(
+        '_getRetainedSizesByClass', {'setBaseline': true});
+    expect(result['type'], equals('_RetainedSizesByClass'));
+    expect(result['objects'], isPositive);
+    expect(result.containsKey('baselineTimestamp'), isFalse);
+    Map member = findTestClass(result)!;
+    expect(member['type'], equals('_ClassRetainedSize'));
+    expect(member['instances'], equals(1));
+    int shallowSize = member['shallowSize'];
+    expect(shallowSize, isPositive);
+    expect(member['retainedSize'], equals(shallowSize));
+    expect(member.containsKey('instancesDelta'), isFalse);
+
+    // Two more instances, one of which dominates the other.
+    await invoke(isolate, 'invoke2');
+    result = await isolate.invokeRpcNoUpgrade('_getRetainedSizesByClass', {});
+    expect(result['baselineTimestamp'], isPositive);
+    member = findTestClass(result)!;
+    expect(member['instances'], equals(3));
+    expect(member['shallowSize'], equals(3 * shallowSize));
+    expect(member['retainedSize'], equals(3 * shallowSize));
+    expect(member['instancesDelta'], equals(2));
+    expect(member['shallowSizeDelta'], equals(2 * shallowSize));
+    expect(member['retainedSizeDelta'], equals(2 * shallowSize));
+  },
+];
+
+main(args) async => runIsolateTests(args, tests);
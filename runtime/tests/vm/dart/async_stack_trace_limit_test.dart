@@ -0,0 +1,40 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--max_async_stack_frames=10
+
+// Verifies that the awaiters collected for a stack trace are capped by
+// --max_async_stack_frames, and that synchronous frames are not affected.
+
+import 'package:expect/expect.dart';
+
+const depth = 50;
+
+int countFrames(StackTrace trace, String name) =>
+    name.allMatches(trace.toString()).length;
+
+@pragma('vm:never-inline')
+StackTrace syncCapture(int n) =>
+    n == 0 ? StackTrace.current : syncCapture(n - 1);
+
+@pragma('vm:never-inline')
+Future<StackTrace> asyncCapture(int n) async {
+  if (n == 0) {
+    await null;
+    return StackTrace.current;
+  }
+  return await asyncCapture(n - 1);
+}
+
+main() async {
+  final sync = syncCapture(depth);
+  Expect.equals(0, countFrames(sync, '<asynchronous suspension>'));
+  Expect.equals(depth + 1, countFrames(sync, 'syncCapture'));
+
+  // The running frame plus at most 10 awaiters.
+  final trace = await asyncCapture(depth);
+  final frames = countFrames(trace, 'asyncCapture');
+  Expect.isTrue(frames > 1 && frames <= 11, '$trace');
+  Expect.isTrue(countFrames(trace, '<asynchronous suspension>') <= 11);
+}
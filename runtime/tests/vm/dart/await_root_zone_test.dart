@@ -0,0 +1,65 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that awaiting values and completed futures resumes in microtask
+// order with the right value or error, in the root zone and in custom zones.
+
+import 'dart:async';
+
+import 'package:expect/expect.dart';
+
+Future<void> awaitAll(List<String> log) async {
+  log.add('start');
+  Expect.equals(1, await 1);
+  log.add('value');
+  Expect.equals(2, await Future.value(2));
+  log.add('future');
+  try {
+    await Future<int>.error('error', StackTrace.empty);
+    Expect.fail('Expected an error');
+  } catch (e, s) {
+    Expect.equals('error', e);
+    Expect.identical(StackTrace.empty, s);
+  }
+  log.add('error');
+  Expect.equals(3, await (Future.value(3) as FutureOr<int>));
+  log.add('done');
+}
+
+Future<void> testOrder() async {
+  final log = <String>[];
+  final done = awaitAll(log);
+  log.add('after call');
+  scheduleMicrotask(() => log.add('microtask'));
+  await done;
+  Expect.listEquals(
+      ['start', 'after call', 'value', 'microtask', 'future', 'error', 'done'],
+      log);
+}
+
+Future<void> testCustomZone() async {
+  var scheduled = 0;
+  var ranUnary = 0;
+  final log = <String>[];
+  await runZoned(() => awaitAll(log),
+      zoneSpecification: ZoneSpecification(
+          scheduleMicrotask: (self, parent, zone, f) {
+    scheduled++;
+    parent.scheduleMicrotask(zone, f);
+  }, runUnary: <R, T>(self, parent, zone, R Function(T) f, T arg) {
+    ranUnary++;
+    return parent.runUnary(zone, f, arg);
+  }));
+  Expect.listEquals(['start', 'value', 'future', 'error', 'done'], log);
+  // The root zone fast path must not bypass a zone which intercepts them.
+  Expect.isTrue(scheduled >= 4);
+  Expect.isTrue(ranUnary >= 3);
+}
+
+main() async {
+  for (var i = 0; i < 100; i++) {
+    await testOrder();
+  }
+  await testCustomZone();
+}
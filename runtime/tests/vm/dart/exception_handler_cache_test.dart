@@ -0,0 +1,57 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization_counter_threshold=100 --no-background-compilation
+
+// Verifies that repeated throws find the right handler once the frames they
+// pass through, with and without handlers, are cached.
+
+import 'package:expect/expect.dart';
+
+class ValidationError {
+  final int value;
+  ValidationError(this.value);
+}
+
+@pragma('vm:never-inline')
+int validate(int value) {
+  if (value.isOdd) throw ValidationError(value);
+  if (value % 10 == 0) throw StateError('$value');
+  return value;
+}
+
+@pragma('vm:never-inline')
+int passThrough(int value, int depth) =>
+    depth == 0 ? validate(value) : passThrough(value, depth - 1) + 0;
+
+@pragma('vm:never-inline')
+int catchValidation(int value) {
+  try {
+    return passThrough(value, value % 5);
+  } on ValidationError catch (e) {
+    return -e.value;
+  }
+}
+
+@pragma('vm:never-inline')
+int catchAll(int value) {
+  try {
+    return catchValidation(value);
+  } catch (e, s) {
+    Expect.isTrue(e is StateError);
+    Expect.isTrue(s.toString().contains('validate'));
+    return 0;
+  }
+}
+
+main() {
+  for (var i = 0; i < 2000; i++) {
+    final expected = i.isOdd ? -i : (i % 10 == 0 ? 0 : i);
+    Expect.equals(expected, catchAll(i));
+    // Calls through the same frames outside of any handler still throw.
+    if (i.isOdd) {
+      Expect.throws<ValidationError>(() => passThrough(i, 2));
+    }
+  }
+}
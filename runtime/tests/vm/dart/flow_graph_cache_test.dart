@@ -0,0 +1,98 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// VMOptions=--cache-flow-graphs --optimization-counter-threshold=10 --no-background-compilation
+// VMOptions=--cache-flow-graphs --optimization-counter-threshold=10 --no-background-compilation --deoptimize-every=17
+
+// Verifies that functions optimized again after a deoptimization, which reuse
+// the flow graph cached by the first optimization, compute the same results.
+
+import 'package:expect/expect.dart';
+
+class A {
+  int get value => 1;
+}
+
+class B extends A {
+  int get value => 2;
+}
+
+class Box {
+  Box(this.field);
+  dynamic field;
+}
+
+@pragma('vm:never-inline')
+int sum(List<A> list) {
+  int result = 0;
+  for (final a in list) {
+    result += a.value;
+  }
+  return result;
+}
+
+@pragma('vm:never-inline')
+dynamic add(dynamic x, dynamic y) => x + y;
+
+@pragma('vm:never-inline')
+int readBox(Box box) => box.field.length;
+
+@pragma('vm:never-inline')
+int loop(int n) {
+  // Compiled for on-stack replacement.
+  int result = 0;
+  for (int i = 0; i < n; i++) {
+    result += i % 7;
+  }
+  return result;
+}
+
+@pragma('vm:never-inline')
+int withClosure(int n) {
+  int counter = 0;
+  void increment(int by) {
+    counter += by;
+  }
+
+  for (int i = 0; i < n; i++) {
+    increment(i);
+  }
+  return counter;
+}
+
+@pragma('vm:never-inline')
+String withTry(dynamic x) {
+  try {
+    return 'ok ${x.length}';
+  } catch (e) {
+    return 'error';
+  }
+}
+
+void main() {
+  final as = List<A>.filled(10, A());
+  final bs = List<A>.filled(10, B());
+
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(10, sum(as));
+    Expect.equals(3, add(1, 2));
+    Expect.equals(3, readBox(Box('abc')));
+    Expect.equals(45, withClosure(10));
+    Expect.equals('ok 2', withTry('ab'));
+  }
+
+  // Deoptimize and optimize again.
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(20, sum(bs));
+    Expect.equals(10, sum(as));
+    Expect.equals(3.5, add(1.5, 2));
+    Expect.equals('ab', add('a', 'b'));
+    Expect.equals(2, readBox(Box([1, 2])));
+    Expect.equals(45, withClosure(10));
+    Expect.equals('error', withTry(1));
+  }
+
+  for (int i = 0; i < 3; i++) {
+    Expect.equals(2999997, loop(1000000));
+  }
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// This test ensures that gen_snapshot --serve creates a snapshot for every
+// request it reads, and that a failing request does not stop the server.
+
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+main() async {
+  if (!isAOTRuntime) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  await withTempDir('gen-snapshot-serve-test', (String tempDir) async {
+    final script = path.join(tempDir, 'main.dart');
+    final scriptDill = path.join(tempDir, 'main.dill');
+    File(script).writeAsStringSync('''
+main() => print(const String.fromEnvironment('message'));
+''');
+    await run(genKernel, <String>[
+      '--aot',
+      '--platform=$platformDill',
+      '-o',
+      scriptDill,
+      script,
+    ]);
+
+    final server = await Process.start(
+        genSnapshot, <String>['--serve', '--snapshot-kind=app-aot-elf']);
+    server.stderr.transform(utf8.decoder).listen(stderr.write);
+    final results = server.stdout
+        .transform(utf8.decoder)
+        .transform(const LineSplitter())
+        .map(int.parse);
+
+    final first = path.join(tempDir, 'first.so');
+    final second = path.join(tempDir, 'second.so');
+    final missing = path.join(tempDir, 'missing.dill');
+    server.stdin
+      ..writeln('-Dmessage=first --elf=$first $scriptDill')
+      ..writeln('--elf=${path.join(tempDir, 'missing.so')} $missing')
+      ..writeln('-Dmessage=second --elf=$second $scriptDill');
+    await server.stdin.close();
+
+    Expect.listEquals([0, 255, 0], await results.toList());
+    Expect.equals(0, await server.exitCode);
+
+    Expect.deepEquals(
+        ['first'], await runOutput(dartPrecompiledRuntime, [first]));
+    Expect.deepEquals(
+        ['second'], await runOutput(dartPrecompiledRuntime, [second]));
+  });
+}
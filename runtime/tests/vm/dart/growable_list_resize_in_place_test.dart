@@ -0,0 +1,65 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that growable lists keep their elements when the backing array
+// grows or shrinks in place.
+
+import 'package:expect/expect.dart';
+
+void testGrow() {
+  // Nothing else is allocated while adding, so the backing array can grow in
+  // place.
+  final ints = <int>[];
+  for (var i = 0; i < 100000; i++) {
+    ints.add(i);
+  }
+  for (var i = 0; i < ints.length; i++) {
+    Expect.equals(i, ints[i]);
+  }
+
+  // Each element is allocated after the backing array, so it has to move.
+  final strings = <String>[];
+  for (var i = 0; i < 10000; i++) {
+    strings.add('s$i');
+  }
+  for (var i = 0; i < strings.length; i++) {
+    Expect.equals('s$i', strings[i]);
+  }
+
+  final nullable = List<int?>.filled(100, 1, growable: true);
+  nullable.length = 1000;
+  Expect.equals(1, nullable[99]);
+  for (var i = 100; i < 1000; i++) {
+    Expect.isNull(nullable[i]);
+  }
+}
+
+void testShrink() {
+  for (final newLength in [1, 2, 3, 10, 11, 100]) {
+    final list = <int?>[for (var i = 0; i < 1000; i++) i];
+    list.length = newLength;
+    Expect.equals(newLength, list.length);
+    for (var i = 0; i < newLength; i++) {
+      Expect.equals(i, list[i]);
+    }
+    // Growing again must not bring back removed elements.
+    list.length = newLength + 5;
+    for (var i = newLength; i < newLength + 5; i++) {
+      Expect.isNull(list[i]);
+    }
+    list.addAll([for (var i = 0; i < 1000; i++) -i]);
+    Expect.equals(-999, list.last);
+  }
+  final empty = <int?>[1, 2, 3]..length = 0;
+  Expect.isTrue(empty.isEmpty);
+  empty.add(4);
+  Expect.listEquals([4], empty);
+}
+
+main() {
+  for (var i = 0; i < 5; i++) {
+    testGrow();
+    testShrink();
+  }
+}
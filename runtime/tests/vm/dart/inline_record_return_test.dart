@@ -0,0 +1,71 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation --inlining-size-threshold=1
+
+// Verifies that functions returning multiple values as a record or an object,
+// which are inlined into callers only destructuring the result, compute the
+// same results.
+
+import 'package:expect/expect.dart';
+
+class MinMax {
+  MinMax(this.min, this.max);
+  final int min;
+  final int max;
+}
+
+(int, int) minMaxRecord(List<int> list) {
+  int min = list[0];
+  int max = list[0];
+  for (int i = 1; i < list.length; i++) {
+    final value = list[i];
+    if (value < min) min = value;
+    if (value > max) max = value;
+  }
+  return (min, max);
+}
+
+({int sum, int count}) sumCount(List<int> list) {
+  int sum = 0;
+  int count = 0;
+  for (final value in list) {
+    if (value.isEven) {
+      sum += value;
+      count++;
+    }
+  }
+  return (sum: sum, count: count);
+}
+
+MinMax minMaxObject(List<int> list) {
+  final (min, max) = minMaxRecord(list);
+  return MinMax(min, max);
+}
+
+// The returned record escapes, so it is not inlined for this reason.
+(int, int) escaping(List<int> list) {
+  final result = minMaxRecord(list);
+  escaped = result;
+  return result;
+}
+
+Object? escaped;
+
+@pragma('vm:never-inline')
+int test(List<int> list) {
+  final (min, max) = minMaxRecord(list);
+  final (:sum, :count) = sumCount(list);
+  final minMax = minMaxObject(list);
+  final (a, b) = escaping(list);
+  return max - min + sum * count + minMax.max - minMax.min + a + b;
+}
+
+void main() {
+  final list = [3, -4, 8, 1, 6];
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(12 + 10 * 3 + 12 + 4, test(list));
+    Expect.equals((-4, 8), escaped);
+  }
+}
@@ -72,6 +72,10 @@ Future main(List<String> args) async {
   Expect.equals(
       arraySize(2) + 2 * objectSize(0), copyOperations[1].bytesCopied);
   Expect.equals(typedDataSize(11), copyOperations[2].bytesCopied);
+
+  for (final operation in copyOperations) {
+    Expect.isTrue(operation.fastObjectsCopied <= operation.objectsCopied);
+  }
 }
 
 List<ObjectCopyOperation> getCopyOperations(
@@ -93,7 +97,8 @@ List<ObjectCopyOperation> getCopyOperations(
           us,
           threadUs,
           int.parse(e.args['AllocatedBytes']!),
-          int.parse(e.args['CopiedObjects']!)));
+          int.parse(e.args['CopiedObjects']!),
+          int.parse(e.args['FastCopiedObjects']!)));
 
       start = null;
       continue;
@@ -110,10 +115,11 @@ class ObjectCopyOperation {
   final int threadUs;
   final int bytesCopied;
   final int objectsCopied;
+  final int fastObjectsCopied;
 
-  ObjectCopyOperation(
-      this.us, this.threadUs, this.bytesCopied, this.objectsCopied);
+  ObjectCopyOperation(this.us, this.threadUs, this.bytesCopied,
+      this.objectsCopied, this.fastObjectsCopied);
 
-  String toString() =>
-      'ObjectCopyOperation($us, $threadUs, $bytesCopied, $objectsCopied)';
+  String toString() => 'ObjectCopyOperation($us, $threadUs, $bytesCopied, '
+      '$objectsCopied, $fastObjectsCopied)';
 }
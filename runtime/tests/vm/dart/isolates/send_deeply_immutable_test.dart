@@ -0,0 +1,91 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that instances of classes marked `vm:deeply-immutable` are shared
+// instead of copied when all objects they refer to can be shared.
+
+import 'dart:async';
+import 'dart:isolate';
+
+import 'package:async_helper/async_helper.dart';
+import 'package:expect/expect.dart';
+
+@pragma('vm:deeply-immutable')
+final class Point {
+  final int x;
+  final double y;
+  final String name;
+  Point(this.x, this.y, this.name);
+}
+
+@pragma('vm:deeply-immutable')
+final class Segment {
+  final Point from;
+  final Point to;
+  Segment(this.from, this.to);
+}
+
+@pragma('vm:deeply-immutable')
+final class Holder {
+  final Object? value;
+  Holder(this.value);
+}
+
+@pragma('vm:deeply-immutable')
+final class WithMutableField {
+  int value;
+  WithMutableField(this.value);
+}
+
+final class NotMarked {
+  final int value;
+  NotMarked(this.value);
+}
+
+Future<Object?> sendAndReceive(Object? object) async {
+  final port = ReceivePort();
+  final inbox = StreamIterator<dynamic>(port);
+  port.sendPort.send(object);
+  Expect.isTrue(await inbox.moveNext());
+  final result = inbox.current;
+  port.close();
+  return result;
+}
+
+main() async {
+  asyncStart();
+
+  final point = Point(1, 2.0, 'a' * 2);
+  Expect.identical(point, await sendAndReceive(point));
+
+  final segment = Segment(Point(0, 0.0, 'from'), Point(1, 1.0, 'to'));
+  Expect.identical(segment, await sendAndReceive(segment));
+  // The validation result is cached in the object.
+  Expect.identical(segment, await sendAndReceive(segment));
+
+  Expect.identical(point, (await sendAndReceive([point]) as List)[0]);
+
+  final holdsPoint = Holder(point);
+  Expect.identical(holdsPoint, await sendAndReceive(holdsPoint));
+
+  // Instances referring to mutable objects are copied.
+  final holdsList = Holder(<int>[1, 2, 3]);
+  final copy = await sendAndReceive(holdsList) as Holder;
+  Expect.notIdentical(holdsList, copy);
+  Expect.listEquals([1, 2, 3], copy.value as List);
+  // A failed validation doesn't prevent copying the instance again.
+  Expect.notIdentical(holdsList, await sendAndReceive(holdsList));
+
+  final mutable = WithMutableField(42);
+  final mutableCopy = await sendAndReceive(mutable) as WithMutableField;
+  Expect.notIdentical(mutable, mutableCopy);
+  Expect.equals(42, mutableCopy.value);
+
+  final notMarked = NotMarked(42);
+  final notMarkedCopy = await sendAndReceive(notMarked) as NotMarked;
+  Expect.notIdentical(notMarked, notMarkedCopy);
+  Expect.equals(42, notMarkedCopy.value);
+
+  asyncEnd();
+}
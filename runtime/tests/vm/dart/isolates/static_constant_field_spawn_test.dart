@@ -0,0 +1,49 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that static fields initialized with constants have the same value in
+// isolates spawned after the field was initialized, while other initializers
+// still run once in every isolate.
+
+import 'dart:isolate';
+
+import 'package:expect/expect.dart';
+
+class Constants {
+  static final names = const ['a', 'b', 'c'];
+  static final table = const {'one': 1, 'two': 2};
+  static var counter = const <int>[];
+}
+
+int initializerRuns = 0;
+
+class Computed {
+  static final value = ++initializerRuns;
+}
+
+Object? readInIsolate() {
+  Expect.listEquals(['a', 'b', 'c'], Constants.names);
+  Expect.equals(2, Constants.table['two']);
+  Expect.isTrue(Constants.counter.isEmpty);
+  Constants.counter = const [1];
+  Expect.equals(1, Computed.value);
+  Expect.equals(1, initializerRuns);
+  return Constants.names;
+}
+
+main() async {
+  Expect.identical(Constants.names, Constants.names);
+  Expect.equals(1, Constants.table['one']);
+  Expect.equals(1, Computed.value);
+  Constants.counter = const [2];
+
+  for (var i = 0; i < 3; i++) {
+    final names = await Isolate.run(readInIsolate);
+    Expect.listEquals(['a', 'b', 'c'], names as List);
+  }
+
+  // Assignments in other isolates are not visible here.
+  Expect.listEquals([2], Constants.counter);
+  Expect.equals(1, initializerRuns);
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that views on the bytes of an unmodifiably materialized
+// [TransferableTypedData] are sent to other isolates without being copied.
+
+import 'dart:async';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:async_helper/async_helper.dart';
+import 'package:expect/expect.dart';
+
+Future<Object?> sendAndReceive(Object? object) async {
+  final port = ReceivePort();
+  final inbox = StreamIterator<dynamic>(port);
+  port.sendPort.send(object);
+  Expect.isTrue(await inbox.moveNext());
+  final result = inbox.current;
+  port.close();
+  return result;
+}
+
+void sumBytes(List<Object> args) {
+  final bytes = args[0] as Uint8List;
+  final sendPort = args[1] as SendPort;
+  int sum = 0;
+  for (final byte in bytes) {
+    sum += byte;
+  }
+  sendPort.send(sum);
+}
+
+main() async {
+  asyncStart();
+
+  final source = Uint8List.fromList(List<int>.generate(1024, (i) => i % 256));
+  final transferable = TransferableTypedData.fromList([source]);
+  final buffer = transferable.materializeUnmodifiable();
+  Expect.throws(() => transferable.materialize());
+
+  final bytes = buffer.asUint8List();
+  Expect.listEquals(source, bytes);
+  Expect.throwsUnsupportedError(() => bytes[0] = 42);
+
+  Expect.identical(bytes, await sendAndReceive(bytes));
+
+  // Several isolates can read the bytes at the same time.
+  final results = ReceivePort();
+  const workers = 4;
+  for (int i = 0; i < workers; i++) {
+    await Isolate.spawn(sumBytes, [bytes, results.sendPort]);
+  }
+  final expected = source.fold<int>(0, (sum, byte) => sum + byte);
+  final sums = await results.take(workers).toList();
+  Expect.listEquals(List<int>.filled(workers, expected), sums);
+  results.close();
+
+  asyncEnd();
+}
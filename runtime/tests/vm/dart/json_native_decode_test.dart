@@ -0,0 +1,115 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that jsonDecode builds the same objects as the Dart JSON parser,
+// which is still used when a reviver is given.
+
+import 'dart:convert';
+
+import 'package:expect/expect.dart';
+
+Object? reviveNothing(Object? key, Object? value) => value;
+
+void expectDecodes(String source) {
+  final native = jsonDecode(source);
+  final dart = jsonDecode(source, reviver: reviveNothing);
+  expectSame(dart, native);
+}
+
+void expectSame(Object? expected, Object? actual) {
+  if (expected is Map) {
+    Expect.isTrue(actual is Map<String, dynamic>);
+    actual as Map;
+    Expect.listEquals(expected.keys.toList(), actual.keys.toList());
+    for (final key in expected.keys) {
+      expectSame(expected[key], actual[key]);
+    }
+    // The map must still be usable after decoding.
+    actual['added'] = 1;
+    Expect.equals(1, actual['added']);
+  } else if (expected is List) {
+    Expect.isTrue(actual is List<dynamic>);
+    actual as List;
+    Expect.equals(expected.length, actual.length);
+    for (var i = 0; i < expected.length; i++) {
+      expectSame(expected[i], actual[i]);
+    }
+    actual.add(1);
+  } else {
+    Expect.equals(expected.runtimeType, actual.runtimeType);
+    Expect.equals(expected, actual);
+    if (expected is double) {
+      Expect.equals(expected.isNegative, (actual as double).isNegative);
+    }
+  }
+}
+
+void testValues() {
+  expectDecodes('null');
+  expectDecodes(' true ');
+  expectDecodes('\t\r\nfalse\n');
+  expectDecodes('[]');
+  expectDecodes('{}');
+  expectDecodes('[1, "a", null, true, false, [], {}]');
+  expectDecodes('{"a": {"b": [{"c": 1}]}, "d": []}');
+}
+
+void testStrings() {
+  expectDecodes('""');
+  expectDecodes('"abcé"');
+  expectDecodes('"ሴ\u{1F600}"');
+  expectDecodes(r'"\"\\\/\b\f\n\r\t"');
+  expectDecodes(r'"aAéሴ😀\ud800"');
+  expectDecodes(r'{"a": 1, "a": 2}');
+}
+
+void testNumbers() {
+  for (final number in [
+    '0', '-0', '1', '-1', '123456789', '9223372036854775807',
+    '-9223372036854775808', '9223372036854775808', '-9223372036854775809',
+    '123456789012345678901234567890', '0.0', '-0.0', '1.5', '-1.5e3',
+    '1E10', '1e+2', '1e-2', '1e400', '-1e400', '1e-400', '-1e-400',
+  ]) {
+    expectDecodes(number);
+    expectDecodes('[$number]');
+    expectDecodes('{"n":$number}');
+  }
+  Expect.identical(0, jsonDecode('-0'));
+}
+
+void testDuplicateKeys() {
+  final map = jsonDecode('{"a": 1, "b": 2, "a": 3}') as Map;
+  Expect.listEquals(['a', 'b'], map.keys.toList());
+  Expect.listEquals([3, 2], map.values.toList());
+  expectDecodes('{"a": 1, "b": 2, "a": 3}');
+}
+
+void testLargeDocuments() {
+  final objects = [for (var i = 0; i < 1000; i++) '{"id": $i, "name": "n$i"}'];
+  expectDecodes('[${objects.join(',')}]');
+  final keys = [for (var i = 0; i < 1000; i++) '"k$i": $i'];
+  expectDecodes('{${keys.join(',')}}');
+  // Deeper than the native parser goes.
+  expectDecodes('${'[' * 10000}${']' * 10000}');
+  expectDecodes('${'{"a":' * 10000}1${'}' * 10000}');
+}
+
+void testMalformed() {
+  for (final source in [
+    '', ' ', '[', ']', '{', '[1,]', '{"a":1,}', '{"a"}', '{a:1}', '01', '-',
+    '1.', '.5', '1e', '1e+', '+1', 'tru', 'nul', '"abc', '"\u0001"',
+    r'"\x"', r'"\u12"', r'"\u12g4"', '[1] 2', 'NaN', 'Infinity', "'a'",
+  ]) {
+    Expect.throwsFormatException(() => jsonDecode(source), source);
+  }
+}
+
+main() {
+  testValues();
+  testStrings();
+  testNumbers();
+  testDuplicateKeys();
+  testLargeDocuments();
+  testMalformed();
+}
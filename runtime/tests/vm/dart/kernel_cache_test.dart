@@ -0,0 +1,58 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// This test ensures that --kernel-cache reuses the kernel compiled by an
+// earlier run, and that it compiles the script again once one of its sources
+// changes.
+
+import 'dart:io';
+
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+main() async {
+  if (isAOTRuntime) {
+    return; // Running in AOT: scripts are not compiled from source.
+  }
+
+  if (Platform.isAndroid) {
+    return; // The test device cannot run scripts from source.
+  }
+
+  await withTempDir('kernel-cache-test', (String tempDir) async {
+    final script = path.join(tempDir, 'main.dart');
+    final library = path.join(tempDir, 'lib.dart');
+    final cacheDir = path.join(tempDir, 'cache');
+    File(script).writeAsStringSync('''
+import 'lib.dart';
+
+main() => print(message);
+''');
+    File(library).writeAsStringSync("const message = 'first';");
+
+    Future<List<String>> runScript() => runOutput(
+        Platform.executable, <String>['--kernel-cache=$cacheDir', script]);
+
+    // The first run compiles the script and stores the kernel.
+    Expect.deepEquals(['first'], await runScript());
+    final entries = Directory(cacheDir).listSync();
+    Expect.equals(1, entries.length);
+    final entry = entries.single as File;
+    Expect.isTrue(entry.path.endsWith('.dill'));
+    final stored = entry.readAsBytesSync();
+    final storedAt = entry.lastModifiedSync();
+
+    // The second run uses the stored kernel and leaves the entry alone.
+    Expect.deepEquals(['first'], await runScript());
+    Expect.equals(storedAt, entry.lastModifiedSync());
+
+    // Changing a library the script imports invalidates the entry.
+    File(library).writeAsStringSync("const message = 'second one';");
+    Expect.deepEquals(['second one'], await runScript());
+    Expect.equals(1, Directory(cacheDir).listSync().length);
+    Expect.notEquals(stored.length, entry.lengthSync());
+  });
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation --deoptimize-every=17
+
+// Verifies calls to local functions, which are compiled as calls to a known
+// closure function (and inlined when possible) even when the closure is
+// loaded from a context.
+
+import 'package:expect/expect.dart';
+
+@pragma('vm:never-inline')
+int fromNestedClosure(List<int> list) {
+  int offset = list.length;
+  int scale(int x, [int factor = 2]) => x * factor + offset;
+
+  int sum = 0;
+  list.forEach((x) {
+    sum += scale(x) + scale(x, 3);
+  });
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int recursive(int n) {
+  int fib(int n) => n < 2 ? n : fib(n - 1) + fib(n - 2);
+  return fib(n);
+}
+
+@pragma('vm:never-inline')
+List<T> generic<T>(T value) {
+  List<S> repeat<S>(S value, {int count = 2}) => List<S>.filled(count, value);
+  final result = <T>[];
+  for (int i = 0; i < 3; i++) {
+    [i].forEach((count) {
+      result.addAll(repeat<T>(value, count: count));
+    });
+  }
+  return result;
+}
+
+@pragma('vm:never-inline')
+Future<int> fromAsync(int x) async {
+  int twice(int y) => 2 * y;
+  final result = await Future.value(x).then((value) => twice(value));
+  return twice(result);
+}
+
+void main() async {
+  for (int i = 0; i < 50; i++) {
+    Expect.equals(78, fromNestedClosure([3, 4, 5]));
+    Expect.equals(55, recursive(10));
+    Expect.listEquals(['a', 'a', 'a'], generic<String>('a'));
+    Expect.equals(4 * i, await fromAsync(i));
+  }
+}
@@ -194,6 +194,22 @@ void main() {
   Expect.isTrue(jumpTableIntWithDefault(15) == 15);
   Expect.isTrue(jumpTableIntWithDefault(16) == 16);
   Expect.isTrue(jumpTableIntWithDefault(17) == null);
+
+  Expect.isTrue(hashString(null) == null);
+  Expect.isTrue(hashString('zero') == 0);
+  Expect.isTrue(hashString('one') == 1);
+  Expect.isTrue(hashString('two') == 2);
+  Expect.isTrue(hashString('three') == 3);
+  Expect.isTrue(hashString('four') == 4);
+  Expect.isTrue(hashString('five') == 5);
+  Expect.isTrue(hashString('six') == 6);
+  Expect.isTrue(hashString('seven') == 7);
+  Expect.isTrue(hashString('eight') == 8);
+  Expect.isTrue(hashString('nine') == null);
+  Expect.isTrue(hashString('') == null);
+  Expect.isTrue(hashString('f' + 'our') == 4);
+  Expect.isTrue(hashString('\u{1F600}') == 9);
+  Expect.isTrue(hashString(String.fromCharCodes([0x1F600])) == 9);
 }
 
 /// Small enum that is used to test binary search switches.
@@ -622,3 +638,29 @@ int? jumpTableIntWithDefault(int? v) {
       return null;
   }
 }
+
+int? hashString(String? v) {
+  switch (v) {
+    case 'zero':
+      return 0;
+    case 'one':
+      return 1;
+    case 'two':
+      return 2;
+    case 'three':
+      return 3;
+    case 'four':
+      return 4;
+    case 'five':
+      return 5;
+    case 'six':
+    case 'seven':
+      return v == 'six' ? 6 : 7;
+    case 'eight':
+      return 8;
+    case '\u{1F600}':
+      return 9;
+    default:
+      return null;
+  }
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--linear_regexp
+// VMOptions=--linear_regexp --regexp_compilation_threshold=0
+// VMOptions=--linear_regexp --interpret_irregexp
+
+// Verifies that regexps run by the linear-time engine match like the
+// backtracking engine, and that patterns it does not support still work.
+
+import 'package:expect/expect.dart';
+
+void expectMatch(RegExp re, String subject, List<String?>? groups) {
+  final match = re.firstMatch(subject);
+  if (groups == null) {
+    Expect.isNull(match);
+    return;
+  }
+  Expect.isNotNull(match);
+  Expect.listEquals(
+      groups, [for (var i = 0; i <= match!.groupCount; i++) match.group(i)]);
+}
+
+void testMatches() {
+  expectMatch(RegExp(r'(\w+)@(\w+)\.com'), 'mail bob@example.com now',
+      ['bob@example.com', 'bob', 'example']);
+  expectMatch(RegExp(r'a|ab'), 'ab', ['a']);
+  expectMatch(RegExp(r'(a|ab)(c|bcd)(d*)'), 'abcd', ['abcd', 'a', 'bcd', '']);
+  expectMatch(RegExp(r'(?:(a)|b)+'), 'ab', ['ab', null]);
+  expectMatch(RegExp(r'ABC', caseSensitive: false), 'xabc', ['abc']);
+  expectMatch(RegExp(r'^b$', multiLine: true), 'a\nb\nc', ['b']);
+  expectMatch(RegExp(r'a.c', dotAll: true), 'a\nc', ['a\nc']);
+  expectMatch(RegExp(r'(?<year>\d{4})-(?<month>\d{2})'), 'on 2023-05-01',
+      ['2023-05', '2023', '05']);
+  expectMatch(RegExp(r'x'), 'abc', null);
+
+  Expect.equals('a-b-c', 'a1b22c'.replaceAll(RegExp(r'\d+'), '-'));
+  Expect.listEquals(['a', 'b', 'c'], 'a,b;c'.split(RegExp(r'[,;]')));
+  Expect.equals('b', RegExp(r'b').matchAsPrefix('abc', 1)![0]);
+  Expect.isNull(RegExp(r'b').matchAsPrefix('abc', 0));
+}
+
+void testUnsupportedPatterns() {
+  // These run in the backtracking engine.
+  expectMatch(RegExp(r'(a)\1'), 'baa', ['aa', 'a']);
+  expectMatch(RegExp(r'a(?=b)'), 'acab', ['a']);
+  expectMatch(RegExp(r'(a*)*b'), 'aab', ['aab', 'aa']);
+  expectMatch(RegExp(r'.', unicode: true), '\u{1F600}', ['\u{1F600}']);
+}
+
+void testPathological() {
+  // Takes exponential time in a backtracking engine.
+  final subject = 'a' * 100000;
+  Expect.isFalse(RegExp(r'(a+)+b').hasMatch(subject));
+  Expect.isFalse(RegExp(r'(x+x+)+y').hasMatch('x' * 10000));
+  Expect.isTrue(RegExp(r'^(a|aa)+$').hasMatch(subject));
+}
+
+main() {
+  for (var i = 0; i < 20; i++) {
+    testMatches();
+    testUnsupportedPatterns();
+  }
+  testPathological();
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that setRange between typed lists of different element types
+// stores the same values as copying element by element.
+
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+const intValues = [
+  0, 1, -1, 127, 128, -128, -129, 255, 256, 32767, 32768, -32768, 65535,
+  65536, 0x7FFFFFFF, 0x80000000, -0x80000000, 0xFFFFFFFF, 0x100000000,
+  0x7FFFFFFFFFFFFFFF, -0x8000000000000000, 12345678901234,
+];
+
+List<List<int>> intLists(int length) => [
+      Int8List(length),
+      Uint8List(length),
+      Uint8ClampedList(length),
+      Int16List(length),
+      Uint16List(length),
+      Int32List(length),
+      Uint32List(length),
+      Int64List(length),
+      Uint64List(length),
+    ];
+
+void testIntConversions() {
+  final length = intValues.length * 2;
+  for (final source in intLists(length)) {
+    for (var i = 0; i < length; i++) {
+      source[i] = intValues[i % intValues.length];
+    }
+    for (final target in intLists(length + 4)) {
+      final expected = intLists(length + 4)
+          .firstWhere((l) => l.runtimeType == target.runtimeType);
+      for (var i = 0; i < length - 1; i++) {
+        expected[i + 3] = source[i + 1];
+      }
+      target.setRange(3, length + 2, source, 1);
+      Expect.listEquals(expected, target,
+          '${source.runtimeType} -> ${target.runtimeType}');
+    }
+  }
+}
+
+void testDoubleConversions() {
+  final values = [0.0, -0.0, 1.5, 1e-40, 1e40, 3.4028235e38, 0.1, -2.5,
+      double.infinity, double.negativeInfinity, double.minPositive];
+  final source64 = Float64List.fromList([...values, ...values]);
+  final target32 = Float32List(source64.length);
+  target32.setRange(0, source64.length, source64);
+  for (var i = 0; i < source64.length; i++) {
+    final expected = (Float32List(1)..[0] = source64[i])[0];
+    Expect.identical(expected, target32[i]);
+  }
+  final target64 = Float64List(source64.length);
+  target64.setRange(0, target32.length, target32);
+  for (var i = 0; i < target32.length; i++) {
+    Expect.identical(target32[i], target64[i]);
+  }
+  final nans = Float64List(12)..fillRange(0, 12, double.nan);
+  Expect.isTrue((Float32List(12)..setRange(0, 12, nans))[11].isNaN);
+}
+
+void testOverlappingRanges() {
+  for (final shift in [-6, -2, 0, 2, 6]) {
+    final buffer = Uint8List(64);
+    for (var i = 0; i < buffer.length; i++) {
+      buffer[i] = i * 7;
+    }
+    final bytes = Uint8List.view(buffer.buffer, 16, 24);
+    final shorts = Uint16List.view(buffer.buffer, 16 + shift, 12);
+    final expected = [for (var i = 0; i < 12; i++) bytes[i]];
+    shorts.setRange(0, 12, bytes);
+    Expect.listEquals(expected, shorts, 'shift $shift');
+
+    final source = Uint16List.view(buffer.buffer, 16, 12);
+    final narrowed = [for (var i = 0; i < 12; i++) source[i] & 0xFF];
+    final target = Uint8List.view(buffer.buffer, 16 + shift, 12);
+    target.setRange(0, 12, source);
+    Expect.listEquals(narrowed, target, 'shift $shift');
+  }
+}
+
+main() {
+  for (var i = 0; i < 3; i++) {
+    testIntConversions();
+    testDoubleConversions();
+    testOverlappingRanges();
+  }
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// This test ensures that the precompiled runtime can symbolize DWARF stack
+// traces itself when given the separate debugging information, and that the
+// result agrees with offline symbolization.
+
+// OtherResources=use_save_debugging_info_flag_program.dart
+
+import "dart:io";
+
+import 'package:expect/expect.dart';
+import 'package:native_stack_traces/native_stack_traces.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+main(List<String> args) async {
+  if (!isAOTRuntime) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and dart_bootstrap not available on the test device.
+  }
+
+  // These are the tools we need to be available to run on a given platform:
+  if (!await testExecutable(genSnapshot)) {
+    throw "Cannot run test as $genSnapshot not available";
+  }
+  if (!await testExecutable(dartPrecompiledRuntime)) {
+    throw "Cannot run test as $dartPrecompiledRuntime not available";
+  }
+  if (!File(platformDill).existsSync()) {
+    throw "Cannot run test as $platformDill does not exist";
+  }
+
+  await withTempDir('dwarf-debug-info-flag-test', (String tempDir) async {
+    final cwDir = path.dirname(Platform.script.toFilePath());
+    final script =
+        path.join(cwDir, 'use_save_debugging_info_flag_program.dart');
+    final scriptDill = path.join(tempDir, 'flag_program.dill');
+
+    await run(genKernel, <String>[
+      '--aot',
+      '--platform=$platformDill',
+      '-o',
+      scriptDill,
+      script,
+    ]);
+
+    final scriptSnapshot = path.join(tempDir, 'stripped.so');
+    final scriptDebuggingInfo = path.join(tempDir, 'debug.so');
+    await run(genSnapshot, <String>[
+      '--dwarf-stack-traces',
+      '--snapshot-kind=app-aot-elf',
+      '--elf=$scriptSnapshot',
+      '--strip',
+      '--save-debugging-info=$scriptDebuggingInfo',
+      scriptDill,
+    ]);
+
+    final plainTrace = await runError(dartPrecompiledRuntime, <String>[
+      scriptSnapshot,
+      scriptDill,
+    ]);
+    final trace = await runError(dartPrecompiledRuntime, <String>[
+      '--dwarf-debug-info=$scriptDebuggingInfo',
+      scriptSnapshot,
+      scriptDill,
+    ]);
+    print("Stack trace symbolized in-process:");
+    trace.forEach(print);
+
+    // The non-symbolic part of the stack trace is unchanged.
+    final marker = trace.indexWhere(
+        (line) => line.contains('symbolized with --dwarf_debug_info'));
+    Expect.isTrue(marker >= 0);
+    Expect.deepEquals(collectPCOffsets(plainTrace).toList(),
+        collectPCOffsets(trace.sublist(0, marker)).toList());
+
+    final symbolized = trace.sublist(marker + 1);
+    Expect.isTrue(symbolized.any((line) => RegExp(
+            r'^#\d+\s+bar \(.*use_save_debugging_info_flag_program\.dart:14:')
+        .hasMatch(line)));
+
+    // Every frame symbolized in-process names a function that offline
+    // symbolization also reports.
+    final offline = await Stream.fromIterable(plainTrace)
+        .transform(
+            DwarfStackTraceDecoder(Dwarf.fromFile(scriptDebuggingInfo)!))
+        .join('\n');
+    for (final line in symbolized) {
+      final match = RegExp(r'^#\d+\s+(\S+) \(').firstMatch(line);
+      if (match == null) continue;
+      Expect.contains(match.group(1)!, offline);
+    }
+  });
+}
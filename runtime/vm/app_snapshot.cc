@@ -28,6 +28,7 @@
 #include "vm/program_visitor.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/v8_snapshot_writer.h"
 #include "vm/version.h"
@@ -60,6 +61,11 @@ DEFINE_FLAG(bool,
             "ROData optimizations.");
 #endif  // defined(DART_PRECOMPILER)
 
+DEFINE_FLAG(bool,
+            concurrent_snapshot_fill,
+            true,
+            "Fill large clusters of a snapshot on helper threads.");
+
 namespace {
 
 // Serialized clusters are identified by their CID. So to insert custom clusters
@@ -2016,6 +2022,7 @@ class CodeSerializationCluster : public SerializationCluster {
     CodePtr code;
     intptr_t not_discarded;  // 1 if this code was not discarded and
                              // 0 otherwise.
+    intptr_t cold;           // 1 if this code is cold and 0 otherwise.
     intptr_t instructions_id;
   };
 
@@ -2030,10 +2037,16 @@ class CodeSerializationCluster : public SerializationCluster {
   // there is no way to identify which specific Code object (out of those
   // which point to the specific instructions range) actually corresponds
   // to a particular frame.
+  //
+  // Within each of these two groups, cold code (see Code::is_cold) is placed
+  // after all other code, so that the code which is actually executed is
+  // densely packed in fewer pages.
   static int CompareCodeOrderInfo(CodeOrderInfo const* a,
                                   CodeOrderInfo const* b) {
     if (a->not_discarded < b->not_discarded) return -1;
     if (a->not_discarded > b->not_discarded) return 1;
+    if (a->cold < b->cold) return -1;
+    if (a->cold > b->cold) return 1;
     if (a->instructions_id < b->instructions_id) return -1;
     if (a->instructions_id > b->instructions_id) return 1;
     return 0;
@@ -2060,6 +2073,7 @@ class CodeSerializationCluster : public SerializationCluster {
     info.code = code;
     info.instructions_id = instructions_id;
     info.not_discarded = Code::IsDiscarded(code) ? 0 : 1;
+    info.cold = Code::IsCold(code) ? 1 : 0;
     order_list->Add(info);
   }
 
@@ -2966,7 +2980,7 @@ class CompressedStackMapsDeserializationCluster
 };
 
 #if !defined(DART_PRECOMPILED_RUNTIME) && !defined(DART_COMPRESSED_POINTERS)
-// PcDescriptor, CompressedStackMaps, OneByteString, TwoByteString
+// PcDescriptor, CompressedStackMaps, OneByteString, TwoByteString, Double
 class RODataSerializationCluster
     : public CanonicalSetSerializationCluster<CanonicalStringSet,
                                               String,
@@ -5496,6 +5510,7 @@ class RegExpDeserializationCluster : public DeserializationCluster {
       regexp->untag()->num_one_byte_registers_ = d.Read<int32_t>();
       regexp->untag()->num_two_byte_registers_ = d.Read<int32_t>();
       regexp->untag()->type_flags_ = d.Read<int8_t>();
+      regexp->untag()->interpreted_executions_ = 0;
     }
   }
 };
@@ -5849,24 +5864,36 @@ class ArrayDeserializationCluster
 
   void ReadFill(Deserializer* d_, bool primary) {
     Deserializer::Local d(d_);
+    ReadFill(&d, primary);
+  }
+
+  bool CanReadFillConcurrently() const { return true; }
 
+  void ReadFillConcurrently(Deserializer* d_,
+                            intptr_t position,
+                            bool primary) {
+    Deserializer::Local d(d_, position);
+    ReadFill(&d, primary);
+  }
+
+ private:
+  DART_FORCE_INLINE void ReadFill(Deserializer::Local* d, bool primary) {
     const intptr_t cid = cid_;
     const bool stamp_canonical = primary && is_canonical();
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
-      ArrayPtr array = static_cast<ArrayPtr>(d.Ref(id));
-      const intptr_t length = d.ReadUnsigned();
+      ArrayPtr array = static_cast<ArrayPtr>(d->Ref(id));
+      const intptr_t length = d->ReadUnsigned();
       Deserializer::InitializeHeader(array, cid, Array::InstanceSize(length),
                                      stamp_canonical);
       array->untag()->type_arguments_ =
-          static_cast<TypeArgumentsPtr>(d.ReadRef());
+          static_cast<TypeArgumentsPtr>(d->ReadRef());
       array->untag()->length_ = Smi::New(length);
       for (intptr_t j = 0; j < length; j++) {
-        array->untag()->data()[j] = d.ReadRef();
+        array->untag()->data()[j] = d->ReadRef();
       }
     }
   }
 
- private:
   const intptr_t cid_;
 };
 
@@ -7131,7 +7158,11 @@ intptr_t Serializer::UnsafeRefId(ObjectPtr object) const {
   FATAL("Reference for object %s is unallocated", handle.ToCString());
 }
 
-const char* Serializer::ReadOnlyObjectType(intptr_t cid) {
+const char* Serializer::ReadOnlyObjectType(intptr_t cid, bool is_canonical) {
+  // Canonical objects of deferred units are recanonicalized when the unit is
+  // loaded, which read-only objects cannot be.
+  const bool is_root_unit = current_loading_unit_id_ <= LoadingUnit::kRootId;
+  const bool can_be_read_only = is_root_unit || !is_canonical;
   switch (cid) {
     case kPcDescriptorsCid:
       return "PcDescriptors";
@@ -7140,17 +7171,16 @@ const char* Serializer::ReadOnlyObjectType(intptr_t cid) {
     case kCompressedStackMapsCid:
       return "CompressedStackMaps";
     case kStringCid:
-      return current_loading_unit_id_ <= LoadingUnit::kRootId
-                 ? "CanonicalString"
-                 : nullptr;
+      return can_be_read_only ? (is_root_unit ? "CanonicalString" : "String")
+                              : nullptr;
     case kOneByteStringCid:
-      return current_loading_unit_id_ <= LoadingUnit::kRootId
-                 ? "OneByteStringCid"
-                 : nullptr;
+      return can_be_read_only ? "OneByteStringCid" : nullptr;
     case kTwoByteStringCid:
-      return current_loading_unit_id_ <= LoadingUnit::kRootId
-                 ? "TwoByteStringCid"
-                 : nullptr;
+      return can_be_read_only ? "TwoByteStringCid" : nullptr;
+    case kDoubleCid:
+      // JIT code updates the boxes of unboxed fields in place.
+      return (kind_ == Snapshot::kFullAOT && can_be_read_only) ? "Double"
+                                                               : nullptr;
     default:
       return nullptr;
   }
@@ -7187,7 +7217,7 @@ SerializationCluster* Serializer::NewClusterForClass(intptr_t cid,
   // the memory image, and it might be outside the 4GB region addressable by
   // compressed pointers.
   if (Snapshot::IncludesCode(kind_)) {
-    if (auto const type = ReadOnlyObjectType(cid)) {
+    if (auto const type = ReadOnlyObjectType(cid, is_canonical)) {
       return new (Z) RODataSerializationCluster(Z, type, cid, is_canonical);
     }
   }
@@ -8037,7 +8067,19 @@ ZoneGrowableArray<Object*>* Serializer::Serialize(SerializationRoots* roots) {
 #endif
 
   for (SerializationCluster* cluster : clusters) {
+    // Prefix each fill with its size, so that the deserializer can skip over
+    // the fills of clusters it reads concurrently.
+    const intptr_t size_position = bytes_written();
+    Write<uint32_t>(0);
     cluster->WriteAndMeasureFill(this);
+    const intptr_t fill_end = bytes_written();
+    const intptr_t fill_size = fill_end - size_position - sizeof(uint32_t);
+    if (!Utils::IsUint(32, fill_size)) {
+      FATAL("Fill of cluster %s is too large", cluster->name());
+    }
+    stream_->SetPosition(size_position);
+    Write<uint32_t>(fill_size);
+    stream_->SetPosition(fill_end);
 #if defined(DEBUG)
     Write<int32_t>(kSectionMarker);
 #endif
@@ -8338,7 +8380,14 @@ DeserializationCluster* Deserializer::ReadCluster() {
       case kOneByteStringCid:
       case kTwoByteStringCid:
       case kStringCid:
-        if (!is_non_root_unit_) {
+        if (!is_non_root_unit_ || !is_canonical) {
+          return new (Z) RODataDeserializationCluster(is_canonical,
+                                                      !is_non_root_unit_, cid);
+        }
+        break;
+      case kDoubleCid:
+        if (kind_ == Snapshot::kFullAOT &&
+            (!is_non_root_unit_ || !is_canonical)) {
           return new (Z) RODataDeserializationCluster(is_canonical,
                                                       !is_non_root_unit_, cid);
         }
@@ -8807,6 +8856,63 @@ class HeapLocker : public StackResource {
   FreeList* freelist_;
 };
 
+class ReadFillTask : public ThreadPool::Task {
+ public:
+  ReadFillTask(Deserializer* deserializer,
+               DeserializationCluster* cluster,
+               intptr_t position,
+               bool primary,
+               Monitor* monitor,
+               intptr_t* pending_fills)
+      : deserializer_(deserializer),
+        cluster_(cluster),
+        position_(position),
+        primary_(primary),
+        monitor_(monitor),
+        pending_fills_(pending_fills) {}
+
+  virtual void Run() {
+    cluster_->ReadFillConcurrently(deserializer_, position_, primary_);
+    MonitorLocker ml(monitor_);
+    if (--(*pending_fills_) == 0) {
+      ml.Notify();
+    }
+  }
+
+ private:
+  Deserializer* const deserializer_;
+  DeserializationCluster* const cluster_;
+  const intptr_t position_;
+  const bool primary_;
+  Monitor* const monitor_;
+  intptr_t* const pending_fills_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadFillTask);
+};
+
+bool Deserializer::ReadFillConcurrently(DeserializationCluster* cluster,
+                                        intptr_t position,
+                                        intptr_t size,
+                                        bool primary,
+                                        Monitor* monitor,
+                                        intptr_t* pending_fills) {
+  if (!FLAG_concurrent_snapshot_fill || size < kMinConcurrentFillSize ||
+      !cluster->CanReadFillConcurrently()) {
+    return false;
+  }
+  {
+    MonitorLocker ml(monitor);
+    (*pending_fills)++;
+  }
+  if (Dart::thread_pool()->Run<ReadFillTask>(this, cluster, position, primary,
+                                             monitor, pending_fills)) {
+    return true;
+  }
+  MonitorLocker ml(monitor);
+  (*pending_fills)--;
+  return false;
+}
+
 void Deserializer::Deserialize(DeserializationRoots* roots) {
   const void* clustered_start = AddressOfCurrentPosition();
 
@@ -8873,6 +8979,7 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
       TIMELINE_DURATION(thread(), Isolate, "ReadAlloc");
       for (intptr_t i = 0; i < num_clusters_; i++) {
         clusters_[i] = ReadCluster();
+        TIMELINE_DURATION(thread(), Isolate, clusters_[i]->name());
         clusters_[i]->ReadAlloc(this);
 #if defined(DEBUG)
         intptr_t serializers_next_ref_index_ = Read<int32_t>();
@@ -8887,16 +8994,33 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
     {
       TIMELINE_DURATION(thread(), Isolate, "ReadFill");
       SafepointWriteRwLocker ml(thread(), isolate_group()->program_lock());
+      Monitor monitor;
+      intptr_t pending_fills = 0;
       for (intptr_t i = 0; i < num_clusters_; i++) {
-        clusters_[i]->ReadFill(this, primary);
+        TIMELINE_DURATION(thread(), Isolate, clusters_[i]->name());
+        const intptr_t fill_size = Read<uint32_t>();
+        const intptr_t fill_start = position();
+        if (!ReadFillConcurrently(clusters_[i], fill_start, fill_size, primary,
+                                  &monitor, &pending_fills)) {
+          clusters_[i]->ReadFill(this, primary);
+        }
+        ASSERT_EQUAL(position(), fill_start + fill_size);
+        set_position(fill_start + fill_size);
 #if defined(DEBUG)
         int32_t section_marker = Read<int32_t>();
         ASSERT(section_marker == kSectionMarker);
 #endif
       }
+      MonitorLocker fills_locker(&monitor);
+      while (pending_fills > 0) {
+        fills_locker.Wait();
+      }
     }
 
-    roots->ReadRoots(this);
+    {
+      TIMELINE_DURATION(thread(), Isolate, "ReadRoots");
+      roots->ReadRoots(this);
+    }
 
 #if defined(DEBUG)
     int32_t section_marker = Read<int32_t>();
@@ -8906,7 +9030,10 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
     refs_ = nullptr;
   }
 
-  roots->PostLoad(this, refs);
+  {
+    TIMELINE_DURATION(thread(), Isolate, "PostLoadRoots");
+    roots->PostLoad(this, refs);
+  }
 
   auto isolate_group = thread()->isolate_group();
 #if defined(DEBUG)
@@ -8919,6 +9046,7 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
   {
     TIMELINE_DURATION(thread(), Isolate, "PostLoad");
     for (intptr_t i = 0; i < num_clusters_; i++) {
+      TIMELINE_DURATION(thread(), Isolate, clusters_[i]->name());
       clusters_[i]->PostLoad(this, refs, primary);
     }
   }
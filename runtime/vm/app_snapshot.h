@@ -44,6 +44,7 @@ class Deserializer;
 class ObjectStore;
 class ImageWriter;
 class ImageReader;
+class Monitor;
 
 class LoadingUnitSerializationData : public ZoneAllocated {
  public:
@@ -143,6 +144,18 @@ class DeserializationCluster : public ZoneAllocated {
   // Initialize the cluster's objects. Do not touch the memory of other objects.
   virtual void ReadFill(Deserializer* deserializer, bool primary) = 0;
 
+  // Whether ReadFill only reads the snapshot and the ref array, and so can run
+  // on a helper thread while other clusters are filled.
+  virtual bool CanReadFillConcurrently() const { return false; }
+
+  // Same as ReadFill, but reads the fill at [position] without moving the
+  // cursor of [deserializer].
+  virtual void ReadFillConcurrently(Deserializer* deserializer,
+                                    intptr_t position,
+                                    bool primary) {
+    UNREACHABLE();
+  }
+
   // Complete any action that requires the full graph to be deserialized, such
   // as rehashing.
   virtual void PostLoad(Deserializer* deserializer,
@@ -497,7 +510,7 @@ class Serializer : public ThreadStackResource {
   }
 
  private:
-  const char* ReadOnlyObjectType(intptr_t cid);
+  const char* ReadOnlyObjectType(intptr_t cid, bool is_canonical);
   void FlushProfile();
 
   Heap* heap_;
@@ -739,6 +752,7 @@ class Deserializer : public ThreadStackResource {
     explicit Local(Deserializer* d)
         : ReadStream(d->stream_.buffer_, d->stream_.current_, d->stream_.end_),
           d_(d),
+          parent_(&d->stream_),
           refs_(d->refs_),
           null_(Object::null()) {
 #if defined(DEBUG)
@@ -746,8 +760,20 @@ class Deserializer : public ThreadStackResource {
       d->stream_.current_ = nullptr;
 #endif
     }
+    // Reads from [position] without touching the cursor of [d], for fills
+    // running on helper threads.
+    Local(Deserializer* d, intptr_t position)
+        : ReadStream(d->stream_.buffer_,
+                     d->stream_.buffer_ + position,
+                     d->stream_.end_),
+          d_(d),
+          parent_(nullptr),
+          refs_(d->refs_),
+          null_(Object::null()) {}
     ~Local() {
-      d_->stream_.current_ = current_;
+      if (parent_ != nullptr) {
+        parent_->current_ = current_;
+      }
     }
 
     ObjectPtr Ref(intptr_t index) const {
@@ -795,11 +821,24 @@ class Deserializer : public ThreadStackResource {
 
    private:
     Deserializer* const d_;
+    ReadStream* const parent_;
     const ArrayPtr refs_;
     const ObjectPtr null_;
   };
 
  private:
+  // Fills smaller than this are not worth handing to a helper thread.
+  static constexpr intptr_t kMinConcurrentFillSize = 64 * KB;
+
+  // Starts filling [cluster] from [position] on a helper thread, counting it
+  // in [pending_fills]. Returns false if the fill must be read in place.
+  bool ReadFillConcurrently(DeserializationCluster* cluster,
+                            intptr_t position,
+                            intptr_t size,
+                            bool primary,
+                            Monitor* monitor,
+                            intptr_t* pending_fills);
+
   Heap* heap_;
   Zone* zone_;
   Snapshot::Kind kind_;
@@ -4,6 +4,15 @@
 
 #include "vm/benchmark_test.h"
 
+#if defined(DART_HOST_OS_LINUX)
+#include <linux/perf_event.h>  // NOLINT
+#include <sys/ioctl.h>         // NOLINT
+#include <sys/syscall.h>       // NOLINT
+#include <unistd.h>            // NOLINT
+#endif
+
+#include <stdarg.h>
+
 #include "bin/builtin.h"
 #include "bin/file.h"
 #include "bin/isolate_data.h"
@@ -18,6 +27,7 @@
 #include "vm/app_snapshot.h"
 #include "vm/dart_api_impl.h"
 #include "vm/datastream.h"
+#include "vm/heap/heap.h"
 #include "vm/message_snapshot.h"
 #include "vm/stack_frame.h"
 #include "vm/timer.h"
@@ -30,6 +40,103 @@ Benchmark* Benchmark::first_ = nullptr;
 Benchmark* Benchmark::tail_ = nullptr;
 const char* Benchmark::executable_ = nullptr;
 
+DEFINE_FLAG(bool,
+            benchmark_perf_counters,
+            false,
+            "Report the cycles, instructions, cache misses and branch misses "
+            "of each benchmark (Linux only).");
+DEFINE_FLAG(int,
+            gc_benchmark_heap_scale,
+            1,
+            "Multiplies the number of long-lived objects in the GCHeapShape "
+            "benchmarks.");
+
+const char* Benchmark::PerfCounterName(PerfCounter counter) {
+  switch (counter) {
+    case kCycles:
+      return "Cycles";
+    case kInstructions:
+      return "Instructions";
+    case kCacheMisses:
+      return "CacheMisses";
+    case kBranchMisses:
+      return "BranchMisses";
+    default:
+      UNREACHABLE();
+      return nullptr;
+  }
+}
+
+#if defined(DART_HOST_OS_LINUX)
+static int OpenPerfCounter(Benchmark::PerfCounter counter, int group_fd) {
+  static const uint64_t kConfigs[Benchmark::kNumPerfCounters] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES,
+      PERF_COUNT_HW_BRANCH_MISSES,
+  };
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = kConfigs[counter];
+  attr.read_format = PERF_FORMAT_GROUP;
+  // The leader starts disabled and enables the whole group at once.
+  attr.disabled = group_fd == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return syscall(__NR_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, group_fd,
+                 /*flags=*/0);
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
+BenchmarkPerfCountersScope::BenchmarkPerfCountersScope(Benchmark* benchmark)
+    : benchmark_(benchmark) {
+  for (intptr_t i = 0; i < Benchmark::kNumPerfCounters; i++) {
+    fds_[i] = -1;
+  }
+  if (!FLAG_benchmark_perf_counters) return;
+#if defined(DART_HOST_OS_LINUX)
+  for (intptr_t i = 0; i < Benchmark::kNumPerfCounters; i++) {
+    fds_[i] = OpenPerfCounter(static_cast<Benchmark::PerfCounter>(i), fds_[0]);
+    if (fds_[i] == -1) {
+      OS::PrintErr("warning: Failed to open %s counter.\n",
+                   Benchmark::PerfCounterName(
+                       static_cast<Benchmark::PerfCounter>(i)));
+      for (intptr_t j = 0; j < i; j++) {
+        close(fds_[j]);
+        fds_[j] = -1;
+      }
+      return;
+    }
+  }
+  ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+  OS::PrintErr("warning: --benchmark_perf_counters is only supported on "
+               "Linux.\n");
+#endif  // defined(DART_HOST_OS_LINUX)
+}
+
+BenchmarkPerfCountersScope::~BenchmarkPerfCountersScope() {
+#if defined(DART_HOST_OS_LINUX)
+  if (fds_[0] == -1) return;
+  ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  // With PERF_FORMAT_GROUP the leader reads the number of counters followed
+  // by their values.
+  uint64_t values[1 + Benchmark::kNumPerfCounters];
+  if (read(fds_[0], values, sizeof(values)) == sizeof(values)) {
+    for (intptr_t i = 0; i < Benchmark::kNumPerfCounters; i++) {
+      benchmark_->set_perf_counter(static_cast<Benchmark::PerfCounter>(i),
+                                   static_cast<int64_t>(values[1 + i]));
+    }
+  }
+  for (intptr_t i = 0; i < Benchmark::kNumPerfCounters; i++) {
+    close(fds_[i]);
+  }
+#endif  // defined(DART_HOST_OS_LINUX)
+}
+
 void Benchmark::RunAll(const char* executable) {
   SetExecutable(executable);
   Benchmark* benchmark = first_;
@@ -607,6 +714,380 @@ BENCHMARK(LargeMap) {
   benchmark->set_score(elapsed_time);
 }
 
+// FFI calls can not leave the simulator.
+#if !defined(USING_SIMULATOR)
+
+//
+// Measure the phases of FFI calls in isolation. Each benchmark calls a
+// trivial native function, so the differences between their scores are the
+// cost of the safepoint transition, the marshalling of arguments, and the
+// callback entry and exit.
+//
+struct BenchmarkFfiCoordinate {
+  int64_t x;
+  int64_t y;
+  int64_t z;
+};
+
+static BenchmarkFfiCoordinate benchmark_ffi_coordinate = {1, 2, 3};
+
+static int64_t BenchmarkFfiNop(int64_t x) {
+  return x;
+}
+
+static BenchmarkFfiCoordinate BenchmarkFfiPassStruct(
+    BenchmarkFfiCoordinate coordinate) {
+  return coordinate;
+}
+
+static BenchmarkFfiCoordinate* BenchmarkFfiStructStorage() {
+  return &benchmark_ffi_coordinate;
+}
+
+static int64_t BenchmarkFfiVarArgs(int64_t count, ...) {
+  va_list arguments;
+  va_start(arguments, count);
+  int64_t sum = 0;
+  for (int64_t i = 0; i < count; i++) {
+    sum += va_arg(arguments, int64_t);
+  }
+  va_end(arguments);
+  return sum;
+}
+
+static int64_t BenchmarkFfiCallCallback(int64_t (*callback)(int64_t),
+                                        int64_t count) {
+  int64_t sum = 0;
+  for (int64_t i = 0; i < count; i++) {
+    sum += callback(i);
+  }
+  return sum;
+}
+
+static void* BenchmarkFfiNativeResolver(const char* name, uintptr_t args_n) {
+  if (strcmp(name, "BenchmarkFfiNop") == 0) {
+    return reinterpret_cast<void*>(BenchmarkFfiNop);
+  }
+  if (strcmp(name, "BenchmarkFfiPassStruct") == 0) {
+    return reinterpret_cast<void*>(BenchmarkFfiPassStruct);
+  }
+  if (strcmp(name, "BenchmarkFfiStructStorage") == 0) {
+    return reinterpret_cast<void*>(BenchmarkFfiStructStorage);
+  }
+  if (strcmp(name, "BenchmarkFfiVarArgs") == 0) {
+    return reinterpret_cast<void*>(BenchmarkFfiVarArgs);
+  }
+  if (strcmp(name, "BenchmarkFfiCallCallback") == 0) {
+    return reinterpret_cast<void*>(BenchmarkFfiCallCallback);
+  }
+  return nullptr;
+}
+
+static const char* kFfiBenchmarkScript = R"(
+import 'dart:ffi';
+
+final class Coordinate extends Struct {
+  @Int64()
+  external int x;
+  @Int64()
+  external int y;
+  @Int64()
+  external int z;
+}
+
+@FfiNative<Int64 Function(Int64)>('BenchmarkFfiNop', isLeaf: true)
+external int nopLeaf(int x);
+
+@FfiNative<Int64 Function(Int64)>('BenchmarkFfiNop')
+external int nop(int x);
+
+@FfiNative<Coordinate Function(Coordinate)>('BenchmarkFfiPassStruct',
+    isLeaf: true)
+external Coordinate passStruct(Coordinate coordinate);
+
+@FfiNative<Pointer<Coordinate> Function()>('BenchmarkFfiStructStorage')
+external Pointer<Coordinate> structStorage();
+
+@FfiNative<Int64 Function(Int64, VarArgs<(Int64, Int64, Int64)>)>(
+    'BenchmarkFfiVarArgs', isLeaf: true)
+external int varArgs(int count, int a, int b, int c);
+
+@FfiNative<Int64 Function(Pointer<NativeFunction<Int64 Function(Int64)>>,
+    Int64)>('BenchmarkFfiCallCallback')
+external int callCallback(
+    Pointer<NativeFunction<Int64 Function(Int64)>> callback, int count);
+
+int identity(int x) => x;
+
+void leafCall(int count) {
+  for (int i = 0; i < count; i++) {
+    nopLeaf(i);
+  }
+}
+
+void call(int count) {
+  for (int i = 0; i < count; i++) {
+    nop(i);
+  }
+}
+
+void structByValue(int count) {
+  Coordinate coordinate = structStorage().ref;
+  for (int i = 0; i < count; i++) {
+    coordinate = passStruct(coordinate);
+  }
+}
+
+void varArgsCall(int count) {
+  for (int i = 0; i < count; i++) {
+    varArgs(3, i, i, i);
+  }
+}
+
+void callback(int count) {
+  callCallback(
+      Pointer.fromFunction<Int64 Function(Int64)>(identity, 0), count);
+}
+)";
+
+// Runs [function] of kFfiBenchmarkScript once to warm up, and then scores a
+// run of [count] calls.
+static void RunFfiBenchmark(Benchmark* benchmark,
+                            const char* function,
+                            intptr_t count) {
+  Dart_Handle lib = TestCase::LoadTestScript(kFfiBenchmarkScript, nullptr);
+  EXPECT_VALID(lib);
+  EXPECT_VALID(Dart_SetFfiNativeResolver(lib, &BenchmarkFfiNativeResolver));
+
+  // Warmup first to avoid compilation jitters. It is kept short, since hardware
+  // counters include it.
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(count / 10);
+  Dart_Handle result = Dart_Invoke(lib, NewString(function), 1, args);
+  EXPECT_VALID(result);
+
+  args[0] = Dart_NewInteger(count);
+  Timer timer;
+  timer.Start();
+  result = Dart_Invoke(lib, NewString(function), 1, args);
+  EXPECT_VALID(result);
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+static constexpr intptr_t kFfiBenchmarkCalls = 10000000;
+
+// Baseline: the call sequence without a transition.
+BENCHMARK(FfiLeafCall) {
+  RunFfiBenchmark(benchmark, "leafCall", kFfiBenchmarkCalls);
+}
+
+// Adds the transition to native and back, including the safepoint checks.
+BENCHMARK(FfiCall) {
+  RunFfiBenchmark(benchmark, "call", kFfiBenchmarkCalls);
+}
+
+// Adds the marshalling of a struct argument and result passed by value.
+BENCHMARK(FfiCallStructByValue) {
+  RunFfiBenchmark(benchmark, "structByValue", kFfiBenchmarkCalls);
+}
+
+// Adds the marshalling of variadic arguments.
+BENCHMARK(FfiCallVarArgs) {
+  RunFfiBenchmark(benchmark, "varArgsCall", kFfiBenchmarkCalls);
+}
+
+// Callback entry and exit, including the transitions into Dart and back.
+BENCHMARK(FfiCallback) {
+  RunFfiBenchmark(benchmark, "callback", kFfiBenchmarkCalls);
+}
+
+#endif  // !defined(USING_SIMULATOR)
+
+//
+// Measure GC pauses and throughput with long-lived heaps of different shapes.
+// Each shape builds a large live heap and then replaces a part of it every
+// round while allocating short-lived garbage. Besides the total time, the
+// pause percentiles of the isolate group's heap are reported, so GC flags can
+// be compared by running these benchmarks with different flags. The size of
+// the live heap is scaled with --gc_benchmark_heap_scale.
+//
+static const char* kGCHeapShapesScript = R"(
+import 'dart:typed_data';
+
+class Entry {
+  final int key;
+  final Object? payload;
+  Entry(this.key, this.payload);
+}
+
+// Allocates short-lived garbage between updates of the long-lived objects.
+int churn(int count) {
+  int sum = 0;
+  for (int i = 0; i < count; i++) {
+    final garbage = [i, 'garbage', Entry(i, null)];
+    sum += garbage.length;
+  }
+  return sum;
+}
+
+// Spreads the replaced entries over the whole heap shape.
+int victim(int round, int i, int size) => (round * 7919 + i * 104729) % size;
+
+// A map of [size] entries, 1% of which are replaced every round.
+int cache(int size, int rounds) {
+  final cache = <int, Entry>{};
+  for (int i = 0; i < size; i++) {
+    cache[i] = Entry(i, Uint8List(16));
+  }
+  int sum = 0;
+  for (int r = 0; r < rounds; r++) {
+    for (int i = 0; i < size ~/ 100; i++) {
+      final key = victim(r, i, size);
+      cache[key] = Entry(key, Uint8List(16));
+    }
+    sum += churn(size ~/ 10);
+  }
+  return sum + cache.length;
+}
+
+// Arrays large enough to be card marked, a strided part of which is
+// overwritten with new objects every round.
+int cardMarkedArray(int size, int rounds) {
+  final arrays =
+      List.generate(4, (_) => List<Object?>.filled(size ~/ 4, null));
+  int sum = 0;
+  for (int r = 0; r < rounds; r++) {
+    for (final array in arrays) {
+      for (int i = r % 64; i < array.length; i += 64) {
+        array[i] = Entry(i, r);
+      }
+    }
+    sum += churn(size ~/ 10);
+  }
+  return sum;
+}
+
+// An Expando whose values reference their keys, and weak references to the
+// keys. 1% of the keys die every round.
+int weakMap(int size, int rounds) {
+  final keys = List<Object>.generate(size, (i) => Entry(i, null));
+  final expando = Expando<Object>();
+  final references = <WeakReference<Object>>[
+    for (final key in keys) WeakReference(key),
+  ];
+  for (int i = 0; i < size; i++) {
+    expando[keys[i]] = Entry(i, keys[i]);
+  }
+  int sum = 0;
+  for (int r = 0; r < rounds; r++) {
+    for (int i = 0; i < size ~/ 100; i++) {
+      final index = victim(r, i, size);
+      final key = Entry(index, r);
+      keys[index] = key;
+      expando[key] = Entry(index, key);
+      references[index] = WeakReference(key);
+    }
+    sum += churn(size ~/ 10);
+  }
+  for (final reference in references) {
+    if (reference.target != null) sum++;
+  }
+  return sum;
+}
+
+// The callbacks never run, since there is no message loop, but the GC still
+// has to process the finalizer entries of the objects that die.
+final finalizer = Finalizer<int>((_) {});
+
+// Objects with finalizers attached, 1% of which die every round.
+int finalizers(int size, int rounds) {
+  final objects = List<Object>.generate(size, (i) {
+    final object = Entry(i, null);
+    finalizer.attach(object, i);
+    return object;
+  });
+  int sum = 0;
+  for (int r = 0; r < rounds; r++) {
+    for (int i = 0; i < size ~/ 100; i++) {
+      final index = victim(r, i, size);
+      final object = Entry(index, r);
+      finalizer.attach(object, index);
+      objects[index] = object;
+    }
+    sum += churn(size ~/ 10);
+  }
+  return sum + objects.length;
+}
+)";
+
+static void PrintGCPauses(Benchmark* benchmark, Heap* heap) {
+  static const struct {
+    GCPauseKind kind;
+    const char* name;
+  } kPauses[] = {
+      {GCPauseKind::kScavenge, "Scavenge"},
+      {GCPauseKind::kMark, "Mark"},
+      {GCPauseKind::kSweep, "Sweep"},
+      {GCPauseKind::kCompact, "Compact"},
+      {GCPauseKind::kSafepoint, "Safepoint"},
+  };
+  for (const auto& pause : kPauses) {
+    LatencyHistogram* histogram = heap->pause_histogram(pause.kind);
+    OS::Print("%s.%sPauses(Count): %" Pd64 "\n", benchmark->name(),
+              pause.name, histogram->count());
+    OS::Print("%s.%sPauseP50(RunTime): %" Pd64 "\n", benchmark->name(),
+              pause.name, histogram->Percentile(50));
+    OS::Print("%s.%sPauseP99(RunTime): %" Pd64 "\n", benchmark->name(),
+              pause.name, histogram->Percentile(99));
+    OS::Print("%s.%sPauseMax(RunTime): %" Pd64 "\n", benchmark->name(),
+              pause.name, histogram->max());
+  }
+}
+
+// Scores a run of [shape] from kGCHeapShapesScript with [size] long-lived
+// objects (before scaling) and prints the pauses of the run.
+static void RunGCHeapShape(Benchmark* benchmark,
+                           Thread* thread,
+                           const char* shape,
+                           intptr_t size) {
+  const intptr_t kRounds = 50;
+  Dart_Handle lib = TestCase::LoadTestScript(kGCHeapShapesScript, nullptr);
+  EXPECT_VALID(lib);
+
+  // Each benchmark runs in a new isolate group, so the pause histograms
+  // contain little besides the pauses of this run.
+  Heap* heap = thread->isolate_group()->heap();
+
+  Dart_Handle args[2];
+  args[0] = Dart_NewInteger(size * FLAG_gc_benchmark_heap_scale);
+  args[1] = Dart_NewInteger(kRounds);
+  Timer timer;
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString(shape), 2, args);
+  EXPECT_VALID(result);
+  timer.Stop();
+  benchmark->set_score(timer.TotalElapsedTime());
+  PrintGCPauses(benchmark, heap);
+}
+
+BENCHMARK(GCHeapShapeCache) {
+  RunGCHeapShape(benchmark, thread, "cache", 1000000);
+}
+
+BENCHMARK(GCHeapShapeCardMarkedArray) {
+  RunGCHeapShape(benchmark, thread, "cardMarkedArray", 4000000);
+}
+
+BENCHMARK(GCHeapShapeWeakMap) {
+  RunGCHeapShape(benchmark, thread, "weakMap", 250000);
+}
+
+BENCHMARK(GCHeapShapeFinalizers) {
+  RunGCHeapShape(benchmark, thread, "finalizers", 250000);
+}
+
 BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
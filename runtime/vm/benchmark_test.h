@@ -39,6 +39,7 @@ extern const uint8_t* core_isolate_snapshot_instructions;
     BenchmarkIsolateScope __isolate__(benchmark);                              \
     Thread* __thread__ = Thread::Current();                                    \
     ASSERT(__thread__->isolate() == benchmark->isolate());                     \
+    BenchmarkPerfCountersScope __counters__(benchmark);                        \
     Dart_BenchmarkHelper##name(benchmark, __thread__);                         \
   }                                                                            \
   static void Dart_BenchmarkHelper##name(Benchmark* benchmark, Thread* thread)
@@ -55,6 +56,17 @@ class Benchmark {
  public:
   typedef void(RunEntry)(Benchmark* benchmark);
 
+  // Hardware counters collected around the body of a benchmark with
+  // --benchmark_perf_counters.
+  enum PerfCounter {
+    kCycles,
+    kInstructions,
+    kCacheMisses,
+    kBranchMisses,
+    kNumPerfCounters,
+  };
+  static const char* PerfCounterName(PerfCounter counter);
+
   Benchmark(RunEntry* run, const char* name, const char* score_kind)
       : run_(run),
         name_(name),
@@ -75,6 +87,16 @@ class Benchmark {
   const char* score_kind() const { return score_kind_; }
   void set_score(int64_t value) { score_ = value; }
   int64_t score() const { return score_; }
+
+  bool has_perf_counters() const { return has_perf_counters_; }
+  int64_t perf_counter(PerfCounter counter) const {
+    ASSERT(has_perf_counters_);
+    return perf_counters_[counter];
+  }
+  void set_perf_counter(PerfCounter counter, int64_t value) {
+    has_perf_counters_ = true;
+    perf_counters_[counter] = value;
+  }
   Isolate* isolate() const { return reinterpret_cast<Isolate*>(isolate_); }
 
   void Run() { (*run_)(this); }
@@ -98,12 +120,29 @@ class Benchmark {
   const char* name_;
   const char* score_kind_;
   int64_t score_;
+  bool has_perf_counters_ = false;
+  int64_t perf_counters_[kNumPerfCounters] = {};
   Dart_Isolate isolate_;
   Benchmark* next_;
 
   DISALLOW_COPY_AND_ASSIGN(Benchmark);
 };
 
+// Counts the hardware events of the current thread while in scope and
+// records them in the benchmark. Only supported on Linux, through
+// perf_event_open, and only if --benchmark_perf_counters is passed.
+class BenchmarkPerfCountersScope {
+ public:
+  explicit BenchmarkPerfCountersScope(Benchmark* benchmark);
+  ~BenchmarkPerfCountersScope();
+
+ private:
+  Benchmark* const benchmark_;
+  int fds_[Benchmark::kNumPerfCounters];
+
+  DISALLOW_COPY_AND_ASSIGN(BenchmarkPerfCountersScope);
+};
+
 class BenchmarkIsolateScope {
  public:
   explicit BenchmarkIsolateScope(Benchmark* benchmark) : benchmark_(benchmark) {
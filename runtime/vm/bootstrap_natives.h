@@ -101,11 +101,13 @@ namespace dart {
   V(Double_truncate, 1)                                                        \
   V(Double_toInt, 1)                                                           \
   V(Double_parse, 3)                                                           \
+  V(Double_parseBytes, 3)                                                      \
   V(Double_toString, 1)                                                        \
   V(Double_toStringAsFixed, 2)                                                 \
   V(Double_toStringAsExponential, 2)                                           \
   V(Double_toStringAsPrecision, 2)                                             \
   V(Double_flipSignBit, 1)                                                     \
+  V(Json_parse, 1)                                                             \
   V(RegExp_factory, 6)                                                         \
   V(RegExp_getPattern, 1)                                                      \
   V(RegExp_getIsMultiLine, 1)                                                  \
@@ -116,6 +118,8 @@ namespace dart {
   V(RegExp_getGroupNameMap, 1)                                                 \
   V(RegExp_ExecuteMatch, 3)                                                    \
   V(RegExp_ExecuteMatchSticky, 3)                                              \
+  V(RegExp_skipUntilCharacter, 4)                                              \
+  V(RegExp_skipUntilBitInTable, 4)                                             \
   V(List_allocate, 2)                                                          \
   V(List_getIndexed, 2)                                                        \
   V(List_setIndexed, 3)                                                        \
@@ -172,6 +176,7 @@ namespace dart {
   V(TypedData_Float64x2Array_new, 2)                                           \
   V(TypedDataBase_length, 1)                                                   \
   V(TypedDataBase_setRange, 7)                                                 \
+  V(TypedDataBase_setConvertedRange, 5)                                        \
   V(TypedData_GetInt8, 2)                                                      \
   V(TypedData_SetInt8, 3)                                                      \
   V(TypedData_GetUint8, 2)                                                     \
@@ -329,6 +334,8 @@ namespace dart {
   V(GrowableList_getCapacity, 1)                                               \
   V(GrowableList_setLength, 2)                                                 \
   V(GrowableList_setData, 2)                                                   \
+  V(GrowableList_tryGrowDataInPlace, 2)                                        \
+  V(GrowableList_truncateData, 2)                                              \
   V(Internal_unsafeCast, 1)                                                    \
   V(Internal_nativeEffect, 1)                                                  \
   V(Internal_collectAllGarbage, 0)                                             \
@@ -390,6 +397,20 @@ namespace dart {
   V(Ffi_fromAddress, 1)                                                        \
   V(Ffi_asFunctionInternal, 2)                                                 \
   V(Ffi_pointerFromFunction, 1)                                                \
+  V(Ffi_createCallbackListener, 1)                                             \
+  V(Ffi_callbackListenerFunction, 1)                                           \
+  V(Ffi_drainCallbackListener, 1)                                              \
+  V(Ffi_closeCallbackListener, 1)                                              \
+  V(Ffi_createIsolateGroupCallback, 1)                                         \
+  V(Ffi_isolateGroupCallbackFunction, 1)                                       \
+  V(Ffi_closeIsolateGroupCallback, 1)                                          \
+  V(Ffi_createNativeArena, 1)                                                  \
+  V(Ffi_nativeArenaAllocate, 3)                                                \
+  V(Ffi_nativeArenaFree, 3)                                                    \
+  V(Ffi_nativeArenaReleaseAll, 2)                                              \
+  V(Ffi_pinTypedData, 1)                                                       \
+  V(Ffi_unpinTypedData, 2)                                                     \
+  V(Ffi_callNativeBatch, 4)                                                    \
   V(Ffi_dl_open, 1)                                                            \
   V(Ffi_dl_lookup, 2)                                                          \
   V(Ffi_dl_getHandle, 1)                                                       \
@@ -412,7 +433,8 @@ namespace dart {
   V(DartApiDLMinorVersion, 0)                                                  \
   V(DartNativeApiFunctionPointer, 1)                                           \
   V(TransferableTypedData_factory, 2)                                          \
-  V(TransferableTypedData_materialize, 1)
+  V(TransferableTypedData_materialize, 1)                                      \
+  V(TransferableTypedData_materializeUnmodifiable, 1)
 
 // List of bootstrap native entry points used in the dart:mirror library.
 #define MIRRORS_BOOTSTRAP_NATIVE_LIST(V)                                       \
@@ -17,12 +17,18 @@ class CharArray {
   CharArray(const CharType* data, intptr_t len) : data_(data), len_(len) {
     hash_ = String::Hash(data, len);
   }
-  StringPtr ToSymbol() const {
+  // Returns an old space string with these characters and its hash set,
+  // which is not yet canonical.
+  StringPtr ToOldString() const {
     String& result = String::Handle(StringFrom(data_, len_, Heap::kOld));
-    result.SetCanonical();
     result.SetHash(hash_);
     return result.ptr();
   }
+  StringPtr ToSymbol() const {
+    String& result = String::Handle(ToOldString());
+    result.SetCanonical();
+    return result.ptr();
+  }
   bool Equals(const String& other) const {
     ASSERT(other.HasHash());
     if (other.Hash() != hash_) {
@@ -47,6 +53,9 @@ class StringSlice {
       : str_(str), begin_index_(begin_index), len_(length) {
     hash_ = is_all() ? str.Hash() : String::Hash(str, begin_index, length);
   }
+  // Returns an old space string with the characters of the slice and its
+  // hash set, which may be the sliced string itself.
+  StringPtr ToOldString() const;
   StringPtr ToSymbol() const;
   bool Equals(const String& other) const {
     ASSERT(other.HasHash());
@@ -69,6 +78,7 @@ class ConcatString {
  public:
   ConcatString(const String& str1, const String& str2)
       : str1_(str1), str2_(str2), hash_(String::HashConcat(str1, str2)) {}
+  StringPtr ToOldString() const;
   StringPtr ToSymbol() const;
   bool Equals(const String& other) const {
     ASSERT(other.HasHash());
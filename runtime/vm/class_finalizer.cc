@@ -28,6 +28,11 @@ namespace dart {
 DEFINE_FLAG(bool, print_classes, false, "Prints details about loaded classes.");
 DEFINE_FLAG(bool, trace_class_finalization, false, "Trace class finalization.");
 DEFINE_FLAG(bool, trace_type_finalization, false, "Trace type finalization.");
+DEFINE_FLAG(bool,
+            cluster_interface_implementors,
+            false,
+            "When sorting classes, number sibling classes that implement the "
+            "same interface next to each other.");
 
 bool ClassFinalizer::AllClassesFinalized() {
   ObjectStore* object_store = IsolateGroup::Current()->object_store();
@@ -1408,6 +1413,44 @@ void ClassFinalizer::VerifyImplicitFieldOffsets() {
 #endif
 }
 
+struct SiblingClass {
+  intptr_t interface_cid;
+  intptr_t cid;
+};
+
+// Orders siblings by the first interface they implement and then by cid,
+// both descending as the classes are numbered in the order they are popped
+// from the DFS stack.
+static int CompareSiblingClasses(const SiblingClass* a, const SiblingClass* b) {
+  if (a->interface_cid != b->interface_cid) {
+    return a->interface_cid < b->interface_cid ? 1 : -1;
+  }
+  return a->cid < b->cid ? 1 : (a->cid > b->cid ? -1 : 0);
+}
+
+// Pushes [siblings] on [dfs_stack]. With --cluster-interface-implementors,
+// implementors of the same interface become adjacent subtrees, so that type
+// tests against the interface need fewer cid ranges.
+static void PushSiblingClasses(GrowableArray<SiblingClass>* siblings,
+                               GrowableArray<intptr_t>* dfs_stack) {
+  if (FLAG_cluster_interface_implementors) {
+    siblings->Sort(CompareSiblingClasses);
+  }
+  for (const SiblingClass& sibling : *siblings) {
+    dfs_stack->Add(sibling.cid);
+  }
+  siblings->Clear();
+}
+
+static intptr_t FirstInterfaceCid(Zone* zone, const Class& cls) {
+  if (!FLAG_cluster_interface_implementors) return kIllegalCid;
+  const auto& interfaces = Array::Handle(zone, cls.interfaces());
+  if (interfaces.IsNull() || interfaces.Length() == 0) return kIllegalCid;
+  const auto& type =
+      AbstractType::Handle(zone, AbstractType::RawCast(interfaces.At(0)));
+  return type.IsNull() ? kIllegalCid : type.type_class_id();
+}
+
 void ClassFinalizer::SortClasses() {
   auto T = Thread::Current();
   StackZone stack_zone(T);
@@ -1433,6 +1476,7 @@ void ClassFinalizer::SortClasses() {
 
   intptr_t next_new_cid = kNumPredefinedCids;
   GrowableArray<intptr_t> dfs_stack;
+  GrowableArray<SiblingClass> siblings;
   Class& cls = Class::Handle(Z);
   GrowableObjectArray& subclasses = GrowableObjectArray::Handle(Z);
 
@@ -1446,9 +1490,10 @@ void ClassFinalizer::SortClasses() {
       continue;
     }
     if (cls.SuperClass() == IG->object_store()->object_class()) {
-      dfs_stack.Add(cid);
+      siblings.Add({FirstInterfaceCid(Z, cls), cid});
     }
   }
+  PushSiblingClasses(&siblings, &dfs_stack);
 
   while (dfs_stack.length() > 0) {
     intptr_t cid = dfs_stack.RemoveLast();
@@ -1467,8 +1512,9 @@ void ClassFinalizer::SortClasses() {
       for (intptr_t i = 0; i < subclasses.Length(); i++) {
         cls ^= subclasses.At(i);
         ASSERT(!cls.IsNull());
-        dfs_stack.Add(cls.id());
+        siblings.Add({FirstInterfaceCid(Z, cls), cls.id()});
       }
+      PushSiblingClasses(&siblings, &dfs_stack);
     }
   }
 
@@ -42,6 +42,30 @@ FunctionPtr ClosureFunctionsCache::LookupClosureFunctionLocked(
   return Function::null();
 }
 
+FunctionPtr ClosureFunctionsCache::LookupClosureFunctionByKernelOffset(
+    const Function& outermost_function,
+    intptr_t kernel_offset) {
+  auto thread = Thread::Current();
+  auto zone = thread->zone();
+  auto object_store = thread->isolate_group()->object_store();
+
+  SafepointReadRwLocker ml(thread, thread->isolate_group()->program_lock());
+
+  const auto& closures =
+      GrowableObjectArray::Handle(zone, object_store->closure_functions());
+  auto& closure = Function::Handle(zone);
+  intptr_t num_closures = closures.Length();
+  for (intptr_t i = 0; i < num_closures; i++) {
+    closure ^= closures.At(i);
+    if (closure.kernel_offset() == kernel_offset &&
+        closure.IsNonImplicitClosureFunction() &&
+        closure.GetOutermostFunction() == outermost_function.ptr()) {
+      return closure.ptr();
+    }
+  }
+  return Function::null();
+}
+
 void ClosureFunctionsCache::AddClosureFunctionLocked(
     const Function& function,
     bool allow_implicit_closure_functions /* = false */) {
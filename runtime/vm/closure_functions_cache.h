@@ -44,6 +44,13 @@ class ClosureFunctionsCache : public AllStatic {
   static FunctionPtr LookupClosureFunctionLocked(const Function& parent,
                                                  TokenPosition token_pos);
 
+  // Returns the closure function created for the function node at
+  // [kernel_offset] within [outermost_function], or null if it was not
+  // created yet.
+  static FunctionPtr LookupClosureFunctionByKernelOffset(
+      const Function& outermost_function,
+      intptr_t kernel_offset);
+
   // Normally implicit closure functions are not added to this cache, however
   // during AOT compilation we might add those implicit closure functions
   // that have their original functions shaken to allow ProgramWalker to
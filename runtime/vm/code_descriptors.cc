@@ -97,6 +97,26 @@ PcDescriptorsPtr DescriptorList::FinalizePcDescriptors(uword entry_point) {
                             encoded_data_.bytes_written());
 }
 
+void CompressedStackMapsIndexBuilder::AddEntry(const BaseWriteStream& stream,
+                                               intptr_t previous_pc_offset) {
+  if ((entry_count_ > 0) &&
+      (entry_count_ % CompressedStackMaps::kIndexInterval) == 0) {
+    index_.Add(static_cast<uint32_t>(previous_pc_offset));
+    index_.Add(static_cast<uint32_t>(stream.bytes_written()));
+  }
+  entry_count_++;
+}
+
+bool CompressedStackMapsIndexBuilder::WriteTo(BaseWriteStream* stream) const {
+  if (entry_count_ < kMinEntriesForIndex) return false;
+  ASSERT(!index_.is_empty());
+  for (intptr_t i = 0; i < index_.length(); i++) {
+    stream->WriteFixed<uint32_t>(index_[i]);
+  }
+  stream->WriteFixed<uint32_t>(index_.length() / 2);
+  return true;
+}
+
 void CompressedStackMapsBuilder::AddEntry(intptr_t pc_offset,
                                           BitmapBuilder* bitmap,
                                           intptr_t spill_slot_bit_count) {
@@ -106,6 +126,7 @@ void CompressedStackMapsBuilder::AddEntry(intptr_t pc_offset,
   const uword pc_delta = pc_offset - last_pc_offset_;
   const uword non_spill_slot_bit_count =
       bitmap->Length() - spill_slot_bit_count;
+  index_builder_.AddEntry(encoded_bytes_, last_pc_offset_);
   encoded_bytes_.WriteLEB128(pc_delta);
   encoded_bytes_.WriteLEB128(spill_slot_bit_count);
   encoded_bytes_.WriteLEB128(non_spill_slot_bit_count);
@@ -113,12 +134,13 @@ void CompressedStackMapsBuilder::AddEntry(intptr_t pc_offset,
   last_pc_offset_ = pc_offset;
 }
 
-CompressedStackMapsPtr CompressedStackMapsBuilder::Finalize() const {
+CompressedStackMapsPtr CompressedStackMapsBuilder::Finalize() {
   if (encoded_bytes_.bytes_written() == 0) {
     return Object::empty_compressed_stackmaps().ptr();
   }
-  return CompressedStackMaps::NewInlined(encoded_bytes_.buffer(),
-                                         encoded_bytes_.bytes_written());
+  const bool has_index = index_builder_.WriteTo(&encoded_bytes_);
+  return CompressedStackMaps::NewInlined(
+      encoded_bytes_.buffer(), encoded_bytes_.bytes_written(), has_index);
 }
 
 ExceptionHandlersPtr ExceptionHandlerList::FinalizeExceptionHandlers(
@@ -47,6 +47,32 @@ class DescriptorList : public ZoneAllocated {
   DISALLOW_COPY_AND_ASSIGN(DescriptorList);
 };
 
+// Collects the sparse index of a CompressedStackMaps payload while its
+// entries are written. See UntaggedCompressedStackMaps for the encoding.
+class CompressedStackMapsIndexBuilder : public ValueObject {
+ public:
+  CompressedStackMapsIndexBuilder() : index_() {}
+
+  // Must be called before writing each entry to [stream], with the PC offset
+  // of the previously written entry (0 for the first entry).
+  void AddEntry(const BaseWriteStream& stream, intptr_t previous_pc_offset);
+
+  // Appends the index to [stream] if the payload has enough entries to
+  // benefit from one. Returns whether it did.
+  bool WriteTo(BaseWriteStream* stream) const;
+
+ private:
+  // Smaller payloads are decoded linearly, as the index would only make
+  // them bigger.
+  static constexpr intptr_t kMinEntriesForIndex = 64;
+
+  intptr_t entry_count_ = 0;
+  // Pairs of the previous PC offset and the payload offset of every
+  // indexed entry.
+  GrowableArray<uint32_t> index_;
+  DISALLOW_COPY_AND_ASSIGN(CompressedStackMapsIndexBuilder);
+};
+
 class CompressedStackMapsBuilder : public ZoneAllocated {
  public:
   explicit CompressedStackMapsBuilder(Zone* zone)
@@ -56,12 +82,13 @@ class CompressedStackMapsBuilder : public ZoneAllocated {
                 BitmapBuilder* bitmap,
                 intptr_t spill_slot_bit_count);
 
-  CompressedStackMapsPtr Finalize() const;
+  CompressedStackMapsPtr Finalize();
 
  private:
   static constexpr intptr_t kInitialStreamSize = 16;
 
   ZoneWriteStream encoded_bytes_;
+  CompressedStackMapsIndexBuilder index_builder_;
   intptr_t last_pc_offset_ = 0;
   DISALLOW_COPY_AND_ASSIGN(CompressedStackMapsBuilder);
 };
@@ -169,4 +169,52 @@ ISOLATE_UNIT_TEST_CASE(DescriptorList_TokenPositions) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(CompressedStackMaps_IndexedFind) {
+  for (const intptr_t count : {10, 64, 1000}) {
+    CompressedStackMapsBuilder builder(thread->zone());
+    for (intptr_t i = 0; i < count; i++) {
+      // Entries with different lengths and bits, so each pc offset can be
+      // recognized from its entry.
+      auto bitmap = new BitmapBuilder();
+      bitmap->Set(i % 37, true);
+      builder.AddEntry(4 * (i + 1), bitmap, i % 2);
+    }
+    const auto& maps = CompressedStackMaps::Handle(builder.Finalize());
+    EXPECT_EQ(count >= 64, maps.HasIndex());
+
+    auto check_entry = [&](CompressedStackMaps::Iterator<CompressedStackMaps>*
+                               it,
+                           intptr_t i) {
+      EXPECT_EQ(4 * (i + 1), static_cast<intptr_t>(it->pc_offset()));
+      EXPECT_EQ(i % 37 + 1, it->Length());
+      EXPECT_EQ(i % 2, it->SpillSlotBitCount());
+      EXPECT(it->IsObject(i % 37));
+    };
+
+    // Lookups with fresh iterators, as done by the GC.
+    for (intptr_t i = 0; i < count; i++) {
+      auto it = maps.iterator(thread);
+      EXPECT(it.Find(4 * (i + 1)));
+      check_entry(&it, i);
+      EXPECT(!maps.iterator(thread).Find(4 * (i + 1) - 2));
+    }
+    EXPECT(!maps.iterator(thread).Find(4 * (count + 1)));
+
+    // Increasing lookups with the same iterator, and iteration over all
+    // entries, which must not see the index.
+    auto it = maps.iterator(thread);
+    for (intptr_t i = 0; i < count; i += 7) {
+      EXPECT(it.Find(4 * (i + 1)));
+      check_entry(&it, i);
+    }
+    intptr_t entries = 0;
+    auto all = maps.iterator(thread);
+    while (all.MoveNext()) {
+      check_entry(&all, entries);
+      entries++;
+    }
+    EXPECT_EQ(count, entries);
+  }
+}
+
 }  // namespace dart
@@ -0,0 +1,53 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compilation_log.h"
+
+#include "platform/utils.h"
+#include "vm/json_stream.h"
+#include "vm/lockers.h"
+
+namespace dart {
+
+void CompilationLog::Entry::SetFunction(const char* name) {
+  Utils::SNPrint(function, kMaxNameLength, "%s", name);
+}
+
+void CompilationLog::Add(const Entry& entry) {
+  MutexLocker ml(&mutex_);
+  entries_.Add(entry);
+}
+
+intptr_t CompilationLog::length() const {
+  MutexLocker ml(&mutex_);
+  return entries_.Size();
+}
+
+void CompilationLog::PrintJSON(JSONStream* js) const {
+#ifndef PRODUCT
+  MutexLocker ml(&mutex_);
+  JSONObject obj(js);
+  obj.AddProperty("type", "_CompilationLog");
+  JSONArray compilations(&obj, "compilations");
+  // Oldest first.
+  for (intptr_t i = entries_.Size() - 1; i >= 0; i--) {
+    const Entry& entry = entries_.Get(i);
+    JSONObject compilation(&compilations);
+    compilation.AddProperty("function", entry.function);
+    compilation.AddProperty("optimized", entry.optimized);
+    compilation.AddProperty64("timestamp", entry.timestamp_micros);
+    compilation.AddProperty64("durationMicros", entry.duration_micros);
+    compilation.AddProperty64("instructions", entry.instruction_count);
+    compilation.AddProperty64("inlinedFunctions", entry.inlined_count);
+    compilation.AddProperty64("deoptimizations", entry.deoptimization_count);
+    if (entry.slowest_pass != nullptr) {
+      compilation.AddProperty("slowestPass", entry.slowest_pass);
+      compilation.AddProperty64("slowestPassMicros",
+                                entry.slowest_pass_micros);
+    }
+  }
+#endif  // !PRODUCT
+}
+
+}  // namespace dart
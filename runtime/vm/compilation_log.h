@@ -0,0 +1,58 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILATION_LOG_H_
+#define RUNTIME_VM_COMPILATION_LOG_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/os_thread.h"
+#include "vm/ring_buffer.h"
+
+namespace dart {
+
+class JSONStream;
+
+// Records a summary of the most recent JIT compilations of an isolate group:
+// how long each one took, which pass was the most expensive, how big the
+// final graph was and how much was inlined. Unlike CompilerTimings this is
+// cheap enough to be always on and is reported by _getCompilationLog.
+class CompilationLog {
+ public:
+  static constexpr intptr_t kCapacity = 256;
+  static constexpr intptr_t kMaxNameLength = 128;
+
+  struct Entry {
+    char function[kMaxNameLength];
+    const char* slowest_pass;
+    int64_t timestamp_micros;
+    int64_t duration_micros;
+    int64_t slowest_pass_micros;
+    intptr_t instruction_count;
+    intptr_t inlined_count;
+    intptr_t deoptimization_count;
+    bool optimized;
+
+    // Copies [name], truncating it to kMaxNameLength - 1 characters.
+    void SetFunction(const char* name);
+  };
+
+  CompilationLog() {}
+
+  void Add(const Entry& entry);
+
+  intptr_t length() const;
+
+  void PrintJSON(JSONStream* js) const;
+
+ private:
+  mutable Mutex mutex_;
+  RingBuffer<Entry, kCapacity> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilationLog);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILATION_LOG_H_
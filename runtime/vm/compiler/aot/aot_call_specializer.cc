@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "vm/bit_vector.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
@@ -38,6 +39,12 @@ DEFINE_FLAG(int,
             5,
             "If a call receiver is known to be of at most this many classes, "
             "generate exhaustive class tests instead of a megamorphic call");
+DEFINE_FLAG(int,
+            max_exhaustive_polymorphic_ranges,
+            16,
+            "If a call receiver is known to be of more classes than "
+            "--max-exhaustive-polymorphic-checks, still generate exhaustive "
+            "tests if their targets form at most this many class id ranges");
 
 // Quick access to the current isolate and zone.
 #define IG (isolate_group())
@@ -830,12 +837,30 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
       // static call.
       // Otherwise we will try to create ICData that contains all possible
       // targets with appropriate checks.
+      //
+      // Classes are visited in class id order to count the class id ranges
+      // the checks will be merged into (see CallTargets::MergeIntoRanges).
+      class_ids.Sort([](const intptr_t* a, const intptr_t* b) {
+        return static_cast<int>(*a - *b);
+      });
+      intptr_t ranges = 0;
+      Function& previous_target = Function::Handle(Z);
       Function& single_target = Function::Handle(Z);
       ICData& ic_data = ICData::Handle(Z);
       const Array& args_desc_array =
           Array::Handle(Z, instr->GetArgumentsDescriptor());
       Function& target = Function::Handle(Z);
       Class& cls = Class::Handle(Z);
+      // With a training profile, checks of a polymorphic call are ordered by
+      // how often each receiver class was seen at this call site.
+      const AotProfile* profile =
+          precompiler_ != nullptr ? precompiler_->profile() : nullptr;
+      auto receiver_count = [&](intptr_t cid) -> intptr_t {
+        if (profile == nullptr) return 1;
+        const intptr_t count = profile->ReceiverCount(
+            function, instr->token_pos(), instr->function_name(), cid);
+        return count < 0 ? 1 : count;
+      };
       for (intptr_t i = 0; i < class_ids.length(); i++) {
         const intptr_t cid = class_ids[i];
         cls = isolate_group()->class_table()->At(cid);
@@ -845,7 +870,14 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
           single_target = Function::null();
           ic_data = ICData::null();
           break;
-        } else if (ic_data.IsNull()) {
+        }
+        if ((i == 0) || (class_ids[i - 1] + 1 != cid) ||
+            (target.ptr() != previous_target.ptr()) ||
+            target.is_polymorphic_target()) {
+          ranges++;
+        }
+        previous_target = target.ptr();
+        if (ic_data.IsNull()) {
           // First we are trying to compute a single target for all subclasses.
           if (single_target.IsNull()) {
             ASSERT(i == 0);
@@ -856,8 +888,10 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
           }
 
           // The call does not resolve to a single target within the hierarchy.
-          // If we have too many subclasses abort the optimization.
-          if (class_ids.length() > FLAG_max_exhaustive_polymorphic_checks) {
+          // If we have too many subclasses and they do not form a few class
+          // id ranges abort the optimization.
+          if ((class_ids.length() > FLAG_max_exhaustive_polymorphic_checks) &&
+              (ranges > FLAG_max_exhaustive_polymorphic_ranges)) {
             single_target = Function::null();
             break;
           }
@@ -868,7 +902,8 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
                                 args_desc_array, DeoptId::kNone,
                                 /* args_tested = */ 1, ICData::kOptimized);
           for (intptr_t j = 0; j < i; j++) {
-            ic_data.AddReceiverCheck(class_ids[j], single_target);
+            ic_data.AddReceiverCheck(class_ids[j], single_target,
+                                     receiver_count(class_ids[j]));
           }
 
           single_target = Function::null();
@@ -876,7 +911,12 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
 
         ASSERT(ic_data.ptr() != ICData::null());
         ASSERT(single_target.ptr() == Function::null());
-        ic_data.AddReceiverCheck(cid, target);
+        if ((class_ids.length() > FLAG_max_exhaustive_polymorphic_checks) &&
+            (ranges > FLAG_max_exhaustive_polymorphic_ranges)) {
+          ic_data = ICData::null();
+          break;
+        }
+        ic_data.AddReceiverCheck(cid, target, receiver_count(cid));
       }
 
       if (single_target.ptr() != Function::null()) {
@@ -0,0 +1,307 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/aot_profile.h"
+
+#include "platform/text_buffer.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/program_visitor.h"
+
+namespace dart {
+
+DEFINE_FLAG(charp,
+            write_aot_profile_to,
+            nullptr,
+            "Write a profile of the executed code to the given file when the "
+            "last isolate exits, for use with --aot_profile.");
+
+#if defined(DART_PRECOMPILER)
+DEFINE_FLAG(charp,
+            aot_profile,
+            nullptr,
+            "Guide AOT compilation with a profile written by "
+            "--write_aot_profile_to.");
+#endif  // defined(DART_PRECOMPILER)
+
+static constexpr const char* kAotProfileVersion = "# dart aot profile v1";
+
+static const char* LibraryUrlOf(Zone* zone, const Class& cls) {
+  const Library& library = Library::Handle(zone, cls.library());
+  if (library.IsNull()) return "-";
+  return String::Handle(zone, library.url()).ToCString();
+}
+
+class AotProfileWriter : public FunctionVisitor {
+ public:
+  AotProfileWriter(Zone* zone, IsolateGroup* isolate_group)
+      : zone_(zone),
+        class_table_(isolate_group->class_table()),
+        buffer_(64 * KB),
+        token_positions_(zone),
+        owner_(Class::Handle(zone)),
+        receiver_class_(Class::Handle(zone)),
+        code_(Code::Handle(zone)),
+        descriptors_(PcDescriptors::Handle(zone)),
+        ic_data_array_(Array::Handle(zone)),
+        ic_data_(ICData::Handle(zone)),
+        selector_(String::Handle(zone)) {
+    buffer_.Printf("%s\n", kAotProfileVersion);
+  }
+
+  void VisitFunction(const Function& function) {
+    if (function.usage_counter() <= 0) return;
+    owner_ = function.Owner();
+    buffer_.Printf("F %" Pd " %" Pd32 " %s %s\n", function.usage_counter(),
+                   function.token_pos().Serialize(),
+                   LibraryUrlOf(zone_, owner_),
+                   function.QualifiedScrubbedNameCString());
+    WriteCallSites(function);
+  }
+
+  TextBuffer* buffer() { return &buffer_; }
+
+ private:
+  void WriteCallSites(const Function& function) {
+    ic_data_array_ = function.ic_data_array();
+    code_ = function.unoptimized_code();
+    if (ic_data_array_.IsNull() || code_.IsNull()) return;
+
+    // ICData only knows the deopt id of its call, so map deopt ids to the
+    // token positions recorded for the calls of the unoptimized code.
+    token_positions_.Clear();
+    descriptors_ = code_.pc_descriptors();
+    PcDescriptors::Iterator iter(descriptors_,
+                                 UntaggedPcDescriptors::kIcCall |
+                                     UntaggedPcDescriptors::kUnoptStaticCall);
+    while (iter.MoveNext()) {
+      token_positions_.Insert(iter.DeoptId(), iter.TokenPos().Serialize());
+    }
+
+    for (intptr_t i = Function::ICDataArrayIndices::kFirstICData;
+         i < ic_data_array_.Length(); i++) {
+      ic_data_ ^= ic_data_array_.At(i);
+      const intptr_t count = ic_data_.AggregateCount();
+      if (count <= 0) continue;
+      auto const pair = token_positions_.LookupPair(ic_data_.deopt_id());
+      if (pair == nullptr) continue;
+      selector_ = ic_data_.target_name();
+      buffer_.Printf("C %" Pd32 " %" Pd " %s\n", pair->value, count,
+                     selector_.ToCString());
+      if (ic_data_.rebind_rule() != ICData::kInstance) continue;
+      for (intptr_t j = 0, n = ic_data_.NumberOfChecks(); j < n; j++) {
+        const intptr_t receiver_count = ic_data_.GetCountAt(j);
+        if (receiver_count <= 0) continue;
+        receiver_class_ = class_table_->At(ic_data_.GetReceiverClassIdAt(j));
+        buffer_.Printf("R %" Pd " %s %s\n", receiver_count,
+                       LibraryUrlOf(zone_, receiver_class_),
+                       receiver_class_.ScrubbedNameCString());
+      }
+    }
+  }
+
+  Zone* const zone_;
+  ClassTable* const class_table_;
+  TextBuffer buffer_;
+  IntMap<int32_t> token_positions_;
+  Class& owner_;
+  Class& receiver_class_;
+  Code& code_;
+  PcDescriptors& descriptors_;
+  Array& ic_data_array_;
+  ICData& ic_data_;
+  String& selector_;
+};
+
+void AotProfile::Write(Thread* thread, const char* filename) {
+  if ((Dart::file_write_callback() == nullptr) ||
+      (Dart::file_open_callback() == nullptr) ||
+      (Dart::file_close_callback() == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return;
+  }
+  void* file = Dart::file_open_callback()(filename, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write AOT profile: %s\n", filename);
+    return;
+  }
+
+  AotProfileWriter writer(thread->zone(), thread->isolate_group());
+  ProgramVisitor::WalkProgram(thread->zone(), thread->isolate_group(),
+                              &writer);
+
+  TextBuffer* buffer = writer.buffer();
+  const intptr_t output_length = buffer->length();
+  char* output = buffer->Steal();
+  Dart::file_write_callback()(output, output_length, file);
+  free(output);
+  Dart::file_close_callback()(file);
+}
+
+#if defined(DART_PRECOMPILER)
+
+static const char* FunctionKey(Zone* zone,
+                               const char* library_url,
+                               const char* name,
+                               int32_t token_pos) {
+  return OS::SCreate(zone, "%s %s %" Pd32, library_url, name, token_pos);
+}
+
+AotProfile::AotProfile(Zone* zone)
+    : zone_(zone),
+      function_indices_(zone),
+      functions_(zone, 0),
+      selector_counts_(zone) {}
+
+AotProfile* AotProfile::ReadIfRequested(Zone* zone) {
+  const char* filename = FLAG_aot_profile;
+  if (filename == nullptr) {
+    return nullptr;
+  }
+  if ((Dart::file_read_callback() == nullptr) ||
+      (Dart::file_open_callback() == nullptr) ||
+      (Dart::file_close_callback() == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return nullptr;
+  }
+  void* file = Dart::file_open_callback()(filename, /*write=*/false);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", filename);
+    return nullptr;
+  }
+  uint8_t* data = nullptr;
+  intptr_t length = -1;
+  Dart::file_read_callback()(&data, &length, file);
+  Dart::file_close_callback()(file);
+  if (data == nullptr || length < 0) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", filename);
+    free(data);
+    return nullptr;
+  }
+
+  char* contents = zone->Alloc<char>(length + 1);
+  memmove(contents, data, length);
+  contents[length] = '\0';
+  free(data);
+
+  AotProfile* profile = new (zone) AotProfile(zone);
+  if (!profile->Parse(Thread::Current(), contents)) {
+    OS::PrintErr("warning: Ignoring malformed AOT profile: %s\n", filename);
+    return nullptr;
+  }
+  return profile;
+}
+
+bool AotProfile::Parse(Thread* thread, char* contents) {
+  char* save_ptr = nullptr;
+  char* line = strtok_r(contents, "\n", &save_ptr);
+  if (line == nullptr || strcmp(line, kAotProfileVersion) != 0) {
+    return false;
+  }
+
+  String& url = String::Handle(zone_);
+  String& name = String::Handle(zone_);
+  Library& library = Library::Handle(zone_);
+  Class& cls = Class::Handle(zone_);
+  FunctionProfile* function = nullptr;
+  CallSiteProfile* call = nullptr;
+  while ((line = strtok_r(nullptr, "\n", &save_ptr)) != nullptr) {
+    intptr_t count = 0;
+    int32_t token_pos = 0;
+    int rest = 0;
+    if (sscanf(line, "F %" Pd " %" Pd32 " %n", &count, &token_pos, &rest) ==
+            2 &&
+        rest > 0) {
+      // <library url> <function name>
+      char* function_name = strchr(line + rest, ' ');
+      if (function_name == nullptr) return false;
+      *function_name++ = '\0';
+      function = new (zone_) FunctionProfile(zone_, count);
+      call = nullptr;
+      function_indices_.Insert(
+          {FunctionKey(zone_, line + rest, function_name, token_pos),
+           functions_.length()});
+      functions_.Add(function);
+    } else if (sscanf(line, "C %" Pd32 " %" Pd " %n", &token_pos, &count,
+                      &rest) == 2 &&
+               rest > 0) {
+      if (function == nullptr) return false;
+      call = new (zone_) CallSiteProfile(zone_, token_pos, count, line + rest);
+      function->calls.Add(call);
+      if (auto kv = selector_counts_.Lookup(call->selector)) {
+        kv->value += count;
+      } else {
+        selector_counts_.Insert({call->selector, count});
+      }
+    } else if (sscanf(line, "R %" Pd " %n", &count, &rest) == 1 && rest > 0) {
+      // <library url> <class name>
+      char* class_name = strchr(line + rest, ' ');
+      if (call == nullptr || class_name == nullptr) return false;
+      *class_name++ = '\0';
+      url = String::New(line + rest);
+      library = Library::LookupLibrary(thread, url);
+      if (library.IsNull()) continue;
+      name = String::New(class_name);
+      cls = library.LookupClassAllowPrivate(name);
+      if (cls.IsNull()) continue;
+      call->receivers.Add({cls.id(), count});
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+const AotProfile::FunctionProfile* AotProfile::Lookup(
+    const Function& function) const {
+  const Class& owner = Class::Handle(zone_, function.Owner());
+  const char* key = FunctionKey(zone_, LibraryUrlOf(zone_, owner),
+                                function.QualifiedScrubbedNameCString(),
+                                function.token_pos().Serialize());
+  const intptr_t index = function_indices_.LookupValue(key);
+  if (index == CStringIntMapKeyValueTrait::kNoValue) return nullptr;
+  return functions_[index];
+}
+
+intptr_t AotProfile::CallCount(const Function& function,
+                               TokenPosition token_pos) const {
+  const FunctionProfile* profile = Lookup(function);
+  if (profile == nullptr) return -1;
+  const int32_t pos = token_pos.Serialize();
+  intptr_t count = 0;
+  for (const CallSiteProfile* call : profile->calls) {
+    if (call->token_pos == pos) {
+      count = Utils::Maximum(count, call->count);
+    }
+  }
+  return count;
+}
+
+intptr_t AotProfile::ReceiverCount(const Function& function,
+                                   TokenPosition token_pos,
+                                   const String& selector,
+                                   intptr_t cid) const {
+  const FunctionProfile* profile = Lookup(function);
+  if (profile == nullptr) return -1;
+  const int32_t pos = token_pos.Serialize();
+  for (const CallSiteProfile* call : profile->calls) {
+    if (call->token_pos != pos || !selector.Equals(call->selector)) continue;
+    for (const ReceiverProfile& receiver : call->receivers) {
+      if (receiver.cid == cid) return receiver.count;
+    }
+    return 0;
+  }
+  return -1;
+}
+
+intptr_t AotProfile::SelectorCount(const String& selector) const {
+  const intptr_t count = selector_counts_.LookupValue(selector.ToCString());
+  return count == CStringIntMapKeyValueTrait::kNoValue ? 0 : count;
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
@@ -0,0 +1,115 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+#define RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+#include "vm/token_position.h"
+
+namespace dart {
+
+class Function;
+class String;
+class Thread;
+
+// Execution profile recorded by a JIT training run (--write_aot_profile_to)
+// and used by the precompiler (--aot_profile) in place of static estimates
+// of which calls are hot and which receivers they see.
+//
+// The profile is a text file which starts with a version line followed by
+// one record per line:
+//
+//   F <usage count> <token pos> <library url> <qualified function name>
+//   C <token pos> <call count> <selector>
+//   R <count> <library url> <class name>
+//
+// C records describe call sites of the preceding F record and R records
+// the receiver classes seen at the preceding C record. Functions and classes
+// are identified by name, and call sites by token position, so that the
+// profile stays valid when the same program is compiled again in AOT mode.
+class AotProfile : public ZoneAllocated {
+ public:
+  // Writes the profile of all functions executed by the current isolate
+  // group into [filename].
+  static void Write(Thread* thread, const char* filename);
+
+#if defined(DART_PRECOMPILER)
+  // Reads the profile passed with --aot_profile. Class names are resolved to
+  // class ids, so this must be called after class ids are final.
+  static AotProfile* ReadIfRequested(Zone* zone);
+
+  // Returns whether [function] was executed during training.
+  bool WasExecuted(const Function& function) const {
+    return Lookup(function) != nullptr;
+  }
+
+  // Returns the number of times the calls at [token_pos] in [function] were
+  // executed during training, 0 if they never were, or -1 if [function]
+  // itself is not in the profile.
+  intptr_t CallCount(const Function& function, TokenPosition token_pos) const;
+
+  // Returns the number of times a receiver of class [cid] was seen by the
+  // [selector] call at [token_pos] in [function], or -1 if that call site is
+  // not in the profile.
+  intptr_t ReceiverCount(const Function& function,
+                         TokenPosition token_pos,
+                         const String& selector,
+                         intptr_t cid) const;
+
+  // Returns the number of times calls with [selector] were executed during
+  // training, summed over all call sites.
+  intptr_t SelectorCount(const String& selector) const;
+
+ private:
+  struct ReceiverProfile {
+    intptr_t cid;
+    intptr_t count;
+  };
+
+  struct CallSiteProfile : public ZoneAllocated {
+    CallSiteProfile(Zone* zone,
+                    int32_t token_pos,
+                    intptr_t count,
+                    const char* selector)
+        : token_pos(token_pos),
+          count(count),
+          selector(selector),
+          receivers(zone, 0) {}
+
+    const int32_t token_pos;
+    const intptr_t count;
+    const char* const selector;
+    GrowableArray<ReceiverProfile> receivers;
+  };
+
+  struct FunctionProfile : public ZoneAllocated {
+    FunctionProfile(Zone* zone, intptr_t usage_count)
+        : usage_count(usage_count), calls(zone, 0) {}
+
+    const intptr_t usage_count;
+    GrowableArray<CallSiteProfile*> calls;
+  };
+
+  explicit AotProfile(Zone* zone);
+
+  bool Parse(Thread* thread, char* contents);
+  const FunctionProfile* Lookup(const Function& function) const;
+
+  Zone* const zone_;
+  CStringIntMap function_indices_;
+  GrowableArray<FunctionProfile*> functions_;
+  CStringIntMap selector_counts_;
+#endif  // defined(DART_PRECOMPILER)
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
@@ -8,6 +8,7 @@
 
 #include <memory>
 
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/frontend/kernel_translation_helper.h"
 #include "vm/dispatch_table.h"
 #include "vm/stub_code.h"
@@ -118,6 +119,14 @@ class SelectorRow {
 
   int32_t CallCount() const { return selector_->call_count; }
 
+  // How often the selector is called: its number of executed calls in the
+  // training profile, if there is one, and its number of call sites
+  // otherwise.
+  int64_t Popularity() const {
+    return selector_->profile_count >= 0 ? selector_->profile_count
+                                         : selector_->call_count;
+  }
+
   bool IsAllocated() const {
     return selector_->offset != SelectorMap::kInvalidSelectorOffset;
   }
@@ -409,8 +418,10 @@ DispatchTableGenerator::DispatchTableGenerator(Zone* zone)
       num_classes_(-1),
       selector_map_(zone) {}
 
-void DispatchTableGenerator::Initialize(ClassTable* table) {
+void DispatchTableGenerator::Initialize(ClassTable* table,
+                                        const AotProfile* profile) {
   classes_ = table;
+  profile_ = profile;
 
   HANDLESCOPE(Thread::Current());
   ReadTableSelectorInfo();
@@ -445,6 +456,7 @@ void DispatchTableGenerator::NumberSelectors() {
   Class& klass = Class::Handle(Z);
   Array& functions = Array::Handle(Z);
   Function& function = Function::Handle(Z);
+  String& name = String::Handle(Z);
 
   for (classid_t cid = kIllegalCid + 1; cid < num_classes_; cid++) {
     obj = classes_->At(cid);
@@ -466,6 +478,14 @@ void DispatchTableGenerator::NumberSelectors() {
             }
             selector_map_.SetSelectorProperties(sid, on_null_interface,
                                                 requires_args_descriptor);
+            TableSelector* selector = &selector_map_.selectors_[sid];
+            if (profile_ != nullptr && selector->profile_count < 0) {
+              // All implementations of a selector share its name.
+              name = function.name();
+              selector->profile_count = static_cast<int32_t>(
+                  Utils::Minimum<intptr_t>(profile_->SelectorCount(name),
+                                           kMaxInt32));
+            }
           }
         }
       }
@@ -623,6 +643,9 @@ void DispatchTableGenerator::ComputeSelectorOffsets() {
   // Sort the table rows according to popularity, descending.
   struct PopularitySorter {
     static int Compare(SelectorRow* const* a, SelectorRow* const* b) {
+      if ((*a)->Popularity() != (*b)->Popularity()) {
+        return (*b)->Popularity() > (*a)->Popularity() ? 1 : -1;
+      }
       return (*b)->CallCount() - (*a)->CallCount();
     }
   };
@@ -637,8 +660,9 @@ void DispatchTableGenerator::ComputeSelectorOffsets() {
   // Sort the table rows according to popularity / size, descending.
   struct PopularitySizeRatioSorter {
     static int Compare(SelectorRow* const* a, SelectorRow* const* b) {
-      return (*b)->CallCount() * (*a)->total_size() -
-             (*a)->CallCount() * (*b)->total_size();
+      const int64_t left = (*b)->Popularity() * (*a)->total_size();
+      const int64_t right = (*a)->Popularity() * (*b)->total_size();
+      return left == right ? 0 : (left > right ? 1 : -1);
     }
   };
   table_rows_.Sort(PopularitySizeRatioSorter::Compare);
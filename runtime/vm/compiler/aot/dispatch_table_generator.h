@@ -14,6 +14,7 @@
 
 namespace dart {
 
+class AotProfile;
 class ClassTable;
 class Precompiler;
 class PrecompilerTracer;
@@ -51,6 +52,9 @@ struct TableSelector {
   bool on_null_interface = false;
   // Do any targets of this selector assume that an args descriptor is passed?
   bool requires_args_descriptor = false;
+  // Number of calls with this selector executed by the training run, or -1
+  // if the table is laid out without a profile.
+  int32_t profile_count = -1;
 };
 
 class SelectorMap {
@@ -92,8 +96,9 @@ class DispatchTableGenerator {
 
   SelectorMap* selector_map() { return &selector_map_; }
 
-  // Find suitable selectors and compute offsets for them.
-  void Initialize(ClassTable* table);
+  // Find suitable selectors and compute offsets for them. With a training
+  // [profile], the most frequently executed selectors are placed first.
+  void Initialize(ClassTable* table, const AotProfile* profile = nullptr);
 
   // Build up an array of Code objects, used to serialize the information
   // deserialized as a DispatchTable at runtime.
@@ -107,6 +112,7 @@ class DispatchTableGenerator {
 
   Zone* const zone_;
   ClassTable* classes_;
+  const AotProfile* profile_ = nullptr;
   int32_t num_selectors_;
   int32_t num_classes_;
   int32_t table_size_;
@@ -13,6 +13,7 @@
 #include "vm/closure_functions_cache.h"
 #include "vm/code_patcher.h"
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler_tracer.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
@@ -39,6 +40,7 @@
 #include "vm/flags.h"
 #include "vm/hash_table.h"
 #include "vm/isolate.h"
+#include "vm/kernel.h"
 #include "vm/log.h"
 #include "vm/longjump.h"
 #include "vm/object.h"
@@ -50,6 +52,7 @@
 #include "vm/regexp_parser.h"
 #include "vm/resolver.h"
 #include "vm/runtime_entry.h"
+#include "vm/source_report.h"
 #include "vm/symbols.h"
 #include "vm/tags.h"
 #include "vm/timeline.h"
@@ -74,6 +77,11 @@ DEFINE_FLAG(charp,
             nullptr,
             "Print layout of Dart objects to the given file");
 DEFINE_FLAG(bool, trace_precompiler, false, "Trace precompiler.");
+DEFINE_FLAG(bool,
+            precompile_constant_static_initializers,
+            true,
+            "Store the values of static fields initialized with constants in "
+            "the snapshot instead of initializing them lazily at runtime.");
 DEFINE_FLAG(
     int,
     max_speculative_inlining_attempts,
@@ -83,6 +91,11 @@ DEFINE_FLAG(charp,
             write_retained_reasons_to,
             nullptr,
             "Print reasons for retaining objects to the given file");
+DEFINE_FLAG(charp,
+            write_compilation_fingerprints_to,
+            nullptr,
+            "Print the source fingerprints of every compiled function and "
+            "of the functions inlined into it to the given file");
 
 DECLARE_FLAG(bool, print_flow_graph);
 DECLARE_FLAG(bool, print_flow_graph_optimized);
@@ -330,6 +343,86 @@ class RetainedReasonsWriter : public ValueObject {
   void* file_;
 };
 
+// Records, in compilation order, which sources the code of each compiled
+// function was generated from: the function itself, its owner and every
+// function inlined into it. Comparing the output of two builds tells which
+// functions have to be recompiled after a change.
+class CompilationFingerprintsWriter : public ValueObject {
+ public:
+  CompilationFingerprintsWriter() {}
+
+  bool Init(const char* filename) {
+    if (filename == nullptr) return false;
+
+    if ((Dart::file_write_callback() == nullptr) ||
+        (Dart::file_open_callback() == nullptr) ||
+        (Dart::file_close_callback() == nullptr)) {
+      OS::PrintErr("warning: Could not access file callbacks.");
+      return false;
+    }
+
+    void* file = Dart::file_open_callback()(filename, /*write=*/true);
+    if (file == nullptr) {
+      OS::PrintErr("warning: Failed to write compilation fingerprints: %s\n",
+                   filename);
+      return false;
+    }
+
+    file_ = file;
+    writer_.OpenArray();
+    return true;
+  }
+
+  void AddCompiled(Zone* zone, const Function& function) {
+    const auto& code = Code::Handle(zone, function.CurrentCode());
+    const auto& owner = Class::Handle(zone, function.Owner());
+    writer_.OpenObject();
+    writer_.PrintProperty("name", function.ToLibNamePrefixedQualifiedCString());
+    writer_.PrintProperty("kind",
+                          UntaggedFunction::KindToCString(function.kind()));
+    writer_.PrintProperty64("fingerprint", function.SourceFingerprint());
+    writer_.PrintProperty64("class_fingerprint", owner.SourceFingerprint());
+    writer_.PrintProperty64("size", code.Size());
+
+    // Entry 0 of the inlining table is the function itself.
+    const auto& inlined = Array::Handle(zone, code.inlined_id_to_function());
+    auto& callee = Function::Handle(zone);
+    writer_.OpenArray("inlined");
+    for (intptr_t i = 1; !inlined.IsNull() && i < inlined.Length(); i++) {
+      callee ^= inlined.At(i);
+      writer_.OpenObject();
+      writer_.PrintProperty("name", callee.ToLibNamePrefixedQualifiedCString());
+      writer_.PrintProperty64("fingerprint", callee.SourceFingerprint());
+      writer_.CloseObject();
+    }
+    writer_.CloseArray();
+    writer_.CloseObject();
+  }
+
+  void Write() {
+    if (file_ == nullptr) return;
+
+    writer_.CloseArray();
+    char* output = nullptr;
+    intptr_t length = -1;
+    writer_.Steal(&output, &length);
+
+    if (const auto file_write = Dart::file_write_callback()) {
+      file_write(output, length, file_);
+    }
+
+    if (const auto file_close = Dart::file_close_callback()) {
+      file_close(file_);
+    }
+
+    free(output);
+  }
+
+ private:
+  JSONWriter writer_;
+  void* file_ = nullptr;
+};
+
 class PrecompileParsedFunctionHelper : public ValueObject {
  public:
   PrecompileParsedFunctionHelper(Precompiler* precompiler,
@@ -413,6 +506,8 @@ Precompiler::Precompiler(Thread* thread)
       seen_functions_(HashTables::New<FunctionSet>(/*initial_capacity=*/1024)),
       possibly_retained_functions_(
           HashTables::New<FunctionSet>(/*initial_capacity=*/1024)),
+      functions_compiled_without_gc_(
+          HashTables::New<FunctionSet>(/*initial_capacity=*/1024)),
       fields_to_retain_(),
       functions_to_retain_(
           HashTables::New<FunctionSet>(/*initial_capacity=*/1024)),
@@ -440,6 +535,7 @@ Precompiler::~Precompiler() {
   functions_with_entry_point_pragmas_.Release();
   seen_functions_.Release();
   possibly_retained_functions_.Release();
+  functions_compiled_without_gc_.Release();
   functions_to_retain_.Release();
 
   ASSERT(Precompiler::singleton_ == this);
@@ -459,6 +555,10 @@ void Precompiler::DoCompileAll() {
     if (reasons_writer.Init(FLAG_write_retained_reasons_to)) {
       retained_reasons_writer_ = &reasons_writer;
     }
+    CompilationFingerprintsWriter fingerprints_writer;
+    if (fingerprints_writer.Init(FLAG_write_compilation_fingerprints_to)) {
+      fingerprints_writer_ = &fingerprints_writer;
+    }
 
     // Since we keep the object pool until the end of AOT compilation, it
     // will hang on to its entries until the very end. Therefore we have
@@ -480,6 +580,10 @@ void Precompiler::DoCompileAll() {
 
       ClassFinalizer::SortClasses();
 
+      // The profile refers to classes by name, so it can only be resolved
+      // once class ids are final.
+      profile_ = AotProfile::ReadIfRequested(Z);
+
       // Collects type usage information which allows us to decide when/how to
       // optimize runtime type tests.
       TypeUsageInfo type_usage_info(T);
@@ -489,12 +593,18 @@ void Precompiler::DoCompileAll() {
       HierarchyInfo hierarchy_info(T);
 
       dispatch_table_generator_ = new compiler::DispatchTableGenerator(Z);
-      dispatch_table_generator_->Initialize(IG->class_table());
+      dispatch_table_generator_->Initialize(IG->class_table(), profile_);
 
       // After finding all code, and before starting to trace, populate the
       // assets map.
       GetNativeAssetsMap(T);
 
+      // Before any code is compiled, so that no code checks whether these
+      // fields are initialized.
+      if (FLAG_precompile_constant_static_initializers) {
+        PrecompileStaticInitializers();
+      }
+
       // Precompile constructors to compute information such as
       // optimized instruction count (used in inlining heuristics).
       ClassFinalizer::ClearAllCode(
@@ -605,6 +715,9 @@ void Precompiler::DoCompileAll() {
         TraceForRetainedFunctions();
       }
 
+      // Must run before functions only used inlined are dropped.
+      CollectCoverageArrays();
+
       FinalizeDispatchTable();
       ReplaceFunctionStaticCallEntries();
 
@@ -672,6 +785,10 @@ void Precompiler::DoCompileAll() {
       reasons_writer.Write();
       retained_reasons_writer_ = nullptr;
     }
+    if (fingerprints_writer_ != nullptr) {
+      fingerprints_writer.Write();
+      fingerprints_writer_ = nullptr;
+    }
 
     zone_ = nullptr;
   }
@@ -735,6 +852,47 @@ void Precompiler::PrecompileConstructors() {
   phase_ = Phase::kPreparation;
 }
 
+void Precompiler::PrecompileStaticInitializers() {
+  PRECOMPILER_TIMER_SCOPE(this, PrecompileStaticInitializers);
+  HANDLESCOPE(T);
+  SafepointWriteRwLocker ml(T, IG->program_lock());
+  FieldTable* initial_field_table = IG->initial_field_table();
+  auto& lib = Library::Handle(Z);
+  auto& cls = Class::Handle(Z);
+  auto& fields = Array::Handle(Z);
+  auto& field = Field::Handle(Z);
+  auto& value = Object::Handle(Z);
+  for (intptr_t i = 0; i < libraries_.Length(); i++) {
+    lib ^= libraries_.At(i);
+    ClassDictionaryIterator it(lib, ClassDictionaryIterator::kIteratePrivate);
+    while (it.HasNext()) {
+      cls = it.GetNextClass();
+      fields = cls.fields();
+      for (intptr_t k = 0; k < fields.Length(); k++) {
+        field ^= fields.At(k);
+        if (!field.is_static() || !field.has_nontrivial_initializer() ||
+            field.needs_load_guard() ||
+            initial_field_table->At(field.field_id()) !=
+                Object::sentinel().ptr()) {
+          continue;
+        }
+        // A constant initializer has no side effects, so initializing the
+        // field ahead of time is not observable.
+        value = kernel::EvaluateConstantFieldInitializer(field);
+        if (value.ptr() == Object::sentinel().ptr() || value.IsError()) {
+          continue;
+        }
+        if (FLAG_trace_precompiler) {
+          THR_Print("Precompiled initializer of %s\n", field.ToCString());
+        }
+        field.SetStaticConstFieldValue(
+            value.IsNull() ? Instance::null_instance() : Instance::Cast(value));
+        field.set_has_nontrivial_initializer(false);
+      }
+    }
+  }
+}
+
 void Precompiler::AddRoots() {
   HANDLESCOPE(T);
   AddSelector(Symbols::NoSuchMethod());
@@ -781,6 +939,13 @@ void Precompiler::Iterate() {
 
   Function& function = Function::Handle(Z);
 
+  // Functions are compiled one at a time on the precompiler thread. Besides
+  // discovering new functions to compile, each compilation appends to the
+  // shared global object pool, allocates and canonicalizes objects in the
+  // heap and relies on the optimized instruction counts of previously
+  // compiled callees for inlining decisions. The order in which functions
+  // are compiled therefore determines the snapshot, and this loop has to
+  // stay serial until code generation no longer depends on such state.
   phase_ = Phase::kFixpointCodeGeneration;
   while (changed_) {
     changed_ = false;
@@ -891,8 +1056,16 @@ void Precompiler::ProcessFunction(const Function& function) {
     Jump(error_);
   }
 
-  // Used in the JIT to save type-feedback across compilations.
-  function.ClearICDataArray();
+  if (fingerprints_writer_ != nullptr) {
+    fingerprints_writer_->AddCompiled(Z, function);
+  }
+
+  // Used in the JIT to save type-feedback across compilations. With
+  // --aot_coverage it holds the coverage array shared with the copies of
+  // the function inlined elsewhere, see CollectCoverageArrays.
+  if (!FLAG_aot_coverage) {
+    function.ClearICDataArray();
+  }
   AddCalleesOf(function, gop_offset);
 }
 
@@ -1471,6 +1644,32 @@ void Precompiler::AddTableSelector(const compiler::TableSelector* selector) {
   changed_ = true;
 }
 
+void Precompiler::RecordWhetherCompiledWithoutGC(const Function& function,
+                                                 FlowGraph* flow_graph) {
+  // Functions are only compiled once during the fixpoint, so their code does
+  // not change anymore once recorded.
+  if (phase() != Phase::kFixpointCodeGeneration) return;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      if (auto branch = current->AsBranch()) {
+        current = branch->comparison();
+      }
+      if (current->CanTriggerGC() && !IsCallWithoutGC(current)) {
+        return;
+      }
+    }
+  }
+  functions_compiled_without_gc_.Insert(function);
+}
+
+bool Precompiler::IsCallWithoutGC(Instruction* instr) {
+  if (auto call = instr->AsStaticCall()) {
+    return functions_compiled_without_gc_.ContainsKey(call->function());
+  }
+  return false;
+}
+
 bool Precompiler::IsHitByTableSelector(const Function& function) {
   const int32_t selector_id = selector_map()->SelectorId(function);
   if (selector_id == compiler::SelectorMap::kInvalidSelectorId) return false;
@@ -1943,6 +2142,56 @@ void Precompiler::CollectDynamicFunctionNames() {
   table.Release();
 }
 
+void Precompiler::CollectCoverageArrays() {
+#if !defined(PRODUCT)
+  if (!FLAG_aot_coverage) {
+    return;
+  }
+
+  class CoverageArraysCollector : public FunctionVisitor {
+   public:
+    CoverageArraysCollector(Zone* zone, const GrowableObjectArray& table)
+        : table_(table),
+          script_(Script::Handle(zone)),
+          coverage_(Array::Handle(zone)),
+          position_(Smi::Handle(zone)) {}
+
+    void VisitFunction(const Function& function) {
+      coverage_ = function.GetCoverageArray();
+      if (coverage_.IsNull() || coverage_.Length() == 0) return;
+      script_ = function.script();
+      if (script_.IsNull()) return;
+      ASSERT(table_.Length() % AotCoverage::kEntrySize ==
+             AotCoverage::kScriptIndex);
+      table_.Add(script_);
+      position_ = Smi::New(function.token_pos().Serialize());
+      table_.Add(position_);
+      position_ = Smi::New(function.end_token_pos().Serialize());
+      table_.Add(position_);
+      table_.Add(coverage_);
+    }
+
+   private:
+    const GrowableObjectArray& table_;
+    Script& script_;
+    Array& coverage_;
+    Smi& position_;
+  };
+
+  HANDLESCOPE(T);
+  const auto& table =
+      GrowableObjectArray::Handle(Z, GrowableObjectArray::New());
+  CoverageArraysCollector visitor(Z, table);
+  ProgramVisitor::WalkProgram(Z, IG, &visitor);
+  IG->object_store()->set_aot_coverage_table(
+      Array::Handle(Z, Array::MakeFixedLength(table)));
+  if (FLAG_trace_precompiler) {
+    THR_Print("Collected coverage of %" Pd " functions\n",
+              table.Length() / AotCoverage::kEntrySize);
+  }
+#endif  // !defined(PRODUCT)
+}
+
 void Precompiler::TraceForRetainedFunctions() {
   HANDLESCOPE(T);
   Library& lib = Library::Handle(Z);
@@ -3411,6 +3660,13 @@ void PrecompileParsedFunctionHelper::FinalizeCompilation(
                                   pool_attachment, optimized(), stats));
   code.set_is_optimized(optimized());
   code.set_owner(function);
+  if (precompiler_->profile() != nullptr &&
+      precompiler_->phase() == Precompiler::Phase::kFixpointCodeGeneration &&
+      !precompiler_->profile()->WasExecuted(function)) {
+    // Move code which was not needed during training out of the way of the
+    // code which was (see CodeSerializationCluster::CompareCodeOrderInfo).
+    code.set_is_cold(true);
+  }
   if (!function.IsOptimizable()) {
     // A function with huge unoptimized code can become non-optimizable
     // after generating unoptimized code.
@@ -3616,6 +3872,8 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         done = false;
         continue;
       }
+      precompiler_->RecordWhetherCompiledWithoutGC(
+          parsed_function()->function(), flow_graph);
       // Exit the loop and the function with the correct result value.
       is_compiled = true;
       done = true;
@@ -28,8 +28,11 @@ class Function;
 class GrowableObjectArray;
 class String;
 class Precompiler;
+class AotProfile;
 class FlowGraph;
+class Instruction;
 class PrecompilerTracer;
+class CompilationFingerprintsWriter;
 class RetainedReasonsWriter;
 
 class TableSelectorKeyValueTrait {
@@ -266,6 +269,16 @@ class Precompiler : public ValueObject {
   void AddField(const Field& field);
   void AddTableSelector(const compiler::TableSelector* selector);
 
+  // Records that the code of [function] was compiled from [flow_graph] if
+  // none of its instructions can trigger GC (see Instruction::CanTriggerGC).
+  void RecordWhetherCompiledWithoutGC(const Function& function,
+                                      FlowGraph* flow_graph);
+
+  // Whether [instr] is a call to a function whose code cannot trigger GC on
+  // a non-exceptional path, so that the call cannot either. Write barrier
+  // elimination keeps tracking allocations across such calls.
+  bool IsCallWithoutGC(Instruction* instr);
+
   enum class Phase {
     kPreparation,
     kCompilingConstructorsForInstructionCounts,
@@ -277,6 +290,18 @@ class Precompiler : public ValueObject {
 
   bool is_tracing() const { return is_tracing_; }
 
+  // Training profile passed with --aot_profile, or nullptr.
+  const AotProfile* profile() const { return profile_; }
+
+  // Number of instructions added to the program by inlining so far, see
+  // --inlining_code_size_budget.
+  intptr_t inlined_instruction_count() const {
+    return inlined_instruction_count_;
+  }
+  void AddInlinedInstructions(intptr_t count) {
+    inlined_instruction_count_ += count;
+  }
+
   Thread* thread() const { return thread_; }
   Zone* zone() const { return zone_; }
 
@@ -338,6 +363,7 @@ class Precompiler : public ValueObject {
 
   void AttachOptimizedTypeTestingStub();
 
+  void CollectCoverageArrays();
   void TraceForRetainedFunctions();
   void FinalizeDispatchTable();
   void ReplaceFunctionStaticCallEntries();
@@ -394,6 +420,7 @@ class Precompiler : public ValueObject {
   FunctionSet functions_with_entry_point_pragmas_;
   FunctionSet seen_functions_;
   FunctionSet possibly_retained_functions_;
+  FunctionSet functions_compiled_without_gc_;
   FieldSet fields_to_retain_;
   FunctionSet functions_to_retain_;
   ClassSet classes_to_retain_;
@@ -412,7 +439,10 @@ class Precompiler : public ValueObject {
 
   Phase phase_ = Phase::kPreparation;
   PrecompilerTracer* tracer_ = nullptr;
+  AotProfile* profile_ = nullptr;
+  intptr_t inlined_instruction_count_ = 0;
   RetainedReasonsWriter* retained_reasons_writer_ = nullptr;
+  CompilationFingerprintsWriter* fingerprints_writer_ = nullptr;
   bool is_tracing_ = false;
 };
 
@@ -1739,6 +1739,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ add(R1, R2, Operand(R1, LSL, target::kWordSizeLog2));
   __ ldr(FUNCTION_REG, FieldAddress(R1, target::RegExp::function_offset(
                                             kOneByteStringCid, sticky)));
+  // Until the regexp is promoted from the bytecode interpreter, the slot holds
+  // bytecode or null. Let the native interpret it.
+  __ CompareClassId(FUNCTION_REG, kFunctionCid, R1);
+  __ b(normal_ir_body, NE);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in R0, the argument descriptor in R4, and IC-Data in R9.
@@ -1747,6 +1751,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   // Tail-call the function.
   __ ldr(CODE_REG, FieldAddress(FUNCTION_REG, target::Function::code_offset()));
   __ Branch(FieldAddress(FUNCTION_REG, target::Function::entry_point_offset()));
+
+  __ Bind(normal_ir_body);
 }
 
 void AsmIntrinsifier::UserTag_defaultTag(Assembler* assembler,
@@ -1976,6 +1976,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ LoadCompressed(FUNCTION_REG,
                     FieldAddress(R1, target::RegExp::function_offset(
                                          kOneByteStringCid, sticky)));
+  // Until the regexp is promoted from the bytecode interpreter, the slot holds
+  // bytecode or null. Let the native interpret it.
+  __ CompareClassId(FUNCTION_REG, kFunctionCid);
+  __ b(normal_ir_body, NE);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in R0, the argument descriptor in R4, and IC-Data in R5.
@@ -1987,6 +1991,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ ldr(R1,
          FieldAddress(FUNCTION_REG, target::Function::entry_point_offset()));
   __ br(R1);
+
+  __ Bind(normal_ir_body);
 }
 
 void AsmIntrinsifier::UserTag_defaultTag(Assembler* assembler,
@@ -1781,6 +1781,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ movl(FUNCTION_REG, FieldAddress(EBX, EDI, TIMES_4,
                                      target::RegExp::function_offset(
                                          kOneByteStringCid, sticky)));
+  // Until the regexp is promoted from the bytecode interpreter, the slot holds
+  // bytecode or null. Let the native interpret it.
+  __ CompareClassId(FUNCTION_REG, kFunctionCid, EDI);
+  __ j(NOT_EQUAL, normal_ir_body);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in EAX, the argument descriptor in EDX, and IC-Data in ECX.
@@ -1788,6 +1792,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
 
   // Tail-call the function.
   __ jmp(FieldAddress(FUNCTION_REG, target::Function::entry_point_offset()));
+
+  __ Bind(normal_ir_body);
 }
 
 void AsmIntrinsifier::UserTag_defaultTag(Assembler* assembler,
@@ -1995,6 +1995,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ add(T1, T1, T2);
   __ lx(FUNCTION_REG, FieldAddress(T1, target::RegExp::function_offset(
                                            kOneByteStringCid, sticky)));
+  // Until the regexp is promoted from the bytecode interpreter, the slot holds
+  // bytecode or null. Let the native interpret it.
+  __ CompareClassId(FUNCTION_REG, kFunctionCid, TMP);
+  __ BranchIf(NE, normal_ir_body);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in T0, the argument descriptor in S4, and IC-Data in S5.
@@ -2004,6 +2008,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ lx(CODE_REG, FieldAddress(FUNCTION_REG, target::Function::code_offset()));
   __ lx(T1, FieldAddress(FUNCTION_REG, target::Function::entry_point_offset()));
   __ jr(T1);
+
+  __ Bind(normal_ir_body);
 }
 
 void AsmIntrinsifier::UserTag_defaultTag(Assembler* assembler,
@@ -1879,6 +1879,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
                                                target::RegExp::function_offset(
                                                    kOneByteStringCid, sticky)));
 #endif
+  // Until the regexp is promoted from the bytecode interpreter, the slot holds
+  // bytecode or null. Let the native interpret it.
+  __ CompareClassId(FUNCTION_REG, kFunctionCid);
+  __ j(NOT_EQUAL, normal_ir_body);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in RAX, the argument descriptor in R10, and IC-Data in RCX.
@@ -1890,6 +1894,8 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ movq(RDI,
           FieldAddress(FUNCTION_REG, target::Function::entry_point_offset()));
   __ jmp(RDI);
+
+  __ Bind(normal_ir_body);
 }
 
 void AsmIntrinsifier::UserTag_defaultTag(Assembler* assembler,
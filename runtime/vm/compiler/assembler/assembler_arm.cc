@@ -2702,9 +2702,18 @@ void Assembler::BranchLink(const Code& target,
   // to by this code sequence.
   // For added code robustness, use 'blx lr' in a patchable sequence and
   // use 'blx ip' in a non-patchable sequence (see other BranchLink flavors).
-  const intptr_t index =
-      object_pool_builder().FindObject(ToObject(target), patchable);
-  LoadWordFromPoolIndex(CODE_REG, index, PP, AL);
+  intptr_t offset_from_thread = 0;
+  if (patchable == ObjectPoolBuilderEntry::kNotPatchable &&
+      !FLAG_precompiled_mode &&
+      target::CanLoadFromThread(ToObject(target), &offset_from_thread)) {
+    // JIT code has an object pool per Code object. Stubs cached on the thread
+    // don't need an entry in each of them.
+    ldr(CODE_REG, Address(THR, offset_from_thread));
+  } else {
+    const intptr_t index =
+        object_pool_builder().FindObject(ToObject(target), patchable);
+    LoadWordFromPoolIndex(CODE_REG, index, PP, AL);
+  }
   Call(FieldAddress(CODE_REG, target::Code::entry_point_offset(entry_kind)));
 }
 
@@ -698,9 +698,18 @@ void Assembler::Branch(const Code& target,
 void Assembler::BranchLink(const Code& target,
                            ObjectPoolBuilderEntry::Patchability patchable,
                            CodeEntryKind entry_kind) {
-  const intptr_t index =
-      object_pool_builder().FindObject(ToObject(target), patchable);
-  LoadWordFromPoolIndex(CODE_REG, index);
+  word offset_from_thread = 0;
+  if (patchable == ObjectPoolBuilderEntry::kNotPatchable &&
+      !FLAG_precompiled_mode &&
+      target::CanLoadFromThread(ToObject(target), &offset_from_thread)) {
+    // JIT code has an object pool per Code object. Stubs cached on the thread
+    // don't need an entry in each of them.
+    ldr(CODE_REG, Address(THR, offset_from_thread));
+  } else {
+    const intptr_t index =
+        object_pool_builder().FindObject(ToObject(target), patchable);
+    LoadWordFromPoolIndex(CODE_REG, index);
+  }
   Call(FieldAddress(CODE_REG, target::Code::entry_point_offset(entry_kind)));
 }
 
@@ -2992,9 +2992,18 @@ void Assembler::Jump(const Code& target,
 void Assembler::JumpAndLink(const Code& target,
                             ObjectPoolBuilderEntry::Patchability patchable,
                             CodeEntryKind entry_kind) {
-  const intptr_t index =
-      object_pool_builder().FindObject(ToObject(target), patchable);
-  LoadWordFromPoolIndex(CODE_REG, index);
+  word offset_from_thread = 0;
+  if (patchable == ObjectPoolBuilderEntry::kNotPatchable &&
+      !FLAG_precompiled_mode &&
+      target::CanLoadFromThread(ToObject(target), &offset_from_thread)) {
+    // JIT code has an object pool per Code object. Stubs cached on the thread
+    // don't need an entry in each of them.
+    lx(CODE_REG, Address(THR, offset_from_thread));
+  } else {
+    const intptr_t index =
+        object_pool_builder().FindObject(ToObject(target), patchable);
+    LoadWordFromPoolIndex(CODE_REG, index);
+  }
   Call(FieldAddress(CODE_REG, target::Code::entry_point_offset(entry_kind)));
 }
 
@@ -82,9 +82,17 @@ void Assembler::CallWithEquivalence(const Code& target,
 
 void Assembler::Call(const Code& target) {
   ASSERT(constant_pool_allowed());
-  const intptr_t idx = object_pool_builder().FindObject(
-      ToObject(target), ObjectPoolBuilderEntry::kNotPatchable);
-  LoadWordFromPoolIndex(CODE_REG, idx);
+  intptr_t offset_from_thread;
+  if (!FLAG_precompiled_mode &&
+      target::CanLoadFromThread(ToObject(target), &offset_from_thread)) {
+    // JIT code has an object pool per Code object. Stubs cached on the thread
+    // don't need an entry in each of them.
+    movq(CODE_REG, Address(THR, offset_from_thread));
+  } else {
+    const intptr_t idx = object_pool_builder().FindObject(
+        ToObject(target), ObjectPoolBuilderEntry::kNotPatchable);
+    LoadWordFromPoolIndex(CODE_REG, idx);
+  }
   call(FieldAddress(CODE_REG, target::Code::entry_point_offset()));
 }
 
@@ -9,6 +9,11 @@
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/jit/compiler.h"
 
+#if defined(DART_PRECOMPILER)
+#include "vm/compiler/aot/aot_profile.h"
+#include "vm/compiler/aot/precompiler.h"
+#endif  // defined(DART_PRECOMPILER)
+
 namespace dart {
 
 static intptr_t GetEdgeCount(const Array& edge_counters, intptr_t edge_id) {
@@ -155,9 +160,11 @@ static void Union(GrowableArray<Chain*>* chains,
   }
 }
 
-void BlockScheduler::ReorderBlocks(FlowGraph* flow_graph) {
+void BlockScheduler::ReorderBlocks(
+    FlowGraph* flow_graph,
+    const GrowableArray<const Function*>* inline_id_to_function) {
   if (CompilerState::Current().is_aot()) {
-    ReorderBlocksAOT(flow_graph);
+    ReorderBlocksAOT(flow_graph, inline_id_to_function);
   } else {
     ReorderBlocksJIT(flow_graph);
   }
@@ -238,9 +245,45 @@ void BlockScheduler::ReorderBlocksJIT(FlowGraph* flow_graph) {
   }
 }
 
-// Moves blocks ending in a throw/rethrow, as well as any block post-dominated
-// by such a throwing block, to the end.
-void BlockScheduler::ReorderBlocksAOT(FlowGraph* flow_graph) {
+// Returns whether [block] contains a call which was never executed while
+// recording the AOT training profile, although the function containing the
+// call was. Such blocks are unlikely to be executed in production either.
+static bool IsColdInProfile(
+    BlockEntryInstr* block,
+    const GrowableArray<const Function*>* inline_id_to_function) {
+#if defined(DART_PRECOMPILER)
+  Precompiler* precompiler = Precompiler::Instance();
+  if (inline_id_to_function == nullptr || precompiler == nullptr ||
+      precompiler->profile() == nullptr) {
+    return false;
+  }
+  const AotProfile* profile = precompiler->profile();
+  for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+    Instruction* instr = it.Current();
+    if (!instr->IsStaticCall() && !instr->IsInstanceCall() &&
+        !instr->IsPolymorphicInstanceCall() && !instr->IsDispatchTableCall() &&
+        !instr->IsClosureCall()) {
+      continue;
+    }
+    if (!instr->has_inlining_id() ||
+        instr->inlining_id() >= inline_id_to_function->length()) {
+      continue;
+    }
+    const Function& function = *(*inline_id_to_function)[instr->inlining_id()];
+    if (profile->CallCount(function, instr->token_pos()) == 0) {
+      return true;
+    }
+  }
+#endif  // defined(DART_PRECOMPILER)
+  return false;
+}
+
+// Moves blocks ending in a throw/rethrow or known to be cold from the AOT
+// training profile, as well as any block post-dominated by such a block, to
+// the end.
+void BlockScheduler::ReorderBlocksAOT(
+    FlowGraph* flow_graph,
+    const GrowableArray<const Function*>* inline_id_to_function) {
   if (!FLAG_reorder_basic_blocks) {
     return;
   }
@@ -254,11 +297,12 @@ void BlockScheduler::ReorderBlocksAOT(FlowGraph* flow_graph) {
   // predecessors need to be marked as well.
   GrowableArray<BlockEntryInstr*> worklist;
 
-  // Add all throwing blocks to the worklist.
+  // Add all throwing and cold blocks to the worklist.
   for (intptr_t i = 0; i < block_count; ++i) {
     auto block = reverse_postorder[i];
     auto last = block->last_instruction();
-    if (last->IsThrow() || last->IsReThrow()) {
+    if (last->IsThrow() || last->IsReThrow() ||
+        IsColdInProfile(block, inline_id_to_function)) {
       const intptr_t preorder_nr = block->preorder_number();
       is_terminating[preorder_nr] = true;
       worklist.Add(block);
@@ -281,8 +325,8 @@ void BlockScheduler::ReorderBlocksAOT(FlowGraph* flow_graph) {
     }
   }
 
-  // Emit code in reverse postorder but move any throwing blocks (except the
-  // function entry, which needs to come first) to the very end.
+  // Emit code in reverse postorder but move any throwing or cold blocks
+  // (except the function entry, which needs to come first) to the very end.
   auto codegen_order = flow_graph->CodegenBlockOrder(true);
   for (intptr_t i = 0; i < block_count; ++i) {
     auto block = reverse_postorder[i];
@@ -10,18 +10,29 @@
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 
 #include "vm/allocation.h"
+#include "vm/growable_array.h"
 
 namespace dart {
 
 class FlowGraph;
+class Function;
 
 class BlockScheduler : public AllStatic {
  public:
   static void AssignEdgeWeights(FlowGraph* flow_graph);
-  static void ReorderBlocks(FlowGraph* flow_graph);
+
+  // [inline_id_to_function] maps the inlining ids of the instructions in
+  // [flow_graph] to the functions they were inlined from. If it is given,
+  // blocks which the AOT training profile (see --aot_profile) shows to be
+  // cold are moved to the end as well.
+  static void ReorderBlocks(
+      FlowGraph* flow_graph,
+      const GrowableArray<const Function*>* inline_id_to_function = nullptr);
 
  private:
-  static void ReorderBlocksAOT(FlowGraph* flow_graph);
+  static void ReorderBlocksAOT(
+      FlowGraph* flow_graph,
+      const GrowableArray<const Function*>* inline_id_to_function);
   static void ReorderBlocksJIT(FlowGraph* flow_graph);
 };
 
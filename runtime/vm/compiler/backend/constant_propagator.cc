@@ -9,6 +9,7 @@
 #include "vm/compiler/backend/flow_graph_compiler.h"
 #include "vm/compiler/backend/il.h"
 #include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/pure_call_evaluator.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/parser.h"
@@ -539,6 +540,32 @@ void ConstantPropagator::VisitStaticCall(StaticCallInstr* instr) {
     default:
       break;
   }
+
+  if (CompilerState::Current().is_aot() && (instr->FirstArgIndex() == 0) &&
+      PureCallEvaluator::IsCandidate(instr->function())) {
+    GrowableArray<const Object*> arguments(instr->ArgumentCount());
+    for (intptr_t i = 0; i < instr->ArgumentCount(); ++i) {
+      const Object& argument = instr->ArgumentAt(i)->constant_value();
+      if (IsUnknown(argument)) {
+        return;
+      }
+      if (!IsConstant(argument)) {
+        break;
+      }
+      arguments.Add(&argument);
+    }
+    if (arguments.length() == instr->ArgumentCount()) {
+      if (pure_call_evaluator_ == nullptr) {
+        pure_call_evaluator_ = new (Z) PureCallEvaluator(T);
+      }
+      Object& value = Object::ZoneHandle(Z);
+      if (pure_call_evaluator_->Evaluate(instr, arguments, &value)) {
+        SetValue(instr, value);
+        return;
+      }
+    }
+  }
+
   SetValue(instr, non_constant_);
 }
 
@@ -14,6 +14,8 @@
 
 namespace dart {
 
+class PureCallEvaluator;
+
 // Sparse conditional constant propagation and unreachable code elimination.
 // Assumes that use lists are computed and preserves them.
 class ConstantPropagator : public FlowGraphVisitor {
@@ -114,6 +116,9 @@ class ConstantPropagator : public FlowGraphVisitor {
   // Worklists of blocks and definitions.
   GrowableArray<BlockEntryInstr*> block_worklist_;
   DefinitionWorklist definition_worklist_;
+
+  // Created when the first call to a candidate pure function is visited.
+  PureCallEvaluator* pure_call_evaluator_ = nullptr;
 };
 
 }  // namespace dart
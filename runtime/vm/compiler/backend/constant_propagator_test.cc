@@ -368,4 +368,63 @@ ISOLATE_UNIT_TEST_CASE(ConstantPropagator_StrictCompareNotEqualsSentinelRight) {
                         /*non_sentinel_on_left=*/false);
 }
 
+#if defined(DART_PRECOMPILER)
+// Calls to pure functions with constant arguments are evaluated in AOT.
+ISOLATE_UNIT_TEST_CASE(ConstantPropagator_PureCall) {
+  const char* kScript = R"(
+    int mask(int bits) {
+      int result = 0;
+      for (int i = 0; i < bits; i++) {
+        result |= 1 << i;
+      }
+      return result;
+    }
+
+    int fib(int n) => n < 2 ? n : fib(n - 1) + fib(n - 2);
+
+    int divide(int x) => 100 ~/ x;
+
+    int foo() => mask(12) + fib(10) + divide(0);
+
+    void main() {
+      foo();
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kConstantPropagation,
+  });
+
+  intptr_t static_calls = 0;
+  bool has_mask_constant = false;
+  bool has_fib_constant = false;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (auto call = it.Current()->AsStaticCall()) {
+        static_calls++;
+        // Evaluating the division would throw.
+        EXPECT_STREQ("divide", String::Handle(call->function().name())
+                                   .ToCString());
+      }
+      for (intptr_t i = 0; i < it.Current()->InputCount(); ++i) {
+        Value* input = it.Current()->InputAt(i);
+        if (input->BindsToSmiConstant()) {
+          has_mask_constant |= input->BoundSmiConstant() == 0xFFF;
+          has_fib_constant |= input->BoundSmiConstant() == 55;
+        }
+      }
+    }
+  }
+  EXPECT_EQ(1, static_calls);
+  EXPECT(has_mask_constant);
+  EXPECT(has_fib_constant);
+}
+#endif  // defined(DART_PRECOMPILER)
+
 }  // namespace dart
@@ -0,0 +1,217 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/counted_loop.h"
+
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+
+namespace dart {
+
+CountedLoop::CountedLoop(FlowGraph* flow_graph, LoopInfo* loop)
+    : flow_graph_(flow_graph),
+      zone_(flow_graph->zone()),
+      loop_(loop),
+      header_(loop->header()->AsJoinEntry()),
+      limits_(zone_, 0) {}
+
+CountedLoop* CountedLoop::Match(FlowGraph* flow_graph, LoopInfo* loop) {
+  auto counted = new (flow_graph->zone()) CountedLoop(flow_graph, loop);
+  return counted->MatchShape() ? counted : nullptr;
+}
+
+bool CountedLoop::IsInvariant(Definition* def) const {
+  return !loop_->Contains(def->GetBlock());
+}
+
+bool CountedLoop::MatchShape() {
+  if (header_ == nullptr || loop_->inner() != nullptr ||
+      loop_->back_edges().length() != 1 || header_->PredecessorCount() != 2) {
+    return false;
+  }
+  body_ = loop_->back_edges()[0];
+  if (!body_->IsTargetEntry() || body_->PredecessorCount() != 1 ||
+      body_->PredecessorAt(0) != header_) {
+    return false;
+  }
+  pre_header_ = header_->PredecessorAt(0) == body_ ? header_->PredecessorAt(1)
+                                                   : header_->PredecessorAt(0);
+  if (!pre_header_->last_instruction()->IsGoto()) {
+    return false;
+  }
+
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    if (!phi->is_alive()) continue;
+    if (phi_ != nullptr) return false;
+    phi_ = phi;
+  }
+  if (phi_ == nullptr || phi_->representation() != kUnboxedInt64) {
+    return false;
+  }
+
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current->IsCheckStackOverflow() && check_ == nullptr) {
+      check_ = current->AsCheckStackOverflow();
+    } else if (current->IsBranch()) {
+      branch_ = current->AsBranch();
+    } else {
+      return false;
+    }
+  }
+  if (branch_ == nullptr || branch_->true_successor() != body_) {
+    return false;
+  }
+  RelationalOpInstr* compare = branch_->comparison()->AsRelationalOp();
+  if (compare == nullptr || compare->kind() != Token::kLT ||
+      compare->operation_cid() != kMintCid ||
+      compare->left()->definition() != phi_ ||
+      !IsInvariant(compare->right()->definition())) {
+    return false;
+  }
+  bound_ = compare->right()->definition();
+
+  // The loop counter must advance by one each iteration. As the bound is
+  // checked before every iteration, neither the counter nor the last
+  // iteration of a fast loop trip can overflow.
+  int64_t stride = 0;
+  if (!InductionVar::IsLinear(loop_->LookupInduction(phi_), &stride) ||
+      stride != 1) {
+    return false;
+  }
+  initial_ =
+      phi_->InputAt(header_->IndexOfPredecessor(pre_header_))->definition();
+  Value* next = phi_->InputAt(header_->IndexOfPredecessor(body_));
+  next_ = next->definition();
+  return next_->GetBlock() == body_ && next_->HasOnlyUse(next);
+}
+
+Definition* CountedLoop::AddToPreHeader(Definition* def) {
+  flow_graph_->InsertBefore(pre_header_->last_instruction(), def, nullptr,
+                            FlowGraph::kValue);
+  return def;
+}
+
+Definition* CountedLoop::AddInt64Constant(Instruction* prev,
+                                          Definition* left,
+                                          int64_t right) {
+  auto add = new (zone_) BinaryInt64OpInstr(
+      Token::kADD, new (zone_) Value(left),
+      new (zone_) Value(flow_graph_->GetConstant(
+          Integer::ZoneHandle(zone_, Integer::NewCanonical(right)),
+          kUnboxedInt64)),
+      DeoptId::kNone, Instruction::kNotSpeculative);
+  flow_graph_->AppendTo(prev, add, nullptr, FlowGraph::kValue);
+  return add;
+}
+
+TargetEntryInstr* CountedLoop::NewTarget() {
+  return new (zone_) TargetEntryInstr(flow_graph_->allocate_block_id(),
+                                      header_->try_index(), DeoptId::kNone);
+}
+
+JoinEntryInstr* CountedLoop::NewJoin() {
+  return new (zone_) JoinEntryInstr(flow_graph_->allocate_block_id(),
+                                    header_->try_index(), DeoptId::kNone);
+}
+
+void CountedLoop::AppendGoto(BlockEntryInstr* block,
+                             Instruction* last,
+                             JoinEntryInstr* target) {
+  auto jump = new (zone_) GotoInstr(target, DeoptId::kNone);
+  flow_graph_->AppendTo(last, jump, nullptr, FlowGraph::kEffect);
+  block->set_last_instruction(jump);
+}
+
+TargetEntryInstr* CountedLoop::BuildFastLoop(intptr_t step) {
+  step_ = step;
+  fast_header_ = NewJoin();
+  fast_body_ = NewTarget();
+  fast_exit_ = limits_.is_empty() ? static_cast<BlockEntryInstr*>(NewTarget())
+                                  : NewJoin();
+
+  fast_phi_ = new (zone_) PhiInstr(fast_header_, 2);
+  flow_graph_->AllocateSSAIndex(fast_phi_);
+  fast_phi_->mark_alive();
+  fast_phi_->set_representation(kUnboxedInt64);
+  fast_header_->InsertPhi(fast_phi_);
+
+  Instruction* last = fast_header_;
+  if (check_ != nullptr) {
+    auto check = new (zone_) CheckStackOverflowInstr(
+        check_->source(), check_->stack_depth(), check_->loop_depth(),
+        check_->deopt_id(), check_->kind());
+    last = flow_graph_->AppendTo(last, check, check_->env(),
+                                 FlowGraph::kEffect);
+    if (check->env() != nullptr) {
+      for (Environment::DeepIterator it(check->env()); !it.Done();
+           it.Advance()) {
+        Value* value = it.CurrentValue();
+        if (value->definition() == phi_) {
+          value->RemoveFromUseList();
+          value->BindToEnvironment(fast_phi_);
+        }
+      }
+    }
+  }
+  Definition* last_iteration = AddInt64Constant(last, fast_phi_, step - 1);
+  last = last_iteration;
+
+  // Test fi + step - 1 against the bound and then against each limit.
+  BlockEntryInstr* block = fast_header_;
+  for (intptr_t i = -1; i < limits_.length(); i++) {
+    Definition* limit = i < 0 ? bound_ : limits_[i];
+    auto compare = new (zone_) RelationalOpInstr(
+        branch_->comparison()->source(), Token::kLT,
+        new (zone_) Value(last_iteration), new (zone_) Value(limit), kMintCid,
+        DeoptId::kNone, Instruction::kNotSpeculative);
+    auto branch = new (zone_) BranchInstr(compare, DeoptId::kNone);
+    flow_graph_->AppendTo(last, branch, nullptr, FlowGraph::kEffect);
+    block->set_last_instruction(branch);
+
+    TargetEntryInstr* next_block =
+        i + 1 < limits_.length() ? NewTarget() : fast_body_;
+    *branch->true_successor_address() = next_block;
+    if (limits_.is_empty()) {
+      *branch->false_successor_address() = fast_exit_->AsTargetEntry();
+    } else {
+      TargetEntryInstr* exit = NewTarget();
+      *branch->false_successor_address() = exit;
+      AppendGoto(exit, exit, fast_exit_->AsJoinEntry());
+    }
+    block = next_block;
+    last = next_block;
+  }
+  AppendGoto(fast_exit_, fast_exit_, header_);
+
+  // P: goto FH
+  pre_header_->last_instruction()->AsGoto()->set_successor(fast_header_);
+  return fast_body_;
+}
+
+void CountedLoop::FinishFastLoop(Instruction* last) {
+  fast_next_ = AddInt64Constant(last, fast_phi_, step_);
+  AppendGoto(fast_body_, fast_next_, fast_header_);
+}
+
+void CountedLoop::SetPhiInput(PhiInstr* phi,
+                              BlockEntryInstr* predecessor,
+                              Definition* def) {
+  Value* input = new (zone_) Value(def);
+  phi->SetInputAt(phi->block()->IndexOfPredecessor(predecessor), input);
+  def->AddInputUse(input);
+}
+
+void CountedLoop::ConnectPhis() {
+  SetPhiInput(fast_phi_, pre_header_, initial_);
+  SetPhiInput(fast_phi_, fast_body_, fast_next_);
+
+  phi_->UnuseAllInputs();
+  SetPhiInput(phi_, fast_exit_, fast_phi_);
+  SetPhiInput(phi_, body_, next_);
+}
+
+}  // namespace dart
@@ -0,0 +1,124 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_COUNTED_LOOP_H_
+#define RUNTIME_VM_COMPILER_BACKEND_COUNTED_LOOP_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+
+namespace dart {
+
+class BlockEntryInstr;
+class BranchInstr;
+class CheckStackOverflowInstr;
+class Definition;
+class FlowGraph;
+class Instruction;
+class JoinEntryInstr;
+class LoopInfo;
+class PhiInstr;
+class TargetEntryInstr;
+
+// A single block loop counting up by one to a loop invariant bound
+//
+//   P: goto H
+//   H: i = phi(i0, i'); [CheckStackOverflow]; if (i < n) goto B else goto E
+//   B: ...; i' = i + 1; ...; goto H
+//
+// which loop transformations can precede with a fast loop performing
+// several iterations of B per trip
+//
+//   P: goto FH
+//   FH: fi = phi(i0, fi + step); if (fi + step - 1 < n) goto FB else goto FX
+//   FB: ...; goto FH
+//   FX: goto H
+//   H: i = phi(fi, i'); ...
+//
+// leaving the remaining iterations to the original loop. The fast loop can
+// be guarded by additional invariant limits, in which case it is left as
+// soon as fi + step - 1 reaches any of them.
+class CountedLoop : public ZoneAllocated {
+ public:
+  // Returns nullptr unless [loop] has the shape above. Requires induction
+  // analysis of the loop hierarchy.
+  static CountedLoop* Match(FlowGraph* flow_graph, LoopInfo* loop);
+
+  LoopInfo* loop() const { return loop_; }
+  BlockEntryInstr* pre_header() const { return pre_header_; }
+  JoinEntryInstr* header() const { return header_; }
+  BlockEntryInstr* body() const { return body_; }
+  PhiInstr* phi() const { return phi_; }
+  Definition* initial() const { return initial_; }
+  Definition* next() const { return next_; }
+  Definition* bound() const { return bound_; }
+
+  bool IsInvariant(Definition* def) const;
+
+  // Inserts [def] at the end of the pre-header and returns it.
+  Definition* AddToPreHeader(Definition* def);
+
+  // Adds an invariant kUnboxedInt64 limit on fi + step - 1 guarding the
+  // fast loop. Must be called before BuildFastLoop().
+  void AddLimit(Definition* limit) { limits_.Add(limit); }
+
+  // Builds the control of the fast loop and returns the entry of its body,
+  // to which the caller appends the body before FinishFastLoop().
+  TargetEntryInstr* BuildFastLoop(intptr_t step);
+  void FinishFastLoop(Instruction* last);
+
+  PhiInstr* fast_phi() const { return fast_phi_; }
+
+  // Connects the phis of both loops. Must be called after the predecessors
+  // of all blocks have been recomputed by FlowGraph::DiscoverBlocks().
+  void ConnectPhis();
+
+ private:
+  CountedLoop(FlowGraph* flow_graph, LoopInfo* loop);
+
+  bool MatchShape();
+  Definition* AddInt64Constant(Instruction* prev,
+                               Definition* left,
+                               int64_t right);
+  TargetEntryInstr* NewTarget();
+  JoinEntryInstr* NewJoin();
+  void AppendGoto(BlockEntryInstr* block,
+                  Instruction* last,
+                  JoinEntryInstr* target);
+  void SetPhiInput(PhiInstr* phi,
+                   BlockEntryInstr* predecessor,
+                   Definition* def);
+
+  FlowGraph* const flow_graph_;
+  Zone* const zone_;
+  LoopInfo* const loop_;
+  JoinEntryInstr* const header_;
+
+  BlockEntryInstr* pre_header_ = nullptr;
+  BlockEntryInstr* body_ = nullptr;
+  PhiInstr* phi_ = nullptr;
+  Definition* initial_ = nullptr;
+  Definition* next_ = nullptr;
+  Definition* bound_ = nullptr;
+  CheckStackOverflowInstr* check_ = nullptr;
+  BranchInstr* branch_ = nullptr;
+
+  GrowableArray<Definition*> limits_;
+  intptr_t step_ = 0;
+  JoinEntryInstr* fast_header_ = nullptr;
+  TargetEntryInstr* fast_body_ = nullptr;
+  BlockEntryInstr* fast_exit_ = nullptr;
+  PhiInstr* fast_phi_ = nullptr;
+  Definition* fast_next_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(CountedLoop);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_COUNTED_LOOP_H_
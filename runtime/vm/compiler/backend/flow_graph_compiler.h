@@ -855,6 +855,11 @@ class FlowGraphCompiler : public ValueObject {
 
   bool may_reoptimize() const { return may_reoptimize_; }
 
+  // True when generating code for the baseline tier of the JIT, which counts
+  // invocations at the entry to be promoted to fully optimized code.
+  bool is_baseline_tier() const { return is_baseline_tier_; }
+  void set_is_baseline_tier(bool value) { is_baseline_tier_ = value; }
+
   // Use in unoptimized compilation to preserve/reuse ICData.
   //
   // If [binary_smi_target] is non-null and we have to create the ICData, the
@@ -1169,6 +1174,7 @@ class FlowGraphCompiler : public ValueObject {
   SpeculativeInliningPolicy* speculative_policy_;
   // Set to true if optimized code has IC calls.
   bool may_reoptimize_;
+  bool is_baseline_tier_ = false;
   // True while emitting intrinsic code.
   bool intrinsic_mode_;
   compiler::Label* intrinsic_slow_path_label_ = nullptr;
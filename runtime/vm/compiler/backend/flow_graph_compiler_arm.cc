@@ -278,7 +278,7 @@ void FlowGraphCompiler::GenerateMethodExtractorIntrinsic(
 void FlowGraphCompiler::EmitFrameEntry() {
   const Function& function = parsed_function().function();
   if (CanOptimizeFunction() && function.IsOptimizable() &&
-      (!is_optimizing() || may_reoptimize())) {
+      (!is_optimizing() || may_reoptimize() || is_baseline_tier())) {
     __ Comment("Invocation Count Check");
     const Register function_reg = R8;
     __ ldr(function_reg, compiler::FieldAddress(
@@ -287,8 +287,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
                    function_reg,
                    compiler::target::Function::usage_counter_offset()));
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function. Baseline code
+    // counts its invocations until it is promoted.
+    if (!is_optimizing() || is_baseline_tier()) {
       __ add(R3, R3, compiler::Operand(1));
       __ str(R3, compiler::FieldAddress(
                      function_reg,
@@ -258,7 +258,7 @@ void FlowGraphCompiler::GenerateMethodExtractorIntrinsic(
 void FlowGraphCompiler::EmitFrameEntry() {
   const Function& function = parsed_function().function();
   if (CanOptimizeFunction() && function.IsOptimizable() &&
-      (!is_optimizing() || may_reoptimize())) {
+      (!is_optimizing() || may_reoptimize() || is_baseline_tier())) {
     __ Comment("Invocation Count Check");
     const Register function_reg = A0;
     const Register usage_reg = A1;
@@ -268,8 +268,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
                            Function::usage_counter_offset(),
                            compiler::kFourBytes);
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function. Baseline code
+    // counts its invocations until it is promoted.
+    if (!is_optimizing() || is_baseline_tier()) {
       __ addi(usage_reg, usage_reg, 1);
       __ StoreFieldToOffset(usage_reg, function_reg,
                             Function::usage_counter_offset(),
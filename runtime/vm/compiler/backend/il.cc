@@ -930,6 +930,18 @@ AllocateUninitializedContextInstr::AllocateUninitializedContextInstr(
   ASSERT(!CompilerState::Current().is_aot());
 }
 
+intptr_t CreateArrayInstr::MaxNumElements() const {
+  if (HasConstantNumElements()) {
+    return GetConstantNumElements();
+  }
+  Range* range = num_elements()->definition()->range();
+  if (Range::IsUnknown(range)) {
+    return -1;
+  }
+  const int64_t max = Range::ConstantMax(range).ConstantValue();
+  return (max <= compiler::target::Array::kMaxElements) ? max : -1;
+}
+
 LocationSummary* AllocateClosureInstr::MakeLocationSummary(Zone* zone,
                                                            bool opt) const {
   const intptr_t kNumInputs = inputs_.length();
@@ -6454,8 +6466,39 @@ LoadIndexedInstr::LoadIndexedInstr(Value* array,
   SetInputAt(1, index);
 }
 
+// Returns the typed data whose payload [array] points into, if [array] is the
+// data field of an object known to be internal typed data.
+//
+// FFI loads and stores through a struct access the memory of its
+// _typedDataBase via the untagged data field, since the base may also be a
+// Pointer. When the base is known to be internal typed data, for example a
+// struct returned by value, the access can use the typed data directly. This
+// avoids the untagged value, which keeps the allocation from being forwarded
+// or sunk.
+static Definition* InternalTypedDataOfDataField(Value* array) {
+  auto load = array->definition()->AsLoadUntagged();
+  if (load == nullptr ||
+      load->offset() != compiler::target::PointerBase::data_offset() ||
+      load->object()->definition()->representation() != kTagged) {
+    return nullptr;
+  }
+  if (!IsTypedDataClassId(load->object()->Type()->ToCid())) {
+    return nullptr;
+  }
+  return load->object()->definition();
+}
+
 Definition* LoadIndexedInstr::Canonicalize(FlowGraph* flow_graph) {
   auto Z = flow_graph->zone();
+  if (auto typed_data = InternalTypedDataOfDataField(array());
+      typed_data != nullptr && IsTypedDataClassId(class_id())) {
+    auto load = new (Z) LoadIndexedInstr(
+        new (Z) Value(typed_data), index()->CopyWithType(Z), index_unboxed_,
+        index_scale(), class_id(), alignment_, GetDeoptId(), source(),
+        result_type_);
+    flow_graph->InsertBefore(this, load, env(), FlowGraph::kValue);
+    return load;
+  }
   if (auto box = index()->definition()->AsBoxInt64()) {
     // TODO(dartbug.com/39432): Make LoadIndexed fully suport unboxed indices.
     if (!box->ComputeCanDeoptimize() && compiler::target::kWordSize == 8) {
@@ -6511,6 +6554,16 @@ StoreIndexedInstr::StoreIndexedInstr(Value* array,
 
 Instruction* StoreIndexedInstr::Canonicalize(FlowGraph* flow_graph) {
   auto Z = flow_graph->zone();
+  if (auto typed_data = InternalTypedDataOfDataField(array());
+      typed_data != nullptr && IsTypedDataClassId(class_id())) {
+    auto store = new (Z) StoreIndexedInstr(
+        new (Z) Value(typed_data), index()->CopyWithType(Z),
+        value()->CopyWithType(Z), emit_store_barrier_, index_unboxed_,
+        index_scale(), class_id(), alignment_, GetDeoptId(), source(),
+        speculative_mode_);
+    flow_graph->InsertBefore(this, store, env(), FlowGraph::kEffect);
+    return nullptr;
+  }
   if (auto box = index()->definition()->AsBoxInt64()) {
     // TODO(dartbug.com/39432): Make StoreIndexed fully suport unboxed indices.
     if (!box->ComputeCanDeoptimize() && compiler::target::kWordSize == 8) {
@@ -4422,22 +4422,36 @@ class ClosureCallInstr : public TemplateDartCall<1> {
                    intptr_t type_args_len,
                    const Array& argument_names,
                    const InstructionSource& source,
-                   intptr_t deopt_id)
+                   intptr_t deopt_id,
+                   const Function& target_function = Function::null_function())
       : TemplateDartCall(deopt_id,
                          type_args_len,
                          argument_names,
                          std::move(inputs),
-                         source) {}
+                         source),
+        target_function_(target_function) {
+    DEBUG_ASSERT(target_function.IsNotTemporaryScopedHandle());
+  }
 
   DECLARE_INSTRUCTION(ClosureCall)
 
+  // Closure function which is known to be called (e.g. when calling a local
+  // function), or null.
+  const Function& target_function() const { return target_function_; }
+
   // TODO(kmillikin): implement exact call counts for closure calls.
   virtual intptr_t CallCount() const { return 1; }
 
   virtual bool HasUnknownSideEffects() const { return true; }
 
   PRINT_OPERANDS_TO_SUPPORT
-  DECLARE_EMPTY_SERIALIZATION(ClosureCallInstr, TemplateDartCall)
+
+#define FIELD_LIST(F) F(const Function&, target_function_)
+
+  DECLARE_INSTRUCTION_SERIALIZABLE_FIELDS(ClosureCallInstr,
+                                          TemplateDartCall,
+                                          FIELD_LIST)
+#undef FIELD_LIST
 
  private:
   DISALLOW_COPY_AND_ASSIGN(ClosureCallInstr);
@@ -6334,6 +6348,7 @@ class LoadIndexedInstr : public TemplateDefinition<2, NoThrow> {
 
   Value* array() const { return inputs_[0]; }
   Value* index() const { return inputs_[1]; }
+  bool index_unboxed() const { return index_unboxed_; }
   intptr_t index_scale() const { return index_scale_; }
   intptr_t class_id() const { return class_id_; }
   bool aligned() const { return alignment_ == kAlignedAccess; }
@@ -6611,6 +6626,7 @@ class StoreIndexedInstr : public TemplateInstruction<3, NoThrow> {
   Value* index() const { return inputs_[kIndexPos]; }
   Value* value() const { return inputs_[kValuePos]; }
 
+  bool index_unboxed() const { return index_unboxed_; }
   intptr_t index_scale() const { return index_scale_; }
   intptr_t class_id() const { return class_id_; }
   bool aligned() const { return alignment_ == kAlignedAccess; }
@@ -7267,11 +7283,16 @@ class CreateArrayInstr : public TemplateArrayAllocation<2> {
 
   virtual bool HasUnknownSideEffects() const { return false; }
 
+  // The constant number of elements, or an upper bound on it computed by
+  // range analysis, or -1 if it is unbounded.
+  intptr_t MaxNumElements() const;
+
   virtual bool WillAllocateNewOrRemembered() const {
     // Large arrays will use cards instead; cannot skip write barrier.
-    if (!HasConstantNumElements()) return false;
+    const intptr_t max_num_elements = MaxNumElements();
+    if (max_num_elements < 0) return false;
     return compiler::target::WillAllocateNewOrRememberedArray(
-        GetConstantNumElements());
+        max_num_elements);
   }
 
   virtual const Slot* SlotForInput(intptr_t pos) {
@@ -9222,6 +9243,7 @@ class CheckStackOverflowInstr : public TemplateInstruction<0, NoThrow> {
   bool in_loop() const { return loop_depth_ > 0; }
   intptr_t stack_depth() const { return stack_depth_; }
   intptr_t loop_depth() const { return loop_depth_; }
+  Kind kind() const { return kind_; }
 
   DECLARE_INSTRUCTION(CheckStackOverflow)
 
@@ -611,6 +611,15 @@ void ClosureCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
       Array::ZoneHandle(Z, GetArgumentsDescriptor());
   __ LoadObject(ARGS_DESC_REG, arguments_descriptor);
 
+  if (FLAG_precompiled_mode && !target_function().IsNull()) {
+    // The closure is passed as an argument, call its known function directly.
+    compiler->GenerateStaticDartCall(deopt_id(), source(),
+                                     UntaggedPcDescriptors::kOther, locs(),
+                                     target_function());
+    compiler->EmitDropArguments(argument_count);
+    return;
+  }
+
   if (FLAG_precompiled_mode) {
     ASSERT(locs()->in(0).reg() == R0);
     // R0: Closure with a cached entry point.
@@ -1776,13 +1785,15 @@ void Utf8ScanInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   const Register bytes_end_reg = end_reg;
   const Register flags_reg = bytes_reg;
   const Register temp_reg = TMP;
+  const Register temp_reg2 = TMP2;
   const Register decoder_temp_reg = start_reg;
   const Register flags_temp_reg = end_reg;
 
   const intptr_t kSizeMask = 0x03;
   const intptr_t kFlagsMask = 0x3C;
+  const int64_t kAsciiMask = 0x8080808080808080;
 
-  compiler::Label loop, loop_in;
+  compiler::Label ascii_loop, nonascii, loop, loop_in;
 
   // Address of input bytes.
   __ LoadFieldFromOffset(bytes_reg, bytes_reg,
@@ -1801,7 +1812,39 @@ void Utf8ScanInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ mov(size_reg, ZR);
   __ mov(flags_reg, ZR);
 
-  __ b(&loop_in);
+  // Loop scanning through ASCII bytes one 8-byte word at a time. ASCII bytes
+  // have a size of 1 and no flags.
+  __ Bind(&ascii_loop);
+  __ sub(temp_reg2, bytes_end_reg, compiler::Operand(bytes_ptr_reg));
+  __ CompareImmediate(temp_reg2, 8);
+  __ b(&loop_in, LESS);
+  __ ldr(temp_reg, compiler::Address(bytes_ptr_reg, 0), compiler::kEightBytes);
+  __ andi(temp_reg, temp_reg, compiler::Immediate(kAsciiMask));
+  __ cbnz(&nonascii, temp_reg);
+  __ add(bytes_ptr_reg, bytes_ptr_reg, compiler::Operand(8));
+  __ add(size_reg, size_reg, compiler::Operand(8));
+  __ b(&ascii_loop);
+
+  // Skip the ASCII bytes in front of the first non-ASCII byte of the word.
+  __ Bind(&nonascii);
+  __ rbit(temp_reg, temp_reg);
+  __ clz(temp_reg, temp_reg);
+  __ LsrImmediate(temp_reg, temp_reg, 3);
+  __ add(bytes_ptr_reg, bytes_ptr_reg, compiler::Operand(temp_reg));
+  __ add(size_reg, size_reg, compiler::Operand(temp_reg));
+
+  // Process the non-ASCII byte and go back to scanning words.
+  __ ldr(temp_reg,
+         compiler::Address(bytes_ptr_reg, 1, compiler::Address::PostIndex),
+         compiler::kUnsignedByte);
+  __ ldr(temp_reg, compiler::Address(table_reg, temp_reg),
+         compiler::kUnsignedByte);
+  __ orr(flags_reg, flags_reg, compiler::Operand(temp_reg));
+  __ andi(temp_reg, temp_reg, compiler::Immediate(kSizeMask));
+  __ add(size_reg, size_reg, compiler::Operand(temp_reg));
+  __ b(&ascii_loop);
+
+  // Less than 8 bytes left. Process the remaining bytes individually.
   __ Bind(&loop);
 
   // Read byte and increment pointer.
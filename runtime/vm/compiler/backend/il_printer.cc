@@ -719,6 +719,9 @@ void ClosureCallInstr::PrintOperandsTo(BaseTextBuffer* f) const {
     f->AddString(" function=");
   }
   InputAt(InputCount() - 1)->PrintTo(f);
+  if (!target_function().IsNull()) {
+    f->Printf(" target=%s", target_function().ToFullyQualifiedCString());
+  }
   f->Printf("<%" Pd ">", type_args_len());
   for (intptr_t i = 0; i < ArgumentCount(); ++i) {
     f->AddString(", ");
@@ -11,6 +11,7 @@
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/backend/il.h"
 #include "vm/compiler/backend/range_analysis.h"
+#include "vm/compiler/compiler_state.h"
 #include "vm/compiler/ffi/call.h"
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/object_store.h"
@@ -36,6 +37,13 @@ FlowGraphSerializer::~FlowGraphSerializer() {
   heap_->ResetObjectIdTable();
 }
 
+void FlowGraphSerializer::Unsupported(const char* what) {
+  if (!allow_unsupported_) {
+    FATAL("Unimplemented serialization of %s", what);
+  }
+  failed_ = true;
+}
+
 FlowGraphDeserializer::FlowGraphDeserializer(
     const ParsedFunction& parsed_function,
     ReadStream* stream)
@@ -464,7 +472,7 @@ void FlowGraphSerializer::WriteTrait<const Code&>::Write(FlowGraphSerializer* s,
   ++index;
   OBJECT_STORE_STUB_CODE_LIST(MATCH)
 #undef MATCH
-  UNIMPLEMENTED();
+  s->Unsupported(x.ToCString());
 }
 
 template <>
@@ -649,11 +657,10 @@ Environment::Environment(FlowGraphDeserializer* d)
 void FlowGraphSerializer::WriteFlowGraph(
     const FlowGraph& flow_graph,
     const ZoneGrowableArray<Definition*>& detached_defs) {
-  ASSERT(!flow_graph.is_licm_allowed());
-
   Write<intptr_t>(flow_graph.current_ssa_temp_index());
   Write<intptr_t>(flow_graph.max_block_id());
   Write<intptr_t>(flow_graph.inlining_id());
+  Write<bool>(flow_graph.is_licm_allowed());
   Write<const Array&>(flow_graph.coverage_array());
 
   PrologueInfo prologue_info = flow_graph.prologue_info();
@@ -712,7 +719,16 @@ FlowGraph* FlowGraphDeserializer::ReadFlowGraph() {
   const intptr_t current_ssa_temp_index = Read<intptr_t>();
   const intptr_t max_block_id = Read<intptr_t>();
   const intptr_t inlining_id = Read<intptr_t>();
-  const Array& coverage_array = Read<const Array&>();
+  const bool is_licm_allowed = Read<bool>();
+  const intptr_t coverage_array_index = object_counter_;
+  const Array* coverage_array = &Read<const Array&>();
+  if ((ic_data_array_ != nullptr) && (object_counter_ > coverage_array_index)) {
+    // Coverage data is type feedback as well, so bind the graph to the
+    // coverage array of the function instead of a copy.
+    coverage_array = &Array::ZoneHandle(
+        Z, parsed_function().function().GetCoverageArray());
+    SetObjectAt(coverage_array_index, *coverage_array);
+  }
   const PrologueInfo prologue_info(Read<intptr_t>(), Read<intptr_t>());
 
   definitions_.EnsureLength(current_ssa_temp_index, nullptr);
@@ -745,9 +761,11 @@ FlowGraph* FlowGraphDeserializer::ReadFlowGraph() {
       FlowGraph(parsed_function(), graph_entry_, max_block_id, prologue_info);
   flow_graph->set_current_ssa_temp_index(current_ssa_temp_index);
   flow_graph->CreateCommonConstants();
-  flow_graph->disallow_licm();
+  if (!is_licm_allowed) {
+    flow_graph->disallow_licm();
+  }
   flow_graph->set_inlining_id(inlining_id);
-  flow_graph->set_coverage_array(coverage_array);
+  flow_graph->set_coverage_array(*coverage_array);
 
   {
     const intptr_t num_blocks = Read<intptr_t>();
@@ -791,7 +809,10 @@ void FlowGraphSerializer::WriteTrait<const Function&>::Write(
       const auto& owner = Class::Handle(zone, x.Owner());
       s->Write<classid_t>(owner.id());
       const intptr_t function_index = owner.FindFunctionIndex(x);
-      ASSERT(function_index >= 0);
+      if (function_index < 0) {
+        s->Unsupported(x.ToCString());
+        return;
+      }
       s->Write<intptr_t>(function_index);
       return;
     }
@@ -805,13 +826,19 @@ void FlowGraphSerializer::WriteTrait<const Function&>::Write(
       s->Write<const Field&>(field);
       return;
     }
-    case UntaggedFunction::kClosureFunction:
+    case UntaggedFunction::kClosureFunction: {
       // TODO(alexmarkov): we cannot rely on ClosureFunctionsCache
       // as it is lazily populated when compiling functions.
       // We need to serialize kernel offset and re-create
       // closure functions when reading as needed.
-      s->Write<intptr_t>(ClosureFunctionsCache::FindClosureIndex(x));
+      const intptr_t closure_index = ClosureFunctionsCache::FindClosureIndex(x);
+      if (closure_index < 0) {
+        s->Unsupported(x.ToCString());
+        return;
+      }
+      s->Write<intptr_t>(closure_index);
       return;
+    }
     case UntaggedFunction::kMethodExtractor: {
       Function& function = Function::Handle(zone, x.extracted_method_closure());
       ASSERT(function.IsImplicitClosureFunction());
@@ -852,7 +879,8 @@ void FlowGraphSerializer::WriteTrait<const Function&>::Write(
   switch (x.kind()) {
 #define UNIMPLEMENTED_FUNCTION_KIND(kind)                                      \
   case UntaggedFunction::k##kind:                                              \
-    FATAL("Unimplemented WriteTrait<const Function&>::Write for " #kind);
+    s->Unsupported("WriteTrait<const Function&>::Write for " #kind);           \
+    return;
     FOR_EACH_RAW_FUNCTION_KIND(UNIMPLEMENTED_FUNCTION_KIND)
 #undef UNIMPLEMENTED_FUNCTION_KIND
   }
@@ -1012,7 +1040,13 @@ void FlowGraphSerializer::WriteTrait<const ICData*>::Write(
   } else {
     s->Write<bool>(true);
     ASSERT(!x->IsNull());
-    s->Write<const Object&>(*x);
+    if (s->ic_data_array() != nullptr) {
+      ASSERT(Instruction::GetICData(*s->ic_data_array(), x->deopt_id(),
+                                    x->is_static_call()) == x);
+      s->Write<intptr_t>(x->deopt_id());
+    } else {
+      s->Write<const Object&>(*x);
+    }
   }
 }
 
@@ -1022,6 +1056,13 @@ const ICData* FlowGraphDeserializer::ReadTrait<const ICData*>::Read(
   if (!d->Read<bool>()) {
     return nullptr;
   }
+  if (d->ic_data_array() != nullptr) {
+    const intptr_t deopt_id = d->Read<intptr_t>();
+    if (deopt_id >= d->ic_data_array()->length()) {
+      return nullptr;
+    }
+    return (*d->ic_data_array())[deopt_id];
+  }
   return &ICData::Cast(d->Read<const Object&>());
 }
 
@@ -1224,7 +1265,7 @@ template <>
 void FlowGraphSerializer::WriteTrait<const LocalVariable&>::Write(
     FlowGraphSerializer* s,
     const LocalVariable& x) {
-  UNIMPLEMENTED();
+  s->Unsupported(x.name().ToCString());
 }
 
 template <>
@@ -1395,12 +1436,14 @@ void FlowGraphSerializer::
   const auto& args = x.argument_locations();
   for (intptr_t i = 0, n = args.length(); i < n; ++i) {
     if (args.At(i)->payload_type().AsRepresentation() != kUnboxedFfiIntPtr) {
-      UNIMPLEMENTED();
+      s->Unsupported("NativeCallingConvention");
+      return;
     }
   }
   if (x.return_location().payload_type().AsRepresentation() !=
       kUnboxedFfiIntPtr) {
-    UNIMPLEMENTED();
+    s->Unsupported("NativeCallingConvention");
+    return;
   }
   s->Write<intptr_t>(args.length());
 }
@@ -1487,7 +1530,8 @@ void FlowGraphSerializer::WriteObjectImpl(const Object& x,
     case kClosureCid: {
       const auto& closure = Closure::Cast(x);
       if (closure.context() != Object::null()) {
-        UNIMPLEMENTED();
+        Unsupported(x.ToCString());
+        break;
       }
       ASSERT(closure.IsCanonical());
       auto& type_args = TypeArguments::Handle(Z);
@@ -1505,7 +1549,8 @@ void FlowGraphSerializer::WriteObjectImpl(const Object& x,
       Write<double>(Double::Cast(x).value());
       break;
     case kFieldCid: {
-      const auto& field = Field::Cast(x);
+      // Background compilations work with clones of fields.
+      const auto& field = Field::Handle(Z, Field::Cast(x).Original());
       const auto& owner = Class::Handle(Z, field.Owner());
       Write<classid_t>(owner.id());
       const intptr_t field_index = owner.FindFieldIndex(field);
@@ -1551,11 +1596,12 @@ void FlowGraphSerializer::WriteObjectImpl(const Object& x,
         Write<const Function&>(Function::Handle(Z, icdata.GetTargetAt(0)));
       } else if (icdata.rebind_rule() == ICData::kInstance) {
         if (icdata.NumberOfChecks() != 0) {
-          UNIMPLEMENTED();
+          Unsupported(x.ToCString());
+          break;
         }
         Write<const String&>(String::Handle(Z, icdata.target_name()));
       } else {
-        UNIMPLEMENTED();
+        Unsupported(x.ToCString());
       }
       break;
     }
@@ -1633,7 +1679,7 @@ void FlowGraphSerializer::WriteObjectImpl(const Object& x,
       } else if (x.ptr() == Object::optimized_out().ptr()) {
         Write<uint8_t>(2);
       } else {
-        UNIMPLEMENTED();
+        Unsupported(x.ToCString());
       }
       break;
     case kSmiCid:
@@ -1734,7 +1780,7 @@ void FlowGraphSerializer::WriteObjectImpl(const Object& x,
         }
         break;
       }
-      FATAL("Unimplemented WriteObjectImpl for %s", x.ToCString());
+      Unsupported(x.ToCString());
     }
   }
 }
@@ -1788,6 +1834,9 @@ const Object& FlowGraphDeserializer::ReadObjectImpl(intptr_t cid,
       const auto& owner = Class::Handle(Z, GetClassById(owner_class_id));
       auto& result = Field::ZoneHandle(Z, owner.FieldFromIndex(field_index));
       ASSERT(!result.IsNull());
+      if (CompilerState::Current().should_clone_fields()) {
+        result = result.CloneFromOriginal();
+      }
       return result;
     }
     case kFunctionCid:
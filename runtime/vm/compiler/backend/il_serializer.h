@@ -304,6 +304,24 @@ class FlowGraphSerializer : public ValueObject {
   Heap* heap() const { return heap_; }
   bool can_write_refs() const { return can_write_refs_; }
 
+  // Type feedback of the serialized graph. If set, ICData is written as
+  // its deopt id and the deserializer binds it (and the coverage array of
+  // the graph) to the type feedback which is current when the graph is read.
+  const ZoneGrowableArray<const ICData*>* ic_data_array() const {
+    return ic_data_array_;
+  }
+  void set_ic_data_array(const ZoneGrowableArray<const ICData*>* value) {
+    ic_data_array_ = value;
+  }
+
+  // If allowed, IL which cannot be serialized makes the serializer
+  // fail (see [failed]) instead of aborting the VM.
+  void set_allow_unsupported(bool value) { allow_unsupported_ = value; }
+  bool failed() const { return failed_; }
+
+  // Reports that [what] cannot be serialized.
+  void Unsupported(const char* what);
+
  private:
   void WriteObjectImpl(const Object& x, intptr_t cid, intptr_t object_index);
 
@@ -340,6 +358,9 @@ class FlowGraphSerializer : public ValueObject {
   intptr_t object_counter_ = 0;
   bool can_write_refs_ = false;
   bool writing_recursive_type_ = false;
+  const ZoneGrowableArray<const ICData*>* ic_data_array_ = nullptr;
+  bool allow_unsupported_ = false;
+  bool failed_ = false;
 };
 
 // Deserializes flow graph.
@@ -382,6 +403,15 @@ class FlowGraphDeserializer : public ValueObject {
     definitions_[ssa_temp_index] = def;
   }
 
+  // Type feedback used to resolve ICData written by deopt id, see
+  // FlowGraphSerializer::set_ic_data_array.
+  const ZoneGrowableArray<const ICData*>* ic_data_array() const {
+    return ic_data_array_;
+  }
+  void set_ic_data_array(const ZoneGrowableArray<const ICData*>* value) {
+    ic_data_array_ = value;
+  }
+
   FlowGraph* ReadFlowGraph();
 
   // Implementation of 'Read' method, specialized for a particular type.
@@ -540,6 +570,7 @@ class FlowGraphDeserializer : public ValueObject {
   GrowableArray<const Object*> objects_;
   intptr_t object_counter_ = 0;
   GrowableArray<intptr_t> pending_canonicalization_;
+  const ZoneGrowableArray<const ICData*>* ic_data_array_ = nullptr;
 };
 
 }  // namespace dart
@@ -1384,6 +1384,63 @@ ISOLATE_UNIT_TEST_CASE(IL_Canonicalize_TypedDataViewFactory) {
       thread, Slot::TypedDataView_typed_data());
 }
 
+// Check that an indexed load through the data field of internal typed data,
+// as used for fields of structs returned by value from FFI calls, reads the
+// typed data directly.
+static void TestCanonicalizationOfDataFieldLoads(Thread* thread,
+                                                 bool known_typed_data) {
+  using compiler::BlockBuilder;
+  CompilerState S(thread, /*is_aot=*/false, /*is_optimizing=*/true);
+  FlowGraphBuilderHelper H(/*num_parameters=*/1);
+  H.AddVariable("v0", AbstractType::ZoneHandle(Type::DynamicType()));
+
+  auto b1 = H.flow_graph()->graph_entry()->normal_entry();
+
+  Definition* base;
+  LoadIndexedInstr* load;
+  ReturnInstr* ret;
+
+  {
+    BlockBuilder builder(H.flow_graph(), b1);
+    auto v0 = builder.AddParameter(0, 0, /*with_frame=*/true, kTagged);
+    // base <- AllocateTypedData(16) or v0
+    base = known_typed_data
+               ? builder.AddDefinition(new AllocateTypedDataInstr(
+                     InstructionSource(), kTypedDataUint8ArrayCid,
+                     new Value(H.IntConstant(16)), DeoptId::kNone))
+               : v0;
+    // data <- LoadUntagged(base.data)
+    auto data = builder.AddDefinition(new LoadUntaggedInstr(
+        new Value(base), compiler::target::PointerBase::data_offset()));
+    // load <- LoadIndexed(data, 4) as int32
+    load = builder.AddDefinition(new LoadIndexedInstr(
+        new Value(data), new Value(H.IntConstant(4)),
+        /*index_unboxed=*/false, /*index_scale=*/1, kTypedDataInt32ArrayCid,
+        kAlignedAccess, DeoptId::kNone, InstructionSource()));
+    auto box = builder.AddDefinition(
+        BoxInstr::Create(kUnboxedInt32, new Value(load)));
+    ret = builder.AddReturn(new Value(box));
+  }
+  H.FinishGraph();
+  H.flow_graph()->Canonicalize();
+
+  auto result = ret->value()->definition()->AsBox()->value()->definition();
+  EXPECT(result->IsLoadIndexed());
+  if (known_typed_data) {
+    EXPECT(result != load);
+    EXPECT_PROPERTY(result->AsLoadIndexed()->array()->definition(),
+                    &it == base);
+    EXPECT(!result->AsLoadIndexed()->IsExternal());
+  } else {
+    EXPECT(result == load);
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(IL_Canonicalize_TypedDataDataFieldLoad) {
+  TestCanonicalizationOfDataFieldLoads(thread, /*known_typed_data=*/true);
+  TestCanonicalizationOfDataFieldLoads(thread, /*known_typed_data=*/false);
+}
+
 // Check that canonicalize can devirtualize InstanceCall based on type
 // information in AOT mode.
 ISOLATE_UNIT_TEST_CASE(IL_Canonicalize_InstanceCallWithNoICDataInAOT) {
@@ -1540,4 +1597,42 @@ ISOLATE_UNIT_TEST_CASE(IL_Canonicalize_FinalFieldForwarding) {
                             /*expected_to_forward=*/false);
 }
 
+#if !defined(PRODUCT)
+// With --aot_coverage, AOT code records the entry of the function and its
+// calls, since it has no ICData to tell which of them ran.
+ISOLATE_UNIT_TEST_CASE(IRTest_AotCoverage) {
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    int bar(int x) => x + 1;
+    int foo(int x) => bar(x);
+    main() {
+      foo(1);
+    }
+  )";
+
+  SetFlagScope<bool> sfs(&FLAG_aot_coverage, true);
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  intptr_t record_coverage_count = 0;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (it.Current()->IsRecordCoverage()) {
+        record_coverage_count++;
+      }
+    }
+  }
+  EXPECT_EQ(2, record_coverage_count);
+
+  // The array is attached to the function, so copies of it inlined elsewhere
+  // share it.
+  const auto& coverage = Array::Handle(function.GetCoverageArray());
+  EXPECT(!coverage.IsNull());
+  EXPECT_EQ(4, coverage.Length());
+}
+#endif  // !defined(PRODUCT)
+
 }  // namespace dart
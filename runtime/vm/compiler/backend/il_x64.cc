@@ -6691,6 +6691,15 @@ void ClosureCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
       Array::ZoneHandle(Z, GetArgumentsDescriptor());
   __ LoadObject(ARGS_DESC_REG, arguments_descriptor);
 
+  if (FLAG_precompiled_mode && !target_function().IsNull()) {
+    // The closure is passed as an argument, call its known function directly.
+    compiler->GenerateStaticDartCall(deopt_id(), source(),
+                                     UntaggedPcDescriptors::kOther, locs(),
+                                     target_function());
+    compiler->EmitDropArguments(argument_count);
+    return;
+  }
+
   if (FLAG_precompiled_mode) {
     ASSERT(locs()->in(0).reg() == RAX);
     // RAX: Closure with cached entry point.
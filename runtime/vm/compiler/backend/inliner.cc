@@ -5,6 +5,7 @@
 #include "vm/compiler/backend/inliner.h"
 
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
@@ -53,6 +54,16 @@ DEFINE_FLAG(int,
             inlining_callee_call_sites_threshold,
             1,
             "Always inline functions containing threshold or fewer calls.");
+DEFINE_FLAG(int,
+            inlining_local_allocation_size_threshold,
+            80,
+            "Inline functions with threshold or fewer instructions if they "
+            "receive or return an allocation which does not escape otherwise.");
+DEFINE_FLAG(int,
+            inlining_constant_type_arguments_size_threshold,
+            80,
+            "Inline generic functions with threshold or fewer instructions if "
+            "they receive constant instantiated type arguments.");
 DEFINE_FLAG(int,
             inlining_callee_size_threshold,
             160,
@@ -70,6 +81,23 @@ DEFINE_FLAG(int,
             10,
             "Inline only hotter calls, in percents (0 .. 100); "
             "default 10%: calls above-equal 10% of max-count are inlined.");
+DEFINE_FLAG(int,
+            inlining_hot_call_percent,
+            50,
+            "Calls executed at least this often, in percents (0 .. 100) of "
+            "the caller's most frequent call, are hot if their counts were "
+            "measured (type feedback, or --aot_profile under AOT).");
+DEFINE_FLAG(int,
+            inlining_hot_call_size_threshold,
+            80,
+            "Inline functions with threshold or fewer instructions at hot "
+            "call sites.");
+DEFINE_FLAG(int,
+            inlining_code_size_budget,
+            0,
+            "Once inlining added threshold instructions to the program, only "
+            "inline tiny functions at call sites which are not hot (0 means "
+            "no budget). Only used by the precompiler.");
 DEFINE_FLAG(int,
             inlining_recursion_depth_threshold,
             1,
@@ -79,6 +107,10 @@ DEFINE_FLAG(int,
             500,
             "Max. number of inlined calls per depth");
 DEFINE_FLAG(bool, print_inlining_tree, false, "Print inlining tree");
+DEFINE_FLAG(bool,
+            print_inlining_decisions,
+            false,
+            "Print the inlining decision made for each call site");
 
 DECLARE_FLAG(int, max_deoptimization_counter_threshold);
 DECLARE_FLAG(bool, print_flow_graph);
@@ -98,6 +130,9 @@ DECLARE_FLAG(bool, print_flow_graph_optimized);
       inlined_info_.Add(InlinedInfo(caller, target, inlining_depth_,           \
                                     instance_call, comment));                  \
     }                                                                          \
+    if (FLAG_print_inlining_decisions) {                                       \
+      PrintInliningDecision(comment, caller, target, instance_call);           \
+    }                                                                          \
   } while (false)
 
 // Test and obtain Smi value.
@@ -276,6 +311,117 @@ static intptr_t AotCallCountApproximation(intptr_t nesting_depth) {
   }
 }
 
+// Returns the number of times [call] in [caller] was executed according to
+// type feedback (JIT) or to the training profile (AOT, see --aot_profile),
+// or -1 if it is not known.
+static intptr_t MeasuredCallCount(const Function& caller,
+                                  const Definition* call) {
+  if (!CompilerState::Current().is_aot()) {
+    return call->CallCount();
+  }
+#if defined(DART_PRECOMPILER)
+  Precompiler* precompiler = Precompiler::Instance();
+  if (precompiler != nullptr && precompiler->profile() != nullptr) {
+    return precompiler->profile()->CallCount(caller, call->token_pos());
+  }
+#endif  // defined(DART_PRECOMPILER)
+  return -1;
+}
+
+// Under AOT, calls in functions which were executed while recording the
+// training profile (see --aot_profile) use the recorded call counts, and all
+// others fall back to the static estimate above.
+static intptr_t AotCallCount(const Function& caller,
+                             const Definition* call,
+                             intptr_t nesting_depth) {
+  const intptr_t count = MeasuredCallCount(caller, call);
+  if (count >= 0) return count;
+  return AotCallCountApproximation(nesting_depth);
+}
+
+// Returns whether inlining used up --inlining_code_size_budget.
+static bool IsOverCodeSizeBudget() {
+#if defined(DART_PRECOMPILER)
+  Precompiler* precompiler = Precompiler::Instance();
+  return FLAG_inlining_code_size_budget > 0 && precompiler != nullptr &&
+         precompiler->inlined_instruction_count() >
+             FLAG_inlining_code_size_budget;
+#else
+  return false;
+#endif  // defined(DART_PRECOMPILER)
+}
+
+// Returns true if [def] is only used to access its own fields and as an
+// argument of calls. Such an object does not escape once those calls are
+// inlined (provided they do not let it escape either), after which
+// allocation sinking can replace it by its fields. This is typical for
+// iterators of for-in loops, closures passed to higher-order functions and
+// records returned from inlined calls. [ret] is another use allowed.
+static bool EscapesOnlyIntoCalls(Definition* def,
+                                 Instruction* ret = nullptr) {
+  for (Value::Iterator it(def->input_use_list()); !it.Done(); it.Advance()) {
+    Value* use = it.Current();
+    Instruction* instr = use->instruction();
+    if (instr == ret || instr->IsLoadField() || instr->IsMaterializeObject() ||
+        instr->IsInstanceCall() || instr->IsPolymorphicInstanceCall() ||
+        instr->IsStaticCall() || instr->IsClosureCall()) {
+      continue;
+    }
+    if (auto store = instr->AsStoreField()) {
+      if (use == store->instance()) continue;
+    }
+    return false;
+  }
+  return true;
+}
+
+static bool IsLocalAllocation(Definition* def, Instruction* ret = nullptr) {
+  return (def->IsAllocateObject() || def->IsAllocateClosure() ||
+          def->IsAllocateRecord() || def->IsAllocateSmallRecord()) &&
+         EscapesOnlyIntoCalls(def, ret);
+}
+
+// Returns true if one of [arguments] is a local allocation of the caller.
+// If the callee graph is already built, the corresponding parameter in
+// [param_stubs] must not escape from the callee either.
+static bool ReceivesLocalAllocation(
+    const GrowableArray<Value*>& arguments,
+    const ZoneGrowableArray<Definition*>* param_stubs = nullptr) {
+  for (intptr_t i = 0, n = arguments.length(); i < n; i++) {
+    if (!IsLocalAllocation(arguments[i]->definition())) continue;
+    if (param_stubs == nullptr) return true;
+    if (i < param_stubs->length() && !(*param_stubs)[i]->IsConstant() &&
+        EscapesOnlyIntoCalls((*param_stubs)[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns true if the result of [call] is only used to access its fields,
+// e.g. a record which is destructured right away. If the callee graph is
+// already built, it must return an allocation which does not escape from the
+// callee either: once the call is inlined, allocation sinking removes the
+// allocation. This makes helpers returning multiple values as a record (or
+// another small object) allocation free.
+static bool ReturnsLocalAllocation(Definition* call,
+                                   FlowGraph* callee_graph = nullptr) {
+  if (call->input_use_list() == nullptr) return false;
+  for (Value::Iterator it(call->input_use_list()); !it.Done(); it.Advance()) {
+    if (!it.Current()->instruction()->IsLoadField()) return false;
+  }
+  if (callee_graph == nullptr) return true;
+  bool has_return = false;
+  for (BlockIterator block_it = callee_graph->postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    ReturnInstr* ret = block_it.Current()->last_instruction()->AsReturn();
+    if (ret == nullptr) continue;
+    if (!IsLocalAllocation(ret->value()->definition(), ret)) return false;
+    has_return = true;
+  }
+  return has_return;
+}
+
 // A collection of call sites to consider for inlining.
 class CallSites : public ValueObject {
  public:
@@ -286,6 +432,7 @@ class CallSites : public ValueObject {
     intptr_t call_depth;
     intptr_t nesting_depth;
     intptr_t call_count;
+    bool is_measured;  // Whether call_count is not just an estimate.
     double ratio = 0.0;
 
     CallInfo(FlowGraph* caller_graph,
@@ -297,13 +444,24 @@ class CallSites : public ValueObject {
           call_depth(call_depth),
           nesting_depth(nesting_depth) {
       if (CompilerState::Current().is_aot()) {
-        call_count = AotCallCountApproximation(nesting_depth);
+        call_count =
+            AotCallCount(caller_graph->function(), call, nesting_depth);
+        is_measured = MeasuredCallCount(caller_graph->function(), call) >= 0;
       } else {
         call_count = call->CallCount();
+        is_measured = true;
       }
     }
 
     const Function& caller() const { return caller_graph->function(); }
+
+    // Hot calls may inline larger callees (see
+    // --inlining_hot_call_size_threshold) and are not subject to
+    // --inlining_code_size_budget.
+    bool is_hot() const {
+      return is_measured && call_count > 0 &&
+             (ratio * 100) >= FLAG_inlining_hot_call_percent;
+    }
   };
 
   explicit CallSites(intptr_t threshold,
@@ -750,8 +908,22 @@ struct InlinedCallData {
   ZoneGrowableArray<Definition*>* parameter_stubs;
   InlineExitCollector* exit_collector;
   const Function& caller;
+  bool is_hot_call = false;
 };
 
+// Returns true if the call passes a constant vector of instantiated type
+// arguments. Inlining such a call specializes the generic callee for them:
+// type checks and instantiations depending on the type arguments fold to
+// constants.
+static bool ReceivesConstantTypeArguments(const InlinedCallData& call_data) {
+  if (call_data.first_arg_index == 0) return false;
+  Value* type_args = (*call_data.arguments)[0];
+  if (!type_args->BindsToConstant()) return false;
+  const Object& value = type_args->BoundConstant();
+  return value.IsNull() || (value.IsTypeArguments() &&
+                            TypeArguments::Cast(value).IsInstantiated());
+}
+
 class CallSiteInliner;
 
 class PolymorphicInliner : public ValueObject {
@@ -1060,7 +1232,10 @@ class CallSiteInliner : public ValueObject {
   // Inlining heuristics based on Cooper et al. 2008.
   InliningDecision ShouldWeInline(const Function& callee,
                                   intptr_t instr_count,
-                                  intptr_t call_site_count) {
+                                  intptr_t call_site_count,
+                                  bool passes_local_allocation,
+                                  bool receives_constant_type_arguments,
+                                  bool is_hot_call) {
     // Pragma or size heuristics.
     if (inliner_->AlwaysInline(callee)) {
       return InliningDecision::Yes("AlwaysInline");
@@ -1083,10 +1258,27 @@ class CallSiteInliner : public ValueObject {
     // late heuristic.
     if (instr_count == 0) {
       return InliningDecision::Yes("need to count first");
+    } else if (!is_hot_call &&
+               instr_count >= FLAG_inline_getters_setters_smaller_than &&
+               IsOverCodeSizeBudget()) {
+      // Keep the remaining growth of the program for hot calls.
+      return InliningDecision::No("--inlining-code-size-budget");
     } else if (instr_count <= FLAG_inlining_size_threshold) {
       return InliningDecision::Yes("--inlining-size-threshold");
     } else if (call_site_count <= FLAG_inlining_callee_call_sites_threshold) {
       return InliningDecision::Yes("--inlining-callee-call-sites-threshold");
+    } else if (passes_local_allocation &&
+               instr_count <= FLAG_inlining_local_allocation_size_threshold) {
+      return InliningDecision::Yes(
+          "--inlining-local-allocation-size-threshold");
+    } else if (receives_constant_type_arguments &&
+               instr_count <=
+                   FLAG_inlining_constant_type_arguments_size_threshold) {
+      return InliningDecision::Yes(
+          "--inlining-constant-type-arguments-size-threshold");
+    } else if (is_hot_call &&
+               instr_count <= FLAG_inlining_hot_call_size_threshold) {
+      return InliningDecision::Yes("--inlining-hot-call-size-threshold");
     }
     return InliningDecision::No("default");
   }
@@ -1147,6 +1339,8 @@ class CallSiteInliner : public ValueObject {
 
   bool inlined() const { return inlined_; }
 
+  intptr_t inlined_size() const { return inlined_size_; }
+
   double GrowthFactor() const {
     return static_cast<double>(inlined_size_) /
            static_cast<double>(initial_size_);
@@ -1272,8 +1466,11 @@ class CallSiteInliner : public ValueObject {
         constant_arg_count == 0 ? function.optimized_instruction_count() : 0;
     const intptr_t call_site_count =
         constant_arg_count == 0 ? function.optimized_call_site_count() : 0;
-    InliningDecision decision =
-        ShouldWeInline(function, instruction_count, call_site_count);
+    InliningDecision decision = ShouldWeInline(
+        function, instruction_count, call_site_count,
+        ReceivesLocalAllocation(*arguments) ||
+            ReturnsLocalAllocation(call_data->call),
+        ReceivesConstantTypeArguments(*call_data), call_data->is_hot_call);
     if (!decision.value) {
       TRACE_INLINING(
           THR_Print("     Bailout: early heuristics (%s) with "
@@ -1283,8 +1480,9 @@ class CallSiteInliner : public ValueObject {
                     "const args: %" Pd "\n",
                     decision.reason, instruction_count, call_site_count,
                     function.inlining_depth(), constant_arg_count));
-      PRINT_INLINING_TREE("Early heuristic", &call_data->caller, &function,
-                          call_data->call);
+      PRINT_INLINING_TREE(
+          Z->PrintToString("Early heuristic (%s)", decision.reason),
+          &call_data->caller, &function, call_data->call);
       return false;
     }
 
@@ -1537,8 +1735,12 @@ class CallSiteInliner : public ValueObject {
         // Use heuristics do decide if this call should be inlined.
         {
           COMPILER_TIMINGS_TIMER_SCOPE(thread(), MakeInliningDecision);
-          InliningDecision decision =
-              ShouldWeInline(function, instruction_count, call_site_count);
+          InliningDecision decision = ShouldWeInline(
+              function, instruction_count, call_site_count,
+              ReceivesLocalAllocation(*arguments, param_stubs) ||
+                  ReturnsLocalAllocation(call_data->call, callee_graph),
+              ReceivesConstantTypeArguments(*call_data),
+              call_data->is_hot_call);
           if (!decision.value) {
             // If size is larger than all thresholds, don't consider it again.
 
@@ -1546,7 +1748,12 @@ class CallSiteInliner : public ValueObject {
             // can identify highly-specialized functions that should always
             // be considered for inlining, without relying on a pragma.
             if ((instruction_count > FLAG_inlining_size_threshold) &&
-                (call_site_count > FLAG_inlining_callee_call_sites_threshold)) {
+                (call_site_count > FLAG_inlining_callee_call_sites_threshold) &&
+                (instruction_count >
+                 FLAG_inlining_local_allocation_size_threshold) &&
+                (instruction_count >
+                 FLAG_inlining_constant_type_arguments_size_threshold) &&
+                (instruction_count > FLAG_inlining_hot_call_size_threshold)) {
               // Will keep trying to inline the function if it can be
               // specialized based on argument types.
               if (!FlowGraphInliner::FunctionHasAlwaysConsiderInliningPragma(
@@ -1563,8 +1770,9 @@ class CallSiteInliner : public ValueObject {
                           "const args: %" Pd "\n",
                           decision.reason, instruction_count, call_site_count,
                           function.inlining_depth(), constants_count));
-            PRINT_INLINING_TREE("Heuristic fail", &call_data->caller, &function,
-                                call_data->call);
+            PRINT_INLINING_TREE(
+                Z->PrintToString("Heuristic fail (%s)", decision.reason),
+                &call_data->caller, &function, call_data->call);
             return false;
           }
 
@@ -1671,6 +1879,21 @@ class CallSiteInliner : public ValueObject {
     return false;
   }
 
+  // Prints one line per call site for --print_inlining_decisions. [reason]
+  // is nullptr if the call was inlined.
+  void PrintInliningDecision(const char* reason,
+                             const Function* caller,
+                             const Function* callee,
+                             const Definition* call) {
+    THR_Print("Inlining decision in %s: %s at %s (depth %" Pd ", count %" Pd
+              ", %s budget): %s\n",
+              caller->ToFullyQualifiedCString(),
+              callee->ToFullyQualifiedCString(), call->token_pos().ToCString(),
+              inlining_depth_, MeasuredCallCount(*caller, call),
+              IsOverCodeSizeBudget() ? "over" : "within",
+              reason == nullptr ? "inlined" : reason);
+  }
+
   void PrintInlinedInfo(const Function& top) {
     if (inlined_info_.length() > 0) {
       THR_Print("Inlining into: '%s'\n    growth: %f (%" Pd " -> %" Pd ")\n",
@@ -1804,6 +2027,7 @@ class CallSiteInliner : public ValueObject {
       InlinedCallData call_data(
           call, Array::ZoneHandle(Z, call->GetArgumentsDescriptor()),
           call->FirstArgIndex(), &arguments, call_info[call_idx].caller());
+      call_data.is_hot_call = call_info[call_idx].is_hot();
 
       // Under AOT, calls outside loops may pass our regular heuristics due
       // to a relatively high ratio. So, unless we are optimizing solely for
@@ -1845,6 +2069,11 @@ class CallSiteInliner : public ValueObject {
           target = Closure::Cast(constant->value()).function();
         }
       }
+      if (target.IsNull()) {
+        // E.g. a local function called from a closure nested in the function
+        // declaring it, where the closure is loaded from a context.
+        target = call->target_function().ptr();
+      }
 
       if (target.IsNull()) {
         TRACE_INLINING(THR_Print("     Bailout: non-closure operator\n"));
@@ -1866,6 +2095,7 @@ class CallSiteInliner : public ValueObject {
       InlinedCallData call_data(call, arguments_descriptor,
                                 call->FirstArgIndex(), &arguments,
                                 call_info[call_idx].caller());
+      call_data.is_hot_call = call_info[call_idx].is_hot();
       if (TryInlining(target, call->argument_names(), &call_data, false)) {
         InlineCall(&call_data);
         inlined = true;
@@ -2726,6 +2956,11 @@ int FlowGraphInliner::Inline() {
   if (FLAG_print_inlining_tree) {
     inliner.PrintInlinedInfo(top);
   }
+#if defined(DART_PRECOMPILER)
+  if (Precompiler* precompiler = Precompiler::Instance()) {
+    precompiler->AddInlinedInstructions(inliner.inlined_size());
+  }
+#endif  // defined(DART_PRECOMPILER)
 
   if (inliner.inlined()) {
     flow_graph_->DiscoverBlocks();
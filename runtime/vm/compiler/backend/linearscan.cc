@@ -968,6 +968,7 @@ void FlowGraphAllocator::ConnectIncomingPhiMoves(JoinEntryInstr* join) {
     LiveRange* range = GetLiveRange(vreg);
     range->DefineAt(pos);  // Shorten live range.
     if (is_loop_header) range->mark_loop_phi();
+    if (!is_pair_phi) range->set_phi(phi);
 
     if (is_pair_phi) {
       LiveRange* second_range = GetLiveRange(phi->vreg(1));
@@ -2034,6 +2035,14 @@ void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
   intptr_t idx = register_kind_ == Location::kRegister
                      ? flow_graph_.graph_entry()->fixed_slot_count()
                      : 0;
+  const intptr_t phi_input_idx =
+      need_quad ? -1 : FindPhiInputSpillSlot(range, start, need_untagged);
+  if (phi_input_idx >= 0) {
+    TRACE_ALLOC(THR_Print("coalescing spill slot %" Pd " of v%" Pd
+                          " with a phi input\n",
+                          phi_input_idx, range->vreg()));
+    idx = phi_input_idx;
+  }
   for (; idx < spill_slots_.length(); idx++) {
     if ((need_quad == quad_spill_slots_[idx]) &&
         (need_untagged == untagged_spill_slots_[idx]) &&
@@ -2064,6 +2073,7 @@ void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
 
   // Set spill slot expiration boundary to the live range's end.
   spill_slots_[idx] = end;
+  range->set_spill_slot_index(idx);
   if (need_quad) {
     ASSERT(quad_spill_slots_[idx] && quad_spill_slots_[idx + 1]);
     idx++;  // Use the higher index it corresponds to the lower stack address.
@@ -2103,6 +2113,27 @@ void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
   spilled_.Add(range);
 }
 
+intptr_t FlowGraphAllocator::FindPhiInputSpillSlot(LiveRange* range,
+                                                   intptr_t start,
+                                                   bool need_untagged) {
+  PhiInstr* phi = range->phi();
+  if (phi == nullptr) return -1;
+  for (intptr_t i = 0; i < phi->InputCount(); i++) {
+    Definition* input = phi->InputAt(i)->definition();
+    if (input->IsConstant() || !input->HasSSATemp()) continue;
+    // Initial definitions do not get their spill slot from
+    // AllocateSpillSlotFor() and have no spill slot index.
+    const intptr_t idx = GetLiveRange(input->vreg(0))->spill_slot_index();
+    if ((idx >= 0) && (idx < spill_slots_.length()) &&
+        !quad_spill_slots_[idx] &&
+        (need_untagged == untagged_spill_slots_[idx]) &&
+        (spill_slots_[idx] <= start)) {
+      return idx;
+    }
+  }
+  return -1;
+}
+
 void FlowGraphAllocator::MarkAsObjectAtSafepoints(LiveRange* range) {
   Location spill_slot = range->spill_slot();
   intptr_t stack_index = spill_slot.stack_index();
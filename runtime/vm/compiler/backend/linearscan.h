@@ -244,6 +244,14 @@ class FlowGraphAllocator : public ValueObject {
   // Find a spill slot that can be used by the given live range.
   void AllocateSpillSlotFor(LiveRange* range);
 
+  // Returns the index of a spill slot of an input of the phi defining
+  // [range] which is free at [start], or -1. Sharing it turns the phi
+  // resolution move on that edge into a no-op instead of a memory to
+  // memory move.
+  intptr_t FindPhiInputSpillSlot(LiveRange* range,
+                                 intptr_t start,
+                                 bool need_untagged);
+
   // Allocate spill slot for synthetic :suspend_state variable.
   void AllocateSpillSlotForSuspendState();
 
@@ -522,6 +530,8 @@ class LiveRange : public ZoneAllocated {
         next_sibling_(nullptr),
         has_only_any_uses_in_loops_(0),
         is_loop_phi_(false),
+        spill_slot_index_(-1),
+        phi_(nullptr),
         finger_() {}
 
   intptr_t vreg() const { return vreg_; }
@@ -588,6 +598,14 @@ class LiveRange : public ZoneAllocated {
   bool is_loop_phi() const { return is_loop_phi_; }
   void mark_loop_phi() { is_loop_phi_ = true; }
 
+  // Index of the spill slot assigned by AllocateSpillSlotFor() or -1.
+  intptr_t spill_slot_index() const { return spill_slot_index_; }
+  void set_spill_slot_index(intptr_t index) { spill_slot_index_ = index; }
+
+  // The phi defining this range, if any.
+  PhiInstr* phi() const { return phi_; }
+  void set_phi(PhiInstr* phi) { phi_ = phi; }
+
  private:
   LiveRange(intptr_t vreg,
             Representation rep,
@@ -607,6 +625,8 @@ class LiveRange : public ZoneAllocated {
         next_sibling_(next_sibling),
         has_only_any_uses_in_loops_(0),
         is_loop_phi_(false),
+        spill_slot_index_(-1),
+        phi_(nullptr),
         finger_() {}
 
   const intptr_t vreg_;
@@ -626,6 +646,8 @@ class LiveRange : public ZoneAllocated {
   static constexpr intptr_t kMaxLoops = sizeof(uint64_t) * kBitsPerByte;
   uint64_t has_only_any_uses_in_loops_;
   bool is_loop_phi_;
+  intptr_t spill_slot_index_;
+  PhiInstr* phi_;
 
   AllocationFinger finger_;
 
@@ -0,0 +1,414 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_unroller.h"
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/counted_loop.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool, loop_unrolling, false, "Partially unroll small loops.");
+DEFINE_FLAG(int,
+            loop_unroll_factor,
+            4,
+            "Number of iterations performed by each trip of an unrolled "
+            "loop.");
+DEFINE_FLAG(int,
+            loop_unroll_max_body_size,
+            16,
+            "Maximum number of instructions in the body of an unrolled loop.");
+DEFINE_FLAG(int,
+            loop_unroll_budget,
+            128,
+            "Maximum number of instructions added to a function by loop "
+            "unrolling when compiling AOT.");
+DEFINE_FLAG(bool,
+            loop_strength_reduction,
+            false,
+            "Replace multiplications of loop inductions by additions.");
+DEFINE_FLAG(bool, trace_loop_unrolling, false, "Trace loop unrolling.");
+
+static ConstantInstr* Int64Constant(FlowGraph* flow_graph, int64_t value) {
+  return flow_graph->GetConstant(
+      Integer::ZoneHandle(flow_graph->zone(), Integer::NewCanonical(value)),
+      kUnboxedInt64);
+}
+
+// A counted loop whose body can be copied.
+class UnrollableLoop : public ZoneAllocated {
+ public:
+  UnrollableLoop(FlowGraph* flow_graph, CountedLoop* loop)
+      : flow_graph_(flow_graph),
+        zone_(flow_graph->zone()),
+        loop_(loop),
+        body_(loop->body()),
+        lengths_(zone_, 2),
+        map_(zone_, 8) {}
+
+  // Returns true if the body of the loop can be copied.
+  bool Match();
+
+  // Builds the unrolled loop in front of the original loop.
+  void Unroll(intptr_t factor);
+
+  // Number of instructions in one copy of the body.
+  intptr_t size() const { return size_; }
+
+  CountedLoop* loop() const { return loop_; }
+
+ private:
+  struct CheckedLength {
+    Definition* length;
+    int64_t max_offset;
+  };
+
+  bool IsInvariant(Definition* def) const { return loop_->IsInvariant(def); }
+  bool MatchCheck(CheckBoundBase* check);
+
+  Definition* Copy(Instruction* instr);
+  Definition* CopyOf(Definition* def);
+  Value* CopyOf(Value* value) {
+    return new (zone_) Value(CopyOf(value->definition()));
+  }
+  void Map(Definition* def, Definition* copy) { map_.Add({def, copy}); }
+
+  FlowGraph* const flow_graph_;
+  Zone* const zone_;
+  CountedLoop* const loop_;
+  BlockEntryInstr* const body_;
+  intptr_t size_ = 0;
+
+  // Invariant lengths of the bounds checks of the body, along with the
+  // largest offset i + c of the indices checked against them.
+  GrowableArray<CheckedLength> lengths_;
+  // Definitions of the body and their counterparts in the current copy.
+  GrowableArray<std::pair<Definition*, Definition*>> map_;
+};
+
+bool UnrollableLoop::MatchCheck(CheckBoundBase* check) {
+  Definition* length = check->length()->definition();
+  if (!IsInvariant(length) || (length->representation() != kUnboxedInt64 &&
+                               (length->representation() != kTagged ||
+                                length->Type()->ToCid() != kSmiCid))) {
+    return false;
+  }
+
+  // The index must be i + c and never negative, so that it is in range for
+  // the whole trip once the last index of the trip is.
+  LoopInfo* loop = loop_->loop();
+  Definition* checked_index = check->index()->definition();
+  InductionVar* index = loop->LookupInduction(
+      checked_index->OriginalDefinitionIgnoreBoxingAndConstraints());
+  int64_t offset = 0;
+  int64_t initial = 0;
+  if (index == nullptr ||
+      !loop->LookupInduction(loop_->phi())
+           ->CanComputeDifferenceWith(index, &offset) ||
+      !Utils::IsInt(32, offset) ||
+      !InductionVar::IsConstant(index->initial(), &initial) || initial < 0) {
+    return false;
+  }
+
+  for (CheckedLength& checked : lengths_) {
+    if (checked.length == length) {
+      checked.max_offset = Utils::Maximum(checked.max_offset, offset);
+      return true;
+    }
+  }
+  lengths_.Add({length, offset});
+  return true;
+}
+
+bool UnrollableLoop::Match() {
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current == loop_->next() || current->IsGoto()) continue;
+    if (Definition* def = current->AsDefinition()) {
+      // The copies of the body redefine its results, so these must not be
+      // used after the loop.
+      if (def->env_use_list() != nullptr) return false;
+      for (Value* use = def->input_use_list(); use != nullptr;
+           use = use->next_use()) {
+        if (use->instruction()->GetBlock() != body_) return false;
+      }
+    }
+    if (CheckBoundBase* check = current->AsCheckBoundBase()) {
+      if (!MatchCheck(check)) return false;
+      continue;
+    }
+    if (current->CanDeoptimize()) return false;
+    if (!current->IsLoadUntagged() && !current->IsBoxInt64() &&
+        !current->IsBinaryInt64Op() && !current->IsBinaryDoubleOp() &&
+        !current->IsLoadIndexed() && !current->IsStoreIndexed()) {
+      return false;
+    }
+    size_++;
+  }
+  return size_ > 0 && size_ <= FLAG_loop_unroll_max_body_size;
+}
+
+Definition* UnrollableLoop::CopyOf(Definition* def) {
+  for (const auto& entry : map_) {
+    if (entry.first == def) return entry.second;
+  }
+  ASSERT(IsInvariant(def));
+  return def;
+}
+
+Definition* UnrollableLoop::Copy(Instruction* instr) {
+  if (LoadUntaggedInstr* load = instr->AsLoadUntagged()) {
+    return new (zone_)
+        LoadUntaggedInstr(CopyOf(load->object()), load->offset());
+  } else if (BoxInt64Instr* box = instr->AsBoxInt64()) {
+    return new (zone_) BoxInt64Instr(CopyOf(box->value()));
+  } else if (BinaryInt64OpInstr* op = instr->AsBinaryInt64Op()) {
+    return new (zone_) BinaryInt64OpInstr(
+        op->op_kind(), CopyOf(op->left()), CopyOf(op->right()), DeoptId::kNone,
+        op->SpeculativeModeOfInputs());
+  } else if (BinaryDoubleOpInstr* op = instr->AsBinaryDoubleOp()) {
+    return new (zone_) BinaryDoubleOpInstr(
+        op->op_kind(), CopyOf(op->left()), CopyOf(op->right()), DeoptId::kNone,
+        op->source(), op->SpeculativeModeOfInputs());
+  } else if (LoadIndexedInstr* load = instr->AsLoadIndexed()) {
+    return new (zone_) LoadIndexedInstr(
+        CopyOf(load->array()), CopyOf(load->index()), load->index_unboxed(),
+        load->index_scale(), load->class_id(),
+        load->aligned() ? kAlignedAccess : kUnalignedAccess, DeoptId::kNone,
+        load->source());
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
+void UnrollableLoop::Unroll(intptr_t factor) {
+  // Hoist the bounds checks out of the unrolled loop: every index i + c
+  // of the trip is in range if fi + factor - 1 < length - max(c).
+  for (const CheckedLength& checked : lengths_) {
+    Definition* limit = checked.length;
+    if (limit->representation() != kUnboxedInt64) {
+      limit = loop_->AddToPreHeader(
+          UnboxInstr::Create(kUnboxedInt64, new (zone_) Value(limit),
+                             DeoptId::kNone, Instruction::kNotSpeculative));
+    }
+    if (checked.max_offset != 0) {
+      limit = loop_->AddToPreHeader(new (zone_) BinaryInt64OpInstr(
+          Token::kSUB, new (zone_) Value(limit),
+          new (zone_) Value(Int64Constant(flow_graph_, checked.max_offset)),
+          DeoptId::kNone, Instruction::kNotSpeculative));
+    }
+    loop_->AddLimit(limit);
+  }
+
+  TargetEntryInstr* unrolled_body = loop_->BuildFastLoop(factor);
+  Instruction* last = unrolled_body;
+  for (intptr_t k = 0; k < factor; k++) {
+    map_.Clear();
+    Definition* index = loop_->fast_phi();
+    if (k > 0) {
+      index = new (zone_) BinaryInt64OpInstr(
+          Token::kADD, new (zone_) Value(index),
+          new (zone_) Value(Int64Constant(flow_graph_, k)), DeoptId::kNone,
+          Instruction::kNotSpeculative);
+      last = flow_graph_->AppendTo(last, index, nullptr, FlowGraph::kValue);
+    }
+    Map(loop_->phi(), index);
+
+    for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      if (current == loop_->next() || current->IsGoto()) continue;
+      if (CheckBoundBase* check = current->AsCheckBoundBase()) {
+        Map(check, CopyOf(check->index()->definition()));
+      } else if (StoreIndexedInstr* store = current->AsStoreIndexed()) {
+        auto copy = new (zone_) StoreIndexedInstr(
+            CopyOf(store->array()), CopyOf(store->index()),
+            CopyOf(store->value()),
+            store->ShouldEmitStoreBarrier() ? kEmitStoreBarrier
+                                            : kNoStoreBarrier,
+            store->index_unboxed(), store->index_scale(), store->class_id(),
+            store->aligned() ? kAlignedAccess : kUnalignedAccess,
+            DeoptId::kNone, store->source(), store->SpeculativeModeOfInputs());
+        last = flow_graph_->AppendTo(last, copy, nullptr, FlowGraph::kEffect);
+      } else {
+        Definition* copy = Copy(current);
+        last = flow_graph_->AppendTo(last, copy, nullptr, FlowGraph::kValue);
+        Map(current->AsDefinition(), copy);
+      }
+    }
+  }
+  loop_->FinishFastLoop(last);
+}
+
+// Materializes the loop invariant [x] at the end of [block].
+static Definition* MaterializeInvariant(FlowGraph* flow_graph,
+                                        BlockEntryInstr* block,
+                                        InductionVar* x) {
+  Zone* zone = flow_graph->zone();
+  if (x->mult() == 0) {
+    return Int64Constant(flow_graph, x->offset());
+  }
+  Definition* result = x->def();
+  auto emit = [&](Token::Kind op_kind, int64_t value) {
+    result = new (zone) BinaryInt64OpInstr(
+        op_kind, new (zone) Value(result),
+        new (zone) Value(Int64Constant(flow_graph, value)), DeoptId::kNone,
+        Instruction::kNotSpeculative);
+    flow_graph->InsertBefore(block->last_instruction(), result, nullptr,
+                             FlowGraph::kValue);
+  };
+  if (x->mult() != 1) emit(Token::kMUL, x->mult());
+  if (x->offset() != 0) emit(Token::kADD, x->offset());
+  return result;
+}
+
+static bool CanMaterializeInvariant(InductionVar* x) {
+  return x->mult() == 0 || x->def()->representation() == kUnboxedInt64;
+}
+
+// Replaces each multiplication in [loop] which is a linear induction
+// a + b * k in the k-th iteration by a header phi p = phi(a, p + b).
+static intptr_t StrengthReduce(FlowGraph* flow_graph, LoopInfo* loop) {
+  JoinEntryInstr* header = loop->header()->AsJoinEntry();
+  if (header == nullptr || loop->back_edges().length() != 1 ||
+      header->PredecessorCount() != 2) {
+    return 0;
+  }
+  BlockEntryInstr* back_edge = loop->back_edges()[0];
+  BlockEntryInstr* pre_header = header->PredecessorAt(0) == back_edge
+                                    ? header->PredecessorAt(1)
+                                    : header->PredecessorAt(0);
+  if (!pre_header->last_instruction()->IsGoto() ||
+      !back_edge->last_instruction()->IsGoto()) {
+    return 0;
+  }
+
+  Zone* zone = flow_graph->zone();
+  intptr_t reduced = 0;
+  for (BitVector::Iterator block_it(loop->blocks()); !block_it.Done();
+       block_it.Advance()) {
+    BlockEntryInstr* block = flow_graph->preorder()[block_it.Current()];
+    if (block->loop_info() != loop) continue;  // Inner loop.
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      BinaryInt64OpInstr* mul = it.Current()->AsBinaryInt64Op();
+      if (mul == nullptr || mul->op_kind() != Token::kMUL) continue;
+      InductionVar* induc = loop->LookupInduction(mul);
+      if (!InductionVar::IsLinear(induc) ||
+          !CanMaterializeInvariant(induc->initial()) ||
+          !CanMaterializeInvariant(induc->next())) {
+        continue;
+      }
+      // The phi holds the value of the current iteration, which differs
+      // from the last value of the multiplication after the loop.
+      bool used_outside = false;
+      for (Value::Iterator use_it(mul->input_use_list()); !use_it.Done();
+           use_it.Advance()) {
+        if (!loop->Contains(use_it.Current()->instruction()->GetBlock())) {
+          used_outside = true;
+        }
+      }
+      for (Value::Iterator use_it(mul->env_use_list()); !use_it.Done();
+           use_it.Advance()) {
+        if (!loop->Contains(use_it.Current()->instruction()->GetBlock())) {
+          used_outside = true;
+        }
+      }
+      if (used_outside) continue;
+
+      Definition* initial =
+          MaterializeInvariant(flow_graph, pre_header, induc->initial());
+      Definition* stride =
+          MaterializeInvariant(flow_graph, pre_header, induc->next());
+      PhiInstr* phi = new (zone) PhiInstr(header, 2);
+      flow_graph->AllocateSSAIndex(phi);
+      phi->mark_alive();
+      phi->set_representation(kUnboxedInt64);
+      header->InsertPhi(phi);
+      auto next = new (zone) BinaryInt64OpInstr(
+          Token::kADD, new (zone) Value(phi), new (zone) Value(stride),
+          DeoptId::kNone, Instruction::kNotSpeculative);
+      flow_graph->InsertBefore(back_edge->last_instruction(), next, nullptr,
+                               FlowGraph::kValue);
+      Value* input = new (zone) Value(initial);
+      phi->SetInputAt(header->IndexOfPredecessor(pre_header), input);
+      initial->AddInputUse(input);
+      input = new (zone) Value(next);
+      phi->SetInputAt(header->IndexOfPredecessor(back_edge), input);
+      next->AddInputUse(input);
+
+      mul->ReplaceUsesWith(phi);
+      it.RemoveCurrentFromGraph();
+      reduced++;
+    }
+  }
+  return reduced;
+}
+
+void LoopUnroller::Optimize(FlowGraph* flow_graph) {
+  if (FLAG_loop_unrolling && FLAG_loop_unroll_factor > 1) {
+    const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+    loop_hierarchy.ComputeInduction();
+
+    // Each unrolled loop grows the function by that many copies of its body,
+    // which is limited by a budget in AOT where all code is compiled.
+    const bool is_aot = CompilerState::Current().is_aot();
+    const intptr_t factor = FLAG_loop_unroll_factor;
+    intptr_t budget = FLAG_loop_unroll_budget;
+
+    // Find all candidates before changing the graph, which invalidates the
+    // loop hierarchy.
+    GrowableArray<UnrollableLoop*> loops;
+    for (BlockEntryInstr* header : loop_hierarchy.headers()) {
+      CountedLoop* counted =
+          CountedLoop::Match(flow_graph, header->loop_info());
+      if (counted == nullptr) continue;
+      auto loop = new (flow_graph->zone()) UnrollableLoop(flow_graph, counted);
+      if (!loop->Match()) continue;
+      const intptr_t growth = loop->size() * factor;
+      if (is_aot && growth > budget) continue;
+      budget -= growth;
+      loops.Add(loop);
+    }
+
+    if (!loops.is_empty()) {
+      for (UnrollableLoop* loop : loops) {
+        loop->Unroll(factor);
+        if (FLAG_trace_loop_unrolling) {
+          THR_Print("Unrolled loop B%" Pd " by %" Pd " in %s\n",
+                    loop->loop()->header()->block_id(), factor,
+                    flow_graph->function().ToFullyQualifiedCString());
+        }
+      }
+
+      flow_graph->DiscoverBlocks();
+      GrowableArray<BitVector*> dominance_frontier;
+      flow_graph->ComputeDominators(&dominance_frontier);
+
+      for (UnrollableLoop* loop : loops) {
+        loop->loop()->ConnectPhis();
+      }
+    }
+  }
+
+  if (FLAG_loop_strength_reduction) {
+    const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+    loop_hierarchy.ComputeInduction();
+    for (BlockEntryInstr* header : loop_hierarchy.headers()) {
+      const intptr_t reduced =
+          StrengthReduce(flow_graph, header->loop_info());
+      if (reduced > 0 && FLAG_trace_loop_unrolling) {
+        THR_Print("Strength reduced %" Pd " multiplications in loop B%" Pd
+                  " in %s\n",
+                  reduced, header->block_id(),
+                  flow_graph->function().ToFullyQualifiedCString());
+      }
+    }
+  }
+}
+
+}  // namespace dart
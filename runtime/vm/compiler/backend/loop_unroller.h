@@ -0,0 +1,37 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLER_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+
+// Partially unrolls small counted loops (see CountedLoop) and strength
+// reduces multiplications by linear inductions.
+//
+// An unrolled loop performs --loop_unroll_factor iterations of the body
+// per trip and is left for the original loop once fewer iterations remain.
+// Bounds checks of the body on indices i + c are replaced by one test of
+// the last index of the trip against the length, so that the original
+// loop still throws (or deoptimizes) at the exact failing iteration.
+//
+// Strength reduction replaces each loop variant i * c by a new header phi
+// advanced by the stride of i * c. The result is also applied to the
+// unrolled loops, whose copies of the body index with i + k.
+class LoopUnroller : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_UNROLLER_H_
@@ -0,0 +1,282 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include "vm/compiler/backend/counted_loop.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_vectorization,
+            false,
+            "Vectorize simple loops over Float64List with Float64x2 "
+            "operations.");
+DEFINE_FLAG(bool,
+            trace_loop_vectorization,
+            false,
+            "Trace loop vectorization.");
+
+// Number of elements processed by one iteration of a vector loop.
+static constexpr intptr_t kVectorLanes = 2;
+
+// Size in bytes of a Float64List element.
+static constexpr intptr_t kElementSize = 8;
+
+// A counted loop whose body can be widened to Float64x2 operations.
+class VectorizableLoop : public ZoneAllocated {
+ public:
+  VectorizableLoop(FlowGraph* flow_graph, CountedLoop* loop)
+      : flow_graph_(flow_graph),
+        zone_(flow_graph->zone()),
+        loop_(loop),
+        body_(loop->body()),
+        phi_(loop->phi()),
+        map_(zone_, 4),
+        splats_(zone_, 2),
+        bases_(zone_, 2) {}
+
+  // Returns true if the body of the loop can be vectorized.
+  bool Match();
+
+  // Builds the vector loop in front of the original loop.
+  void Vectorize();
+
+  CountedLoop* loop() const { return loop_; }
+
+ private:
+  bool IsInvariant(Definition* def) const { return loop_->IsInvariant(def); }
+  bool IsIndex(Value* index) const;
+  bool IsDoubleOperand(Value* value) const;
+  bool AddBase(Value* array);
+
+  // Returns the vector loop counterpart of [value].
+  Definition* VectorOf(Value* value);
+  Definition* Splat(Definition* scalar);
+
+  FlowGraph* const flow_graph_;
+  Zone* const zone_;
+  CountedLoop* const loop_;
+  BlockEntryInstr* const body_;
+  PhiInstr* const phi_;
+
+  // Scalar definitions of the body and their vector counterparts.
+  GrowableArray<std::pair<Definition*, Definition*>> map_;
+  // Loop invariant doubles and their splats in the pre-header.
+  GrowableArray<std::pair<Definition*, Definition*>> splats_;
+  // Distinct typed data objects accessed by the loop.
+  GrowableArray<Definition*> bases_;
+};
+
+bool VectorizableLoop::IsIndex(Value* index) const {
+  Definition* def = index->definition();
+  if (def == phi_) return true;
+  BoxInt64Instr* box = def->AsBoxInt64();
+  return box != nullptr && box->value()->definition() == phi_;
+}
+
+bool VectorizableLoop::IsDoubleOperand(Value* value) const {
+  Definition* def = value->definition();
+  if (def->GetBlock() == body_) {
+    return def->IsLoadIndexed() || def->IsBinaryDoubleOp();
+  }
+  return IsInvariant(def) && def->representation() == kUnboxedDouble;
+}
+
+bool VectorizableLoop::AddBase(Value* array) {
+  Definition* base = array->definition();
+  if (LoadUntaggedInstr* load = base->AsLoadUntagged()) {
+    if (load->GetBlock() != body_) return false;
+    base = load->object()->definition();
+  } else if (!IsInvariant(base)) {
+    return false;
+  }
+  if (!bases_.Contains(base)) {
+    bases_.Add(base);
+  }
+  return true;
+}
+
+bool VectorizableLoop::Match() {
+  intptr_t stores = 0;
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (current == loop_->next() || current->IsGoto()) continue;
+    if (current->CanDeoptimize()) return false;
+
+    if (Definition* def = current->AsDefinition()) {
+      // The results of the body are only used inside the body, so that the
+      // remaining scalar iterations can recompute them.
+      if (def->env_use_list() != nullptr) return false;
+      for (Value* use = def->input_use_list(); use != nullptr;
+           use = use->next_use()) {
+        if (use->instruction()->GetBlock() != body_) return false;
+      }
+    }
+
+    if (LoadUntaggedInstr* load = current->AsLoadUntagged()) {
+      if (load->offset() != compiler::target::PointerBase::data_offset() ||
+          !IsInvariant(load->object()->definition())) {
+        return false;
+      }
+    } else if (BoxInt64Instr* box = current->AsBoxInt64()) {
+      if (box->value()->definition() != phi_) return false;
+    } else if (LoadIndexedInstr* load = current->AsLoadIndexed()) {
+      if (load->class_id() != kTypedDataFloat64ArrayCid ||
+          load->index_scale() != kElementSize || !load->aligned() ||
+          !IsIndex(load->index()) || !AddBase(load->array())) {
+        return false;
+      }
+    } else if (StoreIndexedInstr* store = current->AsStoreIndexed()) {
+      if (store->class_id() != kTypedDataFloat64ArrayCid ||
+          store->index_scale() != kElementSize || !store->aligned() ||
+          !IsIndex(store->index()) || !AddBase(store->array()) ||
+          !IsDoubleOperand(store->value())) {
+        return false;
+      }
+      stores++;
+    } else if (BinaryDoubleOpInstr* op = current->AsBinaryDoubleOp()) {
+      switch (op->op_kind()) {
+        case Token::kADD:
+        case Token::kSUB:
+        case Token::kMUL:
+        case Token::kDIV:
+          break;
+        default:
+          return false;
+      }
+      if (!IsDoubleOperand(op->left()) || !IsDoubleOperand(op->right())) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  if (stores == 0) return false;
+
+  // Every lane only accesses its own index, so a single array may be both
+  // loaded and stored. Distinct arrays must not overlap, which only holds
+  // for internal typed data: views and external typed data can share their
+  // backing store.
+  if (bases_.length() > 1) {
+    for (Definition* base : bases_) {
+      if (base->Type()->ToCid() != kTypedDataFloat64ArrayCid) return false;
+    }
+  }
+  return true;
+}
+
+Definition* VectorizableLoop::VectorOf(Value* value) {
+  Definition* def = value->definition();
+  for (const auto& entry : map_) {
+    if (entry.first == def) return entry.second;
+  }
+  if (def->representation() == kUnboxedDouble) {
+    return Splat(def);
+  }
+  ASSERT(IsInvariant(def));
+  return def;
+}
+
+Definition* VectorizableLoop::Splat(Definition* scalar) {
+  for (const auto& entry : splats_) {
+    if (entry.first == scalar) return entry.second;
+  }
+  Definition* splat = loop_->AddToPreHeader(
+      SimdOpInstr::Create(MethodRecognizer::kFloat64x2Splat,
+                          new (zone_) Value(scalar), DeoptId::kNone));
+  splats_.Add({scalar, splat});
+  return splat;
+}
+
+void VectorizableLoop::Vectorize() {
+  TargetEntryInstr* vector_body = loop_->BuildFastLoop(kVectorLanes);
+  PhiInstr* vector_phi = loop_->fast_phi();
+
+  // Widen each element access of the body to two lanes.
+  Instruction* last = vector_body;
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    Definition* vector = nullptr;
+    if (LoadUntaggedInstr* load = current->AsLoadUntagged()) {
+      vector = new (zone_) LoadUntaggedInstr(
+          new (zone_) Value(load->object()->definition()), load->offset());
+    } else if (LoadIndexedInstr* load = current->AsLoadIndexed()) {
+      vector = new (zone_) LoadIndexedInstr(
+          new (zone_) Value(VectorOf(load->array())),
+          new (zone_) Value(vector_phi), /*index_unboxed=*/true, kElementSize,
+          kTypedDataFloat64x2ArrayCid, kAlignedAccess, DeoptId::kNone,
+          load->source());
+    } else if (BinaryDoubleOpInstr* op = current->AsBinaryDoubleOp()) {
+      vector = SimdOpInstr::Create(
+          SimdOpInstr::KindForOperator(kFloat64x2Cid, op->op_kind()),
+          new (zone_) Value(VectorOf(op->left())),
+          new (zone_) Value(VectorOf(op->right())), DeoptId::kNone);
+    } else if (StoreIndexedInstr* store = current->AsStoreIndexed()) {
+      auto vector_store = new (zone_) StoreIndexedInstr(
+          new (zone_) Value(VectorOf(store->array())),
+          new (zone_) Value(vector_phi),
+          new (zone_) Value(VectorOf(store->value())), kNoStoreBarrier,
+          /*index_unboxed=*/true, kElementSize, kTypedDataFloat64x2ArrayCid,
+          kAlignedAccess, DeoptId::kNone, store->source(),
+          Instruction::kNotSpeculative);
+      last = flow_graph_->AppendTo(last, vector_store, nullptr,
+                                   FlowGraph::kEffect);
+    }
+    if (vector != nullptr) {
+      last = flow_graph_->AppendTo(last, vector, nullptr, FlowGraph::kValue);
+      map_.Add({current->AsDefinition(), vector});
+    }
+  }
+  loop_->FinishFastLoop(last);
+}
+
+void LoopVectorizer::Optimize(FlowGraph* flow_graph) {
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+  if (!FLAG_loop_vectorization ||
+      !FlowGraphCompiler::SupportsUnboxedSimd128()) {
+    return;
+  }
+
+  const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+  loop_hierarchy.ComputeInduction();
+
+  // Find all candidates before changing the graph, which invalidates the
+  // loop hierarchy.
+  GrowableArray<VectorizableLoop*> loops;
+  for (BlockEntryInstr* header : loop_hierarchy.headers()) {
+    CountedLoop* counted = CountedLoop::Match(flow_graph, header->loop_info());
+    if (counted == nullptr) continue;
+    auto loop = new (flow_graph->zone()) VectorizableLoop(flow_graph, counted);
+    if (loop->Match()) {
+      loops.Add(loop);
+    }
+  }
+  if (loops.is_empty()) return;
+
+  for (VectorizableLoop* loop : loops) {
+    loop->Vectorize();
+    if (FLAG_trace_loop_vectorization) {
+      THR_Print("Vectorized loop B%" Pd " in %s\n",
+                loop->loop()->header()->block_id(),
+                flow_graph->function().ToFullyQualifiedCString());
+    }
+  }
+
+  flow_graph->DiscoverBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph->ComputeDominators(&dominance_frontier);
+
+  for (VectorizableLoop* loop : loops) {
+    loop->loop()->ConnectPhis();
+  }
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+}
+
+}  // namespace dart
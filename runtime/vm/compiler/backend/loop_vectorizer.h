@@ -0,0 +1,48 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+
+// Widens simple counted loops over Float64List into Float64x2 operations.
+//
+// A loop is vectorized when its body is a single block which only loads
+// elements a[i], combines them with +, -, * and / (possibly with loop
+// invariant doubles), and stores the results to b[i], where i is a unit
+// stride induction variable bounded by a loop invariant. The loop
+//
+//   P: goto H
+//   H: i = phi(i0, i + 1); if (i < n) goto B else goto E
+//   B: ...; goto H
+//
+// is preceded by a vector loop processing two elements per iteration
+//
+//   P: goto VH
+//   VH: vi = phi(i0, vi + 2); if (vi + 1 < n) goto VB else goto VX
+//   VB: ...; goto VH
+//   VX: goto H
+//   H: i = phi(vi, i + 1); ...
+//
+// which leaves at most one remaining element to the original loop.
+//
+// Bounds checks are not widened, so only loops from which range analysis
+// removed them qualify.
+class LoopVectorizer : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
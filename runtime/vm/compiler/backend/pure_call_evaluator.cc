@@ -0,0 +1,453 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/pure_call_evaluator.h"
+
+#include "vm/compiler/backend/evaluator.h"
+#include "vm/compiler/backend/inliner.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/compiler/frontend/kernel_to_il.h"
+#include "vm/compiler/jit/compiler.h"
+#include "vm/flags.h"
+#include "vm/longjump.h"
+#include "vm/object.h"
+#include "vm/parser.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            evaluate_pure_calls,
+            true,
+            "Evaluate calls to pure functions with constant arguments at "
+            "compile time in AOT.");
+DEFINE_FLAG(int,
+            pure_call_evaluation_budget,
+            10000,
+            "Maximum number of instructions executed when evaluating a call "
+            "to a pure function at compile time.");
+
+// Maximum depth of nested calls when evaluating a call.
+static constexpr intptr_t kMaxCallDepth = 16;
+
+struct PureCallEvaluator::PureFunction : public ZoneAllocated {
+  PureFunction(ParsedFunction* parsed_function, FlowGraph* graph)
+      : parsed_function(parsed_function), graph(graph) {}
+
+  ParsedFunction* parsed_function;
+  FlowGraph* graph;
+  // Definitions are numbered with pass specific ids.
+  intptr_t definition_count = 0;
+  GrowableArray<LocalVariable*> locals;
+  // The index into [locals] accessed by each LoadLocal and StoreLocal, by
+  // definition id.
+  GrowableArray<intptr_t> local_indices;
+
+  intptr_t IndexOf(const LocalVariable* local) const {
+    for (intptr_t i = 0; i < locals.length(); ++i) {
+      if (locals[i] == local) return i;
+    }
+    return -1;
+  }
+};
+
+PureCallEvaluator::PureCallEvaluator(Thread* thread)
+    : thread_(thread), zone_(thread->zone()) {}
+
+bool PureCallEvaluator::IsCandidate(const Function& function) {
+  return function.IsRegularFunction() && function.is_static() &&
+         !function.IsGeneric() && !function.HasOptionalParameters() &&
+         !function.IsSuspendableFunction() && !function.is_native() &&
+         !function.is_external() && !function.IsRecognized() &&
+         !FlowGraphInliner::FunctionHasNeverInlinePragma(function);
+}
+
+static bool IsIntegerOperator(Token::Kind kind, intptr_t argument_count) {
+  if (argument_count == 1) {
+    return (kind == Token::kNEGATE) || (kind == Token::kBIT_NOT);
+  }
+  if (argument_count != 2) {
+    return false;
+  }
+  switch (kind) {
+    case Token::kADD:
+    case Token::kSUB:
+    case Token::kMUL:
+    case Token::kTRUNCDIV:
+    case Token::kMOD:
+    case Token::kSHL:
+    case Token::kSHR:
+    case Token::kUSHR:
+    case Token::kBIT_AND:
+    case Token::kBIT_OR:
+    case Token::kBIT_XOR:
+    case Token::kEQ:
+    case Token::kLT:
+    case Token::kGT:
+    case Token::kLTE:
+    case Token::kGTE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether [instr] can be interpreted without observable side effects.
+static bool IsPureInstruction(Instruction* instr) {
+  switch (instr->tag()) {
+    case Instruction::kConstant:
+    case Instruction::kMakeTemp:
+    case Instruction::kDropTemps:
+    case Instruction::kCheckStackOverflow:
+    case Instruction::kAssertBoolean:
+    case Instruction::kBooleanNegate:
+    case Instruction::kStrictCompare:
+    case Instruction::kGoto:
+    case Instruction::kReturn:
+      return true;
+    case Instruction::kLoadLocal:
+      return !instr->AsLoadLocal()->local().is_captured();
+    case Instruction::kStoreLocal:
+      return !instr->AsStoreLocal()->local().is_captured();
+    case Instruction::kBranch:
+      return instr->AsBranch()->comparison()->IsStrictCompare();
+    case Instruction::kInstanceCall: {
+      InstanceCallInstr* call = instr->AsInstanceCall();
+      return (call->FirstArgIndex() == 0) &&
+             IsIntegerOperator(call->token_kind(), call->ArgumentCount());
+    }
+    case Instruction::kStaticCall: {
+      StaticCallInstr* call = instr->AsStaticCall();
+      return (call->FirstArgIndex() == 0) &&
+             PureCallEvaluator::IsCandidate(call->function());
+    }
+    default:
+      return false;
+  }
+}
+
+PureCallEvaluator::PureFunction* PureCallEvaluator::GetPureFunction(
+    const Function& function) {
+  for (intptr_t i = 0; i < functions_.length(); ++i) {
+    if (functions_[i]->ptr() == function.ptr()) {
+      return pure_functions_[i];
+    }
+  }
+  PureFunction* pure_function = BuildPureFunction(function);
+  functions_.Add(&Function::ZoneHandle(zone_, function.ptr()));
+  pure_functions_.Add(pure_function);
+  return pure_function;
+}
+
+PureCallEvaluator::PureFunction* PureCallEvaluator::BuildPureFunction(
+    const Function& function) {
+  ParsedFunction* parsed_function = new (zone_)
+      ParsedFunction(thread_, Function::ZoneHandle(zone_, function.ptr()));
+  FlowGraph* graph = nullptr;
+  {
+    DeoptIdScope deopt_id_scope(thread_, 0);
+    LongJumpScope jump;
+    if (setjmp(*jump.Set()) == 0) {
+      ZoneGrowableArray<const ICData*>* ic_data_array =
+          new (zone_) ZoneGrowableArray<const ICData*>();
+      function.RestoreICDataMap(ic_data_array, /*clone_ic_data=*/false);
+      kernel::FlowGraphBuilder builder(
+          parsed_function, ic_data_array, /*context_level_array=*/nullptr,
+          /*exit_collector=*/nullptr, /*optimizing=*/true,
+          Compiler::kNoOSRDeoptId);
+      graph = builder.BuildGraph();
+    } else {
+      // Errors are reported when the function itself is compiled.
+      USE(thread_->StealStickyError());
+      return nullptr;
+    }
+  }
+
+  for (Definition* defn : *graph->graph_entry()->initial_definitions()) {
+    if (!defn->IsConstant()) {
+      return nullptr;
+    }
+  }
+
+  PureFunction* pure_function =
+      new (zone_) PureFunction(parsed_function, graph);
+  for (BlockIterator it = graph->reverse_postorder_iterator(); !it.Done();
+       it.Advance()) {
+    BlockEntryInstr* block = it.Current();
+    if (block->IsGraphEntry()) {
+      continue;
+    }
+    if (!block->IsFunctionEntry() && !block->IsTargetEntry() &&
+        !block->IsJoinEntry()) {
+      return nullptr;
+    }
+    for (ForwardInstructionIterator instr_it(block); !instr_it.Done();
+         instr_it.Advance()) {
+      Instruction* current = instr_it.Current();
+      if (!IsPureInstruction(current)) {
+        return nullptr;
+      }
+      Definition* defn = current->AsDefinition();
+      if (defn == nullptr) {
+        continue;
+      }
+      defn->SetPassSpecificId(CompilerPass::kConstantPropagation,
+                              pure_function->definition_count++);
+      const LocalVariable* local = nullptr;
+      if (auto load = defn->AsLoadLocal()) {
+        local = &load->local();
+      } else if (auto store = defn->AsStoreLocal()) {
+        local = &store->local();
+      }
+      intptr_t index = -1;
+      if (local != nullptr) {
+        index = pure_function->IndexOf(local);
+        if (index < 0) {
+          index = pure_function->locals.length();
+          pure_function->locals.Add(const_cast<LocalVariable*>(local));
+        }
+      }
+      pure_function->local_indices.Add(index);
+    }
+  }
+  return pure_function;
+}
+
+bool PureCallEvaluator::Evaluate(StaticCallInstr* call,
+                                 const GrowableArray<const Object*>& arguments,
+                                 Object* result) {
+  if (!FLAG_evaluate_pure_calls || !CompilerState::Current().is_aot()) {
+    return false;
+  }
+  if ((call->FirstArgIndex() != 0) || !IsCandidate(call->function())) {
+    return false;
+  }
+  PureFunction* function = GetPureFunction(call->function());
+  if (function == nullptr) {
+    return false;
+  }
+  steps_ = 0;
+  return Run(function, arguments, /*depth=*/0, result);
+}
+
+bool PureCallEvaluator::Run(PureFunction* function,
+                            const GrowableArray<const Object*>& arguments,
+                            intptr_t depth,
+                            Object* result) {
+  GrowableArray<const Object*> values(function->definition_count);
+  values.FillWith(nullptr, 0, function->definition_count);
+  GrowableArray<const Object*> locals(function->locals.length());
+  locals.FillWith(&Object::null_object(), 0, function->locals.length());
+
+  ParsedFunction* parsed_function = function->parsed_function;
+  for (intptr_t i = 0; i < arguments.length(); ++i) {
+    // The prologue may copy the raw parameter into the parameter variable.
+    for (LocalVariable* parameter : {parsed_function->RawParameterVariable(i),
+                                     parsed_function->ParameterVariable(i)}) {
+      const intptr_t index = function->IndexOf(parameter);
+      if (index >= 0) {
+        locals[index] = arguments[i];
+      }
+    }
+  }
+
+  auto value_of = [&](Value* value) -> const Object* {
+    Definition* defn = value->definition();
+    if (auto constant = defn->AsConstant()) {
+      return &constant->value();
+    }
+    const Object* result =
+        values[defn->GetPassSpecificId(CompilerPass::kConstantPropagation)];
+    ASSERT(result != nullptr);
+    return result;
+  };
+
+  Instruction* current = function->graph->graph_entry()->normal_entry();
+  while (true) {
+    if (++steps_ > FLAG_pure_call_evaluation_budget) {
+      return false;
+    }
+    const Object* value = nullptr;
+    switch (current->tag()) {
+      case Instruction::kFunctionEntry:
+      case Instruction::kTargetEntry:
+      case Instruction::kJoinEntry:
+      case Instruction::kCheckStackOverflow:
+        break;
+      case Instruction::kConstant:
+        value = &current->AsConstant()->value();
+        break;
+      case Instruction::kMakeTemp:
+        value = &Object::null_object();
+        break;
+      case Instruction::kDropTemps: {
+        Value* input = current->AsDropTemps()->value();
+        value = (input != nullptr) ? value_of(input) : &Object::null_object();
+        break;
+      }
+      case Instruction::kLoadLocal:
+      case Instruction::kStoreLocal: {
+        const intptr_t index =
+            function->local_indices[current->AsDefinition()->GetPassSpecificId(
+                CompilerPass::kConstantPropagation)];
+        if (auto store = current->AsStoreLocal()) {
+          locals[index] = value_of(store->value());
+        }
+        value = locals[index];
+        break;
+      }
+      case Instruction::kAssertBoolean:
+        value = value_of(current->AsAssertBoolean()->value());
+        if (!value->IsBool()) {
+          return false;
+        }
+        break;
+      case Instruction::kBooleanNegate: {
+        const Object* input = value_of(current->AsBooleanNegate()->value());
+        if (!input->IsBool()) {
+          return false;
+        }
+        value = &Bool::Get(!Bool::Cast(*input).value());
+        break;
+      }
+      case Instruction::kStrictCompare: {
+        StrictCompareInstr* compare = current->AsStrictCompare();
+        value = EvaluateComparison(compare, *value_of(compare->left()),
+                                   *value_of(compare->right()));
+        if (value == nullptr) {
+          return false;
+        }
+        break;
+      }
+      case Instruction::kInstanceCall: {
+        InstanceCallInstr* call = current->AsInstanceCall();
+        value = EvaluateOperator(
+            call->token_kind(), *value_of(call->ArgumentValueAt(0)),
+            (call->ArgumentCount() == 2) ? value_of(call->ArgumentValueAt(1))
+                                         : nullptr);
+        if (value == nullptr) {
+          return false;
+        }
+        break;
+      }
+      case Instruction::kStaticCall: {
+        StaticCallInstr* call = current->AsStaticCall();
+        if (depth >= kMaxCallDepth) {
+          return false;
+        }
+        PureFunction* callee = GetPureFunction(call->function());
+        if (callee == nullptr) {
+          return false;
+        }
+        GrowableArray<const Object*> call_arguments(call->ArgumentCount());
+        for (intptr_t i = 0; i < call->ArgumentCount(); ++i) {
+          call_arguments.Add(value_of(call->ArgumentValueAt(i)));
+        }
+        Object& call_result = Object::ZoneHandle(zone_);
+        if (!Run(callee, call_arguments, depth + 1, &call_result)) {
+          return false;
+        }
+        value = &call_result;
+        break;
+      }
+      case Instruction::kGoto:
+        current = current->AsGoto()->successor();
+        continue;
+      case Instruction::kBranch: {
+        BranchInstr* branch = current->AsBranch();
+        ComparisonInstr* comparison = branch->comparison();
+        const Object* condition =
+            EvaluateComparison(comparison, *value_of(comparison->left()),
+                               *value_of(comparison->right()));
+        if (condition == nullptr) {
+          return false;
+        }
+        current = Bool::Cast(*condition).value() ? branch->true_successor()
+                                                 : branch->false_successor();
+        continue;
+      }
+      case Instruction::kReturn:
+        *result = value_of(current->AsReturn()->value())->ptr();
+        return true;
+      default:
+        return false;
+    }
+    if (auto defn = current->AsDefinition()) {
+      ASSERT(value != nullptr);
+      values[defn->GetPassSpecificId(CompilerPass::kConstantPropagation)] =
+          value;
+    }
+    current = current->next();
+  }
+}
+
+const Object* PureCallEvaluator::EvaluateOperator(Token::Kind kind,
+                                                  const Object& left,
+                                                  const Object* right) {
+  if (right == nullptr) {
+    const auto& result = Integer::Handle(
+        zone_,
+        Evaluator::UnaryIntegerEvaluate(left, kind, kUnboxedInt64, thread_));
+    return result.IsNull() ? nullptr
+                           : &Integer::ZoneHandle(zone_, result.ptr());
+  }
+  switch (kind) {
+    case Token::kEQ:
+      if (left.IsInteger() && right->IsInteger()) {
+        return &Bool::Get(Integer::Cast(left).Equals(Integer::Cast(*right)));
+      }
+      if ((left.IsBool() || left.IsNull()) &&
+          (right->IsBool() || right->IsNull())) {
+        return &Bool::Get(left.ptr() == right->ptr());
+      }
+      return nullptr;
+    case Token::kLT:
+    case Token::kGT:
+    case Token::kLTE:
+    case Token::kGTE: {
+      if (!left.IsInteger() || !right->IsInteger()) {
+        return nullptr;
+      }
+      const int compare =
+          Integer::Cast(left).CompareWith(Integer::Cast(*right));
+      switch (kind) {
+        case Token::kLT:
+          return &Bool::Get(compare < 0);
+        case Token::kGT:
+          return &Bool::Get(compare > 0);
+        case Token::kLTE:
+          return &Bool::Get(compare <= 0);
+        default:
+          return &Bool::Get(compare >= 0);
+      }
+    }
+    default: {
+      // Returns null if the operation would throw.
+      const auto& result = Integer::Handle(
+          zone_, Evaluator::BinaryIntegerEvaluate(left, *right, kind,
+                                                  /*is_truncating=*/true,
+                                                  kUnboxedInt64, thread_));
+      return result.IsNull() ? nullptr
+                             : &Integer::ZoneHandle(zone_, result.ptr());
+    }
+  }
+}
+
+const Object* PureCallEvaluator::EvaluateComparison(
+    ComparisonInstr* comparison,
+    const Object& left,
+    const Object& right) {
+  ASSERT(comparison->IsStrictCompare());
+  bool identical;
+  if (left.IsInteger() && right.IsInteger()) {
+    identical = Integer::Cast(left).Equals(Integer::Cast(right));
+  } else if (left.IsDouble() || right.IsDouble()) {
+    return nullptr;
+  } else {
+    identical = left.ptr() == right.ptr();
+  }
+  return &Bool::Get((comparison->kind() == Token::kEQ_STRICT) == identical);
+}
+
+}  // namespace dart
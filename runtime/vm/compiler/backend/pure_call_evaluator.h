@@ -0,0 +1,73 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_PURE_CALL_EVALUATOR_H_
+#define RUNTIME_VM_COMPILER_BACKEND_PURE_CALL_EVALUATOR_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+
+namespace dart {
+
+// Evaluates calls to pure static functions with constant arguments at
+// compile time (AOT only).
+//
+// A function is pure if the IL built for it only computes with locals,
+// constants, integer and boolean operators and calls to other pure functions.
+// Such a function is interpreted on the constant arguments, until it returns
+// or a step budget shared by all nested calls runs out. Evaluation gives up
+// whenever the function would throw (e.g. division by zero), so a folded call
+// always has the same result as the call at run time.
+class PureCallEvaluator : public ZoneAllocated {
+ public:
+  explicit PureCallEvaluator(Thread* thread);
+
+  // Whether calls to [function] can be evaluated at all.
+  static bool IsCandidate(const Function& function);
+
+  // Evaluates [call] with the constant [arguments]. Returns false if the
+  // callee is not pure or the evaluation did not finish within the budget.
+  bool Evaluate(StaticCallInstr* call,
+                const GrowableArray<const Object*>& arguments,
+                Object* result);
+
+ private:
+  struct PureFunction;
+
+  // Returns the IL of [function] prepared for interpretation, or nullptr if
+  // [function] is not pure.
+  PureFunction* GetPureFunction(const Function& function);
+  PureFunction* BuildPureFunction(const Function& function);
+
+  bool Run(PureFunction* function,
+           const GrowableArray<const Object*>& arguments,
+           intptr_t depth,
+           Object* result);
+
+  // Evaluates an operator of an instance call on constants.
+  const Object* EvaluateOperator(Token::Kind kind,
+                                 const Object& left,
+                                 const Object* right);
+  const Object* EvaluateComparison(ComparisonInstr* comparison,
+                                   const Object& left,
+                                   const Object& right);
+
+  Thread* thread_;
+  Zone* zone_;
+  intptr_t steps_ = 0;
+  GrowableArray<const Function*> functions_;
+  // Parallel to [functions_], nullptr for functions that are not pure.
+  GrowableArray<PureFunction*> pure_functions_;
+
+  DISALLOW_COPY_AND_ASSIGN(PureCallEvaluator);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_PURE_CALL_EVALUATOR_H_
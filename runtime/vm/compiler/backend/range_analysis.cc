@@ -460,6 +460,10 @@ bool RangeAnalysis::InferRange(JoinOperator op,
       }
     }
 
+    if (auto phi = defn->AsPhi()) {
+      ConstrainInductionRange(phi, &range);
+    }
+
     if (!range.Equals(defn->range())) {
 #ifndef PRODUCT
       if (FLAG_support_il_printer && FLAG_trace_range_analysis) {
@@ -476,6 +480,66 @@ bool RangeAnalysis::InferRange(JoinOperator op,
   return false;
 }
 
+// Computes the range [min, max] of the loop invariant [x] from the current
+// range of its symbolic part. Returns false if it is not known.
+static bool InvariantRange(InductionVar* x, int64_t* min, int64_t* max) {
+  if (!InductionVar::IsInvariant(x)) return false;
+  if (x->mult() == 0) {
+    *min = *max = x->offset();
+    return true;
+  }
+  if (x->mult() != 1 || Range::IsUnknown(x->def()->range())) return false;
+  const int64_t def_min = Range::ConstantMin(x->def()->range()).ConstantValue();
+  const int64_t def_max = Range::ConstantMax(x->def()->range()).ConstantValue();
+  if (Utils::WillAddOverflow(def_min, x->offset()) ||
+      Utils::WillAddOverflow(def_max, x->offset())) {
+    return false;
+  }
+  *min = def_min + x->offset();
+  *max = def_max + x->offset();
+  return true;
+}
+
+void RangeAnalysis::ConstrainInductionRange(PhiInstr* phi, Range* range) {
+  LoopInfo* loop = phi->block()->loop_info();
+  if (loop == nullptr || loop->header() != phi->block()) return;
+  InductionVar* induc = loop->LookupInduction(phi);
+  int64_t stride = 0;
+  if (induc == nullptr || induc != loop->control() ||
+      !InductionVar::IsLinear(induc, &stride)) {
+    return;
+  }
+  int64_t initial_min = 0;
+  int64_t initial_max = 0;
+  if (!InvariantRange(induc->initial(), &initial_min, &initial_max)) return;
+
+  // The loop condition is a strict bound i < U (i++) or i > L (i--) which
+  // is tested in the header before every iteration, so the phi never goes
+  // beyond U or L, even if the increment could overflow in principle.
+  Instruction* condition = loop->header()->last_instruction();
+  for (const auto& bound : induc->bounds()) {
+    int64_t limit_min = 0;
+    int64_t limit_max = 0;
+    if (bound.branch_ != condition ||
+        !InvariantRange(bound.limit_, &limit_min, &limit_max)) {
+      continue;
+    }
+    const Range induction_range =
+        stride > 0
+            ? Range(RangeBoundary::FromConstant(initial_min),
+                    RangeBoundary::FromConstant(
+                        Utils::Maximum(initial_max, limit_max)))
+            : Range(RangeBoundary::FromConstant(
+                        Utils::Minimum(initial_min, limit_min)),
+                    RangeBoundary::FromConstant(initial_max));
+    const Range constrained = range->Intersect(&induction_range);
+    if (!constrained.IsUnsatisfiable()) {
+      *range = constrained;
+    }
+    return;
+  }
+}
+
 void RangeAnalysis::CollectDefinitions(BitVector* set) {
   for (BlockIterator block_it = flow_graph_->reverse_postorder_iterator();
        !block_it.Done(); block_it.Advance()) {
@@ -646,6 +646,12 @@ class RangeAnalysis : public ValueObject {
   void Iterate(JoinOperator op, intptr_t max_iterations);
   bool InferRange(JoinOperator op, Definition* defn, intptr_t iteration);
 
+  // Intersect the [range] of a loop header [phi] with the bounds implied by
+  // the loop condition if the phi is the unit stride induction controlling
+  // the loop (see InductionVar::bounds). Unlike widening and narrowing, this
+  // also bounds phis compared with != or whose increments may overflow.
+  void ConstrainInductionRange(PhiInstr* phi, Range* range);
+
   // Based on computed ranges find and eliminate redundant CheckArrayBound
   // instructions.
   void EliminateRedundantBoundsChecks();
@@ -691,6 +691,55 @@ ISOLATE_UNIT_TEST_CASE(RangeAnalysis_ShiftUint32Op) {
   EXPECT(shift->shift_range()->max().ConstantValue() == 10);
 }
 
+// The range of a loop counter compared with != is bounded by the induction
+// analysis, so the increment can be done with a 32-bit operation.
+ISOLATE_UNIT_TEST_CASE(RangeAnalysis_InductionBoundedByNotEqual) {
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    int foo(int x) {
+      int result = 0;
+      for (int i = 0; i != 100; i++) {
+        result ^= x;
+      }
+      return result;
+    }
+    void main() {
+      foo(42);
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+
+  Invoke(root_library, "main");
+
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  PhiInstr* counter = nullptr;
+  bool has_int32_increment = false;
+  for (auto block : flow_graph->reverse_postorder()) {
+    if (auto join = block->AsJoinEntry()) {
+      for (PhiIterator it(join); !it.Done(); it.Advance()) {
+        PhiInstr* phi = it.Current();
+        if (phi->range() != nullptr &&
+            phi->range()->min().ConstantValue() == 0 &&
+            phi->range()->max().ConstantValue() == 100) {
+          counter = phi;
+        }
+      }
+    }
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (auto op = it.Current()->AsBinaryInt32Op()) {
+        has_int32_increment =
+            has_int32_increment || (op->op_kind() == Token::kADD);
+      }
+    }
+  }
+  EXPECT(counter != nullptr);
+  EXPECT(has_int32_increment);
+}
+
 #endif  // defined(DART_PRECOMPILER) && defined(TARGET_ARCH_IS_64_BIT)
 
 }  // namespace dart
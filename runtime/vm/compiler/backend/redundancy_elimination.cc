@@ -2987,6 +2987,136 @@ bool DominatorBasedCSE::OptimizeRecursive(FlowGraph* graph,
   return changed;
 }
 
+// Returns the value checked by [instr] if it is a check handled by
+// DominatedCheckElimination, or nullptr.
+static Value* CheckedValue(Instruction* instr) {
+  if (auto check = instr->AsCheckNull()) return check->value();
+  if (auto check = instr->AsCheckSmi()) return check->value();
+  if (auto check = instr->AsCheckClass()) return check->value();
+  if (auto check = instr->AsAssertAssignable()) return check->value();
+  return nullptr;
+}
+
+// Returns the destination type of [check] if it is a constant instantiated
+// type, or nullptr.
+static const AbstractType* ConstantDstType(AssertAssignableInstr* check) {
+  if (!check->dst_type()->BindsToConstant()) return nullptr;
+  const Object& type = check->dst_type()->BoundConstant();
+  if (!type.IsAbstractType() || !AbstractType::Cast(type).IsInstantiated()) {
+    return nullptr;
+  }
+  return &AbstractType::Cast(type);
+}
+
+// Returns whether every class id allowed by [a] is allowed by [b].
+static bool IsCidSubset(const Cids& a, const Cids& b) {
+  for (intptr_t i = 0; i < a.length(); ++i) {
+    bool covered = false;
+    for (intptr_t j = 0; j < b.length() && !covered; ++j) {
+      covered = (b[j].cid_start <= a[i].cid_start) &&
+                (a[i].cid_end <= b[j].cid_end);
+    }
+    if (!covered) return false;
+  }
+  return true;
+}
+
+// Returns whether [check] cannot fail once [dominator], which checks the
+// same value, passed.
+static bool IsImpliedBy(Instruction* check, Instruction* dominator) {
+  if (check->IsCheckNull()) {
+    if (dominator->IsCheckNull() || dominator->IsCheckSmi()) return true;
+    if (auto check_class = dominator->AsCheckClass()) {
+      return !check_class->cids().HasClassId(kNullCid);
+    }
+    if (auto assert_assignable = dominator->AsAssertAssignable()) {
+      const AbstractType* type = ConstantDstType(assert_assignable);
+      return (type != nullptr) && type->IsStrictlyNonNullable();
+    }
+  } else if (check->IsCheckSmi()) {
+    if (dominator->IsCheckSmi()) return true;
+    if (auto check_class = dominator->AsCheckClass()) {
+      return check_class->cids().IsMonomorphic() &&
+             (check_class->cids().MonomorphicReceiverCid() == kSmiCid);
+    }
+  } else if (auto check_class = check->AsCheckClass()) {
+    if (dominator->IsCheckSmi()) {
+      return check_class->cids().HasClassId(kSmiCid);
+    }
+    if (auto dominating_class = dominator->AsCheckClass()) {
+      return IsCidSubset(dominating_class->cids(), check_class->cids());
+    }
+  } else if (auto assert_assignable = check->AsAssertAssignable()) {
+    if (auto dominating_assert = dominator->AsAssertAssignable()) {
+      const AbstractType* type = ConstantDstType(assert_assignable);
+      const AbstractType* dominating_type = ConstantDstType(dominating_assert);
+      return (type != nullptr) && (dominating_type != nullptr) &&
+             dominating_type->IsSubtypeOf(*type, Heap::kOld);
+    }
+  }
+  return false;
+}
+
+bool DominatedCheckElimination::Optimize(FlowGraph* graph) {
+  GrowableArray<Instruction*> checks;
+  return OptimizeRecursive(graph, graph->graph_entry(), &checks);
+}
+
+bool DominatedCheckElimination::OptimizeRecursive(
+    FlowGraph* graph,
+    BlockEntryInstr* block,
+    GrowableArray<Instruction*>* checks) {
+  bool changed = false;
+  // Checks of the dominating blocks are at the start of [checks], so only
+  // the ones added for this block need to be removed again below.
+  const intptr_t dominating_checks = checks->length();
+  for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    Value* value = CheckedValue(current);
+    if (value == nullptr) continue;
+
+    Definition* original = value->definition()->OriginalDefinition();
+    Instruction* dominator = nullptr;
+    for (intptr_t i = checks->length() - 1; i >= 0; --i) {
+      Instruction* check = (*checks)[i];
+      if ((CheckedValue(check)->definition()->OriginalDefinition() ==
+           original) &&
+          IsImpliedBy(current, check)) {
+        dominator = check;
+        break;
+      }
+    }
+    if (dominator == nullptr) {
+      checks->Add(current);
+      continue;
+    }
+
+    if (FLAG_trace_optimization && graph->should_print()) {
+      THR_Print("Removing %s implied by %s\n", current->ToCString(),
+                dominator->ToCString());
+    }
+    if (auto def = current->AsDefinition()) {
+      // If the dominating check redefines the value as well, its type is at
+      // least as precise as the one of the removed check.
+      def->ReplaceUsesWith(dominator->IsDefinition() ? dominator->AsDefinition()
+                                                     : value->definition());
+    }
+    it.RemoveCurrentFromGraph();
+    changed = true;
+  }
+
+  intptr_t num_children = block->dominated_blocks().length();
+  if (num_children != 0) {
+    graph->thread()->CheckForSafepoint();
+  }
+  for (intptr_t i = 0; i < num_children; ++i) {
+    changed = OptimizeRecursive(graph, block->dominated_blocks()[i], checks) ||
+              changed;
+  }
+  checks->TruncateTo(dominating_checks);
+  return changed;
+}
+
 class StoreOptimizer : public LivenessAnalysis {
  public:
   StoreOptimizer(FlowGraph* graph,
@@ -96,6 +96,22 @@ class DominatorBasedCSE : public AllStatic {
                                 CSEInstructionSet* map);
 };
 
+// Removes checks (CheckNull, CheckSmi, CheckClass, AssertAssignable) which
+// are implied by a check of the same value in a dominating block. Unlike
+// CSE, this looks through redefinitions of the checked value and does not
+// require the dominating check to be identical: for example, a CheckClass
+// for a subset of the class ids or an AssertAssignable to a subtype suffices.
+class DominatedCheckElimination : public AllStatic {
+ public:
+  // Return true, if the optimization changed the flow graph.
+  static bool Optimize(FlowGraph* graph);
+
+ private:
+  static bool OptimizeRecursive(FlowGraph* graph,
+                                BlockEntryInstr* block,
+                                GrowableArray<Instruction*>* checks);
+};
+
 class DeadStoreElimination : public AllStatic {
  public:
   static void Optimize(FlowGraph* graph);
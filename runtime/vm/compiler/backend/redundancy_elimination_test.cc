@@ -1600,6 +1600,121 @@ ISOLATE_UNIT_TEST_CASE(CSE_Redefinitions) {
 
 #endif  // !defined(TARGET_ARCH_IA32)
 
+ISOLATE_UNIT_TEST_CASE(DominatedCheckElimination_ImpliedChecks) {
+  using compiler::BlockBuilder;
+  CompilerState S(thread, /*is_aot=*/false, /*is_optimizing=*/true);
+
+  FlowGraphBuilderHelper H(/*num_parameters=*/2);
+  H.AddVariable("v0", AbstractType::ZoneHandle(Type::DynamicType()));
+  H.AddVariable("v1", AbstractType::ZoneHandle(Type::DynamicType()));
+
+  // We are going to build the following graph:
+  //
+  // B0[graph_entry]:
+  // B1[function_entry]:
+  //   v0 <- Parameter(0)
+  //   v1 <- Parameter(1)
+  //   v2 <- AssertAssignable(v0, int)
+  //   CheckClass(v1, [OneByteString])
+  //   if v0 == null then B2 else B3
+  // B2:
+  //   v3 <- Redefinition(v0)
+  //   v4 <- CheckNull(v3)
+  //   CheckClass(v1, [OneByteString - TwoByteString])
+  //   Return(v4)
+  // B3:
+  //   v5 <- AssertAssignable(v0, num)
+  //   v6 <- AssertAssignable(v0, String)
+  //   CheckClass(v1, [TwoByteString])
+  //   Return(v5)
+
+  auto make_assert_assignable = [&](Definition* value,
+                                    const AbstractType& type) {
+    return new AssertAssignableInstr(
+        InstructionSource(), new Value(value),
+        new Value(H.flow_graph()->GetConstant(type)),
+        new Value(H.flow_graph()->constant_null()),
+        new Value(H.flow_graph()->constant_null()), Symbols::Empty(),
+        S.GetNextDeoptId());
+  };
+  auto make_check_class = [&](Definition* value, intptr_t cid_start,
+                              intptr_t cid_end) {
+    Cids* cids = new Cids(H.flow_graph()->zone());
+    cids->Add(new CidRange(cid_start, cid_end));
+    return new CheckClassInstr(new Value(value), S.GetNextDeoptId(), *cids,
+                               InstructionSource());
+  };
+
+  auto b1 = H.flow_graph()->graph_entry()->normal_entry();
+  auto b2 = H.TargetEntry();
+  auto b3 = H.TargetEntry();
+  Definition* v0;
+  Definition* v1;
+  Definition* v2;
+  Definition* v4;
+  Definition* v5;
+  Definition* v6;
+  CheckClassInstr* check_class_b2;
+  CheckClassInstr* check_class_b3;
+  ReturnInstr* ret_b2;
+  ReturnInstr* ret_b3;
+
+  {
+    BlockBuilder builder(H.flow_graph(), b1);
+    v0 = builder.AddParameter(0, 0, /*with_frame=*/true, kTagged);
+    v1 = builder.AddParameter(1, 1, /*with_frame=*/true, kTagged);
+    v2 = builder.AddDefinition(
+        make_assert_assignable(v0, AbstractType::ZoneHandle(Type::IntType())));
+    builder.AddInstruction(
+        make_check_class(v1, kOneByteStringCid, kOneByteStringCid));
+    builder.AddBranch(
+        new StrictCompareInstr(
+            InstructionSource(), Token::kEQ_STRICT, new Value(v0),
+            new Value(H.flow_graph()->GetConstant(Object::Handle())),
+            /*needs_number_check=*/false, S.GetNextDeoptId()),
+        b2, b3);
+  }
+
+  {
+    BlockBuilder builder(H.flow_graph(), b2);
+    auto v3 = builder.AddDefinition(new RedefinitionInstr(new Value(v0)));
+    v4 = builder.AddDefinition(new CheckNullInstr(
+        new Value(v3), String::ZoneHandle(), S.GetNextDeoptId(),
+        InstructionSource()));
+    check_class_b2 = builder.AddInstruction(
+        make_check_class(v1, kOneByteStringCid, kTwoByteStringCid));
+    ret_b2 = builder.AddReturn(new Value(v4));
+  }
+
+  {
+    BlockBuilder builder(H.flow_graph(), b3);
+    v5 = builder.AddDefinition(
+        make_assert_assignable(v0, AbstractType::ZoneHandle(Type::Number())));
+    v6 = builder.AddDefinition(make_assert_assignable(
+        v0, AbstractType::ZoneHandle(Type::StringType())));
+    check_class_b3 = builder.AddInstruction(
+        make_check_class(v1, kTwoByteStringCid, kTwoByteStringCid));
+    ret_b3 = builder.AddReturn(new Value(v5));
+  }
+
+  H.FinishGraph();
+
+  EXPECT(DominatedCheckElimination::Optimize(H.flow_graph()));
+
+  // The checks implied by the ones in B1 are removed, and their uses are
+  // replaced by the dominating AssertAssignable.
+  EXPECT_PROPERTY(v4, it.WasEliminated());
+  EXPECT_PROPERTY(ret_b2, it.value()->definition() == v2);
+  EXPECT_PROPERTY(check_class_b2, it.WasEliminated());
+  EXPECT_PROPERTY(v5, it.WasEliminated());
+  EXPECT_PROPERTY(ret_b3, it.value()->definition() == v2);
+
+  // Checks which are not implied are kept.
+  EXPECT_PROPERTY(v2, !it.WasEliminated());
+  EXPECT_PROPERTY(v6, !it.WasEliminated());
+  EXPECT_PROPERTY(check_class_b3, !it.WasEliminated());
+}
+
 // Regression test for https://github.com/dart-lang/sdk/issues/51220.
 // Verifies that deoptimization at the hoisted BinarySmiOp
 // doesn't result in the infinite re-optimization loop.
@@ -12,11 +12,14 @@
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/inliner.h"
 #include "vm/compiler/backend/linearscan.h"
+#include "vm/compiler/backend/loop_unroller.h"
+#include "vm/compiler/backend/loop_vectorizer.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
 #include "vm/compiler/call_specializer.h"
 #include "vm/compiler/compiler_timings.h"
+#include "vm/compiler/jit/flow_graph_cache.h"
 #include "vm/compiler/write_barrier_elimination.h"
 #if defined(DART_PRECOMPILER)
 #include "vm/compiler/aot/aot_call_specializer.h"
@@ -226,8 +229,21 @@ void CompilerPass::Run(CompilerPassState* state) const {
       TIMELINE_DURATION(thread, CompilerVerbose, name());
       {
         COMPILER_TIMINGS_PASS_TIMER_SCOPE(thread, id());
+        const int64_t start = OS::GetCurrentMonotonicMicros();
         repeat = DoBody(state);
+        const int64_t elapsed = OS::GetCurrentMonotonicMicros() - start;
+        if (elapsed > state->slowest_pass_micros) {
+          state->slowest_pass = name();
+          state->slowest_pass_micros = elapsed;
+        }
       }
+#if defined(SUPPORT_TIMELINE)
+      if (tbes.enabled()) {
+        tbes.SetNumArguments(1);
+        tbes.FormatArgument(0, "instructions", "%" Pd,
+                            state->flow_graph()->InstructionCount());
+      }
+#endif
       thread->CheckForSafepoint();
     }
     PrintGraph(state, kTraceAfter, round);
@@ -360,6 +376,7 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   INVOKE_PASS(WidenSmiToInt32);
   INVOKE_PASS(SelectRepresentations);
   INVOKE_PASS(CSE);
+  INVOKE_PASS(EliminateDominatedChecks);
   INVOKE_PASS(Canonicalize);
   INVOKE_PASS(LICM);
   INVOKE_PASS(TryOptimizePatterns);
@@ -379,6 +396,8 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   // Repeat branches optimization after DCE, as it could make more
   // empty blocks.
   INVOKE_PASS(OptimizeBranches);
+  INVOKE_PASS(VectorizeLoops);
+  INVOKE_PASS(UnrollLoops);
   INVOKE_PASS(AllocationSinking_Sink);
   INVOKE_PASS(EliminateDeadPhis);
   INVOKE_PASS(DCE);
@@ -397,6 +416,41 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   return pass_state->flow_graph();
 }
 
+FlowGraph* CompilerPass::RunBaselinePipeline(CompilerPassState* pass_state) {
+  INVOKE_PASS(ComputeSSA);
+  INVOKE_PASS(ApplyICData);
+  INVOKE_PASS(SetOuterInliningId);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(ApplyClassIds);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(BranchSimplify);
+  INVOKE_PASS(IfConvert);
+  INVOKE_PASS(ConstantPropagation);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(WidenSmiToInt32);
+  INVOKE_PASS(SelectRepresentations);
+  INVOKE_PASS(CSE);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(TryCatchOptimization);
+  INVOKE_PASS(EliminateEnvironments);
+  INVOKE_PASS(EliminateDeadPhis);
+  // Currently DCE assumes that EliminateEnvironments has already been run,
+  // so it should not be lifted earlier than that pass.
+  INVOKE_PASS(DCE);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(OptimizeBranches);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(SelectRepresentations_Final);
+  INVOKE_PASS(EliminateStackOverflowChecks);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(EliminateWriteBarriers);
+  INVOKE_PASS(FinalizeGraph);
+  INVOKE_PASS(AllocateRegisters);
+  INVOKE_PASS(ReorderBlocks);
+  return pass_state->flow_graph();
+}
+
 FlowGraph* CompilerPass::RunPipelineWithPasses(
     CompilerPassState* state,
     std::initializer_list<CompilerPass::Id> passes) {
@@ -407,8 +461,14 @@ FlowGraph* CompilerPass::RunPipelineWithPasses(
 }
 
 COMPILER_PASS(ComputeSSA, {
-  // Transform to SSA (no inlining arguments).
-  flow_graph->ComputeSSA(nullptr);
+  FlowGraphCache* cache = state->flow_graph_cache;
+  if (cache == nullptr || !cache->restored()) {
+    // Transform to SSA (no inlining arguments).
+    flow_graph->ComputeSSA(nullptr);
+    if (cache != nullptr) {
+      cache->Store(flow_graph);
+    }
+  }
 });
 
 COMPILER_PASS(ApplyICData, { state->call_specializer->ApplyICData(); });
@@ -485,6 +545,9 @@ COMPILER_PASS(UseTableDispatch, {
 
 COMPILER_PASS_REPEAT(CSE, { return DominatorBasedCSE::Optimize(flow_graph); });
 
+COMPILER_PASS(EliminateDominatedChecks,
+              { DominatedCheckElimination::Optimize(flow_graph); });
+
 COMPILER_PASS(LICM, {
   flow_graph->RenameUsesDominatedByRedefinitions();
   DEBUG_ASSERT(flow_graph->VerifyRedefinitions());
@@ -510,6 +573,10 @@ COMPILER_PASS(OptimizeBranches, {
   ConstantPropagator::OptimizeBranches(flow_graph);
 });
 
+COMPILER_PASS(VectorizeLoops, { LoopVectorizer::Optimize(flow_graph); });
+
+COMPILER_PASS(UnrollLoops, { LoopUnroller::Optimize(flow_graph); });
+
 COMPILER_PASS(OptimizeTypedDataAccesses,
               { TypedDataSpecializer::Optimize(flow_graph); });
 
@@ -565,7 +632,7 @@ COMPILER_PASS(AllocateRegistersForGraphIntrinsic, {
 
 COMPILER_PASS(ReorderBlocks, {
   if (state->reorder_blocks) {
-    BlockScheduler::ReorderBlocks(flow_graph);
+    BlockScheduler::ReorderBlocks(flow_graph, &state->inline_id_to_function);
   }
 
   // This is the last compiler pass.
@@ -34,6 +34,7 @@ namespace dart {
   V(DelayAllocations)                                                          \
   V(DSE)                                                                       \
   V(EliminateDeadPhis)                                                         \
+  V(EliminateDominatedChecks)                                                  \
   V(EliminateEnvironments)                                                     \
   V(EliminateStackOverflowChecks)                                              \
   V(FinalizeGraph)                                                             \
@@ -51,7 +52,9 @@ namespace dart {
   V(TryCatchOptimization)                                                      \
   V(TryOptimizePatterns)                                                       \
   V(TypePropagation)                                                           \
+  V(UnrollLoops)                                                               \
   V(UseTableDispatch)                                                          \
+  V(VectorizeLoops)                                                            \
   V(WidenSmiToInt32)                                                           \
   V(EliminateWriteBarriers)                                                    \
   V(GenerateCode)
@@ -60,6 +63,7 @@ class AllocationSinking;
 class BlockScheduler;
 class CallSpecializer;
 class FlowGraph;
+class FlowGraphCache;
 class FlowGraphCompiler;
 class Function;
 class Precompiler;
@@ -100,6 +104,14 @@ struct CompilerPassState {
 
   FlowGraphCompiler* graph_compiler = nullptr;
 
+  // Cache of the graph in SSA form (JIT only). If the graph was restored
+  // from it, the graph is already in SSA form.
+  FlowGraphCache* flow_graph_cache = nullptr;
+
+  // The pass which took the longest to run so far, see CompilationLog.
+  const char* slowest_pass = nullptr;
+  int64_t slowest_pass_micros = 0;
+
  private:
   FlowGraph* flow_graph_;
 };
@@ -183,6 +195,14 @@ class CompilerPass {
   static FlowGraph* RunForceOptimizedPipeline(PipelineMode mode,
                                               CompilerPassState* state);
 
+  // Pipeline of the JIT baseline tier, which sits between unoptimized and
+  // fully optimized code.
+  //
+  // Applies type feedback but does not inline and skips the expensive loop
+  // and range optimizations.
+  DART_WARN_UNUSED_RESULT
+  static FlowGraph* RunBaselinePipeline(CompilerPassState* state);
+
  protected:
   // This function executes the pass. If it returns true then
   // we will run Canonicalize on the graph and execute the pass
@@ -23,6 +23,7 @@
   V(AddCalleesOf)                                                              \
   V(CheckForNewDynamicFunctions)                                               \
   V(CollectCallbackFields)                                                     \
+  V(PrecompileStaticInitializers)                                              \
   V(PrecompileConstructors)                                                    \
   V(AttachOptimizedTypeTestingStub)                                            \
   V(TraceForRetainedFunctions)                                                 \
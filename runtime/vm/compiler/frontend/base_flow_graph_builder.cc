@@ -25,7 +25,7 @@ static bool SupportsCoverage() {
 #if defined(PRODUCT)
   return false;
 #else
-  return !CompilerState::Current().is_aot();
+  return !CompilerState::Current().is_aot() || FLAG_aot_coverage;
 #endif
 }
 
@@ -1187,7 +1187,8 @@ Fragment BaseFlowGraphBuilder::BuildEntryPointsIntrospection() {
 Fragment BaseFlowGraphBuilder::ClosureCall(TokenPosition position,
                                            intptr_t type_args_len,
                                            intptr_t argument_count,
-                                           const Array& argument_names) {
+                                           const Array& argument_names,
+                                           const Function& target_function) {
   Fragment result = RecordCoverage(position);
   const intptr_t total_count =
       (type_args_len > 0 ? 1 : 0) + argument_count +
@@ -1195,7 +1196,8 @@ Fragment BaseFlowGraphBuilder::ClosureCall(TokenPosition position,
   InputsArray arguments = GetArguments(total_count);
   ClosureCallInstr* call = new (Z)
       ClosureCallInstr(std::move(arguments), type_args_len, argument_names,
-                       InstructionSource(position), GetNextDeoptId());
+                       InstructionSource(position), GetNextDeoptId(),
+                       target_function);
   Push(call);
   result <<= call;
   return result;
@@ -1289,6 +1291,11 @@ Fragment BaseFlowGraphBuilder::RecordBranchCoverage(TokenPosition position) {
   return RecordCoverageImpl(position, true /** is_branch_coverage **/);
 }
 
+Fragment BaseFlowGraphBuilder::RecordCoverageInAot(TokenPosition position) {
+  if (!CompilerState::Current().is_aot()) return Fragment();
+  return RecordCoverageImpl(position, false /** is_branch_coverage **/);
+}
+
 Fragment BaseFlowGraphBuilder::RecordCoverageImpl(TokenPosition position,
                                                   bool is_branch_coverage) {
   Fragment instructions;
@@ -1348,6 +1355,14 @@ void BaseFlowGraphBuilder::FinalizeCoverageArray() {
     value = Smi::New(0);  // no coverage recorded.
     coverage_array_.SetAt(2 * i + 1, value);
   }
+
+  if (CompilerState::Current().is_aot()) {
+    // The precompiler compiles every function once, but a function may also
+    // be inlined into others before or after that. Attach the array to the
+    // function so all copies of its code record into the same one.
+    function_.SaveICDataMap(*new (Z) ZoneGrowableArray<const ICData*>(),
+                            Object::null_array(), coverage_array_);
+  }
 }
 
 }  // namespace kernel
@@ -420,12 +420,15 @@ class BaseFlowGraphBuilder {
 
   // Builds closure call with given number of arguments. Target closure
   // (in bare instructions mode) or closure function (otherwise) is taken from
-  // top of the stack.
+  // top of the stack. [target_function] is the closure function if it is
+  // known statically.
   // MoveArgument instructions should be already added for arguments.
-  Fragment ClosureCall(TokenPosition position,
-                       intptr_t type_args_len,
-                       intptr_t argument_count,
-                       const Array& argument_names);
+  Fragment ClosureCall(
+      TokenPosition position,
+      intptr_t type_args_len,
+      intptr_t argument_count,
+      const Array& argument_names,
+      const Function& target_function = Function::null_function());
 
   // Pops function type arguments, instantiator type arguments, dst_type, and
   // value; and type checks value against the type arguments.
@@ -471,6 +474,10 @@ class BaseFlowGraphBuilder {
   // Records coverage for this position, if the current VM mode supports it.
   Fragment RecordCoverage(TokenPosition position);
   Fragment RecordBranchCoverage(TokenPosition position);
+  // Records coverage for this position when compiling AOT with
+  // --aot_coverage. The JIT gets the same information from ICData and
+  // usage counters, which AOT code does not have.
+  Fragment RecordCoverageInAot(TokenPosition position);
 
   // Returns whether this function has a saved arguments descriptor array.
   bool has_saved_args_desc_array() {
@@ -381,6 +381,7 @@ InstancePtr ConstantReader::ReadConstantInternal(intptr_t constant_index) {
         constant = ReadConstant(entry_index);
         data.SetAt(j, constant);
       }
+      map.PrecomputeIndex();
 
       instance = map.ptr();
       break;
@@ -472,6 +473,7 @@ InstancePtr ConstantReader::ReadConstantInternal(intptr_t constant_index) {
         constant = ReadConstant(entry_index);
         data.SetAt(j, constant);
       }
+      set.PrecomputeIndex();
 
       instance = set.ptr();
       break;
@@ -705,6 +705,7 @@ Fragment StreamingFlowGraphBuilder::BuildRegularFunctionPrologue(
     LocalVariable* first_parameter) {
   Fragment F;
   F += CheckStackOverflowInPrologue(dart_function);
+  F += B->RecordCoverageInAot(dart_function.token_pos());
   F += DebugStepCheckInPrologue(dart_function, token_position);
   F += B->InitConstantParameters();
   F += SetupCapturedParameters(dart_function);
@@ -949,6 +950,23 @@ FlowGraph* StreamingFlowGraphBuilder::BuildGraph() {
   return nullptr;
 }
 
+void StreamingFlowGraphBuilder::PrepareParsedFunction() {
+  const Function& function = parsed_function()->function();
+
+  // Same scopes as in BuildGraph.
+  const Class& klass = Class::Handle(zone_, function.Owner());
+  Function& outermost_function =
+      Function::Handle(Z, function.GetOutermostFunction());
+
+  ActiveClassScope active_class_scope(active_class(), &klass);
+  ActiveMemberScope active_member(active_class(), &outermost_function);
+  FunctionType& signature = FunctionType::Handle(Z, function.signature());
+  ActiveTypeParametersScope active_type_params(active_class(), function,
+                                               &signature, Z);
+
+  ParseKernelASTFunction();
+}
+
 void StreamingFlowGraphBuilder::ParseKernelASTFunction() {
   const Function& function = parsed_function()->function();
 
@@ -3006,6 +3024,20 @@ Fragment StreamingFlowGraphBuilder::BuildLocalFunctionInvocation(
   LocalVariable* variable = LookupVariable(variable_kernel_position);
   ASSERT(!variable->is_late());
 
+  // The variable of a local function declaration is followed by its function
+  // node, so the called closure function is known (if it was created).
+  Function& target_function = Function::ZoneHandle(Z);
+  {
+    AlternativeReadingScope alt(&reader_,
+                                variable_kernel_position - data_program_offset_);
+    SkipVariableDeclaration();  // read variable declaration.
+    const auto& outermost_function = Function::Handle(
+        Z, parsed_function()->function().GetOutermostFunction());
+    target_function =
+        ClosureFunctionsCache::LookupClosureFunctionByKernelOffset(
+            outermost_function, ReaderOffset());
+  }
+
   Fragment instructions;
 
   // Type arguments.
@@ -3044,8 +3076,8 @@ Fragment StreamingFlowGraphBuilder::BuildLocalFunctionInvocation(
     ASSERT(!parsed_function()->function().is_native());
     instructions += DebugStepCheck(position);
   }
-  instructions +=
-      B->ClosureCall(position, type_args_len, argument_count, argument_names);
+  instructions += B->ClosureCall(position, type_args_len, argument_count,
+                                 argument_names, target_function);
   return instructions;
 }
 
@@ -5107,6 +5139,15 @@ Fragment StreamingFlowGraphBuilder::BuildOptimizedSwitchPrelude(
     instructions += B->LoadField(enum_index_field, /*calls_initializer=*/false);
     instructions += StoreLocal(pos, scopes()->switch_variable);
     instructions += Drop();
+  } else if (helper->is_string_switch()) {
+    // For a string switch, we dispatch on the hash code of the string but
+    // keep the string itself to compare it with the case expressions.
+
+    instructions += LoadLocal(scopes()->switch_variable);
+    instructions += InstanceCall(pos, Symbols::GetHashCode(), Token::kGET,
+                                 /*argument_count=*/1);
+    instructions += StoreLocal(pos, scopes()->switch_hash_variable);
+    instructions += Drop();
   }
 
   return instructions;
@@ -5122,6 +5163,8 @@ Fragment StreamingFlowGraphBuilder::BuildBinarySearchSwitch(
   //   jumpers.
   //   * Leafs at the bounds of the switch expression range might need to
   //     do a bound check.
+  // * A switch on strings bisects the hash codes of the case expressions,
+  //   and every leaf compares the strings instead of checking bounds.
 
   SwitchBlock* block = helper->switch_block();
   const intptr_t case_count = helper->case_count();
@@ -5149,6 +5192,11 @@ Fragment StreamingFlowGraphBuilder::BuildBinarySearchSwitch(
 
   Fragment current_instructions = BuildOptimizedSwitchPrelude(helper, join);
 
+  const bool is_string_switch = helper->is_string_switch();
+  LocalVariable* dispatch_variable = is_string_switch
+                                         ? scopes()->switch_hash_variable
+                                         : scopes()->switch_variable;
+
   GrowableArray<SwitchRange> stack;
   stack.Add(SwitchRange::Branch(0, expression_count - 1, current_instructions));
 
@@ -5161,10 +5209,29 @@ Fragment StreamingFlowGraphBuilder::BuildBinarySearchSwitch(
       const SwitchExpression& expression =
           *sorted_expressions.At(expression_index);
 
-      if (!range.is_bounds_checked() &&
-          ((helper->RequiresLowerBoundCheck() && expression_index == 0) ||
-           (helper->RequiresUpperBoundCheck() &&
-            expression_index == expression_count - 1))) {
+      if (!range.is_bounds_checked() && is_string_switch) {
+        // Only the hash code of the switch value matched, compare the
+        // strings.
+
+        branch_instructions += LoadLocal(scopes()->switch_variable);
+        branch_instructions += Constant(expression.value());
+        branch_instructions += InstanceCall(
+            expression.position(), Symbols::EqualOperator(), Token::kEQ,
+            /*argument_count=*/2,
+            /*checked_argument_count=*/2);
+        branch_instructions +=
+            BranchIfTrue(&then_entry, &otherwise_entry, /*negate=*/false);
+
+        Fragment otherwise_instructions(otherwise_entry);
+        otherwise_instructions += Goto(join);
+
+        stack.Add(SwitchRange::Leaf(expression_index, Fragment(then_entry),
+                                    /*is_bounds_checked=*/true));
+      } else if (!range.is_bounds_checked() &&
+                 ((helper->RequiresLowerBoundCheck() &&
+                   expression_index == 0) ||
+                  (helper->RequiresUpperBoundCheck() &&
+                   expression_index == expression_count - 1))) {
         // This leaf needs a bound check.
 
         branch_instructions += LoadLocal(scopes()->switch_variable);
@@ -5221,7 +5288,7 @@ Fragment StreamingFlowGraphBuilder::BuildBinarySearchSwitch(
           *sorted_expressions.At(middle);
       const SwitchExpression& next_expression = *sorted_expressions.At(next);
 
-      branch_instructions += LoadLocal(scopes()->switch_variable);
+      branch_instructions += LoadLocal(dispatch_variable);
       branch_instructions += Constant(middle_expression.integer());
       branch_instructions +=
           InstanceCall(middle_expression.position(),
@@ -5234,10 +5301,12 @@ Fragment StreamingFlowGraphBuilder::BuildBinarySearchSwitch(
       Fragment lower_branch_instructions(then_entry);
       Fragment upper_branch_instructions(otherwise_entry);
 
-      if (next_expression.integer().AsInt64Value() >
-          middle_expression.integer().AsInt64Value() + 1) {
+      if (!is_string_switch &&
+          (next_expression.integer().AsInt64Value() >
+           middle_expression.integer().AsInt64Value() + 1)) {
         // The upper branch is not contiguous with the lower branch.
         // Before continuing in the upper branch we add a bound check.
+        // Leafs of a string switch compare the strings anyway.
 
         upper_branch_instructions += LoadLocal(scopes()->switch_variable);
         upper_branch_instructions += Constant(next_expression.integer());
@@ -50,6 +50,9 @@ class StreamingFlowGraphBuilder : public KernelReaderHelper {
 
   FlowGraph* BuildGraph();
 
+  // See FlowGraphBuilder::PrepareParsedFunction.
+  void PrepareParsedFunction();
+
   void ReportUnexpectedTag(const char* variant, Tag tag) override;
 
   Fragment BuildStatementAt(intptr_t kernel_offset);
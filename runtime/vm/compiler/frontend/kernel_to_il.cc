@@ -389,13 +389,13 @@ Fragment FlowGraphBuilder::InstanceCall(
   }
   call->set_receiver_is_not_smi(receiver_is_not_smi);
   Push(call);
+  Fragment instructions = RecordCoverageInAot(position);
+  instructions <<= call;
   if (result_type != nullptr && result_type->IsConstant()) {
-    Fragment instructions(call);
     instructions += Drop();
     instructions += Constant(result_type->constant_value);
-    return instructions;
   }
-  return Fragment(call);
+  return instructions;
 }
 
 Fragment FlowGraphBuilder::FfiCall(
@@ -648,13 +648,13 @@ Fragment FlowGraphBuilder::StaticCall(TokenPosition position,
     call->set_entry_kind(Code::EntryKind::kUnchecked);
   }
   Push(call);
+  Fragment instructions = RecordCoverageInAot(position);
+  instructions <<= call;
   if (result_type != nullptr && result_type->IsConstant()) {
-    Fragment instructions(call);
     instructions += Drop();
     instructions += Constant(result_type->constant_value);
-    return instructions;
   }
-  return Fragment(call);
+  return instructions;
 }
 
 Fragment FlowGraphBuilder::StringInterpolateSingle(TokenPosition position) {
@@ -840,6 +840,16 @@ FlowGraph* FlowGraphBuilder::BuildGraph() {
   return result;
 }
 
+void FlowGraphBuilder::PrepareParsedFunction() {
+  const Function& function = parsed_function_->function();
+  auto& kernel_data = ExternalTypedData::Handle(Z, function.KernelData());
+  intptr_t kernel_data_program_offset = function.KernelDataProgramOffset();
+
+  StreamingFlowGraphBuilder streaming_flow_graph_builder(
+      this, kernel_data, kernel_data_program_offset);
+  streaming_flow_graph_builder.PrepareParsedFunction();
+}
+
 Fragment FlowGraphBuilder::NativeFunctionBody(const Function& function,
                                               LocalVariable* first_parameter) {
   ASSERT(function.is_native());
@@ -5164,6 +5174,10 @@ SwitchDispatch SwitchHelper::SelectDispatchStrategy() {
   // If the ratio of holes to expressions is too great we fall back to a
   // binary search to avoid code size explosion.
   const double kJumpTableMaxHolesRatio = 1.0;
+  // A switch on strings first has to load the hash code of the switch value
+  // and still compares the strings once a case is found, so a linear scan is
+  // faster for a few cases.
+  const intptr_t kHashDispatchMinExpressions = 8;
 
   if (!is_optimizable()) {
     // The switch is not optimizable, so we can only use linear scan.
@@ -5180,6 +5194,12 @@ SwitchDispatch SwitchHelper::SelectDispatchStrategy() {
     return kSwitchDispatchLinearScan;
   }
 
+  if (is_string_switch() &&
+      (FLAG_force_switch_dispatch_type == kSwitchDispatchAuto) &&
+      (expressions().length() < kHashDispatchMinExpressions)) {
+    return kSwitchDispatchLinearScan;
+  }
+
   PrepareForOptimizedSwitch();
 
   if (!is_optimizable()) {
@@ -5192,6 +5212,12 @@ SwitchDispatch SwitchHelper::SelectDispatchStrategy() {
     return kSwitchDispatchBinarySearch;
   }
 
+  if (is_string_switch()) {
+    // Hash codes are spread over a range that is far too large for a jump
+    // table.
+    return kSwitchDispatchBinarySearch;
+  }
+
   const int64_t range = ExpressionRange();
   if (range > kJumpTableMaxSize) {
     return kSwitchDispatchBinarySearch;
@@ -5266,6 +5292,10 @@ void SwitchHelper::PrepareForOptimizedSwitch() {
       }
       integer = &Integer::ZoneHandle(
           zone_, Integer::RawCast(value.GetField(*enum_index_field)));
+    } else if (is_string_switch()) {
+      // Matches the hashCode of the string at run time.
+      integer = &Integer::ZoneHandle(
+          zone_, Integer::NewCanonical(String::Cast(value).Hash()));
     } else {
       integer = &Integer::Cast(value);
     }
@@ -5291,7 +5321,8 @@ void SwitchHelper::PrepareForOptimizedSwitch() {
 
   // Check that there are no duplicate case expressions.
   // Duplicate expressions are allowed in switch statements, but
-  // optimized switches don't implemented them.
+  // optimized switches don't implemented them. Strings with colliding hash
+  // codes also fall back to a linear scan.
   for (intptr_t i = 0; i < sorted_expressions_.length() - 1; ++i) {
     const SwitchExpression& a = *sorted_expressions_.At(i);
     const SwitchExpression& b = *sorted_expressions_.At(i + 1);
@@ -5311,11 +5342,18 @@ void SwitchHelper::AddExpression(intptr_t case_index,
 
   if (is_optimizable_ || expression_class_ == nullptr) {
     // Check the type of the expression for use in an optimized switch.
-    const Class& value_class = Class::ZoneHandle(zone_, value.clazz());
+    // Strings of all representations are dispatched on as Strings.
+    const Class& value_class = Class::ZoneHandle(
+        zone_, value.IsString() ? Type::Handle(zone_, Type::StringType())
+                                      .type_class()
+                                : value.clazz());
     if (expression_class_ == nullptr) {
       expression_class_ = &value_class;
-      // Only integer and enum expressions can be used in an optimized switch.
-      is_optimizable_ = value.IsInteger() || value_class.is_enum_class();
+      // Only integer, enum and string expressions can be used in an optimized
+      // switch.
+      is_string_switch_ = value.IsString();
+      is_optimizable_ = value.IsInteger() || value_class.is_enum_class() ||
+                        is_string_switch_;
     } else if (value_class.ptr() != expression_class_->ptr()) {
       // At least one expression has a different type than the others.
       is_optimizable_ = false;
@@ -56,6 +56,11 @@ class FlowGraphBuilder : public BaseFlowGraphBuilder {
 
   FlowGraph* BuildGraph();
 
+  // Sets up the parsed function (scopes, default values of parameters and
+  // forwarding stub target) like BuildGraph, but does not build the graph.
+  // Used when the graph is restored from the FlowGraphCache instead.
+  void PrepareParsedFunction();
+
   // Returns true if given [function] is recognized for flow
   // graph building and its body is expressed in a custom-built IL.
   static bool IsRecognizedMethodForFlowGraph(const Function& function);
@@ -971,7 +976,8 @@ class SwitchExpression {
   const Instance& value() const { return *value_; }
 
   // Integer representation of the expression.
-  // For Integers it is the value itself and for Enums it is the index.
+  // For Integers it is the value itself, for Enums it is the index and for
+  // Strings it is the hash code.
   const Integer& integer() const {
     ASSERT(integer_ != nullptr);
     return *integer_;
@@ -1053,7 +1059,7 @@ class SwitchHelper {
   }
 
   // A switch statement is optimizable if all expression are of the same type
-  // and have integer representations.
+  // and have distinct integer representations.
   bool is_optimizable() const { return is_optimizable_; }
   const TokenPosition& position() const { return position_; }
   bool is_exhaustive() const { return is_exhaustive_; }
@@ -1101,6 +1107,10 @@ class SwitchHelper {
 
   bool is_enum_switch() const { return expression_class().is_enum_class(); }
 
+  // Whether the switch dispatches on the hash codes of strings. Every case
+  // reached by the dispatch still has to compare the strings.
+  bool is_string_switch() const { return is_string_switch_; }
+
   // Returns size of [min..max] range, or kMaxInt64 on overflow.
   int64_t ExpressionRange() const;
 
@@ -1120,6 +1130,7 @@ class SwitchHelper {
 
   Zone* zone_;
   bool is_optimizable_ = false;
+  bool is_string_switch_ = false;
   const TokenPosition position_;
   const bool is_exhaustive_;
   SwitchBlock* const switch_block_;
@@ -1385,6 +1385,7 @@ class KernelReaderHelper {
   friend bool NeedsDynamicInvocationForwarder(const Function& function);
   friend ArrayPtr CollectConstConstructorCoverageFrom(
       const Script& interesting_script);
+  friend ObjectPtr EvaluateConstantFieldInitializer(const Field& field);
 
  private:
   DISALLOW_COPY_AND_ASSIGN(KernelReaderHelper);
@@ -1820,6 +1820,13 @@ void ScopeBuilder::AddSwitchVariable() {
     variable->set_is_forced_stack();
     current_function_scope_->AddVariable(variable);
     result_->switch_variable = variable;
+
+    LocalVariable* hash_variable =
+        MakeVariable(TokenPosition::kNoSource, TokenPosition::kNoSource,
+                     Symbols::SwitchHash(), AbstractType::dynamic_type());
+    hash_variable->set_is_forced_stack();
+    current_function_scope_->AddVariable(hash_variable);
+    result_->switch_hash_variable = hash_variable;
   }
 }
 
@@ -189,6 +189,7 @@ class ScopeBuildingResult : public ZoneAllocated {
   ScopeBuildingResult()
       : type_arguments_variable(nullptr),
         switch_variable(nullptr),
+        switch_hash_variable(nullptr),
         finally_return_variable(nullptr),
         setter_value(nullptr),
         yield_jump_variable(nullptr),
@@ -214,6 +215,10 @@ class ScopeBuildingResult : public ZoneAllocated {
   // Non-nullptr when the function contains a switch statement.
   LocalVariable* switch_variable;
 
+  // Non-nullptr when the function contains a switch statement. Holds the hash
+  // of the switch expression when a switch on strings dispatches on it.
+  LocalVariable* switch_hash_variable;
+
   // Non-nullptr when the function contains a return inside a finally block.
   LocalVariable* finally_return_variable;
 
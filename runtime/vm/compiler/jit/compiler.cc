@@ -6,6 +6,7 @@
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/code_patcher.h"
+#include "vm/compilation_log.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
 #include "vm/compiler/backend/block_scheduler.h"
@@ -24,6 +25,7 @@
 #include "vm/compiler/compiler_state.h"
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/compiler/frontend/kernel_to_il.h"
+#include "vm/compiler/jit/flow_graph_cache.h"
 #include "vm/compiler/jit/jit_call_specializer.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
@@ -32,6 +34,7 @@
 #include "vm/flags.h"
 #include "vm/kernel.h"
 #include "vm/longjump.h"
+#include "vm/metrics_page.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/os.h"
@@ -85,6 +88,21 @@ DEFINE_FLAG(bool,
             false,
             "Trace only optimizing compiler operations.");
 DEFINE_FLAG(bool, trace_bailout, false, "Print bailout from ssa compiler.");
+DEFINE_FLAG(bool,
+            baseline_tier,
+            false,
+            "Compile functions reaching the optimization counter threshold "
+            "with a cheap baseline pipeline before fully optimizing them.");
+DEFINE_FLAG(int,
+            baseline_tier_promotion_threshold,
+            30000,
+            "Number of invocations of baseline code before the function is "
+            "fully optimized.");
+DEFINE_FLAG(int,
+            background_compiler_workers,
+            1,
+            "Maximum number of functions an isolate group optimizes in the "
+            "background at the same time.");
 
 DECLARE_FLAG(bool, trace_failed_optimization_attempts);
 
@@ -300,6 +318,17 @@ bool Compiler::IsBackgroundCompilation() {
   return !Thread::Current()->IsMutatorThread();
 }
 
+// Returns true if optimizing [function] should produce baseline code, which
+// counts its invocations to be promoted to fully optimized code. OSR always
+// compiles fully optimized code as baseline code does not count loop
+// iterations.
+static bool ShouldCompileBaselineTier(const Function& function,
+                                      intptr_t osr_id) {
+  return FLAG_baseline_tier && (osr_id == Compiler::kNoOSRDeoptId) &&
+         !function.HasOptimizedCode() && !function.ForceOptimize() &&
+         !function.IsIrregexpFunction();
+}
+
 class CompileParsedFunctionHelper : public ValueObject {
  public:
   CompileParsedFunctionHelper(ParsedFunction* parsed_function,
@@ -470,6 +499,9 @@ CodePtr CompileParsedFunctionHelper::FinalizeCompilation(
       function.SetUsageCounter(0);
     }
   }
+  if (!code.IsNull()) {
+    MetricsPage::RecordCompilation(optimized());
+  }
   return code.ptr();
 }
 
@@ -497,6 +529,17 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
   // suppression, since we don't restart optimization.
   SpeculativeInliningPolicy speculative_policy(/*enable_suppression=*/false);
 
+  const bool baseline_tier =
+      optimized() && ShouldCompileBaselineTier(function, osr_id());
+#if !defined(PRODUCT)
+  const int64_t start_micros = OS::GetCurrentMonotonicMicros();
+#endif
+  if (baseline_tier &&
+      (FLAG_trace_compiler || FLAG_trace_optimizing_compiler)) {
+    THR_Print("--> baseline tier for '%s'\n",
+              function.ToFullyQualifiedCString());
+  }
+
   Code* volatile result = &Code::ZoneHandle(zone);
   while (!done) {
     *result = Code::null();
@@ -504,6 +547,7 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
     if (setjmp(*jump.Set()) == 0) {
       FlowGraph* flow_graph = nullptr;
       ZoneGrowableArray<const ICData*>* ic_data_array = nullptr;
+      FlowGraphCache* flow_graph_cache = nullptr;
 
       CompilerState compiler_state(thread(), /*is_aot=*/false, optimized(),
                                    CompilerState::ShouldTrace(function));
@@ -533,9 +577,18 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
           }
         }
 
-        TIMELINE_DURATION(thread(), CompilerVerbose, "BuildFlowGraph");
-        flow_graph = pipeline->BuildFlowGraph(
-            zone, parsed_function(), ic_data_array, osr_id(), optimized());
+        if (optimized() && !baseline_tier &&
+            FlowGraphCache::IsEnabledFor(function)) {
+          flow_graph_cache = new (zone) FlowGraphCache(
+              thread(), parsed_function(), ic_data_array, osr_id());
+          flow_graph = flow_graph_cache->Lookup();
+        }
+
+        if (flow_graph == nullptr) {
+          TIMELINE_DURATION(thread(), CompilerVerbose, "BuildFlowGraph");
+          flow_graph = pipeline->BuildFlowGraph(
+              zone, parsed_function(), ic_data_array, osr_id(), optimized());
+        }
       }
 
       const bool print_flow_graph =
@@ -557,6 +610,7 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
 
       CompilerPassState pass_state(thread(), flow_graph, &speculative_policy);
       pass_state.reorder_blocks = reorder_blocks;
+      pass_state.flow_graph_cache = flow_graph_cache;
 
       if (function.ForceOptimize()) {
         ASSERT(optimized());
@@ -569,7 +623,12 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         JitCallSpecializer call_specializer(flow_graph, &speculative_policy);
         pass_state.call_specializer = &call_specializer;
 
-        flow_graph = CompilerPass::RunPipeline(CompilerPass::kJIT, &pass_state);
+        if (baseline_tier) {
+          flow_graph = CompilerPass::RunBaselinePipeline(&pass_state);
+        } else {
+          flow_graph =
+              CompilerPass::RunPipeline(CompilerPass::kJIT, &pass_state);
+        }
       }
 
       ASSERT(pass_state.inline_id_to_function.length() ==
@@ -581,6 +640,7 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
           &speculative_policy, pass_state.inline_id_to_function,
           pass_state.inline_id_to_token_pos, pass_state.caller_inline_id,
           ic_data_array);
+      graph_compiler.set_is_baseline_tier(baseline_tier);
       pass_state.graph_compiler = &graph_compiler;
       CompilerPass::GenerateCode(&pass_state);
 
@@ -633,6 +693,20 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         // Must be called outside of safepoint.
         Code::NotifyCodeObservers(function, *result, optimized());
 
+#if !defined(PRODUCT)
+        CompilationLog::Entry entry;
+        entry.SetFunction(function.ToQualifiedCString());
+        entry.optimized = optimized();
+        entry.timestamp_micros = OS::GetCurrentMonotonicMicros();
+        entry.duration_micros = entry.timestamp_micros - start_micros;
+        entry.instruction_count = flow_graph->InstructionCount();
+        entry.inlined_count = pass_state.inline_id_to_function.length() - 1;
+        entry.deoptimization_count = function.deoptimization_counter();
+        entry.slowest_pass = pass_state.slowest_pass;
+        entry.slowest_pass_micros = pass_state.slowest_pass_micros;
+        thread()->isolate_group()->compilation_log()->Add(entry);
+#endif  // !defined(PRODUCT)
+
         if (FLAG_disassemble && FlowGraphPrinter::ShouldPrint(function)) {
           Disassembler::DisassembleCode(function, *result, optimized());
         } else if (FLAG_disassemble_optimized && optimized() &&
@@ -1015,7 +1089,8 @@ class QueueElement {
 };
 
 // Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
+// It implements a FIFO queue, using Peek, Add, Remove operations, from which
+// RemoveHottest also takes the function with the highest usage counter.
 class BackgroundCompilationQueue {
  public:
   BackgroundCompilationQueue() : first_(nullptr), last_(nullptr) {}
@@ -1067,6 +1142,32 @@ class BackgroundCompilationQueue {
     return result;
   }
 
+  QueueElement* RemoveHottest() {
+    ASSERT(first_ != nullptr);
+    Function& candidate = Function::Handle(first_->Function());
+    QueueElement* hottest_prev = nullptr;
+    QueueElement* hottest = first_;
+    intptr_t hottest_count = candidate.usage_counter();
+    for (QueueElement *prev = first_, *p = first_->next(); p != nullptr;
+         prev = p, p = p->next()) {
+      candidate = p->Function();
+      if (candidate.usage_counter() > hottest_count) {
+        hottest_prev = prev;
+        hottest = p;
+        hottest_count = candidate.usage_counter();
+      }
+    }
+    if (hottest_prev == nullptr) {
+      return Remove();
+    }
+    hottest_prev->set_next(hottest->next());
+    if (last_ == hottest) {
+      last_ = hottest_prev;
+    }
+    hottest->set_next(nullptr);
+    return hottest;
+  }
+
   bool ContainsObj(const Object& obj) const {
     QueueElement* p = first_;
     while (p != nullptr) {
@@ -1100,6 +1201,11 @@ class BackgroundCompilerTask : public ThreadPool::Task {
   virtual ~BackgroundCompilerTask() {}
 
  private:
+  virtual Dart_TaskPriority priority(
+      Dart_TaskPriority pool_default) const {
+    return Dart_TaskPriority_Low;
+  }
+
   virtual void Run() { background_compiler_->Run(); }
 
   BackgroundCompiler* background_compiler_;
@@ -1112,7 +1218,7 @@ BackgroundCompiler::BackgroundCompiler(IsolateGroup* isolate_group)
       monitor_(),
       function_queue_(new BackgroundCompilationQueue()),
       running_(false),
-      done_(true),
+      num_workers_(0),
       disabled_depth_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
@@ -1134,14 +1240,25 @@ void BackgroundCompiler::Run() {
     {
       SafepointMonitorLocker ml(&monitor_);
       if (running_ && !function_queue()->IsEmpty()) {
-        element = function_queue()->Remove();
+        element = function_queue()->RemoveHottest();
         function ^= element->function();
+        // Keep other workers from compiling the same function meanwhile.
+        in_progress_.Add(element);
       }
     }
     if (element != nullptr) {
-      delete element;
       Compiler::CompileOptimizedFunction(thread, function,
                                          Compiler::kNoOSRDeoptId);
+      {
+        SafepointMonitorLocker ml(&monitor_);
+        for (intptr_t i = 0; i < in_progress_.length(); i++) {
+          if (in_progress_[i] == element) {
+            in_progress_.RemoveAt(i);
+            break;
+          }
+        }
+      }
+      delete element;
 
       // If an optimizable method is not optimized, put it back on
       // the background queue (unless it was passed to foreground).
@@ -1164,11 +1281,13 @@ void BackgroundCompiler::Run() {
         Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
       // Successfully scheduled a new task.
     } else {
-      // Background compiler done. This notification must happen after the
+      // This worker is done. This notification must happen after the
       // thread leaves to group to avoid a shutdown race with the thread
       // registry.
-      running_ = false;
-      done_ = true;
+      num_workers_--;
+      if (num_workers_ == 0) {
+        running_ = false;
+      }
       ml.NotifyAll();
     }
   }
@@ -1181,22 +1300,28 @@ bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
 
   SafepointMonitorLocker ml(&monitor_);
   if (disabled_depth_ > 0) return false;
-  if (!running_ && done_) {
+  if (!running_) {
+    ASSERT(num_workers_ == 0);
     running_ = true;
-    done_ = false;
+  }
+  // Each worker takes the hottest queued function, so start another one
+  // only when this function would otherwise wait for a busy worker.
+  if ((num_workers_ < FLAG_background_compiler_workers) &&
+      (num_workers_ == 0 || !function_queue()->IsEmpty())) {
     // If we ever wanted to run the BG compiler on the
     // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
     // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
     // notification would not work anymore.
-    if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+    if (Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+      num_workers_++;
+    } else if (num_workers_ == 0) {
       running_ = false;
-      done_ = true;
       return false;
     }
   }
 
   ASSERT(running_);
-  if (function_queue()->ContainsObj(function)) {
+  if (function_queue()->ContainsObj(function) || IsInProgressLocked(function)) {
     return true;
   }
   QueueElement* elem = new QueueElement(function);
@@ -1205,8 +1330,20 @@ bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
   return true;
 }
 
+bool BackgroundCompiler::IsInProgressLocked(const Function& function) const {
+  for (QueueElement* element : in_progress_) {
+    if (element->function() == function.ptr()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   function_queue_->VisitObjectPointers(visitor);
+  for (QueueElement* element : in_progress_) {
+    visitor->VisitPointer(element->function_untag());
+  }
 }
 
 void BackgroundCompiler::Stop() {
@@ -1222,7 +1359,7 @@ void BackgroundCompiler::StopLocked(Thread* thread,
                                     SafepointMonitorLocker* locker) {
   running_ = false;
   function_queue_->Clear();
-  while (!done_) {
+  while (num_workers_ > 0) {
     locker->Wait();
   }
 }
@@ -1246,7 +1383,7 @@ void BackgroundCompiler::Disable() {
 
   SafepointMonitorLocker ml(&monitor_);
   disabled_depth_++;
-  if (done_) return;
+  if (num_workers_ == 0) return;
   StopLocked(thread, &ml);
 }
 
@@ -113,9 +113,9 @@ class Compiler : public AllStatic {
   static void AbortBackgroundCompilation(intptr_t deopt_id, const char* msg);
 };
 
-// Class to run optimizing compilation in a background thread.
-// Current implementation: one task per isolate, it dies with the owning
-// isolate.
+// Class to run optimizing compilation in background threads.
+// Current implementation: up to --background_compiler_workers tasks per
+// isolate group, which die with the owning isolate group.
 // No OSR compilation in the background compiler.
 class BackgroundCompiler {
  public:
@@ -145,14 +145,17 @@ class BackgroundCompiler {
   void StopLocked(Thread* thread, SafepointMonitorLocker* done_locker);
   void Enable();
   void Disable();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return num_workers_ > 0; }
+  bool IsInProgressLocked(const Function& function) const;
 
   IsolateGroup* isolate_group_;
 
   Monitor monitor_;  // Controls access to the queue and running state.
   BackgroundCompilationQueue* function_queue_;
+  // Functions currently being compiled, removed from the queue.
+  MallocGrowableArray<QueueElement*> in_progress_;
   bool running_;            // While true, will try to read queue and compile.
-  bool done_;               // True if the thread is done.
+  intptr_t num_workers_;    // Number of tasks that have not finished.
   int16_t disabled_depth_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(BackgroundCompiler);
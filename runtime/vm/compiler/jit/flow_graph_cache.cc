@@ -0,0 +1,126 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/jit/flow_graph_cache.h"
+
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il_serializer.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/compiler/frontend/kernel_to_il.h"
+#include "vm/datastream.h"
+#include "vm/flags.h"
+#include "vm/object.h"
+#include "vm/parser.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            cache_flow_graphs,
+            false,
+            "Reuse the flow graph of a function built for an earlier "
+            "optimizing compilation when optimizing it again.");
+DECLARE_FLAG(bool, trace_compiler);
+
+FlowGraphCache::FlowGraphCache(Thread* thread,
+                               ParsedFunction* parsed_function,
+                               ZoneGrowableArray<const ICData*>* ic_data_array,
+                               intptr_t osr_id)
+    : thread_(thread),
+      parsed_function_(parsed_function),
+      ic_data_array_(ic_data_array),
+      osr_id_(osr_id) {}
+
+bool FlowGraphCache::IsEnabledFor(const Function& function) {
+  return FLAG_cache_flow_graphs && !function.ForceOptimize() &&
+         !function.IsIrregexpFunction();
+}
+
+FlowGraph* FlowGraphCache::Lookup() {
+  const Function& function = parsed_function_->function();
+  Zone* zone = thread_->zone();
+  const auto& data =
+      TypedData::Handle(zone, function.GetCachedFlowGraph(osr_id_));
+  if (data.IsNull()) {
+    return nullptr;
+  }
+
+  // The graph does not need to be built, but scopes and the rest of the
+  // parsed function do.
+  kernel::FlowGraphBuilder builder(parsed_function_, ic_data_array_,
+                                   /* not building var desc */ nullptr,
+                                   /* not inlining */ nullptr,
+                                   /* optimizing */ true, osr_id_);
+  builder.PrepareParsedFunction();
+
+  // Reading the graph allocates, so read from a copy which cannot move.
+  const intptr_t length = data.LengthInBytes();
+  uint8_t* buffer = zone->Alloc<uint8_t>(length);
+  {
+    NoSafepointScope no_safepoint;
+    memmove(buffer, data.DataAddr(0), length);
+  }
+  ReadStream read_stream(buffer, length);
+  FlowGraphDeserializer deserializer(*parsed_function_, &read_stream);
+  deserializer.set_ic_data_array(ic_data_array_);
+  const intptr_t deopt_id = deserializer.Read<intptr_t>();
+  const bool is_huge_method = deserializer.Read<bool>();
+  FlowGraph* flow_graph = deserializer.ReadFlowGraph();
+  if (is_huge_method) {
+    flow_graph->mark_huge_method();
+  }
+  // Continue numbering instructions added by optimizations after the ones
+  // of the graph.
+  CompilerState::Current().set_deopt_id(deopt_id);
+
+  if (FLAG_trace_compiler) {
+    THR_Print("--> using cached flow graph for '%s' (%" Pd " bytes)\n",
+              function.ToFullyQualifiedCString(), length);
+  }
+  restored_ = true;
+  return flow_graph;
+}
+
+void FlowGraphCache::Store(FlowGraph* flow_graph) {
+  ASSERT(!restored_);
+  // The serializer keeps track of written objects in the object id table of
+  // the heap, which only the mutator thread may use. Background compilations
+  // can still use graphs stored by other compilations of the function.
+  if (!thread_->IsMutatorThread()) {
+    return;
+  }
+
+  const Function& function = parsed_function_->function();
+  Zone* zone = thread_->zone();
+  auto* detached_defs = new (zone) ZoneGrowableArray<Definition*>(zone, 0);
+  flow_graph->CompactSSA(detached_defs);
+
+  ZoneWriteStream write_stream(zone, 1024);
+  {
+    FlowGraphSerializer serializer(&write_stream);
+    serializer.set_ic_data_array(ic_data_array_);
+    serializer.set_allow_unsupported(true);
+    serializer.Write<intptr_t>(CompilerState::Current().deopt_id());
+    serializer.Write<bool>(flow_graph->is_huge_method());
+    serializer.WriteFlowGraph(*flow_graph, *detached_defs);
+    if (serializer.failed()) {
+      if (FLAG_trace_compiler) {
+        THR_Print("--> cannot cache flow graph for '%s'\n",
+                  function.ToFullyQualifiedCString());
+      }
+      return;
+    }
+  }
+
+  const intptr_t length = write_stream.bytes_written();
+  const auto& data = TypedData::Handle(
+      zone, TypedData::New(kTypedDataUint8ArrayCid, length, Heap::kOld));
+  {
+    NoSafepointScope no_safepoint;
+    memmove(data.DataAddr(0), write_stream.buffer(), length);
+  }
+  function.SetCachedFlowGraph(osr_id_, data);
+}
+
+}  // namespace dart
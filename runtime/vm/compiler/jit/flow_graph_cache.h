@@ -0,0 +1,67 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_JIT_FLOW_GRAPH_CACHE_H_
+#define RUNTIME_VM_COMPILER_JIT_FLOW_GRAPH_CACHE_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+
+namespace dart {
+
+class FlowGraph;
+class Function;
+class ICData;
+class ParsedFunction;
+class Thread;
+
+// Caches the flow graphs built for optimizing compilations in the JIT, as
+// they are right after the conversion to SSA, so that optimizing a function
+// again (e.g. after it was deoptimized) does not need to build the graph from
+// kernel again.
+//
+// Graphs are stored serialized (see FlowGraphSerializer) next to the type
+// feedback of the function, one per OSR entry (see
+// Function::GetCachedFlowGraph), and are dropped together with the type
+// feedback when the unoptimized code of the function is replaced. ICData is
+// stored as deopt ids and bound to the type feedback which is current when
+// the graph is read.
+class FlowGraphCache : public ZoneAllocated {
+ public:
+  FlowGraphCache(Thread* thread,
+                 ParsedFunction* parsed_function,
+                 ZoneGrowableArray<const ICData*>* ic_data_array,
+                 intptr_t osr_id);
+
+  // Whether flow graphs of [function] can be cached.
+  static bool IsEnabledFor(const Function& function);
+
+  // Returns the graph cached for the function, which is already in SSA form,
+  // or nullptr. The parsed function is set up the same way as when the graph
+  // is built.
+  FlowGraph* Lookup();
+
+  // Stores [flow_graph], which has just been converted to SSA form.
+  void Store(FlowGraph* flow_graph);
+
+  // Whether the graph being compiled was returned by Lookup.
+  bool restored() const { return restored_; }
+
+ private:
+  Thread* const thread_;
+  ParsedFunction* const parsed_function_;
+  ZoneGrowableArray<const ICData*>* const ic_data_array_;
+  const intptr_t osr_id_;
+  bool restored_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(FlowGraphCache);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_JIT_FLOW_GRAPH_CACHE_H_
@@ -525,6 +525,11 @@ bool Class::TraceAllocation(const dart::Class& klass) {
   return klass.TraceAllocation(dart::IsolateGroup::Current());
 }
 
+bool Class::IsPretenured(const dart::Class& klass) {
+  return dart::IsolateGroup::Current()->heap()->pretenuring()->ShouldAllocateOld(
+      klass.id());
+}
+
 word Instance::first_field_offset() {
   return TranslateOffsetInWords(dart::Instance::NextFieldOffset());
 }
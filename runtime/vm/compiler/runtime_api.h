@@ -500,6 +500,9 @@ class Class : public AllStatic {
 
   // Whether to trace allocation for this klass.
   static bool TraceAllocation(const dart::Class& klass);
+
+  // Whether instances should be allocated in old space by the runtime.
+  static bool IsPretenured(const dart::Class& klass);
 };
 
 class Instance : public AllStatic {
@@ -1558,7 +1558,8 @@ void StubCodeCompiler::GenerateAllocationStubForClass(
   //                                       (if is_cls_parameterized).
   if (!FLAG_use_slow_path && FLAG_inline_alloc &&
       target::Heap::IsAllocatableInNewSpace(instance_size) &&
-      !target::Class::TraceAllocation(cls)) {
+      !target::Class::TraceAllocation(cls) &&
+      !target::Class::IsPretenured(cls)) {
     Label slow_case;
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
@@ -6,6 +6,10 @@
 #include "vm/compiler/compiler_pass.h"
 #include "vm/compiler/write_barrier_elimination.h"
 
+#if defined(DART_PRECOMPILER)
+#include "vm/compiler/aot/precompiler.h"
+#endif
+
 namespace dart {
 
 #if defined(DEBUG)
@@ -70,6 +74,16 @@ typedef DirectChainedHashMap<DefinitionIndexPairTrait> DefinitionIndexMap;
 //
 // See also Thread::RememberLiveTemporaries() and
 // Thread::DeferredMarkLiveTemporaries().
+//
+// Calls to Dart functions can trigger GC in the callee, which the runtime does
+// not cover. Under AOT, the precompiler records which functions were compiled
+// without any instruction that can trigger GC, and calls to those do not
+// interrupt write barrier elimination either (see
+// Precompiler::IsCallWithoutGC()).
+//
+// Arrays whose length is not constant are tracked if range analysis bounds
+// their length (see CreateArrayInstr::MaxNumElements()), so that loops
+// filling a freshly allocated array of bounded length skip the barrier too.
 class WriteBarrierElimination : public ValueObject {
  public:
   WriteBarrierElimination(Zone* zone, FlowGraph* flow_graph);
@@ -99,6 +113,8 @@ class WriteBarrierElimination : public ValueObject {
                             def->AsAllocation()->WillAllocateNewOrRemembered());
   }
 
+  static bool IsCallWithoutGC(Instruction* instr);
+
 #if defined(DEBUG)
   static bool SlotEligibleForWBE(const Slot& slot);
 #endif
@@ -194,9 +210,9 @@ static bool IsCreateLargeArray(Definition* defn) {
     static_assert(!Array::UseCardMarkingForAllocation(
                       Array::kMaxLengthForWriteBarrierElimination),
                   "Invariant restoration code does not handle card marking.");
-    // Note: IsUsable would reject CreateArray instructions with non-constant
+    // Note: IsUsable would reject CreateArray instructions with an unbounded
     // number of elements.
-    return create_array->GetConstantNumElements() >
+    return create_array->MaxNumElements() >
            Array::kMaxLengthForWriteBarrierElimination;
   }
   return false;
@@ -379,6 +395,16 @@ bool WriteBarrierElimination::SlotEligibleForWBE(const Slot& slot) {
 }
 #endif
 
+bool WriteBarrierElimination::IsCallWithoutGC(Instruction* instr) {
+#if defined(DART_PRECOMPILER)
+  Precompiler* precompiler = Precompiler::Instance();
+  if (precompiler != nullptr && CompilerState::Current().is_aot()) {
+    return precompiler->IsCallWithoutGC(instr);
+  }
+#endif  // defined(DART_PRECOMPILER)
+  return false;
+}
+
 void WriteBarrierElimination::UpdateVectorForBlock(BlockEntryInstr* entry,
                                                    bool finalize) {
   for (ForwardInstructionIterator it(entry); !it.Done(); it.Advance()) {
@@ -399,7 +425,9 @@ void WriteBarrierElimination::UpdateVectorForBlock(BlockEntryInstr* entry,
       }
     }
 
-    if (current->CanCallDart()) {
+    if (IsCallWithoutGC(current)) {
+      // Neither the call nor the callee can trigger GC.
+    } else if (current->CanCallDart()) {
       vector_->Clear();
     } else if (current->CanTriggerGC()) {
       // Clear large array allocations. These are not added to the remembered
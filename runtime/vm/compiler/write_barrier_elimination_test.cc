@@ -224,6 +224,69 @@ ISOLATE_UNIT_TEST_CASE(IRTest_WriteBarrierElimination_Arrays) {
   TestWBEForArrays(Array::kMaxLengthForWriteBarrierElimination + 1);
 }
 
+static void TestWBEForArrayFill(const char* length, bool bounded) {
+  DEBUG_ONLY(
+      SetFlagScope<bool> sfs(&FLAG_trace_write_barrier_elimination, true));
+  const char* nullable_tag = TestCase::NullableTag();
+
+  // Test that stores filling an array whose length is not constant skip the
+  // write barrier iff range analysis bounds the length, even though the loop
+  // allocates.
+  // clang-format off
+  auto kScript =
+      Utils::CStringUniquePtr(OS::SCreate(nullptr, R"(
+      class C {}
+
+      foo(int n) {
+        final int length = %s;
+        final array = List<C%s>.filled(length, null);
+        for (int i = 0; i < length; i++) {
+          array[i] = C();
+        }
+        return array;
+      }
+
+      main() { foo(10); }
+      )", length, nullable_tag), std::free);
+  // clang-format on
+
+  // Generate a length dependent test library uri.
+  char lib_uri[256];
+  snprintf(lib_uri, sizeof(lib_uri), "%s%s", RESOLVED_USER_TEST_URI,
+           bounded ? "bounded" : "unbounded");
+
+  const auto& root_library = Library::Handle(
+      LoadTestScript(kScript.get(), /*resolver=*/nullptr, lib_uri));
+
+  Invoke(root_library, "main");
+
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  auto entry = flow_graph->graph_entry()->normal_entry();
+  EXPECT(entry != nullptr);
+
+  StoreIndexedInstr* store_into_array = nullptr;
+
+  ILMatcher cursor(flow_graph, entry);
+  RELEASE_ASSERT(cursor.TryMatch({
+      kMoveGlob,
+      kMatchAndMoveGoto,
+      kMoveGlob,
+      kMatchAndMoveBranchTrue,
+      kMoveGlob,
+      {kMatchAndMoveStoreIndexed, &store_into_array},
+  }));
+
+  EXPECT(store_into_array->ShouldEmitStoreBarrier() == !bounded);
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_WriteBarrierElimination_ArrayFill) {
+  TestWBEForArrayFill("n & 7", /*bounded=*/true);
+  TestWBEForArrayFill("n", /*bounded=*/false);
+}
+
 ISOLATE_UNIT_TEST_CASE(IRTest_WriteBarrierElimination_Regress43786) {
   DEBUG_ONLY(
       SetFlagScope<bool> sfs(&FLAG_trace_write_barrier_elimination, true));
@@ -6,8 +6,10 @@
 #include "platform/assert.h"
 #include "vm/class_finalizer.h"
 #include "vm/code_patcher.h"
+#include "vm/compilation_log.h"
 #include "vm/dart_api_impl.h"
 #include "vm/heap/safepoint.h"
+#include "vm/json_stream.h"
 #include "vm/kernel_isolate.h"
 #include "vm/object.h"
 #include "vm/symbols.h"
@@ -127,6 +129,39 @@ ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   EXPECT(func.HasCode());
 }
 
+#ifndef PRODUCT
+ISOLATE_UNIT_TEST_CASE(CompilationLog) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo() { return 42; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+  const String& name = String::Handle(String::New("foo"));
+  const Function& func = Function::Handle(cls.LookupStaticFunction(name));
+  EXPECT(CompilerTest::TestCompileFunction(func));
+
+  CompilationLog* log = thread->isolate_group()->compilation_log();
+  EXPECT(log->length() > 0);
+  JSONStream js;
+  log->PrintJSON(&js);
+  EXPECT_SUBSTRING("\"type\":\"_CompilationLog\"", js.ToCString());
+  EXPECT_SUBSTRING("{\"function\":\"A.foo\",\"optimized\":false,",
+                   js.ToCString());
+}
+#endif  // !PRODUCT
+
 ISOLATE_UNIT_TEST_CASE(RegenerateAllocStubs) {
   const char* kScriptChars =
       "class A {\n"
@@ -7,6 +7,7 @@
 
 #include "vm/dart.h"
 
+#include "lib/ffi_dynamic_library.h"
 #include "vm/app_snapshot.h"
 #include "vm/code_observers.h"
 #include "vm/compiler/runtime_offsets_extracted.h"
@@ -15,6 +16,7 @@
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
+#include "vm/dwarf_symbolizer.h"
 #if defined(DART_PRECOMPILED_RUNTIME) && defined(DART_TARGET_OS_LINUX)
 #include "vm/elf.h"
 #endif
@@ -24,11 +26,13 @@
 #include "vm/heap/freelist.h"
 #include "vm/heap/heap.h"
 #include "vm/heap/pointer_block.h"
+#include "vm/heap/sampled_allocation_profile.h"
 #include "vm/isolate.h"
 #include "vm/isolate_reload.h"
 #include "vm/kernel_isolate.h"
 #include "vm/message_handler.h"
 #include "vm/metrics.h"
+#include "vm/metrics_page.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/object_id_ring.h"
@@ -51,6 +55,7 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, ffi_preload_native_assets);
 DECLARE_FLAG(bool, print_class_table);
 DEFINE_FLAG(bool, trace_shutdown, false, "Trace VM shutdown on stderr");
 
@@ -332,7 +337,10 @@ char* Dart::DartInit(const Dart_InitializeParams* params) {
   ForwardingCorpse::Init();
   Api::Init();
   NativeSymbolResolver::Init();
+  DwarfSymbolizer::Init();
+  MetricsPage::Init();
   NOT_IN_PRODUCT(Profiler::Init());
+  NOT_IN_PRODUCT(SampledAllocationProfile::Init());
   Page::Init();
   StoreBuffer::Init();
   MarkingStack::Init();
@@ -346,6 +354,7 @@ char* Dart::DartInit(const Dart_InitializeParams* params) {
   predefined_handles_ = new ReadOnlyHandles();
   // Create the VM isolate and finish the VM initialization.
   ASSERT(thread_pool_ == nullptr);
+  ThreadPool::SetExecutor(params->post_task, params->executor_data);
   thread_pool_ = new ThreadPool();
   {
     ASSERT(vm_isolate_ == nullptr);
@@ -636,6 +645,7 @@ char* Dart::Cleanup() {
 #endif  // !defined(PRODUCT)
 
   NativeSymbolResolver::Cleanup();
+  MetricsPage::Cleanup();
 
   // Disable the creation of new isolates.
   if (FLAG_trace_shutdown) {
@@ -712,6 +722,7 @@ char* Dart::Cleanup() {
   thread_pool_->Shutdown();
   delete thread_pool_;
   thread_pool_ = nullptr;
+  ThreadPool::SetExecutor(nullptr, nullptr);
   if (FLAG_trace_shutdown) {
     OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Done deleting thread pool\n",
                  UptimeMillis());
@@ -756,6 +767,7 @@ char* Dart::Cleanup() {
   PortMap::Cleanup();
   UserTags::Cleanup();
   IsolateGroup::Cleanup();
+  DwarfSymbolizer::Cleanup();
   ICData::Cleanup();
   SubtypeTestCache::Cleanup();
   ArgumentsDescriptor::Cleanup();
@@ -1044,6 +1056,11 @@ ErrorPtr Dart::InitializeIsolate(const uint8_t* snapshot_data,
     return error.ptr();
   }
 
+  if (FLAG_ffi_preload_native_assets &&
+      !was_child_cloned_into_existing_isolate && !Isolate::IsSystemIsolate(I)) {
+    PreloadNativeAssets(T);
+  }
+
   I->set_init_callback_data(isolate_data);
   if (FLAG_print_class_table) {
     IG->class_table()->Print();
@@ -34,6 +34,7 @@
 #include "vm/message.h"
 #include "vm/message_handler.h"
 #include "vm/message_snapshot.h"
+#include "vm/metrics_page.h"
 #include "vm/native_entry.h"
 #include "vm/native_symbol.h"
 #include "vm/object.h"
@@ -53,6 +54,7 @@
 #include "vm/stack_frame.h"
 #include "vm/symbols.h"
 #include "vm/tags.h"
+#include "vm/thread_pool.h"
 #include "vm/thread_registry.h"
 #include "vm/uri.h"
 #include "vm/version.h"
@@ -724,7 +726,8 @@ FinalizablePersistentHandle* FinalizablePersistentHandle::Cast(
 
 void FinalizablePersistentHandle::Finalize(
     IsolateGroup* isolate_group,
-    FinalizablePersistentHandle* handle) {
+    FinalizablePersistentHandle* handle,
+    bool defer) {
   if (!handle->ptr()->IsHeapObject()) {
     return;  // Free handle.
   }
@@ -739,6 +742,14 @@ void FinalizablePersistentHandle::Finalize(
     state->ClearWeakPersistentHandle(handle);
   }
 
+  if (defer) {
+    state->AddPendingFinalizer(callback, peer);
+    if (handle->auto_delete()) {
+      state->FreeWeakPersistentHandle(handle);
+    }
+    return;
+  }
+
   (*callback)(isolate_group->embedder_data(), peer);
 
   if (handle->auto_delete()) {
@@ -1213,6 +1224,13 @@ DART_EXPORT char* Dart_Initialize(Dart_InitializeParams* params) {
   return Dart::Init(params);
 }
 
+DART_EXPORT void Dart_RunTask(Dart_Task task) {
+  if (task == nullptr) {
+    FATAL("%s expects argument 'task' to be non-null.", CURRENT_FUNC);
+  }
+  ThreadPool::RunExecutorTask(task);
+}
+
 DART_EXPORT char* Dart_Cleanup() {
   CHECK_NO_ISOLATE(Isolate::Current());
   return Dart::Cleanup();
@@ -1239,6 +1257,20 @@ DART_EXPORT bool Dart_IsVMFlagSet(const char* flag_name) {
 DART_API_ISOLATE_GROUP_METRIC_LIST(ISOLATE_GROUP_METRIC_API)
 #undef ISOLATE_GROUP_METRIC_API
 
+DART_EXPORT int64_t Dart_IsolateCPUTimeMetric(Dart_Isolate isolate) {
+  if (isolate == nullptr) {
+    FATAL("%s expects argument 'isolate' to be non-null.", CURRENT_FUNC);
+  }
+  return reinterpret_cast<Isolate*>(isolate)->CpuTimeMicros();
+}
+
+DART_EXPORT int64_t Dart_IsolateAllocatedMetric(Dart_Isolate isolate) {
+  if (isolate == nullptr) {
+    FATAL("%s expects argument 'isolate' to be non-null.", CURRENT_FUNC);
+  }
+  return reinterpret_cast<Isolate*>(isolate)->allocated_bytes();
+}
+
 #if !defined(PRODUCT)
 #define ISOLATE_METRIC_API(type, variable, name, unit)                         \
   DART_EXPORT int64_t Dart_Isolate##variable##Metric(Dart_Isolate isolate) {   \
@@ -1259,6 +1291,14 @@ ISOLATE_METRIC_LIST(ISOLATE_METRIC_API)
 #undef ISOLATE_METRIC_API
 #endif  // !defined(PRODUCT)
 
+DART_EXPORT char* Dart_SetMetricsPage(Dart_MetricsPage* page,
+                                      int64_t period_micros) {
+  if (!Dart::IsInitialized()) {
+    return Utils::StrDup("VM is not initialized.");
+  }
+  return MetricsPage::SetPage(page, period_micros);
+}
+
 // --- Isolates ---
 
 static Dart_Isolate CreateIsolate(IsolateGroup* group,
@@ -1824,6 +1864,14 @@ DART_EXPORT void Dart_NotifyIdle(int64_t deadline) {
   T->isolate()->group()->idle_time_handler()->NotifyIdle(deadline);
 }
 
+DART_EXPORT void Dart_SetNewSpacePauseGoal(int64_t goal_micros) {
+  Thread* T = Thread::Current();
+  CHECK_ISOLATE(T->isolate());
+  API_TIMELINE_BEGIN_END(T);
+  TransitionNativeToVM transition(T);
+  T->heap()->new_space()->set_pause_goal_micros(goal_micros);
+}
+
 DART_EXPORT void Dart_NotifyDestroyed() {
   Thread* T = Thread::Current();
   CHECK_ISOLATE(T->isolate());
@@ -1880,6 +1928,12 @@ DART_EXPORT void Dart_NotifyLowMemory() {
   API_TIMELINE_BEGIN_END(Thread::Current());
   Page::ClearCache();
   Zone::ClearCache();
+  IsolateGroup::ForEach([](IsolateGroup* group) {
+    Heap* heap = group->heap();
+    if (heap != nullptr) {
+      heap->old_space()->ReleaseFreeMemory();
+    }
+  });
 
   // For each isolate's global variables, we might also clear:
   //  - RegExp backtracking stack (both bytecode and compiled versions)
@@ -4069,6 +4123,83 @@ DART_EXPORT Dart_Handle Dart_NewUnmodifiableExternalTypedDataWithFinalizer(
       callback, true);
 }
 
+static intptr_t ViewCidForType(Dart_TypedData_Type type) {
+  switch (type) {
+    case Dart_TypedData_kByteData:
+      return kByteDataViewCid;
+    case Dart_TypedData_kInt8:
+      return kTypedDataInt8ArrayViewCid;
+    case Dart_TypedData_kUint8:
+      return kTypedDataUint8ArrayViewCid;
+    case Dart_TypedData_kUint8Clamped:
+      return kTypedDataUint8ClampedArrayViewCid;
+    case Dart_TypedData_kInt16:
+      return kTypedDataInt16ArrayViewCid;
+    case Dart_TypedData_kUint16:
+      return kTypedDataUint16ArrayViewCid;
+    case Dart_TypedData_kInt32:
+      return kTypedDataInt32ArrayViewCid;
+    case Dart_TypedData_kUint32:
+      return kTypedDataUint32ArrayViewCid;
+    case Dart_TypedData_kInt64:
+      return kTypedDataInt64ArrayViewCid;
+    case Dart_TypedData_kUint64:
+      return kTypedDataUint64ArrayViewCid;
+    case Dart_TypedData_kFloat32:
+      return kTypedDataFloat32ArrayViewCid;
+    case Dart_TypedData_kFloat64:
+      return kTypedDataFloat64ArrayViewCid;
+    case Dart_TypedData_kInt32x4:
+      return kTypedDataInt32x4ArrayViewCid;
+    case Dart_TypedData_kFloat32x4:
+      return kTypedDataFloat32x4ArrayViewCid;
+    case Dart_TypedData_kFloat64x2:
+      return kTypedDataFloat64x2ArrayViewCid;
+    default:
+      return kIllegalCid;
+  }
+}
+
+DART_EXPORT Dart_Handle Dart_NewTypedDataView(Dart_Handle typed_data,
+                                              Dart_TypedData_Type type,
+                                              intptr_t offset_in_bytes,
+                                              intptr_t length) {
+  DARTSCOPE(Thread::Current());
+  CHECK_CALLBACK_STATE(T);
+  const intptr_t view_cid = ViewCidForType(type);
+  if (view_cid == kIllegalCid) {
+    return Api::NewError("%s expects argument 'type' to be of 'TypedData'",
+                         CURRENT_FUNC);
+  }
+  const Object& obj = Object::Handle(Z, Api::UnwrapHandle(typed_data));
+  TypedDataBase& backing = TypedDataBase::Handle(Z);
+  intptr_t base_offset = 0;
+  const intptr_t cid = obj.GetClassId();
+  if (IsTypedDataClassId(cid) || IsExternalTypedDataClassId(cid)) {
+    backing ^= obj.ptr();
+  } else if (IsTypedDataViewClassId(cid)) {
+    const TypedDataView& view = TypedDataView::Cast(obj);
+    backing ^= view.typed_data();
+    base_offset = Smi::Value(view.offset_in_bytes());
+  } else {
+    RETURN_TYPE_ERROR(Z, typed_data, 'TypedData');
+  }
+  const intptr_t element_size = TypedDataBase::ElementSizeInBytes(view_cid);
+  const intptr_t available =
+      TypedDataBase::Cast(obj).LengthInBytes() - offset_in_bytes;
+  if (offset_in_bytes < 0 || available < 0 ||
+      (offset_in_bytes % element_size) != 0) {
+    return Api::NewError("%s: invalid offset %" Pd, CURRENT_FUNC,
+                         offset_in_bytes);
+  }
+  if (length < 0 || length > available / element_size) {
+    return Api::NewError("%s: invalid length %" Pd, CURRENT_FUNC, length);
+  }
+  return Api::NewHandle(
+      T, TypedDataView::New(view_cid, backing, base_offset + offset_in_bytes,
+                            length));
+}
+
 static ObjectPtr GetByteBufferConstructor(Thread* thread,
                                           const String& class_name,
                                           const String& constructor_name,
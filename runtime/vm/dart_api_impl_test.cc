@@ -3263,6 +3263,70 @@ TEST_CASE(DartAPI_ExternalTypedDataCallback) {
   }
 }
 
+TEST_CASE(DartAPI_TypedDataViewsOntoArena) {
+  int peer = 0;
+  uint8_t arena[64];
+  Dart_PersistentHandle live_view;
+  {
+    Dart_EnterScope();
+    Dart_Handle obj = Dart_NewExternalTypedDataWithFinalizer(
+        Dart_TypedData_kUint8, arena, ARRAY_SIZE(arena), &peer, sizeof(arena),
+        ExternalTypedDataFinalizer);
+    EXPECT_VALID(obj);
+    for (intptr_t i = 0; i < 8; i++) {
+      Dart_Handle view =
+          Dart_NewTypedDataView(obj, Dart_TypedData_kInt32, i * 8, 2);
+      EXPECT_VALID(view);
+      Dart_TypedData_Type type;
+      void* data;
+      intptr_t len;
+      EXPECT_VALID(Dart_TypedDataAcquireData(view, &type, &data, &len));
+      EXPECT_EQ(Dart_TypedData_kInt32, type);
+      EXPECT_EQ(arena + i * 8, data);
+      EXPECT_EQ(2, len);
+      EXPECT_VALID(Dart_TypedDataReleaseData(view));
+      if (i == 3) {
+        live_view = Dart_NewPersistentHandle(view);
+      }
+    }
+
+    // Views of views are relative to the outer view.
+    Dart_Handle outer =
+        Dart_NewTypedDataView(obj, Dart_TypedData_kByteData, 16, 16);
+    EXPECT_VALID(outer);
+    Dart_Handle inner =
+        Dart_NewTypedDataView(outer, Dart_TypedData_kUint16, 4, 6);
+    EXPECT_VALID(inner);
+    Dart_TypedData_Type type;
+    void* data;
+    intptr_t len;
+    EXPECT_VALID(Dart_TypedDataAcquireData(inner, &type, &data, &len));
+    EXPECT_EQ(arena + 20, data);
+    EXPECT_VALID(Dart_TypedDataReleaseData(inner));
+
+    EXPECT_ERROR(Dart_NewTypedDataView(obj, Dart_TypedData_kInt32, 2, 1),
+                 "invalid offset");
+    EXPECT_ERROR(Dart_NewTypedDataView(obj, Dart_TypedData_kInt32, 60, 2),
+                 "invalid length");
+    EXPECT_ERROR(Dart_NewTypedDataView(obj, Dart_TypedData_kInt32, 72, 0),
+                 "invalid offset");
+    EXPECT_ERROR(Dart_NewTypedDataView(outer, Dart_TypedData_kUint8, 0, 17),
+                 "invalid length");
+    Dart_ExitScope();
+  }
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectAllGarbage();
+    EXPECT(peer == 0);
+  }
+  Dart_DeletePersistentHandle(live_view);
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectAllGarbage();
+    EXPECT(peer == 42);
+  }
+}
+
 static void SlowFinalizer(void* isolate_callback_data, void* peer) {
   OS::Sleep(10);
   intptr_t* count = reinterpret_cast<intptr_t*>(peer);
@@ -4938,6 +5002,41 @@ VM_UNIT_TEST_CASE(DartAPI_LocalHandles) {
   Dart_ShutdownIsolate();
 }
 
+// Unit test for reentering nested scopes, which are reused with the handle
+// blocks they kept from their previous use.
+VM_UNIT_TEST_CASE(DartAPI_ReuseNestedLocalScopes) {
+  TestCase::CreateTestIsolate();
+  Thread* thread = Thread::Current();
+  ApiLocalScope* scope = thread->api_top_scope();
+  const int kDepth = 6;
+  const int kHandlesPerScope = 150;
+  Dart_Handle handles[kDepth * kHandlesPerScope];
+  for (int round = 0; round < 3; round++) {
+    for (int depth = 0; depth < kDepth; depth++) {
+      Dart_EnterScope();
+      TransitionNativeToVM transition(thread);
+      for (int i = 0; i < kHandlesPerScope; i++) {
+        const int index = depth * kHandlesPerScope + i;
+        handles[index] = Api::NewHandle(thread, Smi::New(index + round));
+      }
+      EXPECT_EQ((depth + 1) * kHandlesPerScope, thread->CountLocalHandles());
+    }
+    {
+      TransitionNativeToVM transition(thread);
+      for (int i = 0; i < kDepth * kHandlesPerScope; i++) {
+        EXPECT_EQ(i + round, Smi::Value(Smi::RawCast(
+                                 Api::UnwrapHandle(handles[i]))));
+      }
+    }
+    for (int depth = kDepth; depth > 0; depth--) {
+      Dart_ExitScope();
+      EXPECT_EQ((depth - 1) * kHandlesPerScope, thread->CountLocalHandles());
+    }
+  }
+  EXPECT(scope == thread->api_top_scope());
+  Dart_ShutdownIsolate();
+}
+
 // Unit test for creating multiple scopes and allocating objects in the
 // zone for the scope. Ensure that the memory is freed when the scope
 // exits.
@@ -8257,6 +8356,47 @@ TEST_CASE(DartAPI_PostCObject_DoesNotRunFinalizerOnFailure) {
   free(my_str);  // Never a double-free.
 }
 
+static Monitor* concurrent_native_port_monitor = nullptr;
+static intptr_t concurrent_native_port_handled = 0;
+
+// The first message is only done once the second one was handled.
+static void NewNativePort_concurrent(Dart_Port dest_port_id,
+                                     Dart_CObject* message) {
+  EXPECT_EQ(Dart_CObject_kInt32, message->type);
+  MonitorLocker ml(concurrent_native_port_monitor);
+  if (message->value.as_int32 == 1) {
+    const int64_t deadline =
+        OS::GetCurrentMonotonicMicros() + 10 * kMicrosecondsPerSecond;
+    while (concurrent_native_port_handled == 0 &&
+           OS::GetCurrentMonotonicMicros() < deadline) {
+      ml.Wait(100);
+    }
+    EXPECT_EQ(1, concurrent_native_port_handled);
+  }
+  concurrent_native_port_handled++;
+  ml.NotifyAll();
+}
+
+VM_UNIT_TEST_CASE(DartAPI_NewNativePort_HandleConcurrently) {
+  Monitor monitor;
+  concurrent_native_port_monitor = &monitor;
+  concurrent_native_port_handled = 0;
+
+  Dart_Port port_id =
+      Dart_NewNativePort("Concurrent", NewNativePort_concurrent, true);
+  EXPECT_NE(ILLEGAL_PORT, port_id);
+  EXPECT(Dart_PostInteger(port_id, 1));
+  EXPECT(Dart_PostInteger(port_id, 2));
+  {
+    MonitorLocker ml(&monitor);
+    while (concurrent_native_port_handled < 2) {
+      ml.Wait();
+    }
+  }
+  EXPECT(Dart_CloseNativePort(port_id));
+  concurrent_native_port_monitor = nullptr;
+}
+
 VM_UNIT_TEST_CASE(DartAPI_NewNativePort) {
   // Create a port with a bogus handler.
   Dart_Port error_port = Dart_NewNativePort("Foo", nullptr, true);
@@ -8340,6 +8480,14 @@ static void NewNativePort_sendInteger321(Dart_Port dest_port_id,
                    321);
 }
 
+VM_UNIT_TEST_CASE(DartAPI_IsSafepointRequested_NoIsolate) {
+  EXPECT(!Dart_IsSafepointRequested());
+}
+
+TEST_CASE(DartAPI_IsSafepointRequested) {
+  EXPECT(!Dart_IsSafepointRequested());
+}
+
 TEST_CASE(DartAPI_NativePortPostInteger) {
   const char* kScriptChars =
       "import 'dart:isolate';\n"
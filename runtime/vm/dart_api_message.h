@@ -16,14 +16,17 @@
 namespace dart {
 
 // This class handles translation of certain RawObjects to CObjects for
-// NativeMessageHandlers.
+// NativeMessageHandlers, and back for Dart_PostCObject. Messages of such
+// objects don't need to be serialized.
 //
-// TODO(zra): Expand to support not only null, but also other VM heap objects
-// as well.
+// TODO(zra): Expand to support not only null and bool, but also other VM heap
+// objects as well.
 class ApiObjectConverter : public AllStatic {
  public:
   static bool CanConvert(const ObjectPtr raw_obj) {
-    return !raw_obj->IsHeapObject() || (raw_obj == Object::null());
+    return !raw_obj->IsHeapObject() || (raw_obj == Object::null()) ||
+           (raw_obj == Object::bool_true().ptr()) ||
+           (raw_obj == Object::bool_false().ptr());
   }
 
   static bool Convert(const ObjectPtr raw_obj, Dart_CObject* c_obj) {
@@ -31,12 +34,39 @@ class ApiObjectConverter : public AllStatic {
       ConvertSmi(static_cast<const SmiPtr>(raw_obj), c_obj);
     } else if (raw_obj == Object::null()) {
       ConvertNull(c_obj);
+    } else if (raw_obj == Object::bool_true().ptr()) {
+      ConvertBool(true, c_obj);
+    } else if (raw_obj == Object::bool_false().ptr()) {
+      ConvertBool(false, c_obj);
     } else {
       return false;
     }
     return true;
   }
 
+  // Returns the object of [c_obj] if it can be converted, nullptr otherwise.
+  static ObjectPtr TryConvert(const Dart_CObject* c_obj) {
+    switch (c_obj->type) {
+      case Dart_CObject_kNull:
+        return Object::null();
+      case Dart_CObject_kBool:
+        return c_obj->value.as_bool ? Object::bool_true().ptr()
+                                    : Object::bool_false().ptr();
+      case Dart_CObject_kInt32:
+        if (Smi::IsValid(c_obj->value.as_int32)) {
+          return Smi::New(c_obj->value.as_int32);
+        }
+        return nullptr;
+      case Dart_CObject_kInt64:
+        if (Smi::IsValid(c_obj->value.as_int64)) {
+          return Smi::New(c_obj->value.as_int64);
+        }
+        return nullptr;
+      default:
+        return nullptr;
+    }
+  }
+
  private:
   static void ConvertSmi(const SmiPtr raw_smi, Dart_CObject* c_obj) {
     ASSERT(!raw_smi->IsHeapObject());
@@ -54,6 +84,11 @@ class ApiObjectConverter : public AllStatic {
     c_obj->type = Dart_CObject_kNull;
     c_obj->value.as_int64 = 0;
   }
+
+  static void ConvertBool(bool value, Dart_CObject* c_obj) {
+    c_obj->type = Dart_CObject_kBool;
+    c_obj->value.as_bool = value;
+  }
 };
 
 }  // namespace dart
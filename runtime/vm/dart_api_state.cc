@@ -14,4 +14,23 @@
 
 namespace dart {
 
+void ApiState::RunPendingFinalizers(void* isolate_callback_data) {
+  // Callbacks may allocate or free handles, so run them without the lock.
+  MallocGrowableArray<PendingFinalizer> finalizers;
+  {
+    MutexLocker ml(&mutex_);
+    if (pending_finalizers_.is_empty()) {
+      return;
+    }
+    for (intptr_t i = 0; i < pending_finalizers_.length(); i++) {
+      finalizers.Add(pending_finalizers_[i]);
+    }
+    pending_finalizers_.Clear();
+  }
+  TIMELINE_DURATION(Thread::Current(), GC, "RunPendingFinalizers");
+  for (intptr_t i = 0; i < finalizers.length(); i++) {
+    (*finalizers[i].callback)(isolate_callback_data, finalizers[i].peer);
+  }
+}
+
 }  // namespace dart
@@ -247,10 +247,11 @@ class FinalizablePersistentHandle {
     }
   }
 
-  // Called when the referent becomes unreachable.
-  void UpdateUnreachable(IsolateGroup* isolate_group) {
+  // Called when the referent becomes unreachable. The GC defers the
+  // finalizer callback until the end of its safepoint operation.
+  void UpdateUnreachable(IsolateGroup* isolate_group, bool defer = false) {
     EnsureFreedExternal(isolate_group);
-    Finalize(isolate_group, this);
+    Finalize(isolate_group, this, defer);
   }
 
   // Called when the referent has moved, potentially between generations.
@@ -295,7 +296,8 @@ class FinalizablePersistentHandle {
   ~FinalizablePersistentHandle() {}
 
   static void Finalize(IsolateGroup* isolate_group,
-                       FinalizablePersistentHandle* handle);
+                       FinalizablePersistentHandle* handle,
+                       bool defer);
 
   // Overload the ptr_ field as a next pointer when adding freed
   // handles to the free list.
@@ -788,8 +790,23 @@ class ApiState {
 
   WeakTable* acquired_table() { return &acquired_table_; }
 
+  // Finalizer callbacks of handles found unreachable by the GC are queued
+  // here and run once the GC's safepoint operation is over, so embedder code
+  // does not add to the pause.
+  void AddPendingFinalizer(Dart_HandleFinalizer callback, void* peer) {
+    MutexLocker ml(&mutex_);
+    pending_finalizers_.Add({callback, peer});
+  }
+  void RunPendingFinalizers(void* isolate_callback_data);
+
  private:
+  struct PendingFinalizer {
+    Dart_HandleFinalizer callback;
+    void* peer;
+  };
+
   Mutex mutex_;
+  MallocGrowableArray<PendingFinalizer> pending_finalizers_;
 
   PersistentHandles persistent_handles_;
   FinalizablePersistentHandles weak_persistent_handles_;
@@ -16,6 +16,34 @@ static constexpr char kExponentChar = 'e';
 static constexpr const char* kInfinitySymbol = "Infinity";
 static constexpr const char* kNaNSymbol = "NaN";
 
+// Doubles with an integral value of at most this magnitude are printed
+// without going through the shortest-digits algorithm.
+static constexpr double kMaxExactIntegralDouble = 9007199254740992.0;  // 2^53
+
+// Prints an integral [d] as digits followed by ".0", which is what
+// ToShortest produces for integral doubles below 1e21.
+static void IntegralDoubleToCString(double d, char* buffer) {
+  ASSERT(d == trunc(d) && fabs(d) <= kMaxExactIntegralDouble);
+  int64_t value = static_cast<int64_t>(d);
+  char* p = buffer;
+  if (value < 0 || signbit(d)) {
+    *p++ = '-';
+    value = -value;
+  }
+  char digits[20];
+  intptr_t count = 0;
+  do {
+    digits[count++] = '0' + (value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (count > 0) {
+    *p++ = digits[--count];
+  }
+  *p++ = '.';
+  *p++ = '0';
+  *p = '\0';
+}
+
 void DoubleToCString(double d, char* buffer, int buffer_size) {
   const int kDecimalLow = -6;
   const int kDecimalHigh = 21;
@@ -31,6 +59,11 @@ void DoubleToCString(double d, char* buffer, int buffer_size) {
   // sign, at most three exponent digits, plus the \0.
   ASSERT(buffer_size >= 1 + 17 + 1 + 1 + 1 + 3 + 1);
 
+  if (fabs(d) <= kMaxExactIntegralDouble && d == trunc(d)) {
+    IntegralDoubleToCString(d, buffer);
+    return;
+  }
+
   const int kConversionFlags =
       double_conversion::DoubleToStringConverter::EMIT_POSITIVE_EXPONENT_SIGN |
       double_conversion::DoubleToStringConverter::EMIT_TRAILING_DECIMAL_POINT |
@@ -152,11 +185,76 @@ StringPtr DoubleToStringAsPrecision(double d, int precision) {
   return String::New(builder.Finalize());
 }
 
+// Powers of ten that are exactly representable as doubles.
+static constexpr double kExactPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// Parses plain decimal numerals whose digits fit in the 53-bit significand
+// of a double and whose decimal exponent selects an exact power of ten
+// (Clinger's fast path). A single multiplication or division of two exact
+// values is correctly rounded, so the result matches the full converter.
+// Returns false for any other input.
+static bool FastCStringToDouble(const char* str,
+                                intptr_t length,
+                                double* result) {
+  const uint64_t kMaxSignificand = static_cast<uint64_t>(1) << 53;
+  const intptr_t kMaxExactPower = ARRAY_SIZE(kExactPowersOfTen) - 1;
+  intptr_t i = 0;
+  const bool is_negative = str[0] == '-';
+  if (is_negative || str[0] == '+') i++;
+  uint64_t significand = 0;
+  intptr_t exponent = 0;
+  const intptr_t integer_start = i;
+  for (; i < length && str[i] >= '0' && str[i] <= '9'; i++) {
+    significand = significand * 10 + (str[i] - '0');
+    if (significand > kMaxSignificand) return false;
+  }
+  if (i == integer_start) return false;
+  if (i < length && str[i] == '.') {
+    const intptr_t fraction_start = ++i;
+    for (; i < length && str[i] >= '0' && str[i] <= '9'; i++) {
+      significand = significand * 10 + (str[i] - '0');
+      if (significand > kMaxSignificand) return false;
+      exponent--;
+    }
+    if (i == fraction_start) return false;
+  }
+  if (i < length && (str[i] == 'e' || str[i] == 'E')) {
+    i++;
+    const bool is_negative_exponent = i < length && str[i] == '-';
+    if (is_negative_exponent || (i < length && str[i] == '+')) i++;
+    const intptr_t exponent_start = i;
+    intptr_t explicit_exponent = 0;
+    for (; i < length && str[i] >= '0' && str[i] <= '9'; i++) {
+      explicit_exponent = explicit_exponent * 10 + (str[i] - '0');
+      if (explicit_exponent > 1000) return false;
+    }
+    if (i == exponent_start) return false;
+    exponent += is_negative_exponent ? -explicit_exponent : explicit_exponent;
+  }
+  if (i != length) return false;
+  if (exponent < -kMaxExactPower || exponent > kMaxExactPower) return false;
+  double value = static_cast<double>(significand);
+  if (exponent < 0) {
+    value /= kExactPowersOfTen[-exponent];
+  } else {
+    value *= kExactPowersOfTen[exponent];
+  }
+  *result = is_negative ? -value : value;
+  return true;
+}
+
 bool CStringToDouble(const char* str, intptr_t length, double* result) {
   if (length == 0) {
     return false;
   }
 
+  if (FastCStringToDouble(str, length, result)) {
+    return true;
+  }
+
   double_conversion::StringToDoubleConverter converter(
       double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, 0.0,
       kInfinitySymbol, kNaNSymbol);
@@ -0,0 +1,72 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/double_conversion.h"
+
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static double ParseDouble(const char* str) {
+  double result = 0.0;
+  EXPECT(CStringToDouble(str, strlen(str), &result));
+  return result;
+}
+
+static bool IsNegativeZero(double d) {
+  return d == 0.0 && signbit(d);
+}
+
+VM_UNIT_TEST_CASE(CStringToDouble) {
+  EXPECT_EQ(0.0, ParseDouble("0"));
+  EXPECT(IsNegativeZero(ParseDouble("-0")));
+  EXPECT(IsNegativeZero(ParseDouble("-0.0e5")));
+  EXPECT_EQ(1.5, ParseDouble("1.5"));
+  EXPECT_EQ(-1.5, ParseDouble("-1.5"));
+  EXPECT_EQ(1.5, ParseDouble("+1.5"));
+  EXPECT_EQ(0.1, ParseDouble("0.1"));
+  EXPECT_EQ(0.3, ParseDouble("0.3"));
+  EXPECT_EQ(123.456, ParseDouble("123.456"));
+  EXPECT_EQ(1e22, ParseDouble("1e22"));
+  EXPECT_EQ(1e-22, ParseDouble("1E-22"));
+  EXPECT_EQ(1.5e10, ParseDouble("15e+9"));
+  EXPECT_EQ(9007199254740992.0, ParseDouble("9007199254740992"));
+  // Outside of the exact range.
+  EXPECT_EQ(9007199254740993e0, ParseDouble("9007199254740993"));
+  EXPECT_EQ(1e23, ParseDouble("1e23"));
+  EXPECT_EQ(2.2250738585072014e-308, ParseDouble("2.2250738585072014e-308"));
+  EXPECT_EQ(0.1234567890123456789, ParseDouble("0.1234567890123456789"));
+  EXPECT(isinf(ParseDouble("1e400")));
+  EXPECT(isinf(ParseDouble("Infinity")));
+  EXPECT(isnan(ParseDouble("NaN")));
+
+  double result;
+  EXPECT(!CStringToDouble("", 0, &result));
+  EXPECT(!CStringToDouble("1.5x", 4, &result));
+  EXPECT(!CStringToDouble("--1", 3, &result));
+  EXPECT(!CStringToDouble("1e", 2, &result));
+}
+
+static void ExpectPrints(const char* expected, double d) {
+  char buffer[128];
+  DoubleToCString(d, buffer, sizeof(buffer));
+  EXPECT_STREQ(expected, buffer);
+}
+
+VM_UNIT_TEST_CASE(DoubleToCString) {
+  ExpectPrints("0.0", 0.0);
+  ExpectPrints("-0.0", -0.0);
+  ExpectPrints("1.0", 1.0);
+  ExpectPrints("-42.0", -42.0);
+  ExpectPrints("9007199254740992.0", 9007199254740992.0);
+  ExpectPrints("-9007199254740992.0", -9007199254740992.0);
+  ExpectPrints("9007199254740994.0", 9007199254740994.0);
+  ExpectPrints("1e+21", 1e21);
+  ExpectPrints("1.5", 1.5);
+  ExpectPrints("0.1", 0.1);
+  ExpectPrints("1e-7", 1e-7);
+}
+
+}  // namespace dart
@@ -0,0 +1,756 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/dwarf_symbolizer.h"
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+
+#include "platform/elf.h"
+#include "vm/compiler/runtime_api.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/growable_array.h"
+#include "vm/os.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+DEFINE_FLAG(charp,
+            dwarf_debug_info,
+            nullptr,
+            "Separate debugging information (see --save-debugging-info) used "
+            "to symbolize DWARF stack traces in-process.");
+
+// Only the subset of DWARF written by vm/dwarf.cc is understood.
+static constexpr intptr_t DW_TAG_subprogram = 0x2e;
+static constexpr intptr_t DW_TAG_inlined_subroutine = 0x1d;
+
+static constexpr intptr_t DW_AT_name = 0x3;
+static constexpr intptr_t DW_AT_low_pc = 0x11;
+static constexpr intptr_t DW_AT_high_pc = 0x12;
+static constexpr intptr_t DW_AT_abstract_origin = 0x31;
+
+static constexpr intptr_t DW_FORM_addr = 0x01;
+static constexpr intptr_t DW_FORM_data2 = 0x05;
+static constexpr intptr_t DW_FORM_data4 = 0x06;
+static constexpr intptr_t DW_FORM_data8 = 0x07;
+static constexpr intptr_t DW_FORM_string = 0x08;
+static constexpr intptr_t DW_FORM_data1 = 0x0b;
+static constexpr intptr_t DW_FORM_flag = 0x0c;
+static constexpr intptr_t DW_FORM_sdata = 0x0d;
+static constexpr intptr_t DW_FORM_udata = 0x0f;
+static constexpr intptr_t DW_FORM_ref4 = 0x13;
+static constexpr intptr_t DW_FORM_ref_udata = 0x15;
+static constexpr intptr_t DW_FORM_sec_offset = 0x17;
+
+static constexpr intptr_t DW_LNS_copy = 0x1;
+static constexpr intptr_t DW_LNS_advance_pc = 0x2;
+static constexpr intptr_t DW_LNS_advance_line = 0x3;
+static constexpr intptr_t DW_LNS_set_file = 0x4;
+static constexpr intptr_t DW_LNS_set_column = 0x5;
+static constexpr intptr_t DW_LNS_const_add_pc = 0x8;
+static constexpr intptr_t DW_LNS_fixed_advance_pc = 0x9;
+
+static constexpr intptr_t DW_LNE_end_sequence = 0x01;
+static constexpr intptr_t DW_LNE_set_address = 0x02;
+
+// Reads little-endian DWARF data, failing instead of reading past the end
+// since the file is not trusted to be well formed.
+class DwarfReader : public ValueObject {
+ public:
+  DwarfReader(const uint8_t* start, intptr_t size)
+      : start_(start), current_(start), end_(start + size) {}
+
+  bool failed() const { return failed_; }
+  bool at_end() const { return current_ >= end_; }
+  intptr_t Position() const { return current_ - start_; }
+
+  void SetPosition(intptr_t position) {
+    if (position < 0 || position > end_ - start_) {
+      failed_ = true;
+      current_ = end_;
+      return;
+    }
+    current_ = start_ + position;
+  }
+
+  uint64_t Fixed(intptr_t size) {
+    if (size > end_ - current_) {
+      failed_ = true;
+      current_ = end_;
+      return 0;
+    }
+    uint64_t value = 0;
+    for (intptr_t i = 0; i < size; i++) {
+      value |= static_cast<uint64_t>(current_[i]) << (i * kBitsPerByte);
+    }
+    current_ += size;
+    return value;
+  }
+
+  uint8_t u1() { return Fixed(1); }
+  uint16_t u2() { return Fixed(2); }
+  uint32_t u4() { return Fixed(4); }
+  uword addr() { return Fixed(compiler::target::kWordSize); }
+
+  uint64_t uleb128() {
+    uint64_t value = 0;
+    intptr_t shift = 0;
+    uint8_t byte;
+    do {
+      byte = u1();
+      if (shift < 64) {
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      }
+      shift += 7;
+    } while (((byte & 0x80) != 0) && !failed_);
+    return value;
+  }
+
+  int64_t sleb128() {
+    uint64_t value = 0;
+    intptr_t shift = 0;
+    uint8_t byte;
+    do {
+      byte = u1();
+      if (shift < 64) {
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      }
+      shift += 7;
+    } while (((byte & 0x80) != 0) && !failed_);
+    if (((byte & 0x40) != 0) && (shift < 64)) {
+      value |= ~static_cast<uint64_t>(0) << shift;
+    }
+    return static_cast<int64_t>(value);
+  }
+
+  // Returns a pointer to the null-terminated string at the current position.
+  const char* string() {
+    const char* result = reinterpret_cast<const char*>(current_);
+    while (current_ < end_ && *current_ != '\0') {
+      current_++;
+    }
+    if (current_ == end_) {
+      failed_ = true;
+      return nullptr;
+    }
+    current_++;  // Skip the terminator.
+    return result;
+  }
+
+ private:
+  const uint8_t* const start_;
+  const uint8_t* current_;
+  const uint8_t* const end_;
+  bool failed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(DwarfReader);
+};
+
+// Address to function and source position index built from the debugging
+// information. All strings point into the contents of the file, which is
+// kept alive as long as the index.
+class DwarfIndex {
+ public:
+  DwarfIndex() {}
+  ~DwarfIndex() { free(contents_); }
+
+  // Reads [filename] and builds the index. Returns false if the file could
+  // not be read or does not contain DWARF information written by the VM.
+  bool Build(const char* filename);
+
+  bool Lookup(uword address, DwarfSymbolizer::Location* location);
+
+ private:
+  struct Section {
+    const uint8_t* start = nullptr;
+    intptr_t size = 0;
+  };
+
+  struct Abbreviation {
+    intptr_t code;
+    intptr_t tag;
+    bool has_children;
+    // Offset of the (attribute, form) pairs in .debug_abbrev.
+    intptr_t attributes_offset;
+  };
+
+  // A function, or an inlined function when [depth] is positive. Inlined
+  // functions directly follow the function (or inlined function) they were
+  // inlined into.
+  struct FunctionRange {
+    uword start;
+    uword end;
+    const char* name;
+    intptr_t depth;
+  };
+
+  struct Root {
+    uword start;
+    intptr_t index;
+  };
+
+  struct AbstractFunction {
+    uint64_t offset;
+    const char* name;
+  };
+
+  struct LineRow {
+    uword address;
+    // Zero for addresses without source information.
+    intptr_t file;
+    intptr_t line;
+    intptr_t column;
+  };
+
+  struct CacheEntry {
+    uword address = 0;
+    bool found = false;
+    DwarfSymbolizer::Location location;
+  };
+
+  bool FindSections(Section* info, Section* abbrev, Section* line);
+  bool ReadAbbreviations(const Section& abbrev);
+  bool ReadDebugInfo(const Section& info, const Section& abbrev);
+  bool ReadLineNumberProgram(const Section& line);
+
+  bool SkipAttribute(DwarfReader* reader, intptr_t form);
+  const Abbreviation* LookupAbbreviation(intptr_t code) const;
+  const char* LookupAbstractFunction(uint64_t offset) const;
+  void AddLineRow(uword address, intptr_t file, intptr_t line, intptr_t col);
+
+  bool DoLookup(uword address, DwarfSymbolizer::Location* location) const;
+
+  uint8_t* contents_ = nullptr;
+  intptr_t length_ = 0;
+
+  MallocGrowableArray<Abbreviation> abbreviations_;
+  MallocGrowableArray<AbstractFunction> abstract_functions_;
+  MallocGrowableArray<FunctionRange> functions_;
+  // The entries of [functions_] with depth 0, by address.
+  MallocGrowableArray<Root> roots_;
+  MallocGrowableArray<const char*> files_;
+  MallocGrowableArray<LineRow> lines_;
+
+  static constexpr intptr_t kCacheSize = 256;
+  CacheEntry cache_[kCacheSize];
+
+  DISALLOW_COPY_AND_ASSIGN(DwarfIndex);
+};
+
+bool DwarfIndex::Build(const char* filename) {
+  auto file_open = Dart::file_open_callback();
+  auto file_read = Dart::file_read_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_read == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.\n");
+    return false;
+  }
+  void* file = file_open(filename, /*write=*/false);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to open debugging information: %s\n",
+                 filename);
+    return false;
+  }
+  file_read(&contents_, &length_, file);
+  file_close(file);
+  if ((contents_ == nullptr) || (length_ < 0)) {
+    OS::PrintErr("warning: Failed to read debugging information: %s\n",
+                 filename);
+    return false;
+  }
+
+  Section info, abbrev, line;
+  if (!FindSections(&info, &abbrev, &line) || !ReadAbbreviations(abbrev) ||
+      !ReadDebugInfo(info, abbrev) || !ReadLineNumberProgram(line)) {
+    OS::PrintErr("warning: Malformed debugging information: %s\n", filename);
+    return false;
+  }
+  return true;
+}
+
+bool DwarfIndex::FindSections(Section* info, Section* abbrev, Section* line) {
+  if (length_ < static_cast<intptr_t>(sizeof(elf::ElfHeader))) return false;
+  const auto& header = *reinterpret_cast<const elf::ElfHeader*>(contents_);
+  if ((header.ident[0] != 0x7f) || (header.ident[1] != 'E') ||
+      (header.ident[2] != 'L') || (header.ident[3] != 'F')) {
+    return false;
+  }
+  if (header.section_table_entry_size != sizeof(elf::SectionHeader)) {
+    return false;
+  }
+  const uint64_t table_end =
+      header.section_table_offset +
+      static_cast<uint64_t>(header.num_section_headers) *
+          sizeof(elf::SectionHeader);
+  if ((header.section_table_offset > static_cast<uint64_t>(length_)) ||
+      (table_end > static_cast<uint64_t>(length_)) ||
+      (header.shstrtab_section_index >= header.num_section_headers)) {
+    return false;
+  }
+  // The section table may not be aligned in the buffer, so copy entries out.
+  auto section_at = [&](intptr_t i) {
+    elf::SectionHeader section;
+    memcpy(&section,
+           contents_ + header.section_table_offset +
+               i * sizeof(elf::SectionHeader),
+           sizeof(elf::SectionHeader));
+    return section;
+  };
+  auto contents_of = [&](const elf::SectionHeader& section, Section* result) {
+    const uint64_t length = length_;
+    if ((section.file_offset > length) ||
+        (section.file_size > length - section.file_offset)) {
+      return false;
+    }
+    result->start = contents_ + section.file_offset;
+    result->size = section.file_size;
+    return true;
+  };
+
+  Section names;
+  if (!contents_of(section_at(header.shstrtab_section_index), &names)) {
+    return false;
+  }
+  for (intptr_t i = 0; i < header.num_section_headers; i++) {
+    const elf::SectionHeader section = section_at(i);
+    if (section.type != elf::SectionHeaderType::SHT_PROGBITS) continue;
+    if (static_cast<intptr_t>(section.name) >= names.size) return false;
+    const char* name = reinterpret_cast<const char*>(names.start) +
+                       section.name;
+    const intptr_t max_length = names.size - section.name;
+    Section* result = nullptr;
+    if (strncmp(name, ".debug_info", max_length) == 0) {
+      result = info;
+    } else if (strncmp(name, ".debug_abbrev", max_length) == 0) {
+      result = abbrev;
+    } else if (strncmp(name, ".debug_line", max_length) == 0) {
+      result = line;
+    }
+    if ((result != nullptr) && !contents_of(section, result)) return false;
+  }
+  return (info->start != nullptr) && (abbrev->start != nullptr) &&
+         (line->start != nullptr);
+}
+
+bool DwarfIndex::ReadAbbreviations(const Section& abbrev) {
+  DwarfReader reader(abbrev.start, abbrev.size);
+  while (!reader.at_end()) {
+    const intptr_t code = reader.uleb128();
+    if (code == 0) break;  // End of abbreviations.
+    const intptr_t tag = reader.uleb128();
+    const bool has_children = reader.u1() != 0;
+    abbreviations_.Add({code, tag, has_children, reader.Position()});
+    // Skip the attribute specifications.
+    while (!reader.failed()) {
+      const intptr_t attribute = reader.uleb128();
+      const intptr_t form = reader.uleb128();
+      if ((attribute == 0) && (form == 0)) break;
+    }
+    if (reader.failed()) return false;
+  }
+  return !reader.failed();
+}
+
+const DwarfIndex::Abbreviation* DwarfIndex::LookupAbbreviation(
+    intptr_t code) const {
+  for (intptr_t i = 0; i < abbreviations_.length(); i++) {
+    if (abbreviations_[i].code == code) return &abbreviations_[i];
+  }
+  return nullptr;
+}
+
+bool DwarfIndex::SkipAttribute(DwarfReader* reader, intptr_t form) {
+  switch (form) {
+    case DW_FORM_addr:
+      reader->addr();
+      break;
+    case DW_FORM_data1:
+    case DW_FORM_flag:
+      reader->u1();
+      break;
+    case DW_FORM_data2:
+      reader->u2();
+      break;
+    case DW_FORM_data4:
+    case DW_FORM_ref4:
+    case DW_FORM_sec_offset:
+      reader->u4();
+      break;
+    case DW_FORM_data8:
+      reader->Fixed(8);
+      break;
+    case DW_FORM_string:
+      reader->string();
+      break;
+    case DW_FORM_sdata:
+      reader->sleb128();
+      break;
+    case DW_FORM_udata:
+    case DW_FORM_ref_udata:
+      reader->uleb128();
+      break;
+    default:
+      return false;
+  }
+  return !reader->failed();
+}
+
+bool DwarfIndex::ReadDebugInfo(const Section& info, const Section& abbrev) {
+  DwarfReader reader(info.start, info.size);
+  // Compilation unit header. Offsets in DW_FORM_ref4 are relative to its
+  // start, which is also the start of the section since the VM only
+  // writes a single compilation unit.
+  const intptr_t unit_length = reader.u4();
+  const intptr_t unit_end = reader.Position() + unit_length;
+  const uint16_t version = reader.u2();
+  reader.u4();  // debug_abbrev_offset
+  const uint8_t address_size = reader.u1();
+  if (reader.failed() || (unit_end > info.size) || (version < 2) ||
+      (version > 4) || (address_size != compiler::target::kWordSize)) {
+    return false;
+  }
+
+  DwarfReader attributes(abbrev.start, abbrev.size);
+  intptr_t depth = 0;
+  // Depth of the enclosing concrete function, or -1 outside of one.
+  intptr_t function_depth = -1;
+  while (reader.Position() < unit_end) {
+    const uint64_t offset = reader.Position();
+    const intptr_t code = reader.uleb128();
+    if (reader.failed()) return false;
+    if (code == 0) {
+      // End of the children of the parent entry.
+      depth--;
+      if (depth <= function_depth) function_depth = -1;
+      continue;
+    }
+    const Abbreviation* abbreviation = LookupAbbreviation(code);
+    if (abbreviation == nullptr) return false;
+
+    const char* name = nullptr;
+    uint64_t origin = 0;
+    bool has_origin = false;
+    uword low_pc = 0;
+    uword high_pc = 0;
+    attributes.SetPosition(abbreviation->attributes_offset);
+    while (true) {
+      const intptr_t attribute = attributes.uleb128();
+      const intptr_t form = attributes.uleb128();
+      if (attributes.failed()) return false;
+      if ((attribute == 0) && (form == 0)) break;
+      if ((attribute == DW_AT_name) && (form == DW_FORM_string)) {
+        name = reader.string();
+      } else if ((attribute == DW_AT_abstract_origin) &&
+                 (form == DW_FORM_ref4)) {
+        origin = reader.u4();
+        has_origin = true;
+      } else if ((attribute == DW_AT_low_pc) && (form == DW_FORM_addr)) {
+        low_pc = reader.addr();
+      } else if ((attribute == DW_AT_high_pc) && (form == DW_FORM_addr)) {
+        high_pc = reader.addr();
+      } else if (!SkipAttribute(&reader, form)) {
+        return false;
+      }
+    }
+    if (reader.failed()) return false;
+
+    const intptr_t tag = abbreviation->tag;
+    if ((tag == DW_TAG_subprogram) && (name != nullptr)) {
+      // Abstract functions come before any concrete or inlined functions
+      // referring to them, in increasing offset order.
+      abstract_functions_.Add({offset, name});
+    } else if (((tag == DW_TAG_subprogram) ||
+                (tag == DW_TAG_inlined_subroutine)) &&
+               has_origin) {
+      if (tag == DW_TAG_subprogram) {
+        function_depth = depth;
+        roots_.Add({low_pc, functions_.length()});
+      } else if (function_depth < 0) {
+        return false;
+      }
+      const intptr_t inlining_depth =
+          (tag == DW_TAG_subprogram) ? 0 : depth - function_depth;
+      functions_.Add(
+          {low_pc, high_pc, LookupAbstractFunction(origin), inlining_depth});
+    }
+    if (abbreviation->has_children) depth++;
+  }
+
+  // Concrete functions are written in code order, but don't rely on it.
+  roots_.Sort([](const Root* a, const Root* b) {
+    if (a->start == b->start) return 0;
+    return (a->start < b->start) ? -1 : 1;
+  });
+  return true;
+}
+
+const char* DwarfIndex::LookupAbstractFunction(uint64_t offset) const {
+  intptr_t low = 0;
+  intptr_t high = abstract_functions_.length() - 1;
+  while (low <= high) {
+    const intptr_t mid = low + (high - low) / 2;
+    const uint64_t mid_offset = abstract_functions_[mid].offset;
+    if (mid_offset == offset) return abstract_functions_[mid].name;
+    if (mid_offset < offset) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  return "<unknown>";
+}
+
+bool DwarfIndex::ReadLineNumberProgram(const Section& line) {
+  DwarfReader reader(line.start, line.size);
+  // 6.2.4 The Line Number Program Header
+  const intptr_t unit_length = reader.u4();
+  const intptr_t unit_end = reader.Position() + unit_length;
+  const uint16_t version = reader.u2();
+  const intptr_t header_length = reader.u4();
+  const intptr_t program_start = reader.Position() + header_length;
+  const intptr_t minimum_instruction_length = reader.u1();
+  reader.u1();  // default_is_stmt
+  const int8_t line_base = static_cast<int8_t>(reader.u1());
+  const intptr_t line_range = reader.u1();
+  const intptr_t opcode_base = reader.u1();
+  if (reader.failed() || (unit_end > line.size) ||
+      (program_start > unit_end) || (version < 2) || (version > 4) ||
+      (line_range == 0) || (opcode_base == 0)) {
+    return false;
+  }
+  uint8_t standard_opcode_lengths[256];
+  for (intptr_t i = 1; i < opcode_base; i++) {
+    standard_opcode_lengths[i] = reader.u1();
+  }
+  if (version == 4) reader.u1();  // maximum_operations_per_instruction
+  // include_directories, which the VM doesn't use.
+  while (!reader.failed() && (*reader.string() != '\0')) {
+  }
+  // file_names. Files are 1-indexed, so add a placeholder for index 0.
+  files_.Add(nullptr);
+  while (!reader.failed()) {
+    const char* file = reader.string();
+    if (reader.failed() || (*file == '\0')) break;
+    reader.uleb128();  // Include directory index.
+    reader.uleb128();  // File modification time.
+    reader.uleb128();  // File length.
+    files_.Add(file);
+  }
+  if (reader.failed()) return false;
+
+  // 6.2.5 The Line Number Program
+  reader.SetPosition(program_start);
+  uword address = 0;
+  intptr_t file = 1;
+  intptr_t line_number = 1;
+  intptr_t column = 0;
+  while (!reader.failed() && (reader.Position() < unit_end)) {
+    const intptr_t opcode = reader.u1();
+    if (opcode >= opcode_base) {
+      // Special opcode.
+      const intptr_t adjusted = opcode - opcode_base;
+      address += (adjusted / line_range) * minimum_instruction_length;
+      line_number += line_base + (adjusted % line_range);
+      AddLineRow(address, file, line_number, column);
+      continue;
+    }
+    switch (opcode) {
+      case 0: {
+        // Extended opcode.
+        const intptr_t length = reader.uleb128();
+        const intptr_t end = reader.Position() + length;
+        const intptr_t extended_opcode = reader.u1();
+        if (extended_opcode == DW_LNE_end_sequence) {
+          AddLineRow(address, 0, 0, 0);
+          address = 0;
+          file = 1;
+          line_number = 1;
+          column = 0;
+        } else if (extended_opcode == DW_LNE_set_address) {
+          address = reader.addr();
+        }
+        reader.SetPosition(end);
+        break;
+      }
+      case DW_LNS_copy:
+        AddLineRow(address, file, line_number, column);
+        break;
+      case DW_LNS_advance_pc:
+        address += reader.uleb128() * minimum_instruction_length;
+        break;
+      case DW_LNS_advance_line:
+        line_number += reader.sleb128();
+        break;
+      case DW_LNS_set_file:
+        file = reader.uleb128();
+        break;
+      case DW_LNS_set_column:
+        column = reader.uleb128();
+        break;
+      case DW_LNS_const_add_pc:
+        address += ((255 - opcode_base) / line_range) *
+                   minimum_instruction_length;
+        break;
+      case DW_LNS_fixed_advance_pc:
+        address += reader.u2();
+        break;
+      default:
+        for (intptr_t i = 0; i < standard_opcode_lengths[opcode]; i++) {
+          reader.uleb128();
+        }
+        break;
+    }
+  }
+  if (reader.failed()) return false;
+
+  for (intptr_t i = 1; i < lines_.length(); i++) {
+    if (lines_[i - 1].address > lines_[i].address) {
+      lines_.Sort([](const LineRow* a, const LineRow* b) {
+        if (a->address == b->address) return 0;
+        return (a->address < b->address) ? -1 : 1;
+      });
+      break;
+    }
+  }
+  return true;
+}
+
+void DwarfIndex::AddLineRow(uword address,
+                            intptr_t file,
+                            intptr_t line,
+                            intptr_t column) {
+  if ((file < 0) || (file >= files_.length())) file = 0;
+  // A later row for the same address replaces the earlier one.
+  if (!lines_.is_empty() && (lines_.Last().address == address)) {
+    lines_.Last() = {address, file, line, column};
+  } else {
+    lines_.Add({address, file, line, column});
+  }
+}
+
+bool DwarfIndex::Lookup(uword address, DwarfSymbolizer::Location* location) {
+  CacheEntry* entry = &cache_[(address >> 2) & (kCacheSize - 1)];
+  if (entry->address != address) {
+    entry->address = address;
+    entry->location = DwarfSymbolizer::Location();
+    entry->found = DoLookup(address, &entry->location);
+  }
+  *location = entry->location;
+  return entry->found;
+}
+
+bool DwarfIndex::DoLookup(uword address,
+                          DwarfSymbolizer::Location* location) const {
+  // Find the last function starting at or before [address].
+  intptr_t low = 0;
+  intptr_t high = roots_.length() - 1;
+  intptr_t root = -1;
+  while (low <= high) {
+    const intptr_t mid = low + (high - low) / 2;
+    if (roots_[mid].start <= address) {
+      root = roots_[mid].index;
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  if ((root < 0) || (address >= functions_[root].end)) return false;
+
+  // Inlined functions follow their root in pre-order, so the innermost one
+  // containing [address] is the last containing one before the next root.
+  location->function = functions_[root].name;
+  intptr_t depth = 0;
+  for (intptr_t i = root + 1;
+       (i < functions_.length()) && (functions_[i].depth > 0); i++) {
+    const FunctionRange& inlined = functions_[i];
+    if ((inlined.depth == depth + 1) && (inlined.start <= address) &&
+        (address < inlined.end)) {
+      location->function = inlined.name;
+      depth = inlined.depth;
+    }
+  }
+
+  // Find the last line number row at or before [address].
+  low = 0;
+  high = lines_.length() - 1;
+  intptr_t row = -1;
+  while (low <= high) {
+    const intptr_t mid = low + (high - low) / 2;
+    if (lines_[mid].address <= address) {
+      row = mid;
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  if ((row >= 0) && (lines_[row].file != 0)) {
+    location->file = files_[lines_[row].file];
+    location->line = lines_[row].line;
+    location->column = lines_[row].column;
+  }
+  return true;
+}
+
+static Mutex* index_mutex_ = nullptr;
+// Null until the first lookup.
+static DwarfIndex* index_ = nullptr;
+static bool index_failed_ = false;
+
+void DwarfSymbolizer::Init() {
+  if (FLAG_dwarf_debug_info == nullptr) return;
+  ASSERT(index_mutex_ == nullptr);
+  index_mutex_ = new Mutex();
+}
+
+void DwarfSymbolizer::Cleanup() {
+  delete index_;
+  index_ = nullptr;
+  index_failed_ = false;
+  delete index_mutex_;
+  index_mutex_ = nullptr;
+}
+
+bool DwarfSymbolizer::IsEnabled() {
+  return index_mutex_ != nullptr;
+}
+
+bool DwarfSymbolizer::Lookup(uword address, Location* location) {
+  if (!IsEnabled()) return false;
+  MutexLocker ml(index_mutex_);
+  if (index_ == nullptr) {
+    if (index_failed_) return false;
+    index_ = new DwarfIndex();
+    if (!index_->Build(FLAG_dwarf_debug_info)) {
+      delete index_;
+      index_ = nullptr;
+      index_failed_ = true;
+      return false;
+    }
+  }
+  return index_->Lookup(address, location);
+}
+
+}  // namespace dart
+
+#else  // defined(DART_PRECOMPILED_RUNTIME)
+
+namespace dart {
+
+void DwarfSymbolizer::Init() {}
+
+void DwarfSymbolizer::Cleanup() {}
+
+bool DwarfSymbolizer::IsEnabled() {
+  return false;
+}
+
+bool DwarfSymbolizer::Lookup(uword address, Location* location) {
+  return false;
+}
+
+}  // namespace dart
+
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
@@ -0,0 +1,42 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_DWARF_SYMBOLIZER_H_
+#define RUNTIME_VM_DWARF_SYMBOLIZER_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+// Symbolizes addresses in DWARF stack traces in-process using the separate
+// debugging information written by gen_snapshot --save-debugging-info.
+//
+// The debugging information is only read, and the index of functions and
+// line number rows only built, when the first address is looked up.
+class DwarfSymbolizer : public AllStatic {
+ public:
+  struct Location {
+    // The innermost (possibly inlined) function containing the address.
+    const char* function = nullptr;
+    // Source position of the address, if the line number program has one.
+    const char* file = nullptr;
+    intptr_t line = 0;
+    intptr_t column = 0;
+  };
+
+  static void Init();
+  static void Cleanup();
+
+  // Whether a debugging information file was given with --dwarf_debug_info.
+  static bool IsEnabled();
+
+  // Looks up [address], a relocated address as printed after 'virt' in
+  // DWARF stack traces. The returned strings stay valid until Cleanup.
+  static bool Lookup(uword address, Location* location);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_DWARF_SYMBOLIZER_H_
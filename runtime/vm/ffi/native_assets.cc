@@ -5,7 +5,9 @@
 #include "vm/ffi/native_assets.h"
 
 #include "vm/hash_table.h"
+#include "vm/lockers.h"
 #include "vm/object_store.h"
+#include "vm/os.h"
 #include "vm/symbols.h"
 
 namespace dart {
@@ -81,4 +83,71 @@ ArrayPtr GetNativeAssetsMap(Thread* thread) {
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 }
 
+FfiNativeCache::~FfiNativeCache() {
+  for (Map* map : {&libraries_, &symbols_}) {
+    auto it = map->GetIterator();
+    while (auto* pair = it.Next()) {
+      free(const_cast<char*>(pair->key));
+    }
+  }
+}
+
+// Symbols cannot contain spaces, so the key is unambiguous.
+static char* SymbolKey(const char* asset, const char* symbol) {
+  return OS::SCreate(/*use malloc*/ nullptr, "%s %s", asset, symbol);
+}
+
+bool FfiNativeCache::Lookup(const Map& map, const char* key, intptr_t* value) {
+  MutexLocker ml(&mutex_);
+  auto* pair = map.Lookup(key);
+  if (pair == nullptr) {
+    return false;
+  }
+  *value = pair->value;
+  return true;
+}
+
+void FfiNativeCache::Insert(Map* map, char* key, intptr_t value) {
+  MutexLocker ml(&mutex_);
+  if (map->Lookup(key) != nullptr) {
+    // Resolved concurrently by another isolate.
+    free(key);
+    return;
+  }
+  map->Insert({key, value});
+}
+
+bool FfiNativeCache::LookupLibrary(const char* asset, void** handle) {
+  intptr_t value;
+  if (!Lookup(libraries_, asset, &value)) {
+    return false;
+  }
+  *handle = reinterpret_cast<void*>(value);
+  return true;
+}
+
+void FfiNativeCache::InsertLibrary(const char* asset, void* handle) {
+  Insert(&libraries_, Utils::StrDup(asset), reinterpret_cast<intptr_t>(handle));
+}
+
+bool FfiNativeCache::LookupSymbol(const char* asset,
+                                  const char* symbol,
+                                  uword* address) {
+  char* key = SymbolKey(asset, symbol);
+  intptr_t value;
+  const bool found = Lookup(symbols_, key, &value);
+  free(key);
+  if (!found) {
+    return false;
+  }
+  *address = static_cast<uword>(value);
+  return true;
+}
+
+void FfiNativeCache::InsertSymbol(const char* asset,
+                                  const char* symbol,
+                                  uword address) {
+  Insert(&symbols_, SymbolKey(asset, symbol), static_cast<intptr_t>(address));
+}
+
 }  // namespace dart
@@ -5,7 +5,9 @@
 #ifndef RUNTIME_VM_FFI_NATIVE_ASSETS_H_
 #define RUNTIME_VM_FFI_NATIVE_ASSETS_H_
 
+#include "vm/hash_map.h"
 #include "vm/hash_table.h"
+#include "vm/os_thread.h"
 #include "vm/tagged_pointer.h"
 #include "vm/thread.h"
 
@@ -37,6 +39,38 @@ typedef UnorderedHashMap<NativeAssetsMapTraits> NativeAssetsMap;
 // pre-populated from the aotsnapshot.
 ArrayPtr GetNativeAssetsMap(Thread* thread);
 
+// Caches the dynamic libraries of native assets and the addresses of @Native
+// functions resolved through them or through the process.
+//
+// Shared by the isolates of a group, so that only the first isolate to call
+// a native pays for dlopen and dlsym, and each asset is opened only once.
+class FfiNativeCache {
+ public:
+  FfiNativeCache() {}
+  ~FfiNativeCache();
+
+  // Whether the library of [asset] was loaded, returning it in [handle].
+  bool LookupLibrary(const char* asset, void** handle);
+  void InsertLibrary(const char* asset, void* handle);
+
+  // Whether [symbol] was resolved in [asset], returning it in [address].
+  bool LookupSymbol(const char* asset, const char* symbol, uword* address);
+  void InsertSymbol(const char* asset, const char* symbol, uword address);
+
+ private:
+  using Map = MallocDirectChainedHashMap<CStringIntMapKeyValueTrait>;
+
+  bool Lookup(const Map& map, const char* key, intptr_t* value);
+  // Takes ownership of the malloced [key].
+  void Insert(Map* map, char* key, intptr_t value);
+
+  Mutex mutex_;
+  Map libraries_;
+  Map symbols_;
+
+  DISALLOW_COPY_AND_ASSIGN(FfiNativeCache);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_FFI_NATIVE_ASSETS_H_
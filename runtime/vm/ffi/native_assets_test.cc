@@ -0,0 +1,38 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/ffi/native_assets.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+VM_UNIT_TEST_CASE(FfiNativeCache) {
+  FfiNativeCache cache;
+
+  void* handle = nullptr;
+  EXPECT(!cache.LookupLibrary("package:a/a.dart", &handle));
+  // The process library may have a null handle.
+  cache.InsertLibrary("package:a/a.dart", nullptr);
+  handle = reinterpret_cast<void*>(1);
+  EXPECT(cache.LookupLibrary("package:a/a.dart", &handle));
+  EXPECT(handle == nullptr);
+
+  uword address = 0;
+  EXPECT(!cache.LookupSymbol("package:a/a.dart", "sum", &address));
+  cache.InsertSymbol("package:a/a.dart", "sum", 0x1000);
+  cache.InsertSymbol("package:b/b.dart", "sum", 0x2000);
+  EXPECT(cache.LookupSymbol("package:a/a.dart", "sum", &address));
+  EXPECT_EQ(0x1000u, address);
+  EXPECT(cache.LookupSymbol("package:b/b.dart", "sum", &address));
+  EXPECT_EQ(0x2000u, address);
+
+  // The first resolution wins.
+  cache.InsertSymbol("package:a/a.dart", "sum", 0x3000);
+  EXPECT(cache.LookupSymbol("package:a/a.dart", "sum", &address));
+  EXPECT_EQ(0x1000u, address);
+  EXPECT(!cache.LookupSymbol("package:a/a.dart", "product", &address));
+}
+
+}  // namespace dart
@@ -0,0 +1,306 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/ffi_callback_listener.h"
+
+#include <utility>
+
+#include "platform/assert.h"
+#include "vm/class_id.h"
+#include "vm/message.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/port.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+static constexpr intptr_t kNumSlots =
+    (FfiCallbackListener::kMaxArguments + 1) *
+    FfiCallbackListener::kSlotsPerArity;
+
+namespace {
+
+struct Slot {
+  std::atomic<FfiCallbackListener*> listener;
+  // Native threads currently inside the trampoline of this slot.
+  std::atomic<intptr_t> in_flight;
+};
+
+template <intptr_t>
+using Word = uword;
+
+template <intptr_t kSlot, typename Indices>
+struct Trampoline;
+
+// The native function of a slot, taking one word per argument.
+template <intptr_t kSlot, intptr_t... kIndices>
+struct Trampoline<kSlot, std::integer_sequence<intptr_t, kIndices...>> {
+  static void Call(Word<kIndices>... arguments) {
+    const uword values[] = {arguments..., 0};
+    FfiCallbackListener::Enqueue(kSlot, values);
+  }
+};
+
+template <intptr_t kArity, typename Indices>
+struct EntryPoints;
+
+template <intptr_t kArity, intptr_t... kIndices>
+struct EntryPoints<kArity, std::integer_sequence<intptr_t, kIndices...>> {
+  using Parameters = std::make_integer_sequence<intptr_t, kArity>;
+  using Entry = decltype(&Trampoline<0, Parameters>::Call);
+
+  static constexpr Entry table[] = {
+      &Trampoline<kArity * FfiCallbackListener::kSlotsPerArity + kIndices,
+                  Parameters>::Call...};
+};
+
+template <intptr_t kArity>
+uword EntryPointAt(intptr_t index) {
+  using Table =
+      EntryPoints<kArity, std::make_integer_sequence<
+                              intptr_t, FfiCallbackListener::kSlotsPerArity>>;
+  return reinterpret_cast<uword>(Table::table[index]);
+}
+
+}  // namespace
+
+static Slot slots[kNumSlots];
+
+FfiCallbackListener::~FfiCallbackListener() {
+  Call* call = pending_.exchange(nullptr, std::memory_order_acquire);
+  while (call != nullptr) {
+    Call* next = call->next;
+    free(call);
+    call = next;
+  }
+}
+
+bool FfiCallbackListener::ArgumentKindOf(intptr_t cid, ArgumentKind* kind) {
+  switch (cid) {
+    case kFfiInt8Cid:
+      *kind = kInt8;
+      return true;
+    case kFfiInt16Cid:
+      *kind = kInt16;
+      return true;
+    case kFfiInt32Cid:
+      *kind = kInt32;
+      return true;
+    case kFfiUint8Cid:
+      *kind = kUint8;
+      return true;
+    case kFfiUint16Cid:
+      *kind = kUint16;
+      return true;
+    case kFfiUint32Cid:
+      *kind = kUint32;
+      return true;
+    case kFfiBoolCid:
+      *kind = kBool;
+      return true;
+    case kPointerCid:
+      *kind = kPointer;
+      return true;
+#if defined(ARCH_IS_64_BIT)
+    // On 32-bit architectures these take two words.
+    case kFfiInt64Cid:
+      *kind = kInt64;
+      return true;
+    case kFfiUint64Cid:
+      *kind = kUint64;
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+ObjectPtr FfiCallbackListener::ArgumentToObject(ArgumentKind kind,
+                                                uword word) {
+  switch (kind) {
+    case kInt8:
+      return Integer::New(static_cast<int8_t>(word));
+    case kInt16:
+      return Integer::New(static_cast<int16_t>(word));
+    case kInt32:
+      return Integer::New(static_cast<int32_t>(word));
+    case kUint8:
+      return Integer::New(static_cast<uint8_t>(word));
+    case kUint16:
+      return Integer::New(static_cast<uint16_t>(word));
+    case kUint32:
+      return Integer::New(static_cast<uint32_t>(word));
+    case kInt64:
+    case kUint64:
+      return Integer::New(static_cast<int64_t>(word));
+    case kBool:
+      return Bool::Get(static_cast<uint8_t>(word) != 0).ptr();
+    case kPointer:
+      return Pointer::New(word);
+  }
+  UNREACHABLE();
+  return Object::null();
+}
+
+intptr_t FfiCallbackListener::Create(Zone* zone,
+                                     Isolate* isolate,
+                                     const FunctionType& signature,
+                                     Dart_Port port,
+                                     const char** error) {
+  const AbstractType& result_type =
+      AbstractType::Handle(zone, signature.result_type());
+  if (!result_type.IsType() || result_type.type_class_id() != kFfiVoidCid) {
+    *error = "Native callback listeners must return Void.";
+    return -1;
+  }
+  const intptr_t first = signature.num_implicit_parameters();
+  const intptr_t arity = signature.NumParameters() - first;
+  if (arity > kMaxArguments) {
+    *error = "Native callback listeners take at most 6 arguments.";
+    return -1;
+  }
+
+  FfiCallbackListener* listener =
+      new FfiCallbackListener(isolate, port, arity);
+  AbstractType& type = AbstractType::Handle(zone);
+  for (intptr_t i = 0; i < arity; i++) {
+    type = signature.ParameterTypeAt(first + i);
+    if (!type.IsType() ||
+        !ArgumentKindOf(type.type_class_id(), &listener->kinds_[i])) {
+      delete listener;
+      *error =
+          "Native callback listeners only take integer, Bool and Pointer "
+          "arguments.";
+      return -1;
+    }
+  }
+
+  for (intptr_t i = 0; i < kSlotsPerArity; i++) {
+    const intptr_t slot = arity * kSlotsPerArity + i;
+    FfiCallbackListener* expected = nullptr;
+    if (slots[slot].listener.compare_exchange_strong(expected, listener)) {
+      return slot;
+    }
+  }
+  delete listener;
+  *error = "Too many open native callback listeners.";
+  return -1;
+}
+
+uword FfiCallbackListener::EntryPoint(Isolate* isolate, intptr_t slot) {
+  ASSERT(0 <= slot && slot < kNumSlots);
+  ASSERT(slots[slot].listener.load()->isolate_ == isolate);
+  const intptr_t index = slot % kSlotsPerArity;
+  switch (slot / kSlotsPerArity) {
+    case 0:
+      return EntryPointAt<0>(index);
+    case 1:
+      return EntryPointAt<1>(index);
+    case 2:
+      return EntryPointAt<2>(index);
+    case 3:
+      return EntryPointAt<3>(index);
+    case 4:
+      return EntryPointAt<4>(index);
+    case 5:
+      return EntryPointAt<5>(index);
+    case 6:
+      return EntryPointAt<6>(index);
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+void FfiCallbackListener::Enqueue(intptr_t slot, const uword* arguments) {
+  // Close waits for in_flight to drop to zero after clearing the listener,
+  // so the listener cannot be deleted while we use it.
+  slots[slot].in_flight.fetch_add(1);
+  FfiCallbackListener* listener = slots[slot].listener.load();
+  if (listener != nullptr) {
+    Call* call = reinterpret_cast<Call*>(malloc(sizeof(Call)));
+    for (intptr_t i = 0; i < listener->arity_; i++) {
+      call->arguments[i] = arguments[i];
+    }
+    listener->Push(call);
+  }
+  slots[slot].in_flight.fetch_sub(1);
+}
+
+void FfiCallbackListener::Push(Call* call) {
+  Call* head = pending_.load(std::memory_order_relaxed);
+  do {
+    call->next = head;
+  } while (!pending_.compare_exchange_weak(
+      head, call, std::memory_order_release, std::memory_order_relaxed));
+  if (head == nullptr) {
+    // First call of a batch. Later calls are picked up by the same Drain.
+    PortMap::PostMessage(
+        Message::New(port_, Smi::New(0), Message::kNormalPriority));
+  }
+}
+
+ArrayPtr FfiCallbackListener::Drain(Isolate* isolate, intptr_t slot) {
+  ASSERT(0 <= slot && slot < kNumSlots);
+  FfiCallbackListener* listener = slots[slot].listener.load();
+  ASSERT(listener != nullptr && listener->isolate_ == isolate);
+
+  // Reverse the list to deliver calls in the order they were made.
+  Call* call = listener->pending_.exchange(nullptr, std::memory_order_acquire);
+  Call* oldest = nullptr;
+  intptr_t count = 0;
+  while (call != nullptr) {
+    Call* next = call->next;
+    call->next = oldest;
+    oldest = call;
+    call = next;
+    count++;
+  }
+
+  Zone* zone = Thread::Current()->zone();
+  const Array& calls = Array::Handle(zone, Array::New(count));
+  Array& arguments = Array::Handle(zone);
+  Object& value = Object::Handle(zone);
+  call = oldest;
+  for (intptr_t i = 0; i < count; i++) {
+    arguments = Array::New(listener->arity_);
+    for (intptr_t j = 0; j < listener->arity_; j++) {
+      value = ArgumentToObject(listener->kinds_[j], call->arguments[j]);
+      arguments.SetAt(j, value);
+    }
+    calls.SetAt(i, arguments);
+    Call* next = call->next;
+    free(call);
+    call = next;
+  }
+  return calls.ptr();
+}
+
+void FfiCallbackListener::Release(intptr_t slot) {
+  FfiCallbackListener* listener = slots[slot].listener.exchange(nullptr);
+  if (listener == nullptr) {
+    return;
+  }
+  while (slots[slot].in_flight.load() != 0) {
+    OS::SleepMicros(10);
+  }
+  delete listener;
+}
+
+void FfiCallbackListener::Close(Isolate* isolate, intptr_t slot) {
+  ASSERT(0 <= slot && slot < kNumSlots);
+  ASSERT(slots[slot].listener.load()->isolate_ == isolate);
+  Release(slot);
+}
+
+void FfiCallbackListener::CloseAll(Isolate* isolate) {
+  for (intptr_t slot = 0; slot < kNumSlots; slot++) {
+    FfiCallbackListener* listener = slots[slot].listener.load();
+    if (listener != nullptr && listener->isolate_ == isolate) {
+      Release(slot);
+    }
+  }
+}
+
+}  // namespace dart
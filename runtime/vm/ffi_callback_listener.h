@@ -0,0 +1,116 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_FFI_CALLBACK_LISTENER_H_
+#define RUNTIME_VM_FFI_CALLBACK_LISTENER_H_
+
+#include <atomic>
+
+#include "include/dart_api.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/tagged_pointer.h"
+
+namespace dart {
+
+class FunctionType;
+class Isolate;
+class String;
+class Zone;
+
+// A native callback that may be invoked from any thread, see
+// NativeCallbackListener in dart:ffi.
+//
+// Calling the native function does not run Dart code. The arguments are
+// queued and the call returns immediately, without taking any lock and
+// without needing a Thread. The owning isolate is woken by a message to its
+// listener port, and then takes all queued calls at once with Drain. Only
+// the first call of a batch posts a message, so a burst of calls costs a
+// single trip through the isolate's message queue.
+//
+// Native functions are handed out from a fixed pool of C++ trampolines, one
+// per (arity, slot) pair. Since the trampolines only receive integer
+// registers, the signature must return void and take at most kMaxArguments
+// integer, bool or pointer arguments.
+class FfiCallbackListener {
+ public:
+  static constexpr intptr_t kMaxArguments = 6;
+  static constexpr intptr_t kSlotsPerArity = 64;
+
+  // Creates a listener for the native [signature] that wakes up [port] of
+  // [isolate]. Returns its slot, or -1 with [error] set if the signature is
+  // not supported or all trampolines of its arity are in use.
+  static intptr_t Create(Zone* zone,
+                         Isolate* isolate,
+                         const FunctionType& signature,
+                         Dart_Port port,
+                         const char** error);
+
+  // The native function that queues calls to the listener in [slot].
+  static uword EntryPoint(Isolate* isolate, intptr_t slot);
+
+  // Takes all calls queued for the listener in [slot], oldest first, as an
+  // array of argument arrays.
+  static ArrayPtr Drain(Isolate* isolate, intptr_t slot);
+
+  // Releases the listener in [slot]. Waits for native threads still inside
+  // its trampoline, and drops calls that were not drained yet.
+  static void Close(Isolate* isolate, intptr_t slot);
+
+  // Releases all listeners of [isolate], on shutdown.
+  static void CloseAll(Isolate* isolate);
+
+  // Called by the trampolines.
+  static void Enqueue(intptr_t slot, const uword* arguments);
+
+  // How an argument word is converted to a Dart value. Also used by
+  // FfiIsolateGroupCallback.
+  enum ArgumentKind {
+    kInt8,
+    kInt16,
+    kInt32,
+    kInt64,
+    kUint8,
+    kUint16,
+    kUint32,
+    kUint64,
+    kBool,
+    kPointer,
+  };
+
+  // Returns whether arguments of the native type [cid] fit in one word, and
+  // if so sets [kind].
+  static bool ArgumentKindOf(intptr_t cid, ArgumentKind* kind);
+
+  // Converts the argument [word] of [kind] to a Dart value.
+  static ObjectPtr ArgumentToObject(ArgumentKind kind, uword word);
+
+ private:
+  struct Call {
+    Call* next;
+    uword arguments[kMaxArguments];
+  };
+
+  FfiCallbackListener(Isolate* isolate, Dart_Port port, intptr_t arity)
+      : isolate_(isolate), port_(port), arity_(arity) {}
+  ~FfiCallbackListener();
+
+  static void Release(intptr_t slot);
+
+  void Push(Call* call);
+
+  Isolate* const isolate_;
+  const Dart_Port port_;
+  const intptr_t arity_;
+  ArgumentKind kinds_[kMaxArguments];
+
+  // Calls not yet drained, newest first.
+  std::atomic<Call*> pending_ = {nullptr};
+
+  DISALLOW_COPY_AND_ASSIGN(FfiCallbackListener);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_FFI_CALLBACK_LISTENER_H_
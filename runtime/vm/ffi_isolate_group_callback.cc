@@ -0,0 +1,336 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/ffi_isolate_group_callback.h"
+
+#include <atomic>
+#include <utility>
+
+#include "include/dart_api.h"
+#include "platform/assert.h"
+#include "vm/class_id.h"
+#include "vm/dart.h"
+#include "vm/dart_api_impl.h"
+#include "vm/dart_api_state.h"
+#include "vm/dart_entry.h"
+#include "vm/heap/safepoint.h"
+#include "vm/isolate.h"
+#include "vm/lockers.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/thread.h"
+#include "vm/thread_pool.h"
+
+namespace dart {
+
+static constexpr intptr_t kNumSlots =
+    (FfiIsolateGroupCallback::kMaxArguments + 1) *
+    FfiIsolateGroupCallback::kSlotsPerArity;
+
+namespace {
+
+struct CallbackSlot {
+  std::atomic<FfiIsolateGroupCallback*> callback;
+  // Native threads currently inside the trampoline of this slot.
+  std::atomic<intptr_t> in_flight;
+};
+
+template <intptr_t>
+using Word = uword;
+
+template <intptr_t kSlot, typename Indices>
+struct Trampoline;
+
+// The native function of a slot, taking one word per argument. The result is
+// ignored by callers of native functions returning void.
+template <intptr_t kSlot, intptr_t... kIndices>
+struct Trampoline<kSlot, std::integer_sequence<intptr_t, kIndices...>> {
+  static uword Call(Word<kIndices>... arguments) {
+    const uword values[] = {arguments..., 0};
+    return FfiIsolateGroupCallback::Invoke(kSlot, values);
+  }
+};
+
+template <intptr_t kArity, typename Indices>
+struct EntryPoints;
+
+template <intptr_t kArity, intptr_t... kIndices>
+struct EntryPoints<kArity, std::integer_sequence<intptr_t, kIndices...>> {
+  using Parameters = std::make_integer_sequence<intptr_t, kArity>;
+  using Entry = decltype(&Trampoline<0, Parameters>::Call);
+
+  static constexpr Entry table[] = {
+      &Trampoline<kArity * FfiIsolateGroupCallback::kSlotsPerArity + kIndices,
+                  Parameters>::Call...};
+};
+
+template <intptr_t kArity>
+uword EntryPointAt(intptr_t index) {
+  using Table = EntryPoints<
+      kArity, std::make_integer_sequence<
+                  intptr_t, FfiIsolateGroupCallback::kSlotsPerArity>>;
+  return reinterpret_cast<uword>(Table::table[index]);
+}
+
+// Shuts down helper isolates which are no longer needed. Runs on the VM
+// thread pool, since the thread closing the callback is inside an isolate.
+class ShutdownHelperIsolatesTask : public ThreadPool::Task {
+ public:
+  explicit ShutdownHelperIsolatesTask(MallocGrowableArray<Isolate*>* isolates)
+      : isolates_(isolates) {}
+  ~ShutdownHelperIsolatesTask() { delete isolates_; }
+
+  virtual void Run() {
+    for (intptr_t i = 0; i < isolates_->length(); i++) {
+      Dart_EnterIsolate(Api::CastIsolate(isolates_->At(i)));
+      Dart_ShutdownIsolate();
+    }
+  }
+
+ private:
+  MallocGrowableArray<Isolate*>* isolates_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShutdownHelperIsolatesTask);
+};
+
+}  // namespace
+
+static CallbackSlot slots[kNumSlots];
+
+FfiIsolateGroupCallback::~FfiIsolateGroupCallback() {
+  if (target_ != nullptr) {
+    isolate_->group()->api_state()->FreePersistentHandle(target_);
+  }
+  if (idle_isolates_.length() > 0) {
+    auto isolates = new MallocGrowableArray<Isolate*>();
+    for (intptr_t i = 0; i < idle_isolates_.length(); i++) {
+      isolates->Add(idle_isolates_[i]);
+    }
+    Dart::thread_pool()->Run<ShutdownHelperIsolatesTask>(isolates);
+  }
+}
+
+intptr_t FfiIsolateGroupCallback::Create(Zone* zone,
+                                         Isolate* isolate,
+                                         const FunctionType& signature,
+                                         const Function& target,
+                                         const char** error) {
+  const intptr_t first = signature.num_implicit_parameters();
+  const intptr_t arity = signature.NumParameters() - first;
+  if (arity > kMaxArguments) {
+    *error = "Isolate group callbacks take at most 6 arguments.";
+    return -1;
+  }
+  if (!target.AreValidArgumentCounts(0, arity, 0, nullptr)) {
+    *error = "The callback does not take the arguments of the signature.";
+    return -1;
+  }
+
+  FfiIsolateGroupCallback* callback =
+      new FfiIsolateGroupCallback(isolate, arity);
+  AbstractType& type = AbstractType::Handle(zone);
+  for (intptr_t i = 0; i < arity; i++) {
+    type = signature.ParameterTypeAt(first + i);
+    if (!type.IsType() || !FfiCallbackListener::ArgumentKindOf(
+                              type.type_class_id(), &callback->kinds_[i])) {
+      delete callback;
+      *error =
+          "Isolate group callbacks only take integer, Bool and Pointer "
+          "arguments.";
+      return -1;
+    }
+  }
+  type = signature.result_type();
+  ArgumentKind kind;
+  if (type.IsType() && type.type_class_id() == kFfiVoidCid) {
+    callback->result_kind_ = kVoidResult;
+  } else if (type.IsType() && FfiCallbackListener::ArgumentKindOf(
+                                  type.type_class_id(), &kind)) {
+    callback->result_kind_ = kind == FfiCallbackListener::kBool ? kBoolResult
+                             : kind == FfiCallbackListener::kPointer
+                                 ? kPointerResult
+                                 : kIntegerResult;
+  } else {
+    delete callback;
+    *error =
+        "Isolate group callbacks only return Void, integer, Bool and Pointer "
+        "types.";
+    return -1;
+  }
+  callback->target_ = isolate->group()->api_state()->AllocatePersistentHandle();
+  callback->target_->set_ptr(target);
+
+  for (intptr_t i = 0; i < kSlotsPerArity; i++) {
+    const intptr_t slot = arity * kSlotsPerArity + i;
+    FfiIsolateGroupCallback* expected = nullptr;
+    if (slots[slot].callback.compare_exchange_strong(expected, callback)) {
+      return slot;
+    }
+  }
+  delete callback;
+  *error = "Too many open isolate group callbacks.";
+  return -1;
+}
+
+uword FfiIsolateGroupCallback::EntryPoint(Isolate* isolate, intptr_t slot) {
+  ASSERT(0 <= slot && slot < kNumSlots);
+  ASSERT(slots[slot].callback.load()->isolate_ == isolate);
+  const intptr_t index = slot % kSlotsPerArity;
+  switch (slot / kSlotsPerArity) {
+    case 0:
+      return EntryPointAt<0>(index);
+    case 1:
+      return EntryPointAt<1>(index);
+    case 2:
+      return EntryPointAt<2>(index);
+    case 3:
+      return EntryPointAt<3>(index);
+    case 4:
+      return EntryPointAt<4>(index);
+    case 5:
+      return EntryPointAt<5>(index);
+    case 6:
+      return EntryPointAt<6>(index);
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+uword FfiIsolateGroupCallback::Invoke(intptr_t slot, const uword* arguments) {
+  // Close waits for in_flight to drop to zero after clearing the callback,
+  // so the callback cannot be deleted while we use it.
+  slots[slot].in_flight.fetch_add(1);
+  FfiIsolateGroupCallback* callback = slots[slot].callback.load();
+  if (callback == nullptr) {
+    FATAL("Called an isolate group callback after it was closed.");
+  }
+  uword result;
+  Thread* thread = Thread::Current();
+  if (thread != nullptr && thread->isolate() != nullptr) {
+    if (thread->isolate_group() != callback->isolate_->group()) {
+      FATAL("Called an isolate group callback from another isolate group.");
+    }
+    if (thread->execution_state() != Thread::kThreadInNative) {
+      FATAL("Called an isolate group callback from a leaf call.");
+    }
+    result = callback->Run(thread, arguments);
+  } else {
+    Isolate* isolate = callback->EnterHelperIsolate();
+    result = callback->Run(Thread::Current(), arguments);
+    callback->ExitHelperIsolate(isolate);
+  }
+  slots[slot].in_flight.fetch_sub(1);
+  return result;
+}
+
+Isolate* FfiIsolateGroupCallback::EnterHelperIsolate() {
+  Isolate* isolate = nullptr;
+  {
+    MutexLocker ml(&mutex_);
+    if (idle_isolates_.length() > 0) {
+      isolate = idle_isolates_.RemoveLast();
+    }
+  }
+  if (isolate != nullptr) {
+    Dart_EnterIsolate(Api::CastIsolate(isolate));
+    return isolate;
+  }
+
+  char* error = nullptr;
+  isolate = CreateWithinExistingIsolateGroup(
+      isolate_->group(), "isolate-group-callback", &error);
+  if (isolate == nullptr) {
+    FATAL("Failed to create a helper isolate: %s", error);
+  }
+  auto initialize_callback = Isolate::InitializeCallback();
+  if (initialize_callback != nullptr) {
+    void* isolate_data = nullptr;
+    if (!initialize_callback(&isolate_data, &error)) {
+      FATAL("Failed to initialize a helper isolate: %s", error);
+    }
+    isolate->set_init_callback_data(isolate_data);
+  }
+  const char* runnable_error = isolate->MakeRunnable();
+  if (runnable_error != nullptr) {
+    FATAL("Failed to run a helper isolate: %s", runnable_error);
+  }
+  return isolate;
+}
+
+void FfiIsolateGroupCallback::ExitHelperIsolate(Isolate* isolate) {
+  Dart_ExitIsolate();
+  MutexLocker ml(&mutex_);
+  idle_isolates_.Add(isolate);
+}
+
+uword FfiIsolateGroupCallback::Run(Thread* thread, const uword* arguments) {
+  TransitionNativeToVM transition(thread);
+  StackZone stack_zone(thread);
+  HandleScope handle_scope(thread);
+  Zone* zone = thread->zone();
+
+  const auto& target =
+      Function::Handle(zone, Function::RawCast(target_->ptr()));
+  const auto& dart_arguments = Array::Handle(zone, Array::New(arity_));
+  auto& value = Object::Handle(zone);
+  for (intptr_t i = 0; i < arity_; i++) {
+    value = FfiCallbackListener::ArgumentToObject(kinds_[i], arguments[i]);
+    dart_arguments.SetAt(i, value);
+  }
+  const auto& result =
+      Object::Handle(zone, DartEntry::InvokeFunction(target, dart_arguments));
+  if (result.IsError()) {
+    // There is no Dart caller to pass the error on to.
+    OS::PrintErr("Unhandled exception in isolate group callback:\n%s\n",
+                 Error::Cast(result).ToErrorCString());
+    return 0;
+  }
+  switch (result_kind_) {
+    case kVoidResult:
+      return 0;
+    case kIntegerResult:
+      return result.IsInteger()
+                 ? static_cast<uword>(Integer::Cast(result).AsInt64Value())
+                 : 0;
+    case kBoolResult:
+      return result.ptr() == Bool::True().ptr() ? 1 : 0;
+    case kPointerResult:
+      return result.IsPointer() ? Pointer::Cast(result).NativeAddress() : 0;
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+void FfiIsolateGroupCallback::Release(Thread* thread, intptr_t slot) {
+  FfiIsolateGroupCallback* callback = slots[slot].callback.exchange(nullptr);
+  if (callback == nullptr) {
+    return;
+  }
+  {
+    // Calls in progress in other isolates of the group may need this thread
+    // to reach a safepoint before they can finish.
+    TransitionVMToNative transition(thread);
+    while (slots[slot].in_flight.load() != 0) {
+      OS::SleepMicros(10);
+    }
+  }
+  delete callback;
+}
+
+void FfiIsolateGroupCallback::Close(Thread* thread, intptr_t slot) {
+  ASSERT(0 <= slot && slot < kNumSlots);
+  ASSERT(slots[slot].callback.load()->isolate_ == thread->isolate());
+  Release(thread, slot);
+}
+
+void FfiIsolateGroupCallback::CloseAll(Thread* thread) {
+  for (intptr_t slot = 0; slot < kNumSlots; slot++) {
+    FfiIsolateGroupCallback* callback = slots[slot].callback.load();
+    if (callback != nullptr && callback->isolate_ == thread->isolate()) {
+      Release(thread, slot);
+    }
+  }
+}
+
+}  // namespace dart
@@ -0,0 +1,106 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_FFI_ISOLATE_GROUP_CALLBACK_H_
+#define RUNTIME_VM_FFI_ISOLATE_GROUP_CALLBACK_H_
+
+#include "vm/allocation.h"
+#include "vm/ffi_callback_listener.h"
+#include "vm/globals.h"
+#include "vm/growable_array.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+class Function;
+class FunctionType;
+class Isolate;
+class IsolateGroup;
+class PersistentHandle;
+class Thread;
+class Zone;
+
+// A native callback that runs a static Dart function synchronously on any
+// thread, see IsolateGroupCallback in dart:ffi.
+//
+// A call from a thread that is inside an isolate of the group, for example
+// a native function called through FFI, runs the function in that isolate.
+// Any other thread borrows a helper isolate of the group for the duration
+// of the call. Helper isolates share the program structure, code and class
+// table of the group, so creating one only sets up its own heap state and
+// statics. Idle helper isolates are pooled, so a native thread pool keeps
+// reusing at most one helper isolate per thread, and runs Dart code on all
+// of them in parallel.
+//
+// As for FfiCallbackListener, native functions are handed out from a fixed
+// pool of C++ trampolines and only take integer, bool or pointer arguments.
+// The result is returned in the integer register, so it must be void or of
+// one of the argument types.
+class FfiIsolateGroupCallback {
+ public:
+  static constexpr intptr_t kMaxArguments = FfiCallbackListener::kMaxArguments;
+  static constexpr intptr_t kSlotsPerArity = 16;
+
+  // Creates a callback running [target] for the native [signature], owned
+  // by [isolate]. Returns its slot, or -1 with [error] set if the signature
+  // is not supported or all trampolines of its arity are in use.
+  static intptr_t Create(Zone* zone,
+                         Isolate* isolate,
+                         const FunctionType& signature,
+                         const Function& target,
+                         const char** error);
+
+  // The native function that calls the callback in [slot].
+  static uword EntryPoint(Isolate* isolate, intptr_t slot);
+
+  // Releases the callback in [slot]. Waits for calls in progress, and shuts
+  // down its helper isolates.
+  static void Close(Thread* thread, intptr_t slot);
+
+  // Releases all callbacks owned by [isolate], on shutdown.
+  static void CloseAll(Thread* thread);
+
+  // Called by the trampolines.
+  static uword Invoke(intptr_t slot, const uword* arguments);
+
+ private:
+  using ArgumentKind = FfiCallbackListener::ArgumentKind;
+
+  enum ResultKind {
+    kVoidResult,
+    kIntegerResult,
+    kBoolResult,
+    kPointerResult,
+  };
+
+  FfiIsolateGroupCallback(Isolate* isolate, intptr_t arity)
+      : isolate_(isolate), arity_(arity) {}
+  ~FfiIsolateGroupCallback();
+
+  static void Release(Thread* thread, intptr_t slot);
+
+  // Enters an idle helper isolate, creating one if there is none.
+  Isolate* EnterHelperIsolate();
+  // Exits [isolate] and makes it available to other calls.
+  void ExitHelperIsolate(Isolate* isolate);
+
+  // Runs the target on [thread], which is in native state inside an isolate
+  // of the group.
+  uword Run(Thread* thread, const uword* arguments);
+
+  Isolate* const isolate_;
+  const intptr_t arity_;
+  ArgumentKind kinds_[kMaxArguments];
+  ResultKind result_kind_ = kVoidResult;
+  PersistentHandle* target_ = nullptr;
+
+  Mutex mutex_;
+  MallocGrowableArray<Isolate*> idle_isolates_;
+
+  DISALLOW_COPY_AND_ASSIGN(FfiIsolateGroupCallback);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_FFI_ISOLATE_GROUP_CALLBACK_H_
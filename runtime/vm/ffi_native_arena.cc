@@ -0,0 +1,133 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/ffi_native_arena.h"
+
+#include <stdlib.h>
+
+#include "platform/assert.h"
+
+namespace dart {
+
+intptr_t FfiNativeArena::SizeClassOf(intptr_t size) {
+  ASSERT(0 <= size && size <= kMaxSmallSize);
+  if (size <= (1 << kMinSmallSizeLog2)) {
+    return 0;
+  }
+  return Utils::ShiftForPowerOfTwo(Utils::RoundUpToPowerOfTwo(size)) -
+         kMinSmallSizeLog2;
+}
+
+void* FfiNativeArena::Allocate(intptr_t size) {
+  ASSERT(size >= 0);
+  static_assert(sizeof(SmallHeader) == kAlignment, "Header keeps alignment");
+  if (size > kMaxSmallSize) {
+    return AllocateLarge(size);
+  }
+  return AllocateSmall(SizeClassOf(size));
+}
+
+void* FfiNativeArena::AllocateSmall(intptr_t size_class) {
+  SmallHeader* header = free_lists_[size_class];
+  if (header != nullptr) {
+    free_lists_[size_class] = header->next_free;
+    return header + 1;
+  }
+
+  const intptr_t block_size = sizeof(SmallHeader) + SizeOfClass(size_class);
+  if (top_ + block_size > end_) {
+    // The rest of the current chunk is dropped.
+    Chunk* chunk = reinterpret_cast<Chunk*>(malloc(kChunkSize));
+    if (chunk == nullptr) {
+      return nullptr;
+    }
+    chunk->next = chunks_;
+    chunks_ = chunk;
+    capacity_ += kChunkSize;
+    // Start such that blocks after the header are aligned.
+    top_ = Utils::RoundUp(reinterpret_cast<uword>(chunk) + sizeof(Chunk),
+                          kAlignment);
+    end_ = reinterpret_cast<uword>(chunk) + kChunkSize;
+    ASSERT(top_ + block_size <= end_);
+  }
+  header = reinterpret_cast<SmallHeader*>(top_);
+  top_ += block_size;
+  header->size_class = size_class;
+  return header + 1;
+}
+
+void* FfiNativeArena::AllocateLarge(intptr_t size) {
+  // malloc only guarantees word alignment on some platforms, so the block is
+  // aligned by hand and the header placed right before it.
+  const intptr_t allocation_size = sizeof(LargeHeader) + kAlignment + size;
+  if (allocation_size < size) {
+    return nullptr;
+  }
+  void* allocation = malloc(allocation_size);
+  if (allocation == nullptr) {
+    return nullptr;
+  }
+  const uword start = Utils::RoundUp(
+      reinterpret_cast<uword>(allocation) + sizeof(LargeHeader), kAlignment);
+  LargeHeader* header = reinterpret_cast<LargeHeader*>(start) - 1;
+  header->allocation = allocation;
+  header->previous = nullptr;
+  header->next = large_blocks_;
+  if (large_blocks_ != nullptr) {
+    large_blocks_->previous = header;
+  }
+  large_blocks_ = header;
+  header->size = allocation_size;
+  header->size_class = kLargeSizeClass;
+  capacity_ += allocation_size;
+  return header + 1;
+}
+
+void FfiNativeArena::Free(void* pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+  // Both headers end with the size class.
+  const intptr_t size_class = reinterpret_cast<intptr_t*>(pointer)[-1];
+  if (size_class != kLargeSizeClass) {
+    ASSERT(0 <= size_class && size_class < kNumSizeClasses);
+    SmallHeader* header = reinterpret_cast<SmallHeader*>(pointer) - 1;
+    header->next_free = free_lists_[size_class];
+    free_lists_[size_class] = header;
+    return;
+  }
+
+  LargeHeader* header = reinterpret_cast<LargeHeader*>(pointer) - 1;
+  if (header->previous != nullptr) {
+    header->previous->next = header->next;
+  } else {
+    ASSERT(large_blocks_ == header);
+    large_blocks_ = header->next;
+  }
+  if (header->next != nullptr) {
+    header->next->previous = header->previous;
+  }
+  capacity_ -= header->size;
+  free(header->allocation);
+}
+
+void FfiNativeArena::ReleaseAll() {
+  while (chunks_ != nullptr) {
+    Chunk* next = chunks_->next;
+    free(chunks_);
+    chunks_ = next;
+  }
+  while (large_blocks_ != nullptr) {
+    LargeHeader* next = large_blocks_->next;
+    free(large_blocks_->allocation);
+    large_blocks_ = next;
+  }
+  for (intptr_t i = 0; i < kNumSizeClasses; i++) {
+    free_lists_[i] = nullptr;
+  }
+  top_ = end_ = 0;
+  capacity_ = 0;
+}
+
+}  // namespace dart
@@ -0,0 +1,102 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_FFI_NATIVE_ARENA_H_
+#define RUNTIME_VM_FFI_NATIVE_ARENA_H_
+
+#include "platform/utils.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+class FinalizablePersistentHandle;
+
+// Native memory allocator backing NativeArena in dart:ffi.
+//
+// Allocations of up to kMaxSmallSize bytes are rounded up to a power of two
+// size class and carved out of malloced chunks by bumping a pointer. Freed
+// small blocks are kept on a free list per size class and reused. Larger
+// allocations are malloced individually. ReleaseAll, or collecting the
+// owning Dart object, releases all memory at once.
+//
+// The arena is owned by a single isolate and is not thread safe. Its
+// capacity is reported as the external size of the owning Dart object, so
+// the GC sees the native memory it holds on to.
+class FfiNativeArena {
+ public:
+  static constexpr intptr_t kAlignment = 16;
+  static constexpr intptr_t kMinSmallSizeLog2 = 4;
+  static constexpr intptr_t kMaxSmallSizeLog2 = 11;
+  static constexpr intptr_t kMaxSmallSize = 1 << kMaxSmallSizeLog2;
+  static constexpr intptr_t kChunkSize = 64 * KB;
+
+  FfiNativeArena() {}
+  ~FfiNativeArena() { ReleaseAll(); }
+
+  // Returns a block of at least [size] bytes aligned to kAlignment, or
+  // nullptr if out of memory.
+  void* Allocate(intptr_t size);
+
+  // Returns [pointer], which must have been allocated by this arena and not
+  // been released, to the arena.
+  void Free(void* pointer);
+
+  // Releases all memory of the arena. The arena can be used again afterwards.
+  void ReleaseAll();
+
+  // Bytes of native memory held by the arena.
+  intptr_t capacity() const { return capacity_; }
+
+  FinalizablePersistentHandle* handle() const { return handle_; }
+  void set_handle(FinalizablePersistentHandle* handle) { handle_ = handle; }
+
+ private:
+  static constexpr intptr_t kNumSizeClasses =
+      kMaxSmallSizeLog2 - kMinSmallSizeLog2 + 1;
+  static constexpr intptr_t kLargeSizeClass = -1;
+
+  // The size class of a block is stored in the word right before it.
+  struct SmallHeader {
+    SmallHeader* next_free;
+#if defined(ARCH_IS_32_BIT)
+    intptr_t padding[2];
+#endif
+    intptr_t size_class;
+  };
+
+  struct LargeHeader {
+    void* allocation;
+    LargeHeader* previous;
+    LargeHeader* next;
+    intptr_t size;
+    intptr_t size_class;
+  };
+
+  struct Chunk {
+    Chunk* next;
+  };
+
+  static intptr_t SizeClassOf(intptr_t size);
+  static intptr_t SizeOfClass(intptr_t size_class) {
+    return static_cast<intptr_t>(1) << (size_class + kMinSmallSizeLog2);
+  }
+
+  void* AllocateSmall(intptr_t size_class);
+  void* AllocateLarge(intptr_t size);
+
+  SmallHeader* free_lists_[kNumSizeClasses] = {};
+  Chunk* chunks_ = nullptr;
+  uword top_ = 0;
+  uword end_ = 0;
+  LargeHeader* large_blocks_ = nullptr;
+  intptr_t capacity_ = 0;
+  FinalizablePersistentHandle* handle_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(FfiNativeArena);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_FFI_NATIVE_ARENA_H_
@@ -0,0 +1,66 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/ffi_native_arena.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+VM_UNIT_TEST_CASE(FfiNativeArena_SmallBlocks) {
+  FfiNativeArena arena;
+  EXPECT_EQ(0, arena.capacity());
+
+  void* a = arena.Allocate(1);
+  void* b = arena.Allocate(FfiNativeArena::kMaxSmallSize);
+  EXPECT(a != nullptr && b != nullptr && a != b);
+  EXPECT(Utils::IsAligned(a, FfiNativeArena::kAlignment));
+  EXPECT(Utils::IsAligned(b, FfiNativeArena::kAlignment));
+  EXPECT_EQ(FfiNativeArena::kChunkSize, arena.capacity());
+  memset(b, 0xff, FfiNativeArena::kMaxSmallSize);
+
+  // Freed blocks are reused by allocations of the same size class.
+  arena.Free(a);
+  EXPECT_EQ(a, arena.Allocate(16));
+  arena.Free(b);
+  EXPECT_EQ(b, arena.Allocate(FfiNativeArena::kMaxSmallSize - 1));
+  EXPECT_EQ(FfiNativeArena::kChunkSize, arena.capacity());
+
+  // Filling a chunk takes another one.
+  for (intptr_t i = 0; i < FfiNativeArena::kChunkSize / 64; i++) {
+    arena.Allocate(48);
+  }
+  EXPECT_EQ(2 * FfiNativeArena::kChunkSize, arena.capacity());
+
+  arena.ReleaseAll();
+  EXPECT_EQ(0, arena.capacity());
+  EXPECT(arena.Allocate(8) != nullptr);
+}
+
+VM_UNIT_TEST_CASE(FfiNativeArena_LargeBlocks) {
+  FfiNativeArena arena;
+  const intptr_t size = 10 * FfiNativeArena::kMaxSmallSize;
+  void* a = arena.Allocate(size);
+  void* b = arena.Allocate(size);
+  void* c = arena.Allocate(size);
+  EXPECT(Utils::IsAligned(a, FfiNativeArena::kAlignment));
+  memset(a, 0, size);
+  memset(b, 0, size);
+  memset(c, 0, size);
+  const intptr_t capacity = arena.capacity();
+  EXPECT(capacity >= 3 * size);
+
+  // Large blocks are returned to the system when freed.
+  arena.Free(b);
+  EXPECT(arena.capacity() < capacity);
+  arena.Free(a);
+  arena.Free(c);
+  EXPECT_EQ(0, arena.capacity());
+
+  // Unfreed blocks are released with the arena.
+  arena.Allocate(size);
+  arena.Allocate(1);
+}
+
+}  // namespace dart
@@ -136,6 +136,9 @@ constexpr bool FLAG_support_il_printer = false;
     "Allow idle tasks to run for this long.")                                  \
   P(interpret_irregexp, bool, false, "Use irregexp bytecode interpreter")      \
   P(lazy_async_stacks, bool, true, "Obsolete, ignored.")                       \
+  P(linear_regexp, bool, false,                                                \
+    "Run regexps without backreferences or lookarounds in a linear-time "      \
+    "engine instead of the backtracking one.")                                 \
   P(link_natives_lazily, bool, false, "Link native calls lazily")              \
   R(log_marker_tasks, false, bool, false,                                      \
     "Log debugging information for old gen GC marking tasks.")                 \
@@ -145,9 +148,10 @@ constexpr bool FLAG_support_il_printer = false;
   P(mark_when_idle, bool, false,                                               \
     "The Dart thread will assist in concurrent marking during idle time and "  \
     "is counted as one marker task")                                           \
-  P(marker_tasks, int, 2,                                                      \
+  P(marker_tasks, int, -1,                                                     \
     "The number of tasks to spawn during old gen GC marking (0 means "         \
-    "perform all marking on main thread).")                                    \
+    "perform all marking on main thread, negative means choose based on the "  \
+    "number of processors and the size of old space).")                        \
   P(hash_map_probes_limit, int, kMaxInt32,                                     \
     "Limit number of probes while doing lookups in hash maps.")                \
   P(max_polymorphic_checks, int, 4,                                            \
@@ -185,6 +189,9 @@ constexpr bool FLAG_support_il_printer = false;
   R(profiler, false, bool, false, "Enable the profiler.")                      \
   R(profiler_native_memory, false, bool, false,                                \
     "Enable native memory statistic collection.")                              \
+  P(regexp_compilation_threshold, int, 10,                                     \
+    "Number of times a regexp runs in the bytecode interpreter before it is "  \
+    "compiled. 0 compiles regexps when they are created.")                     \
   P(reorder_basic_blocks, bool, true, "Reorder basic blocks")                  \
   C(stress_async_stacks, false, false, bool, false,                            \
     "Stress test async stack traces")                                          \
@@ -242,6 +249,8 @@ constexpr bool FLAG_support_il_printer = false;
     "Enables store buffer verification before and after scavenges.")           \
   R(verify_after_marking, false, bool, false,                                  \
     "Enables heap verification after marking.")                                \
+  P(verifier_tasks, int, 2,                                                    \
+    "The number of tasks to use for heap verification.")                       \
   P(enable_slow_path_sharing, bool, true, "Enable sharing of slow-path code.") \
   P(shared_slow_path_triggers_gc, bool, false,                                 \
     "TESTING: slow-path triggers a GC.")                                       \
@@ -257,6 +266,8 @@ constexpr bool FLAG_support_il_printer = false;
     "entry_point_pragma.md")                                                   \
   P(sound_null_safety, bool, true,                                             \
     "Respect the nullability of types at runtime.")                            \
+  R(aot_coverage, false, bool, false,                                          \
+    "Instrument AOT compiled code to record source coverage.")                 \
   C(branch_coverage, false, false, bool, false, "Enable branch coverage")
 
 #endif  // RUNTIME_VM_FLAG_LIST_H_
@@ -66,10 +66,17 @@ void Handles<kHandleSizeInWords, kHandlesPerChunk, kOffsetOfRawPtr>::Reset() {
     zone_blocks_->ReInit();
   }
 
-  // Delete all the extra scoped handle blocks allocated and reinit the first
-  // scoped block.
-  DeleteHandleBlocks(first_scoped_block_.next_block());
+  // Delete all but one of the extra scoped handle blocks allocated and reinit
+  // the ones that are kept. The spare block saves scopes which are reused,
+  // like the API scope of every native call, from allocating it again each
+  // time they need more than one block.
+  HandlesBlock* spare_block = first_scoped_block_.next_block();
+  if (spare_block != nullptr) {
+    DeleteHandleBlocks(spare_block->next_block());
+    spare_block->ReInit();
+  }
   first_scoped_block_.ReInit();
+  first_scoped_block_.set_next_block(spare_block);
   scoped_blocks_ = &first_scoped_block_;
 }
 
@@ -146,12 +146,18 @@ class CompactorTask : public ThreadPool::Task {
         free_current_(0),
         free_end_(0) {}
 
+  virtual Dart_TaskPriority priority(
+      Dart_TaskPriority pool_default) const {
+    return Dart_TaskPriority_High;
+  }
+
   void Run();
   void RunEnteredIsolateGroup();
 
  private:
   void PlanPage(Page* page);
   void SlidePage(Page* page);
+  void ForwardMarkedObjects(Page* page);
   uword PlanBlock(uword first_object, ForwardingPage* forwarding_page);
   uword SlideBlock(uword first_object, ForwardingPage* forwarding_page);
   void PlanMoveToContiguousSize(intptr_t size);
@@ -185,6 +191,7 @@ void GCCompactor::Compact(Page* pages, FreeList* freelist, Mutex* pages_lock) {
   // TODO(30978): Try to divide based on live bytes or with work stealing.
   intptr_t num_pages = 0;
   for (Page* page = pages; page != nullptr; page = page->next()) {
+    page->set_is_compacting(true);
     num_pages++;
   }
 
@@ -239,6 +246,7 @@ void GCCompactor::Compact(Page* pages, FreeList* freelist, Mutex* pages_lock) {
 
         FreeListElement::AsElement(page->object_start(),
                                    page->object_end() - page->object_start());
+        page->set_is_compacting(true);
 
         // The compactor slides down: add the empty pages to the beginning.
         page->set_next(partitions[task_index].head);
@@ -349,6 +357,13 @@ void GCCompactor::Compact(Page* pages, FreeList* freelist, Mutex* pages_lock) {
     heap_->old_space()->pages_ = pages = partitions[0].head;
     heap_->old_space()->pages_tail_ = partitions[num_tasks - 1].tail;
 
+    // Surviving pages are densely packed, so they count as fully used until
+    // they are next swept.
+    for (Page* page = pages; page != nullptr; page = page->next()) {
+      page->set_is_compacting(false);
+      page->set_live_bytes(page->used());
+    }
+
     delete[] partitions;
   }
 }
@@ -420,8 +435,9 @@ void CompactorTask::RunEnteredIsolateGroup() {
       partitions_[sliding_task].tail = free_page_;  // Last live page.
     }
 
-    // Heap: Regular pages already visited during sliding. Code and image pages
-    // have no pointers to forward. Visit large pages and new-space.
+    // Heap: Regular pages being compacted already visited during sliding. Code
+    // and image pages have no pointers to forward. Visit large pages, regular
+    // pages left for the sweeper by a partial compaction, and new-space.
 
     bool more_forwarding_tasks = true;
     while (more_forwarding_tasks) {
@@ -456,8 +472,16 @@ void CompactorTask::RunEnteredIsolateGroup() {
           isolate_group_->VisitWeakPersistentHandles(compactor_);
           break;
         }
-#ifndef PRODUCT
         case 5: {
+          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardUncompactedPages");
+          for (Page* page = isolate_group_->heap()->old_space()->sweep_regular_;
+               page != nullptr; page = page->next()) {
+            ForwardMarkedObjects(page);
+          }
+          break;
+        }
+#ifndef PRODUCT
+        case 6: {
           TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardObjectIdRing");
           isolate_group_->ForEachIsolate(
               [&](Isolate* isolate) {
@@ -477,6 +501,22 @@ void CompactorTask::RunEnteredIsolateGroup() {
   }
 }
 
+// Only marked objects are visited: the sweeper has yet to free the others,
+// and their pointers may refer to objects that no longer exist.
+void CompactorTask::ForwardMarkedObjects(Page* page) {
+  ASSERT(!page->is_compacting());
+  uword current = page->object_start();
+  uword end = page->object_end();
+  while (current < end) {
+    ObjectPtr obj = UntaggedObject::FromAddr(current);
+    if (obj->untag()->IsMarked()) {
+      current += obj->untag()->VisitPointers(compactor_);
+    } else {
+      current += obj->untag()->HeapSize();
+    }
+  }
+}
+
 void CompactorTask::PlanPage(Page* page) {
   uword current = page->object_start();
   uword end = page->object_end();
@@ -655,10 +695,12 @@ void GCCompactor::ForwardPointer(ObjectPtr* ptr) {
   }
 
   Page* page = Page::Of(old_target);
-  ForwardingPage* forwarding_page = page->forwarding_page();
-  if (forwarding_page == nullptr) {
-    return;  // Not moved (VM isolate, large page, code page).
+  if (!page->is_compacting()) {
+    // Not moved (VM isolate, large page, code page, uncompacted page).
+    return;
   }
+  ForwardingPage* forwarding_page = page->forwarding_page();
+  ASSERT(forwarding_page != nullptr);
 
   ObjectPtr new_target =
       UntaggedObject::FromAddr(forwarding_page->Lookup(old_addr));
@@ -691,10 +733,12 @@ void GCCompactor::ForwardCompressedPointer(uword heap_base,
   }
 
   Page* page = Page::Of(old_target);
-  ForwardingPage* forwarding_page = page->forwarding_page();
-  if (forwarding_page == nullptr) {
-    return;  // Not moved (VM isolate, large page, code page).
+  if (!page->is_compacting()) {
+    // Not moved (VM isolate, large page, code page, uncompacted page).
+    return;
   }
+  ForwardingPage* forwarding_page = page->forwarding_page();
+  ASSERT(forwarding_page != nullptr);
 
   ObjectPtr new_target =
       UntaggedObject::FromAddr(forwarding_page->Lookup(old_addr));
@@ -10,6 +10,7 @@
 #include "vm/object.h"
 #include "vm/os_thread.h"
 #include "vm/raw_object.h"
+#include "vm/virtual_memory.h"
 
 namespace dart {
 
@@ -195,6 +196,27 @@ void FreeList::Reset() {
   }
 }
 
+intptr_t FreeList::ReleaseFreeMemory() {
+  MutexLocker ml(&mutex_);
+  const uword page_size = VirtualMemory::PageSize();
+  intptr_t released = 0;
+  // Elements in the fixed size lists are smaller than an OS page.
+  for (FreeListElement* element = free_lists_[kNumLists]; element != nullptr;
+       element = element->next()) {
+    const uword start = reinterpret_cast<uword>(element);
+    const intptr_t size = element->HeapSize();
+    const uword release_start = Utils::RoundUp(
+        start + FreeListElement::HeaderSizeFor(size), page_size);
+    const uword release_end = Utils::RoundDown(start + size, page_size);
+    if (release_end > release_start) {
+      VirtualMemory::DontNeed(reinterpret_cast<void*>(release_start),
+                              release_end - release_start);
+      released += release_end - release_start;
+    }
+  }
+  return released;
+}
+
 void FreeList::EnqueueElement(FreeListElement* element, intptr_t index) {
   FreeListElement* next = free_lists_[index];
   if (next == nullptr && index != kNumLists) {
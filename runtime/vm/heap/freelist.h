@@ -83,6 +83,10 @@ class FreeList {
 
   void Reset();
 
+  // Returns the OS pages inside large free elements to the OS, keeping only
+  // the element headers resident. Returns the number of bytes released.
+  intptr_t ReleaseFreeMemory();
+
   void Print() const;
 
   Mutex* mutex() { return &mutex_; }
@@ -94,6 +94,29 @@ TEST_CASE(FreeList) {
   delete free_list;
 }
 
+TEST_CASE(FreeList_ReleaseFreeMemory) {
+  FreeList* free_list = new FreeList();
+  const intptr_t kBlobSize = 1 * MB;
+  VirtualMemory* region = VirtualMemory::Allocate(
+      kBlobSize, /* is_executable */ false, /* is_compressed */ false, "test");
+  const uword blob = region->start();
+  memset(reinterpret_cast<void*>(blob), 0xAB, kBlobSize);
+  free_list->Free(blob, kBlobSize);
+
+  // All but the OS page holding the element header are released.
+  const intptr_t released = free_list->ReleaseFreeMemory();
+  EXPECT_EQ(kBlobSize - VirtualMemory::PageSize(), released);
+#if defined(DART_HOST_OS_LINUX)
+  EXPECT_EQ(0, *reinterpret_cast<uint8_t*>(blob + kBlobSize - 1));
+#endif
+
+  // The element is still usable.
+  EXPECT_EQ(blob, free_list->TryAllocate(kBlobSize, /*is_protected=*/false));
+
+  delete region;
+  delete free_list;
+}
+
 TEST_CASE(FreeListProtected) {
   FreeList* free_list = new FreeList();
   const intptr_t kBlobSize = 1 * MB;
@@ -11,6 +11,7 @@
 #include "platform/utils.h"
 #include "vm/compiler/jit/compiler.h"
 #include "vm/dart.h"
+#include "vm/dart_api_state.h"
 #include "vm/flags.h"
 #include "vm/heap/pages.h"
 #include "vm/heap/safepoint.h"
@@ -28,6 +29,7 @@
 #include "vm/service_isolate.h"
 #include "vm/stack_frame.h"
 #include "vm/tags.h"
+#include "vm/thread_barrier.h"
 #include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/virtual_memory.h"
@@ -48,6 +50,7 @@ Heap::Heap(IsolateGroup* isolate_group,
       is_vm_isolate_(is_vm_isolate),
       new_space_(this, max_new_gen_semi_words),
       old_space_(this, max_old_gen_words),
+      pretenuring_(this),
       read_only_(false),
       last_gc_was_old_space_(false),
       assume_scavenge_will_fail_(false),
@@ -113,7 +116,9 @@ uword Heap::AllocateOld(Thread* thread, intptr_t size, Page::PageType type) {
 
   if (!thread->force_growth()) {
     CollectForDebugging(thread);
-    uword addr = old_space_.TryAllocate(size, type);
+    uword addr = (type == Page::kData)
+                     ? old_space_.TryAllocateThreadLocal(thread, size)
+                     : old_space_.TryAllocate(size, type);
     if (addr != 0) {
       return addr;
     }
@@ -260,6 +265,87 @@ void Heap::VisitObjectsImagePages(ObjectVisitor* visitor) const {
   old_space_.VisitObjectsImagePages(visitor);
 }
 
+class ParallelObjectVisitorTask : public ThreadPool::Task {
+ public:
+  ParallelObjectVisitorTask(IsolateGroup* isolate_group,
+                            ThreadBarrier* barrier,
+                            const MallocGrowableArray<Page*>* pages,
+                            RelaxedAtomic<intptr_t>* next_page,
+                            ObjectVisitor* visitor)
+      : isolate_group_(isolate_group),
+        barrier_(barrier),
+        pages_(pages),
+        next_page_(next_page),
+        visitor_(visitor) {}
+
+  virtual Dart_TaskPriority priority(
+      Dart_TaskPriority pool_default) const {
+    return Dart_TaskPriority_High;
+  }
+
+  void Run() {
+    if (!barrier_->TryEnter()) {
+      barrier_->Release();
+      return;
+    }
+
+    bool result = Thread::EnterIsolateGroupAsHelper(
+        isolate_group_, Thread::kHeapVisitorTask, /*bypass_safepoint=*/true);
+    ASSERT(result);
+
+    RunEnteredIsolateGroup();
+
+    Thread::ExitIsolateGroupAsHelper(/*bypass_safepoint=*/true);
+
+    // This task is done. Notify the original thread.
+    barrier_->Sync();
+    barrier_->Release();
+  }
+
+  void RunEnteredIsolateGroup() {
+    // Pages differ a lot in size, so hand them out one at a time instead of
+    // partitioning them up front.
+    while (true) {
+      const intptr_t index = next_page_->fetch_add(1);
+      if (index >= pages_->length()) break;
+      pages_->At(index)->VisitObjects(visitor_);
+    }
+  }
+
+ private:
+  IsolateGroup* isolate_group_;
+  ThreadBarrier* barrier_;
+  const MallocGrowableArray<Page*>* pages_;
+  RelaxedAtomic<intptr_t>* next_page_;
+  ObjectVisitor* visitor_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelObjectVisitorTask);
+};
+
+void Heap::ParallelVisitObjects(ObjectVisitor** visitors,
+                                intptr_t num_visitors,
+                                bool include_image_pages) {
+  ASSERT(num_visitors >= 1);
+  ASSERT(Thread::Current()->IsAtSafepoint());
+  MallocGrowableArray<Page*> pages;
+  new_space_.AddPagesTo(&pages);
+  old_space_.AddPagesTo(&pages, include_image_pages);
+
+  ThreadBarrier* barrier = new ThreadBarrier(num_visitors, 1);
+  RelaxedAtomic<intptr_t> next_page = {0};
+  for (intptr_t i = 0; i < num_visitors - 1; i++) {
+    Dart::thread_pool()->Run<ParallelObjectVisitorTask>(
+        isolate_group(), barrier, &pages, &next_page, visitors[i]);
+  }
+  // The last visitor runs on the current thread, so all pages get visited
+  // even if the thread pool does not start any of the other tasks.
+  ParallelObjectVisitorTask task(isolate_group(), barrier, &pages, &next_page,
+                                 visitors[num_visitors - 1]);
+  task.RunEnteredIsolateGroup();
+  barrier->Sync();
+  barrier->Release();
+}
+
 HeapIterationScope::HeapIterationScope(Thread* thread, bool writable)
     : ThreadStackResource(thread),
       heap_(isolate_group()->heap()),
@@ -341,6 +427,12 @@ void HeapIterationScope::IterateOldObjectsNoImagePages(
   old_space_->VisitObjectsNoImagePages(visitor);
 }
 
+void HeapIterationScope::ParallelIterateObjects(ObjectVisitor** visitors,
+                                                intptr_t num_visitors) const {
+  heap_->ParallelVisitObjects(visitors, num_visitors,
+                              /*include_image_pages=*/true);
+}
+
 void HeapIterationScope::IterateVMIsolateObjects(ObjectVisitor* visitor) const {
   Dart::vm_isolate_group()->heap()->VisitObjects(visitor);
 }
@@ -450,7 +542,11 @@ void Heap::NotifyIdle(int64_t deadline) {
   }
 
   if (OS::GetCurrentMonotonicMicros() < deadline) {
+    if (old_space_.ExceedsSoftLimit()) {
+      old_space_.ReleaseFreeMemory();
+    }
     Page::ClearCache();
+    Zone::ClearCache();
   }
 }
 
@@ -507,6 +603,17 @@ void Heap::CollectNewSpaceGarbage(Thread* thread,
       }
     }
   }
+  RunPendingFinalizers(thread);
+}
+
+void Heap::RunPendingFinalizers(Thread* thread) {
+  // A collection nested in another safepoint operation leaves them for the
+  // outermost one.
+  if (thread->IsAtSafepoint()) {
+    return;
+  }
+  isolate_group_->api_state()->RunPendingFinalizers(
+      isolate_group_->embedder_data());
 }
 
 void Heap::CollectOldSpaceGarbage(Thread* thread,
@@ -550,6 +657,9 @@ void Heap::CollectOldSpaceGarbage(Thread* thread,
     TIMELINE_FUNCTION_GC_DURATION(thread, "CollectOldGeneration");
     old_space_.CollectGarbage(thread, /*compact=*/type == GCType::kMarkCompact,
                               /*finalize=*/true);
+    if (Pretenuring::IsEnabled()) {
+      pretenuring_.UpdateAfterOldSpaceGC(thread);
+    }
     RecordAfterGC(type);
     PrintStats();
 #if defined(SUPPORT_TIMELINE)
@@ -566,6 +676,7 @@ void Heap::CollectOldSpaceGarbage(Thread* thread,
     last_gc_was_old_space_ = true;
     assume_scavenge_will_fail_ = false;
   }
+  RunPendingFinalizers(thread);
 }
 
 void Heap::CollectGarbage(Thread* thread, GCType type, GCReason reason) {
@@ -695,9 +806,15 @@ void Heap::WaitForMarkerTasks(Thread* thread) {
 void Heap::WaitForSweeperTasks(Thread* thread) {
   ASSERT(!thread->IsAtSafepoint());
   MonitorLocker ml(old_space_.tasks_lock());
+  if (old_space_.tasks() == 0) {
+    return;
+  }
+  const int64_t start = OS::GetCurrentMonotonicMicros();
   while (old_space_.tasks() > 0) {
     ml.WaitWithSafepointCheck(thread);
   }
+  pause_histogram(GCPauseKind::kSweep)
+      ->Record(OS::GetCurrentMonotonicMicros() - start);
 }
 
 void Heap::WaitForSweeperTasksAtSafepoint(Thread* thread) {
@@ -771,9 +888,20 @@ ObjectSet* Heap::CreateAllocatedObjectSet(Zone* zone,
   vm_isolate->group()->heap()->AddRegionsToObjectSet(allocated_set);
 
   {
-    VerifyObjectVisitor object_visitor(isolate_group(), allocated_set,
-                                       mark_expectation);
-    this->VisitObjectsNoImagePages(&object_visitor);
+    // Every page has its own region in the set, so visitors of different
+    // pages can add objects concurrently.
+    const intptr_t num_tasks = Utils::Maximum(FLAG_verifier_tasks, 1);
+    ObjectVisitor** visitors = new ObjectVisitor*[num_tasks];
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      visitors[i] = new VerifyObjectVisitor(isolate_group(), allocated_set,
+                                            mark_expectation);
+    }
+    this->ParallelVisitObjects(visitors, num_tasks,
+                               /*include_image_pages=*/false);
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      delete visitors[i];
+    }
+    delete[] visitors;
   }
   {
     VerifyObjectVisitor object_visitor(isolate_group(), allocated_set,
@@ -804,8 +932,17 @@ bool Heap::VerifyGC(MarkExpectation mark_expectation) {
 
   ObjectSet* allocated_set =
       CreateAllocatedObjectSet(stack_zone.GetZone(), mark_expectation);
-  VerifyPointersVisitor visitor(isolate_group(), allocated_set);
-  VisitObjectPointers(&visitor);
+  const intptr_t num_tasks = Utils::Maximum(FLAG_verifier_tasks, 1);
+  ObjectVisitor** visitors = new ObjectVisitor*[num_tasks];
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    visitors[i] =
+        new VerifyPointersInObjectsVisitor(isolate_group(), allocated_set);
+  }
+  ParallelVisitObjects(visitors, num_tasks, /*include_image_pages=*/true);
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    delete visitors[i];
+  }
+  delete[] visitors;
 
   // Only returning a value so that Heap::Validate can be called from an ASSERT.
   return true;
@@ -1033,6 +1170,29 @@ void Heap::RecordBeforeGC(GCType type, GCReason reason) {
   stats_.before_.new_ = new_space_.GetCurrentUsage();
   stats_.before_.old_ = old_space_.GetCurrentUsage();
   stats_.before_.store_buffer_ = isolate_group_->store_buffer()->Size();
+  new_allocated_in_words_ =
+      AllocatedInWords(stats_.before_.new_.used_in_words,
+                       new_allocated_in_words_, new_used_after_gc_in_words_);
+  old_allocated_in_words_ =
+      AllocatedInWords(stats_.before_.old_.used_in_words,
+                       old_allocated_in_words_, old_used_after_gc_in_words_);
+}
+
+int64_t Heap::AllocatedInWords(intptr_t used_in_words,
+                               int64_t allocated_in_words,
+                               intptr_t used_after_gc_in_words) {
+  // Usage can drop between GCs, e.g. as the concurrent sweeper frees pages.
+  return allocated_in_words +
+         Utils::Maximum<intptr_t>(used_in_words - used_after_gc_in_words, 0);
+}
+
+int64_t Heap::AllocatedInWords(Space space) const {
+  if (space == kNew) {
+    return AllocatedInWords(new_space_.UsedInWords(), new_allocated_in_words_,
+                            new_used_after_gc_in_words_);
+  }
+  return AllocatedInWords(old_space_.UsedInWords(), old_allocated_in_words_,
+                          old_used_after_gc_in_words_);
 }
 
 void Heap::RecordAfterGC(GCType type) {
@@ -1048,6 +1208,21 @@ void Heap::RecordAfterGC(GCType type) {
   stats_.after_.new_ = new_space_.GetCurrentUsage();
   stats_.after_.old_ = old_space_.GetCurrentUsage();
   stats_.after_.store_buffer_ = isolate_group_->store_buffer()->Size();
+  new_used_after_gc_in_words_ = stats_.after_.new_.used_in_words;
+  old_used_after_gc_in_words_ = stats_.after_.old_.used_in_words;
+  switch (type) {
+    case GCType::kScavenge:
+    case GCType::kEvacuate:
+      pause_histogram(GCPauseKind::kScavenge)->Record(delta);
+      break;
+    case GCType::kStartConcurrentMark:
+    case GCType::kMarkSweep:
+      pause_histogram(GCPauseKind::kMark)->Record(delta);
+      break;
+    case GCType::kMarkCompact:
+      pause_histogram(GCPauseKind::kCompact)->Record(delta);
+      break;
+  }
 #ifndef PRODUCT
   // For now we'll emit the same GC events on all isolates.
   if (Service::gc_stream.enabled()) {
@@ -16,6 +16,7 @@
 #include "vm/flags.h"
 #include "vm/globals.h"
 #include "vm/heap/pages.h"
+#include "vm/heap/pretenuring.h"
 #include "vm/heap/scavenger.h"
 #include "vm/heap/spaces.h"
 #include "vm/heap/weak_table.h"
@@ -74,8 +75,19 @@ class Heap {
   ~Heap();
 
   Scavenger* new_space() { return &new_space_; }
+  Pretenuring* pretenuring() { return &pretenuring_; }
   PageSpace* old_space() { return &old_space_; }
 
+  // Durations of GC pauses and of bringing threads to a safepoint, in
+  // microseconds.
+  LatencyHistogram* pause_histogram(GCPauseKind kind) {
+    return &pause_histograms_[static_cast<intptr_t>(kind)];
+  }
+
+  // Total words allocated in [space] since the heap was created, including
+  // promotions into old space.
+  int64_t AllocatedInWords(Space space) const;
+
   uword Allocate(Thread* thread, intptr_t size, Space space) {
     ASSERT(!read_only_);
     switch (space) {
@@ -371,6 +383,15 @@ class Heap {
   void VisitObjectsNoImagePages(ObjectVisitor* visitor);
   void VisitObjectsImagePages(ObjectVisitor* visitor) const;
 
+  // Like VisitObjects, but divides the pages among [num_visitors] tasks, one
+  // of which runs on the current thread and the others on the thread pool.
+  // Each task uses its own visitor. Visitors run concurrently and see the
+  // pages in no particular order, so any state they share must be
+  // thread-safe.
+  void ParallelVisitObjects(ObjectVisitor** visitors,
+                            intptr_t num_visitors,
+                            bool include_image_pages);
+
   // Like Verify, but does not wait for concurrent sweeper, so caller must
   // ensure thread-safety.
   bool VerifyGC(MarkExpectation mark_expectation = kForbidMarked);
@@ -378,9 +399,15 @@ class Heap {
   // Helper functions for garbage collection.
   void CollectNewSpaceGarbage(Thread* thread, GCType type, GCReason reason);
   void CollectOldSpaceGarbage(Thread* thread, GCType type, GCReason reason);
+  // Runs the finalizer callbacks queued by the last collection, once the
+  // safepoint operation has ended.
+  void RunPendingFinalizers(Thread* thread);
 
   // GC stats collection.
   void RecordBeforeGC(GCType type, GCReason reason);
+  static int64_t AllocatedInWords(intptr_t used_in_words,
+                                  int64_t allocated_in_words,
+                                  intptr_t used_after_gc_in_words);
   void RecordAfterGC(GCType type);
   void PrintStats();
   void PrintStatsToTimeline(TimelineEventScope* event, GCReason reason);
@@ -397,12 +424,22 @@ class Heap {
   Scavenger new_space_;
   PageSpace old_space_;
 
+  Pretenuring pretenuring_;
+
   WeakTable* new_weak_tables_[kNumWeakSelectors];
   WeakTable* old_weak_tables_[kNumWeakSelectors];
 
   // GC stats collection.
   GCStats stats_;
 
+  LatencyHistogram pause_histograms_[kNumGCPauseKinds];
+  // Allocation up to the last GC, and usage right after it, from which
+  // AllocatedInWords attributes any growth since to allocation.
+  RelaxedAtomic<int64_t> new_allocated_in_words_ = 0;
+  RelaxedAtomic<int64_t> old_allocated_in_words_ = 0;
+  RelaxedAtomic<intptr_t> new_used_after_gc_in_words_ = 0;
+  RelaxedAtomic<intptr_t> old_used_after_gc_in_words_ = 0;
+
   RelaxedAtomic<Dart_PerformanceMode> mode_ = {Dart_PerformanceMode_Default};
 
   // This heap is in read-only mode: No allocation is allowed.
@@ -446,6 +483,11 @@ class HeapIterationScope : public ThreadStackResource {
   void IterateOldObjects(ObjectVisitor* visitor) const;
   void IterateOldObjectsNoImagePages(ObjectVisitor* visitor) const;
 
+  // Visits all objects using one task per visitor. See
+  // Heap::ParallelVisitObjects.
+  void ParallelIterateObjects(ObjectVisitor** visitors,
+                              intptr_t num_visitors) const;
+
   void IterateVMIsolateObjects(ObjectVisitor* visitor) const;
 
   void IterateObjectPointers(ObjectPointerVisitor* visitor,
@@ -15,6 +15,9 @@
 #include "vm/globals.h"
 #include "vm/heap/become.h"
 #include "vm/heap/heap.h"
+#include "vm/heap/sampled_allocation_profile.h"
+#include "vm/heap/sampler.h"
+#include "vm/json_stream.h"
 #include "vm/message_handler.h"
 #include "vm/message_snapshot.h"
 #include "vm/object_graph.h"
@@ -24,6 +27,11 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, use_incremental_compactor);
+DECLARE_FLAG(int, compactor_pause_budget);
+DECLARE_FLAG(bool, pretenure);
+DECLARE_FLAG(bool, scavenger_depth_first);
+
 TEST_CASE(OldGC) {
   const char* kScriptChars =
       "main() {\n"
@@ -254,6 +262,48 @@ ISOLATE_UNIT_TEST_CASE(FindObject) {
   }
 }
 
+class CountAndSizeVisitor : public ObjectVisitor {
+ public:
+  CountAndSizeVisitor() {}
+
+  void VisitObject(ObjectPtr obj) override {
+    count_++;
+    size_ += obj->untag()->HeapSize();
+  }
+
+  intptr_t count_ = 0;
+  intptr_t size_ = 0;
+};
+
+ISOLATE_UNIT_TEST_CASE(ParallelIterateObjects) {
+  const Array& old = Array::Handle(Array::New(1000, Heap::kOld));
+  for (intptr_t i = 0; i < old.Length(); i++) {
+    old.SetAt(i, Array::Handle(Array::New(i % 10, (i % 2 == 0) ? Heap::kNew
+                                                              : Heap::kOld)));
+  }
+  GCTestHelper::WaitForGCTasks();
+
+  HeapIterationScope iteration(thread);
+  CountAndSizeVisitor serial;
+  iteration.IterateObjects(&serial);
+
+  const intptr_t kNumVisitors = 4;
+  CountAndSizeVisitor parallel[kNumVisitors];
+  ObjectVisitor* visitors[kNumVisitors];
+  for (intptr_t i = 0; i < kNumVisitors; i++) {
+    visitors[i] = &parallel[i];
+  }
+  iteration.ParallelIterateObjects(visitors, kNumVisitors);
+  intptr_t count = 0;
+  intptr_t size = 0;
+  for (intptr_t i = 0; i < kNumVisitors; i++) {
+    count += parallel[i].count_;
+    size += parallel[i].size_;
+  }
+  EXPECT_EQ(serial.count_, count);
+  EXPECT_EQ(serial.size_, size);
+}
+
 ISOLATE_UNIT_TEST_CASE(IterateReadOnly) {
   const String& obj = String::Handle(String::New("x", Heap::kOld));
 
@@ -898,4 +948,283 @@ ISOLATE_UNIT_TEST_CASE(WeakSmi) {
   EXPECT(old_finalizer.value() == Smi::New(42));
 }
 
+// Large arrays are marked in slices; elements in every slice must survive.
+ISOLATE_UNIT_TEST_CASE(LargeArrayMarkedInSlices) {
+  const intptr_t kLength = 1 * MB;
+  const intptr_t kProbes = 5;
+  Array& large = Array::Handle(Array::New(kLength, Heap::kOld));
+  WeakArray& weak = WeakArray::Handle(WeakArray::New(kProbes, Heap::kOld));
+  {
+    HANDLESCOPE(thread);
+    Array& element = Array::Handle();
+    for (intptr_t i = 0; i < kProbes; i++) {
+      element = Array::New(1, Heap::kOld);
+      large.SetAt(i * (kLength - 1) / (kProbes - 1), element);
+      weak.SetAt(i, element);
+    }
+  }
+
+  GCTestHelper::CollectAllGarbage();
+  for (intptr_t i = 0; i < kProbes; i++) {
+    EXPECT(weak.At(i) != Object::null());
+  }
+
+  large = Array::null();
+  GCTestHelper::CollectAllGarbage();
+  for (intptr_t i = 0; i < kProbes; i++) {
+    EXPECT(weak.At(i) == Object::null());
+  }
+}
+
+// Remembering a large array dirties its cards instead of adding the whole
+// array to the store buffer.
+ISOLATE_UNIT_TEST_CASE(LargeArrayRememberedByCard) {
+  const intptr_t kLength = 1 * MB;
+  const Array& large = Array::Handle(Array::New(kLength, Heap::kOld));
+  EXPECT(large.ptr()->untag()->IsCardRemembered());
+  Page* page = Page::Of(large.ptr());
+  CompressedObjectPtr* data = Array::DataOf(large.ptr());
+  EXPECT(!page->IsCardRemembered(&data[kLength - 1]));
+
+  large.ptr()->untag()->EnsureInRememberedSet(thread);
+  EXPECT(!large.ptr()->untag()->IsRemembered());
+  EXPECT(page->IsCardRemembered(&data[0]));
+  EXPECT(page->IsCardRemembered(&data[kLength - 1]));
+
+  // Cards without new-space targets are cleaned by the next scavenge.
+  GCTestHelper::CollectNewSpace();
+  EXPECT(!page->IsCardRemembered(&data[kLength - 1]));
+}
+
+ISOLATE_UNIT_TEST_CASE(LargeWeakTableSweptInChunks) {
+  // Enough entries that the peer table spans several weak slices.
+  const intptr_t kNumObjects = 100 * KB;
+  const Array& live = Array::Handle(Array::New(kNumObjects / 2, Heap::kOld));
+  Heap* heap = thread->heap();
+  const int64_t before = heap->PeerCount();
+  {
+    HANDLESCOPE(thread);
+    Array& element = Array::Handle();
+    for (intptr_t i = 0; i < kNumObjects; i++) {
+      element = Array::New(0, Heap::kOld);
+      heap->SetPeer(element.ptr(), reinterpret_cast<void*>(i + 1));
+      if ((i % 2) == 0) {
+        live.SetAt(i / 2, element);
+      }
+    }
+  }
+  EXPECT_EQ(before + kNumObjects, heap->PeerCount());
+
+  GCTestHelper::CollectOldSpace();
+
+  EXPECT_EQ(before + kNumObjects / 2, heap->PeerCount());
+  Object& element = Object::Handle();
+  for (intptr_t i = 0; i < kNumObjects / 2; i++) {
+    element = live.At(i);
+    EXPECT_EQ(reinterpret_cast<void*>(2 * i + 1), heap->GetPeer(element.ptr()));
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(IncrementalCompaction) {
+  const intptr_t kLength = 128 * KB;
+  const intptr_t kStride = 4;
+  Heap* heap = IsolateGroup::Current()->heap();
+  Array& survivors = Array::Handle(Array::New(kLength / kStride, Heap::kOld));
+  {
+    HANDLESCOPE(thread);
+    Array& element = Array::Handle();
+    for (intptr_t i = 0; i < kLength; i++) {
+      element = Array::New(4, Heap::kOld);
+      element.SetAt(0, Smi::Handle(Smi::New(i)));
+      if ((i % kStride) == 0) {
+        survivors.SetAt(i / kStride, element);
+      }
+    }
+  }
+
+  // Sweep once to learn how fragmented the pages are.
+  GCTestHelper::CollectOldSpace();
+  const int64_t capacity_before = heap->CapacityInWords(Heap::kOld);
+
+  const bool saved_use_incremental_compactor = FLAG_use_incremental_compactor;
+  const int saved_compactor_pause_budget = FLAG_compactor_pause_budget;
+  FLAG_use_incremental_compactor = true;
+  FLAG_compactor_pause_budget = 1000;
+  GCTestHelper::CollectOldSpace();
+  FLAG_use_incremental_compactor = saved_use_incremental_compactor;
+  FLAG_compactor_pause_budget = saved_compactor_pause_budget;
+
+  EXPECT_LT(heap->CapacityInWords(Heap::kOld), capacity_before);
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kLength / kStride; i++) {
+    element ^= survivors.At(i);
+    EXPECT(element.At(0) == Smi::New(i * kStride));
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(PinnedObjectsSurviveCompaction) {
+  Heap* heap = IsolateGroup::Current()->heap();
+  PageSpace* old_space = heap->old_space();
+  {
+    HANDLESCOPE(thread);
+    // Garbage in front of the typed data, so that compaction would slide it.
+    for (intptr_t i = 0; i < 1000; i++) {
+      Array::Handle(Array::New(4, Heap::kOld));
+    }
+  }
+  const TypedData& data = TypedData::Handle(
+      TypedData::New(kTypedDataUint8ArrayCid, 64, Heap::kOld));
+  data.SetUint8(0, 42);
+  void* address = data.DataAddr(0);
+
+  old_space->PinObject(data.ptr());
+  EXPECT(old_space->HasPinnedObjects());
+  GCTestHelper::CollectAllGarbage(/*compact=*/true);
+  EXPECT(address == data.DataAddr(0));
+  EXPECT_EQ(42, data.GetUint8(0));
+  old_space->UnpinObject(data.ptr());
+  EXPECT(!old_space->HasPinnedObjects());
+
+  GCTestHelper::CollectAllGarbage(/*compact=*/true);
+  EXPECT_EQ(42, data.GetUint8(0));
+}
+
+ISOLATE_UNIT_TEST_CASE(NewSpacePauseGoal) {
+  Heap* heap = IsolateGroup::Current()->heap();
+  Scavenger* new_space = heap->new_space();
+  const int64_t saved_goal = new_space->pause_goal_micros();
+  const int64_t initial_capacity = heap->CapacityInWords(Heap::kNew);
+
+  // Cheap scavenges with nothing surviving leave room to grow.
+  new_space->set_pause_goal_micros(kMaxInt64 / 2);
+  GCTestHelper::CollectNewSpace();
+  heap->CollectGarbage(thread, GCType::kScavenge, GCReason::kNewSpace);
+  heap->CollectGarbage(thread, GCType::kScavenge, GCReason::kNewSpace);
+  EXPECT_GT(heap->CapacityInWords(Heap::kNew), initial_capacity);
+
+  // Every scavenge misses an unattainable goal, so new-space shrinks back.
+  new_space->set_pause_goal_micros(1);
+  for (intptr_t i = 0; i < 4; i++) {
+    heap->CollectGarbage(thread, GCType::kScavenge, GCReason::kNewSpace);
+  }
+  EXPECT_LE(heap->CapacityInWords(Heap::kNew), initial_capacity);
+
+  new_space->set_pause_goal_micros(saved_goal);
+}
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+TEST_CASE(PretenureLongLivedClass) {
+  const char* kScriptChars =
+      "class Node {\n"
+      "  var next;\n"
+      "  Node(this.next);\n"
+      "}\n"
+      "var keep;\n"
+      "main() {\n"
+      "  var list = null;\n"
+      "  for (var i = 0; i < 200000; i++) {\n"
+      "    list = new Node(list);\n"
+      "  }\n"
+      "  keep = list;\n"
+      "}\n";
+  const bool saved_pretenure = FLAG_pretenure;
+  FLAG_pretenure = true;
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  EXPECT_VALID(Dart_Invoke(h_lib, NewString("main"), 0, nullptr));
+  {
+    TransitionNativeToVM transition(thread);
+    Library& lib = Library::Handle();
+    lib ^= Api::UnwrapHandle(h_lib);
+    const Class& cls = Class::Handle(
+        lib.LookupClass(String::Handle(Symbols::New(thread, "Node"))));
+    EXPECT(!cls.IsNull());
+    Pretenuring* pretenuring = thread->heap()->pretenuring();
+
+    // Every Node survives, so the class is moved to old space.
+    GCTestHelper::CollectNewSpace();
+    EXPECT(pretenuring->ShouldAllocateOld(cls.id()));
+
+    // Old-space GC returns it to new space for resampling.
+    GCTestHelper::CollectOldSpace();
+    EXPECT(!pretenuring->ShouldAllocateOld(cls.id()));
+  }
+  FLAG_pretenure = saved_pretenure;
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+ISOLATE_UNIT_TEST_CASE(ScavengeDepthFirst) {
+  const intptr_t kLength = 10;
+  const Array& outer = Array::Handle(Array::New(kLength, Heap::kNew));
+  Array& mid = Array::Handle();
+  Array& inner = Array::Handle();
+  Array& leaf = Array::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    mid = Array::New(1, Heap::kNew);
+    inner = Array::New(1, Heap::kNew);
+    leaf = Array::New(1, Heap::kNew);
+    inner.SetAt(0, leaf);
+    mid.SetAt(0, inner);
+    outer.SetAt(i, mid);
+  }
+  // Only reachable through outer.
+  mid = Array::null();
+  inner = Array::null();
+  leaf = Array::null();
+
+  const bool saved_depth_first = FLAG_scavenger_depth_first;
+  FLAG_scavenger_depth_first = true;
+  GCTestHelper::CollectNewSpace();
+  FLAG_scavenger_depth_first = saved_depth_first;
+
+  // Each leaf is copied right after its parent rather than after all of the
+  // objects at its parent's depth.
+  for (intptr_t i = 0; i < kLength; i++) {
+    mid ^= outer.At(i);
+    inner ^= mid.At(0);
+    leaf ^= inner.At(0);
+    EXPECT(inner.ptr()->IsNewObject());
+    EXPECT_EQ(UntaggedObject::ToAddr(inner.ptr()) +
+                  inner.ptr()->untag()->HeapSize(),
+              UntaggedObject::ToAddr(leaf.ptr()));
+  }
+}
+
+#if !defined(PRODUCT)
+TEST_CASE(SampledAllocationProfile) {
+  DisableBackgroundCompilationScope scope;
+  const char* kScriptChars = R"(
+    class Bar {}
+    final list = [];
+    foo() {
+      for (int i = 0; i < 100000; ++i) {
+        list.add(Bar());
+      }
+    }
+    )";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  EXPECT_VALID(lib);
+
+  EXPECT(SampledAllocationProfile::Enable(true));
+  HeapProfileSampler::SetSamplingInterval(1);
+  {
+    TransitionNativeToVM transition(thread);
+    thread->HandleInterrupts();
+  }
+  EXPECT_VALID(Dart_Invoke(lib, NewString("foo"), 0, nullptr));
+  EXPECT(SampledAllocationProfile::Enable(false));
+  EXPECT(SampledAllocationProfile::in_use());
+
+  TransitionNativeToVM transition(thread);
+  GCTestHelper::CollectAllGarbage();
+  JSONStream js;
+  thread->isolate_group()->sampled_allocation_profile()->PrintJSON(thread,
+                                                                   &js);
+  const char* json = js.ToCString();
+  EXPECT_SUBSTRING("\"type\":\"_SampledAllocationProfile\"", json);
+  EXPECT_SUBSTRING("\"name\":\"Bar\"", json);
+  EXPECT_SUBSTRING("foo", json);
+  EXPECT_SUBSTRING("\"liveBytes\":", json);
+}
+#endif  // !defined(PRODUCT)
+
 }  // namespace dart
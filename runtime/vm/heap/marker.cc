@@ -37,12 +37,17 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
         work_list_(marking_stack),
         deferred_work_list_(deferred_marking_stack),
         marked_bytes_(0),
-        marked_micros_(0) {}
+        marked_micros_(0),
+        idle_micros_(0) {}
   ~MarkingVisitorBase() { ASSERT(delayed_.IsEmpty()); }
 
   uintptr_t marked_bytes() const { return marked_bytes_; }
   int64_t marked_micros() const { return marked_micros_; }
   void AddMicros(int64_t micros) { marked_micros_ += micros; }
+  // Time spent waiting for work or for other markers. Included in
+  // marked_micros.
+  int64_t idle_micros() const { return idle_micros_; }
+  void AddIdleMicros(int64_t micros) { idle_micros_ += micros; }
 
 #ifdef DEBUG
   constexpr static const char* const kName = "Marker";
@@ -119,6 +124,18 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
     do {
       do {
         // First drain the marking stacks.
+        if (!raw_obj->IsHeapObject()) {
+          // The remainder of a large array that is being scanned in slices.
+          const intptr_t size = ProcessArraySlice(static_cast<uword>(raw_obj));
+          marked_bytes_ += size;
+          remaining_budget -= size;
+          if (remaining_budget < 0) {
+            return true;  // More to mark.
+          }
+          raw_obj = work_list_.Pop();
+          continue;
+        }
+
         const intptr_t class_id = raw_obj->GetClassId();
 
         intptr_t size;
@@ -133,12 +150,17 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
         } else {
           if ((class_id == kArrayCid) || (class_id == kImmutableArrayCid)) {
             size = raw_obj->untag()->HeapSize();
-            if (size > remaining_budget) {
+            if (IsSliceable(raw_obj, size)) {
+              size = ProcessArraySlice(ToArraySlice(raw_obj, 0));
+            } else if (size > remaining_budget) {
               work_list_.Push(raw_obj);
               return true;  // More to mark.
+            } else {
+              size = raw_obj->untag()->VisitPointersNonvirtual(this);
             }
+          } else {
+            size = raw_obj->untag()->VisitPointersNonvirtual(this);
           }
-          size = raw_obj->untag()->VisitPointersNonvirtual(this);
         }
         marked_bytes_ += size;
         remaining_budget -= size;
@@ -160,6 +182,74 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
     return false;  // No more work.
   }
 
+  // Arrays at least this large are scanned in slices of kArraySliceBytes, with
+  // the unscanned remainder pushed back on the marking stack so that other
+  // markers can share the work and incremental budgets are respected.
+  static constexpr intptr_t kSliceableArrayBytes = Heap::kAllocatablePageSize;
+  static constexpr intptr_t kArraySliceBytes = 64 * KB;
+
+  // Such an array is the only object on its large page, so the remainder is
+  // pushed as a Smi-tagged word holding the page address and the index of the
+  // next slice in the bits below kPageSize.
+  static bool IsSliceable(ObjectPtr raw_array, intptr_t size) {
+    if (size < kSliceableArrayBytes) {
+      return false;
+    }
+    const uword addr = UntaggedObject::ToAddr(raw_array);
+    return addr == (addr & kPageMask) + Page::OldObjectStartOffset();
+  }
+
+  static uword ToArraySlice(ObjectPtr raw_array, intptr_t slice) {
+    const uword slice_bits = static_cast<uword>(slice) << kSmiTagSize;
+    ASSERT(slice_bits < static_cast<uword>(kPageSize));
+    return (UntaggedObject::ToAddr(raw_array) & kPageMask) | slice_bits;
+  }
+
+  static intptr_t ArraySliceLength(intptr_t length) {
+    // Keep the slice count within the bits available in ToArraySlice.
+    constexpr intptr_t kMaxSlices = kPageSize >> kSmiTagSize;
+    return Utils::Maximum(kArraySliceBytes / kCompressedWordSize,
+                          length / kMaxSlices + 1);
+  }
+
+  // Visits one slice of a large array and pushes the remainder, if any.
+  // Returns the number of bytes of the array covered by the slice; the slices
+  // of an array add up to its HeapSize.
+  intptr_t ProcessArraySlice(uword entry) {
+    ASSERT(!static_cast<ObjectPtr>(entry)->IsHeapObject());
+    const uword start = (entry & kPageMask) + Page::OldObjectStartOffset();
+    const intptr_t slice = (entry & ~kPageMask) >> kSmiTagSize;
+    ArrayPtr raw_array = static_cast<ArrayPtr>(UntaggedObject::FromAddr(start));
+    ASSERT(IsMarked(raw_array));
+    UntaggedArray* array = raw_array->untag();
+
+    const intptr_t length = Smi::Value(array->length());
+    const intptr_t slice_length = ArraySliceLength(length);
+    const intptr_t first = slice * slice_length;
+    intptr_t last = first + slice_length;
+    if (last < length) {
+      work_list_.Push(static_cast<ObjectPtr>(ToArraySlice(raw_array, slice + 1)));
+      if (sync) {
+        // Make the remainder visible to idle markers.
+        work_list_.FlushOutput();
+      }
+    } else {
+      last = length;
+    }
+
+    CompressedObjectPtr* from =
+        (slice == 0) ? array->from() : &array->data()[first];
+    CompressedObjectPtr* to = &array->data()[last - 1];
+    VisitCompressedPointers(raw_array->heap_base(), from, to);
+
+    const uword slice_start =
+        (slice == 0) ? start : reinterpret_cast<uword>(&array->data()[first]);
+    const uword slice_end = (last == length)
+                                ? start + array->HeapSize()
+                                : reinterpret_cast<uword>(&array->data()[last]);
+    return slice_end - slice_start;
+  }
+
   // Races: The concurrent marker is racing with the mutator, but this race is
   // harmless. The concurrent marker will only visit objects that were created
   // before the marker started. It will ignore all new-space objects based on
@@ -454,6 +544,7 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
   GCLinkedLists delayed_;
   uintptr_t marked_bytes_;
   int64_t marked_micros_;
+  int64_t idle_micros_;
 
   template <typename GCVisitorType>
   friend void MournFinalized(GCVisitorType* visitor);
@@ -480,7 +571,7 @@ class MarkingWeakVisitor : public HandleVisitor {
         reinterpret_cast<FinalizablePersistentHandle*>(addr);
     ObjectPtr raw_obj = handle->ptr();
     if (IsUnreachable(raw_obj)) {
-      handle->UpdateUnreachable(thread()->isolate_group());
+      handle->UpdateUnreachable(thread()->isolate_group(), /*defer=*/true);
     }
   }
 
@@ -507,6 +598,27 @@ enum RootSlices {
   kNumFixedRootSlices = 1,
 };
 
+enum WeakSlices {
+  kWeakHandles = 0,
+  kObjectIdRing,
+  kRememberedSet,
+  kNumFixedWeakSlices,
+};
+
+// Large weak tables are split so that several workers can sweep them.
+static constexpr intptr_t kWeakTableChunkSize = 64 * KB;
+
+static intptr_t NumWeakTableChunks(WeakTable* table, intptr_t sel) {
+#if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
+  // The embedder's delete callback is not promised to be thread-safe.
+  if (sel == Heap::kHeapSamplingData) {
+    return 1;
+  }
+#endif
+  return Utils::RoundUp(table->size(), kWeakTableChunkSize) /
+         kWeakTableChunkSize;
+}
+
 void GCMarker::ResetSlices() {
   ASSERT(Thread::Current()->IsAtSafepoint());
 
@@ -519,6 +631,12 @@ void GCMarker::ResetSlices() {
   }
 
   weak_slices_started_ = 0;
+  weak_slices_count_ = kNumFixedWeakSlices;
+  for (intptr_t sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
+    weak_slices_count_ += NumWeakTableChunks(
+        heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel)),
+        sel);
+  }
 }
 
 void GCMarker::IterateRoots(ObjectPointerVisitor* visitor) {
@@ -557,18 +675,10 @@ void GCMarker::IterateRoots(ObjectPointerVisitor* visitor) {
   }
 }
 
-enum WeakSlices {
-  kWeakHandles = 0,
-  kWeakTables,
-  kObjectIdRing,
-  kRememberedSet,
-  kNumWeakSlices,
-};
-
 void GCMarker::IterateWeakRoots(Thread* thread) {
   for (;;) {
     intptr_t slice = weak_slices_started_.fetch_add(1);
-    if (slice >= kNumWeakSlices) {
+    if (slice >= weak_slices_count_) {
       return;  // No more slices.
     }
 
@@ -576,9 +686,6 @@ void GCMarker::IterateWeakRoots(Thread* thread) {
       case kWeakHandles:
         ProcessWeakHandles(thread);
         break;
-      case kWeakTables:
-        ProcessWeakTables(thread);
-        break;
       case kObjectIdRing:
         ProcessObjectIdTable(thread);
         break;
@@ -586,7 +693,7 @@ void GCMarker::IterateWeakRoots(Thread* thread) {
         ProcessRememberedSet(thread);
         break;
       default:
-        UNREACHABLE();
+        ProcessWeakTableChunk(thread, slice - kNumFixedWeakSlices);
     }
   }
 }
@@ -599,19 +706,33 @@ void GCMarker::ProcessWeakHandles(Thread* thread) {
   isolate_group_->VisitWeakPersistentHandles(&visitor);
 }
 
-void GCMarker::ProcessWeakTables(Thread* thread) {
+void GCMarker::ProcessWeakTableChunk(Thread* thread, intptr_t chunk) {
   TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessWeakTables");
-  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
+  // Find the table and range of entries this chunk covers. The tables cannot
+  // change shape while the mutators are stopped, so this agrees with the
+  // chunk count computed in ResetSlices.
+  for (intptr_t sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
+    WeakTable* table =
+        heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel));
+    const intptr_t num_chunks = NumWeakTableChunks(table, sel);
+    if (chunk >= num_chunks) {
+      chunk -= num_chunks;
+      continue;
+    }
+
     Dart_HeapSamplingDeleteCallback cleanup = nullptr;
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
     if (sel == Heap::kHeapSamplingData) {
       cleanup = HeapProfileSampler::delete_callback();
     }
 #endif
-    WeakTable* table =
-        heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel));
-    intptr_t size = table->size();
-    for (intptr_t i = 0; i < size; i++) {
+    const intptr_t size = table->size();
+    const intptr_t start = chunk * kWeakTableChunkSize;
+    const intptr_t end = num_chunks == 1
+                             ? size
+                             : Utils::Minimum(start + kWeakTableChunkSize, size);
+    intptr_t removed = 0;
+    for (intptr_t i = start; i < end; i++) {
       if (table->IsValidEntryAtExclusive(i)) {
         // The object has been collected.
         ObjectPtr raw_obj = table->ObjectAtExclusive(i);
@@ -619,11 +740,17 @@ void GCMarker::ProcessWeakTables(Thread* thread) {
           if (cleanup != nullptr) {
             cleanup(reinterpret_cast<void*>(table->ValueAtExclusive(i)));
           }
-          table->InvalidateAtExclusive(i);
+          table->ClearEntryAtExclusive(i);
+          removed++;
         }
       }
     }
+    if (removed != 0) {
+      table->ReduceCount(removed);
+    }
+    return;
   }
+  UNREACHABLE();
 }
 
 void GCMarker::ProcessRememberedSet(Thread* thread) {
@@ -704,6 +831,11 @@ class ParallelMarkTask : public ThreadPool::Task {
         visitor_(visitor),
         num_busy_(num_busy) {}
 
+  virtual Dart_TaskPriority priority(
+      Dart_TaskPriority pool_default) const {
+    return Dart_TaskPriority_High;
+  }
+
   virtual void Run() {
     if (!barrier_->TryEnter()) {
       barrier_->Release();
@@ -725,7 +857,10 @@ class ParallelMarkTask : public ThreadPool::Task {
   void RunEnteredIsolateGroup() {
     {
       Thread* thread = Thread::Current();
-      TIMELINE_FUNCTION_GC_DURATION(thread, "ParallelMark");
+#if defined(SUPPORT_TIMELINE)
+      TimelineBeginEndScope tbes(thread, Timeline::GetGCStream(),
+                                 "ParallelMark");
+#endif
       int64_t start = OS::GetCurrentMonotonicMicros();
 
       // Phase 1: Iterate over roots and drain marking stack in tasks.
@@ -738,15 +873,15 @@ class ParallelMarkTask : public ThreadPool::Task {
       do {
         do {
           visitor_->DrainMarkingStack();
-        } while (visitor_->WaitForWork(num_busy_));
+        } while (WaitForWork());
         // Wait for all markers to stop.
-        barrier_->Sync();
+        Sync();
 #if defined(DEBUG)
         ASSERT(num_busy_->load() == 0);
         // Caveat: must not allow any marker to continue past the barrier
         // before we checked num_busy, otherwise one of them might rush
         // ahead and increment it.
-        barrier_->Sync();
+        Sync();
 #endif
         // Check if we have any pending properties with marked keys.
         // Those might have been marked by another marker.
@@ -760,19 +895,19 @@ class ParallelMarkTask : public ThreadPool::Task {
         // weak properties and decide if they need to continue marking.
         // Caveat: we need two barriers here to make this decision in lock step
         // between all markers and the main thread.
-        barrier_->Sync();
+        Sync();
         if (!more_to_mark && (num_busy_->load() > 0)) {
           // All markers continue to mark as long as any single marker has
           // some work to do.
           num_busy_->fetch_add(1u);
           more_to_mark = true;
         }
-        barrier_->Sync();
+        Sync();
       } while (more_to_mark);
 
       // Phase 2: deferred marking.
       visitor_->ProcessDeferredMarking();
-      barrier_->Sync();
+      Sync();
 
       // Phase 3: Weak processing and statistics.
       visitor_->MournWeakProperties();
@@ -784,14 +919,41 @@ class ParallelMarkTask : public ThreadPool::Task {
       marker_->IterateWeakRoots(thread);
       int64_t stop = OS::GetCurrentMonotonicMicros();
       visitor_->AddMicros(stop - start);
+      const int64_t idle = visitor_->idle_micros();
+      const int64_t busy = visitor_->marked_micros() - idle;
+#if defined(SUPPORT_TIMELINE)
+      if (tbes.enabled()) {
+        tbes.SetNumArguments(3);
+        tbes.FormatArgument(0, "MarkedBytes", "%" Pu "",
+                            visitor_->marked_bytes());
+        tbes.FormatArgument(1, "BusyMicros", "%" Pd64 "", busy);
+        tbes.FormatArgument(2, "IdleMicros", "%" Pd64 "", idle);
+      }
+#endif
       if (FLAG_log_marker_tasks) {
-        THR_Print("Task marked %" Pd " bytes in %" Pd64 " micros.\n",
-                  visitor_->marked_bytes(), visitor_->marked_micros());
+        THR_Print("Task marked %" Pd " bytes in %" Pd64 " micros (%" Pd64
+                  " busy, %" Pd64 " idle).\n",
+                  visitor_->marked_bytes(), visitor_->marked_micros(), busy,
+                  idle);
       }
     }
   }
 
  private:
+  // Waiting on other markers is accounted as idle time.
+  bool WaitForWork() {
+    int64_t start = OS::GetCurrentMonotonicMicros();
+    bool result = visitor_->WaitForWork(num_busy_);
+    visitor_->AddIdleMicros(OS::GetCurrentMonotonicMicros() - start);
+    return result;
+  }
+
+  void Sync() {
+    int64_t start = OS::GetCurrentMonotonicMicros();
+    barrier_->Sync();
+    visitor_->AddIdleMicros(OS::GetCurrentMonotonicMicros() - start);
+  }
+
   GCMarker* marker_;
   IsolateGroup* isolate_group_;
   MarkingStack* marking_stack_;
@@ -818,6 +980,11 @@ class ConcurrentMarkTask : public ThreadPool::Task {
 #endif
   }
 
+  virtual Dart_TaskPriority priority(
+      Dart_TaskPriority pool_default) const {
+    return Dart_TaskPriority_Low;
+  }
+
   virtual void Run() {
     bool result = Thread::EnterIsolateGroupAsHelper(
         isolate_group_, Thread::kMarkerTask, /*bypass_safepoint=*/true);
@@ -872,24 +1039,46 @@ intptr_t GCMarker::MarkedWordsPerMicro() const {
   if (marked_words_per_job_micro == 0) {
     marked_words_per_job_micro = 1;  // Prevent division by zero.
   }
-  intptr_t jobs = FLAG_marker_tasks;
+  intptr_t jobs = num_tasks_;
   if (jobs == 0) {
     jobs = 1;  // Marking on main thread is still one job.
   }
   return marked_words_per_job_micro * jobs;
 }
 
+// With a negative --marker_tasks, use roughly one task per this many bytes of
+// old-space in use, bounded by the available processors.
+static constexpr intptr_t kMarkerTaskBytes = 64 * MB;
+static constexpr intptr_t kMinMarkerTasks = 2;
+static constexpr intptr_t kMaxMarkerTasks = 32;
+
+static intptr_t ComputeMarkerTasks(Heap* heap) {
+  if (FLAG_marker_tasks >= 0) {
+    return FLAG_marker_tasks;
+  }
+  const intptr_t processors = OS::NumberOfAvailableProcessors();
+  const intptr_t used = heap->old_space()->UsedInWords() << kWordSizeLog2;
+  intptr_t tasks = used / kMarkerTaskBytes + 1;
+  tasks = Utils::Maximum(tasks, kMinMarkerTasks);
+  tasks = Utils::Minimum(tasks, Utils::Minimum(processors, kMaxMarkerTasks));
+  return Utils::Maximum(tasks, static_cast<intptr_t>(1));
+}
+
 GCMarker::GCMarker(IsolateGroup* isolate_group, Heap* heap)
     : isolate_group_(isolate_group),
       heap_(heap),
+      num_tasks_(ComputeMarkerTasks(heap)),
       marking_stack_(),
       deferred_marking_stack_(),
       global_list_(),
       visitors_(),
       marked_bytes_(0),
       marked_micros_(0) {
-  visitors_ = new SyncMarkingVisitor*[FLAG_marker_tasks];
-  for (intptr_t i = 0; i < FLAG_marker_tasks; i++) {
+  if (FLAG_log_marker_tasks) {
+    THR_Print("Marking with %" Pd " tasks.\n", num_tasks_);
+  }
+  visitors_ = new SyncMarkingVisitor*[num_tasks_];
+  for (intptr_t i = 0; i < num_tasks_; i++) {
     visitors_[i] = nullptr;
   }
 }
@@ -899,7 +1088,7 @@ GCMarker::~GCMarker() {
   // marker and before finalizing.
   if (isolate_group_->marking_stack() != nullptr) {
     isolate_group_->DisableIncrementalBarrier();
-    for (intptr_t i = 0; i < FLAG_marker_tasks; i++) {
+    for (intptr_t i = 0; i < num_tasks_; i++) {
       visitors_[i]->AbandonWork();
       delete visitors_[i];
     }
@@ -911,7 +1100,7 @@ void GCMarker::StartConcurrentMark(PageSpace* page_space) {
   isolate_group_->EnableIncrementalBarrier(&marking_stack_,
                                            &deferred_marking_stack_);
 
-  const intptr_t num_tasks = FLAG_marker_tasks;
+  const intptr_t num_tasks = num_tasks_;
 
   {
     // Bulk increase task count before starting any task, instead of
@@ -1067,7 +1256,7 @@ void GCMarker::MarkObjects(PageSpace* page_space) {
   Prologue();
   {
     Thread* thread = Thread::Current();
-    const int num_tasks = FLAG_marker_tasks;
+    const intptr_t num_tasks = num_tasks_;
     if (num_tasks == 0) {
       TIMELINE_FUNCTION_GC_DURATION(thread, "Mark");
       int64_t start = OS::GetCurrentMonotonicMicros();
@@ -58,7 +58,7 @@ class GCMarker {
   void IterateRoots(ObjectPointerVisitor* visitor);
   void IterateWeakRoots(Thread* thread);
   void ProcessWeakHandles(Thread* thread);
-  void ProcessWeakTables(Thread* thread);
+  void ProcessWeakTableChunk(Thread* thread, intptr_t chunk);
   void ProcessRememberedSet(Thread* thread);
   void ProcessObjectIdTable(Thread* thread);
 
@@ -68,6 +68,9 @@ class GCMarker {
 
   IsolateGroup* const isolate_group_;
   Heap* const heap_;
+  // Fixed for the lifetime of the marker so that concurrent marking and its
+  // finalization agree on the number of visitors.
+  const intptr_t num_tasks_;
   MarkingStack marking_stack_;
   MarkingStack deferred_marking_stack_;
   GCLinkedLists global_list_;
@@ -79,6 +82,7 @@ class GCMarker {
   intptr_t root_slices_finished_;
   intptr_t root_slices_count_;
   RelaxedAtomic<intptr_t> weak_slices_started_;
+  intptr_t weak_slices_count_;
 
   uintptr_t marked_bytes_;
   int64_t marked_micros_;
@@ -21,11 +21,18 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            numa_aware_heap,
+            false,
+            "Back heap pages with memory from the NUMA node of the allocating "
+            "thread.");
+
 // This cache needs to be at least as big as FLAG_new_gen_semi_max_size or
 // munmap will noticeably impact performance.
 static constexpr intptr_t kPageCacheCapacity = 8 * kWordSize;
 static Mutex* page_cache_mutex = nullptr;
 static VirtualMemory* page_cache[kPageCacheCapacity] = {nullptr};
+static intptr_t page_cache_node[kPageCacheCapacity] = {0};
 static intptr_t page_cache_size = 0;
 
 void Page::Init() {
@@ -58,6 +65,8 @@ Page* Page::Allocate(intptr_t size, PageType type, bool can_use_cache) {
   const bool compressed = !executable;
   const char* name = executable ? "dart-code" : "dart-heap";
 
+  const intptr_t numa_node =
+      FLAG_numa_aware_heap ? VirtualMemory::CurrentNumaNode() : -1;
   VirtualMemory* memory = nullptr;
   if (can_use_cache) {
     // We don't automatically use the cache based on size and type because a
@@ -69,10 +78,23 @@ Page* Page::Allocate(intptr_t size, PageType type, bool can_use_cache) {
     MutexLocker ml(page_cache_mutex);
     ASSERT(page_cache_size >= 0);
     ASSERT(page_cache_size <= kPageCacheCapacity);
-    if (page_cache_size > 0) {
+    if (numa_node >= 0) {
+      // Cached pages are already populated, so only a page from the same
+      // node keeps the memory local.
+      for (intptr_t i = page_cache_size - 1; i >= 0; i--) {
+        if (page_cache_node[i] == numa_node) {
+          memory = page_cache[i];
+          page_cache_size--;
+          page_cache[i] = page_cache[page_cache_size];
+          page_cache_node[i] = page_cache_node[page_cache_size];
+          break;
+        }
+      }
+    } else if (page_cache_size > 0) {
       memory = page_cache[--page_cache_size];
     }
   }
+  const bool from_cache = memory != nullptr;
   if (memory == nullptr) {
     memory = VirtualMemory::AllocateAligned(size, kPageSize, executable,
                                             compressed, name);
@@ -80,6 +102,10 @@ Page* Page::Allocate(intptr_t size, PageType type, bool can_use_cache) {
   if (memory == nullptr) {
     return nullptr;  // Out of memory.
   }
+  if ((numa_node >= 0) && !from_cache) {
+    // Must precede the first write to the page.
+    VirtualMemory::PreferNumaNode(memory->address(), size, numa_node);
+  }
 
   if (type == kNew) {
 #if defined(DEBUG)
@@ -100,6 +126,10 @@ Page* Page::Allocate(intptr_t size, PageType type, bool can_use_cache) {
   result->forwarding_page_ = nullptr;
   result->card_table_ = nullptr;
   result->progress_bar_ = 0;
+  result->live_bytes_ = 0;
+  result->is_compacting_ = false;
+  result->pin_count_ = 0;
+  result->numa_node_ = numa_node;
   result->owner_ = nullptr;
   result->top_ = 0;
   result->end_ = 0;
@@ -142,6 +172,7 @@ void Page::Deallocate(bool can_use_cache) {
     ASSERT(page_cache_size >= 0);
     ASSERT(page_cache_size <= kPageCacheCapacity);
     if (page_cache_size < kPageCacheCapacity) {
+      const intptr_t numa_node = numa_node_;
       intptr_t size = memory->size();
 #if defined(DEBUG)
       if (type_ == kNew) {
@@ -152,6 +183,7 @@ void Page::Deallocate(bool can_use_cache) {
       }
 #endif
       MSAN_POISON(memory->address(), size);
+      page_cache_node[page_cache_size] = numa_node;
       page_cache[page_cache_size++] = memory;
       memory = nullptr;
     }
@@ -160,7 +192,8 @@ void Page::Deallocate(bool can_use_cache) {
 }
 
 void Page::VisitObjects(ObjectVisitor* visitor) const {
-  ASSERT(Thread::Current()->IsAtSafepoint());
+  ASSERT(Thread::Current()->IsAtSafepoint() ||
+         (Thread::Current()->task_kind() == Thread::kHeapVisitorTask));
   NoSafepointScope no_safepoint;
   uword obj_addr = object_start();
   uword end_addr = object_end();
@@ -186,6 +219,14 @@ void Page::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   ASSERT(obj_addr == end_addr);
 }
 
+void Page::RememberAllCards() {
+  if (card_table_ == nullptr) {
+    card_table_ =
+        reinterpret_cast<uint8_t*>(calloc(card_table_size(), sizeof(uint8_t)));
+  }
+  memset(card_table_, 1, card_table_size() * sizeof(uint8_t));
+}
+
 void Page::VisitRememberedCards(ObjectPointerVisitor* visitor) {
   ASSERT(Thread::Current()->IsAtSafepoint() ||
          (Thread::Current()->task_kind() == Thread::kScavengerTask));
@@ -269,18 +310,18 @@ ObjectPtr Page::FindObject(FindObjectVisitor* visitor) const {
 
 void Page::WriteProtect(bool read_only) {
   ASSERT(!is_image_page());
+  memory_->Protect(WriteProtection(read_only));
+}
 
-  VirtualMemory::Protection prot;
+VirtualMemory::Protection Page::WriteProtection(bool read_only) const {
   if (read_only) {
     if ((type_ == kExecutable) && (memory_->AliasOffset() == 0)) {
-      prot = VirtualMemory::kReadExecute;
+      return VirtualMemory::kReadExecute;
     } else {
-      prot = VirtualMemory::kReadOnly;
+      return VirtualMemory::kReadOnly;
     }
-  } else {
-    prot = VirtualMemory::kReadWrite;
   }
-  memory_->Protect(prot);
+  return VirtualMemory::kReadWrite;
 }
 
 }  // namespace dart
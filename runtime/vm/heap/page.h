@@ -91,6 +91,27 @@ class Page {
   }
   intptr_t used() const { return object_end() - object_start(); }
 
+  // Bytes of live objects on this page as of the last sweep or compaction.
+  // Fresh pages count as fully used.
+  intptr_t live_bytes() const { return live_bytes_; }
+  void set_live_bytes(intptr_t value) { live_bytes_ = value; }
+
+  // Whether the compactor is moving the objects on this page.
+  bool is_compacting() const { return is_compacting_; }
+  void set_is_compacting(bool value) { is_compacting_ = value; }
+
+  // Pinned pages are not compacted, see PageSpace::PinObject.
+  bool is_pinned() const { return pin_count_ != 0; }
+  void IncrementPinCount() { pin_count_.fetch_add(1); }
+  void DecrementPinCount() {
+    ASSERT(pin_count_ > 0);
+    pin_count_.fetch_sub(1);
+  }
+
+  // The NUMA node this page's memory was requested from, or -1 when
+  // --numa_aware_heap is off or the node is unknown.
+  intptr_t numa_node() const { return numa_node_; }
+
   ForwardingPage* forwarding_page() const { return forwarding_page_; }
   void RegisterUnwindingRecords();
   void UnregisterUnwindingRecords();
@@ -106,6 +127,7 @@ class Page {
   ObjectPtr FindObject(FindObjectVisitor* visitor) const;
 
   void WriteProtect(bool read_only);
+  VirtualMemory::Protection WriteProtection(bool read_only) const;
 
   constexpr static intptr_t OldObjectStartOffset() {
     return Utils::RoundUp(sizeof(Page), kObjectStartAlignment,
@@ -224,6 +246,8 @@ class Page {
     return card_table_[index] != 0;
   }
 #endif
+  // Dirties every card, for stores whose slot is not known.
+  void RememberAllCards();
   void VisitRememberedCards(ObjectPointerVisitor* visitor);
   void ResetProgressBar();
 
@@ -242,6 +266,8 @@ class Page {
     survivor_end_ = end_;
   }
 
+  uword survivor_end() const { return survivor_end_; }
+
   uword promo_candidate_words() const {
     return (survivor_end_ - object_start()) / kWordSize;
   }
@@ -256,6 +282,7 @@ class Page {
   void Release(Thread* thread) {
     ASSERT(owner_ == thread);
     owner_ = nullptr;
+    thread->AccountTLABAllocation(thread->top() - top_);
     top_ = thread->top();
     thread->set_top(0);
     thread->set_end(0);
@@ -312,6 +339,10 @@ class Page {
   ForwardingPage* forwarding_page_;
   uint8_t* card_table_;  // Remembered set, not marking.
   RelaxedAtomic<intptr_t> progress_bar_;
+  intptr_t live_bytes_;
+  bool is_compacting_;
+  RelaxedAtomic<intptr_t> pin_count_;
+  intptr_t numa_node_;
 
   // The thread using this page for allocation, otherwise nullptr.
   Thread* owner_;
@@ -336,6 +367,7 @@ class Page {
   friend class SemiSpace;
   friend class PageSpace;
   friend class GCCompactor;
+  friend class HeapSnapshotWriter;
   friend class UnwindingRecords;
 
   DISALLOW_ALLOCATION();
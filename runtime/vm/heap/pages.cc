@@ -16,6 +16,7 @@
 #include "vm/log.h"
 #include "vm/object.h"
 #include "vm/object_set.h"
+#include "vm/os.h"
 #include "vm/os_thread.h"
 #include "vm/unwinding_records.h"
 #include "vm/virtual_memory.h"
@@ -43,6 +44,38 @@ DEFINE_FLAG(bool,
             false,
             "Print free list statistics after a GC");
 DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
+DEFINE_FLAG(bool,
+            use_incremental_compactor,
+            false,
+            "During old-space GCs that would not otherwise compact, compact "
+            "the most fragmented pages within --compactor_pause_budget.");
+DEFINE_FLAG(bool,
+            lazy_sweep,
+            true,
+            "When old-space allocation misses the freelist while the "
+            "concurrent sweeper is running, sweep a page on demand instead of "
+            "growing the heap.");
+DEFINE_FLAG(int,
+            compactor_pause_budget,
+            5,
+            "The desired maximum time in milliseconds spent compacting "
+            "fragmented pages during an old-space GC.");
+DEFINE_FLAG(int,
+            old_gen_soft_limit,
+            0,
+            "Old gen size in MB that GC works harder to stay below and above "
+            "which free memory is returned to the OS, or 0 to derive it from "
+            "the container memory limit.");
+DEFINE_FLAG(int,
+            old_gen_container_soft_limit_percent,
+            70,
+            "The percentage of the container memory limit used as "
+            "--old_gen_soft_limit when that is 0, or 0 for none.");
+DEFINE_FLAG(int,
+            old_gen_container_hard_limit_percent,
+            90,
+            "The percentage of the container memory limit that old gen may "
+            "not grow beyond, or 0 for no limit besides --old_gen_heap_size.");
 
 // The initial estimate of how many words we can mark per microsecond (usage
 // before / mark-sweep time). This is a conservative value observed running
@@ -50,12 +83,21 @@ DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
 // based on the device's actual speed.
 static constexpr intptr_t kConservativeInitialMarkSpeed = 20;
 
+// The initial estimate of how many live bytes the incremental compactor can
+// move per microsecond, including forwarding pointers in the rest of the heap.
+// Afterwards we use the speed observed in the previous compaction.
+static constexpr intptr_t kConservativeInitialCompactSpeed = 256;
+
+// Pages with at most this percentage of live bytes are considered fragmented.
+static constexpr intptr_t kFragmentedPageLivePercent = 50;
+
 PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
     : heap_(heap),
       num_freelists_(Utils::Maximum(FLAG_scavenger_tasks, 1) + 1),
       freelists_(new FreeList[num_freelists_]),
       pages_lock_(),
-      max_capacity_in_words_(max_capacity_in_words),
+      max_capacity_in_words_(
+          PageSpaceController::HardLimitInWords(max_capacity_in_words)),
       usage_(),
       allocated_black_in_words_(0),
       tasks_lock_(),
@@ -73,6 +115,7 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
       gc_time_micros_(0),
       collections_(0),
       mark_words_per_micro_(kConservativeInitialMarkSpeed),
+      compact_bytes_per_micro_(kConservativeInitialCompactSpeed),
       enable_concurrent_mark_(FLAG_concurrent_mark) {
   // We aren't holding the lock but no one can reference us yet.
   UpdateMaxCapacityLocked();
@@ -202,6 +245,7 @@ Page* PageSpace::AllocatePage(Page::PageType type, bool link) {
   if (!is_exec && (heap_ != nullptr) && !heap_->is_vm_isolate()) {
     page->AllocateForwardingPage();
   }
+  page->set_live_bytes(page->used());
 
   if (is_exec && !page->is_image_page()) {
     UnwindingRecords::RegisterExecutablePage(page);
@@ -303,6 +347,53 @@ void PageSpace::FreePages(Page* pages, bool can_use_cache) {
   }
 }
 
+// Upper bound on the pages one allocation sweeps before giving up and
+// growing, so a run of nearly full pages cannot stall the mutator.
+static constexpr intptr_t kMaxLazySweepPages = 8;
+
+uword PageSpace::TryAllocateAfterLazySweep(intptr_t size,
+                                           FreeList* freelist,
+                                           bool is_locked) {
+  // Outside of a safepoint, regular pages are only waiting to be swept while
+  // the concurrent sweeper is running.
+  if (Thread::Current()->IsAtSafepoint()) {
+    return 0;
+  }
+
+  GCSweeper sweeper;
+  for (intptr_t i = 0; i < kMaxLazySweepPages; i++) {
+    Page* page;
+    {
+      MutexLocker ml(&pages_lock_);
+      page = sweep_regular_;
+      if (page == nullptr) {
+        return 0;  // The sweeper has caught up.
+      }
+      sweep_regular_ = page->next();
+    }
+    page->set_next(nullptr);
+    ASSERT(page->type() == Page::kData);
+
+    bool page_in_use = sweeper.SweepPage(page, freelist, is_locked);
+    if (page_in_use) {
+      MutexLocker ml(&pages_lock_);
+      AddPageLocked(page);
+    } else {
+      const intptr_t page_size = page->memory_->size();
+      page->Deallocate(/*can_use_cache*/ true);
+      MutexLocker ml(&pages_lock_);
+      IncreaseCapacityInWordsLocked(-(page_size >> kWordSizeLog2));
+    }
+
+    uword result = is_locked ? freelist->TryAllocateLocked(size, false)
+                             : freelist->TryAllocate(size, false);
+    if (result != 0) {
+      return result;
+    }
+  }
+  return 0;
+}
+
 uword PageSpace::TryAllocateInFreshPage(intptr_t size,
                                         FreeList* freelist,
                                         Page::PageType type,
@@ -310,6 +401,16 @@ uword PageSpace::TryAllocateInFreshPage(intptr_t size,
                                         bool is_locked) {
   ASSERT(Heap::IsAllocatableViaFreeLists(size));
 
+  if (FLAG_lazy_sweep && (type == Page::kData)) {
+    // Reuse memory the concurrent sweeper has not reached yet before asking
+    // for more.
+    uword result = TryAllocateAfterLazySweep(size, freelist, is_locked);
+    if (result != 0) {
+      usage_.used_in_words += (size >> kWordSizeLog2);
+      return result;
+    }
+  }
+
   if (growth_policy != kForceGrowth) {
     ASSERT(!Thread::Current()->force_growth());
     if (heap_ != nullptr) {  // Some unit tests.
@@ -412,6 +513,76 @@ uword PageSpace::TryAllocateInternal(intptr_t size,
   return result;
 }
 
+// Objects up to this size are allocated from thread-local buffers of
+// kThreadLocalBufferSize bytes.
+static constexpr intptr_t kMaxThreadLocalAllocationSize = 1 * KB;
+static constexpr intptr_t kThreadLocalBufferSize = 16 * KB;
+
+uword PageSpace::TryAllocateThreadLocalSlow(Thread* thread, intptr_t size) {
+  // Tasks that bypass safepoints may run during GC, when the buffers are
+  // handed back to the sweeper.
+  if ((size > kMaxThreadLocalAllocationSize) || thread->BypassSafepoints()) {
+    return TryAllocate(size);
+  }
+
+  FreeList* freelist = DataFreeList();
+  MutexLocker ml(freelist->mutex());
+  AbandonThreadLocalBufferLocked(thread, freelist);
+  FreeListElement* block =
+      freelist->TryAllocateLargeLocked(kThreadLocalBufferSize);
+  if (block == nullptr) {
+    // Allocating from a fresh page leaves its remainder on the freelist for
+    // the next refill.
+    return TryAllocateDataLocked(freelist, size, kControlGrowth);
+  }
+  const uword start = reinterpret_cast<uword>(block);
+  intptr_t block_size = block->HeapSize();
+  if (block_size > kThreadLocalBufferSize) {
+    freelist->FreeLocked(start + kThreadLocalBufferSize,
+                         block_size - kThreadLocalBufferSize);
+    block_size = kThreadLocalBufferSize;
+  }
+  usage_.used_in_words += (block_size >> kWordSizeLog2);
+
+  const uword top = start + size;
+  const uword end = start + block_size;
+  thread->set_old_top(top);
+  thread->set_old_end(end);
+  if (top < end) {
+    FreeListElement::AsElement(top, end - top);
+  }
+  return start;
+}
+
+void PageSpace::AbandonThreadLocalBufferLocked(Thread* thread,
+                                               FreeList* freelist) {
+  const uword top = thread->old_top();
+  const uword end = thread->old_end();
+  if (top < end) {
+    freelist->FreeLocked(top, end - top);
+    usage_.used_in_words -= ((end - top) >> kWordSizeLog2);
+  }
+  thread->set_old_top(0);
+  thread->set_old_end(0);
+}
+
+void PageSpace::AbandonThreadLocalBuffer(Thread* thread) {
+  if (thread->old_end() == 0) {
+    return;
+  }
+  FreeList* freelist = DataFreeList();
+  MutexLocker ml(freelist->mutex());
+  AbandonThreadLocalBufferLocked(thread, freelist);
+}
+
+void PageSpace::AbandonThreadLocalBuffers() {
+  if (heap_ == nullptr) {
+    return;
+  }
+  heap_->isolate_group()->thread_registry()->ForEachThread(
+      [&](Thread* thread) { AbandonThreadLocalBuffer(thread); });
+}
+
 void PageSpace::AcquireLock(FreeList* freelist) {
   freelist->mutex()->Lock();
 }
@@ -637,6 +808,15 @@ void PageSpace::VisitObjectsImagePages(ObjectVisitor* visitor) const {
   }
 }
 
+void PageSpace::AddPagesTo(MallocGrowableArray<Page*>* pages,
+                           bool include_image_pages) const {
+  for (ExclusivePageIterator it(this); !it.Done(); it.Advance()) {
+    if (include_image_pages || !it.page()->is_image_page()) {
+      pages->Add(it.page());
+    }
+  }
+}
+
 void PageSpace::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   for (ExclusivePageIterator it(this); !it.Done(); it.Advance()) {
     it.page()->VisitObjectPointers(visitor);
@@ -793,21 +973,73 @@ void PageSpace::PrintHeapMapToJSONStream(IsolateGroup* isolate_group,
 }
 #endif  // PRODUCT
 
+// Changes the protection of a sequence of pages, using a single call for runs
+// of pages that are adjacent in memory. Pages are usually mapped next to each
+// other, so this saves most of the system calls and TLB shootdowns when all
+// code pages are flipped at once.
+class PageProtectionBatch : public ValueObject {
+ public:
+  explicit PageProtectionBatch(bool read_only) : read_only_(read_only) {}
+  ~PageProtectionBatch() { Flush(); }
+
+  void Add(Page* page) {
+    ASSERT(!page->is_image_page());
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID) ||            \
+    defined(DART_HOST_OS_MACOS)
+    const VirtualMemory::Protection protection =
+        page->WriteProtection(read_only_);
+    if (end_ != 0 && protection == protection_) {
+      if (page->start() == end_) {
+        end_ = page->end();
+        return;
+      }
+      if (page->end() == start_) {
+        start_ = page->start();
+        return;
+      }
+    }
+    Flush();
+    start_ = page->start();
+    end_ = page->end();
+    protection_ = protection;
+#else
+    // Other platforms cannot change the protection of several mappings in
+    // one call.
+    page->WriteProtect(read_only_);
+#endif
+  }
+
+ private:
+  void Flush() {
+    if (end_ != 0) {
+      VirtualMemory::Protect(reinterpret_cast<void*>(start_), end_ - start_,
+                             protection_);
+      start_ = end_ = 0;
+    }
+  }
+
+  const bool read_only_;
+  uword start_ = 0;
+  uword end_ = 0;
+  VirtualMemory::Protection protection_ = VirtualMemory::kNoAccess;
+};
+
 void PageSpace::WriteProtectCode(bool read_only) {
   if (FLAG_write_protect_code) {
     MutexLocker ml(&pages_lock_);
     NoSafepointScope no_safepoint;
+    PageProtectionBatch batch(read_only);
     // No need to go through all of the data pages first.
     Page* page = exec_pages_;
     while (page != nullptr) {
       ASSERT(page->type() == Page::kExecutable);
-      page->WriteProtect(read_only);
+      batch.Add(page);
       page = page->next();
     }
     page = large_pages_;
     while (page != nullptr) {
       if (page->type() == Page::kExecutable) {
-        page->WriteProtect(read_only);
+        batch.Add(page);
       }
       page = page->next();
     }
@@ -1007,6 +1239,9 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
 
   NoSafepointScope no_safepoints(thread);
 
+  // The sweeper must see the unused parts of the allocation buffers as free.
+  AbandonThreadLocalBuffers();
+
   if (FLAG_print_free_list_before_gc) {
     for (intptr_t i = 0; i < num_freelists_; i++) {
       OS::PrintErr("Before GC: Freelist %" Pd "\n", i);
@@ -1084,6 +1319,12 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
 
   bool has_reservation = MarkReservation();
 
+  // Pinned objects must not move. Pages without pinned objects may still be
+  // compacted incrementally below.
+  if (compact && HasPinnedObjects()) {
+    compact = false;
+  }
+
   {
     // Move pages to sweeper work lists.
     MutexLocker ml(&pages_lock_);
@@ -1097,6 +1338,18 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
     }
   }
 
+  Page* fragmented = nullptr;
+  if (!compact && FLAG_use_incremental_compactor && (heap_ != nullptr) &&
+      !heap_->is_vm_isolate()) {
+    fragmented = SelectFragmentedPages();
+  }
+  if (fragmented != nullptr) {
+    // The remaining regular pages are swept as usual, but only after the
+    // compactor has forwarded their pointers into the fragmented pages.
+    SweepLarge();
+    CompactFragmentedPages(thread, fragmented);
+  }
+
   bool can_verify;
   if (compact) {
     SweepLarge();
@@ -1215,6 +1468,26 @@ void PageSpace::Sweep(bool exclusive) {
       DataFreeList(i)->mutex()->Unlock();
     }
   }
+
+  if (ExceedsSoftLimit()) {
+    ReleaseFreeMemory();
+  }
+}
+
+intptr_t PageSpace::ReleaseFreeMemory() {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ReleaseFreeMemory");
+  intptr_t released = Page::CachedSize();
+  Page::ClearCache();
+  for (intptr_t i = 0; i < num_freelists_; i++) {
+    if (i != Page::kExecutable) {
+      released += freelists_[i].ReleaseFreeMemory();
+    }
+  }
+  if ((FLAG_log_growth || FLAG_verbose_gc) && (heap_ != nullptr)) {
+    THR_Print("%s: released %" Pd "KB of free memory\n",
+              heap_->isolate_group()->source()->name, released / KB);
+  }
+  return released;
 }
 
 void PageSpace::ConcurrentSweep(IsolateGroup* isolate_group) {
@@ -1233,6 +1506,103 @@ void PageSpace::Compact(Thread* thread) {
   }
 }
 
+static int CompareLiveBytes(Page* const* a, Page* const* b) {
+  const intptr_t a_live = (*a)->live_bytes();
+  const intptr_t b_live = (*b)->live_bytes();
+  return (a_live < b_live) ? -1 : ((a_live == b_live) ? 0 : 1);
+}
+
+// Removes the most fragmented pages from the sweeper's work list, as many as
+// we expect to compact within the pause budget. Returns nullptr if compacting
+// them would not release at least one page.
+Page* PageSpace::SelectFragmentedPages() {
+  const intptr_t budget_in_bytes =
+      static_cast<intptr_t>(FLAG_compactor_pause_budget) *
+      kMicrosecondsPerMillisecond * compact_bytes_per_micro_;
+
+  MallocGrowableArray<Page*> candidates;
+  for (Page* page = sweep_regular_; page != nullptr; page = page->next()) {
+    if (page->is_pinned()) {
+      continue;
+    }
+    if ((page->live_bytes() * 100) <=
+        (page->used() * kFragmentedPageLivePercent)) {
+      candidates.Add(page);
+    }
+  }
+  candidates.Sort(CompareLiveBytes);
+
+  intptr_t selected = 0;
+  intptr_t live_in_bytes = 0;
+  intptr_t used_in_bytes = 0;
+  while (selected < candidates.length()) {
+    Page* page = candidates[selected];
+    if (live_in_bytes + page->live_bytes() > budget_in_bytes) {
+      break;
+    }
+    live_in_bytes += page->live_bytes();
+    used_in_bytes += page->used();
+    selected++;
+  }
+  // Sliding the live objects together must free at least one page.
+  if ((selected < 2) || (used_in_bytes - live_in_bytes < kPageSize)) {
+    if (FLAG_log_growth) {
+      THR_Print("%s: skipping incremental compaction (%" Pd
+                " candidate pages)\n",
+                heap_->isolate_group()->source()->name, candidates.length());
+    }
+    // Slowly recover from a pessimistic estimate so that compaction is
+    // retried once the heap allows it.
+    compact_bytes_per_micro_ =
+        Utils::Minimum(compact_bytes_per_micro_ * 2,
+                       kConservativeInitialCompactSpeed);
+    return nullptr;
+  }
+
+  for (intptr_t i = 0; i < selected; i++) {
+    candidates[i]->set_is_compacting(true);
+  }
+  Page* fragmented = nullptr;
+  Page* fragmented_tail = nullptr;
+  Page* remaining = nullptr;
+  Page* remaining_tail = nullptr;
+  for (Page* page = sweep_regular_; page != nullptr;) {
+    Page* next = page->next();
+    page->set_next(nullptr);
+    Page** head = page->is_compacting() ? &fragmented : &remaining;
+    Page** tail = page->is_compacting() ? &fragmented_tail : &remaining_tail;
+    if (*tail == nullptr) {
+      *head = page;
+    } else {
+      (*tail)->set_next(page);
+    }
+    *tail = page;
+    page = next;
+  }
+  sweep_regular_ = remaining;
+  compacted_live_bytes_ = live_in_bytes;
+  return fragmented;
+}
+
+void PageSpace::CompactFragmentedPages(Thread* thread, Page* fragmented) {
+  TIMELINE_FUNCTION_GC_DURATION(thread, "CompactFragmentedPages");
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  ASSERT(pages_ == nullptr);
+  {
+    GCCompactor compactor(thread, heap_);
+    compactor.Compact(fragmented, &freelists_[Page::kData], &pages_lock_);
+  }
+  const int64_t micros = OS::GetCurrentMonotonicMicros() - start;
+  compact_bytes_per_micro_ = Utils::Maximum(
+      static_cast<intptr_t>(1),
+      compacted_live_bytes_ / Utils::Maximum(micros, static_cast<int64_t>(1)));
+  if (FLAG_log_growth) {
+    THR_Print("%s: compacted %" Pd " live bytes in %" Pd64 " micros\n",
+              heap_->isolate_group()->source()->name, compacted_live_bytes_,
+              micros);
+  }
+}
+
 uword PageSpace::TryAllocateDataBumpLocked(FreeList* freelist, intptr_t size) {
   ASSERT(size >= kObjectAlignment);
   ASSERT(Utils::IsAligned(size, kObjectAlignment));
@@ -1325,6 +1695,18 @@ void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   image_pages_ = page;
 }
 
+void PageSpace::PinObject(ObjectPtr object) {
+  ASSERT(object->IsOldObject() && !IsObjectFromImagePages(object));
+  Page::Of(object)->IncrementPinCount();
+  pinned_objects_.fetch_add(1);
+}
+
+void PageSpace::UnpinObject(ObjectPtr object) {
+  ASSERT(object->IsOldObject() && !IsObjectFromImagePages(object));
+  Page::Of(object)->DecrementPinCount();
+  pinned_objects_.fetch_sub(1);
+}
+
 bool PageSpace::IsObjectFromImagePages(dart::ObjectPtr object) {
   uword object_addr = UntaggedObject::ToAddr(object);
   Page* image_page = image_pages_;
@@ -1337,6 +1719,30 @@ bool PageSpace::IsObjectFromImagePages(dart::ObjectPtr object) {
   return false;
 }
 
+// Returns [percent] of the container memory limit, or 0 if there is none.
+static intptr_t ContainerLimitInWords(intptr_t percent) {
+  const int64_t limit = OS::GetMemoryLimit();
+  if ((limit <= 0) || (percent <= 0)) {
+    return 0;
+  }
+  const int64_t limit_in_words = limit / 100 * percent / kWordSize;
+  return static_cast<intptr_t>(
+      Utils::Minimum<int64_t>(limit_in_words, kIntptrMax / kWordSize));
+}
+
+intptr_t PageSpaceController::HardLimitInWords(
+    intptr_t max_capacity_in_words) {
+  const intptr_t container_limit_in_words =
+      ContainerLimitInWords(FLAG_old_gen_container_hard_limit_percent);
+  if (container_limit_in_words == 0) {
+    return max_capacity_in_words;
+  }
+  if (max_capacity_in_words == 0) {
+    return container_limit_in_words;
+  }
+  return Utils::Minimum(max_capacity_in_words, container_limit_in_words);
+}
+
 PageSpaceController::PageSpaceController(Heap* heap,
                                          int heap_growth_ratio,
                                          int heap_growth_max,
@@ -1346,8 +1752,13 @@ PageSpaceController::PageSpaceController(Heap* heap,
       desired_utilization_((100.0 - heap_growth_ratio) / 100.0),
       heap_growth_max_(heap_growth_max),
       garbage_collection_time_ratio_(garbage_collection_time_ratio),
+      soft_limit_in_words_(FLAG_old_gen_soft_limit > 0
+                               ? FLAG_old_gen_soft_limit * MBInWords
+                               : ContainerLimitInWords(
+                                     FLAG_old_gen_container_soft_limit_percent)),
       idle_gc_threshold_in_words_(0) {
-  const intptr_t growth_in_pages = heap_growth_max / 2;
+  const intptr_t growth_in_pages =
+      ClampToSoftLimit(last_usage_, heap_growth_max / 2);
   RecordUpdate(last_usage_, last_usage_, growth_in_pages, "initial");
 }
 
@@ -1481,6 +1892,7 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
     intptr_t min_step = (2 * MB) / kPageSize;
     grow_heap = Utils::Maximum(min_step, grow_heap);
   }
+  grow_heap = ClampToSoftLimit(after, grow_heap);
 
   RecordUpdate(before, after, grow_heap, "gc");
 }
@@ -1501,10 +1913,25 @@ void PageSpaceController::EvaluateAfterLoading(SpaceUsage after) {
   // Apply growth cap.
   growth_in_pages =
       Utils::Minimum(static_cast<intptr_t>(heap_growth_max_), growth_in_pages);
+  growth_in_pages = ClampToSoftLimit(after, growth_in_pages);
 
   RecordUpdate(after, after, growth_in_pages, "loaded");
 }
 
+intptr_t PageSpaceController::ClampToSoftLimit(SpaceUsage after,
+                                               intptr_t growth_in_pages) const {
+  if (soft_limit_in_words_ == 0) {
+    return growth_in_pages;
+  }
+  const intptr_t headroom_in_pages =
+      (soft_limit_in_words_ - after.CombinedUsedInWords()) / kPageSizeInWords;
+  // Past the soft limit, keep collecting after each small growth step
+  // instead of after each growth_in_pages.
+  const intptr_t min_step = (2 * MB) / kPageSize;
+  return Utils::Maximum(Utils::Minimum(min_step, growth_in_pages),
+                        Utils::Minimum(headroom_in_pages, growth_in_pages));
+}
+
 void PageSpaceController::RecordUpdate(SpaceUsage before,
                                        SpaceUsage after,
                                        intptr_t growth_in_pages,
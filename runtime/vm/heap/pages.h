@@ -72,6 +72,19 @@ class PageSpaceController {
   // Returns whether an idle GC is worthwhile.
   bool ReachedIdleThreshold(SpaceUsage current) const;
 
+  // Returns whether the committed memory exceeds the soft limit, above which
+  // free memory should be returned to the OS.
+  bool ExceedsSoftLimit(SpaceUsage current) const {
+    return (soft_limit_in_words_ != 0) &&
+           (current.CombinedCapacityInWords() > soft_limit_in_words_);
+  }
+  intptr_t soft_limit_in_words() const { return soft_limit_in_words_; }
+
+  // Returns the maximum capacity of old space, which is the smaller of
+  // [max_capacity_in_words] and a limit derived from the container's memory
+  // limit. 0 means unlimited.
+  static intptr_t HardLimitInWords(intptr_t max_capacity_in_words);
+
   // Should be called after each collection to update the controller state.
   void EvaluateGarbageCollection(SpaceUsage before,
                                  SpaceUsage after,
@@ -84,6 +97,10 @@ class PageSpaceController {
  private:
   friend class PageSpace;  // For MergeOtherPageSpaceController
 
+  // Limits growth so that the next GC happens before usage passes the soft
+  // limit.
+  intptr_t ClampToSoftLimit(SpaceUsage after, intptr_t growth_in_pages) const;
+
   void RecordUpdate(SpaceUsage before, SpaceUsage after, const char* reason);
   void RecordUpdate(SpaceUsage before,
                     SpaceUsage after,
@@ -110,6 +127,11 @@ class PageSpaceController {
   // we grow the heap more aggressively.
   const int garbage_collection_time_ratio_;
 
+  // As usage approaches this amount, GC is done more often to stay below it,
+  // and above it free memory is returned to the OS after sweeping. 0 means
+  // no soft limit.
+  const intptr_t soft_limit_in_words_;
+
   // Perform a stop-the-world GC when usage exceeds this amount.
   intptr_t hard_gc_threshold_in_words_;
 
@@ -147,6 +169,31 @@ class PageSpace {
                                is_protected, is_locked);
   }
 
+  // Allocates from the thread's old-space allocation buffer without taking a
+  // freelist lock. The buffer is refilled from the data freelist when it runs
+  // out. Unused memory at the end of the buffer is kept formatted as a
+  // FreeListElement so the page stays walkable.
+  DART_FORCE_INLINE
+  uword TryAllocateThreadLocal(Thread* thread, intptr_t size) {
+    ASSERT(Utils::IsAligned(size, kObjectAlignment));
+    const uword result = thread->old_top();
+    const uword new_top = result + size;
+    if (LIKELY(new_top <= thread->old_end())) {
+      thread->set_old_top(new_top);
+      if (new_top < thread->old_end()) {
+        FreeListElement::AsElement(new_top, thread->old_end() - new_top);
+      }
+      return result;
+    }
+    return TryAllocateThreadLocalSlow(thread, size);
+  }
+
+  // Return the thread's (or all threads') old-space allocation buffer to the
+  // data freelist. Must be done before sweeping and when a thread leaves the
+  // isolate group.
+  void AbandonThreadLocalBuffer(Thread* thread);
+  void AbandonThreadLocalBuffers();
+
   void TryReleaseReservation();
   bool MarkReservation();
   void TryReserveForOOM();
@@ -161,6 +208,9 @@ class PageSpace {
   bool ReachedIdleThreshold() const {
     return page_space_controller_.ReachedIdleThreshold(usage_);
   }
+  bool ExceedsSoftLimit() const {
+    return page_space_controller_.ExceedsSoftLimit(usage_);
+  }
   void EvaluateAfterLoading() {
     page_space_controller_.EvaluateAfterLoading(usage_);
   }
@@ -208,6 +258,10 @@ class PageSpace {
   void VisitObjectsImagePages(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
+  // Adds all pages to [pages], e.g. to divide them among several visitors.
+  void AddPagesTo(MallocGrowableArray<Page*>* pages,
+                  bool include_image_pages) const;
+
   void VisitRememberedCards(ObjectPointerVisitor* visitor) const;
   void ResetProgressBars() const;
 
@@ -229,6 +283,10 @@ class PageSpace {
   void IncrementalMarkWithTimeBudget(int64_t deadline);
   void AssistTasks(MonitorLocker* ml);
 
+  // Returns the memory of free data pages and of the insides of large free
+  // blocks to the OS. Returns the number of bytes released.
+  intptr_t ReleaseFreeMemory();
+
   void AddGCTime(int64_t micros) { gc_time_micros_ += micros; }
 
   int64_t gc_time_micros() const { return gc_time_micros_; }
@@ -332,6 +390,15 @@ class PageSpace {
 
   bool IsObjectFromImagePages(ObjectPtr object);
 
+  // Keeps the compactor from moving [object] until a matching UnpinObject,
+  // so native code may use its address across safepoints. [object] must be
+  // an old-space object on a page owned by this space. While any object is
+  // pinned, full compactions fall back to sweeping and incremental
+  // compaction skips the pinned pages.
+  void PinObject(ObjectPtr object);
+  void UnpinObject(ObjectPtr object);
+  bool HasPinnedObjects() const { return pinned_objects_ != 0; }
+
  private:
   // Ids for time and data records in Heap::GCStats.
   enum {
@@ -344,6 +411,9 @@ class PageSpace {
     kSweepLargePages = 5,
   };
 
+  uword TryAllocateThreadLocalSlow(Thread* thread, intptr_t size);
+  void AbandonThreadLocalBufferLocked(Thread* thread, FreeList* freelist);
+
   uword TryAllocateInternal(intptr_t size,
                             FreeList* freelist,
                             Page::PageType type,
@@ -355,6 +425,11 @@ class PageSpace {
                                Page::PageType type,
                                GrowthPolicy growth_policy,
                                bool is_locked);
+  // Sweeps pages not yet reached by the concurrent sweeper into [freelist]
+  // until it can satisfy the allocation. Returns 0 if it cannot.
+  uword TryAllocateAfterLazySweep(intptr_t size,
+                                  FreeList* freelist,
+                                  bool is_locked);
   uword TryAllocateInFreshLargePage(intptr_t size,
                                     Page::PageType type,
                                     GrowthPolicy growth_policy);
@@ -382,6 +457,8 @@ class PageSpace {
   void Sweep(bool exclusive);
   void ConcurrentSweep(IsolateGroup* isolate_group);
   void Compact(Thread* thread);
+  Page* SelectFragmentedPages();
+  void CompactFragmentedPages(Thread* thread, Page* fragmented);
 
   static intptr_t LargePageSizeInWordsFor(intptr_t size);
 
@@ -443,6 +520,9 @@ class PageSpace {
   int64_t gc_time_micros_;
   intptr_t collections_;
   intptr_t mark_words_per_micro_;
+  intptr_t compact_bytes_per_micro_;
+  intptr_t compacted_live_bytes_ = 0;
+  RelaxedAtomic<intptr_t> pinned_objects_ = {0};
 
   bool enable_concurrent_mark_;
 
@@ -8,6 +8,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, old_gen_soft_limit);
+
 TEST_CASE(Pages) {
   PageSpace* space = new PageSpace(nullptr, 4 * MBInWords);
   EXPECT(!space->Contains(reinterpret_cast<uword>(&space)));
@@ -31,4 +33,38 @@ TEST_CASE(Pages) {
   delete space;
 }
 
+TEST_CASE(Pages_ThreadLocalAllocation) {
+  PageSpace* space = new PageSpace(nullptr, 4 * MBInWords);
+  const intptr_t kBlockSize = 4 * kWordSize;
+  uword first = space->TryAllocateThreadLocal(thread, kBlockSize);
+  EXPECT(first != 0);
+  EXPECT(space->IsValidAddress(first));
+  // Small allocations are carved sequentially out of the thread's buffer.
+  uword second = space->TryAllocateThreadLocal(thread, kBlockSize);
+  EXPECT_EQ(first + kBlockSize, second);
+  EXPECT(space->UsedInWords() > 2 * (kBlockSize >> kWordSizeLog2));
+
+  // Abandoning the buffer returns the unused remainder to the space.
+  space->AbandonThreadLocalBuffer(thread);
+  EXPECT_EQ(0u, thread->old_top());
+  EXPECT_EQ(0u, thread->old_end());
+  EXPECT_EQ(2 * (kBlockSize >> kWordSizeLog2), space->UsedInWords());
+  delete space;
+}
+
+TEST_CASE(Pages_SoftLimit) {
+  SetFlagScope<int> sfs(&FLAG_old_gen_soft_limit, 8);
+  PageSpace* space = new PageSpace(nullptr, 0);
+  EXPECT(!space->ExceedsSoftLimit());
+  intptr_t total = 0;
+  while (total <= 16 * MB) {
+    const intptr_t kBlockSize = 64 * KB;
+    EXPECT(space->TryAllocate(kBlockSize, Page::kData,
+                              PageSpace::kForceGrowth) != 0);
+    total += kBlockSize;
+  }
+  EXPECT(space->ExceedsSoftLimit());
+  delete space;
+}
+
 }  // namespace dart
@@ -116,7 +116,9 @@ typename BlockStack<BlockSize>::Block* BlockStack<BlockSize>::WaitForWork(
       num_busy->fetch_add(1u);
       return partial_.Pop();
     }
+    num_waiters_.fetch_add(1);
     ml.Wait();
+    num_waiters_.fetch_sub(1);
     if (num_busy->load() == 0) {
       return nullptr;
     }
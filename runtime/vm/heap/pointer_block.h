@@ -110,6 +110,10 @@ class BlockStack {
 
   Block* WaitForWork(RelaxedAtomic<uintptr_t>* num_busy);
 
+  // Whether some worker is blocked in WaitForWork. Busy workers use this to
+  // publish work they would otherwise keep in their local blocks.
+  bool HasWaiters() const { return num_waiters_.load() > 0; }
+
  protected:
   class List {
    public:
@@ -139,6 +143,7 @@ class BlockStack {
   List full_;
   List partial_;
   Monitor monitor_;
+  RelaxedAtomic<intptr_t> num_waiters_ = 0;
 
   // Note: This is shared on the basis of block size.
   static constexpr intptr_t kMaxGlobalEmpty = 100;
@@ -195,6 +200,22 @@ class BlockWorkList : public ValueObject {
     local_output_->Push(raw_obj);
   }
 
+  // Publishes pushed work to other workers without giving up local input.
+  void FlushOutput() {
+    if (!local_output_->IsEmpty()) {
+      stack_->PushBlock(local_output_);
+      local_output_ = stack_->PopEmptyBlock();
+    }
+  }
+
+  // Like FlushOutput, but only when another worker is waiting for work, so
+  // that partially filled blocks are shared instead of starving idle workers.
+  void FlushOutputIfStarving() {
+    if (UNLIKELY(stack_->HasWaiters())) {
+      FlushOutput();
+    }
+  }
+
   void Flush() {
     if (!local_output_->IsEmpty()) {
       stack_->PushBlock(local_output_);
@@ -0,0 +1,128 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/heap/pretenuring.h"
+
+#include "vm/class_table.h"
+#include "vm/flags.h"
+#include "vm/heap/heap.h"
+#include "vm/isolate.h"
+#include "vm/lockers.h"
+#include "vm/log.h"
+#include "vm/object.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            pretenure,
+            false,
+            "Allocate instances of classes whose objects usually survive "
+            "their first scavenge directly in old space.");
+DEFINE_FLAG(int,
+            pretenure_survival_threshold,
+            80,
+            "Pretenure a class when at least this percentage of its new-space "
+            "allocation survives a scavenge.");
+DEFINE_FLAG(bool, trace_pretenuring, false, "Trace pretenuring decisions.");
+
+// A class needs to have allocated this much in new space before its survival
+// rate is trusted.
+static constexpr intptr_t kMinSampleWords = 64 * KBInWords;
+
+Pretenuring::Pretenuring(Heap* heap) : heap_(heap) {}
+
+bool Pretenuring::IsEnabled() {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  // AOT allocation stubs cannot be regenerated.
+  return false;
+#else
+  return FLAG_pretenure;
+#endif
+}
+
+void Pretenuring::Grow(intptr_t length) {
+  intptr_t old_length = feedback_.length();
+  feedback_.Resize(length);
+  for (intptr_t i = old_length; i < length; i++) {
+    feedback_[i] = Feedback();
+  }
+}
+
+void Pretenuring::UpdateAfterScavenge(Thread* thread) {
+  for (intptr_t cid = kNumPredefinedCids; cid < feedback_.length(); cid++) {
+    Feedback* feedback = &feedback_[cid];
+    if (feedback->allocated_words < kMinSampleWords) {
+      continue;
+    }
+    const intptr_t survival_percent =
+        feedback->survived_words * 100 / feedback->allocated_words;
+    feedback->allocated_words = 0;
+    feedback->survived_words = 0;
+    if (!feedback->pretenured &&
+        (survival_percent >= FLAG_pretenure_survival_threshold)) {
+      Change(cid, true);
+    }
+  }
+}
+
+void Pretenuring::UpdateAfterOldSpaceGC(Thread* thread) {
+  // Pretenured classes produce no new-space feedback, so move them back to
+  // new space and let the following scavenges decide again.
+  for (intptr_t cid = kNumPredefinedCids; cid < feedback_.length(); cid++) {
+    Feedback* feedback = &feedback_[cid];
+    feedback->allocated_words = 0;
+    feedback->survived_words = 0;
+    if (feedback->pretenured) {
+      Change(cid, false);
+    }
+  }
+}
+
+void Pretenuring::Change(intptr_t cid, bool pretenured) {
+  feedback_[cid].pretenured = pretenured;
+  if (FLAG_trace_pretenuring) {
+    THR_Print("[%s] %s class id %" Pd "\n",
+              heap_->isolate_group()->source()->name,
+              pretenured ? "pretenuring" : "de-pretenuring", cid);
+  }
+  {
+    MutexLocker ml(&pending_mutex_);
+    pending_.Add(cid);
+  }
+  // Applied on the next interrupt check, outside of the GC.
+  Thread::Current()->ScheduleInterrupts(Thread::kVMInterrupt);
+}
+
+void Pretenuring::ApplyPendingChanges(Thread* thread) {
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  MallocGrowableArray<intptr_t> cids;
+  {
+    MutexLocker ml(&pending_mutex_);
+    if (pending_.is_empty()) {
+      return;
+    }
+    for (intptr_t i = 0; i < pending_.length(); i++) {
+      cids.Add(pending_[i]);
+    }
+    pending_.Clear();
+  }
+
+  // The runtime allocates according to the current decision even before the
+  // stub is replaced; disabling it only moves callers off the inline
+  // new-space fast path, or back onto it.
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  Class& cls = Class::Handle(thread->zone());
+  for (intptr_t i = 0; i < cids.length(); i++) {
+    const intptr_t cid = cids[i];
+    if (!class_table->IsValidIndex(cid) || !class_table->HasValidClassAt(cid)) {
+      continue;
+    }
+    cls = class_table->At(cid);
+    cls.DisableAllocationStub();
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+}
+
+}  // namespace dart
@@ -0,0 +1,86 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_PRETENURING_H_
+#define RUNTIME_VM_HEAP_PRETENURING_H_
+
+#include "platform/growable_array.h"
+#include "vm/allocation.h"
+#include "vm/class_id.h"
+#include "vm/globals.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+class Heap;
+class Thread;
+
+// Decides which classes should be allocated directly in old space, based on
+// how many of their instances survive their first scavenge.
+//
+// Allocation sites are tracked per class: in JIT mode every instance
+// allocation goes through the class's allocation stub, so redirecting the
+// stub to the runtime moves all of the class's allocation sites at once
+// without recompiling their callers. Decisions are revisited after every
+// old-space collection by returning the classes to new space and sampling
+// them again.
+class Pretenuring {
+ public:
+  explicit Pretenuring(Heap* heap);
+
+  static bool IsEnabled();
+
+  // Whether instances of |cid| should be allocated in old space.
+  bool ShouldAllocateOld(intptr_t cid) const {
+    return (cid < feedback_.length()) && feedback_[cid].pretenured;
+  }
+
+  // Scavenger feedback for one object allocated in new space since the
+  // previous scavenge. Called with mutators stopped.
+  void RecordNewSpaceObject(intptr_t cid, intptr_t size, bool survived) {
+    if (cid < kNumPredefinedCids) {
+      return;  // Not allocated through a class allocation stub.
+    }
+    if (cid >= feedback_.length()) {
+      Grow(cid + 1);
+    }
+    Feedback* feedback = &feedback_[cid];
+    feedback->allocated_words += size >> kWordSizeLog2;
+    if (survived) {
+      feedback->survived_words += size >> kWordSizeLog2;
+    }
+  }
+
+  // Called with mutators stopped at the end of each collection.
+  void UpdateAfterScavenge(Thread* thread);
+  void UpdateAfterOldSpaceGC(Thread* thread);
+
+  // Replaces the allocation stubs of classes whose decision changed. Must be
+  // called from a mutator at a point where it may safepoint.
+  void ApplyPendingChanges(Thread* thread);
+
+ private:
+  struct Feedback {
+    intptr_t allocated_words = 0;
+    intptr_t survived_words = 0;
+    bool pretenured = false;
+  };
+
+  void Grow(intptr_t length);
+  void Change(intptr_t cid, bool pretenured);
+
+  Heap* heap_;
+
+  // Indexed by class id. Only resized with mutators stopped.
+  MallocGrowableArray<Feedback> feedback_;
+
+  Mutex pending_mutex_;
+  MallocGrowableArray<intptr_t> pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(Pretenuring);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HEAP_PRETENURING_H_
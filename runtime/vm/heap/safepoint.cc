@@ -5,12 +5,35 @@
 #include "vm/heap/safepoint.h"
 
 #include "vm/heap/heap.h"
+#include "vm/profiler.h"
+#include "vm/stack_frame.h"
 #include "vm/thread.h"
 #include "vm/thread_registry.h"
 
 namespace dart {
 
 DEFINE_FLAG(bool, trace_safepoint, false, "Trace Safepoint logic.");
+DEFINE_FLAG(int,
+            safepoint_latency_threshold,
+            0,
+            "When non-zero, report threads that take longer than this many "
+            "microseconds to reach a requested safepoint, with the Dart frame "
+            "they were in.");
+
+// Records a profiler sample of |T| if it waited since |start| for longer than
+// --profile_wait_threshold.
+static void SampleWaitSince(Thread* T, int64_t start) {
+#if !defined(PRODUCT)
+  const int64_t wait_micros = OS::GetCurrentMonotonicMicros() - start;
+  if (wait_micros > FLAG_profile_wait_threshold) {
+    Profiler::SampleWait(T, wait_micros);
+  }
+#endif  // !defined(PRODUCT)
+}
+
+void TransitionSafepointState::SampleWaitSlow(int64_t start) {
+  SampleWaitSince(thread(), start);
+}
 
 SafepointOperationScope::SafepointOperationScope(Thread* T,
                                                  SafepointLevel level)
@@ -79,6 +102,7 @@ void SafepointHandler::SafepointThreads(Thread* T, SafepointLevel level) {
   ASSERT(T->execution_state() == Thread::kThreadInVM);
   ASSERT(T->current_safepoint_level() >= level);
 
+  const int64_t start = OS::GetCurrentMonotonicMicros();
   {
     MonitorLocker tl(threads_lock());
 
@@ -116,6 +140,12 @@ void SafepointHandler::SafepointThreads(Thread* T, SafepointLevel level) {
   handlers_[level]->WaitUntilThreadsReachedSafepointLevel();
 
   AcquireLowerLevelSafepoints(T, level);
+
+  Heap* heap = isolate_group()->heap();
+  if (heap != nullptr) {
+    heap->pause_histogram(GCPauseKind::kSafepoint)
+        ->Record(OS::GetCurrentMonotonicMicros() - start);
+  }
 }
 
 void SafepointHandler::AssertWeOwnLowerLevelSafepoints(Thread* T,
@@ -136,6 +166,7 @@ void SafepointHandler::AssertWeDoNotOwnLowerLevelSafepoints(
 void SafepointHandler::LevelHandler::NotifyThreadsToGetToSafepointLevel(
     Thread* T) {
   ASSERT(num_threads_not_parked_ == 0);
+  requested_micros_ = OS::GetCurrentMonotonicMicros();
   for (auto current = isolate_group()->thread_registry()->active_list();
        current != nullptr; current = current->next()) {
     MonitorLocker tl(current->thread_lock());
@@ -235,8 +266,15 @@ void SafepointHandler::LevelHandler::NotifyThreadsToContinue(Thread* T) {
 }
 
 void SafepointHandler::EnterSafepointUsingLock(Thread* T) {
-  MonitorLocker tl(T->thread_lock());
-  EnterSafepointLocked(T, &tl);
+  int64_t latency = 0;
+  {
+    MonitorLocker tl(T->thread_lock());
+    latency = TimeToSafepointLocked(T);
+    EnterSafepointLocked(T, &tl);
+  }
+  if (latency > FLAG_safepoint_latency_threshold) {
+    ReportSlowSafepoint(T, latency);
+  }
 }
 
 void SafepointHandler::ExitSafepointUsingLock(Thread* T) {
@@ -248,13 +286,60 @@ void SafepointHandler::ExitSafepointUsingLock(Thread* T) {
 
 void SafepointHandler::BlockForSafepoint(Thread* T) {
   ASSERT(!T->BypassSafepoints());
-  MonitorLocker tl(T->thread_lock());
-  // This takes into account the safepoint level the thread can participate in.
-  if (T->IsSafepointRequestedLocked()) {
-    EnterSafepointLocked(T, &tl);
-    ExitSafepointLocked(T, &tl);
-    ASSERT(!T->IsSafepointRequestedLocked());
+  int64_t latency = 0;
+  int64_t wait_start = 0;
+  {
+    MonitorLocker tl(T->thread_lock());
+    // This takes into account the safepoint level the thread can participate
+    // in.
+    if (T->IsSafepointRequestedLocked()) {
+      latency = TimeToSafepointLocked(T);
+      if (FLAG_profile_wait_threshold > 0) {
+        wait_start = OS::GetCurrentMonotonicMicros();
+      }
+      EnterSafepointLocked(T, &tl);
+      ExitSafepointLocked(T, &tl);
+      ASSERT(!T->IsSafepointRequestedLocked());
+    }
+  }
+  // Report once the thread is running again, so the stack walk is not part
+  // of the safepoint operation that was waiting for it.
+  if (latency > FLAG_safepoint_latency_threshold) {
+    ReportSlowSafepoint(T, latency);
+  }
+  // Threads leaving native code or a blocked state are sampled by their
+  // transition scope, which includes this wait.
+  if (wait_start != 0 && T->execution_state() != Thread::kThreadInNative &&
+      T->execution_state() != Thread::kThreadInBlockedState) {
+    SampleWaitSince(T, wait_start);
+  }
+}
+
+int64_t SafepointHandler::TimeToSafepointLocked(Thread* T) {
+  if (FLAG_safepoint_latency_threshold <= 0) {
+    return 0;
+  }
+  int64_t latency = 0;
+  const int64_t now = OS::GetCurrentMonotonicMicros();
+  for (intptr_t level = T->current_safepoint_level(); level >= 0; --level) {
+    if (T->IsSafepointLevelRequestedLocked(
+            static_cast<SafepointLevel>(level))) {
+      latency =
+          Utils::Maximum(latency, now - handlers_[level]->requested_micros_);
+    }
+  }
+  return latency;
+}
+
+void SafepointHandler::ReportSlowSafepoint(Thread* T, int64_t latency_micros) {
+  const char* location = "native code";
+  if (T->execution_state() == Thread::kThreadInVM && T->zone() != nullptr) {
+    DartFrameIterator frames(T, StackFrameIterator::kNoCrossThreadIteration);
+    StackFrame* frame = frames.NextFrame();
+    location = frame != nullptr ? frame->ToCString() : "the VM";
   }
+  OS::PrintErr("Thread %s took %" Pd64 "us to reach a safepoint, in %s\n",
+               T->os_thread()->name(), latency_micros, location);
 }
 
 void SafepointHandler::EnterSafepointLocked(Thread* T, MonitorLocker* tl) {
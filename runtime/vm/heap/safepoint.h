@@ -13,6 +13,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, profile_wait_threshold);
+
 // A stack based scope that can be used to perform an operation after getting
 // all threads to a safepoint. At the end of the operation all the threads are
 // resumed.
@@ -152,6 +154,10 @@ class SafepointHandler {
     // Count the number of threads the currently in-progress safepoint operation
     // is waiting for to check-in.
     int32_t num_threads_not_parked_ = 0;
+
+    // When the currently in-progress safepoint operation asked threads to
+    // check-in.
+    int64_t requested_micros_ = 0;
   };
 
   void SafepointThreads(Thread* T, SafepointLevel level);
@@ -168,6 +174,11 @@ class SafepointHandler {
   void EnterSafepointLocked(Thread* T, MonitorLocker* tl);
   void ExitSafepointLocked(Thread* T, MonitorLocker* tl);
 
+  // Time since the oldest safepoint operation [T] is being asked to check in
+  // for was requested, or 0 if latency is not being traced.
+  int64_t TimeToSafepointLocked(Thread* T);
+  void ReportSlowSafepoint(Thread* T, int64_t latency_micros);
+
   IsolateGroup* isolate_group() const { return isolate_group_; }
   Monitor* threads_lock() const { return isolate_group_->threads_lock(); }
 
@@ -235,7 +246,25 @@ class TransitionSafepointState : public ThreadStackResource {
     return thread()->isolate()->safepoint_handler();
   }
 
+ protected:
+  // Returns the start of a wait, or 0 if waits are not sampled, see
+  // --profile_wait_threshold.
+  static int64_t WaitStart() {
+    return FLAG_profile_wait_threshold > 0 ? OS::GetCurrentMonotonicMicros()
+                                           : 0;
+  }
+
+  // Records a profiler sample if the wait that started at |start| took
+  // longer than --profile_wait_threshold.
+  void SampleWait(int64_t start) {
+    if (start != 0) {
+      SampleWaitSlow(start);
+    }
+  }
+
  private:
+  void SampleWaitSlow(int64_t start);
+
   DISALLOW_COPY_AND_ASSIGN(TransitionSafepointState);
 };
 
@@ -279,6 +308,7 @@ class TransitionGeneratedToNative : public TransitionSafepointState {
     ASSERT(T->execution_state() == Thread::kThreadInGenerated);
     T->set_execution_state(Thread::kThreadInNative);
     T->EnterSafepoint();
+    wait_start_ = WaitStart();
   }
 
   ~TransitionGeneratedToNative() {
@@ -286,10 +316,13 @@ class TransitionGeneratedToNative : public TransitionSafepointState {
     // anymore.
     ASSERT(thread()->execution_state() == Thread::kThreadInNative);
     thread()->ExitSafepoint();
+    SampleWait(wait_start_);
     thread()->set_execution_state(Thread::kThreadInGenerated);
   }
 
  private:
+  int64_t wait_start_;
+
   DISALLOW_COPY_AND_ASSIGN(TransitionGeneratedToNative);
 };
 
@@ -305,6 +338,7 @@ class TransitionVMToBlocked : public TransitionSafepointState {
     ASSERT(T->execution_state() == Thread::kThreadInVM);
     T->set_execution_state(Thread::kThreadInBlockedState);
     T->EnterSafepoint();
+    wait_start_ = WaitStart();
   }
 
   ~TransitionVMToBlocked() {
@@ -312,9 +346,12 @@ class TransitionVMToBlocked : public TransitionSafepointState {
     ASSERT(thread()->execution_state() == Thread::kThreadInBlockedState);
     thread()->ExitSafepoint();
     thread()->set_execution_state(Thread::kThreadInVM);
+    SampleWait(wait_start_);
   }
 
  private:
+  int64_t wait_start_;
+
   DISALLOW_COPY_AND_ASSIGN(TransitionVMToBlocked);
 };
 
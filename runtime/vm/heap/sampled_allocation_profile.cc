@@ -0,0 +1,226 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(PRODUCT)
+
+#include "vm/heap/sampled_allocation_profile.h"
+
+#include "platform/utils.h"
+#include "vm/flags.h"
+#include "vm/hash.h"
+#include "vm/heap/sampler.h"
+#include "vm/isolate.h"
+#include "vm/json_stream.h"
+#include "vm/lockers.h"
+#include "vm/object.h"
+#include "vm/profiler.h"
+#include "vm/stack_frame.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            sampled_allocation_profile,
+            false,
+            "Sample allocations from startup and aggregate them by class and "
+            "stack for _getSampledAllocationProfile.");
+
+std::atomic<bool> SampledAllocationProfile::in_use_ = {false};
+
+void SampledAllocationProfile::Bucket::ComputeHash() {
+  uint32_t result = static_cast<uint32_t>(cid);
+  for (intptr_t i = 0; i < frame_count; i++) {
+    result = CombineHashes(result, static_cast<uint32_t>(frames[i]));
+  }
+  hash = FinalizeHash(result);
+}
+
+bool SampledAllocationProfile::Bucket::Equals(const Bucket& other) const {
+  if (cid != other.cid || frame_count != other.frame_count) {
+    return false;
+  }
+  for (intptr_t i = 0; i < frame_count; i++) {
+    if (frames[i] != other.frames[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+SampledAllocationProfile::~SampledAllocationProfile() {
+  // The heap is destroyed first and releases every outstanding sample, so no
+  // weak table entry refers to these buckets anymore.
+  for (intptr_t i = 0; i < bucket_list_.length(); i++) {
+    delete bucket_list_[i];
+  }
+}
+
+void SampledAllocationProfile::Init() {
+  if (FLAG_sampled_allocation_profile) {
+    Enable(true);
+  }
+}
+
+bool SampledAllocationProfile::Enable(bool enabled) {
+  if (HeapProfileSampler::has_embedder_callbacks()) {
+    return false;
+  }
+  HeapProfileSampler::Enable(enabled);
+  return true;
+}
+
+void* SampledAllocationProfile::Add(Thread* thread,
+                                    intptr_t cid,
+                                    intptr_t bytes) {
+  Bucket key;
+  key.cid = cid;
+  key.frame_count = 0;
+  DartFrameIterator iterator(thread,
+                             StackFrameIterator::kNoCrossThreadIteration);
+  for (StackFrame* frame = iterator.NextFrame();
+       frame != nullptr && key.frame_count < kMaxFrames;
+       frame = iterator.NextFrame()) {
+    key.frames[key.frame_count++] = frame->pc();
+  }
+  key.ComputeHash();
+
+  Bucket* bucket;
+  {
+    MutexLocker ml(&mutex_);
+    auto pair = buckets_.Lookup(&key);
+    if (pair == nullptr && bucket_list_.length() >= kMaxBuckets) {
+      key.frame_count = 0;
+      key.ComputeHash();
+      pair = buckets_.Lookup(&key);
+    }
+    if (pair != nullptr) {
+      bucket = *pair;
+    } else {
+      bucket = new Bucket();
+      bucket->cid = key.cid;
+      bucket->frame_count = key.frame_count;
+      for (intptr_t i = 0; i < key.frame_count; i++) {
+        bucket->frames[i] = key.frames[i];
+      }
+      bucket->hash = key.hash;
+      bucket->samples = 0;
+      bucket->bytes = 0;
+      buckets_.Insert(bucket);
+      bucket_list_.Add(bucket);
+    }
+    bucket->samples++;
+    bucket->bytes += bytes;
+  }
+  bucket->live_samples.fetch_add(1);
+  bucket->live_bytes.fetch_add(bytes);
+  in_use_.store(true, std::memory_order_relaxed);
+
+  Sample* sample = new Sample();
+  sample->bucket = bucket;
+  sample->bytes = bytes;
+  return sample;
+}
+
+void SampledAllocationProfile::Release(void* data) {
+  Sample* sample = reinterpret_cast<Sample*>(data);
+  if (sample == nullptr) {
+    return;
+  }
+  sample->bucket->live_samples.fetch_sub(1);
+  sample->bucket->live_bytes.fetch_sub(sample->bytes);
+  delete sample;
+}
+
+void SampledAllocationProfile::ResetTotals() {
+  MutexLocker ml(&mutex_);
+  for (intptr_t i = 0; i < bucket_list_.length(); i++) {
+    bucket_list_[i]->samples = 0;
+    bucket_list_[i]->bytes = 0;
+  }
+}
+
+namespace {
+
+struct BucketSnapshot {
+  intptr_t cid;
+  intptr_t frame_count;
+  const uword* frames;
+  intptr_t samples;
+  intptr_t bytes;
+  intptr_t live_samples;
+  intptr_t live_bytes;
+};
+
+int CompareByBytes(const BucketSnapshot* a, const BucketSnapshot* b) {
+  if (a->bytes != b->bytes) {
+    return a->bytes > b->bytes ? -1 : 1;
+  }
+  if (a->live_bytes != b->live_bytes) {
+    return a->live_bytes > b->live_bytes ? -1 : 1;
+  }
+  return 0;
+}
+
+}  // namespace
+
+void SampledAllocationProfile::PrintJSON(Thread* thread, JSONStream* js) {
+  Zone* zone = thread->zone();
+
+  // Copy the counts before symbolizing. Building the code table can reach a
+  // safepoint, and a mutator recording a sample holds mutex_ without being
+  // able to take part in one.
+  GrowableArray<BucketSnapshot> snapshot;
+  {
+    MutexLocker ml(&mutex_);
+    for (intptr_t i = 0; i < bucket_list_.length(); i++) {
+      const Bucket* bucket = bucket_list_[i];
+      const intptr_t live_samples = bucket->live_samples.load();
+      if (bucket->samples == 0 && live_samples == 0) {
+        continue;
+      }
+      uword* frames = zone->Alloc<uword>(bucket->frame_count);
+      for (intptr_t j = 0; j < bucket->frame_count; j++) {
+        frames[j] = bucket->frames[j];
+      }
+      snapshot.Add({bucket->cid, bucket->frame_count, frames, bucket->samples,
+                    bucket->bytes, live_samples, bucket->live_bytes.load()});
+    }
+  }
+  snapshot.Sort(CompareByBytes);
+
+  CodeLookupTable* code_table = new CodeLookupTable(thread);
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  Class& cls = Class::Handle(zone);
+
+  JSONObject obj(js);
+  obj.AddProperty("type", "_SampledAllocationProfile");
+  obj.AddProperty("enabled", HeapProfileSampler::enabled());
+  obj.AddProperty64("samplingInterval",
+                    HeapProfileSampler::sampling_interval());
+  JSONArray members(&obj, "members");
+  for (intptr_t i = 0; i < snapshot.length(); i++) {
+    const BucketSnapshot& entry = snapshot[i];
+    JSONObject member(&members);
+    if (class_table->IsValidIndex(entry.cid) &&
+        class_table->HasValidClassAt(entry.cid)) {
+      cls = class_table->At(entry.cid);
+      member.AddProperty("class", cls);
+    }
+    member.AddProperty64("samples", entry.samples);
+    member.AddProperty64("bytes", entry.bytes);
+    member.AddProperty64("liveSamples", entry.live_samples);
+    member.AddProperty64("liveBytes", entry.live_bytes);
+    JSONArray stack(&member, "stack");
+    for (intptr_t j = 0; j < entry.frame_count; j++) {
+      // Frames hold return addresses, which may be just past the end of the
+      // calling code.
+      const CodeDescriptor* code = code_table->FindCode(entry.frames[j] - 1);
+      stack.AddValue(code != nullptr ? code->Name() : "<unknown>");
+    }
+  }
+}
+
+}  // namespace dart
+
+#endif  // !defined(PRODUCT)
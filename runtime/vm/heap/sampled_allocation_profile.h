@@ -0,0 +1,105 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_SAMPLED_ALLOCATION_PROFILE_H_
+#define RUNTIME_VM_HEAP_SAMPLED_ALLOCATION_PROFILE_H_
+
+#if !defined(PRODUCT)
+
+#include <atomic>
+
+#include "platform/atomic.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+class JSONStream;
+class Thread;
+
+// The VM's own consumer of HeapProfileSampler samples, used when the embedder
+// has not registered heap sampling callbacks.
+//
+// Samples are aggregated by allocated class and Dart stack. Each sampled
+// object keeps a pointer to its bucket in the heap's sampling weak table, so
+// the GC tells us when it dies and the profile can report live bytes next to
+// the total bytes allocated. Stacks are stored as return addresses and only
+// symbolized when the profile is printed, which keeps the cost of a sample
+// low enough to use in AOT.
+class SampledAllocationProfile {
+ public:
+  static constexpr intptr_t kMaxFrames = 16;
+  // Once this many distinct (class, stack) pairs have been seen, new stacks
+  // are folded into a bucket with an empty stack for their class.
+  static constexpr intptr_t kMaxBuckets = 4096;
+
+  SampledAllocationProfile() {}
+  ~SampledAllocationProfile();
+
+  // Enables the profile at startup when --sampled_allocation_profile is set.
+  static void Init();
+
+  // Starts or stops heap sampling for the whole VM. Fails if the embedder has
+  // registered its own heap sampling callbacks.
+  static bool Enable(bool enabled);
+
+  // Records a sample of an object of class [cid] allocated by [thread], which
+  // stands for [bytes] allocated bytes. Returns the value to store in the
+  // heap's sampling weak table for the object.
+  void* Add(Thread* thread, intptr_t cid, intptr_t bytes);
+
+  // Called by the GC when an object recorded by Add is collected.
+  static void Release(void* data);
+
+  // True once any isolate group has recorded a sample.
+  static bool in_use() { return in_use_.load(std::memory_order_relaxed); }
+
+  // Clears the allocation totals. Live counts are kept, since the objects
+  // they describe are still in the heap.
+  void ResetTotals();
+
+  void PrintJSON(Thread* thread, JSONStream* js);
+
+ private:
+  struct Bucket {
+    intptr_t cid;
+    intptr_t frame_count;
+    uword frames[kMaxFrames];
+    uword hash;
+
+    // Guarded by mutex_.
+    intptr_t samples;
+    intptr_t bytes;
+
+    // Decremented by GC workers in parallel.
+    RelaxedAtomic<intptr_t> live_samples;
+    RelaxedAtomic<intptr_t> live_bytes;
+
+    void ComputeHash();
+    uword Hash() const { return hash; }
+    bool Equals(const Bucket& other) const;
+  };
+
+  // The weak table value of a sample. Owned by the sampled object.
+  struct Sample {
+    Bucket* bucket;
+    intptr_t bytes;
+  };
+
+  Mutex mutex_;
+  MallocDirectChainedHashMap<PointerSetKeyValueTrait<Bucket>> buckets_;
+  MallocGrowableArray<Bucket*> bucket_list_;
+
+  static std::atomic<bool> in_use_;
+
+  DISALLOW_COPY_AND_ASSIGN(SampledAllocationProfile);
+};
+
+}  // namespace dart
+
+#endif  // !defined(PRODUCT)
+#endif  // RUNTIME_VM_HEAP_SAMPLED_ALLOCATION_PROFILE_H_
@@ -8,6 +8,7 @@
 #include <algorithm>
 
 #include "vm/heap/safepoint.h"
+#include "vm/heap/sampled_allocation_profile.h"
 #include "vm/heap/sampler.h"
 #include "vm/isolate.h"
 #include "vm/lockers.h"
@@ -87,10 +88,26 @@ void HeapProfileSampler::SetSamplingCallback(
       (delete_callback_ != nullptr && delete_callback == nullptr)) {
     FATAL("Clearing sampling callbacks is prohibited.");
   }
+#if !defined(PRODUCT)
+  if (create_callback_ == nullptr && SampledAllocationProfile::in_use()) {
+    FATAL(
+        "Sampling callbacks cannot be registered after the VM's sampled "
+        "allocation profile has been used.");
+  }
+#endif
   create_callback_ = create_callback;
   delete_callback_ = delete_callback;
 }
 
+Dart_HeapSamplingDeleteCallback HeapProfileSampler::delete_callback() {
+#if !defined(PRODUCT)
+  if (delete_callback_ == nullptr) {
+    return SampledAllocationProfile::Release;
+  }
+#endif
+  return delete_callback_;
+}
+
 void HeapProfileSampler::ResetState() {
   thread_->set_end(thread_->true_end());
   next_tlab_offset_ = kUninitialized;
@@ -197,14 +214,21 @@ void HeapProfileSampler::HandleNewTLAB(intptr_t old_tlab_remaining_space,
   }
 }
 
-void* HeapProfileSampler::InvokeCallbackForLastSample() {
+void* HeapProfileSampler::InvokeCallbackForLastSample(intptr_t cid) {
   ASSERT(enabled_);
-  ASSERT(create_callback_ != nullptr);
   ReadRwLocker locker(thread_, lock_);
-  void* result = create_callback_(
-      reinterpret_cast<Dart_Isolate>(thread_->isolate()),
-      reinterpret_cast<Dart_IsolateGroup>(thread_->isolate_group()),
-      last_sample_size_);
+  void* result = nullptr;
+  if (create_callback_ != nullptr) {
+    result = create_callback_(
+        reinterpret_cast<Dart_Isolate>(thread_->isolate()),
+        reinterpret_cast<Dart_IsolateGroup>(thread_->isolate_group()),
+        last_sample_size_);
+  } else {
+#if !defined(PRODUCT)
+    result = thread_->isolate_group()->sampled_allocation_profile()->Add(
+        thread_, cid, last_sample_size_);
+#endif
+  }
   last_sample_size_ = kUninitialized;
   return result;
 }
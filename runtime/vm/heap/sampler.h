@@ -50,9 +50,15 @@ class HeapProfileSampler {
       Dart_HeapSamplingCreateCallback create_callback,
       Dart_HeapSamplingDeleteCallback delete_callback);
 
-  static Dart_HeapSamplingDeleteCallback delete_callback() {
-    return delete_callback_;
-  }
+  // Returns the callback the GC invokes for the data of a collected sample.
+  //
+  // Without embedder callbacks, samples are recorded by the VM's own
+  // SampledAllocationProfile.
+  static Dart_HeapSamplingDeleteCallback delete_callback();
+
+  static bool has_embedder_callbacks() { return create_callback_ != nullptr; }
+
+  static intptr_t sampling_interval() { return sampling_interval_; }
 
   void Initialize();
   void Cleanup() {
@@ -118,7 +124,9 @@ class HeapProfileSampler {
   // allocations.
   void HandleNewTLAB(intptr_t old_tlab_remaining_space, bool is_first_tlab);
 
-  void* InvokeCallbackForLastSample();
+  // Reports the last sample, an object of class [cid], to the registered
+  // create callback and returns the data to associate with the object.
+  void* InvokeCallbackForLastSample(intptr_t cid);
 
   bool HasOutstandingSample() const {
     return last_sample_size_ != kUninitialized;
@@ -16,6 +16,7 @@
 #include "vm/heap/gc_shared.h"
 #include "vm/heap/pages.h"
 #include "vm/heap/pointer_block.h"
+#include "vm/heap/pretenuring.h"
 #include "vm/heap/safepoint.h"
 #include "vm/heap/verifier.h"
 #include "vm/heap/weak_table.h"
@@ -46,6 +47,29 @@ DEFINE_FLAG(int,
             90,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
+DEFINE_FLAG(int,
+            new_gen_pause_goal,
+            0,
+            "When non-zero, size new gen from the observed scavenge pause time "
+            "and promotion rate to keep scavenges under this many "
+            "milliseconds.");
+DEFINE_FLAG(bool,
+            adaptive_scavenger_tasks,
+            true,
+            "Use fewer than --scavenger_tasks tasks when few objects are "
+            "expected to survive or the thread pool has no idle workers.");
+DEFINE_FLAG(bool,
+            log_scavenger_tasks,
+            false,
+            "Log the work done by each parallel scavenger task.");
+DEFINE_FLAG(bool,
+            scavenger_depth_first,
+            false,
+            "Scavenge serially, copying survivors in depth-first order so that "
+            "objects end up next to the objects they reference.");
+
+// Each parallel scavenger task should expect at least this much to copy.
+static constexpr intptr_t kLiveWordsPerScavengerTask = 2 * MBInWords;
 
 // Scavenger uses the kCardRememberedBit to distinguish forwarded and
 // non-forwarded objects. We must choose a bit that is clear for all new-space
@@ -142,7 +166,8 @@ class ScavengerVisitorBase : public ObjectPointerVisitor {
         freelist_(freelist),
         bytes_promoted_(0),
         visiting_old_object_(nullptr),
-        promoted_list_(promotion_stack) {}
+        promoted_list_(promotion_stack),
+        depth_first_(!parallel && FLAG_scavenger_depth_first) {}
   ~ScavengerVisitorBase() { ASSERT(delayed_.IsEmpty()); }
 
 #ifdef DEBUG
@@ -483,6 +508,8 @@ class ScavengerVisitorBase : public ObjectPointerVisitor {
         }
         // Use the winner's forwarding target.
         new_obj = ForwardedObj(header);
+      } else if (depth_first_ && new_obj->IsNewObject()) {
+        copied_stack_.Add(new_obj);
       }
     }
 
@@ -559,6 +586,11 @@ class ScavengerVisitorBase : public ObjectPointerVisitor {
   Page* tail_ = nullptr;  // Allocating from here.
   Page* scan_ = nullptr;  // Resolving from here.
 
+  // When copying depth-first, to-space copies are processed from this stack
+  // instead of by scanning to-space in allocation order.
+  const bool depth_first_;
+  MallocGrowableArray<ObjectPtr> copied_stack_;
+
   template <typename GCVisitorType>
   friend void MournFinalized(GCVisitorType* visitor);
 
@@ -591,7 +623,7 @@ class ScavengerWeakVisitor : public HandleVisitor {
         reinterpret_cast<FinalizablePersistentHandle*>(addr);
     ObjectPtr* p = handle->ptr_addr();
     if (IsUnreachable(p)) {
-      handle->UpdateUnreachable(thread()->isolate_group());
+      handle->UpdateUnreachable(thread()->isolate_group(), /*defer=*/true);
     } else {
       handle->UpdateRelocated(thread()->isolate_group());
     }
@@ -612,6 +644,11 @@ class ParallelScavengerTask : public ThreadPool::Task {
         visitor_(visitor),
         num_busy_(num_busy) {}
 
+  virtual Dart_TaskPriority priority(
+      Dart_TaskPriority pool_default) const {
+    return Dart_TaskPriority_High;
+  }
+
   virtual void Run() {
     if (!barrier_->TryEnter()) {
       barrier_->Release();
@@ -761,6 +798,7 @@ Scavenger::Scavenger(Heap* heap, intptr_t max_semi_capacity_in_words)
       collections_(0),
       scavenge_words_per_micro_(kConservativeInitialScavengeSpeed),
       idle_scavenge_threshold_in_words_(0),
+      pause_goal_micros_(FLAG_new_gen_pause_goal * kMicrosecondsPerMillisecond),
       external_size_(0),
       failed_to_promote_(false),
       abort_(false) {
@@ -794,6 +832,11 @@ intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
     grow = true;
   }
 
+  if ((pause_goal_micros_ > 0) && !grow && (reason == GCReason::kNewSpace) &&
+      (stats_history_.Size() != 0)) {
+    return NewSizeForPauseGoalInWords(old_size_in_words);
+  }
+
   if (reason == GCReason::kNewSpace) {
     // If we GC for a reason other than new-space being full (i.e., full
     // collection for old-space or store-buffer overflow), that's not an
@@ -816,6 +859,34 @@ intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
   return old_size_in_words;
 }
 
+intptr_t Scavenger::NewSizeForPauseGoalInWords(
+    intptr_t old_size_in_words) const {
+  const ScavengeStats& last = stats_history_.Get(0);
+  const int64_t pause = last.DurationMicros();
+  const intptr_t min_size_in_words = Utils::Minimum(
+      max_semi_capacity_in_words_, FLAG_new_gen_semi_initial_size * MBInWords);
+
+  if (pause > pause_goal_micros_) {
+    // Scavenge time is dominated by the survivors, and a smaller new-space
+    // gives fewer objects the chance to survive.
+    return Utils::Maximum(min_size_in_words,
+                          old_size_in_words / FLAG_new_gen_growth_factor);
+  }
+
+  // Growing only pays off when most survivors go on to die in new-space:
+  // when a large share of promotion candidates is promoted anyway, a bigger
+  // new-space just copies them for longer. Leave room for the pause to grow
+  // in proportion to the new size before committing to growth.
+  const bool mostly_short_lived = last.PromoCandidatesSuccessFraction() <
+                                  (FLAG_early_tenuring_threshold / 100.0);
+  if (mostly_short_lived &&
+      (pause * FLAG_new_gen_growth_factor <= pause_goal_micros_)) {
+    return Utils::Minimum(max_semi_capacity_in_words_,
+                          old_size_in_words * FLAG_new_gen_growth_factor);
+  }
+  return old_size_in_words;
+}
+
 class CollectStoreBufferVisitor : public ObjectPointerVisitor {
  public:
   explicit CollectStoreBufferVisitor(ObjectSet* in_store_buffer)
@@ -1218,6 +1289,24 @@ void Scavenger::MournWeakHandles() {
 
 template <bool parallel>
 void ScavengerVisitorBase<parallel>::ProcessToSpace() {
+  if (depth_first_) {
+    // Processing the most recent copy first keeps each object's descendants
+    // together, instead of grouping all objects of the same depth as a scan
+    // of to-space in allocation order does.
+    while (!copied_stack_.is_empty()) {
+      ProcessCopied(copied_stack_.RemoveLast());
+    }
+    // Everything copied so far has been processed.
+    while (scan_ != nullptr) {
+      scan_->resolved_top_ = scan_->top_;
+      Page* next = scan_->next();
+      if (next == nullptr) {
+        return;
+      }
+      scan_ = next;
+    }
+    return;
+  }
   while (scan_ != nullptr) {
     uword resolved_top = scan_->resolved_top_;
     while (resolved_top < scan_->top_) {
@@ -1257,6 +1346,9 @@ void ScavengerVisitorBase<parallel>::ProcessPromotedList() {
       // forwarded contents of this object.
       thread_->MarkingStackAddObject(raw_object);
     }
+    if (parallel) {
+      promoted_list_.FlushOutputIfStarving();
+    }
   }
   VisitingOldObject(nullptr);
 }
@@ -1413,6 +1505,33 @@ void ScavengerVisitorBase<parallel>::ProcessOldFinalizerEntry(
   }
 }
 
+void Scavenger::RecordPretenuringFeedback(SemiSpace* from) {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "PretenuringFeedback");
+  Pretenuring* pretenuring = heap_->pretenuring();
+  for (Page* page = from->head(); page != nullptr; page = page->next()) {
+    // Objects below the survivor end were already sampled when they survived
+    // their first scavenge.
+    const uword end = page->object_end();
+    uword addr = Utils::Minimum(page->survivor_end(), end);
+    while (addr < end) {
+      const uword header = *reinterpret_cast<uword*>(addr);
+      ObjectPtr obj;
+      bool survived;
+      if (IsForwarding(header)) {
+        obj = ForwardedObj(header);
+        survived = true;
+      } else {
+        obj = UntaggedObject::FromAddr(addr);
+        survived = false;
+      }
+      const intptr_t size = obj->untag()->HeapSize();
+      pretenuring->RecordNewSpaceObject(obj->GetClassId(), size, survived);
+      addr += size;
+    }
+  }
+  pretenuring->UpdateAfterScavenge(Thread::Current());
+}
+
 void Scavenger::MournWeakTables() {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "MournWeakTables");
 
@@ -1592,6 +1711,12 @@ void Scavenger::VisitObjects(ObjectVisitor* visitor) const {
   }
 }
 
+void Scavenger::AddPagesTo(MallocGrowableArray<Page*>* pages) const {
+  for (Page* page = to_->head(); page != nullptr; page = page->next()) {
+    pages->Add(page);
+  }
+}
+
 void Scavenger::AddRegionsToObjectSet(ObjectSet* set) const {
   for (Page* page = to_->head(); page != nullptr; page = page->next()) {
     set->AddRegion(page->start(), page->end());
@@ -1749,10 +1874,12 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   SemiSpace* from = Prologue(reason);
 
   intptr_t bytes_promoted;
-  if (FLAG_scavenger_tasks == 0) {
+  const intptr_t num_tasks = NumScavengerTasks(usage_before.used_in_words);
+  intptr_t max_task_work_in_words = 0;
+  if (num_tasks <= 1) {
     bytes_promoted = SerialScavenge(from);
   } else {
-    bytes_promoted = ParallelScavenge(from);
+    bytes_promoted = ParallelScavenge(from, num_tasks, &max_task_work_in_words);
   }
   if (abort_) {
     ReverseScavenge(&from);
@@ -1779,6 +1906,9 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   ASSERT(promotion_stack_.IsEmpty());
   MournWeakHandles();
   MournWeakTables();
+  if (!abort_ && Pretenuring::IsEnabled()) {
+    RecordPretenuringFeedback(from);
+  }
   heap_->old_space()->ResetProgressBars();
 
   // Restore write-barrier assumptions.
@@ -1788,7 +1918,9 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   int64_t end = OS::GetCurrentMonotonicMicros();
   stats_history_.Add(ScavengeStats(
       start, end, usage_before, GetCurrentUsage(), promo_candidate_words,
-      bytes_promoted >> kWordSizeLog2, abandoned_bytes >> kWordSizeLog2));
+      bytes_promoted >> kWordSizeLog2, abandoned_bytes >> kWordSizeLog2,
+      Utils::Maximum(num_tasks, static_cast<intptr_t>(1)),
+      max_task_work_in_words));
   Epilogue(from);
 
   if (FLAG_verify_after_gc) {
@@ -1824,10 +1956,35 @@ intptr_t Scavenger::SerialScavenge(SemiSpace* from) {
   return visitor.bytes_promoted();
 }
 
-intptr_t Scavenger::ParallelScavenge(SemiSpace* from) {
+intptr_t Scavenger::NumScavengerTasks(intptr_t used_in_words) const {
+  if (FLAG_scavenger_depth_first) {
+    return 1;
+  }
+  const intptr_t max_tasks = FLAG_scavenger_tasks;
+  if (!FLAG_adaptive_scavenger_tasks || (max_tasks <= 1)) {
+    return max_tasks;
+  }
+  // Expect as much of new space to survive as did last time.
+  double survival = 1.0;
+  if (stats_history_.Size() != 0) {
+    survival = stats_history_.Get(0).SurvivalFraction();
+  }
+  const intptr_t live_in_words =
+      static_cast<intptr_t>(used_in_words * survival);
+  intptr_t num_tasks = 1 + live_in_words / kLiveWordsPerScavengerTask;
+  // Starting threads costs more than it saves on a short scavenge, so use the
+  // idle workers and grow the pool by at most one helper at a time.
+  num_tasks = Utils::Minimum(num_tasks,
+                             Dart::thread_pool()->idle_workers() + 2);
+  return Utils::Minimum(num_tasks, max_tasks);
+}
+
+intptr_t Scavenger::ParallelScavenge(SemiSpace* from,
+                                     intptr_t num_tasks,
+                                     intptr_t* max_task_work_in_words) {
   intptr_t bytes_promoted = 0;
-  const intptr_t num_tasks = FLAG_scavenger_tasks;
   ASSERT(num_tasks > 0);
+  ASSERT(num_tasks <= FLAG_scavenger_tasks);
 
   ThreadBarrier* barrier = new ThreadBarrier(num_tasks, 1);
   RelaxedAtomic<uintptr_t> num_busy = 0;
@@ -1860,6 +2017,17 @@ intptr_t Scavenger::ParallelScavenge(SemiSpace* from) {
     } else {
       visitor->FinalizePromotion();
     }
+    intptr_t work_in_bytes = visitor->bytes_promoted();
+    for (Page* page = visitor->head(); page != nullptr; page = page->next()) {
+      work_in_bytes += page->used();
+    }
+    *max_task_work_in_words = Utils::Maximum(*max_task_work_in_words,
+                                             work_in_bytes >> kWordSizeLog2);
+    if (FLAG_log_scavenger_tasks) {
+      THR_Print("Scavenger task %" Pd " copied %" Pd " bytes (%" Pd
+                " promoted).\n",
+                i, work_in_bytes, visitor->bytes_promoted());
+    }
     to_->AddList(visitor->head(), visitor->tail());
     bytes_promoted += visitor->bytes_promoted();
     delete visitor;
@@ -75,14 +75,18 @@ class ScavengeStats {
                 SpaceUsage after,
                 intptr_t promo_candidates_in_words,
                 intptr_t promoted_in_words,
-                intptr_t abandoned_in_words)
+                intptr_t abandoned_in_words,
+                intptr_t num_tasks,
+                intptr_t max_task_work_in_words)
       : start_micros_(start_micros),
         end_micros_(end_micros),
         before_(before),
         after_(after),
         promo_candidates_in_words_(promo_candidates_in_words),
         promoted_in_words_(promoted_in_words),
-        abandoned_in_words_(abandoned_in_words) {}
+        abandoned_in_words_(abandoned_in_words),
+        num_tasks_(num_tasks),
+        max_task_work_in_words_(max_task_work_in_words) {}
 
   // Of all data before scavenge, what fraction was found to be garbage?
   // If this scavenge included growth, assume the extra capacity would become
@@ -102,10 +106,24 @@ class ScavengeStats {
                : 0.0;
   }
 
+  // Fraction of the data before scavenge that was copied or promoted.
+  double SurvivalFraction() const {
+    if (before_.used_in_words == 0) return 0.0;
+    const double survived = after_.used_in_words + promoted_in_words_;
+    return Utils::Minimum(1.0, survived / before_.used_in_words);
+  }
+
   intptr_t UsedBeforeInWords() const { return before_.used_in_words; }
 
   int64_t DurationMicros() const { return end_micros_ - start_micros_; }
 
+  // Number of tasks that performed this scavenge.
+  intptr_t num_tasks() const { return num_tasks_; }
+
+  // Words copied or promoted by the busiest task; zero for a serial scavenge.
+  // Compare with the total to judge how evenly the work was spread.
+  intptr_t max_task_work_in_words() const { return max_task_work_in_words_; }
+
  private:
   int64_t start_micros_;
   int64_t end_micros_;
@@ -114,6 +132,8 @@ class ScavengeStats {
   intptr_t promo_candidates_in_words_;
   intptr_t promoted_in_words_;
   intptr_t abandoned_in_words_;
+  intptr_t num_tasks_;
+  intptr_t max_task_work_in_words_;
 };
 
 class Scavenger {
@@ -171,6 +191,10 @@ class Scavenger {
   void VisitObjects(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
+  // Adds the pages of to-space to [pages], e.g. to divide them among several
+  // visitors.
+  void AddPagesTo(MallocGrowableArray<Page*>* pages) const;
+
   void AddRegionsToObjectSet(ObjectSet* set) const;
 
   void WriteProtect(bool read_only);
@@ -219,6 +243,11 @@ class Scavenger {
 
   bool scavenging() const { return scavenging_; }
 
+  // When positive, new-space is sized to keep scavenge pauses below this
+  // many microseconds instead of by the fixed survival threshold.
+  int64_t pause_goal_micros() const { return pause_goal_micros_; }
+  void set_pause_goal_micros(int64_t micros) { pause_goal_micros_ = micros; }
+
   // The maximum number of Dart mutator threads we allow to execute at the same
   // time.
   static intptr_t MaxMutatorThreadCount() {
@@ -264,7 +293,12 @@ class Scavenger {
   void TryAllocateNewTLAB(Thread* thread, intptr_t size, bool can_safepoint);
 
   SemiSpace* Prologue(GCReason reason);
-  intptr_t ParallelScavenge(SemiSpace* from);
+  // Picks the number of tasks for the next scavenge from the expected
+  // survivors and the idle thread pool workers, up to --scavenger_tasks.
+  intptr_t NumScavengerTasks(intptr_t used_in_words) const;
+  intptr_t ParallelScavenge(SemiSpace* from,
+                            intptr_t num_tasks,
+                            intptr_t* max_task_work_in_words);
   intptr_t SerialScavenge(SemiSpace* from);
   void ReverseScavenge(SemiSpace** from);
   void IterateIsolateRoots(ObjectPointerVisitor* visitor);
@@ -276,6 +310,7 @@ class Scavenger {
   template <bool parallel>
   void IterateRoots(ScavengerVisitorBase<parallel>* visitor);
   void MournWeakHandles();
+  void RecordPretenuringFeedback(SemiSpace* from);
   void Epilogue(SemiSpace* from);
 
   void VerifyStoreBuffers();
@@ -286,6 +321,7 @@ class Scavenger {
   void MournWeakTables();
 
   intptr_t NewSizeInWords(intptr_t old_size_in_words, GCReason reason) const;
+  intptr_t NewSizeForPauseGoalInWords(intptr_t old_size_in_words) const;
 
   Heap* heap_;
 
@@ -308,6 +344,7 @@ class Scavenger {
 
   intptr_t scavenge_words_per_micro_;
   intptr_t idle_scavenge_threshold_in_words_;
+  RelaxedAtomic<int64_t> pause_goal_micros_;
 
   // The total size of external data associated with objects in this scavenger.
   RelaxedAtomic<intptr_t> external_size_;
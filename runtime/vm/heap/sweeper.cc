@@ -76,6 +76,7 @@ bool GCSweeper::SweepPage(Page* page, FreeList* freelist, bool locked) {
   }
   ASSERT(current == end);
 
+  page->set_live_bytes(used_in_bytes);
   return used_in_bytes != 0;  // In use.
 }
 
@@ -117,6 +118,11 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
     old_space->set_phase(PageSpace::kSweepingLarge);
   }
 
+  virtual Dart_TaskPriority priority(
+      Dart_TaskPriority pool_default) const {
+    return Dart_TaskPriority_Low;
+  }
+
   virtual void Run() {
     bool result = Thread::EnterIsolateGroupAsHelper(
         isolate_group_, Thread::kSweeperTask, /*bypass_safepoint=*/true);
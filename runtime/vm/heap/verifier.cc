@@ -79,6 +79,10 @@ void VerifyPointersVisitor::VisitCompressedPointers(uword heap_base,
 }
 #endif
 
+void VerifyPointersInObjectsVisitor::VisitObject(ObjectPtr obj) {
+  obj->untag()->VisitPointers(&pointer_visitor_);
+}
+
 void VerifyWeakPointersVisitor::VisitHandle(uword addr) {
   FinalizablePersistentHandle* handle =
       reinterpret_cast<FinalizablePersistentHandle*>(addr);
@@ -62,6 +62,22 @@ class VerifyPointersVisitor : public ObjectPointerVisitor {
   DISALLOW_COPY_AND_ASSIGN(VerifyPointersVisitor);
 };
 
+// Verifies the pointers in the objects it visits, so that the objects of the
+// heap can be divided among several verifying tasks.
+class VerifyPointersInObjectsVisitor : public ObjectVisitor {
+ public:
+  VerifyPointersInObjectsVisitor(IsolateGroup* isolate_group,
+                                 ObjectSet* allocated_set)
+      : pointer_visitor_(isolate_group, allocated_set) {}
+
+  void VisitObject(ObjectPtr obj) override;
+
+ private:
+  VerifyPointersVisitor pointer_visitor_;
+
+  DISALLOW_COPY_AND_ASSIGN(VerifyPointersInObjectsVisitor);
+};
+
 class VerifyWeakPointersVisitor : public HandleVisitor {
  public:
   explicit VerifyWeakPointersVisitor(VerifyPointersVisitor* visitor)
@@ -72,6 +72,11 @@ class WeakTable {
     return old_value;
   }
 
+  void ReduceCount(intptr_t removed) {
+    MutexLocker ml(&mutex_);
+    set_count(count() - removed);
+  }
+
   // The following "exclusive" methods must only be called from call sites
   // which are known to have exclusive access to the weak table.
   //
@@ -91,6 +96,15 @@ class WeakTable {
     SetValueAt(i, 0);
   }
 
+  // Like InvalidateAtExclusive, but leaves count() alone so that parallel GC
+  // workers owning disjoint ranges of entries can clear them without racing.
+  // The caller must account for the cleared entries with ReduceCount.
+  void ClearEntryAtExclusive(intptr_t i) {
+    ASSERT(IsValidEntryAtExclusive(i));
+    data_[ObjectIndex(i)] = kDeletedEntry;
+    data_[ValueIndex(i)] = 0;
+  }
+
   ObjectPtr ObjectAtExclusive(intptr_t i) const {
     ASSERT(i >= 0);
     ASSERT(i < size());
@@ -281,6 +281,8 @@ intptr_t ImageWriter::SizeInSnapshot(ObjectPtr raw_object) {
       return compiler::target::String::InstanceSize(
           String::LengthOf(raw_str) * TwoByteString::kBytesPerElement);
     }
+    case kDoubleCid:
+      return compiler::target::Double::InstanceSize();
     default: {
       const Class& clazz = Class::Handle(Object::Handle(raw_object).clazz());
       FATAL("Unsupported class %s in rodata section.\n", clazz.ToCString());
@@ -575,6 +577,11 @@ void ImageWriter::WriteROData(NonStreamingWriteStream* stream, bool vm) {
           str.Length() * (str.IsOneByteString()
                               ? OneByteString::kBytesPerElement
                               : TwoByteString::kBytesPerElement));
+    } else if (obj.IsDouble()) {
+      stream->Align(sizeof(double));
+      ASSERT_EQUAL(stream->Position() - object_start,
+                   compiler::target::Double::value_offset());
+      stream->WriteFixed<double>(Double::Cast(obj).value());
     } else {
       const Class& clazz = Class::Handle(obj.clazz());
       FATAL("Unsupported class %s in rodata section.\n", clazz.ToCString());
@@ -13,6 +13,7 @@
 #include "platform/text_buffer.h"
 #include "vm/class_finalizer.h"
 #include "vm/code_observers.h"
+#include "vm/compilation_log.h"
 #include "vm/compiler/jit/compiler.h"
 #include "vm/dart_api_message.h"
 #include "vm/dart_api_state.h"
@@ -20,10 +21,14 @@
 #include "vm/debugger.h"
 #include "vm/deopt_instructions.h"
 #include "vm/dispatch_table.h"
+#include "vm/ffi/native_assets.h"
+#include "vm/ffi_callback_listener.h"
+#include "vm/ffi_isolate_group_callback.h"
 #include "vm/flags.h"
 #include "vm/heap/heap.h"
 #include "vm/heap/pointer_block.h"
 #include "vm/heap/safepoint.h"
+#include "vm/heap/sampled_allocation_profile.h"
 #include "vm/heap/verifier.h"
 #include "vm/image_snapshot.h"
 #include "vm/isolate_reload.h"
@@ -33,11 +38,13 @@
 #include "vm/message_handler.h"
 #include "vm/message_snapshot.h"
 #include "vm/object.h"
+#include "vm/object_graph.h"
 #include "vm/object_id_ring.h"
 #include "vm/object_store.h"
 #include "vm/os_thread.h"
 #include "vm/port.h"
 #include "vm/profiler.h"
+#include "vm/profiler_service.h"
 #include "vm/reusable_handles.h"
 #include "vm/reverse_pc_lookup_cache.h"
 #include "vm/service.h"
@@ -55,6 +62,7 @@
 #include "vm/visitor.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/stub_code_compiler.h"
 #endif
@@ -75,6 +83,11 @@ DECLARE_FLAG(bool, reload_every_back_off);
 DECLARE_FLAG(bool, trace_reload);
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+DECLARE_FLAG(charp, write_aot_profile_to);
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+NOT_IN_PRODUCT(DECLARE_FLAG(charp, write_pprof_profile_to));
+
 static void DeterministicModeHandler(bool value) {
   if (value) {
     FLAG_background_compilation = false;  // Timing dependent.
@@ -96,6 +109,13 @@ DEFINE_FLAG(bool,
             "Disables the limit of the thread pool (simulates custom embedder "
             "with custom message handler on unlimited number of threads).");
 
+DEFINE_FLAG(bool,
+            predict_idle_window,
+            false,
+            "Schedule idle-time GC within the idle window predicted from the "
+            "gaps between message bursts, instead of after idle_timeout_micros "
+            "for idle_duration_micros.");
+
 // Quick access to the locally defined thread() and isolate() methods.
 #define T (thread())
 #define I (isolate())
@@ -201,22 +221,64 @@ void IdleTimeHandler::UpdateStartIdleTime() {
   MutexLocker ml(&mutex_);
   if (disabled_counter_ == 0) {
     idle_start_time_ = OS::GetCurrentMonotonicMicros();
+    last_message_end_time_ = idle_start_time_;
   }
 }
 
+void IdleTimeHandler::UpdateEndIdleTime() {
+  if (!FLAG_predict_idle_window) return;
+  int64_t gap;
+  {
+    MutexLocker ml(&mutex_);
+    if (last_message_end_time_ == 0) return;
+    gap = OS::GetCurrentMonotonicMicros() - last_message_end_time_;
+    last_message_end_time_ = 0;
+  }
+  RecordIdleGap(gap);
+}
+
+void IdleTimeHandler::RecordIdleGap(int64_t gap_micros) {
+  if (gap_micros < kMinIdleGapMicros) return;
+  MutexLocker ml(&mutex_);
+  if (predicted_idle_micros_ == 0) {
+    predicted_idle_micros_ = gap_micros;
+  } else {
+    // Exponential moving average, so a few unusually long or short gaps do
+    // not swing the prediction.
+    predicted_idle_micros_ = (3 * predicted_idle_micros_ + gap_micros) / 4;
+  }
+}
+
+int64_t IdleTimeHandler::PredictedIdleMicros() {
+  MutexLocker ml(&mutex_);
+  return predicted_idle_micros_;
+}
+
+int64_t IdleTimeHandler::IdleTimeoutMicrosLocked() const {
+  ASSERT(mutex_.IsOwnedByCurrentThread());
+  if (FLAG_predict_idle_window && predicted_idle_micros_ > 0) {
+    // Wait out a small part of the window to confirm the burst has ended,
+    // leaving the rest of it for the GC.
+    return Utils::Minimum(static_cast<int64_t>(FLAG_idle_timeout_micros),
+                          predicted_idle_micros_ / 8);
+  }
+  return FLAG_idle_timeout_micros;
+}
+
 bool IdleTimeHandler::ShouldNotifyIdle(int64_t* expiry) {
   const int64_t now = OS::GetCurrentMonotonicMicros();
 
   MutexLocker ml(&mutex_);
+  const int64_t timeout = IdleTimeoutMicrosLocked();
   if (idle_start_time_ > 0 && disabled_counter_ == 0) {
-    const int64_t expiry_time = idle_start_time_ + FLAG_idle_timeout_micros;
+    const int64_t expiry_time = idle_start_time_ + timeout;
     if (expiry_time < now) {
       idle_start_time_ = 0;
       return true;
     }
   }
 
-  *expiry = now + FLAG_idle_timeout_micros;
+  *expiry = now + timeout;
   return false;
 }
 
@@ -237,7 +299,16 @@ void IdleTimeHandler::NotifyIdle(int64_t deadline) {
 
 void IdleTimeHandler::NotifyIdleUsingDefaultDeadline() {
   const int64_t now = OS::GetCurrentMonotonicMicros();
-  NotifyIdle(now + FLAG_idle_duration_micros);
+  int64_t duration = FLAG_idle_duration_micros;
+  if (FLAG_predict_idle_window) {
+    MutexLocker ml(&mutex_);
+    if (predicted_idle_micros_ > 0) {
+      // The timeout has already used up part of the window.
+      duration = Utils::Maximum<int64_t>(
+          predicted_idle_micros_ - IdleTimeoutMicrosLocked(), 0);
+    }
+  }
+  NotifyIdle(now + duration);
 }
 
 DisableIdleTimerScope::DisableIdleTimerScope(IdleTimeHandler* handler)
@@ -330,7 +401,8 @@ IsolateGroup::IsolateGroup(std::shared_ptr<IsolateGroupSource> source,
       class_table_allocator_(),
       embedder_data_(embedder_data),
       thread_pool_(),
-      isolates_lock_(new SafepointRwLock()),
+      isolates_lock_(
+          new SafepointRwLock(NOT_IN_PRODUCT("IsolateGroup::isolates_lock_"))),
       isolates_(),
       start_time_micros_(OS::GetCurrentMonotonicMicros()),
       is_system_isolate_group_(source->flags.is_system_isolate),
@@ -343,8 +415,13 @@ IsolateGroup::IsolateGroup(std::shared_ptr<IsolateGroupSource> source,
       api_state_(new ApiState()),
       thread_registry_(new ThreadRegistry()),
       safepoint_handler_(new SafepointHandler(this)),
+      ffi_native_cache_(new FfiNativeCache()),
 #if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
       reload_handler_(new ReloadHandler()),
+      compilation_log_(new CompilationLog()),
+#endif
+#if !defined(PRODUCT)
+      sampled_allocation_profile_(new SampledAllocationProfile()),
 #endif
       store_buffer_(new StoreBuffer()),
       heap_(nullptr),
@@ -376,7 +453,8 @@ IsolateGroup::IsolateGroup(std::shared_ptr<IsolateGroupSource> source,
           NOT_IN_PRODUCT("IsolateGroup::kernel_constants_mutex_")),
       field_list_mutex_(NOT_IN_PRODUCT("Isolate::field_list_mutex_")),
       boxed_field_list_(GrowableObjectArray::null()),
-      program_lock_(new SafepointRwLock()),
+      program_lock_(
+          new SafepointRwLock(NOT_IN_PRODUCT("IsolateGroup::program_lock_"))),
       active_mutators_monitor_(new Monitor()),
       max_active_mutators_(Scavenger::MaxMutatorThreadCount())
 #if !defined(PRODUCT)
@@ -433,6 +511,12 @@ IsolateGroup::~IsolateGroup() {
 #endif
 }
 
+#if !defined(PRODUCT)
+void IsolateGroup::set_retained_sizes_baseline(ClassRetainedSizes* value) {
+  retained_sizes_baseline_.reset(value);
+}
+#endif
+
 void IsolateGroup::RegisterIsolate(Isolate* isolate) {
   {
     SafepointWriteRwLocker ml(Thread::Current(), isolates_lock_.get());
@@ -649,6 +733,7 @@ void IsolateGroup::UnscheduleThreadLocked(MonitorLocker* ml,
                                           bool is_mutator,
                                           bool bypass_safepoint) {
   thread->heap()->new_space()->AbandonRemainingTLAB(thread);
+  thread->heap()->old_space()->AbandonThreadLocalBuffer(thread);
 
   // Clear since GC will not visit the thread once it is unscheduled. Do this
   // under the thread lock to prevent races with the GC visiting thread roots.
@@ -754,19 +839,29 @@ void IsolateGroup::IncreaseMutatorCount(Isolate* mutator,
 
   // Prevent too many mutators from entering the isolate group to avoid
   // pathological behavior where many threads are fighting for obtaining TLABs.
-  {
-    // NOTE: This is performance critical code, we should avoid monitors and use
-    // std::atomics in the fast case (where active_mutators <
-    // max_active_mutators) and only use monitors in the uncommon case.
-    MonitorLocker ml(active_mutators_monitor_.get());
-    ASSERT(active_mutators_ <= max_active_mutators_);
-    while (active_mutators_ == max_active_mutators_) {
-      waiting_mutators_++;
-      ml.Wait();
-      waiting_mutators_--;
+  if (TryIncreaseMutatorCount()) {
+    return;
+  }
+
+  MonitorLocker ml(active_mutators_monitor_.get());
+  // Announce the waiter before checking again, so that a mutator leaving
+  // after the check sees it and notifies the monitor.
+  waiting_mutators_.fetch_add(1);
+  while (!TryIncreaseMutatorCount()) {
+    ml.Wait();
+  }
+  waiting_mutators_.fetch_sub(1);
+}
+
+bool IsolateGroup::TryIncreaseMutatorCount() {
+  intptr_t active = active_mutators_.load();
+  while (active < max_active_mutators_) {
+    if (active_mutators_.compare_exchange_weak(active, active + 1)) {
+      return true;
     }
-    active_mutators_++;
   }
+  ASSERT(active == max_active_mutators_);
+  return false;
 }
 
 void IsolateGroup::DecreaseMutatorCount(Isolate* mutator, bool is_nested_exit) {
@@ -780,16 +875,12 @@ void IsolateGroup::DecreaseMutatorCount(Isolate* mutator, bool is_nested_exit) {
     thread_pool()->MarkCurrentWorkerAsBlocked();
   }
 
-  {
-    // NOTE: This is performance critical code, we should avoid monitors and use
-    // std::atomics in the fast case (where active_mutators <
-    // max_active_mutators) and only use monitors in the uncommon case.
+  const intptr_t active = active_mutators_.fetch_sub(1);
+  ASSERT(active > 0 && active <= max_active_mutators_);
+  USE(active);
+  if (waiting_mutators_.load() > 0) {
     MonitorLocker ml(active_mutators_monitor_.get());
-    ASSERT(active_mutators_ <= max_active_mutators_);
-    active_mutators_--;
-    if (waiting_mutators_ > 0) {
-      ml.Notify();
-    }
+    ml.Notify();
   }
 }
 
@@ -1957,6 +2048,17 @@ int64_t Isolate::UptimeMicros() const {
   return OS::GetCurrentMonotonicMicros() - start_time_micros_;
 }
 
+int64_t Isolate::CpuTimeMicros() const {
+  int64_t micros = cpu_time_micros_.load();
+  Thread* thread = Thread::Current();
+  if (thread != nullptr && thread->IsMutatorThread() &&
+      thread->isolate() == this) {
+    micros +=
+        OS::GetCurrentThreadCPUMicros() - thread->isolate_enter_cpu_micros();
+  }
+  return micros;
+}
+
 Dart_Port Isolate::origin_id() {
   MutexLocker ml(&origin_id_mutex_);
   return origin_id_;
@@ -2524,6 +2626,10 @@ void Isolate::Shutdown() {
     ServiceIsolate::SendIsolateShutdownMessage();
 #if !defined(PRODUCT)
     debugger()->Shutdown();
+    if (FLAG_write_pprof_profile_to != nullptr && is_runnable() &&
+        !Isolate::IsSystemIsolate(this)) {
+      ProfilerService::WritePprof(thread, FLAG_write_pprof_profile_to);
+    }
     Profiler::IsolateShutdown(thread);
 #endif
   }
@@ -2538,6 +2644,15 @@ void Isolate::Shutdown() {
   }
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if (FLAG_write_aot_profile_to != nullptr && is_runnable() &&
+      !Isolate::IsSystemIsolate(this) && group()->ContainsOnlyOneIsolate()) {
+    StackZone zone(thread);
+    HandleScope handle_scope(thread);
+    AotProfile::Write(thread, FLAG_write_aot_profile_to);
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
   // Then, proceed with low-level teardown.
   Isolate::UnMarkIsolateReady(this);
 
@@ -2546,6 +2661,13 @@ void Isolate::Shutdown() {
   // run any Dart code anymore _and_ will not run any native finalizers anymore.
   RunAndCleanupFinalizersOnShutdown();
 
+  // Native threads may keep calling listener callbacks, which now drop the
+  // calls.
+  FfiCallbackListener::CloseAll(this);
+  // Waits for calls of isolate group callbacks in other isolates, which may
+  // still use the target function.
+  FfiIsolateGroupCallback::CloseAll(thread);
+
   // Post message before LowLevelShutdown that sends onExit message.
   // This ensures that exit message comes last.
   if (bequest_ != nullptr) {
@@ -2611,6 +2733,8 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
 
       // Finalize any weak persistent handles with a non-null referent with
       // isolate group still being available.
+      isolate_group->api_state()->RunPendingFinalizers(
+          isolate_group->embedder_data());
       FinalizeWeakPersistentHandlesVisitor visitor(isolate_group);
       isolate_group->api_state()->VisitWeakHandlesUnlocked(&visitor);
 
@@ -3001,6 +3125,8 @@ void Isolate::PrintJSON(JSONStream* stream, bool ref) {
     group()->heap()->PrintToJSONObject(Heap::kNew, &jsheap);
     group()->heap()->PrintToJSONObject(Heap::kOld, &jsheap);
   }
+  jsobj.AddProperty64("_cpuTimeMicros", CpuTimeMicros());
+  jsobj.AddProperty64("_allocatedBytes", allocated_bytes());
 
   {
 // Stringification macros
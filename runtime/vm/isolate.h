@@ -48,7 +48,9 @@ class ApiState;
 class BackgroundCompiler;
 class Become;
 class Capability;
+class ClassRetainedSizes;
 class CodeIndexTable;
+class CompilationLog;
 class Debugger;
 class DeoptContext;
 class ExternalTypedData;
@@ -56,6 +58,7 @@ class GroupDebugger;
 class HandleScope;
 class HandleVisitor;
 class Heap;
+class FfiNativeCache;
 class ICData;
 class IsolateGroupReloadContext;
 class IsolateObjectStore;
@@ -78,6 +81,7 @@ class SafepointHandler;
 class SampleBuffer;
 class SampleBlock;
 class SampleBlockBuffer;
+class SampledAllocationProfile;
 class SendPort;
 class SerializedObjectBuffer;
 class ServiceIdZone;
@@ -127,8 +131,10 @@ class LambdaCallable : public Callable {
   DISALLOW_COPY_AND_ASSIGN(LambdaCallable);
 };
 
-// Fixed cache for exception handler lookup.
-typedef FixedCache<intptr_t, ExceptionHandlerInfo, 16> HandlerInfoCache;
+// Fixed cache for exception handler lookup. Also holds the frames without a
+// handler that exceptions pass through, so it is larger than the catch entry
+// cache.
+typedef FixedCache<intptr_t, ExceptionHandlerInfo, 64> HandlerInfoCache;
 // Fixed cache for catch entry state lookup.
 typedef FixedCache<intptr_t, CatchEntryMovesRefPtr, 16> CatchEntryMovesCache;
 
@@ -233,6 +239,18 @@ class IdleTimeHandler : public ValueObject {
   // Declares that the idle time should be reset to now.
   void UpdateStartIdleTime();
 
+  // Declares that a normal message is about to be handled. The gap since the
+  // last message feeds the prediction of the next idle window.
+  void UpdateEndIdleTime();
+
+  // Folds an observed gap between messages into the predicted idle window.
+  // Gaps shorter than kMinIdleGapMicros are treated as part of a burst.
+  void RecordIdleGap(int64_t gap_micros);
+
+  // Returns the predicted length of the next idle window, or 0 if none has
+  // been observed yet.
+  int64_t PredictedIdleMicros();
+
   // Returns whether idle time expired and [NotifyIdle] should be called.
   bool ShouldNotifyIdle(int64_t* expiry);
 
@@ -240,16 +258,26 @@ class IdleTimeHandler : public ValueObject {
   // we have time for the GC until [deadline].
   void NotifyIdle(int64_t deadline);
 
-  // Calls [NotifyIdle] with the default deadline.
+  // Calls [NotifyIdle] with the default deadline, or with the end of the
+  // predicted idle window under --predict_idle_window.
   void NotifyIdleUsingDefaultDeadline();
 
+  static constexpr int64_t kMinIdleGapMicros = kMicrosecondsPerMillisecond;
+
  private:
   friend class DisableIdleTimerScope;
 
+  // How long to wait after the last message before notifying the heap.
+  int64_t IdleTimeoutMicrosLocked() const;
+
   Mutex mutex_;
   Heap* heap_ = nullptr;
   intptr_t disabled_counter_ = 0;
   int64_t idle_start_time_ = 0;
+  // Unlike idle_start_time_, not cleared by idle notifications, so that the
+  // whole gap between bursts is measured.
+  int64_t last_message_end_time_ = 0;
+  int64_t predicted_idle_micros_ = 0;
 };
 
 // Disables firing of the idle timer while this object is alive.
@@ -265,7 +293,8 @@ class DisableIdleTimerScope : public ValueObject {
 class MutatorThreadPool : public ThreadPool {
  public:
   MutatorThreadPool(IsolateGroup* isolate_group, intptr_t max_pool_size)
-      : ThreadPool(max_pool_size), isolate_group_(isolate_group) {}
+      : ThreadPool(max_pool_size, Dart_TaskPriority_High),
+        isolate_group_(isolate_group) {}
   virtual ~MutatorThreadPool() {}
 
  protected:
@@ -342,8 +371,22 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   Monitor* threads_lock() const;
   ThreadRegistry* thread_registry() const { return thread_registry_.get(); }
   SafepointHandler* safepoint_handler() { return safepoint_handler_.get(); }
+  FfiNativeCache* ffi_native_cache() { return ffi_native_cache_.get(); }
 #if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
   ReloadHandler* reload_handler() { return reload_handler_.get(); }
+  CompilationLog* compilation_log() { return compilation_log_.get(); }
+#endif
+#if !defined(PRODUCT)
+  SampledAllocationProfile* sampled_allocation_profile() {
+    return sampled_allocation_profile_.get();
+  }
+
+  // The retained sizes that _getRetainedSizesByClass reports differences
+  // from, if any. Takes ownership of [value].
+  ClassRetainedSizes* retained_sizes_baseline() const {
+    return retained_sizes_baseline_.get();
+  }
+  void set_retained_sizes_baseline(ClassRetainedSizes* value);
 #endif
 
   void CreateHeap(bool is_vm_isolate, bool is_service_or_kernel_isolate);
@@ -590,10 +633,7 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
 
   void IncreaseMutatorCount(Isolate* mutator, bool is_nested_reenter);
   void DecreaseMutatorCount(Isolate* mutator, bool is_nested_exit);
-  intptr_t MutatorCount() const {
-    MonitorLocker ml(active_mutators_monitor_.get());
-    return active_mutators_;
-  }
+  intptr_t MutatorCount() const { return active_mutators_.load(); }
 
   bool HasTagHandler() const { return library_tag_handler() != nullptr; }
   ObjectPtr CallTagHandler(Dart_LibraryTag tag,
@@ -878,9 +918,16 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   std::unique_ptr<ApiState> api_state_;
   std::unique_ptr<ThreadRegistry> thread_registry_;
   std::unique_ptr<SafepointHandler> safepoint_handler_;
+  std::unique_ptr<FfiNativeCache> ffi_native_cache_;
 
   NOT_IN_PRODUCT(
       NOT_IN_PRECOMPILED(std::unique_ptr<ReloadHandler> reload_handler_));
+  NOT_IN_PRODUCT(
+      NOT_IN_PRECOMPILED(std::unique_ptr<CompilationLog> compilation_log_));
+  NOT_IN_PRODUCT(
+      std::unique_ptr<SampledAllocationProfile> sampled_allocation_profile_);
+  NOT_IN_PRODUCT(
+      std::unique_ptr<ClassRetainedSizes> retained_sizes_baseline_);
 
   static RwLock* isolate_groups_rwlock_;
   static IntrusiveDList<IsolateGroup>* isolate_groups_;
@@ -930,9 +977,12 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   std::unique_ptr<SafepointRwLock> program_lock_;
 
   // Allow us to ensure the number of active mutators is limited by a maximum.
+  // Mutators enter and leave without taking the monitor while there is room;
+  // it is only used to wait for a free slot and to wake up waiters.
+  bool TryIncreaseMutatorCount();
   std::unique_ptr<Monitor> active_mutators_monitor_;
-  intptr_t active_mutators_ = 0;
-  intptr_t waiting_mutators_ = 0;
+  std::atomic<intptr_t> active_mutators_ = {0};
+  std::atomic<intptr_t> waiting_mutators_ = {0};
   intptr_t max_active_mutators_ = 0;
 
   NOT_IN_PRODUCT(GroupDebugger* debugger_ = nullptr);
@@ -1055,6 +1105,16 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
 
   int64_t UptimeMicros() const;
 
+  // The CPU time spent by the threads that ran this isolate, including the
+  // current thread if it is running this isolate.
+  int64_t CpuTimeMicros() const;
+  void AddCpuTimeMicros(int64_t micros) { cpu_time_micros_.fetch_add(micros); }
+
+  // The bytes allocated by this isolate in new-space TLABs that have been
+  // released, which happens when they fill up and before every scavenge.
+  int64_t allocated_bytes() const { return allocated_bytes_.load(); }
+  void AddAllocatedBytes(int64_t bytes) { allocated_bytes_.fetch_add(bytes); }
+
   Dart_Port main_port() const { return main_port_; }
   void set_main_port(Dart_Port port) {
     ASSERT(main_port_ == 0);  // Only set main port once.
@@ -1658,6 +1718,8 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
 
   // All other fields go here.
   int64_t start_time_micros_;
+  RelaxedAtomic<int64_t> cpu_time_micros_ = {0};
+  RelaxedAtomic<int64_t> allocated_bytes_ = {0};
   std::atomic<Dart_MessageNotifyCallback> message_notify_callback_;
   Dart_IsolateShutdownCallback on_shutdown_callback_ = nullptr;
   Dart_IsolateCleanupCallback on_cleanup_callback_ = nullptr;
@@ -2029,15 +2029,50 @@ void ProgramReloadContext::ResetMegamorphicCaches() {
   // new ones.
 }
 
+// Returns the set of classes whose instances need to have their fields
+// checked after a reload. Instances of classes without instance fields, or
+// whose fields are all unboxed or already guarded, cannot gain a load guard,
+// so the heap walk does not need to collect them.
+static BitVector* ClassesWithCheckedFields(Zone* zone,
+                                           ClassTable* class_table) {
+  const intptr_t num_cids = class_table->NumCids();
+  BitVector* result = new (zone) BitVector(zone, num_cids);
+  auto& cls = Class::Handle(zone);
+  auto& field_map = Array::Handle(zone);
+  auto& entry = Object::Handle(zone);
+  for (intptr_t cid = kNumPredefinedCids; cid < num_cids; cid++) {
+    if (!class_table->HasValidClassAt(cid)) {
+      continue;
+    }
+    cls = class_table->At(cid);
+    if (!cls.is_finalized()) {
+      // Cannot have instances.
+      continue;
+    }
+    field_map = cls.OffsetToFieldMap(class_table);
+    for (intptr_t i = 0; i < field_map.Length(); i++) {
+      entry = field_map.At(i);
+      if (entry.IsField() && !Field::Cast(entry).needs_load_guard() &&
+          !Field::Cast(entry).is_unboxed()) {
+        result->Add(cid);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
 class InvalidationCollector : public ObjectVisitor {
  public:
   InvalidationCollector(Zone* zone,
+                        BitVector* classes_with_checked_fields,
                         GrowableArray<const Function*>* functions,
                         GrowableArray<const KernelProgramInfo*>* kernel_infos,
                         GrowableArray<const Field*>* fields,
                         GrowableArray<const SuspendState*>* suspend_states,
                         GrowableArray<const Instance*>* instances)
       : zone_(zone),
+        classes_with_checked_fields_(classes_with_checked_fields),
         functions_(functions),
         kernel_infos_(kernel_infos),
         fields_(fields),
@@ -2066,12 +2101,17 @@ class InvalidationCollector : public ObjectVisitor {
         suspend_states_->Add(&suspend_state);
       }
     } else if (cid > kNumPredefinedCids) {
-      instances_->Add(&Instance::Handle(zone_, static_cast<InstancePtr>(obj)));
+      if (cid >= classes_with_checked_fields_->length() ||
+          classes_with_checked_fields_->Contains(cid)) {
+        instances_->Add(
+            &Instance::Handle(zone_, static_cast<InstancePtr>(obj)));
+      }
     }
   }
 
  private:
   Zone* const zone_;
+  BitVector* const classes_with_checked_fields_;
   GrowableArray<const Function*>* const functions_;
   GrowableArray<const KernelProgramInfo*>* const kernel_infos_;
   GrowableArray<const Field*>* const fields_;
@@ -2093,9 +2133,13 @@ void ProgramReloadContext::RunInvalidationVisitors() {
   GrowableArray<const SuspendState*> suspend_states(4 * KB);
   GrowableArray<const Instance*> instances(4 * KB);
 
+  BitVector* classes_with_checked_fields =
+      ClassesWithCheckedFields(zone, IG->class_table());
+
   {
     HeapIterationScope iteration(thread);
-    InvalidationCollector visitor(zone, &functions, &kernel_infos, &fields,
+    InvalidationCollector visitor(zone, classes_with_checked_fields,
+                                  &functions, &kernel_infos, &fields,
                                   &suspend_states, &instances);
     iteration.IterateObjects(&visitor);
   }
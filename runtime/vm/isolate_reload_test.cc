@@ -5446,6 +5446,67 @@ TEST_CASE(IsolateReload_ExistingFieldChangesTypeIndirect) {
                SimpleInvokeStr(lib, "main"));
 }
 
+// Instances whose fields are only inherited are still checked, while the
+// many instances without fields are skipped.
+TEST_CASE(IsolateReload_InheritedFieldChangesTypeIndirect) {
+  const char* late_tag = TestCase::LateTag();
+  // clang-format off
+  auto kScript = Utils::CStringUniquePtr(OS::SCreate(nullptr, R"(
+    class A {}
+    class B extends A {}
+    class Base {
+      A x;
+      Base(this.x);
+    }
+    class Foo extends Base {
+      Foo(A x) : super(x);
+    }
+    class Empty {}
+    %s Foo value;
+    %s List<Empty> empties;
+    main() {
+      value = Foo(B());
+      empties = List<Empty>.generate(1000, (_) => Empty());
+      return 'Okay';
+    }
+  )", late_tag, late_tag), std::free);
+  // clang-format on
+
+  Dart_Handle lib = TestCase::LoadTestScript(kScript.get(), nullptr);
+  EXPECT_VALID(lib);
+  EXPECT_STREQ("Okay", SimpleInvokeStr(lib, "main"));
+
+  // B is no longer a subtype of A.
+  // clang-format off
+  auto kReloadScript = Utils::CStringUniquePtr(OS::SCreate(nullptr, R"(
+    class A {}
+    class B {}
+    class Base {
+      A x;
+      Base(this.x);
+    }
+    class Foo extends Base {
+      Foo(A x) : super(x);
+    }
+    class Empty {}
+    %s Foo value;
+    %s List<Empty> empties;
+    main() {
+      try {
+        return value.x.toString();
+      } catch (e) {
+        return e.toString();
+      }
+    }
+  )", late_tag, late_tag), std::free);
+  // clang-format on
+
+  lib = TestCase::ReloadTestScript(kReloadScript.get());
+  EXPECT_VALID(lib);
+  EXPECT_STREQ("type 'B' is not a subtype of type 'A' of 'function result'",
+               SimpleInvokeStr(lib, "main"));
+}
+
 TEST_CASE(IsolateReload_ExistingStaticFieldChangesTypeIndirect) {
   const char* kScript = R"(
     class A {}
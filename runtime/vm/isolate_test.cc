@@ -148,6 +148,22 @@ class InterruptChecker : public ThreadPool::Task {
 // happens *after* the interrupt is observed. Without this synchronization, the
 // compiler and/or CPU could reorder operations to make the tasks observe the
 // round update *before* the interrupt is set.
+VM_UNIT_TEST_CASE(IdleTimeHandler_PredictsIdleWindow) {
+  IdleTimeHandler handler;
+  EXPECT_EQ(0, handler.PredictedIdleMicros());
+
+  // Gaps within a burst are ignored.
+  handler.RecordIdleGap(IdleTimeHandler::kMinIdleGapMicros / 2);
+  EXPECT_EQ(0, handler.PredictedIdleMicros());
+
+  handler.RecordIdleGap(100 * kMicrosecondsPerMillisecond);
+  EXPECT_EQ(100 * kMicrosecondsPerMillisecond, handler.PredictedIdleMicros());
+
+  // A single outlier only moves the prediction part of the way.
+  handler.RecordIdleGap(20 * kMicrosecondsPerMillisecond);
+  EXPECT_EQ(80 * kMicrosecondsPerMillisecond, handler.PredictedIdleMicros());
+}
+
 TEST_CASE(StackLimitInterrupts) {
   ThreadBarrier* barrier = new ThreadBarrier(InterruptChecker::kTaskCount + 1,
                                              InterruptChecker::kTaskCount + 1);
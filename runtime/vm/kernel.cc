@@ -374,6 +374,11 @@ ArrayPtr CollectConstConstructorCoverageFrom(const Script& interesting_script) {
 
 ObjectPtr EvaluateStaticConstFieldInitializer(const Field& field) {
   ASSERT(field.is_static() && field.is_const());
+  return EvaluateConstantFieldInitializer(field);
+}
+
+ObjectPtr EvaluateConstantFieldInitializer(const Field& field) {
+  ASSERT(field.is_static());
 
   LongJumpScope jump;
   if (setjmp(*jump.Set()) == 0) {
@@ -396,9 +401,14 @@ ObjectPtr EvaluateStaticConstFieldInitializer(const Field& field) {
 
     FieldHelper field_helper(&kernel_reader);
     field_helper.ReadUntilExcluding(FieldHelper::kInitializer);
-    ASSERT(field_helper.IsConst());
-
-    return constant_reader.ReadConstantInitializer();
+    if (field_helper.IsConst()) {
+      return constant_reader.ReadConstantInitializer();
+    }
+    if (kernel_reader.ReadTag() != kSomething ||
+        kernel_reader.PeekTag() != kConstantExpression) {
+      return Object::sentinel().ptr();
+    }
+    return constant_reader.ReadConstantExpression();
   } else {
     return Thread::Current()->StealStickyError();
   }
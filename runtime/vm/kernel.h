@@ -211,6 +211,9 @@ ArrayPtr CollectConstConstructorCoverageFrom(const Script& interesting_script);
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
 ObjectPtr EvaluateStaticConstFieldInitializer(const Field& field);
+// Returns the value of the initializer of the static [field] if it is a
+// constant expression, or the sentinel if it is not.
+ObjectPtr EvaluateConstantFieldInitializer(const Field& field);
 ObjectPtr EvaluateMetadata(const Library& library,
                            intptr_t kernel_offset,
                            bool is_annotations_offset);
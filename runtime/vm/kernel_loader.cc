@@ -1048,6 +1048,7 @@ void KernelLoader::FinishTopLevelClassLoading(
     ReadVMAnnotations(library, annotation_count, /*native_name=*/nullptr,
                       /*is_invisible_function=*/nullptr,
                       /*is_isolate_unsendable=*/nullptr,
+                      /*is_deeply_immutable=*/nullptr,
                       &has_pragma_annotation);
     field_helper.SetJustRead(FieldHelper::kAnnotations);
 
@@ -1360,12 +1361,16 @@ void KernelLoader::LoadClass(const Library& library,
   intptr_t annotation_count = helper_.ReadListLength();
   bool has_pragma_annotation = false;
   bool is_isolate_unsendable = false;
+  bool is_deeply_immutable = false;
   ReadVMAnnotations(library, annotation_count, /*native_name=*/nullptr,
                     /*is_invisible_function=*/nullptr, &is_isolate_unsendable,
-                    &has_pragma_annotation);
+                    &is_deeply_immutable, &has_pragma_annotation);
   if (is_isolate_unsendable) {
     out_class->set_is_isolate_unsendable_due_to_pragma(true);
   }
+  if (is_deeply_immutable) {
+    out_class->set_is_deeply_immutable(true);
+  }
   if (has_pragma_annotation) {
     out_class->set_has_pragma(true);
   }
@@ -1446,6 +1451,7 @@ void KernelLoader::FinishClassLoading(const Class& klass,
       ReadVMAnnotations(library, annotation_count, /*native_name=*/nullptr,
                         /*is_invisible_function=*/nullptr,
                         /*is_isolate_unsendable=*/nullptr,
+                        /*is_deeply_immutable=*/nullptr,
                         &has_pragma_annotation);
       field_helper.SetJustRead(FieldHelper::kAnnotations);
 
@@ -1573,7 +1579,7 @@ void KernelLoader::FinishClassLoading(const Class& klass,
     bool is_invisible_function;
     ReadVMAnnotations(library, annotation_count, /*native_name=*/nullptr,
                       &is_invisible_function, /*isolate_unsendable=*/nullptr,
-                      &has_pragma_annotation);
+                      /*is_deeply_immutable=*/nullptr, &has_pragma_annotation);
     constructor_helper.SetJustRead(ConstructorHelper::kAnnotations);
     constructor_helper.ReadUntilExcluding(ConstructorHelper::kFunction);
 
@@ -1724,6 +1730,10 @@ void KernelLoader::FinishLoading(const Class& klass) {
 //
 //   `native_name`: set if @pragma('vm:external-name)` was identified.
 //
+//   `is_isolate_unsendable`: if `@pragma('vm:isolate-unsendable')` was found.
+//
+//   `is_deeply_immutable`: if `@pragma('vm:deeply-immutable')` was found.
+//
 //   `has_pragma_annotation`: if `@pragma(...)` was found (no information
 //   is given on the kind of pragma directive).
 //
@@ -1732,6 +1742,7 @@ void KernelLoader::ReadVMAnnotations(const Library& library,
                                      String* native_name,
                                      bool* is_invisible_function,
                                      bool* is_isolate_unsendable,
+                                     bool* is_deeply_immutable,
                                      bool* has_pragma_annotation) {
   if (is_invisible_function != nullptr) {
     *is_invisible_function = false;
@@ -1775,6 +1786,12 @@ void KernelLoader::ReadVMAnnotations(const Library& library,
             *is_isolate_unsendable = true;
           }
         }
+        if (is_deeply_immutable != nullptr) {
+          if (constant_reader.IsStringConstant(name_index,
+                                               "vm:deeply-immutable")) {
+            *is_deeply_immutable = true;
+          }
+        }
       }
     } else {
       helper_.SkipExpression();
@@ -1815,7 +1832,7 @@ void KernelLoader::LoadProcedure(const Library& library,
   const intptr_t annotation_count = helper_.ReadListLength();
   ReadVMAnnotations(library, annotation_count, &native_name,
                     &is_invisible_function, /*isolate_unsendable=*/nullptr,
-                    &has_pragma_annotation);
+                    /*is_deeply_immutable=*/nullptr, &has_pragma_annotation);
   is_external = is_external && native_name.IsNull();
   procedure_helper.SetJustRead(ProcedureHelper::kAnnotations);
   const Object& script_class =
@@ -1952,6 +1969,7 @@ ScriptPtr KernelLoader::LoadScriptAt(intptr_t index,
     }
   }
 
+  bool lazy_lookup = false;
   if (sources.IsNull() || line_starts.IsNull()) {
     const String& script_source = helper_.GetSourceFor(index);
     line_starts = helper_.GetLineStartsFor(index);
@@ -1959,20 +1977,9 @@ ScriptPtr KernelLoader::LoadScriptAt(intptr_t index,
     if (script_source.ptr() == Symbols::Empty().ptr() &&
         line_starts.Length() == 0 && uri_string.Length() > 0) {
       // Entry included only to provide URI - actual source should already exist
-      // in the VM, so try to find it.
-      Library& lib = Library::Handle(Z);
-      Script& script = Script::Handle(Z);
-      const GrowableObjectArray& libs =
-          GrowableObjectArray::Handle(IG->object_store()->libraries());
-      for (intptr_t i = 0; i < libs.Length(); i++) {
-        lib ^= libs.At(i);
-        script = lib.LookupScript(uri_string, /* useResolvedUri = */ true);
-        if (!script.IsNull()) {
-          sources = script.Source();
-          line_starts = script.line_starts();
-          break;
-        }
-      }
+      // in the VM. Searching all libraries for it is only done when the source
+      // is first needed, see Script::LookupSourceAndLineStarts.
+      lazy_lookup = true;
     } else {
       sources = script_source.ptr();
     }
@@ -1980,6 +1987,7 @@ ScriptPtr KernelLoader::LoadScriptAt(intptr_t index,
 
   const Script& script =
       Script::Handle(Z, Script::New(import_uri_string, uri_string, sources));
+  script.SetLazyLookupSourceAndLineStarts(lazy_lookup);
   script.set_kernel_script_index(index);
   script.set_kernel_program_info(kernel_program_info_);
   script.set_line_starts(line_starts);
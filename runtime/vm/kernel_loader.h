@@ -231,6 +231,7 @@ class KernelLoader : public ValueObject {
                          String* native_name,
                          bool* is_invisible_function,
                          bool* is_isolate_unsendable,
+                         bool* is_deeply_immutable,
                          bool* has_pragma_annotation);
 
   KernelLoader(const Script& script,
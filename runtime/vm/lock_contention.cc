@@ -0,0 +1,236 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(PRODUCT)
+
+#include "vm/lock_contention.h"
+
+#include "platform/utils.h"
+#include "vm/growable_array.h"
+#include "vm/json_stream.h"
+#include "vm/native_symbol.h"
+#include "vm/os.h"
+#include "vm/timeline.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            profile_lock_contention,
+            false,
+            "Count VM lock acquisitions and measure how long threads block on "
+            "them. Reported by _getLockContentionProfile.");
+
+LockContentionProfiler::Entry
+    LockContentionProfiler::entries_[LockContentionProfiler::kMaxLocks];
+RelaxedAtomic<intptr_t> LockContentionProfiler::dropped_ = 0;
+
+static const char* KindToCString(intptr_t kind) {
+  switch (kind) {
+    case LockContentionProfiler::kMutex:
+      return "Mutex";
+    case LockContentionProfiler::kMonitor:
+      return "Monitor";
+    case LockContentionProfiler::kReadLock:
+      return "ReadLock";
+    case LockContentionProfiler::kWriteLock:
+      return "WriteLock";
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
+LockContentionProfiler::Entry* LockContentionProfiler::Lookup(const void* lock,
+                                                               const char* name,
+                                                               Kind kind) {
+  const uword hash = reinterpret_cast<uword>(lock) >> kWordSizeLog2;
+  for (intptr_t probe = 0; probe < kMaxLocks; probe++) {
+    Entry* entry = &entries_[(hash + probe) & (kMaxLocks - 1)];
+    const void* current = entry->lock.load(std::memory_order_acquire);
+    if (current == lock) {
+      return entry;
+    }
+    if (current == nullptr) {
+      if (entry->lock.compare_exchange_strong(current, lock,
+                                              std::memory_order_acq_rel)) {
+        entry->name = name;
+        entry->kind = kind;
+        return entry;
+      }
+      if (current == lock) {
+        return entry;
+      }
+    }
+  }
+  dropped_.fetch_add(1);
+  return nullptr;
+}
+
+void LockContentionProfiler::Acquired(const void* lock,
+                                      const char* name,
+                                      Kind kind,
+                                      uword pc) {
+  Entry* entry = Lookup(lock, name, kind);
+  if (entry == nullptr) {
+    return;
+  }
+  entry->acquisitions.fetch_add(1);
+  entry->holder_pc = pc;
+}
+
+void LockContentionProfiler::AddHolderWait(Entry* entry,
+                                           uword holder_pc,
+                                           int64_t micros) {
+  if (holder_pc == 0) {
+    return;
+  }
+  for (intptr_t i = 0; i < kMaxHolders; i++) {
+    Holder* holder = &entry->holders[i];
+    uword current = holder->pc.load();
+    if (current == 0 &&
+        holder->pc.compare_exchange_strong(current, holder_pc)) {
+      current = holder_pc;
+    }
+    if (current == holder_pc) {
+      holder->wait_micros.fetch_add(micros);
+      return;
+    }
+  }
+}
+
+LockContentionProfiler::ContendedScope::ContendedScope(const void* lock,
+                                                       const char* name,
+                                                       Kind kind,
+                                                       uword pc,
+                                                       bool emit_timeline_event)
+    : lock_(lock),
+      name_(name),
+      kind_(kind),
+      pc_(pc),
+      emit_timeline_event_(emit_timeline_event),
+      holder_pc_(0),
+      start_(0) {
+  if (!enabled()) {
+    lock_ = nullptr;
+    return;
+  }
+  start_ = OS::GetCurrentMonotonicMicros();
+  // Read the holder before blocking; once we have the lock it is us.
+  Entry* entry = Lookup(lock, name, kind);
+  if (entry != nullptr) {
+    holder_pc_ = entry->holder_pc;
+  }
+}
+
+LockContentionProfiler::ContendedScope::~ContendedScope() {
+  if (lock_ == nullptr) {
+    return;
+  }
+  const int64_t end = OS::GetCurrentMonotonicMicros();
+  const int64_t wait = end - start_;
+  Entry* entry = Lookup(lock_, name_, kind_);
+  if (entry != nullptr) {
+    entry->acquisitions.fetch_add(1);
+    entry->contentions.fetch_add(1);
+    entry->wait_micros.fetch_add(wait);
+    int64_t max = entry->max_wait_micros.load();
+    while (wait > max &&
+           !entry->max_wait_micros.compare_exchange_weak(max, wait)) {
+    }
+    AddHolderWait(entry, holder_pc_, wait);
+    entry->holder_pc = pc_;
+  }
+#if defined(SUPPORT_TIMELINE)
+  if (emit_timeline_event_) {
+    TimelineStream* stream = Timeline::GetVMStream();
+    TimelineEvent* event = stream->StartEvent();
+    if (event != nullptr) {
+      event->Duration(name_, start_, end);
+      event->SetNumArguments(1);
+      event->CopyArgument(0, "kind", KindToCString(kind_));
+      event->Complete();
+    }
+  }
+#endif  // defined(SUPPORT_TIMELINE)
+}
+
+void LockContentionProfiler::Reset() {
+  for (intptr_t i = 0; i < kMaxLocks; i++) {
+    Entry* entry = &entries_[i];
+    entry->acquisitions = 0;
+    entry->contentions = 0;
+    entry->wait_micros = 0;
+    entry->max_wait_micros = 0;
+    for (intptr_t j = 0; j < kMaxHolders; j++) {
+      entry->holders[j].wait_micros = 0;
+    }
+  }
+  dropped_ = 0;
+}
+
+int LockContentionProfiler::CompareByWait(Entry* const* a, Entry* const* b) {
+  const int64_t a_wait = (*a)->wait_micros.load();
+  const int64_t b_wait = (*b)->wait_micros.load();
+  if (a_wait != b_wait) {
+    return a_wait > b_wait ? -1 : 1;
+  }
+  const int64_t a_count = (*a)->acquisitions.load();
+  const int64_t b_count = (*b)->acquisitions.load();
+  if (a_count != b_count) {
+    return a_count > b_count ? -1 : 1;
+  }
+  return 0;
+}
+
+void LockContentionProfiler::PrintJSON(JSONStream* js) {
+  GrowableArray<Entry*> entries;
+  for (intptr_t i = 0; i < kMaxLocks; i++) {
+    Entry* entry = &entries_[i];
+    if (entry->lock.load(std::memory_order_acquire) != nullptr &&
+        entry->acquisitions.load() > 0) {
+      entries.Add(entry);
+    }
+  }
+  // Most waited on first.
+  entries.Sort(CompareByWait);
+
+  JSONObject obj(js);
+  obj.AddProperty("type", "_LockContentionProfile");
+  obj.AddProperty("enabled", enabled());
+  obj.AddProperty64("dropped", dropped_.load());
+  JSONArray locks(&obj, "locks");
+  for (intptr_t i = 0; i < entries.length(); i++) {
+    Entry* entry = entries[i];
+    JSONObject lock(&locks);
+    const char* name = entry->name.load();
+    lock.AddProperty("name", name != nullptr ? name : "<unknown>");
+    lock.AddProperty("kind", KindToCString(entry->kind.load()));
+    lock.AddPropertyF("address", "%" Px "",
+                      reinterpret_cast<uword>(entry->lock.load()));
+    lock.AddProperty64("acquisitions", entry->acquisitions.load());
+    lock.AddProperty64("contentions", entry->contentions.load());
+    lock.AddProperty64("waitMicros", entry->wait_micros.load());
+    lock.AddProperty64("maxWaitMicros", entry->max_wait_micros.load());
+    JSONArray holders(&lock, "holders");
+    for (intptr_t j = 0; j < kMaxHolders; j++) {
+      const uword pc = entry->holders[j].pc.load();
+      const int64_t wait = entry->holders[j].wait_micros.load();
+      if (pc == 0 || wait == 0) {
+        continue;
+      }
+      JSONObject holder(&holders);
+      holder.AddPropertyF("pc", "%" Px "", pc);
+      uword start = 0;
+      char* symbol = NativeSymbolResolver::LookupSymbolName(pc, &start);
+      if (symbol != nullptr) {
+        holder.AddProperty("symbol", symbol);
+        NativeSymbolResolver::FreeSymbolName(symbol);
+      }
+      holder.AddProperty64("waitMicros", wait);
+    }
+  }
+}
+
+}  // namespace dart
+
+#endif  // !defined(PRODUCT)
@@ -0,0 +1,119 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_LOCK_CONTENTION_H_
+#define RUNTIME_VM_LOCK_CONTENTION_H_
+
+#if !defined(PRODUCT)
+
+#include "platform/atomic.h"
+#include "vm/allocation.h"
+#include "vm/flags.h"
+#include "vm/globals.h"
+#include "vm/os.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, profile_lock_contention);
+
+class JSONStream;
+
+// Counts acquisitions of the locks taken through the lockers in lockers.h and
+// measures how long threads block on them, see --profile_lock_contention.
+//
+// Locks are identified by their address and reported under the name given to
+// them at construction. A contended acquisition is attributed to the lock's
+// current holder, identified by the code address where the holder took the
+// lock, so the report shows which code keeps others waiting.
+//
+// Blocking acquisitions through the safepoint-aware lockers are also recorded
+// as events on the VM timeline stream. Plain MutexLocker and MonitorLocker are
+// also used by the timeline recorder itself, so they are only counted.
+//
+// The bookkeeping is lock free and allocation free, since it runs inside the
+// lockers. At most kMaxLocks locks are tracked; acquisitions of further locks
+// are counted in dropped().
+class LockContentionProfiler : public AllStatic {
+ public:
+  enum Kind {
+    kMutex,
+    kMonitor,
+    kReadLock,
+    kWriteLock,
+  };
+
+  static constexpr intptr_t kMaxLocks = 1024;
+  static constexpr intptr_t kMaxHolders = 4;
+
+  static bool enabled() { return FLAG_profile_lock_contention; }
+
+  // The code address of the caller when profiling, 0 otherwise.
+  DART_FORCE_INLINE static uword CallerPc() {
+    return enabled() ? OS::GetProgramCounter() : 0;
+  }
+
+  // Records an acquisition of [lock] at [pc] that did not block.
+  static void Acquired(const void* lock, const char* name, Kind kind, uword pc);
+
+  // Records a blocking acquisition of [lock] at [pc] that lasts for the scope
+  // of this object. Does nothing unless profiling is enabled.
+  class ContendedScope : public ValueObject {
+   public:
+    ContendedScope(const void* lock,
+                   const char* name,
+                   Kind kind,
+                   uword pc,
+                   bool emit_timeline_event);
+    ~ContendedScope();
+
+   private:
+    const void* lock_;
+    const char* name_;
+    Kind kind_;
+    uword pc_;
+    bool emit_timeline_event_;
+    uword holder_pc_;
+    int64_t start_;
+
+    DISALLOW_COPY_AND_ASSIGN(ContendedScope);
+  };
+
+  static intptr_t dropped() { return dropped_; }
+
+  // Clears all counts. Racing acquisitions may survive the reset.
+  static void Reset();
+
+  static void PrintJSON(JSONStream* js);
+
+ private:
+  struct Holder {
+    RelaxedAtomic<uword> pc;
+    RelaxedAtomic<int64_t> wait_micros;
+  };
+
+  struct Entry {
+    std::atomic<const void*> lock;
+    RelaxedAtomic<const char*> name;
+    RelaxedAtomic<intptr_t> kind;
+    RelaxedAtomic<int64_t> acquisitions;
+    RelaxedAtomic<int64_t> contentions;
+    RelaxedAtomic<int64_t> wait_micros;
+    RelaxedAtomic<int64_t> max_wait_micros;
+    // Where the last thread to acquire the lock took it.
+    RelaxedAtomic<uword> holder_pc;
+    Holder holders[kMaxHolders];
+  };
+
+  static Entry* Lookup(const void* lock, const char* name, Kind kind);
+  static void AddHolderWait(Entry* entry, uword holder_pc, int64_t micros);
+  static int CompareByWait(Entry* const* a, Entry* const* b);
+
+  static Entry entries_[kMaxLocks];
+  static RelaxedAtomic<intptr_t> dropped_;
+};
+
+}  // namespace dart
+
+#endif  // !defined(PRODUCT)
+#endif  // RUNTIME_VM_LOCK_CONTENTION_H_
@@ -39,34 +39,52 @@ Monitor::WaitResult MonitorLocker::WaitWithSafepointCheck(Thread* thread,
   return result;
 }
 
-SafepointMutexLocker::SafepointMutexLocker(ThreadState* thread, Mutex* mutex)
-    : StackResource(thread), mutex_(mutex) {
-  ASSERT(mutex != nullptr);
-  if (!mutex_->TryLock()) {
-    // We did not get the lock and could potentially block, so transition
-    // accordingly.
-    Thread* thread = Thread::Current();
-    if (thread != nullptr) {
-      TransitionVMToBlocked transition(thread);
-      mutex->Lock();
-    } else {
-      mutex->Lock();
+void SafepointMutexLocker::AcquireLock(NOT_IN_PRODUCT(uword pc)) {
+  if (mutex_->TryLock()) {
+#if !defined(PRODUCT)
+    if (UNLIKELY(LockContentionProfiler::enabled())) {
+      LockContentionProfiler::Acquired(mutex_, mutex_->name_,
+                                       LockContentionProfiler::kMutex, pc);
     }
+#endif
+    return;
+  }
+  NOT_IN_PRODUCT(LockContentionProfiler::ContendedScope contended(
+      mutex_, mutex_->name_, LockContentionProfiler::kMutex, pc,
+      /*emit_timeline_event=*/true));
+  // We did not get the lock and could potentially block, so transition
+  // accordingly.
+  Thread* thread = Thread::Current();
+  if (thread != nullptr) {
+    TransitionVMToBlocked transition(thread);
+    mutex_->Lock();
+  } else {
+    mutex_->Lock();
   }
 }
 
-void SafepointMonitorLocker::AcquireLock() {
+void SafepointMonitorLocker::AcquireLock(NOT_IN_PRODUCT(uword pc)) {
   ASSERT(monitor_ != nullptr);
-  if (!monitor_->TryEnter()) {
-    // We did not get the lock and could potentially block, so transition
-    // accordingly.
-    Thread* thread = Thread::Current();
-    if (thread != nullptr) {
-      TransitionVMToBlocked transition(thread);
-      monitor_->Enter();
-    } else {
-      monitor_->Enter();
+  if (monitor_->TryEnter()) {
+#if !defined(PRODUCT)
+    if (UNLIKELY(LockContentionProfiler::enabled())) {
+      LockContentionProfiler::Acquired(monitor_, "anonymous monitor",
+                                       LockContentionProfiler::kMonitor, pc);
     }
+#endif
+    return;
+  }
+  NOT_IN_PRODUCT(LockContentionProfiler::ContendedScope contended(
+      monitor_, "anonymous monitor", LockContentionProfiler::kMonitor, pc,
+      /*emit_timeline_event=*/true));
+  // We did not get the lock and could potentially block, so transition
+  // accordingly.
+  Thread* thread = Thread::Current();
+  if (thread != nullptr) {
+    TransitionVMToBlocked transition(thread);
+    monitor_->Enter();
+  } else {
+    monitor_->Enter();
   }
 }
 
@@ -104,7 +122,7 @@ bool SafepointRwLock::IsCurrentThreadReader() {
 }
 #endif  // defined(DEBUG)
 
-bool SafepointRwLock::EnterRead() {
+bool SafepointRwLock::EnterRead(NOT_IN_PRODUCT(uword pc)) {
   // No need to safepoint if the current thread is not attached.
   auto thread = Thread::Current();
   // Attempt to acquire a lock while owning a safepoint could lead to a deadlock
@@ -113,16 +131,30 @@ bool SafepointRwLock::EnterRead() {
          !thread->isolate_group()->safepoint_handler()->IsOwnedByTheThread(
              thread));
 
-  const bool can_block_without_safepoint = thread == nullptr;
-
   bool acquired_read_lock = false;
-  if (!TryEnterRead(can_block_without_safepoint, &acquired_read_lock)) {
+  if (TryEnterRead(/*can_block=*/false, &acquired_read_lock)) {
+#if !defined(PRODUCT)
+    if (UNLIKELY(LockContentionProfiler::enabled())) {
+      LockContentionProfiler::Acquired(
+          this, name_, LockContentionProfiler::kReadLock, pc);
+    }
+#endif
+    return acquired_read_lock;
+  }
+
+  NOT_IN_PRODUCT(LockContentionProfiler::ContendedScope contended(
+      this, name_, LockContentionProfiler::kReadLock, pc,
+      /*emit_timeline_event=*/true));
+  if (thread == nullptr) {
+    const bool ok = TryEnterRead(/*can_block=*/true, &acquired_read_lock);
+    RELEASE_ASSERT(ok);
+  } else {
     // Important: must never hold monitor_ when blocking for safepoint.
     TransitionVMToBlocked transition(thread);
     const bool ok = TryEnterRead(/*can_block=*/true, &acquired_read_lock);
     RELEASE_ASSERT(ok);
-    RELEASE_ASSERT(acquired_read_lock);
   }
+  RELEASE_ASSERT(acquired_read_lock);
   return acquired_read_lock;
 }
 
@@ -168,12 +200,27 @@ void SafepointRwLock::LeaveRead() {
   }
 }
 
-void SafepointRwLock::EnterWrite() {
+void SafepointRwLock::EnterWrite(NOT_IN_PRODUCT(uword pc)) {
   // No need to safepoint if the current thread is not attached.
   auto thread = Thread::Current();
-  const bool can_block_without_safepoint = thread == nullptr;
 
-  if (!TryEnterWrite(can_block_without_safepoint)) {
+  if (TryEnterWrite(/*can_block=*/false)) {
+#if !defined(PRODUCT)
+    if (UNLIKELY(LockContentionProfiler::enabled())) {
+      LockContentionProfiler::Acquired(
+          this, name_, LockContentionProfiler::kWriteLock, pc);
+    }
+#endif
+    return;
+  }
+
+  NOT_IN_PRODUCT(LockContentionProfiler::ContendedScope contended(
+      this, name_, LockContentionProfiler::kWriteLock, pc,
+      /*emit_timeline_event=*/true));
+  if (thread == nullptr) {
+    const bool ok = TryEnterWrite(/*can_block=*/true);
+    RELEASE_ASSERT(ok);
+  } else {
     // Important: must never hold monitor_ when blocking for safepoint.
     TransitionVMToBlocked transition(thread);
     const bool ok = TryEnterWrite(/*can_block=*/true);
@@ -9,6 +9,7 @@
 #include "platform/growable_array.h"
 #include "vm/allocation.h"
 #include "vm/globals.h"
+#include "vm/lock_contention.h"
 #include "vm/os_thread.h"
 #include "vm/thread.h"
 
@@ -62,7 +63,7 @@ class MutexLocker : public ValueObject {
       no_safepoint_scope_ = false;
     }
 #endif
-    mutex_->Lock();
+    LockMutex();
   }
 
   virtual ~MutexLocker() {
@@ -80,7 +81,7 @@ class MutexLocker : public ValueObject {
       Thread::Current()->IncrementNoSafepointScopeDepth();
     }
 #endif
-    mutex_->Lock();
+    LockMutex();
   }
   void Unlock() const {
     mutex_->Unlock();
@@ -92,6 +93,26 @@ class MutexLocker : public ValueObject {
   }
 
  private:
+  void LockMutex() const {
+#if !defined(PRODUCT)
+    if (UNLIKELY(LockContentionProfiler::enabled())) {
+      const uword pc = OS::GetProgramCounter();
+      if (mutex_->TryLock()) {
+        LockContentionProfiler::Acquired(mutex_, mutex_->name_,
+                                         LockContentionProfiler::kMutex, pc);
+      } else {
+        // Not reported to the timeline, whose recorder uses MutexLocker.
+        LockContentionProfiler::ContendedScope contended(
+            mutex_, mutex_->name_, LockContentionProfiler::kMutex, pc,
+            /*emit_timeline_event=*/false);
+        mutex_->Lock();
+      }
+      return;
+    }
+#endif
+    mutex_->Lock();
+  }
+
   DEBUG_ONLY(bool no_safepoint_scope_;)
   Mutex* const mutex_;
 
@@ -140,7 +161,7 @@ class MonitorLocker : public ValueObject {
       }
     }
 #endif
-    monitor_->Enter();
+    EnterMonitor();
   }
 
   virtual ~MonitorLocker() {
@@ -158,7 +179,7 @@ class MonitorLocker : public ValueObject {
       Thread::Current()->IncrementNoSafepointScopeDepth();
     }
 #endif
-    monitor_->Enter();
+    EnterMonitor();
   }
   void Exit() const {
     monitor_->Exit();
@@ -186,6 +207,26 @@ class MonitorLocker : public ValueObject {
   void NotifyAll() { monitor_->NotifyAll(); }
 
  private:
+  void EnterMonitor() const {
+#if !defined(PRODUCT)
+    if (UNLIKELY(LockContentionProfiler::enabled())) {
+      const uword pc = OS::GetProgramCounter();
+      if (monitor_->TryEnter()) {
+        LockContentionProfiler::Acquired(monitor_, "anonymous monitor",
+                                         LockContentionProfiler::kMonitor, pc);
+      } else {
+        // Not reported to the timeline, whose recorder uses MonitorLocker.
+        LockContentionProfiler::ContendedScope contended(
+            monitor_, "anonymous monitor", LockContentionProfiler::kMonitor,
+            pc, /*emit_timeline_event=*/false);
+        monitor_->Enter();
+      }
+      return;
+    }
+#endif
+    monitor_->Enter();
+  }
+
   Monitor* const monitor_;
   bool no_safepoint_scope_;
 
@@ -230,10 +271,17 @@ class SafepointMutexLocker : public StackResource {
  public:
   explicit SafepointMutexLocker(Mutex* mutex)
       : SafepointMutexLocker(ThreadState::Current(), mutex) {}
-  SafepointMutexLocker(ThreadState* thread, Mutex* mutex);
+  SafepointMutexLocker(ThreadState* thread, Mutex* mutex)
+      : StackResource(thread), mutex_(mutex) {
+    ASSERT(mutex != nullptr);
+    AcquireLock(NOT_IN_PRODUCT(LockContentionProfiler::CallerPc()));
+  }
   virtual ~SafepointMutexLocker() { mutex_->Unlock(); }
 
  private:
+  // [pc] identifies the caller when profiling lock contention.
+  void AcquireLock(NOT_IN_PRODUCT(uword pc));
+
   Mutex* const mutex_;
 
   DISALLOW_COPY_AND_ASSIGN(SafepointMutexLocker);
@@ -260,7 +308,7 @@ class SafepointMutexLocker : public StackResource {
 class SafepointMonitorLocker : public ValueObject {
  public:
   explicit SafepointMonitorLocker(Monitor* monitor) : monitor_(monitor) {
-    AcquireLock();
+    AcquireLock(NOT_IN_PRODUCT(LockContentionProfiler::CallerPc()));
   }
   virtual ~SafepointMonitorLocker() { ReleaseLock(); }
 
@@ -271,7 +319,8 @@ class SafepointMonitorLocker : public ValueObject {
  private:
   friend class SafepointMonitorUnlockScope;
 
-  void AcquireLock();
+  // [pc] identifies the caller when profiling lock contention.
+  void AcquireLock(NOT_IN_PRODUCT(uword pc));
   void ReleaseLock();
 
   Monitor* const monitor_;
@@ -285,7 +334,9 @@ class SafepointMonitorUnlockScope : public ValueObject {
       : locker_(locker) {
     locker_->ReleaseLock();
   }
-  ~SafepointMonitorUnlockScope() { locker_->AcquireLock(); }
+  ~SafepointMonitorUnlockScope() {
+    locker_->AcquireLock(NOT_IN_PRODUCT(LockContentionProfiler::CallerPc()));
+  }
 
  private:
   SafepointMonitorLocker* locker_;
@@ -338,7 +389,13 @@ class RwLock {
 
 class SafepointRwLock {
  public:
-  SafepointRwLock() {}
+  explicit SafepointRwLock(
+      NOT_IN_PRODUCT(const char* name = "anonymous rwlock"))
+#if !defined(PRODUCT)
+      : name_(name)
+#endif
+  {
+  }
   ~SafepointRwLock() {}
 
   DEBUG_ONLY(bool IsCurrentThreadReader());
@@ -354,11 +411,13 @@ class SafepointRwLock {
   // returns [true] if read lock was acquired,
   // returns [false] if the thread didn't have to acquire read lock due
   // to the thread already holding write lock
-  bool EnterRead();
+  //
+  // [pc] identifies the caller when profiling lock contention.
+  bool EnterRead(NOT_IN_PRODUCT(uword pc));
   bool TryEnterRead(bool can_block, bool* acquired_read_lock);
   void LeaveRead();
 
-  void EnterWrite();
+  void EnterWrite(NOT_IN_PRODUCT(uword pc));
   bool TryEnterWrite(bool can_block);
   void LeaveWrite();
 
@@ -379,6 +438,8 @@ class SafepointRwLock {
 
   DEBUG_ONLY(MallocGrowableArray<ThreadId> readers_ids_);
   ThreadId writer_id_ = OSThread::kInvalidThreadId;
+
+  NOT_IN_PRODUCT(const char* name_);
 };
 
 /*
@@ -413,7 +474,8 @@ class SafepointReadRwLocker : public StackResource {
   SafepointReadRwLocker(ThreadState* thread_state, SafepointRwLock* rw_lock)
       : StackResource(thread_state), rw_lock_(rw_lock) {
     ASSERT(rw_lock_ != nullptr);
-    if (!rw_lock_->EnterRead()) {
+    if (!rw_lock_->EnterRead(
+            NOT_IN_PRODUCT(LockContentionProfiler::CallerPc()))) {
       // if lock didn't have to be acquired, it doesn't have to be released.
       rw_lock_ = nullptr;
     }
@@ -460,7 +522,7 @@ class SafepointWriteRwLocker : public StackResource {
  public:
   SafepointWriteRwLocker(ThreadState* thread_state, SafepointRwLock* rw_lock)
       : StackResource(thread_state), rw_lock_(rw_lock) {
-    rw_lock_->EnterWrite();
+    rw_lock_->EnterWrite(NOT_IN_PRODUCT(LockContentionProfiler::CallerPc()));
   }
 
   ~SafepointWriteRwLocker() { rw_lock_->LeaveWrite(); }
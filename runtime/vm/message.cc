@@ -84,6 +84,8 @@ const char* Message::PriorityAsString(Priority priority) {
   }
 }
 
+RelaxedAtomic<intptr_t> MessageQueue::total_length_ = 0;
+
 MessageQueue::MessageQueue() {
   head_ = nullptr;
   tail_ = nullptr;
@@ -101,6 +103,9 @@ void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
 
   // Make sure messages are not reused.
   ASSERT(msg->next_ == nullptr);
+  total_length_.fetch_add(1);
+  // Keep the order with respect to messages posted before.
+  ReceiveInbox();
   if (head_ == nullptr) {
     // Only element in the queue.
     ASSERT(tail_ == nullptr);
@@ -139,7 +144,46 @@ void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
   }
 }
 
+void MessageQueue::Post(std::unique_ptr<Message> msg0) {
+  Message* msg = msg0.release();
+
+  // Make sure messages are not reused.
+  ASSERT(msg->next_ == nullptr);
+  total_length_.fetch_add(1);
+  Message* top = inbox_.load();
+  do {
+    msg->next_ = top;
+  } while (!inbox_.compare_exchange_weak(top, msg));
+}
+
+bool MessageQueue::ReceiveInbox() {
+  Message* top = inbox_.exchange(nullptr);
+  if (top == nullptr) {
+    return false;
+  }
+  // Reverse the stack into posting order.
+  Message* first = nullptr;
+  Message* last = top;
+  while (top != nullptr) {
+    Message* next = top->next_;
+    top->next_ = first;
+    first = top;
+    top = next;
+  }
+  if (head_ == nullptr) {
+    ASSERT(tail_ == nullptr);
+    head_ = first;
+  } else {
+    tail_->next_ = first;
+  }
+  tail_ = last;
+  return true;
+}
+
 std::unique_ptr<Message> MessageQueue::Dequeue() {
+  if (head_ == nullptr) {
+    ReceiveInbox();
+  }
   Message* result = head_;
   if (result != nullptr) {
     head_ = result->next_;
@@ -150,18 +194,21 @@ std::unique_ptr<Message> MessageQueue::Dequeue() {
 #if defined(DEBUG)
     result->next_ = result;  // Make sure to trigger ASSERT in Enqueue.
 #endif                       // DEBUG
+    total_length_.fetch_sub(1);
     return std::unique_ptr<Message>(result);
   }
   return nullptr;
 }
 
 void MessageQueue::Clear() {
+  ReceiveInbox();
   std::unique_ptr<Message> cur(head_);
   head_ = nullptr;
   tail_ = nullptr;
   while (cur != nullptr) {
     std::unique_ptr<Message> next(cur->next_);
     cur = std::move(next);
+    total_length_.fetch_sub(1);
   }
 }
 
@@ -199,6 +246,7 @@ intptr_t MessageQueue::Length() const {
 }
 
 Message* MessageQueue::FindMessageById(intptr_t id) {
+  ReceiveInbox();
   MessageQueue::Iterator it(this);
   while (it.HasNext()) {
     Message* current = it.Next();
@@ -216,6 +264,7 @@ void MessageQueue::PrintJSON(JSONStream* stream) {
 
   Object& msg_handler = Object::Handle();
 
+  ReceiveInbox();
   MessageQueue::Iterator it(this);
   intptr_t depth = 0;
   while (it.HasNext()) {
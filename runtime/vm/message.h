@@ -5,10 +5,12 @@
 #ifndef RUNTIME_VM_MESSAGE_H_
 #define RUNTIME_VM_MESSAGE_H_
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 #include "vm/finalizable_data.h"
 #include "vm/globals.h"
@@ -156,6 +158,9 @@ class Message {
 };
 
 // There is a message queue per isolate.
+//
+// Except for Post(), the methods of a queue must be called with the lock of
+// its owner held.
 class MessageQueue {
  public:
   MessageQueue();
@@ -163,11 +168,22 @@ class MessageQueue {
 
   void Enqueue(std::unique_ptr<Message> msg, bool before_events);
 
+  // Appends the message to the queue without taking any lock, so it can be
+  // called concurrently by any number of threads. Posted messages go to an
+  // inbox that is moved to the queue by the consumer side.
+  void Post(std::unique_ptr<Message> msg);
+
+  // Moves the posted messages to the end of the queue. Returns false if no
+  // message was posted since the previous call.
+  bool ReceiveInbox();
+
   // Gets the next message from the message queue or nullptr if no
   // message is available.  This function will not block.
   std::unique_ptr<Message> Dequeue();
 
-  bool IsEmpty() { return head_ == nullptr; }
+  bool IsEmpty() const {
+    return head_ == nullptr && inbox_.load() == nullptr;
+  }
 
   // Clear all messages from the message queue.
   void Clear();
@@ -190,8 +206,13 @@ class MessageQueue {
     Message* next_;
   };
 
+  // The length of the queue, not counting messages that have not been
+  // received from the inbox yet.
   intptr_t Length() const;
 
+  // The number of messages in all queues, including their inboxes.
+  static intptr_t TotalLength() { return total_length_.load(); }
+
   // Returns the message with id or nullptr.
   Message* FindMessageById(intptr_t id);
 
@@ -201,6 +222,11 @@ class MessageQueue {
   Message* head_;
   Message* tail_;
 
+  // Stack of the posted messages, in reverse order of posting.
+  std::atomic<Message*> inbox_ = {nullptr};
+
+  static RelaxedAtomic<intptr_t> total_length_;
+
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
 
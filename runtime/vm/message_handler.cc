@@ -18,6 +18,17 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            message_batch_size,
+            0,
+            "Maximum number of normal messages an isolate handles before "
+            "yielding its thread to other tasks. 0 means no limit. Lower "
+            "values trade message throughput for latency of other isolates.");
+DEFINE_FLAG(int,
+            message_batch_micros,
+            0,
+            "Maximum time in microseconds an isolate handles normal messages "
+            "before yielding its thread to other tasks. 0 means no limit.");
 DECLARE_FLAG(bool, trace_service_pause_events);
 
 class MessageHandlerTask : public ThreadPool::Task {
@@ -130,7 +141,21 @@ bool MessageHandler::Run(ThreadPool* pool,
 
 void MessageHandler::PostMessage(std::unique_ptr<Message> message,
                                  bool before_events) {
-  Message::Priority saved_priority;
+  const Message::Priority saved_priority = message->priority();
+
+  // Normal messages are posted to [queue_] without taking the monitor, which
+  // is only needed to wake up the handler. A running task that does not wait
+  // dequeues the message without that, or notices it in StopTaskLocked()
+  // since [task_running_without_wait_] is cleared before checking the queue.
+  const bool post =
+      !message->IsOOB() && !before_events && !FLAG_trace_isolates;
+  if (post) {
+    queue_->Post(std::move(message));
+    if (task_running_without_wait_.load()) {
+      MessageNotify(saved_priority);
+      return;
+    }
+  }
 
   {
     MonitorLocker ml(&monitor_);
@@ -155,11 +180,12 @@ void MessageHandler::PostMessage(std::unique_ptr<Message> message,
       }
     }
 
-    saved_priority = message->priority();
-    if (message->IsOOB()) {
-      oob_queue_->Enqueue(std::move(message), before_events);
-    } else {
-      queue_->Enqueue(std::move(message), before_events);
+    if (!post) {
+      if (message->IsOOB()) {
+        oob_queue_->Enqueue(std::move(message), before_events);
+      } else {
+        queue_->Enqueue(std::move(message), before_events);
+      }
     }
     if (paused_for_messages_) {
       ml.Notify();
@@ -194,7 +220,8 @@ void MessageHandler::ClearOOBQueue() {
 MessageHandler::MessageStatus MessageHandler::HandleMessages(
     MonitorLocker* ml,
     bool allow_normal_messages,
-    bool allow_multiple_normal_messages) {
+    bool allow_multiple_normal_messages,
+    bool allow_yield) {
   ASSERT(monitor_.IsOwnedByCurrentThread());
 
   // Scheduling of the mutator thread during the isolate start can cause this
@@ -211,6 +238,12 @@ MessageHandler::MessageStatus MessageHandler::HandleMessages(
   auto idle_time_handler =
       isolate() != nullptr ? isolate()->group()->idle_time_handler() : nullptr;
 
+  // The batch limits are checked after each normal message.
+  allow_yield &=
+      (FLAG_message_batch_size > 0) || (FLAG_message_batch_micros > 0);
+  const int64_t batch_start = allow_yield ? OS::GetCurrentMonotonicMicros() : 0;
+  intptr_t batch_size = 0;
+
   MessageStatus max_status = kOK;
   Message::Priority min_priority =
       ((allow_normal_messages && !paused()) ? Message::kNormalPriority
@@ -234,6 +267,10 @@ MessageHandler::MessageStatus MessageHandler::HandleMessages(
     Message::Priority saved_priority = message->priority();
     Dart_Port saved_dest_port = message->dest_port();
     MessageStatus status = kOK;
+    if ((idle_time_handler != nullptr) &&
+        (saved_priority == Message::kNormalPriority)) {
+      idle_time_handler->UpdateEndIdleTime();
+    }
     {
       DisableIdleTimerScope disable_idle_timer(idle_time_handler);
       status = HandleMessage(std::move(message));
@@ -274,6 +311,21 @@ MessageHandler::MessageStatus MessageHandler::HandleMessages(
       allow_normal_messages = false;
     }
 
+    // Leave the remaining normal messages to a new task once this one used
+    // up its batch. Handlers without live ports drain their queue to exit.
+    if (allow_yield && (saved_priority == Message::kNormalPriority) &&
+        allow_normal_messages && HasLivePorts()) {
+      batch_size++;
+      if (((FLAG_message_batch_size > 0) &&
+           (batch_size >= FLAG_message_batch_size)) ||
+          ((FLAG_message_batch_micros > 0) &&
+           (OS::GetCurrentMonotonicMicros() - batch_start >=
+            FLAG_message_batch_micros))) {
+        allow_normal_messages = false;
+        task_yielded_ = true;
+      }
+    }
+
     // Reevaluate the minimum allowable priority.  The paused state
     // may have changed as part of handling the message.  We may also
     // have encountered an error during message processing.
@@ -309,6 +361,8 @@ MessageHandler::MessageStatus MessageHandler::PauseAndHandleAllMessages(
   CheckAccess();
 #endif
   paused_for_messages_ = true;
+  // Posters have to notify the monitor from now on.
+  task_running_without_wait_.store(false);
   while (queue_->IsEmpty() && oob_queue_->IsEmpty()) {
     Monitor::WaitResult wr;
     {
@@ -328,11 +382,13 @@ MessageHandler::MessageStatus MessageHandler::PauseAndHandleAllMessages(
       MessageStatus status = HandleMessages(&ml, false, false);
       if (status != kOK) {
         paused_for_messages_ = false;
+        task_running_without_wait_.store(true);
         return status;
       }
     }
   }
   paused_for_messages_ = false;
+  task_running_without_wait_.store(true);
   return HandleMessages(&ml, true, true);
 }
 
@@ -398,6 +454,7 @@ void MessageHandler::TaskCallback() {
     // other message handler tasks will be started until this one sets
     // [task_running_] to false.
     ASSERT(task_running_);
+    task_running_without_wait_.store(true);
 
 #if !defined(PRODUCT)
     if (ShouldPauseOnStart(kOK)) {
@@ -409,7 +466,7 @@ void MessageHandler::TaskCallback() {
       if (ShouldPauseOnStart(status)) {
         // Still paused.
         ASSERT(oob_queue_->IsEmpty());
-        task_running_ = false;  // No task in queue.
+        StopTaskLocked();  // No task in queue.
         return;
       } else {
         PausedOnStartLocked(&ml, false);
@@ -420,7 +477,7 @@ void MessageHandler::TaskCallback() {
       if (ShouldPauseOnExit(status)) {
         // Still paused.
         ASSERT(oob_queue_->IsEmpty());
-        task_running_ = false;  // No task in queue.
+        StopTaskLocked();  // No task in queue.
         return;
       } else {
         PausedOnExitLocked(&ml, false);
@@ -447,7 +504,8 @@ void MessageHandler::TaskCallback() {
 
       // Handle any pending messages for this message handler.
       if (status != kShutdown) {
-        status = HandleMessages(&ml, (status == kOK), true);
+        status = HandleMessages(&ml, (status == kOK), true,
+                                /*allow_yield=*/true);
       }
     }
 
@@ -470,7 +528,7 @@ void MessageHandler::TaskCallback() {
         if (ShouldPauseOnExit(status)) {
           // Still paused.
           ASSERT(oob_queue_->IsEmpty());
-          task_running_ = false;  // No task in queue.
+          StopTaskLocked();  // No task in queue.
           return;
         } else {
           PausedOnExitLocked(&ml, false);
@@ -503,7 +561,7 @@ void MessageHandler::TaskCallback() {
     // Clear task_running_ last.  This allows other tasks to potentially start
     // for this message handler.
     ASSERT(oob_queue_->IsEmpty());
-    task_running_ = false;
+    StopTaskLocked();
   }
 
   // The handler may have been deleted by another thread here if it is a native
@@ -522,6 +580,24 @@ void MessageHandler::TaskCallback() {
   }
 }
 
+void MessageHandler::StopTaskLocked() {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  ASSERT(task_running_);
+  // Messages posted after this store see it and launch a task themselves.
+  task_running_without_wait_.store(false);
+  const bool yielded = task_yielded_;
+  task_yielded_ = false;
+  if ((queue_->ReceiveInbox() || yielded) && (pool_ != nullptr) &&
+      !delete_me_) {
+    // Some messages were posted in between without launching a task, or are
+    // left by this task for the next one.
+    const bool launched_successfully = pool_->Run<MessageHandlerTask>(this);
+    ASSERT(launched_successfully);
+    return;
+  }
+  task_running_ = false;
+}
+
 void MessageHandler::ClosePort(Dart_Port port) {
   MonitorLocker ml(&monitor_);
   if (FLAG_trace_isolates) {
@@ -650,6 +726,7 @@ MessageHandler::AcquiredQueues::AcquiredQueues(MessageHandler* handler)
     : handler_(handler), ml_(&handler->monitor_) {
   ASSERT(handler != nullptr);
   handler_->oob_message_handling_allowed_ = false;
+  handler_->queue_->ReceiveInbox();
 }
 
 MessageHandler::AcquiredQueues::~AcquiredQueues() {
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_MESSAGE_HANDLER_H_
 #define RUNTIME_VM_MESSAGE_HANDLER_H_
 
+#include <atomic>
 #include <memory>
 
 #include "vm/isolate.h"
@@ -243,10 +244,20 @@ class MessageHandler {
 
   void ClearOOBQueue();
 
+  // Clears [task_running_] once the task of this handler is done. Launches a
+  // new task if messages were posted while [task_running_without_wait_] was
+  // still set, as their posters did not, or if the task yielded.
+  void StopTaskLocked();
+
   // Handles any pending messages.
+  //
+  // With [allow_yield], stops handling normal messages once the batch
+  // limits given by --message_batch_size and --message_batch_micros are
+  // reached, so that the remaining messages are handled by a new task.
   MessageStatus HandleMessages(MonitorLocker* ml,
                                bool allow_normal_messages,
-                               bool allow_multiple_normal_messages);
+                               bool allow_multiple_normal_messages,
+                               bool allow_yield = false);
 
   Monitor monitor_;  // Protects all fields in MessageHandler.
   MessageQueue* queue_;
@@ -270,6 +281,13 @@ class MessageHandler {
   int64_t paused_timestamp_;
 #endif
   bool task_running_;
+  // Whether a task is running and not waiting for messages, so that it will
+  // dequeue any message posted to [queue_] without being woken up. Only
+  // written with [monitor_] held, but read by posters without it.
+  std::atomic<bool> task_running_without_wait_ = {false};
+  // Whether the running task stopped handling messages because it reached
+  // the batch limits.
+  bool task_yielded_ = false;
   bool delete_me_;
   ThreadPool* pool_;
   StartCallback start_callback_;
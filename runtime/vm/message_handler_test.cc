@@ -10,6 +10,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, message_batch_size);
+
 class MessageHandlerTestPeer {
  public:
   explicit MessageHandlerTestPeer(MessageHandler* handler)
@@ -409,4 +411,39 @@ VM_UNIT_TEST_CASE(MessageHandler_Run) {
   OSThread::Join(info.join_id);
 }
 
+VM_UNIT_TEST_CASE(MessageHandler_RunYieldsAfterBatch) {
+  const int saved_batch_size = FLAG_message_batch_size;
+  FLAG_message_batch_size = 3;
+
+  TestMessageHandler handler;
+  ThreadPool pool;
+  MessageHandlerTestPeer handler_peer(&handler);
+  handler_peer.increment_live_ports();
+
+  // Queue the messages before the first task starts, so that it has to
+  // leave most of them to the tasks it launches when yielding.
+  Dart_Port ports[10];
+  for (int i = 0; i < 10; i++) {
+    ports[i] = PortMap::CreatePort(&handler);
+    handler_peer.PostMessage(BlankMessage(ports[i], Message::kNormalPriority));
+  }
+  handler.Run(&pool, TestStartFunction, TestEndFunction,
+              reinterpret_cast<uword>(&handler));
+
+  {
+    MonitorLocker ml(handler.monitor());
+    while (handler.message_count() < 10) {
+      ml.Wait();
+    }
+    Dart_Port* handler_ports = handler.port_buffer();
+    EXPECT_EQ(10, handler.message_count());
+    EXPECT(!handler.end_called());
+    for (int i = 0; i < 10; i++) {
+      EXPECT_EQ(ports[i], handler_ports[i]);
+    }
+    handler_peer.decrement_live_ports();
+  }
+  FLAG_message_batch_size = saved_batch_size;
+}
+
 }  // namespace dart
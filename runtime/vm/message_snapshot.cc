@@ -3509,6 +3509,11 @@ std::unique_ptr<Message> WriteApiMessage(Zone* zone,
                                          Dart_CObject* obj,
                                          Dart_Port dest_port,
                                          Message::Priority priority) {
+  const ObjectPtr raw_obj = ApiObjectConverter::TryConvert(obj);
+  if (raw_obj != nullptr) {
+    return Message::New(dest_port, raw_obj, priority);
+  }
+
   ApiMessageSerializer serializer(zone);
   if (!serializer.Serialize(obj)) {
     return nullptr;
@@ -118,6 +118,49 @@ TEST_CASE(MessageQueue_BasicOperations) {
   EXPECT(queue.IsEmpty());
 }
 
+TEST_CASE(MessageQueue_Post) {
+  MessageQueue queue;
+  Dart_Port port = 1;
+
+  const char* str1 = "msg1";
+  const char* str2 = "msg2";
+  const char* str3 = "msg3";
+  const char* str4 = "msg4";
+
+  // Posted messages keep their order.
+  std::unique_ptr<Message> msg =
+      Message::New(port, AllocMsg(str1), strlen(str1) + 1, nullptr,
+                   Message::kNormalPriority);
+  queue.Post(std::move(msg));
+  EXPECT(!queue.IsEmpty());
+  msg = Message::New(port, AllocMsg(str2), strlen(str2) + 1, nullptr,
+                     Message::kNormalPriority);
+  queue.Post(std::move(msg));
+
+  // Enqueued messages go after the posted ones.
+  msg = Message::New(port, AllocMsg(str3), strlen(str3) + 1, nullptr,
+                     Message::kNormalPriority);
+  queue.Enqueue(std::move(msg), false);
+  msg = Message::New(port, AllocMsg(str4), strlen(str4) + 1, nullptr,
+                     Message::kNormalPriority);
+  queue.Post(std::move(msg));
+  EXPECT(queue.Length() == 3);
+  EXPECT(queue.ReceiveInbox());
+  EXPECT(!queue.ReceiveInbox());
+  EXPECT(queue.Length() == 4);
+
+  msg = queue.Dequeue();
+  EXPECT_STREQ(str1, reinterpret_cast<char*>(msg->snapshot()));
+  msg = queue.Dequeue();
+  EXPECT_STREQ(str2, reinterpret_cast<char*>(msg->snapshot()));
+  msg = queue.Dequeue();
+  EXPECT_STREQ(str3, reinterpret_cast<char*>(msg->snapshot()));
+  msg = queue.Dequeue();
+  EXPECT_STREQ(str4, reinterpret_cast<char*>(msg->snapshot()));
+  EXPECT(queue.IsEmpty());
+  EXPECT(queue.Dequeue() == nullptr);
+}
+
 TEST_CASE(MessageQueue_Clear) {
   MessageQueue queue;
   Dart_Port port1 = 1;
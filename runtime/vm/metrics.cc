@@ -10,6 +10,7 @@
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/runtime_entry.h"
+#include "vm/virtual_memory.h"
 
 namespace dart {
 
@@ -177,6 +178,87 @@ int64_t MetricHeapUsed::Value() const {
          isolate_group()->heap()->UsedInWords(Heap::kOld) * kWordSize;
 }
 
+int64_t MetricHeapOldAllocated::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  return isolate_group()->heap()->AllocatedInWords(Heap::kOld) * kWordSize;
+}
+
+int64_t MetricHeapNewAllocated::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  return isolate_group()->heap()->AllocatedInWords(Heap::kNew) * kWordSize;
+}
+
+int64_t MetricGCPause::ValueFor(GCPauseKind kind, intptr_t percentile) const {
+  LatencyHistogram* histogram = isolate_group()->heap()->pause_histogram(kind);
+  if (percentile >= 100) {
+    return histogram->max();
+  }
+  return histogram->Percentile(percentile);
+}
+
+intptr_t LatencyHistogram::BucketFor(int64_t value) {
+  if (value < 0) {
+    value = 0;
+  }
+  const int64_t kMaxValue = (static_cast<int64_t>(1) << kMaxValueBits) - 1;
+  if (value > kMaxValue) {
+    value = kMaxValue;
+  }
+  if (value < kSubBuckets) {
+    return static_cast<intptr_t>(value);
+  }
+  // Each power of two above kSubBuckets is split into kSubBuckets linear
+  // sub-buckets, bounding the relative error to 1/kSubBuckets.
+  const intptr_t msb = Utils::HighestBit(value);
+  const intptr_t shift = msb - kSubBucketBits;
+  const intptr_t sub = (value >> shift) & (kSubBuckets - 1);
+  return (msb - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+int64_t LatencyHistogram::BucketUpperBound(intptr_t bucket) {
+  ASSERT(bucket >= 0 && bucket < kNumBuckets);
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+  const intptr_t msb = bucket / kSubBuckets + kSubBucketBits - 1;
+  const intptr_t shift = msb - kSubBucketBits;
+  const int64_t lower = static_cast<int64_t>(kSubBuckets + bucket % kSubBuckets)
+                        << shift;
+  return lower + (static_cast<int64_t>(1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(int64_t value) {
+  if (value < 0) {
+    value = 0;
+  }
+  buckets_[BucketFor(value)].fetch_add(1);
+  count_.fetch_add(1);
+  int64_t old_max = max_.load();
+  while (value > old_max && !max_.compare_exchange_weak(old_max, value)) {
+  }
+}
+
+int64_t LatencyHistogram::Percentile(double percentile) const {
+  const int64_t count = count_.load();
+  if (count == 0) {
+    return 0;
+  }
+  int64_t rank = static_cast<int64_t>(count * percentile / 100.0 + 0.999999);
+  rank = Utils::Maximum<int64_t>(1, Utils::Minimum(rank, count));
+  int64_t seen = 0;
+  for (intptr_t i = 0; i < kNumBuckets; i++) {
+    seen += buckets_[i].load();
+    if (seen >= rank) {
+      return Utils::Minimum(BucketUpperBound(i), max_.load());
+    }
+  }
+  return max_.load();
+}
+
+int64_t MetricHeapHugePages::Value() const {
+  return VirtualMemory::HugePageBackedBytes();
+}
+
 #if !defined(PRODUCT)
 int64_t MetricIsolateCount::Value() const {
   return Isolate::IsolateListLength();
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_METRICS_H_
 #define RUNTIME_VM_METRICS_H_
 
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 
 namespace dart {
@@ -32,7 +33,37 @@ class JSONStream;
   V(MetricHeapOldExternal, HeapOldExternal, "heap.old.external", kByte)        \
   V(MetricHeapNewUsed, HeapNewUsed, "heap.new.used", kByte)                    \
   V(MetricHeapNewCapacity, HeapNewCapacity, "heap.new.capacity", kByte)        \
-  V(MetricHeapNewExternal, HeapNewExternal, "heap.new.external", kByte)
+  V(MetricHeapNewExternal, HeapNewExternal, "heap.new.external", kByte)        \
+  V(MetricHeapOldAllocated, HeapOldAllocated, "heap.old.allocated", kByte)     \
+  V(MetricHeapNewAllocated, HeapNewAllocated, "heap.new.allocated", kByte)     \
+  GC_PAUSE_METRIC_LIST(V)
+
+// Percentiles of the pause histograms, see LatencyHistogram.
+#define GC_PAUSE_METRIC_LIST(V)                                                \
+  V(MetricScavengePauseP50, ScavengePauseP50, "gc.scavenge.pause.p50",         \
+    kMicrosecond)                                                              \
+  V(MetricScavengePauseP99, ScavengePauseP99, "gc.scavenge.pause.p99",         \
+    kMicrosecond)                                                              \
+  V(MetricScavengePauseMax, ScavengePauseMax, "gc.scavenge.pause.max",         \
+    kMicrosecond)                                                              \
+  V(MetricMarkPauseP50, MarkPauseP50, "gc.mark.pause.p50", kMicrosecond)       \
+  V(MetricMarkPauseP99, MarkPauseP99, "gc.mark.pause.p99", kMicrosecond)       \
+  V(MetricMarkPauseMax, MarkPauseMax, "gc.mark.pause.max", kMicrosecond)       \
+  V(MetricCompactPauseP50, CompactPauseP50, "gc.compact.pause.p50",            \
+    kMicrosecond)                                                              \
+  V(MetricCompactPauseP99, CompactPauseP99, "gc.compact.pause.p99",            \
+    kMicrosecond)                                                              \
+  V(MetricCompactPauseMax, CompactPauseMax, "gc.compact.pause.max",            \
+    kMicrosecond)                                                              \
+  V(MetricSweepPauseP50, SweepPauseP50, "gc.sweep.pause.p50", kMicrosecond)    \
+  V(MetricSweepPauseP99, SweepPauseP99, "gc.sweep.pause.p99", kMicrosecond)    \
+  V(MetricSweepPauseMax, SweepPauseMax, "gc.sweep.pause.max", kMicrosecond)    \
+  V(MetricSafepointPauseP50, SafepointPauseP50, "gc.safepoint.pause.p50",      \
+    kMicrosecond)                                                              \
+  V(MetricSafepointPauseP99, SafepointPauseP99, "gc.safepoint.pause.p99",      \
+    kMicrosecond)                                                              \
+  V(MetricSafepointPauseMax, SafepointPauseMax, "gc.safepoint.pause.max",      \
+    kMicrosecond)
 
 #define ISOLATE_GROUP_METRIC_LIST(V)                                           \
   DART_API_ISOLATE_GROUP_METRIC_LIST(V)                                        \
@@ -41,7 +72,8 @@ class JSONStream;
   V(MaxMetric, HeapNewUsedMax, "heap.new.used.max", kByte)                     \
   V(MaxMetric, HeapNewCapacityMax, "heap.new.capacity.max", kByte)             \
   V(MetricHeapUsed, HeapGlobalUsed, "heap.global.used", kByte)                 \
-  V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)
+  V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)               \
+  V(MetricHeapHugePages, HeapHugePages, "heap.hugepages", kByte)
 
 // Metrics for each isolate.
 //
@@ -50,6 +82,41 @@ class JSONStream;
   V(Metric, RunnableLatency, "isolate.runnable.latency", kMicrosecond)         \
   V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)
 
+// A thread-safe histogram of durations or sizes with log-linear buckets, so
+// that each recorded value is reported with a relative error of at most
+// 1/kSubBuckets while a few hundred counters cover the whole range. Recording
+// is a single relaxed increment, cheap enough to do on every GC pause.
+class LatencyHistogram {
+ public:
+  static constexpr intptr_t kSubBucketBits = 3;
+  static constexpr intptr_t kSubBuckets = 1 << kSubBucketBits;
+  // Larger values are recorded as the largest representable one.
+  static constexpr intptr_t kMaxValueBits = 40;
+  static constexpr intptr_t kNumBuckets =
+      (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets;
+
+  LatencyHistogram() {}
+
+  void Record(int64_t value);
+
+  int64_t count() const { return count_.load(); }
+  int64_t max() const { return max_.load(); }
+
+  // Returns the upper bound of the bucket holding the value ranked at
+  // [percentile] (0-100), or 0 if nothing was recorded.
+  int64_t Percentile(double percentile) const;
+
+  static intptr_t BucketFor(int64_t value);
+  static int64_t BucketUpperBound(intptr_t bucket);
+
+ private:
+  RelaxedAtomic<int64_t> buckets_[kNumBuckets] = {};
+  RelaxedAtomic<int64_t> count_ = 0;
+  RelaxedAtomic<int64_t> max_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyHistogram);
+};
+
 class Metric {
  public:
   enum Unit {
@@ -195,6 +262,63 @@ class MetricHeapUsed : public Metric {
   virtual int64_t Value() const;
 };
 
+class MetricHeapHugePages : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+// Bytes allocated since the isolate group started; sample twice for a rate.
+class MetricHeapOldAllocated : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+class MetricHeapNewAllocated : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+enum class GCPauseKind {
+  kScavenge,
+  kMark,
+  kCompact,
+  // Time a mutator waited for the concurrent sweeper to finish.
+  kSweep,
+  kSafepoint,
+};
+static constexpr intptr_t kNumGCPauseKinds =
+    static_cast<intptr_t>(GCPauseKind::kSafepoint) + 1;
+
+class MetricGCPause : public Metric {
+ protected:
+  // [percentile] of 100 reports the maximum.
+  int64_t ValueFor(GCPauseKind kind, intptr_t percentile) const;
+};
+
+#define DEFINE_GC_PAUSE_METRIC(Name, kind, percentile)                         \
+  class Metric##Name : public MetricGCPause {                                  \
+   public:                                                                     \
+    virtual int64_t Value() const {                                            \
+      return ValueFor(GCPauseKind::kind, percentile);                          \
+    }                                                                          \
+  };
+DEFINE_GC_PAUSE_METRIC(ScavengePauseP50, kScavenge, 50)
+DEFINE_GC_PAUSE_METRIC(ScavengePauseP99, kScavenge, 99)
+DEFINE_GC_PAUSE_METRIC(ScavengePauseMax, kScavenge, 100)
+DEFINE_GC_PAUSE_METRIC(MarkPauseP50, kMark, 50)
+DEFINE_GC_PAUSE_METRIC(MarkPauseP99, kMark, 99)
+DEFINE_GC_PAUSE_METRIC(MarkPauseMax, kMark, 100)
+DEFINE_GC_PAUSE_METRIC(CompactPauseP50, kCompact, 50)
+DEFINE_GC_PAUSE_METRIC(CompactPauseP99, kCompact, 99)
+DEFINE_GC_PAUSE_METRIC(CompactPauseMax, kCompact, 100)
+DEFINE_GC_PAUSE_METRIC(SweepPauseP50, kSweep, 50)
+DEFINE_GC_PAUSE_METRIC(SweepPauseP99, kSweep, 99)
+DEFINE_GC_PAUSE_METRIC(SweepPauseMax, kSweep, 100)
+DEFINE_GC_PAUSE_METRIC(SafepointPauseP50, kSafepoint, 50)
+DEFINE_GC_PAUSE_METRIC(SafepointPauseP99, kSafepoint, 99)
+DEFINE_GC_PAUSE_METRIC(SafepointPauseMax, kSafepoint, 100)
+#undef DEFINE_GC_PAUSE_METRIC
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_METRICS_H_
@@ -0,0 +1,169 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/metrics_page.h"
+
+#include <atomic>
+
+#include "platform/utils.h"
+#include "vm/dart.h"
+#include "vm/heap/heap.h"
+#include "vm/heap/pages.h"
+#include "vm/heap/scavenger.h"
+#include "vm/isolate.h"
+#include "vm/message.h"
+#include "vm/os.h"
+#include "vm/thread_pool.h"
+
+namespace dart {
+
+Monitor* MetricsPage::monitor_ = nullptr;
+Dart_MetricsPage* MetricsPage::page_ = nullptr;
+int64_t MetricsPage::period_micros_ = 0;
+bool MetricsPage::thread_running_ = false;
+bool MetricsPage::shutdown_ = false;
+ThreadJoinId MetricsPage::thread_id_ = OSThread::kInvalidThreadJoinId;
+RelaxedAtomic<int64_t> MetricsPage::functions_compiled_ = 0;
+RelaxedAtomic<int64_t> MetricsPage::functions_optimized_ = 0;
+
+void MetricsPage::Init() {
+  if (monitor_ == nullptr) {
+    monitor_ = new Monitor();
+  }
+  page_ = nullptr;
+  shutdown_ = false;
+}
+
+void MetricsPage::Cleanup() {
+  {
+    MonitorLocker ml(monitor_);
+    if (!thread_running_) {
+      page_ = nullptr;
+      return;
+    }
+    page_ = nullptr;
+    shutdown_ = true;
+    ml.Notify();
+  }
+  OSThread::Join(thread_id_);
+  thread_id_ = OSThread::kInvalidThreadJoinId;
+  thread_running_ = false;
+}
+
+char* MetricsPage::SetPage(Dart_MetricsPage* page, int64_t period_micros) {
+  if (page != nullptr && period_micros <= 0) {
+    return Utils::StrDup("Dart_SetMetricsPage expects a positive period.");
+  }
+  MonitorLocker ml(monitor_);
+  if (shutdown_) {
+    return Utils::StrDup("VM is shutting down.");
+  }
+  page_ = page;
+  period_micros_ = period_micros;
+  if (page == nullptr) {
+    // The updater waits until it gets a new page.
+    return nullptr;
+  }
+  page->version = DART_METRICS_PAGE_VERSION;
+  page->size = sizeof(Dart_MetricsPage);
+  page->sequence = 0;
+  Update(page);
+  if (!thread_running_) {
+    const int result =
+        OSThread::Start("Dart Metrics Page", ThreadMain, /*parameter=*/0);
+    if (result != 0) {
+      page_ = nullptr;
+      return OS::SCreate(nullptr, "Could not start the metrics thread: %d",
+                         result);
+    }
+    while (!thread_running_) {
+      ml.Wait();
+    }
+  } else {
+    ml.Notify();
+  }
+  return nullptr;
+}
+
+void MetricsPage::ThreadMain(uword parameter) {
+  MonitorLocker ml(monitor_);
+  thread_id_ = OSThread::GetCurrentThreadJoinId(OSThread::Current());
+  thread_running_ = true;
+  ml.NotifyAll();
+  while (!shutdown_) {
+    if (page_ == nullptr) {
+      ml.Wait();
+    } else {
+      ml.WaitMicros(period_micros_);
+    }
+    // Updating under the monitor ensures the page is no longer written to
+    // once Dart_SetMetricsPage returns.
+    if (!shutdown_ && page_ != nullptr) {
+      Update(page_);
+    }
+  }
+}
+
+static void MaxPause(Heap* heap,
+                     GCPauseKind kind,
+                     int64_t* p99,
+                     int64_t* max) {
+  LatencyHistogram* histogram = heap->pause_histogram(kind);
+  *p99 = Utils::Maximum(*p99, histogram->Percentile(99));
+  *max = Utils::Maximum(*max, histogram->max());
+}
+
+void MetricsPage::Update(Dart_MetricsPage* page) {
+  Dart_MetricsPage values = {};
+  IsolateGroup::ForEach([&](IsolateGroup* group) {
+    Heap* heap = group->heap();
+    if (heap == nullptr) {
+      return;
+    }
+    values.isolate_groups++;
+    group->ForEachIsolate([&](Isolate* isolate) { values.isolates++; });
+    values.heap_new_used += heap->UsedInWords(Heap::kNew) * kWordSize;
+    values.heap_new_capacity += heap->CapacityInWords(Heap::kNew) * kWordSize;
+    values.heap_new_external += heap->ExternalInWords(Heap::kNew) * kWordSize;
+    values.heap_old_used += heap->UsedInWords(Heap::kOld) * kWordSize;
+    values.heap_old_capacity += heap->CapacityInWords(Heap::kOld) * kWordSize;
+    values.heap_old_external += heap->ExternalInWords(Heap::kOld) * kWordSize;
+    values.scavenges += heap->new_space()->collections();
+    values.old_collections += heap->old_space()->collections();
+    MaxPause(heap, GCPauseKind::kScavenge, &values.scavenge_pause_p99,
+             &values.scavenge_pause_max);
+    MaxPause(heap, GCPauseKind::kMark, &values.mark_pause_p99,
+             &values.mark_pause_max);
+    MaxPause(heap, GCPauseKind::kCompact, &values.compact_pause_p99,
+             &values.compact_pause_max);
+    MaxPause(heap, GCPauseKind::kSweep, &values.sweep_pause_p99,
+             &values.sweep_pause_max);
+    MaxPause(heap, GCPauseKind::kSafepoint, &values.safepoint_pause_p99,
+             &values.safepoint_pause_max);
+  });
+  values.functions_compiled = functions_compiled_.load();
+  values.functions_optimized = functions_optimized_.load();
+  ThreadPool* pool = Dart::thread_pool();
+  if (pool != nullptr) {
+    values.thread_pool_workers =
+        pool->workers_started() - pool->workers_stopped();
+    values.thread_pool_idle_workers = pool->idle_workers();
+    values.thread_pool_pending_tasks = pool->pending_tasks();
+  }
+  values.queued_messages = MessageQueue::TotalLength();
+  values.timestamp_micros = OS::GetCurrentMonotonicMicros();
+
+  // Readers retry while the sequence is odd or changes under them.
+  const uint64_t sequence = page->sequence;
+  page->sequence = sequence + 1;
+  std::atomic_thread_fence(std::memory_order_release);
+  values.version = page->version;
+  values.size = page->size;
+  values.sequence = sequence + 1;
+  *page = values;
+  std::atomic_thread_fence(std::memory_order_release);
+  page->sequence = sequence + 2;
+}
+
+}  // namespace dart
@@ -0,0 +1,56 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_METRICS_PAGE_H_
+#define RUNTIME_VM_METRICS_PAGE_H_
+
+#include "include/dart_tools_api.h"
+#include "platform/atomic.h"
+#include "vm/allocation.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+class Monitor;
+
+// Periodically copies process-wide counters into a Dart_MetricsPage owned by
+// the embedder (see Dart_SetMetricsPage). The updates are done by a
+// dedicated thread that is not attached to any isolate group, so they
+// neither allocate in a Dart heap nor need a safepoint.
+class MetricsPage : public AllStatic {
+ public:
+  static void Init();
+  static void Cleanup();
+
+  // Starts updating [page] every [period_micros], or stops the updates if
+  // [page] is nullptr. Returns an error message or nullptr.
+  static char* SetPage(Dart_MetricsPage* page, int64_t period_micros);
+
+  // Counts the functions compiled by the JIT.
+  static void RecordCompilation(bool optimized) {
+    if (optimized) {
+      functions_optimized_.fetch_add(1);
+    } else {
+      functions_compiled_.fetch_add(1);
+    }
+  }
+
+ private:
+  static void ThreadMain(uword parameter);
+  static void Update(Dart_MetricsPage* page);
+
+  static Monitor* monitor_;
+  static Dart_MetricsPage* page_;
+  static int64_t period_micros_;
+  static bool thread_running_;
+  static bool shutdown_;
+  static ThreadJoinId thread_id_;
+
+  static RelaxedAtomic<int64_t> functions_compiled_;
+  static RelaxedAtomic<int64_t> functions_optimized_;
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_METRICS_PAGE_H_
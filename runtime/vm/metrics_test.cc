@@ -102,6 +102,8 @@ ISOLATE_UNIT_TEST_CASE(Metric_EmbedderAPI) {
   EXPECT(thread->isolate_group()->GetHeapNewCapacityMaxMetric()->Value() > 0);
   EXPECT(thread->isolate_group()->GetHeapGlobalUsedMetric()->Value() > 0);
   EXPECT(thread->isolate_group()->GetHeapGlobalUsedMaxMetric()->Value() > 0);
+  // Depends on the kernel's THP configuration, so may legitimately be zero.
+  EXPECT(thread->isolate_group()->GetHeapHugePagesMetric()->Value() >= 0);
 
   {
     TransitionVMToNative transition(thread);
@@ -111,7 +113,97 @@ ISOLATE_UNIT_TEST_CASE(Metric_EmbedderAPI) {
     EXPECT(Dart_IsolateGroupHeapOldCapacityMetric(isolate_group) > 0);
     EXPECT(Dart_IsolateGroupHeapNewUsedMetric(isolate_group) > 0);
     EXPECT(Dart_IsolateGroupHeapNewCapacityMetric(isolate_group) > 0);
+    EXPECT(Dart_IsolateGroupHeapNewAllocatedMetric(isolate_group) > 0);
+    EXPECT(Dart_IsolateGroupScavengePauseMaxMetric(isolate_group) >= 0);
+
+    // The scavenges above released the TLABs of this isolate.
+    Dart_Isolate isolate = Dart_CurrentIsolate();
+    EXPECT(Dart_IsolateAllocatedMetric(isolate) > 0);
+    EXPECT(Dart_IsolateCPUTimeMetric(isolate) >= 0);
+  }
+
+  Heap* heap = thread->heap();
+  EXPECT(heap->pause_histogram(GCPauseKind::kScavenge)->count() > 0);
+  EXPECT(heap->pause_histogram(GCPauseKind::kMark)->count() > 0);
+}
+
+VM_UNIT_TEST_CASE(MetricsPage_Update) {
+  TestCase::CreateTestIsolate();
+  {
+    Thread* thread = Thread::Current();
+    TransitionVMToNative transition(thread);
+
+    Dart_MetricsPage page;
+    EXPECT(Dart_SetMetricsPage(&page, 0) != nullptr);
+    char* error = Dart_SetMetricsPage(&page, 1000);
+    EXPECT(error == nullptr);
+    free(error);
+
+    // The page is filled in before Dart_SetMetricsPage returns.
+    EXPECT_EQ(DART_METRICS_PAGE_VERSION, page.version);
+    EXPECT_EQ(static_cast<int32_t>(sizeof(Dart_MetricsPage)), page.size);
+    EXPECT(page.sequence >= 2);
+    EXPECT(page.isolate_groups >= 1);
+    EXPECT(page.isolates >= 1);
+    EXPECT(page.heap_old_used > 0);
+    EXPECT(page.heap_new_capacity > 0);
+    EXPECT(page.thread_pool_workers >= 0);
+    EXPECT(page.queued_messages >= 0);
+
+    // The updates continue in the background.
+    while (page.sequence < 6) {
+      OS::Sleep(1);
+    }
+
+    error = Dart_SetMetricsPage(nullptr, 0);
+    EXPECT(error == nullptr);
+    free(error);
+    const uint64_t stopped = page.sequence;
+    EXPECT_EQ(0u, stopped % 2);
+    OS::Sleep(5);
+    EXPECT_EQ(stopped, page.sequence);
+  }
+  Dart_ShutdownIsolate();
+}
+
+VM_UNIT_TEST_CASE(LatencyHistogram_Buckets) {
+  // Small values are recorded exactly.
+  for (intptr_t i = 0; i < LatencyHistogram::kSubBuckets; i++) {
+    EXPECT_EQ(i, LatencyHistogram::BucketFor(i));
+    EXPECT_EQ(i, LatencyHistogram::BucketUpperBound(i));
+  }
+  // Every value lands in a bucket whose bound is within 1/8th above it.
+  for (int64_t v = 1; v < (static_cast<int64_t>(1) << 30); v = v * 3 + 1) {
+    const intptr_t bucket = LatencyHistogram::BucketFor(v);
+    EXPECT_LT(bucket, LatencyHistogram::kNumBuckets);
+    const int64_t bound = LatencyHistogram::BucketUpperBound(bucket);
+    EXPECT_LE(v, bound);
+    EXPECT_LE(bound - v, v / LatencyHistogram::kSubBuckets);
+    if (bucket > 0) {
+      EXPECT_LT(LatencyHistogram::BucketUpperBound(bucket - 1), v);
+    }
+  }
+  EXPECT_EQ(LatencyHistogram::kNumBuckets - 1,
+            LatencyHistogram::BucketFor(kMaxInt64));
+  EXPECT_EQ(0, LatencyHistogram::BucketFor(-5));
+}
+
+VM_UNIT_TEST_CASE(LatencyHistogram_Percentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.Percentile(50));
+  for (intptr_t i = 1; i <= 100; i++) {
+    histogram.Record(i);
   }
+  histogram.Record(100000);
+  EXPECT_EQ(101, histogram.count());
+  EXPECT_EQ(100000, histogram.max());
+  const int64_t p50 = histogram.Percentile(50);
+  EXPECT_LE(51, p50);
+  EXPECT_LE(p50, 51 + 51 / 8);
+  const int64_t p99 = histogram.Percentile(99);
+  EXPECT_LE(100, p99);
+  EXPECT_LE(p99, 100 + 100 / 8);
+  EXPECT_EQ(100000, histogram.Percentile(100));
 }
 
 }  // namespace dart
@@ -71,6 +71,11 @@ DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message) {
   return PostCObjectHelper(port_id, &cobj);
 }
 
+DART_EXPORT bool Dart_IsSafepointRequested() {
+  Thread* thread = Thread::Current();
+  return thread != nullptr && thread->IsSafepointRequested();
+}
+
 DART_EXPORT Dart_Port Dart_NewNativePort(const char* name,
                                          Dart_NativeMessageHandler handler,
                                          bool handle_concurrently) {
@@ -88,7 +93,8 @@ DART_EXPORT Dart_Port Dart_NewNativePort(const char* name,
   // Start the native port without a current isolate.
   IsolateLeaveScope saver(Isolate::Current());
 
-  NativeMessageHandler* nmh = new NativeMessageHandler(name, handler);
+  NativeMessageHandler* nmh =
+      new NativeMessageHandler(name, handler, handle_concurrently);
   Dart_Port port_id = PortMap::CreatePort(nmh);
   if (port_id != ILLEGAL_PORT) {
     PortMap::SetPortState(port_id, PortMap::kLivePort);
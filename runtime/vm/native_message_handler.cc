@@ -6,17 +6,22 @@
 
 #include <memory>
 
+#include "vm/dart.h"
 #include "vm/dart_api_message.h"
 #include "vm/isolate.h"
 #include "vm/message.h"
 #include "vm/message_snapshot.h"
 #include "vm/snapshot.h"
+#include "vm/thread_pool.h"
 
 namespace dart {
 
 NativeMessageHandler::NativeMessageHandler(const char* name,
-                                           Dart_NativeMessageHandler func)
-    : name_(Utils::StrDup(name)), func_(func) {}
+                                           Dart_NativeMessageHandler func,
+                                           bool handle_concurrently)
+    : name_(Utils::StrDup(name)),
+      func_(func),
+      handle_concurrently_(handle_concurrently) {}
 
 NativeMessageHandler::~NativeMessageHandler() {
   free(name_);
@@ -28,18 +33,46 @@ void NativeMessageHandler::CheckAccess() {
 }
 #endif
 
+static void InvokeNativeMessageHandler(Dart_NativeMessageHandler func,
+                                       Message* message) {
+  // We create a native scope for handling the message.
+  // All allocation of objects for decoding the message is done in the
+  // zone associated with this scope.
+  ApiNativeScope scope;
+  Dart_CObject* object = ReadApiMessage(scope.zone(), message);
+  (*func)(message->dest_port(), object);
+}
+
+// Handles one message of a concurrent native port. The task doesn't refer to
+// the handler, which is deleted once the port is closed.
+class NativeMessageTask : public ThreadPool::Task {
+ public:
+  NativeMessageTask(Dart_NativeMessageHandler func,
+                    std::unique_ptr<Message> message)
+      : func_(func), message_(std::move(message)) {}
+
+  void Run() override { InvokeNativeMessageHandler(func_, message_.get()); }
+
+ private:
+  Dart_NativeMessageHandler func_;
+  std::unique_ptr<Message> message_;
+
+  DISALLOW_COPY_AND_ASSIGN(NativeMessageTask);
+};
+
 MessageHandler::MessageStatus NativeMessageHandler::HandleMessage(
     std::unique_ptr<Message> message) {
   if (message->IsOOB()) {
     // We currently do not use OOB messages for native ports.
     UNREACHABLE();
   }
-  // We create a native scope for handling the message.
-  // All allocation of objects for decoding the message is done in the
-  // zone associated with this scope.
-  ApiNativeScope scope;
-  Dart_CObject* object = ReadApiMessage(scope.zone(), message.get());
-  (*func())(message->dest_port(), object);
+  if (handle_concurrently_) {
+    // This only fails once the VM shuts down, in which case the message is
+    // dropped like messages to closed ports.
+    Dart::thread_pool()->Run<NativeMessageTask>(func_, std::move(message));
+    return kOK;
+  }
+  InvokeNativeMessageHandler(func_, message.get());
   return kOK;
 }
 
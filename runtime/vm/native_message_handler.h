@@ -13,13 +13,20 @@ namespace dart {
 
 // A NativeMessageHandler accepts messages and dispatches them to
 // native C handlers.
+//
+// If the handler can handle messages concurrently, each message is handed
+// to its own thread pool task, so a slow message doesn't hold up the
+// following ones. Otherwise messages are handled one at a time.
 class NativeMessageHandler : public MessageHandler {
  public:
-  NativeMessageHandler(const char* name, Dart_NativeMessageHandler func);
+  NativeMessageHandler(const char* name,
+                       Dart_NativeMessageHandler func,
+                       bool handle_concurrently);
   ~NativeMessageHandler();
 
   const char* name() const { return name_; }
   Dart_NativeMessageHandler func() const { return func_; }
+  bool handle_concurrently() const { return handle_concurrently_; }
 
   MessageStatus HandleMessage(std::unique_ptr<Message> message);
 
@@ -34,6 +41,7 @@ class NativeMessageHandler : public MessageHandler {
  private:
   char* name_;
   Dart_NativeMessageHandler func_;
+  bool handle_concurrently_;
 };
 
 }  // namespace dart
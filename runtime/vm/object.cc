@@ -33,6 +33,7 @@
 #include "vm/debugger.h"
 #include "vm/deopt_instructions.h"
 #include "vm/double_conversion.h"
+#include "vm/dwarf_symbolizer.h"
 #include "vm/elf.h"
 #include "vm/exceptions.h"
 #include "vm/growable_array.h"
@@ -2833,7 +2834,7 @@ ObjectPtr Object::Allocate(intptr_t cls_id,
   HeapProfileSampler& heap_sampler = thread->heap_sampler();
   if (heap_sampler.HasOutstandingSample()) {
     thread->IncrementNoCallbackScopeDepth();
-    void* data = heap_sampler.InvokeCallbackForLastSample();
+    void* data = heap_sampler.InvokeCallbackForLastSample(cls_id);
     heap->SetHeapSamplingData(raw_obj, data);
     thread->DecrementNoCallbackScopeDepth();
   }
@@ -3160,6 +3161,11 @@ void Class::set_is_isolate_unsendable_due_to_pragma(bool value) const {
       IsIsolateUnsendableDueToPragmaBit::update(value, state_bits()));
 }
 
+void Class::set_is_deeply_immutable(bool value) const {
+  ASSERT(IsolateGroup::Current()->program_lock()->IsCurrentThreadWriter());
+  set_state_bits(IsDeeplyImmutableBit::update(value, state_bits()));
+}
+
 // Initialize class fields of type Array with empty array.
 void Class::InitEmptyFields() {
   if (Object::empty_array().ptr() == Array::null()) {
@@ -3633,6 +3639,34 @@ intptr_t Class::UnboxedFieldSizeInBytesByCid(intptr_t cid) {
   }
 }
 
+// Returns true if laying out the instance fields of [fields] in declaration
+// order, starting at the given offsets, would place an unboxed field beyond
+// the words covered by UnboxedFieldBitmap.
+static bool UnboxedFieldsExceedBitmap(const Array& fields,
+                                      intptr_t host_offset,
+                                      intptr_t target_offset) {
+  Field& field = Field::Handle();
+  for (intptr_t i = 0, n = fields.Length(); i < n; i++) {
+    field ^= fields.At(i);
+    if (field.is_static()) continue;
+    if (field.is_unboxed()) {
+      const intptr_t field_size =
+          Class::UnboxedFieldSizeInBytesByCid(field.guarded_cid());
+      host_offset += field_size;
+      target_offset += field_size;
+      if (host_offset / kCompressedWordSize > UnboxedFieldBitmap::Length() ||
+          target_offset / compiler::target::kCompressedWordSize >
+              UnboxedFieldBitmap::Length()) {
+        return true;
+      }
+    } else {
+      host_offset += kCompressedWordSize;
+      target_offset += compiler::target::kCompressedWordSize;
+    }
+  }
+  return false;
+}
+
 UnboxedFieldBitmap Class::CalculateFieldOffsets() const {
   Array& flds = Array::Handle(fields());
   const Class& super = Class::Handle(SuperClass());
@@ -3689,8 +3723,23 @@ UnboxedFieldBitmap Class::CalculateFieldOffsets() const {
   ASSERT(target_offset > 0);
   Field& field = Field::Handle();
   const intptr_t len = flds.Length();
+  // Unboxed fields can only be stored in the words covered by the unboxed
+  // fields bitmap. If declaration order would push some of them past it,
+  // lay out the unboxed fields of this class before its boxed ones.
+  const bool unboxed_fields_first =
+      UnboxedFieldsExceedBitmap(flds, host_offset, target_offset);
+  GrowableArray<intptr_t> order(len);
+  for (intptr_t pass = 0; pass < (unboxed_fields_first ? 2 : 1); pass++) {
+    for (intptr_t i = 0; i < len; i++) {
+      field ^= flds.At(i);
+      if (!unboxed_fields_first || (field.is_unboxed() == (pass == 0))) {
+        order.Add(i);
+      }
+    }
+  }
+  ASSERT(order.length() == len);
   for (intptr_t i = 0; i < len; i++) {
-    field ^= flds.At(i);
+    field ^= flds.At(order[i]);
     // Offset is computed only for instance fields.
     if (!field.is_static()) {
       ASSERT(field.HostOffset() == 0);
@@ -4257,6 +4306,28 @@ void Class::Finalize() const {
   }
 #endif
 
+  if (is_deeply_immutable()) {
+    // Instances are only shared across isolates if none of their fields can
+    // change once they are constructed.
+    auto Z = thread->zone();
+    const auto& super_class = Class::Handle(Z, SuperClass());
+    bool can_be_deeply_immutable =
+        (super_class.IsNull() || super_class.IsObjectClass() ||
+         super_class.is_deeply_immutable()) &&
+        (num_native_fields() == 0) && !is_isolate_unsendable_due_to_pragma();
+    const auto& fields = Array::Handle(Z, this->fields());
+    auto& field = Field::Handle(Z);
+    for (intptr_t i = 0; i < fields.Length(); ++i) {
+      field ^= fields.At(i);
+      if (!field.is_static() && (!field.is_final() || field.is_late())) {
+        can_be_deeply_immutable = false;
+      }
+    }
+    if (!can_be_deeply_immutable) {
+      set_is_deeply_immutable(false);
+    }
+  }
+
   set_is_finalized();
 }
 
@@ -6905,6 +6976,43 @@ TypeArguments::Cache::KeyLocation TypeArguments::Cache::FindKeyOrUnused(
   return {probe, false};
 }
 
+bool TypeArguments::Cache::FindInstantiationNoLock(
+    const Array& array,
+    const TypeArguments& instantiator_tav,
+    const TypeArguments& function_tav,
+    TypeArguments* result) {
+  // Entries are never removed and the backing array is replaced instead of
+  // being shrunk or rehashed in place, so probing a possibly stale array finds
+  // either a published entry or an unoccupied one.
+  const bool is_hash = IsHash(array);
+  InstantiationsCacheTable table(array);
+  const intptr_t num_entries = table.Length();
+  intptr_t probe = 0;
+  intptr_t probe_distance = 1;
+  if (is_hash) {
+    auto hash = FinalizeHash(
+        CombineHashes(instantiator_tav.Hash(), function_tav.Hash()));
+    probe = hash & (num_entries - 1);
+  }
+  while (true) {
+    const auto& tuple = table.At(probe);
+    // Use load-acquire to get the entry, see AddEntry.
+    const auto instantiator =
+        tuple.Get<kInstantiatorTypeArgsIndex, std::memory_order_acquire>();
+    if (instantiator == Sentinel()) return false;
+    if ((instantiator == instantiator_tav.ptr()) &&
+        (tuple.Get<kFunctionTypeArgsIndex>() == function_tav.ptr())) {
+      *result = tuple.Get<kInstantiatedTypeArgsIndex>();
+      return true;
+    }
+    probe = probe + probe_distance;
+    if (is_hash) {
+      probe = probe & (num_entries - 1);
+      probe_distance++;
+    }
+  }
+}
+
 TypeArguments::Cache::KeyLocation TypeArguments::Cache::AddEntry(
     intptr_t entry,
     const TypeArguments& instantiator_tav,
@@ -7416,6 +7524,20 @@ TypeArgumentsPtr TypeArguments::InstantiateAndCanonicalizeFrom(
     const TypeArguments& function_type_arguments) const {
   auto thread = Thread::Current();
   auto zone = thread->zone();
+  // Warm instantiations that reach the runtime (e.g. on IA32 where the stub
+  // does not probe hash-based caches) are found without taking the mutex
+  // shared by all isolates of the group.
+#if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+  if (!TESTING_runtime_fail_on_existing_cache_entry)
+#endif
+  {
+    TypeArguments& result = TypeArguments::Handle(zone);
+    if (Cache::FindInstantiationNoLock(Array::Handle(zone, instantiations()),
+                                       instantiator_type_arguments,
+                                       function_type_arguments, &result)) {
+      return result.ptr();
+    }
+  }
   SafepointMutexLocker ml(
       thread->isolate_group()->type_arguments_canonicalization_mutex());
 
@@ -10708,6 +10830,92 @@ ArrayPtr Function::GetCoverageArray() const {
   return Array::RawCast(arr.At(ICDataArrayIndices::kCoverageData));
 }
 
+// Returns the value stored for [key] in the list of (Smi key, value) pairs
+// at [index] of the ic_data_array [arr], or null.
+static ObjectPtr LookupICDataArrayPair(const Array& arr,
+                                       intptr_t index,
+                                       intptr_t key) {
+  if (arr.IsNull()) {
+    return Object::null();
+  }
+  const auto& pairs = Array::Handle(Array::RawCast(arr.AtAcquire(index)));
+  if (pairs.IsNull()) {
+    return Object::null();
+  }
+  for (intptr_t i = 0; i < pairs.Length(); i += 2) {
+    if (Smi::Value(Smi::RawCast(pairs.At(i))) == key) {
+      return pairs.At(i + 1);
+    }
+  }
+  return Object::null();
+}
+
+// Sets the value for [key] in the list of (Smi key, value) pairs at [index]
+// of the ic_data_array [arr].
+static void UpdateICDataArrayPair(const Array& arr,
+                                  intptr_t index,
+                                  intptr_t key,
+                                  const Object& value) {
+  const auto& old_pairs =
+      Array::Handle(Array::RawCast(arr.AtAcquire(index)));
+  const intptr_t old_length = old_pairs.IsNull() ? 0 : old_pairs.Length();
+  // Replace the entry of [key] if there is one.
+  intptr_t pos = old_length;
+  for (intptr_t i = 0; i < old_length; i += 2) {
+    if (Smi::Value(Smi::RawCast(old_pairs.At(i))) == key) {
+      pos = i;
+      break;
+    }
+  }
+  // Other isolates of the group may read the array concurrently, so it is
+  // copied and published with a store-release.
+  const intptr_t length = pos < old_length ? old_length : old_length + 2;
+  const auto& pairs = Array::Handle(Array::New(length, Heap::kOld));
+  Object& element = Object::Handle();
+  for (intptr_t i = 0; i < old_length; i++) {
+    element = old_pairs.At(i);
+    pairs.SetAt(i, element);
+  }
+  pairs.SetAt(pos, Smi::Handle(Smi::New(key)));
+  pairs.SetAt(pos + 1, value);
+  arr.SetAtRelease(index, pairs);
+}
+
+CodePtr Function::GetOsrCode(intptr_t osr_id) const {
+  const Array& arr = Array::Handle(ic_data_array());
+  const auto& code = Code::Handle(Code::RawCast(LookupICDataArrayPair(
+      arr, ICDataArrayIndices::kOsrCode, osr_id)));
+  // Code becomes dead or disabled once its assumptions are invalidated.
+  if (code.IsNull() || !code.is_alive() || code.IsDisabled()) {
+    return Code::null();
+  }
+  return code.ptr();
+}
+
+void Function::SetOsrCode(intptr_t osr_id, const Code& code) const {
+  const Array& arr = Array::Handle(ic_data_array());
+  if (arr.IsNull()) {
+    return;
+  }
+  UpdateICDataArrayPair(arr, ICDataArrayIndices::kOsrCode, osr_id, code);
+}
+
+TypedDataPtr Function::GetCachedFlowGraph(intptr_t osr_id) const {
+  const Array& arr = Array::Handle(ic_data_array());
+  return TypedData::RawCast(LookupICDataArrayPair(
+      arr, ICDataArrayIndices::kFlowGraphCache, osr_id));
+}
+
+void Function::SetCachedFlowGraph(intptr_t osr_id,
+                                  const TypedData& data) const {
+  const Array& arr = Array::Handle(ic_data_array());
+  if (arr.IsNull()) {
+    return;
+  }
+  UpdateICDataArrayPair(arr, ICDataArrayIndices::kFlowGraphCache, osr_id,
+                        data);
+}
+
 void Function::set_ic_data_array(const Array& value) const {
   untag()->set_ic_data_array<std::memory_order_release>(value.ptr());
 }
@@ -11824,11 +12032,14 @@ ErrorPtr Field::InitializeStatic() const {
         UNREACHABLE();
       }
     } else {
-      SetStaticValue(Object::transition_sentinel());
-      value = EvaluateInitializer();
-      if (value.IsError()) {
-        SetStaticValue(Object::null_instance());
-        return Error::Cast(value).ptr();
+      value = EvaluateSharedInitializer();
+      if (value.ptr() == Object::sentinel().ptr()) {
+        SetStaticValue(Object::transition_sentinel());
+        value = EvaluateInitializer();
+        if (value.IsError()) {
+          SetStaticValue(Object::null_instance());
+          return Error::Cast(value).ptr();
+        }
       }
     }
     ASSERT(value.IsNull() || value.IsInstance());
@@ -11889,6 +12100,33 @@ void Field::SetStaticConstFieldValue(const Instance& value,
                              /*concurrent_use=*/true);
 }
 
+ObjectPtr Field::EvaluateSharedInitializer() const {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  // The precompiler already stored the values of constant initializers in the
+  // initial field table.
+  return Object::sentinel().ptr();
+#else
+  // Once an initializer function exists the initializer was found not to be
+  // a constant, so don't look at it again.
+  if (!has_nontrivial_initializer() || needs_load_guard() ||
+      HasInitializerFunction()) {
+    return Object::sentinel().ptr();
+  }
+  const auto& value =
+      Object::Handle(kernel::EvaluateConstantFieldInitializer(*this));
+  if (value.ptr() == Object::sentinel().ptr() || value.IsError()) {
+    // Let the initializer function run and report any error.
+    return Object::sentinel().ptr();
+  }
+  // A constant is the same object in all isolates of the group, so isolates
+  // spawned from now on start out with the field initialized.
+  SetStaticConstFieldValue(
+      value.IsNull() ? Instance::null_instance() : Instance::Cast(value),
+      /*assert_initializing_store=*/false);
+  return value.ptr();
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
 ObjectPtr Field::EvaluateInitializer() const {
   ASSERT(Thread::Current()->IsMutatorThread());
 
@@ -12510,10 +12748,11 @@ StringPtr Script::resolved_url() const {
 }
 
 bool Script::HasSource() const {
-  return untag()->source() != String::null();
+  return Source() != String::null();
 }
 
 StringPtr Script::Source() const {
+  LookupSourceAndLineStarts(Thread::Current()->zone());
   return untag()->source();
 }
 
@@ -12565,7 +12804,8 @@ void Script::LookupSourceAndLineStarts(Zone* zone) const {
     for (intptr_t i = 0; i < libs.Length(); i++) {
       lib ^= libs.At(i);
       script = lib.LookupScript(uri, /* useResolvedUri = */ true);
-      if (!script.IsNull()) {
+      if (!script.IsNull() && script.ptr() != ptr() &&
+          !script.IsLazyLookupSourceAndLineStarts()) {
         const auto& source = String::Handle(zone, script.Source());
         const auto& starts = TypedData::Handle(zone, script.line_starts());
         if (!source.IsNull() || !starts.IsNull()) {
@@ -12684,6 +12924,7 @@ void Script::set_debug_positions(const Array& value) const {
 }
 
 TypedDataPtr Script::line_starts() const {
+  LookupSourceAndLineStarts(Thread::Current()->zone());
   return untag()->line_starts();
 }
 
@@ -15394,14 +15635,21 @@ const UntaggedCompressedStackMaps::Payload* InstructionsTable::FindStackMap(
   NoSafepointScope no_safepoint;
   const intptr_t idx = FindEntry(table, pc);
   if (idx != -1) {
-    const auto rodata = table.untag()->rodata_;
-    const auto entries = rodata->entries();
-    *start_pc = InstructionsTable::start_pc(table) + entries[idx].pc_offset;
-    return rodata->StackMapAt(entries[idx].stack_map_offset);
+    return StackMapAtEntry(table, idx, start_pc);
   }
   return nullptr;
 }
 
+const UntaggedCompressedStackMaps::Payload* InstructionsTable::StackMapAtEntry(
+    InstructionsTablePtr table,
+    intptr_t index,
+    uword* start_pc) {
+  const auto rodata = table.untag()->rodata_;
+  const auto entries = rodata->entries();
+  *start_pc = InstructionsTable::start_pc(table) + entries[index].pc_offset;
+  return rodata->StackMapAt(entries[index].stack_map_offset);
+}
+
 CodePtr InstructionsTable::FindCode(InstructionsTablePtr table, uword pc) {
   // This can run in the middle of GC and must not allocate handles.
   NoSafepointScope no_safepoint;
@@ -15418,21 +15666,37 @@ CodePtr InstructionsTable::FindCode(InstructionsTablePtr table, uword pc) {
   const auto idx =
       FindEntry(table, pc, table.untag()->rodata_->first_entry_with_code);
   if (idx != -1) {
-    const intptr_t code_index = idx - rodata->first_entry_with_code;
-    ASSERT(code_index >= 0);
-    ASSERT(code_index <
-           Smi::Value(table.untag()->code_objects()->untag()->length()));
-    ObjectPtr result =
-        table.untag()->code_objects()->untag()->element(code_index);
-    ASSERT(result->IsCode());
-    // Note: can't use Code::RawCast(...) here because it allocates handles
-    // in DEBUG mode.
-    return static_cast<CodePtr>(result);
+    return CodeAtEntry(table, pc, idx);
   }
 
   return Code::null();
 }
 
+CodePtr InstructionsTable::CodeAtEntry(InstructionsTablePtr table,
+                                       uword pc,
+                                       intptr_t index) {
+  // This can run in the middle of GC and must not allocate handles.
+  NoSafepointScope no_safepoint;
+  ASSERT(InstructionsTable::ContainsPc(table, pc));
+  const auto rodata = table.untag()->rodata_;
+
+  const auto pc_offset = InstructionsTable::ConvertPcToOffset(table, pc);
+
+  if (pc_offset <= rodata->entries()[rodata->first_entry_with_code].pc_offset) {
+    return StubCode::UnknownDartCode().ptr();
+  }
+
+  const intptr_t code_index = index - rodata->first_entry_with_code;
+  ASSERT(code_index >= 0);
+  ASSERT(code_index <
+         Smi::Value(table.untag()->code_objects()->untag()->length()));
+  ObjectPtr result = table.untag()->code_objects()->untag()->element(code_index);
+  ASSERT(result->IsCode());
+  // Note: can't use Code::RawCast(...) here because it allocates handles
+  // in DEBUG mode.
+  return static_cast<CodePtr>(result);
+}
+
 uword InstructionsTable::EntryPointAt(intptr_t code_index) const {
   ASSERT(0 <= code_index);
   ASSERT(code_index < static_cast<intptr_t>(rodata()->length));
@@ -15786,10 +16050,12 @@ CompressedStackMaps::iterator(Thread* thread) const {
 CompressedStackMapsPtr CompressedStackMaps::New(const void* payload,
                                                 intptr_t size,
                                                 bool is_global_table,
-                                                bool uses_global_table) {
+                                                bool uses_global_table,
+                                                bool has_index) {
   ASSERT(Object::compressed_stackmaps_class() != Class::null());
   // We don't currently allow both flags to be true.
   ASSERT(!is_global_table || !uses_global_table);
+  ASSERT(!is_global_table || !has_index);
   // The canonical empty instance should be used instead.
   ASSERT(size != 0);
 
@@ -15812,6 +16078,7 @@ CompressedStackMapsPtr CompressedStackMaps::New(const void* payload,
     result.untag()->payload()->set_flags_and_size(
         UntaggedCompressedStackMaps::GlobalTableBit::encode(is_global_table) |
         UntaggedCompressedStackMaps::UsesTableBit::encode(uses_global_table) |
+        UntaggedCompressedStackMaps::IndexBit::encode(has_index) |
         UntaggedCompressedStackMaps::SizeField::encode(size));
     auto cursor =
         result.UnsafeMutableNonPointer(result.untag()->payload()->data());
@@ -17566,6 +17833,10 @@ void Code::set_is_discarded(bool value) const {
   set_state_bits(DiscardedBit::update(value, untag()->state_bits_));
 }
 
+void Code::set_is_cold(bool value) const {
+  set_state_bits(ColdBit::update(value, untag()->state_bits_));
+}
+
 void Code::set_compressed_stackmaps(const CompressedStackMaps& maps) const {
   ASSERT(maps.IsOld());
   untag()->set_compressed_stackmaps(maps.ptr());
@@ -19806,7 +20077,10 @@ IntegerPtr Instance::IdentityHashCode(Thread* thread) const {
 #if defined(HASH_IN_OBJECT_HEADER)
   intptr_t hash = Object::GetCachedHash(ptr());
 #else
-  intptr_t hash = thread->heap()->GetHash(ptr());
+  // Looking up the hash takes the weak table lock. Rather than taking it once
+  // to look the hash up and again to set it, compute a candidate hash and let
+  // SetHashIfNotSet return the existing one, if any, under a single lock.
+  intptr_t hash = 0;
 #endif
   if (hash == 0) {
     if (IsNull()) {
@@ -24501,12 +24775,18 @@ StringPtr String::SubString(Thread* thread,
   bool is_one_byte_string = true;
   intptr_t char_size = str.CharSize();
   if (char_size == kTwoByteChar) {
-    for (intptr_t i = begin_index; i < begin_index + length; ++i) {
-      if (!Utf::IsLatin1(str.CharAt(i))) {
-        is_one_byte_string = false;
-        break;
-      }
+    // Or the characters together rather than testing them one at a time, so
+    // that the loop has no early exit and can be vectorized.
+    NoSafepointScope no_safepoint;
+    const uint16_t* chars =
+        str.IsTwoByteString()
+            ? TwoByteString::CharAddr(str, begin_index)
+            : ExternalTwoByteString::CharAddr(str, begin_index);
+    uint16_t limit = 0;
+    for (intptr_t i = 0; i < length; ++i) {
+      limit |= chars[i];
     }
+    is_one_byte_string = Utf::IsLatin1(limit);
   }
   REUSABLE_STRING_HANDLESCOPE(thread);
   String& result = thread->StringHandle();
@@ -25478,6 +25758,34 @@ void Array::Truncate(intptr_t new_len) const {
   array.SetLengthRelease(new_len);
 }
 
+bool Array::TryGrowInPlace(intptr_t new_len) const {
+  ASSERT(!IsNull());
+  const intptr_t old_len = Length();
+  ASSERT(new_len > old_len);
+  if (!ptr()->IsNewObject() || (new_len > kMaxNewSpaceElements)) {
+    return false;
+  }
+  Thread* thread = Thread::Current();
+  const intptr_t old_size = Array::InstanceSize(old_len);
+  const intptr_t new_size = Array::InstanceSize(new_len);
+  const uword old_end = UntaggedObject::ToAddr(ptr()) + old_size;
+  if ((thread->top() != old_end) ||
+      ((thread->end() - old_end) < static_cast<uword>(new_size - old_size))) {
+    return false;
+  }
+
+  NoSafepointScope no_safepoint(thread);
+  thread->set_top(old_end + (new_size - old_size));
+  // New-space objects are not visited concurrently, so the header and length
+  // can be updated without the care Truncate needs.
+  untag()->tags_ = UntaggedObject::SizeTag::update(new_size, untag()->tags_);
+  SetLength(new_len);
+  for (intptr_t i = old_len; i < new_len; i++) {
+    untag()->set_element(i, Object::null(), thread);
+  }
+  return true;
+}
+
 ArrayPtr Array::MakeFixedLength(const GrowableObjectArray& growable_array,
                                 bool unique) {
   ASSERT(!growable_array.IsNull());
@@ -25688,6 +25996,16 @@ const char* Map::ToCString() const {
       Length());
 }
 
+intptr_t LinkedHashBase::ImmutableIndexSize(intptr_t data_length,
+                                           bool is_map) {
+  const intptr_t rounded_length = Utils::RoundUpToPowerOfTwo(data_length);
+  const intptr_t index_size_mult = is_map ? 1 : 2;
+  const intptr_t index_size = Utils::Maximum(LinkedHashBase::kInitialIndexSize,
+                                             rounded_length * index_size_mult);
+  ASSERT(Utils::IsPowerOfTwo(index_size));
+  return index_size;
+}
+
 void LinkedHashBase::ComputeAndSetHashMask() const {
   ASSERT(IsImmutable());
   ASSERT_EQUAL(Smi::Value(deleted_keys()), 0);
@@ -25695,16 +26013,52 @@ void LinkedHashBase::ComputeAndSetHashMask() const {
   Zone* const zone = thread->zone();
 
   const auto& data_array = Array::Handle(zone, data());
-  const intptr_t data_length = Utils::RoundUpToPowerOfTwo(data_array.Length());
-  const intptr_t index_size_mult = IsMap() ? 1 : 2;
-  const intptr_t index_size = Utils::Maximum(LinkedHashBase::kInitialIndexSize,
-                                             data_length * index_size_mult);
-  ASSERT(Utils::IsPowerOfTwo(index_size));
-
+  const intptr_t index_size = ImmutableIndexSize(data_array.Length(), IsMap());
   const intptr_t hash_mask = IndexSizeToHashMask(index_size);
   set_hash_mask(hash_mask);
 }
 
+void LinkedHashBase::PrecomputeIndex() const {
+  ASSERT(IsImmutable());
+  ASSERT_EQUAL(Smi::Value(deleted_keys()), 0);
+  Zone* const zone = Thread::Current()->zone();
+
+  const auto& data_array = Array::Handle(zone, data());
+  const intptr_t used = Smi::Value(used_data());
+  const intptr_t stride = IsMap() ? 2 : 1;
+  auto& key = Object::Handle(zone);
+  for (intptr_t j = 0; j < used; j += stride) {
+    key = data_array.At(j);
+    if (!key.IsString()) return;
+  }
+
+  const intptr_t index_size = ImmutableIndexSize(data_array.Length(), IsMap());
+  const intptr_t hash_mask = Smi::Value(this->hash_mask());
+  if (hash_mask != IndexSizeToHashMask(index_size)) return;
+
+  const intptr_t size_mask = index_size - 1;
+  const intptr_t max_entries = index_size >> 1;
+  const auto& new_index = TypedData::Handle(
+      zone, TypedData::New(kTypedDataUint32ArrayCid, index_size, Heap::kOld));
+  const intptr_t kElementSize = sizeof(uint32_t);
+  for (intptr_t j = 0; j < used; j += stride) {
+    key = data_array.At(j);
+    const intptr_t full_hash = String::Cast(key).Hash();
+    const intptr_t masked_hash = full_hash & hash_mask;
+    const intptr_t hash_pattern =
+        masked_hash == 0 ? max_entries : masked_hash * max_entries;
+    // Linear probing after the same shuffle as _HashBase._firstProbe. Keys of
+    // constant maps and sets are distinct, so every key gets a fresh slot.
+    intptr_t i = ((full_hash & size_mask) * 3) & size_mask;
+    while (new_index.GetUint32(i * kElementSize) != 0) {
+      i = (i + 1) & size_mask;
+    }
+    new_index.SetUint32(i * kElementSize,
+                        static_cast<uint32_t>(hash_pattern | (j / stride)));
+  }
+  set_index(new_index);
+}
+
 bool LinkedHashBase::CanonicalizeEquals(const Instance& other) const {
   ASSERT(IsImmutable());
 
@@ -25786,9 +26140,9 @@ void LinkedHashBase::CanonicalizeFieldsLocked(Thread* thread) const {
   data_array ^= data_array.CanonicalizeLocked(thread);
   set_data(data_array);
 
-  // The index should not be set yet. It is populated lazily on first read.
-  const auto& index_td = TypedData::Handle(zone, index());
-  ASSERT(index_td.IsNull());
+  // The index is either precomputed (see PrecomputeIndex) or populated
+  // lazily on first read. String hashes do not change when the keys are
+  // canonicalized, so a precomputed index stays valid.
 }
 
 ConstMapPtr ConstMap::NewDefault(Heap::Space space) {
@@ -26818,6 +27172,12 @@ const char* StackTrace::ToCString() const {
   const bool have_footnote_callback =
       FLAG_dwarf_stack_traces_mode &&
       Dart::dwarf_stacktrace_footnote_callback() != nullptr;
+  // Frame indices and relocated addresses of the frames to symbolize with
+  // the separate debugging information, if given.
+  const bool have_symbolizer =
+      FLAG_dwarf_stack_traces_mode && DwarfSymbolizer::IsEnabled();
+  GrowableArray<intptr_t> symbolized_frames;
+  GrowableArray<uword> symbolized_addresses;
 #endif
 
   ZoneTextBuffer buffer(zone, 1024);
@@ -26956,6 +27316,17 @@ const char* StackTrace::ToCString() const {
         buffer.Printf("    #%02" Pd " abs %" Pp "", frame_index, call_addr);
         PrintNonSymbolicStackFrameBody(&buffer, call_addr, isolate_instructions,
                                        vm_instructions);
+        if (have_symbolizer) {
+          const Image isolate_image(
+              reinterpret_cast<const void*>(isolate_instructions));
+          if (isolate_image.contains(call_addr) &&
+              isolate_image.compiled_to_elf()) {
+            symbolized_frames.Add(frame_index);
+            symbolized_addresses.Add(
+                isolate_image.instructions_relocated_address() +
+                (call_addr - isolate_instructions));
+          }
+        }
         frame_index++;
         continue;
       }
@@ -27007,6 +27378,21 @@ const char* StackTrace::ToCString() const {
   } while (!stack_trace.IsNull());
 
 #if defined(DART_PRECOMPILED_RUNTIME)
+  if (!symbolized_addresses.is_empty()) {
+    DwarfSymbolizer::Location location;
+    buffer.AddString("*** symbolized with --dwarf_debug_info ***\n");
+    for (intptr_t i = 0; i < symbolized_addresses.length(); i++) {
+      if (!DwarfSymbolizer::Lookup(symbolized_addresses[i], &location)) {
+        continue;
+      }
+      PrintSymbolicStackFrameIndex(&buffer, symbolized_frames[i]);
+      PrintSymbolicStackFrameBody(
+          &buffer, location.function,
+          location.file != nullptr ? location.file : "unknown",
+          location.line > 0 ? location.line : -1,
+          location.column > 0 ? location.column : -1);
+    }
+  }
   if (have_footnote_callback) {
     char* footnote = Dart::dwarf_stacktrace_footnote_callback()(
         &addresses[0], addresses.length());
@@ -27152,6 +27538,20 @@ void RegExp::set_pattern(const String& pattern) const {
   untag()->set_pattern(pattern.ptr());
 }
 
+intptr_t RegExp::IncrementInterpretedExecutions() const {
+  // Concurrent increments from several isolates of the group may be lost,
+  // which only delays compilation.
+  const uint16_t count =
+      LoadNonPointer<uint16_t, std::memory_order_relaxed>(
+          &untag()->interpreted_executions_);
+  if (count == kMaxUint16) {
+    return count;
+  }
+  StoreNonPointer<uint16_t, uint16_t, std::memory_order_relaxed>(
+      &untag()->interpreted_executions_, count + 1);
+  return count + 1;
+}
+
 void RegExp::set_function(intptr_t cid,
                           bool sticky,
                           const Function& value) const {
@@ -27219,9 +27619,15 @@ RegExpPtr RegExp::New(Zone* zone, Heap::Space space) {
     result.set_num_bracket_expressions(-1);
     result.set_num_registers(/*is_one_byte=*/false, -1);
     result.set_num_registers(/*is_one_byte=*/true, -1);
+    result.StoreNonPointer(&result.untag()->interpreted_executions_,
+                           static_cast<uint16_t>(0));
   }
 
-  if (!FLAG_interpret_irregexp) {
+  // With a compilation threshold, or when the regexp may be run by the
+  // linear engine, the specialized functions are created once they are
+  // needed, see RegExpEngine::EnsureCompiled.
+  if (!FLAG_interpret_irregexp && FLAG_regexp_compilation_threshold == 0 &&
+      !FLAG_linear_regexp) {
     auto thread = Thread::Current();
     const Library& lib = Library::Handle(zone, Library::CoreLibrary());
     const Class& owner =
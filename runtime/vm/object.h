@@ -1686,6 +1686,9 @@ class Class : public Object {
     return IsIsolateUnsendableDueToPragmaBit::decode(
         clazz->untag()->state_bits_);
   }
+  static bool IsDeeplyImmutable(ClassPtr clazz) {
+    return IsDeeplyImmutableBit::decode(clazz->untag()->state_bits_);
+  }
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
   CodePtr allocation_stub() const { return untag()->allocation_stub(); }
@@ -1936,6 +1939,14 @@ class Class : public Object {
     // True if this class has `@pramga('vm:isolate-unsendable') annotation or
     // base class or implemented interfaces has this bit.
     kIsIsolateUnsendableDueToPragmaBit,
+    // Whether instances of the class can be shared across isolates once
+    // their fields are found to refer to deeply immutable objects only.
+    //
+    // Will be true iff
+    //    - class is marked with `@pragma('vm:deeply-immutable')`
+    //    - all its instance fields are final and not late.
+    //    - super class is Object or also has this bit.
+    kIsDeeplyImmutableBit,
   };
   class ConstBit : public BitField<uint32_t, bool, kConstBit, 1> {};
   class ImplementedBit : public BitField<uint32_t, bool, kImplementedBit, 1> {};
@@ -1969,6 +1980,8 @@ class Class : public Object {
   class IsIsolateUnsendableDueToPragmaBit
       : public BitField<uint32_t, bool, kIsIsolateUnsendableDueToPragmaBit, 1> {
   };
+  class IsDeeplyImmutableBit
+      : public BitField<uint32_t, bool, kIsDeeplyImmutableBit, 1> {};
 
   void set_name(const String& value) const;
   void set_user_name(const String& value) const;
@@ -2021,6 +2034,13 @@ class Class : public Object {
     return IsIsolateUnsendableDueToPragmaBit::decode(state_bits());
   }
 
+  // The bit is set while loading a class with the pragma and is cleared by
+  // the class finalizer if the class does not qualify.
+  void set_is_deeply_immutable(bool value) const;
+  bool is_deeply_immutable() const {
+    return IsDeeplyImmutableBit::decode(state_bits());
+  }
+
  private:
   void set_functions(const Array& value) const;
   void set_fields(const Array& value) const;
@@ -3826,12 +3846,15 @@ class Function : public Object {
                         bool clone_ic_data) const;
 
   // ic_data_array attached to the function stores edge counters in the
-  // first element, coverage data array in the second element and the rest
+  // first element, coverage data array in the second element, OSR code in
+  // the third element, cached flow graphs in the fourth element and the rest
   // are ICData objects.
   struct ICDataArrayIndices {
     static constexpr intptr_t kEdgeCounters = 0;
     static constexpr intptr_t kCoverageData = 1;
-    static constexpr intptr_t kFirstICData = 2;
+    static constexpr intptr_t kOsrCode = 2;
+    static constexpr intptr_t kFlowGraphCache = 3;
+    static constexpr intptr_t kFirstICData = 4;
   };
 
   ArrayPtr ic_data_array() const;
@@ -3843,6 +3866,28 @@ class Function : public Object {
   //   element 2 * i + 1 is coverage hit (zero meaning code was not hit)
   ArrayPtr GetCoverageArray() const;
 
+  // OSR code array is a list of pairs:
+  //   element 2 * i + 0 is the deopt id of the OSR entry
+  //   element 2 * i + 1 is the optimized code compiled for that entry
+  //
+  // Returns the code compiled for on-stack replacement at [osr_id] if it can
+  // still be entered, or null otherwise.
+  CodePtr GetOsrCode(intptr_t osr_id) const;
+  // Remembers [code] compiled for on-stack replacement at [osr_id] until the
+  // unoptimized code of the function is replaced.
+  void SetOsrCode(intptr_t osr_id, const Code& code) const;
+
+  // Flow graph cache array is a list of pairs:
+  //   element 2 * i + 0 is the deopt id of the OSR entry (or
+  //                     Compiler::kNoOSRDeoptId)
+  //   element 2 * i + 1 is the serialized flow graph, see FlowGraphCache
+  //
+  // Returns the flow graph cached for [osr_id], or null.
+  TypedDataPtr GetCachedFlowGraph(intptr_t osr_id) const;
+  // Remembers the flow graph [data] for [osr_id] until the unoptimized code
+  // of the function is replaced.
+  void SetCachedFlowGraph(intptr_t osr_id, const TypedData& data) const;
+
   // Outputs this function's service ID to the provided JSON object.
   void AddFunctionServiceId(const JSONObject& obj) const;
 
@@ -4628,6 +4673,11 @@ class Field : public Object {
   // Force this field's guard to be dynamic and deoptimize dependent code.
   void ForceDynamicGuardedCidAndLength() const;
 
+  // Evaluates the initializer of this static field if it is a constant and
+  // stores the value in the isolate group's initial field table. Returns the
+  // sentinel if the initializer function has to run instead.
+  ObjectPtr EvaluateSharedInitializer() const;
+
   void set_name(const String& value) const;
   void set_is_static(bool is_static) const {
     // TODO(36097): Once concurrent access is possible ensure updates are safe.
@@ -4754,13 +4804,13 @@ class Script : public Object {
   void LoadSourceFromKernel(const uint8_t* kernel_buffer,
                             intptr_t kernel_buffer_len) const;
   bool IsLazyLookupSourceAndLineStarts() const;
+  void SetLazyLookupSourceAndLineStarts(bool value) const;
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
  private:
 #if !defined(DART_PRECOMPILED_RUNTIME)
   bool HasCachedMaxPosition() const;
 
-  void SetLazyLookupSourceAndLineStarts(bool value) const;
   void SetHasCachedMaxPosition(bool value) const;
   void SetCachedMaxPosition(intptr_t value) const;
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
@@ -5713,6 +5763,21 @@ class InstructionsTable : public Object {
   static const UntaggedCompressedStackMaps::Payload*
   FindStackMap(InstructionsTablePtr table, uword pc, uword* start_pc);
 
+  // Returns the index of the entry containing [pc], or -1.
+  static intptr_t FindEntry(InstructionsTablePtr table,
+                            uword pc,
+                            intptr_t start_index = 0);
+
+  // Returns the Code of the entry at [index], which must contain [pc].
+  static CodePtr CodeAtEntry(InstructionsTablePtr table,
+                             uword pc,
+                             intptr_t index);
+
+  // Returns the stack map of the entry at [index] and sets [start_pc] to the
+  // start of its instructions.
+  static const UntaggedCompressedStackMaps::Payload*
+  StackMapAtEntry(InstructionsTablePtr table, intptr_t index, uword* start_pc);
+
   static const UntaggedCompressedStackMaps::Payload* GetCanonicalStackMap(
       InstructionsTablePtr table);
 
@@ -5753,10 +5818,6 @@ class InstructionsTable : public Object {
   }
   static uint32_t ConvertPcToOffset(InstructionsTablePtr table, uword pc);
 
-  static intptr_t FindEntry(InstructionsTablePtr table,
-                            uword pc,
-                            intptr_t start_index = 0);
-
   FINAL_HEAP_OBJECT_IMPLEMENTATION(InstructionsTable, Object);
   friend class Class;
   friend class Deserializer;
@@ -6039,20 +6100,39 @@ class CompressedStackMaps : public Object {
         raw->untag()->payload()->flags_and_size());
   }
 
-  static CompressedStackMapsPtr NewInlined(const void* payload, intptr_t size) {
+  bool HasIndex() const {
+    return UntaggedCompressedStackMaps::IndexBit::decode(
+        untag()->payload()->flags_and_size());
+  }
+
+  // The number of entries between two entries in the sparse index at the
+  // end of the payload. See UntaggedCompressedStackMaps for the encoding.
+  static constexpr intptr_t kIndexInterval = 16;
+
+  struct IndexEntry {
+    // The PC offset of the entry before the indexed entry.
+    uint32_t previous_pc_offset;
+    // The payload offset of the indexed entry.
+    uint32_t entry_offset;
+  };
+
+  static CompressedStackMapsPtr NewInlined(const void* payload,
+                                           intptr_t size,
+                                           bool has_index = false) {
     return New(payload, size, /*is_global_table=*/false,
-               /*uses_global_table=*/false);
+               /*uses_global_table=*/false, has_index);
   }
   static CompressedStackMapsPtr NewUsingTable(const void* payload,
-                                              intptr_t size) {
+                                              intptr_t size,
+                                              bool has_index = false) {
     return New(payload, size, /*is_global_table=*/false,
-               /*uses_global_table=*/true);
+               /*uses_global_table=*/true, has_index);
   }
 
   static CompressedStackMapsPtr NewGlobalTable(const void* payload,
                                                intptr_t size) {
     return New(payload, size, /*is_global_table=*/true,
-               /*uses_global_table=*/false);
+               /*uses_global_table=*/false, /*has_index=*/false);
   }
 
   class RawPayloadHandle {
@@ -6100,6 +6180,11 @@ class CompressedStackMaps : public Object {
           payload()->flags_and_size());
     }
 
+    bool HasIndex() const {
+      return UntaggedCompressedStackMaps::IndexBit::decode(
+          payload()->flags_and_size());
+    }
+
    private:
     const UntaggedCompressedStackMaps::Payload* payload_ = nullptr;
   };
@@ -6109,16 +6194,29 @@ class CompressedStackMaps : public Object {
    public:
     Iterator(const PayloadHandle& maps, const PayloadHandle& global_table)
         : maps_(maps),
-          bits_container_(maps.UsesGlobalTable() ? global_table : maps) {
+          bits_container_(maps.UsesGlobalTable() ? global_table : maps),
+          entries_size_(maps.payload_size()) {
       ASSERT(!maps_.IsNull());
       ASSERT(!bits_container_.IsNull());
       ASSERT(!maps_.IsGlobalTable());
       ASSERT(!maps_.UsesGlobalTable() || bits_container_.IsGlobalTable());
+      if (maps_.HasIndex()) {
+        NoSafepointScope scope;
+        uint32_t index_length;
+        memcpy(&index_length,
+               maps_.data() + maps_.payload_size() - sizeof(uint32_t),
+               sizeof(uint32_t));
+        index_length_ = index_length;
+        entries_size_ -= sizeof(uint32_t) + index_length_ * sizeof(IndexEntry);
+        ASSERT(entries_size_ < maps_.payload_size());
+      }
     }
 
     Iterator(const Iterator& it)
         : maps_(it.maps_),
           bits_container_(it.bits_container_),
+          entries_size_(it.entries_size_),
+          index_length_(it.index_length_),
           next_offset_(it.next_offset_),
           current_pc_offset_(it.current_pc_offset_),
           current_global_table_offset_(it.current_global_table_offset_),
@@ -6129,7 +6227,7 @@ class CompressedStackMaps : public Object {
     // Loads the next entry from [maps_], if any. If [maps_] is the null value,
     // this always returns false.
     bool MoveNext() {
-      if (next_offset_ >= maps_.payload_size()) {
+      if (next_offset_ >= entries_size_) {
         return false;
       }
 
@@ -6169,7 +6267,7 @@ class CompressedStackMaps : public Object {
             current_spill_slot_bit_count_ + current_non_spill_slot_bit_count_;
         const uintptr_t stackmap_size =
             Utils::RoundUp(stackmap_bits, kBitsPerByte) >> kBitsPerByteLog2;
-        ASSERT(stackmap_size <= (maps_.payload_size() - stream.Position()));
+        ASSERT(stackmap_size <= (entries_size_ - stream.Position()));
 
         current_bits_offset_ = stream.Position();
         next_offset_ = current_bits_offset_ + stackmap_size;
@@ -6184,6 +6282,7 @@ class CompressedStackMaps : public Object {
       // We should never have an entry with a PC offset of 0 inside an
       // non-empty CSM, so fail.
       if (pc_offset == 0) return false;
+      SkipAhead(pc_offset);
       do {
         if (current_pc_offset_ >= pc_offset) break;
       } while (MoveNext());
@@ -6225,6 +6324,43 @@ class CompressedStackMaps : public Object {
    private:
     bool HasLoadedEntry() const { return next_offset_ > 0; }
 
+    // Uses the sparse index, if any, to move the iterator to just before the
+    // last indexed entry whose predecessor is before [pc_offset], unless the
+    // iterator is already past that entry.
+    void SkipAhead(uint32_t pc_offset) {
+      if (index_length_ == 0) return;
+      NoSafepointScope scope;
+      const uint8_t* const index = maps_.data() + entries_size_;
+      auto index_entry_at = [&](intptr_t i) {
+        IndexEntry entry;
+        memcpy(&entry, index + i * sizeof(IndexEntry), sizeof(IndexEntry));
+        return entry;
+      };
+      intptr_t low = 0;
+      intptr_t high = index_length_ - 1;
+      intptr_t found = -1;
+      while (low <= high) {
+        const intptr_t mid = low + (high - low) / 2;
+        if (index_entry_at(mid).previous_pc_offset < pc_offset) {
+          found = mid;
+          low = mid + 1;
+        } else {
+          high = mid - 1;
+        }
+      }
+      if (found < 0) return;
+      const IndexEntry entry = index_entry_at(found);
+      if (entry.entry_offset <= next_offset_) return;
+      ASSERT(entry.entry_offset < entries_size_);
+      // Leave the iterator as if it had just loaded the entry before the
+      // indexed one, which is all MoveNext needs to decode the next entry.
+      next_offset_ = entry.entry_offset;
+      current_pc_offset_ = entry.previous_pc_offset;
+      current_spill_slot_bit_count_ = -1;
+      current_non_spill_slot_bit_count_ = -1;
+      current_bits_offset_ = -1;
+    }
+
     // Caches the corresponding values from the global table in the mutable
     // fields. We lazily load these as some clients only need the PC offset.
     void LazyLoadGlobalTableEntry() const {
@@ -6261,6 +6397,9 @@ class CompressedStackMaps : public Object {
 
     const PayloadHandle& maps_;
     const PayloadHandle& bits_container_;
+    // The size of the entries in the payload, which excludes the index.
+    uintptr_t entries_size_;
+    intptr_t index_length_ = 0;
 
     uintptr_t next_offset_ = 0;
     uint32_t current_pc_offset_ = 0;
@@ -6284,7 +6423,8 @@ class CompressedStackMaps : public Object {
   static CompressedStackMapsPtr New(const void* payload,
                                     intptr_t size,
                                     bool is_global_table,
-                                    bool uses_global_table);
+                                    bool uses_global_table,
+                                    bool has_index);
 
   FINAL_HEAP_OBJECT_IMPLEMENTATION(CompressedStackMaps, Object);
   friend class Class;
@@ -6553,6 +6693,12 @@ class Code : public Object {
   }
   void set_is_discarded(bool value) const;
 
+  bool is_cold() const { return IsCold(ptr()); }
+  static bool IsCold(const CodePtr code) {
+    return ColdBit::decode(code->untag()->state_bits_);
+  }
+  void set_is_cold(bool value) const;
+
   bool HasMonomorphicEntry() const { return HasMonomorphicEntry(ptr()); }
   static bool HasMonomorphicEntry(const CodePtr code) {
 #if defined(DART_PRECOMPILED_RUNTIME)
@@ -6997,7 +7143,8 @@ class Code : public Object {
     kForceOptimizedBit = 1,
     kAliveBit = 2,
     kDiscardedBit = 3,
-    kPtrOffBit = 4,
+    kColdBit = 4,
+    kPtrOffBit = 5,
     kPtrOffSize = kBitsPerInt32 - kPtrOffBit,
   };
 
@@ -7016,6 +7163,11 @@ class Code : public Object {
   // StubCode::UnknownDartCode() during snapshot deserialization.
   class DiscardedBit : public BitField<int32_t, bool, kDiscardedBit, 1> {};
 
+  // Set by precompiler if the function of this Code object was not executed
+  // while recording the AOT training profile (see --aot_profile). Cold code
+  // is placed after all other code in the snapshot.
+  class ColdBit : public BitField<int32_t, bool, kColdBit, 1> {};
+
   class PtrOffBits
       : public BitField<int32_t, intptr_t, kPtrOffBit, kPtrOffSize> {};
 
@@ -8339,6 +8491,15 @@ class TypeArguments : public Instance {
       return FindKeyOrUnused(data_, instantiator_tav, function_tav);
     }
 
+    // Looks up the instantiation for the given instantiator and function type
+    // arguments in the cache backed by [array] the same way the
+    // InstantiateTypeArguments stubs do, so the type arguments
+    // canonicalization mutex need not be held. Returns false on a miss.
+    static bool FindInstantiationNoLock(const Array& array,
+                                        const TypeArguments& instantiator_tav,
+                                        const TypeArguments& function_tav,
+                                        TypeArguments* result);
+
     // Returns whether the entry at the given index in the cache is occupied.
     bool IsOccupied(intptr_t entry) const;
 
@@ -10275,6 +10436,8 @@ class OneByteString : public AllStatic {
   friend class OneByteStringMessageSerializationCluster;
   friend class Deserializer;
   friend class JSONWriter;
+  friend class JsonDecoder;
+  friend class RegExpMacroAssembler;
 };
 
 class TwoByteString : public AllStatic {
@@ -10394,6 +10557,8 @@ class TwoByteString : public AllStatic {
   friend class Symbols;
   friend class TwoByteStringMessageSerializationCluster;
   friend class JSONWriter;
+  friend class JsonDecoder;
+  friend class RegExpMacroAssembler;
 };
 
 class ExternalOneByteString : public AllStatic {
@@ -10487,6 +10652,8 @@ class ExternalOneByteString : public AllStatic {
   friend class Symbols;
   friend class Utf8;
   friend class JSONWriter;
+  friend class JsonDecoder;
+  friend class RegExpMacroAssembler;
 };
 
 class ExternalTwoByteString : public AllStatic {
@@ -10575,6 +10742,8 @@ class ExternalTwoByteString : public AllStatic {
   friend class StringHasher;
   friend class Symbols;
   friend class JSONWriter;
+  friend class JsonDecoder;
+  friend class RegExpMacroAssembler;
 };
 
 // Matches null_patch.dart / bool_patch.dart.
@@ -10772,6 +10941,12 @@ class Array : public Instance {
   // during garbage collection.
   void Truncate(intptr_t new_length) const;
 
+  // Grows the array to 'new_length' without moving it, which is only possible
+  // if it is the last object allocated in the current thread's new-space
+  // allocation buffer and the buffer has room. The new elements are null.
+  // Returns false if the array was left unchanged.
+  bool TryGrowInPlace(intptr_t new_length) const;
+
   // Return an Array object that contains all the elements currently present
   // in the specified Growable Object Array. This is done by first truncating
   // the Growable Object Array's backing array to the currently used size and
@@ -11829,6 +12004,14 @@ class LinkedHashBase : public Instance {
   // and hash mask.
   void ComputeAndSetHashMask() const;
 
+  // Builds the index of an immutable map or set whose keys are all Strings,
+  // so that the first lookup does not have to rehash every key in Dart and
+  // the index is shared through snapshots. Does nothing for other keys, whose
+  // hash codes can only be computed in Dart. Requires ComputeAndSetHashMask.
+  //
+  // Keep in sync with _createIndex in lib/compact_hash.dart.
+  void PrecomputeIndex() const;
+
   virtual bool CanonicalizeEquals(const Instance& other) const;
   virtual uint32_t CanonicalizeHash() const;
   virtual void CanonicalizeFieldsLocked(Thread* thread) const;
@@ -11838,6 +12021,9 @@ class LinkedHashBase : public Instance {
   static constexpr intptr_t kInitialIndexBits = 2;
   static constexpr intptr_t kInitialIndexSize = 1 << (kInitialIndexBits + 1);
 
+  // The size of the index of an immutable map or set.
+  static intptr_t ImmutableIndexSize(intptr_t data_length, bool is_map);
+
  private:
   LinkedHashBasePtr ptr() const { return static_cast<LinkedHashBasePtr>(ptr_); }
   UntaggedLinkedHashBase* untag() const {
@@ -12530,6 +12716,16 @@ class RegExp : public Instance {
                     : &untag()->num_two_byte_registers_);
   }
 
+  // Counts one more execution in the bytecode interpreter and returns the
+  // number of executions so far. The count saturates at kMaxUint16.
+  intptr_t IncrementInterpretedExecutions() const;
+
+  // Whether the specialized function for subjects of class [cid] exists.
+  // Until then, the slot holds the bytecode used by the interpreter or null.
+  bool IsCompiled(intptr_t cid, bool sticky) const {
+    return function(cid, sticky)->GetClassId() == kFunctionCid;
+  }
+
   StringPtr pattern() const { return untag()->pattern(); }
   intptr_t num_bracket_expressions() const {
     return untag()->num_bracket_expressions_;
@@ -12612,6 +12808,15 @@ class RegExp : public Instance {
                     bool sticky,
                     const TypedData& bytecode) const;
 
+  // The program run by the linear-time engine, Object::sentinel() if the
+  // engine does not support the pattern, or null if it has not been compiled.
+  ObjectPtr linear_program() const {
+    return untag()->linear_program<std::memory_order_acquire>();
+  }
+  void set_linear_program(const Object& value) const {
+    untag()->set_linear_program<std::memory_order_release>(value.ptr());
+  }
+
   void set_num_bracket_expressions(SmiPtr value) const;
   void set_num_bracket_expressions(const Smi& value) const;
   void set_num_bracket_expressions(intptr_t value) const;
@@ -11,6 +11,7 @@
 #include "vm/native_symbol.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/os.h"
 #include "vm/profiler.h"
 #include "vm/raw_object.h"
 #include "vm/raw_object_fields.h"
@@ -500,6 +501,305 @@ intptr_t ObjectGraph::SizeReachableByClass(intptr_t class_id) {
   return total.size();
 }
 
+ClassRetainedSizes::ClassRetainedSizes(intptr_t num_cids)
+    : entries_(num_cids), timestamp_(OS::GetCurrentTimeMillis()) {
+  entries_.FillWith(Entry(), 0, num_cids);
+}
+
+// Numbers the objects in the order they are first visited, starting from 1,
+// and remembers the roots of the traversal.
+class NumberingVisitor : public ObjectGraph::Visitor {
+ public:
+  NumberingVisitor(WeakTable* ids,
+                   MallocGrowableArray<ObjectPtr>* objects,
+                   MallocGrowableArray<intptr_t>* roots)
+      : ids_(ids), objects_(objects), roots_(roots) {}
+
+  virtual Direction VisitObject(ObjectGraph::StackIterator* it) {
+    ObjectPtr obj = it->Get();
+    const intptr_t id = objects_->length();
+    objects_->Add(obj);
+    ids_->SetValueExclusive(obj, id);
+    if (!it->MoveToParent()) {
+      roots_->Add(id);
+    }
+    return kProceed;
+  }
+
+ private:
+  WeakTable* ids_;
+  MallocGrowableArray<ObjectPtr>* objects_;
+  MallocGrowableArray<intptr_t>* roots_;
+
+  DISALLOW_COPY_AND_ASSIGN(NumberingVisitor);
+};
+
+// Collects the numbers of the objects an object references.
+class SuccessorCollector : public ObjectPointerVisitor {
+ public:
+  SuccessorCollector(IsolateGroup* isolate_group,
+                     WeakTable* ids,
+                     MallocGrowableArray<intptr_t>* successors)
+      : ObjectPointerVisitor(isolate_group),
+        ids_(ids),
+        successors_(successors) {}
+
+  bool trace_values_through_fields() const override { return true; }
+
+  void VisitPointers(ObjectPtr* first, ObjectPtr* last) override {
+    for (ObjectPtr* current = first; current <= last; ++current) {
+      Add(*current);
+    }
+  }
+
+#if defined(DART_COMPRESSED_POINTERS)
+  void VisitCompressedPointers(uword heap_base,
+                               CompressedObjectPtr* first,
+                               CompressedObjectPtr* last) override {
+    for (CompressedObjectPtr* current = first; current <= last; ++current) {
+      Add(current->Decompress(heap_base));
+    }
+  }
+#endif
+
+ private:
+  void Add(ObjectPtr obj) {
+    if (!obj->IsHeapObject() || obj->untag()->InVMIsolateHeap()) {
+      return;
+    }
+    const intptr_t id = ids_->GetValueExclusive(obj);
+    if (id != 0) {
+      successors_->Add(id);
+    }
+  }
+
+  WeakTable* ids_;
+  MallocGrowableArray<intptr_t>* successors_;
+
+  DISALLOW_COPY_AND_ASSIGN(SuccessorCollector);
+};
+
+// Computes the immediate dominators of a graph given by [successors] with
+// the Semi-NCA algorithm (Georgiadis, "Linear-Time Algorithms for Dominators
+// and Related Problems"). The edges of node v are successors[start[v]] to
+// successors[start[v + 1] - 1], and node 0 is the root.
+//
+// Returns the nodes in depth-first preorder in [order] and the index in
+// [order] of the immediate dominator of order[i] in [idom][i], so that
+// idom[i] < i. Nodes that cannot be reached from the root are left out.
+static void ComputeDominators(const MallocGrowableArray<intptr_t>& start,
+                              const MallocGrowableArray<intptr_t>& successors,
+                              MallocGrowableArray<intptr_t>* order,
+                              MallocGrowableArray<intptr_t>* idom) {
+  const intptr_t num_nodes = start.length() - 1;
+  const intptr_t kUnvisited = -1;
+
+  // Number the nodes in depth-first preorder, remembering their parent in
+  // the depth-first spanning tree.
+  MallocGrowableArray<intptr_t> number(num_nodes);
+  number.FillWith(kUnvisited, 0, num_nodes);
+  MallocGrowableArray<intptr_t> parent(num_nodes);
+  {
+    // Pairs of (node, number of the node that pushed it).
+    MallocGrowableArray<intptr_t> stack;
+    stack.Add(0);
+    stack.Add(0);
+    while (!stack.is_empty()) {
+      const intptr_t from = stack.RemoveLast();
+      const intptr_t v = stack.RemoveLast();
+      if (number[v] != kUnvisited) {
+        continue;
+      }
+      number[v] = order->length();
+      order->Add(v);
+      parent.Add(from);
+      for (intptr_t e = start[v + 1] - 1; e >= start[v]; e--) {
+        const intptr_t w = successors[e];
+        if (number[w] == kUnvisited) {
+          stack.Add(w);
+          stack.Add(number[v]);
+        }
+      }
+    }
+  }
+  const intptr_t count = order->length();
+
+  // Invert the edges between reached nodes, by preorder number.
+  MallocGrowableArray<intptr_t> pred_start(count + 1);
+  pred_start.FillWith(0, 0, count + 1);
+  for (intptr_t v = 0; v < num_nodes; v++) {
+    if (number[v] == kUnvisited) continue;
+    for (intptr_t e = start[v]; e < start[v + 1]; e++) {
+      pred_start[number[successors[e]] + 1]++;
+    }
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    pred_start[i + 1] += pred_start[i];
+  }
+  MallocGrowableArray<intptr_t> predecessors(pred_start[count]);
+  predecessors.FillWith(0, 0, pred_start[count]);
+  {
+    MallocGrowableArray<intptr_t> next(count);
+    for (intptr_t i = 0; i < count; i++) {
+      next.Add(pred_start[i]);
+    }
+    for (intptr_t v = 0; v < num_nodes; v++) {
+      if (number[v] == kUnvisited) continue;
+      for (intptr_t e = start[v]; e < start[v + 1]; e++) {
+        predecessors[next[number[successors[e]]]++] = number[v];
+      }
+    }
+  }
+
+  // Compute the semidominators, evaluating paths in the forest of processed
+  // nodes with path compression.
+  MallocGrowableArray<intptr_t> semi(count);
+  MallocGrowableArray<intptr_t> label(count);
+  MallocGrowableArray<intptr_t> ancestor(count);
+  for (intptr_t i = 0; i < count; i++) {
+    semi.Add(i);
+    label.Add(i);
+    ancestor.Add(kUnvisited);
+  }
+  MallocGrowableArray<intptr_t> path;
+  for (intptr_t w = count - 1; w > 0; w--) {
+    for (intptr_t e = pred_start[w]; e < pred_start[w + 1]; e++) {
+      const intptr_t v = predecessors[e];
+      intptr_t u = v;
+      if (ancestor[v] != kUnvisited) {
+        // Compress the path from v to the root of its tree.
+        for (intptr_t a = v; ancestor[ancestor[a]] != kUnvisited;
+             a = ancestor[a]) {
+          path.Add(a);
+        }
+        while (!path.is_empty()) {
+          const intptr_t a = path.RemoveLast();
+          const intptr_t b = ancestor[a];
+          if (semi[label[b]] < semi[label[a]]) {
+            label[a] = label[b];
+          }
+          ancestor[a] = ancestor[b];
+        }
+        u = label[v];
+      }
+      semi[w] = Utils::Minimum(semi[w], semi[u]);
+    }
+    ancestor[w] = parent[w];
+  }
+
+  // The immediate dominator is the nearest ancestor in the spanning tree
+  // whose number is not greater than the semidominator.
+  idom->Add(0);
+  for (intptr_t w = 1; w < count; w++) {
+    intptr_t d = parent[w];
+    while (d > semi[w]) {
+      d = (*idom)[d];
+    }
+    idom->Add(d);
+  }
+}
+
+ClassRetainedSizes* ObjectGraph::RetainedSizesByClass() {
+  Thread* thread = Thread::Current();
+  HeapIterationScope iteration_scope(thread, true);
+  const intptr_t num_cids = isolate_group()->class_table()->NumCids();
+  ClassRetainedSizes* result = new ClassRetainedSizes(num_cids);
+
+  // Number the reachable objects. Node 0 stands for the isolate group roots
+  // and references all the objects that were reached from them directly.
+  WeakTable ids;
+  MallocGrowableArray<ObjectPtr> objects;
+  MallocGrowableArray<intptr_t> roots;
+  objects.Add(Object::null());
+  NumberingVisitor numbering(&ids, &objects, &roots);
+  IterateObjects(&numbering);
+  const intptr_t num_nodes = objects.length();
+  result->object_count_ = num_nodes - 1;
+
+  MallocGrowableArray<intptr_t> start(num_nodes + 1);
+  MallocGrowableArray<intptr_t> successors;
+  start.Add(0);
+  for (intptr_t i = 0; i < roots.length(); i++) {
+    successors.Add(roots[i]);
+  }
+  SuccessorCollector collector(isolate_group(), &ids, &successors);
+  for (intptr_t v = 1; v < num_nodes; v++) {
+    start.Add(successors.length());
+    objects[v]->untag()->VisitPointers(&collector);
+  }
+  start.Add(successors.length());
+
+  MallocGrowableArray<intptr_t> order(num_nodes);
+  MallocGrowableArray<intptr_t> idom(num_nodes);
+  ComputeDominators(start, successors, &order, &idom);
+  const intptr_t count = order.length();
+
+  // An object retains itself and everything it dominates.
+  MallocGrowableArray<intptr_t> retained(count);
+  MallocGrowableArray<intptr_t> cids(count);
+  retained.Add(0);
+  cids.Add(kIllegalCid);
+  for (intptr_t i = 1; i < count; i++) {
+    ObjectPtr obj = objects[order[i]];
+    const intptr_t size = obj->untag()->HeapSize();
+    const intptr_t cid = obj->GetClassId();
+    ASSERT(cid < num_cids);
+    retained.Add(size);
+    cids.Add(cid);
+    ClassRetainedSizes::Entry& entry = result->entries_[cid];
+    entry.instances++;
+    entry.shallow_size += size;
+  }
+  for (intptr_t i = count - 1; i > 0; i--) {
+    retained[idom[i]] += retained[i];
+  }
+
+  // A class retains what its outermost instances in the dominator tree
+  // retain: the instances dominated by another instance are already counted.
+  MallocGrowableArray<intptr_t> child_start(count + 1);
+  child_start.FillWith(0, 0, count + 1);
+  for (intptr_t i = 1; i < count; i++) {
+    child_start[idom[i] + 1]++;
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    child_start[i + 1] += child_start[i];
+  }
+  MallocGrowableArray<intptr_t> children(count);
+  children.FillWith(0, 0, count);
+  {
+    MallocGrowableArray<intptr_t> next(count);
+    for (intptr_t i = 0; i < count; i++) {
+      next.Add(child_start[i]);
+    }
+    for (intptr_t i = 1; i < count; i++) {
+      children[next[idom[i]]++] = i;
+    }
+  }
+  MallocGrowableArray<intptr_t> active(num_cids);
+  active.FillWith(0, 0, num_cids);
+  // Nodes to enter, and the complements of nodes to leave.
+  MallocGrowableArray<intptr_t> stack;
+  for (intptr_t e = child_start[0]; e < child_start[1]; e++) {
+    stack.Add(children[e]);
+  }
+  while (!stack.is_empty()) {
+    const intptr_t i = stack.RemoveLast();
+    if (i < 0) {
+      active[cids[~i]]--;
+      continue;
+    }
+    const intptr_t cid = cids[i];
+    if (active[cid]++ == 0) {
+      result->entries_[cid].retained_size += retained[i];
+    }
+    stack.Add(~i);
+    for (intptr_t e = child_start[i]; e < child_start[i + 1]; e++) {
+      stack.Add(children[e]);
+    }
+  }
+  return result;
+}
+
 class RetainingPathVisitor : public ObjectGraph::Visitor {
  public:
   // We cannot use a GrowableObjectArray, since we must not trigger GC.
@@ -849,6 +1149,29 @@ void HeapSnapshotWriter::SetupCountingPages() {
     counting_page->Clear();
     page = page->next();
   }
+
+  // Give new-space objects ids in side tables as well, rather than one entry
+  // each in the heap's object id table, which costs far more per object.
+  for (page = isolate_group()->heap()->new_space()->head(); page != nullptr;
+       page = page->next()) {
+    ASSERT(page->forwarding_page_ == nullptr);
+    CountingPage* counting_page =
+        reinterpret_cast<CountingPage*>(malloc(sizeof(CountingPage)));
+    counting_page->Clear();
+    page->forwarding_page_ = reinterpret_cast<ForwardingPage*>(counting_page);
+    new_counting_pages_.Add(counting_page);
+  }
+}
+
+void HeapSnapshotWriter::ReleaseCountingPages() {
+  for (Page* page = isolate_group()->heap()->new_space()->head();
+       page != nullptr; page = page->next()) {
+    page->forwarding_page_ = nullptr;
+  }
+  for (CountingPage* counting_page : new_counting_pages_) {
+    free(counting_page);
+  }
+  new_counting_pages_.Clear();
 }
 
 bool HeapSnapshotWriter::OnImagePage(ObjectPtr obj) const {
@@ -862,13 +1185,13 @@ bool HeapSnapshotWriter::OnImagePage(ObjectPtr obj) const {
 }
 
 CountingPage* HeapSnapshotWriter::FindCountingPage(ObjectPtr obj) const {
-  if (obj->IsOldObject() && !OnImagePage(obj)) {
-    // On a regular or large page.
+  if (obj->IsNewObject() || !OnImagePage(obj)) {
+    // On a new, regular or large page.
     Page* page = Page::Of(obj);
     return reinterpret_cast<CountingPage*>(page->forwarding_page());
   }
 
-  // On an image page or in new space.
+  // On an image page.
   return nullptr;
 }
 
@@ -883,7 +1206,7 @@ void HeapSnapshotWriter::AssignObjectId(ObjectPtr obj) {
     // Likely: object on an ordinary page.
     counting_page->Record(UntaggedObject::ToAddr(obj), ++object_count_);
   } else {
-    // Unlikely: new space object, or object on a large or image page.
+    // Unlikely: object on an image page or in the VM isolate.
     thread()->heap()->SetObjectId(obj, ++object_count_);
   }
 }
@@ -906,7 +1229,7 @@ intptr_t HeapSnapshotWriter::GetObjectId(ObjectPtr obj) const {
     // Likely: object on an ordinary page.
     id = counting_page->Lookup(UntaggedObject::ToAddr(obj));
   } else {
-    // Unlikely: new space object, or object on a large or image page.
+    // Unlikely: object on an image page or in the VM isolate.
     id = thread()->heap()->GetObjectId(obj);
   }
   ASSERT(id != 0);
@@ -1724,6 +2047,7 @@ void HeapSnapshotWriter::Write() {
   }
 
   ClearObjectIds();
+  ReleaseCountingPages();
   Flush(true);
 }
 
@@ -14,6 +14,7 @@
 namespace dart {
 
 class Array;
+class ClassRetainedSizes;
 class Object;
 class CountingPage;
 
@@ -94,6 +95,10 @@ class ObjectGraph : public ThreadStackResource {
   intptr_t SizeRetainedByClass(intptr_t class_id);
   intptr_t SizeReachableByClass(intptr_t class_id);
 
+  // The number, size and retained size of the instances of every class, all
+  // computed by a single traversal. The caller owns the result.
+  ClassRetainedSizes* RetainedSizesByClass();
+
   // Finds some retaining path from the isolate roots to 'obj'. Populates the
   // provided array with pairs of (object, offset from parent in words),
   // starting with 'obj' itself, as far as there is room. Returns the number
@@ -117,6 +122,42 @@ class ObjectGraph : public ThreadStackResource {
   DISALLOW_IMPLICIT_CONSTRUCTORS(ObjectGraph);
 };
 
+// The number, size and retained size of the instances of every class at some
+// point in time, computed from the dominator tree of the object graph.
+//
+// The retained size of an object is the size of the objects it dominates,
+// including itself. The retained size of a class sums the retained sizes of
+// its instances that are not dominated by another instance of the class, so
+// that no object is counted twice. Unlike ObjectGraph::SizeRetainedByClass,
+// it leaves out objects only retained by several instances together.
+class ClassRetainedSizes {
+ public:
+  struct Entry {
+    intptr_t instances = 0;
+    intptr_t shallow_size = 0;
+    intptr_t retained_size = 0;
+  };
+
+  explicit ClassRetainedSizes(intptr_t num_cids);
+
+  intptr_t num_cids() const { return entries_.length(); }
+  const Entry& At(intptr_t cid) const { return entries_[cid]; }
+
+  // The number of reachable objects.
+  intptr_t object_count() const { return object_count_; }
+
+  // When the sizes were computed, in milliseconds since the epoch.
+  int64_t timestamp() const { return timestamp_; }
+
+ private:
+  MallocGrowableArray<Entry> entries_;
+  intptr_t object_count_ = 0;
+  int64_t timestamp_;
+
+  friend class ObjectGraph;
+  DISALLOW_COPY_AND_ASSIGN(ClassRetainedSizes);
+};
+
 class ChunkedWriter : public ThreadStackResource {
  public:
   explicit ChunkedWriter(Thread* thread) : ThreadStackResource(thread) {}
@@ -246,6 +287,7 @@ class HeapSnapshotWriter : public ThreadStackResource {
   static constexpr intptr_t kPreferredChunkSize = MB;
 
   void SetupCountingPages();
+  void ReleaseCountingPages();
   bool OnImagePage(ObjectPtr obj) const;
   CountingPage* FindCountingPage(ObjectPtr obj) const;
 
@@ -274,6 +316,10 @@ class HeapSnapshotWriter : public ThreadStackResource {
 
   MallocGrowableArray<SmiPtr> smis_;
 
+  // Counting pages allocated for new-space pages, which unlike old-space pages
+  // have no forwarding page to reuse.
+  MallocGrowableArray<CountingPage*> new_counting_pages_;
+
   DISALLOW_COPY_AND_ASSIGN(HeapSnapshotWriter);
 };
 
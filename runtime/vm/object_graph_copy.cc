@@ -146,6 +146,8 @@ static ObjectPtr Marker() {
   return Object::unknown_constant().ptr();
 }
 
+static bool IsDeeplyImmutableInstance(ObjectPtr obj, classid_t cid);
+
 DART_FORCE_INLINE
 static bool CanShareObject(ObjectPtr obj, uword tags) {
   if ((tags & UntaggedObject::CanonicalBit::mask_in_place()) != 0) {
@@ -170,9 +172,66 @@ static bool CanShareObject(ObjectPtr obj, uword tags) {
     return Closure::RawCast(obj)->untag()->context() == Object::null();
   }
 
+  if (cid >= kNumPredefinedCids) {
+    return IsDeeplyImmutableInstance(obj, cid);
+  }
+
   return false;
 }
 
+// Whether [root] is an instance of a `@pragma('vm:deeply-immutable')` class
+// whose fields transitively only refer to objects that can be shared.
+//
+// As such instances cannot change once constructed, each validated instance
+// gets the immutability bit set so that it is only validated once. Instances
+// are only marked after their whole subgraph was validated, so a failed
+// validation never leaves mutable objects marked.
+static bool IsDeeplyImmutableInstance(ObjectPtr root, classid_t cid) {
+  ClassTable* class_table = IsolateGroup::Current()->class_table();
+  if (!Class::IsDeeplyImmutable(class_table->At(cid))) {
+    return false;
+  }
+  const uword heap_base = root.heap_base();
+  // Instances being validated and the offset of their next field to check.
+  MallocGrowableArray<std::pair<ObjectPtr, intptr_t>> stack;
+  stack.Add({root, kWordSize});
+  while (!stack.is_empty()) {
+    const ObjectPtr obj = stack.Last().first;
+    const intptr_t instance_size = obj.untag()->HeapSize();
+    const auto bitmap = class_table->GetUnboxedFieldsMapAt(obj->GetClassId());
+    ObjectPtr child = Object::null();
+    intptr_t offset = stack.Last().second;
+    for (; offset < instance_size; offset += kCompressedWordSize) {
+      if (bitmap.Get(offset / kCompressedWordSize)) continue;
+      const ObjectPtr value =
+          reinterpret_cast<CompressedObjectPtr*>(
+              reinterpret_cast<uword>(obj.untag()) + offset)
+              ->Decompress(heap_base);
+      if (!value->IsHeapObject()) continue;
+      const uword tags = TagsFromUntaggedObject(value.untag());
+      const intptr_t value_cid = UntaggedObject::ClassIdTag::decode(tags);
+      if (((tags & UntaggedObject::ImmutableBit::mask_in_place()) == 0) &&
+          (value_cid >= kNumPredefinedCids) &&
+          Class::IsDeeplyImmutable(class_table->At(value_cid))) {
+        child = value;
+        break;
+      }
+      if (!CanShareObject(value, tags)) {
+        return false;
+      }
+    }
+    if (child != Object::null()) {
+      // Final fields cannot form cycles, so the child is not on the stack.
+      stack.Last().second = offset + kCompressedWordSize;
+      stack.Add({child, kWordSize});
+      continue;
+    }
+    obj.untag()->SetImmutable();
+    stack.RemoveLast();
+  }
+  return true;
+}
+
 bool CanShareObjectAcrossIsolates(ObjectPtr obj) {
   if (!obj->IsHeapObject()) return true;
   const uword tags = TagsFromUntaggedObject(obj.untag());
@@ -2330,6 +2389,10 @@ class ObjectGraphCopier : public StackResource {
 
   intptr_t copied_objects() { return copied_objects_; }
 
+  // The number of objects copied before falling back to the slow path, which
+  // allocates into old space and checks into safepoints.
+  intptr_t fast_copied_objects() { return fast_copied_objects_; }
+
  private:
   ObjectPtr CopyObjectGraphInternal(const Object& root,
                                     const char* volatile* exception_msg) {
@@ -2375,6 +2438,7 @@ class ObjectGraphCopier : public StackResource {
             copied_objects_ =
                 fast_object_copy_.fast_forward_map_.fill_cursor_ / 2 -
                 /*null_entry=*/1;
+            fast_copied_objects_ = copied_objects_;
             return result_array.ptr();
           }
 
@@ -2440,6 +2504,7 @@ class ObjectGraphCopier : public StackResource {
     HandlifyFromToObjects();
     slow_forward_map.fill_cursor_ = fast_forward_map.fill_cursor_;
     slow_forward_map.allocated_bytes = fast_forward_map.allocated_bytes;
+    fast_copied_objects_ = fast_forward_map.fill_cursor_ / 2 - /*null_entry=*/1;
   }
 
   void MakeUninitializedNewSpaceObjectsGCSafe() {
@@ -2521,6 +2586,11 @@ class ObjectGraphCopier : public StackResource {
     from_to = GrowableObjectArray::New(length, Heap::kOld);
     for (intptr_t i = 0; i < length; i++) {
       from_to.Add(*from_to_transition[i]);
+      // The fast path may have filled all of new space, so the objects are
+      // many. They are all handlified at this point.
+      if (((i + 1) % KB) == 0) {
+        thread_->CheckForSafepoint();
+      }
     }
     ASSERT(from_to.Length() == length);
     from_to_transition.Clear();
@@ -2540,6 +2610,7 @@ class ObjectGraphCopier : public StackResource {
   FastObjectCopy fast_object_copy_;
   SlowObjectCopy slow_object_copy_;
   intptr_t copied_objects_ = 0;
+  intptr_t fast_copied_objects_ = 0;
   intptr_t allocated_bytes_ = 0;
 };
 
@@ -2550,9 +2621,11 @@ ObjectPtr CopyMutableObjectGraph(const Object& object) {
   ObjectPtr result = copier.CopyObjectGraph(object);
 #if defined(SUPPORT_TIMELINE)
   if (tbes.enabled()) {
-    tbes.SetNumArguments(2);
+    tbes.SetNumArguments(3);
     tbes.FormatArgument(0, "CopiedObjects", "%" Pd, copier.copied_objects());
     tbes.FormatArgument(1, "AllocatedBytes", "%" Pd, copier.allocated_bytes());
+    tbes.FormatArgument(2, "FastCopiedObjects", "%" Pd,
+                        copier.fast_copied_objects());
   }
 #endif
   return result;
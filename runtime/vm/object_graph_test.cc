@@ -3,7 +3,12 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/object_graph.h"
+
+#include <memory>
+
 #include "platform/assert.h"
+#include "vm/dart_api_impl.h"
+#include "vm/symbols.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -190,6 +195,55 @@ ISOLATE_UNIT_TEST_CASE(RetainingPathGCRoot) {
   EXPECT_STREQ(result.gc_root_type, "local handle");
 }
 
+TEST_CASE(RetainedSizesByClass) {
+  const char* kScript = R"(
+    class Leaf {
+      final data = List<int>.filled(100, 0);
+    }
+    class Node {
+      final Node? next;
+      final leaf = Leaf();
+      Node(this.next);
+    }
+    var chain;
+    var shared;
+    main() {
+      chain = Node(Node(Node(null)));
+      shared = Leaf();
+    }
+  )";
+  Dart_Handle api_lib = TestCase::LoadTestScript(kScript, nullptr);
+  EXPECT_VALID(api_lib);
+  EXPECT_VALID(Dart_Invoke(api_lib, NewString("main"), 0, nullptr));
+
+  TransitionNativeToVM transition(thread);
+  Library& lib = Library::Handle();
+  lib ^= Api::UnwrapHandle(api_lib);
+  const Class& node_class = Class::Handle(
+      lib.LookupClass(String::Handle(Symbols::New(thread, "Node"))));
+  const Class& leaf_class = Class::Handle(
+      lib.LookupClass(String::Handle(Symbols::New(thread, "Leaf"))));
+  ASSERT(!node_class.IsNull() && !leaf_class.IsNull());
+
+  ObjectGraph graph(thread);
+  std::unique_ptr<ClassRetainedSizes> sizes(graph.RetainedSizesByClass());
+  EXPECT_LT(0, sizes->object_count());
+  const ClassRetainedSizes::Entry& node = sizes->At(node_class.id());
+  const ClassRetainedSizes::Entry& leaf = sizes->At(leaf_class.id());
+  EXPECT_EQ(3, node.instances);
+  EXPECT_EQ(4, leaf.instances);
+
+  // Each leaf retains its list, and no leaf retains another.
+  EXPECT_LT(leaf.shallow_size, leaf.retained_size);
+  EXPECT_EQ(graph.SizeRetainedByClass(leaf_class.id()), leaf.retained_size);
+
+  // The outermost node retains the whole chain, which holds three of the four
+  // leaves. The inner nodes are not counted again.
+  EXPECT_EQ(4 * (node.retained_size - node.shallow_size),
+            3 * leaf.retained_size);
+  EXPECT_EQ(graph.SizeRetainedByClass(node_class.id()), node.retained_size);
+}
+
 #endif  // !defined(PRODUCT)
 
 }  // namespace dart
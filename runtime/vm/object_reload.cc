@@ -218,6 +218,12 @@ void Class::CopyStaticFieldValues(ProgramReloadContext* reload_context,
             // old and new code see and update same value.
             reload_context->isolate_group()->FreeStaticField(field);
             field.set_field_id_unsafe(old_field.field_id());
+            if (field.has_nontrivial_initializer()) {
+              // The old initializer may have left its value in the initial
+              // field table. New isolates have to run the new initializer.
+              reload_context->isolate_group()->initial_field_table()->SetAt(
+                  field.field_id(), Object::sentinel().ptr());
+            }
           }
           reload_context->AddStaticFieldMapping(old_field, field);
         }
@@ -10,6 +10,7 @@
 #include "vm/object_graph.h"
 #include "vm/object_store.h"
 #include "vm/resolver.h"
+#include "vm/runtime_entry.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
 
@@ -339,6 +340,19 @@ void Function::AddFunctionServiceId(const JSONObject& jsobj) const {
   jsobj.AddServiceId(*this);
 }
 
+// Adds the names of the deoptimization [reasons] recorded in ICData as a
+// "_deoptReasons" list.
+static void AddDeoptReasons(JSONObject* jsobj, uint32_t reasons) {
+  if (reasons == 0) return;
+  JSONArray jsarr(jsobj, "_deoptReasons");
+  for (intptr_t i = 0; i <= ICData::kLastRecordedDeoptReason; i++) {
+    if ((reasons & (1 << i)) != 0) {
+      jsarr.AddValue(
+          DeoptReasonToCString(static_cast<ICData::DeoptReasonId>(i)));
+    }
+  }
+}
+
 void Function::PrintJSONImpl(JSONStream* stream, bool ref) const {
   Class& cls = Class::Handle(Owner());
   ASSERT(!cls.IsNull());
@@ -408,6 +422,18 @@ void Function::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("_optimizedCallSiteCount", optimized_call_site_count());
   jsobj.AddProperty("_deoptimizations",
                     static_cast<intptr_t>(deoptimization_counter()));
+  if (!ics.IsNull()) {
+    // The deoptimization reasons of all call sites, which tell why a
+    // function that deoptimizes repeatedly does so.
+    uint32_t deopt_reasons = 0;
+    ICData& ic_data = ICData::Handle();
+    for (intptr_t i = ICDataArrayIndices::kFirstICData; i < ics.Length();
+         i++) {
+      ic_data ^= ics.At(i);
+      deopt_reasons |= ic_data.DeoptReasons();
+    }
+    AddDeoptReasons(&jsobj, deopt_reasons);
+  }
   if ((kind() == UntaggedFunction::kImplicitGetter) ||
       (kind() == UntaggedFunction::kImplicitSetter) ||
       (kind() == UntaggedFunction::kImplicitStaticGetter) ||
@@ -989,6 +1015,7 @@ void ICData::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("_argumentsDescriptor",
                     Object::Handle(arguments_descriptor()));
   jsobj.AddProperty("_entries", Object::Handle(entries()));
+  AddDeoptReasons(&jsobj, DeoptReasons());
 }
 
 void ICData::PrintToJSONArray(const JSONArray& jsarray,
@@ -1000,8 +1027,7 @@ void ICData::PrintToJSONArray(const JSONArray& jsarray,
   JSONObject jsobj(&jsarray);
   jsobj.AddProperty("name", String::Handle(target_name()).ToCString());
   jsobj.AddProperty("tokenPos", static_cast<intptr_t>(token_pos.Serialize()));
-  // TODO(rmacnak): Figure out how to stringify DeoptReasons().
-  // jsobj.AddProperty("deoptReasons", ...);
+  AddDeoptReasons(&jsobj, DeoptReasons());
 
   JSONArray cache_entries(&jsobj, "cacheEntries");
   for (intptr_t i = 0; i < NumberOfChecks(); i++) {
@@ -1974,34 +2000,36 @@ void RegExp::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("isCaseSensitive", !flags().IgnoreCase());
   jsobj.AddProperty("isMultiLine", flags().IsMultiLine());
 
-  if (!FLAG_interpret_irregexp) {
-    Function& func = Function::Handle();
-    func = function(kOneByteStringCid, /*sticky=*/false);
-    jsobj.AddProperty("_oneByteFunction", func);
-    func = function(kTwoByteStringCid, /*sticky=*/false);
-    jsobj.AddProperty("_twoByteFunction", func);
-    func = function(kExternalOneByteStringCid, /*sticky=*/false);
-    jsobj.AddProperty("_externalOneByteFunction", func);
-    func = function(kExternalTwoByteStringCid, /*sticky=*/false);
-    jsobj.AddProperty("_externalTwoByteFunction", func);
-    func = function(kOneByteStringCid, /*sticky=*/true);
-    jsobj.AddProperty("_oneByteFunctionSticky", func);
-    func = function(kTwoByteStringCid, /*sticky=*/true);
-    jsobj.AddProperty("_twoByteFunctionSticky", func);
-    func = function(kExternalOneByteStringCid, /*sticky=*/true);
-    jsobj.AddProperty("_externalOneByteFunctionSticky", func);
-    func = function(kExternalTwoByteStringCid, /*sticky=*/true);
-    jsobj.AddProperty("_externalTwoByteFunctionSticky", func);
-  } else {
-    TypedData& bc = TypedData::Handle();
-    bc = bytecode(/*is_one_byte=*/true, /*sticky=*/false);
-    jsobj.AddProperty("_oneByteBytecode", bc);
-    bc = bytecode(/*is_one_byte=*/false, /*sticky=*/false);
-    jsobj.AddProperty("_twoByteBytecode", bc);
-    bc = bytecode(/*is_one_byte=*/true, /*sticky=*/true);
-    jsobj.AddProperty("_oneByteBytecodeSticky", bc);
-    bc = bytecode(/*is_one_byte=*/false, /*sticky=*/true);
-    jsobj.AddProperty("_twoByteBytecodeSticky", bc);
+  struct CodeSlot {
+    intptr_t cid;
+    bool sticky;
+    const char* function_name;
+    const char* bytecode_name;
+  };
+  const CodeSlot kCodeSlots[] = {
+      {kOneByteStringCid, false, "_oneByteFunction", "_oneByteBytecode"},
+      {kTwoByteStringCid, false, "_twoByteFunction", "_twoByteBytecode"},
+      {kExternalOneByteStringCid, false, "_externalOneByteFunction", nullptr},
+      {kExternalTwoByteStringCid, false, "_externalTwoByteFunction", nullptr},
+      {kOneByteStringCid, true, "_oneByteFunctionSticky",
+       "_oneByteBytecodeSticky"},
+      {kTwoByteStringCid, true, "_twoByteFunctionSticky",
+       "_twoByteBytecodeSticky"},
+      {kExternalOneByteStringCid, true, "_externalOneByteFunctionSticky",
+       nullptr},
+      {kExternalTwoByteStringCid, true, "_externalTwoByteFunctionSticky",
+       nullptr},
+  };
+  // Each slot holds either the specialized function or, until the regexp is
+  // compiled, the bytecode run by the interpreter.
+  Object& code = Object::Handle();
+  for (const CodeSlot& slot : kCodeSlots) {
+    code = function(slot.cid, slot.sticky);
+    if (code.IsFunction()) {
+      jsobj.AddProperty(slot.function_name, code);
+    } else if (slot.bytecode_name != nullptr) {
+      jsobj.AddProperty(slot.bytecode_name, code);
+    }
   }
 }
 
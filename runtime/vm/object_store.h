@@ -276,6 +276,7 @@ class ObjectPointerVisitor;
   RW(Code, type_parameter_tts_stub)                                            \
   RW(Code, unreachable_tts_stub)                                               \
   RW(Array, ffi_callback_functions)                                            \
+  RW(Array, aot_coverage_table)                                                \
   RW(Code, slow_tts_stub)                                                      \
   /* Roots for JIT/AOT snapshots are up until here (see to_snapshot() below)*/ \
   RW(Code, await_stub)                                                         \
@@ -1853,6 +1853,21 @@ ISOLATE_UNIT_TEST_CASE(Symbol) {
   EXPECT_EQ(elf2.ptr(), Symbols::New(thread, "Elf"));
 }
 
+ISOLATE_UNIT_TEST_CASE(Symbol_FromOldString) {
+  // A new symbol can be the old string itself.
+  const String& fresh =
+      String::Handle(String::New("SymbolFromOldString", Heap::kOld));
+  const String& symbol = String::Handle(Symbols::New(thread, fresh));
+  EXPECT_EQ(fresh.ptr(), symbol.ptr());
+  EXPECT(fresh.IsCanonical());
+
+  // An old string equal to an existing symbol is left alone.
+  const String& copy =
+      String::Handle(String::New("SymbolFromOldString", Heap::kOld));
+  EXPECT_EQ(symbol.ptr(), Symbols::New(thread, copy));
+  EXPECT(!copy.IsCanonical());
+}
+
 ISOLATE_UNIT_TEST_CASE(SymbolUnicode) {
   uint16_t monkey_utf16[] = {0xd83d, 0xdc35};  // Unicode Monkey Face.
   String& monkey = String::Handle(Symbols::FromUTF16(thread, monkey_utf16, 2));
@@ -1952,6 +1967,40 @@ ISOLATE_UNIT_TEST_CASE(Array_Grow) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(Array_TryGrowInPlace) {
+  const intptr_t kSmallSize = 10;
+  const intptr_t kGrownSize = 25;
+  const Array& array = Array::Handle(Array::New(kSmallSize));
+  // Only the last allocation can grow, and only if the allocation buffer has
+  // room left.
+  if (thread->end() - thread->top() >=
+      static_cast<uword>(Array::InstanceSize(kGrownSize))) {
+    for (intptr_t i = 0; i < kSmallSize; i++) {
+      array.SetAt(i, Smi::Handle(Smi::New(i)));
+    }
+    EXPECT(array.TryGrowInPlace(kGrownSize));
+    EXPECT_EQ(kGrownSize, array.Length());
+    EXPECT_EQ(Array::InstanceSize(kGrownSize),
+              array.ptr()->untag()->HeapSize());
+    for (intptr_t i = 0; i < kSmallSize; i++) {
+      EXPECT_EQ(Smi::New(i), array.At(i));
+    }
+    for (intptr_t i = kSmallSize; i < kGrownSize; i++) {
+      EXPECT_EQ(Object::null(), array.At(i));
+    }
+  }
+
+  const Array& other = Array::Handle(Array::New(kSmallSize));
+  EXPECT(!other.IsNull());
+  const intptr_t length = array.Length();
+  EXPECT(!array.TryGrowInPlace(length + 10));
+  EXPECT_EQ(length, array.Length());
+
+  const Array& old_array = Array::Handle(Array::New(kSmallSize, Heap::kOld));
+  EXPECT(!old_array.TryGrowInPlace(kGrownSize));
+  EXPECT_EQ(kSmallSize, old_array.Length());
+}
+
 ISOLATE_UNIT_TEST_CASE(EmptyInstantiationsCacheArray) {
   SafepointMutexLocker ml(
       thread->isolate_group()->type_arguments_canonicalization_mutex());
@@ -7151,6 +7200,28 @@ void init() {
   HashMapNonConstEqualsConst(kScript);
 }
 
+TEST_CASE(ConstMap_stringKeys) {
+  const char* kScript = R"(
+const keys = <String>[
+  'alpha', 'beta', 'gamma', 'delta', 'epsilon', 'zeta', 'eta', 'theta',
+  'iota', 'kappa', 'lambda', 'mu', 'nu', 'xi', 'omicron', 'pi',
+];
+
+constValue() => const {
+  'alpha': 0, 'beta': 1, 'gamma': 2, 'delta': 3, 'epsilon': 4, 'zeta': 5,
+  'eta': 6, 'theta': 7, 'iota': 8, 'kappa': 9, 'lambda': 10, 'mu': 11,
+  'nu': 12, 'xi': 13, 'omicron': 14, 'pi': 15,
+};
+
+nonConstValue() => {for (var i = 0; i < keys.length; i++) keys[i]: i};
+
+void init() {
+  // No lookup: the index of the constant map is built when it is loaded.
+}
+)";
+  HashMapNonConstEqualsConst(kScript);
+}
+
 TEST_CASE(ConstMap_nested) {
   const char* kScript = R"(
 enum Abi {
@@ -7405,6 +7476,19 @@ void init() {
   HashSetNonConstEqualsConst(kScript);
 }
 
+TEST_CASE(ConstSet_stringKeys) {
+  const char* kScript = R"(
+constValue() => const {'a', 'bb', 'ccc', 'dddd', 'eeeee', 'f', 'gg', 'hhh'};
+
+nonConstValue() => {'a', 'bb', 'ccc', 'dddd', 'eeeee', 'f', 'gg', 'hhh'};
+
+void init() {
+  // No lookup: the index of the constant set is built when it is loaded.
+}
+)";
+  HashSetNonConstEqualsConst(kScript);
+}
+
 TEST_CASE(OneByteStringExternalEqualsInternal) {
   const char* kScript = R"(
 makeInternalString() {
@@ -69,6 +69,10 @@ class OS {
   // Returns number of available processor cores.
   static int NumberOfAvailableProcessors();
 
+  // Returns the memory limit in bytes that the process's container (cgroup)
+  // imposes, or 0 if there is none below the physical memory.
+  static int64_t GetMemoryLimit();
+
   // Sleep the currently executing thread for millis ms.
   static void Sleep(int64_t millis);
 
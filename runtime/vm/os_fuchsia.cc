@@ -473,6 +473,10 @@ int OS::NumberOfAvailableProcessors() {
   return sysconf(_SC_NPROCESSORS_CONF);
 }
 
+int64_t OS::GetMemoryLimit() {
+  return 0;
+}
+
 void OS::Sleep(int64_t millis) {
   SleepMicros(millis * kMicrosecondsPerMillisecond);
 }
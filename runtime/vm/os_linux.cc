@@ -520,6 +520,44 @@ int OS::NumberOfAvailableProcessors() {
   return sysconf(_SC_NPROCESSORS_ONLN);
 }
 
+// Returns the limit in a cgroup memory controller file, which holds either a
+// number of bytes or "max", or 0 if there is no such file.
+static int64_t ReadCgroupMemoryLimit(const char* path) {
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) {
+    return 0;
+  }
+  char buffer[32];
+  int64_t limit = 0;
+  if (fgets(buffer, sizeof(buffer), file) != nullptr) {
+    char* end = nullptr;
+    errno = 0;
+    const int64_t value = strtoll(buffer, &end, 10);
+    if ((errno == 0) && (end != buffer) && (value > 0)) {
+      limit = value;
+    }
+  }
+  fclose(file);
+  return limit;
+}
+
+int64_t OS::GetMemoryLimit() {
+  // cgroup v2, then v1. Inside a container these are the container's own
+  // limits.
+  int64_t limit = ReadCgroupMemoryLimit("/sys/fs/cgroup/memory.max");
+  if (limit == 0) {
+    limit = ReadCgroupMemoryLimit(
+        "/sys/fs/cgroup/memory/memory.limit_in_bytes");
+  }
+  // cgroup v1 reports no limit as a huge number.
+  const int64_t physical =
+      static_cast<int64_t>(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGESIZE);
+  if ((physical > 0) && (limit >= physical)) {
+    return 0;
+  }
+  return limit;
+}
+
 void OS::Sleep(int64_t millis) {
   int64_t micros = millis * kMicrosecondsPerMillisecond;
   SleepMicros(micros);
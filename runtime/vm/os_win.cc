@@ -192,6 +192,10 @@ int OS::NumberOfAvailableProcessors() {
   return info.dwNumberOfProcessors;
 }
 
+int64_t OS::GetMemoryLimit() {
+  return 0;
+}
+
 void OS::Sleep(int64_t millis) {
   ::Sleep(millis);
 }
@@ -18,7 +18,7 @@
 namespace dart {
 
 Mutex* PortMap::mutex_ = nullptr;
-PortSet<PortMap::Entry>* PortMap::ports_ = nullptr;
+PortMap::Shard* PortMap::shards_ = nullptr;
 MessageHandler* PortMap::deleted_entry_ = reinterpret_cast<MessageHandler*>(1);
 Random* PortMap::prng_ = nullptr;
 
@@ -62,21 +62,39 @@ Dart_Port PortMap::AllocatePort() {
     }
 
     ASSERT(!static_cast<ObjectPtr>(static_cast<uword>(result))->IsWellFormed());
-  } while (ports_->Contains(result));
+  } while (IsUsedPort(result));
 
   ASSERT(result != 0);
-  ASSERT(!ports_->Contains(result));
   return result;
 }
 
+PortMap::PortState PortMap::GetPortState(Dart_Port port) {
+  ASSERT(mutex_->IsOwnedByCurrentThread());
+  Shard* shard = ShardFor(port);
+  MutexLocker ml(&shard->mutex);
+  ASSERT(shard->ports != nullptr);
+  auto it = shard->ports->TryLookup(port);
+  ASSERT(it != shard->ports->end());
+  return (*it).state;
+}
+
+bool PortMap::IsUsedPort(Dart_Port port) {
+  ASSERT(mutex_->IsOwnedByCurrentThread());
+  Shard* shard = ShardFor(port);
+  MutexLocker ml(&shard->mutex);
+  return shard->ports->Contains(port);
+}
+
 void PortMap::SetPortState(Dart_Port port, PortState state) {
   MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(port);
+  MutexLocker shard_locker(&shard->mutex);
+  if (shard->ports == nullptr) {
     return;
   }
 
-  auto it = ports_->TryLookup(port);
-  ASSERT(it != ports_->end());
+  auto it = shard->ports->TryLookup(port);
+  ASSERT(it != shard->ports->end());
 
   Entry& entry = *it;
   PortState old_state = entry.state;
@@ -99,7 +117,7 @@ void PortMap::SetPortState(Dart_Port port, PortState state) {
 Dart_Port PortMap::CreatePort(MessageHandler* handler) {
   ASSERT(handler != nullptr);
   MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  if (shards_[0].ports == nullptr) {
     return ILLEGAL_PORT;
   }
 
@@ -119,7 +137,11 @@ Dart_Port PortMap::CreatePort(MessageHandler* handler) {
   entry.port = port;
   entry.handler = handler;
   entry.state = kNewPort;
-  ports_->Insert(entry);
+  {
+    Shard* shard = ShardFor(port);
+    MutexLocker shard_locker(&shard->mutex);
+    shard->ports->Insert(entry);
+  }
 
   if (FLAG_trace_isolates) {
     OS::PrintErr(
@@ -136,11 +158,13 @@ bool PortMap::ClosePort(Dart_Port port) {
   MessageHandler* handler = nullptr;
   {
     MutexLocker ml(mutex_);
-    if (ports_ == nullptr) {
+    Shard* shard = ShardFor(port);
+    MutexLocker shard_locker(&shard->mutex);
+    if (shard->ports == nullptr) {
       return false;
     }
-    auto it = ports_->TryLookup(port);
-    if (it == ports_->end()) {
+    auto it = shard->ports->TryLookup(port);
+    if (it == shard->ports->end()) {
       return false;
     }
     Entry entry = *it;
@@ -158,7 +182,7 @@ bool PortMap::ClosePort(Dart_Port port) {
     // Delete the port entry before releasing the lock to avoid holding the lock
     // while flushing the messages below.
     it.Delete();
-    ports_->Rebalance();
+    shard->ports->Rebalance();
 
     // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
     // by the [PortMap::mutex_] we already hold.
@@ -178,15 +202,17 @@ bool PortMap::ClosePort(Dart_Port port) {
 void PortMap::ClosePorts(MessageHandler* handler) {
   {
     MutexLocker ml(mutex_);
-    if (ports_ == nullptr) {
+    if (shards_[0].ports == nullptr) {
       return;
     }
     // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
     // by the [PortMap::mutex_] we already hold.
     for (auto isolate_it = handler->ports_.begin();
          isolate_it != handler->ports_.end(); ++isolate_it) {
-      auto it = ports_->TryLookup((*isolate_it).port);
-      ASSERT(it != ports_->end());
+      Shard* shard = ShardFor((*isolate_it).port);
+      MutexLocker shard_locker(&shard->mutex);
+      auto it = shard->ports->TryLookup((*isolate_it).port);
+      ASSERT(it != shard->ports->end());
       Entry entry = *it;
       ASSERT(entry.port == (*isolate_it).port);
       ASSERT(entry.handler == handler);
@@ -194,22 +220,25 @@ void PortMap::ClosePorts(MessageHandler* handler) {
         handler->decrement_live_ports();
       }
       it.Delete();
+      shard->ports->Rebalance();
       isolate_it.Delete();
     }
     ASSERT(handler->ports_.IsEmpty());
-    ports_->Rebalance();
   }
   handler->CloseAllPorts();
 }
 
 bool PortMap::PostMessage(std::unique_ptr<Message> message,
                           bool before_events) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  // Only the shard of the port is locked: the entry (and so the handler)
+  // cannot be removed while the message is enqueued.
+  Shard* shard = ShardFor(message->dest_port());
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(message->dest_port());
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(message->dest_port());
+  if (it == shard->ports->end()) {
     // Ownership of external data remains with the poster.
     message->DropFinalizers();
     return false;
@@ -221,12 +250,13 @@ bool PortMap::PostMessage(std::unique_ptr<Message> message,
 }
 
 bool PortMap::IsLocalPort(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(id);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(id);
+  if (it == shard->ports->end()) {
     // Port does not exist.
     return false;
   }
@@ -237,12 +267,13 @@ bool PortMap::IsLocalPort(Dart_Port id) {
 }
 
 bool PortMap::IsLivePort(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(id);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(id);
+  if (it == shard->ports->end()) {
     // Port does not exist.
     return false;
   }
@@ -252,12 +283,13 @@ bool PortMap::IsLivePort(Dart_Port id) {
 }
 
 Isolate* PortMap::GetIsolate(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(id);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return nullptr;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(id);
+  if (it == shard->ports->end()) {
     // Port does not exist.
     return nullptr;
   }
@@ -267,12 +299,13 @@ Isolate* PortMap::GetIsolate(Dart_Port id) {
 }
 
 Dart_Port PortMap::GetOriginId(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(id);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return ILLEGAL_PORT;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(id);
+  if (it == shard->ports->end()) {
     // Port does not exist.
     return ILLEGAL_PORT;
   }
@@ -288,13 +321,14 @@ Dart_Port PortMap::GetOriginId(Dart_Port id) {
 
 bool PortMap::IsReceiverInThisIsolateGroupOrClosed(Dart_Port receiver,
                                                    IsolateGroup* group) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(receiver);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     // Port was closed.
     return true;
   }
-  auto it = ports_->TryLookup(receiver);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(receiver);
+  if (it == shard->ports->end()) {
     // Port was closed.
     return true;
   }
@@ -314,31 +348,44 @@ void PortMap::Init() {
   if (prng_ == nullptr) {
     prng_ = new Random();
   }
-  if (ports_ == nullptr) {
-    ports_ = new PortSet<Entry>();
+  if (shards_ == nullptr) {
+    shards_ = new Shard[kNumShards];
+  }
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    MutexLocker ml(&shards_[i].mutex);
+    if (shards_[i].ports == nullptr) {
+      shards_[i].ports = new PortSet<Entry>();
+    }
   }
 }
 
 void PortMap::Cleanup() {
-  ASSERT(ports_ != nullptr);
+  ASSERT(shards_ != nullptr);
   ASSERT(prng_ != nullptr);
-  for (auto it = ports_->begin(); it != ports_->end(); ++it) {
-    const auto& entry = *it;
-    ASSERT(entry.handler != nullptr);
-    if (entry.state == kLivePort) {
-      entry.handler->decrement_live_ports();
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    PortSet<Entry>* ports = shards_[i].ports;
+    ASSERT(ports != nullptr);
+    for (auto it = ports->begin(); it != ports->end(); ++it) {
+      const auto& entry = *it;
+      ASSERT(entry.handler != nullptr);
+      if (entry.state == kLivePort) {
+        entry.handler->decrement_live_ports();
+      }
+      delete entry.handler;
+      it.Delete();
     }
-    delete entry.handler;
-    it.Delete();
+    ports->Rebalance();
   }
-  ports_->Rebalance();
 
-  // Grab the mutex and delete the port set.
+  // Grab the mutexes and delete the port sets.
   MutexLocker ml(mutex_);
   delete prng_;
   prng_ = nullptr;
-  delete ports_;
-  ports_ = nullptr;
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    MutexLocker shard_locker(&shards_[i].mutex);
+    delete shards_[i].ports;
+    shards_[i].ports = nullptr;
+  }
 }
 
 void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
@@ -350,18 +397,16 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
   {
     JSONArray ports(&jsobj, "ports");
     SafepointMutexLocker ml(mutex_);
-    if (ports_ == nullptr) {
-      return;
-    }
-    for (auto& entry : *ports_) {
-      if (entry.handler == handler) {
-        if (entry.state == kLivePort) {
-          JSONObject port(&ports);
-          port.AddProperty("type", "_Port");
-          port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", entry.port);
-          msg_handler = DartLibraryCalls::LookupHandler(entry.port);
-          port.AddProperty("handler", msg_handler);
-        }
+    // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
+    // by the [PortMap::mutex_] we already hold.
+    for (auto& isolate_entry : handler->ports_) {
+      if (GetPortState(isolate_entry.port) == kLivePort) {
+        JSONObject port(&ports);
+        port.AddProperty("type", "_Port");
+        port.AddPropertyF("name", "Isolate Port (%" Pd64 ")",
+                          isolate_entry.port);
+        msg_handler = DartLibraryCalls::LookupHandler(isolate_entry.port);
+        port.AddProperty("handler", msg_handler);
       }
     }
   }
@@ -370,17 +415,14 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
 
 void PortMap::DebugDumpForMessageHandler(MessageHandler* handler) {
   SafepointMutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
-    return;
-  }
   Object& msg_handler = Object::Handle();
-  for (auto& entry : *ports_) {
-    if (entry.handler == handler) {
-      if (entry.state == kLivePort) {
-        OS::PrintErr("Live Port = %" Pd64 "\n", entry.port);
-        msg_handler = DartLibraryCalls::LookupHandler(entry.port);
-        OS::PrintErr("Handler = %s\n", msg_handler.ToCString());
-      }
+  // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
+  // by the [PortMap::mutex_] we already hold.
+  for (auto& isolate_entry : handler->ports_) {
+    if (GetPortState(isolate_entry.port) == kLivePort) {
+      OS::PrintErr("Live Port = %" Pd64 "\n", isolate_entry.port);
+      msg_handler = DartLibraryCalls::LookupHandler(isolate_entry.port);
+      OS::PrintErr("Handler = %s\n", msg_handler.ToCString());
     }
   }
 }
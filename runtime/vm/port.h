@@ -11,6 +11,7 @@
 #include "vm/allocation.h"
 #include "vm/globals.h"
 #include "vm/json_stream.h"
+#include "vm/os_thread.h"
 #include "vm/port_set.h"
 #include "vm/random.h"
 
@@ -19,7 +20,6 @@ namespace dart {
 class Isolate;
 class Message;
 class MessageHandler;
-class Mutex;
 class PortMapTestPeer;
 
 class PortMap : public AllStatic {
@@ -88,15 +88,41 @@ class PortMap : public AllStatic {
     PortState state;
   };
 
+  // The ports are distributed over shards by their id, so that lookups of
+  // ports in different shards (e.g. sending messages to different isolates)
+  // do not contend on one lock.
+  struct Shard {
+    // Lock protecting access to [ports].
+    Mutex mutex;
+    PortSet<Entry>* ports = nullptr;
+  };
+
+  static constexpr intptr_t kNumShards = 16;
+
   static const char* PortStateString(PortState state);
 
   // Allocate a new unique port.
   static Dart_Port AllocatePort();
 
-  // Lock protecting access to the port map.
+  // Whether [port] is in use. Requires [mutex_].
+  static bool IsUsedPort(Dart_Port port);
+
+  // Returns the state of the existing [port]. Requires [mutex_].
+  static PortState GetPortState(Dart_Port port);
+
+  // The low bits of a port select its slot in the [PortSet] of a shard, so
+  // shards are selected by higher bits.
+  static Shard* ShardFor(Dart_Port port) {
+    return &shards_[(port >> 32) & (kNumShards - 1)];
+  }
+
+  // Lock serializing the creation and closing of ports. It also protects
+  // MessageHandler::ports_ and [prng_]. It must be acquired before the lock
+  // of any shard.
   static Mutex* mutex_;
 
-  static PortSet<Entry>* ports_;
+  // Never deleted, so that the shards stay safe to lock after Cleanup().
+  static Shard* shards_;
   static MessageHandler* deleted_entry_;
 
   static Random* prng_;
@@ -15,15 +15,17 @@ namespace dart {
 class PortMapTestPeer {
  public:
   static bool IsActivePort(Dart_Port port) {
-    MutexLocker ml(PortMap::mutex_);
-    auto it = PortMap::ports_->TryLookup(port);
-    return it != PortMap::ports_->end();
+    PortMap::Shard* shard = PortMap::ShardFor(port);
+    MutexLocker ml(&shard->mutex);
+    auto it = shard->ports->TryLookup(port);
+    return it != shard->ports->end();
   }
 
   static bool IsLivePort(Dart_Port port) {
-    MutexLocker ml(PortMap::mutex_);
-    auto it = PortMap::ports_->TryLookup(port);
-    if (it == PortMap::ports_->end()) {
+    PortMap::Shard* shard = PortMap::ShardFor(port);
+    MutexLocker ml(&shard->mutex);
+    auto it = shard->ports->TryLookup(port);
+    if (it == shard->ports->end()) {
       return false;
     }
     return (*it).state == PortMap::kLivePort;
@@ -93,6 +95,27 @@ TEST_CASE(PortMap_CreateManyPorts) {
   }
 }
 
+TEST_CASE(PortMap_ClosePortsOfManyShards) {
+  // Enough ports to populate every shard of the port map.
+  const intptr_t kNumPorts = 256;
+  PortTestMessageHandler handler;
+  Dart_Port ports[kNumPorts];
+  for (intptr_t i = 0; i < kNumPorts; i++) {
+    ports[i] = PortMap::CreatePort(&handler);
+    EXPECT(PortMapTestPeer::IsActivePort(ports[i]));
+  }
+  for (intptr_t i = 0; i < kNumPorts; i++) {
+    EXPECT(PortMap::PostMessage(
+        Message::New(ports[i], Smi::New(i), Message::kNormalPriority)));
+  }
+  EXPECT_EQ(kNumPorts, handler.notify_count);
+
+  PortMap::ClosePorts(&handler);
+  for (intptr_t i = 0; i < kNumPorts; i++) {
+    EXPECT(!PortMapTestPeer::IsActivePort(ports[i]));
+  }
+}
+
 TEST_CASE(PortMap_SetPortState) {
   PortTestMessageHandler handler;
 
@@ -54,6 +54,13 @@ DEFINE_FLAG(bool,
             false,
             "Collect native stack traces when tracing Dart allocations.");
 
+DEFINE_FLAG(int,
+            profile_wait_threshold,
+            0,
+            "When non-zero, record the stack of mutators that are blocked, in "
+            "native code or at a safepoint for longer than this many "
+            "microseconds, together with the duration of the wait.");
+
 DEFINE_FLAG(
     int,
     sample_buffer_duration,
@@ -1225,22 +1232,20 @@ static bool CheckIsolate(Isolate* isolate) {
   return isolate != Dart::vm_isolate();
 }
 
-void Profiler::SampleAllocation(Thread* thread,
-                                intptr_t cid,
-                                uint32_t identity_hash) {
+Sample* Profiler::SampleCurrentThread(Thread* thread) {
   ASSERT(thread != nullptr);
   OSThread* os_thread = thread->os_thread();
   ASSERT(os_thread != nullptr);
   Isolate* isolate = thread->isolate();
   if (!CheckIsolate(isolate)) {
-    return;
+    return nullptr;
   }
   const bool exited_dart_code = thread->HasExitedDartCode();
 
   SampleBlockBuffer* buffer = Profiler::sample_block_buffer();
   if (buffer == nullptr) {
     // Profiler not initialized.
-    return;
+    return nullptr;
   }
 
   uintptr_t sp = OSThread::GetCurrentStackPointer();
@@ -1256,7 +1261,7 @@ void Profiler::SampleAllocation(Thread* thread,
   if (!GetAndValidateThreadStackBounds(os_thread, thread, fp, sp, &stack_lower,
                                        &stack_upper)) {
     // Could not get stack boundary.
-    return;
+    return nullptr;
   }
 
   Sample* sample =
@@ -1264,10 +1269,8 @@ void Profiler::SampleAllocation(Thread* thread,
   if (sample == nullptr) {
     // We were unable to assign a sample for this allocation.
     counters_.sample_allocation_failure++;
-    return;
+    return nullptr;
   }
-  sample->SetAllocationCid(cid);
-  sample->set_allocation_identity_hash(identity_hash);
 
   if (FLAG_profile_vm_allocation) {
     ProfilerNativeStackWalker native_stack_walker(
@@ -1285,6 +1288,30 @@ void Profiler::SampleAllocation(Thread* thread,
     uintptr_t pc = OS::GetProgramCounter();
     sample->SetAt(0, pc);
   }
+  return sample;
+}
+
+void Profiler::SampleAllocation(Thread* thread,
+                                intptr_t cid,
+                                uint32_t identity_hash) {
+  Sample* sample = SampleCurrentThread(thread);
+  if (sample != nullptr) {
+    sample->SetAllocationCid(cid);
+    sample->set_allocation_identity_hash(identity_hash);
+  }
+}
+
+void Profiler::SampleWait(Thread* thread, int64_t wait_micros) {
+  // The allocation sample block of an isolate is only used by its mutator,
+  // while the CPU sample block is filled by the thread interrupter.
+  if (!thread->IsMutatorThread()) {
+    return;
+  }
+  Sample* sample = SampleCurrentThread(thread);
+  if (sample != nullptr) {
+    sample->SetWaitMicros(static_cast<uint32_t>(
+        Utils::Minimum<int64_t>(wait_micros, kMaxUint32)));
+  }
 }
 
 void Profiler::SampleThreadSingleFrame(Thread* thread,
@@ -1609,6 +1636,9 @@ ProcessedSample* SampleBuffer::BuildProcessedSample(
     processed_sample->set_allocation_identity_hash(
         sample->allocation_identity_hash());
   }
+  if (sample->is_wait_sample()) {
+    processed_sample->set_wait_micros(sample->wait_micros());
+  }
   processed_sample->set_first_frame_executing(!sample->exit_frame_sample());
 
   // Copy stack trace from sample(s).
@@ -1660,6 +1690,7 @@ ProcessedSample::ProcessedSample()
       user_tag_(0),
       allocation_cid_(-1),
       allocation_identity_hash_(0),
+      wait_micros_(0),
       truncated_(false) {}
 
 void ProcessedSample::FixupCaller(const CodeLookupTable& clt,
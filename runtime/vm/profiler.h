@@ -78,6 +78,10 @@ class Profiler : public AllStatic {
                                intptr_t cid,
                                uint32_t identity_hash);
 
+  // Records the stack of a mutator that waited for |wait_micros| while
+  // blocked, in native code or at a safepoint, see --profile_wait_threshold.
+  static void SampleWait(Thread* thread, int64_t wait_micros);
+
   // SampleThread is called from inside the signal handler and hence it is very
   // critical that the implementation of SampleThread does not do any of the
   // following:
@@ -107,6 +111,10 @@ class Profiler : public AllStatic {
   // should be able to accomodate.
   static intptr_t CalculateSampleBufferCapacity();
 
+  // Walks the stack of the current thread into a new sample of its
+  // allocation sample block. Returns nullptr if no sample was recorded.
+  static Sample* SampleCurrentThread(Thread* thread);
+
   // Does not walk the thread's stack.
   static void SampleThreadSingleFrame(Thread* thread,
                                       Sample* sample,
@@ -224,6 +232,7 @@ class Sample {
     state_ = 0;
     next_ = nullptr;
     allocation_identity_hash_ = 0;
+    wait_micros_ = 0;
     set_head_sample(true);
   }
 
@@ -359,6 +368,18 @@ class Sample {
     set_metadata(cid);
   }
 
+  bool is_wait_sample() const { return WaitSampleBit::decode(state_); }
+
+  uint32_t wait_micros() const {
+    ASSERT(is_wait_sample());
+    return wait_micros_;
+  }
+
+  void SetWaitMicros(uint32_t wait_micros) {
+    state_ = WaitSampleBit::update(true, state_);
+    wait_micros_ = wait_micros;
+  }
+
   static constexpr int kPCArraySizeInWords = 32;
   uword* GetPCArray() { return &pc_array_[0]; }
 
@@ -377,7 +398,8 @@ class Sample {
     kContinuationSampleBit = 7,
     kThreadTaskBit = 8,  // 7 bits.
     kMetadataBit = 15,   // 16 bits.
-    kNextFreeBit = 31,
+    kWaitSampleBit = 31,
+    kNextFreeBit = 32,
   };
   class HeadSampleBit : public BitField<uint32_t, bool, kHeadSampleBit, 1> {};
   class LeafFrameIsDart
@@ -395,6 +417,7 @@ class Sample {
   class ThreadTaskBit
       : public BitField<uint32_t, Thread::TaskKind, kThreadTaskBit, 7> {};
   class MetadataBits : public BitField<uint32_t, intptr_t, kMetadataBit, 16> {};
+  class WaitSampleBit : public BitField<uint32_t, bool, kWaitSampleBit, 1> {};
 
   int64_t timestamp_;
   Dart_Port port_;
@@ -406,6 +429,7 @@ class Sample {
   uint32_t state_;
   Sample* next_;
   uint32_t allocation_identity_hash_;
+  uint32_t wait_micros_;
 
   DISALLOW_COPY_AND_ASSIGN(Sample);
 };
@@ -878,6 +902,12 @@ class ProcessedSample : public ZoneAllocated {
 
   bool IsAllocationSample() const { return allocation_cid_ > 0; }
 
+  // The duration of the wait if this is a wait sample. 0 otherwise.
+  int64_t wait_micros() const { return wait_micros_; }
+  void set_wait_micros(int64_t wait_micros) { wait_micros_ = wait_micros; }
+
+  bool IsWaitSample() const { return wait_micros_ > 0; }
+
   // Was the stack trace truncated?
   bool truncated() const { return truncated_; }
   void set_truncated(bool truncated) { truncated_ = truncated; }
@@ -905,6 +935,7 @@ class ProcessedSample : public ZoneAllocated {
   uword user_tag_;
   intptr_t allocation_cid_;
   uint32_t allocation_identity_hash_;
+  int64_t wait_micros_;
   bool truncated_;
   bool first_frame_executing_;
 
@@ -5,6 +5,7 @@
 #include "vm/profiler_service.h"
 
 #include "platform/text_buffer.h"
+#include "vm/dart.h"
 #include "vm/growable_array.h"
 #include "vm/hash_map.h"
 #include "vm/heap/safepoint.h"
@@ -13,6 +14,7 @@
 #include "vm/object.h"
 #include "vm/os.h"
 #include "vm/profiler.h"
+#include "vm/proto_writer.h"
 #include "vm/reusable_handles.h"
 #include "vm/scope_timer.h"
 #include "vm/service.h"
@@ -25,6 +27,12 @@ DECLARE_FLAG(int, max_profile_depth);
 DECLARE_FLAG(int, profile_period);
 DECLARE_FLAG(bool, profile_vm);
 
+DEFINE_FLAG(charp,
+            write_pprof_profile_to,
+            nullptr,
+            "Write the CPU, allocation and wait samples of an isolate to the "
+            "given file in the pprof format when the isolate shuts down.");
+
 #ifndef PRODUCT
 
 ProfileFunctionSourcePosition::ProfileFunctionSourcePosition(
@@ -1585,10 +1593,10 @@ void Profile::PrintHeaderJSON(JSONObject* obj) {
   }
 }
 
-void Profile::ProcessSampleFrameJSON(JSONArray* stack,
-                                     ProfileCodeInlinedFunctionsCache* cache_,
-                                     ProcessedSample* sample,
-                                     intptr_t frame_index) {
+void Profile::ProcessSampleFrame(ProfileCodeInlinedFunctionsCache* cache_,
+                                 ProcessedSample* sample,
+                                 intptr_t frame_index,
+                                 GrowableArray<ProfileFunction*>* functions) {
   const uword pc = sample->At(frame_index);
   ProfileCode* profile_code = GetCodeFromPC(pc, sample->timestamp());
   ASSERT(profile_code != nullptr);
@@ -1622,7 +1630,7 @@ void Profile::ProcessSampleFrameJSON(JSONArray* stack,
 
   if (code.IsNull() || (inlined_functions == nullptr) ||
       (inlined_functions->length() <= 1)) {
-    PrintFunctionFrameIndexJSON(stack, function);
+    functions->Add(function);
     return;
   }
 
@@ -1643,18 +1651,12 @@ void Profile::ProcessSampleFrameJSON(JSONArray* stack,
     const Function* inlined_function = (*inlined_functions)[i];
     ASSERT(inlined_function != nullptr);
     ASSERT(!inlined_function->IsNull());
-    ProcessInlinedFunctionFrameJSON(stack, inlined_function);
+    ProfileFunction* function = functions_->LookupOrAdd(*inlined_function);
+    ASSERT(function != nullptr);
+    functions->Add(function);
   }
 }
 
-void Profile::ProcessInlinedFunctionFrameJSON(
-    JSONArray* stack,
-    const Function* inlined_function) {
-  ProfileFunction* function = functions_->LookupOrAdd(*inlined_function);
-  ASSERT(function != nullptr);
-  PrintFunctionFrameIndexJSON(stack, function);
-}
-
 void Profile::PrintFunctionFrameIndexJSON(JSONArray* stack,
                                           ProfileFunction* function) {
   stack->AddValue64(function->table_index());
@@ -1678,6 +1680,7 @@ void Profile::PrintCodeFrameIndexJSON(JSONArray* stack,
 void Profile::PrintSamplesJSON(JSONObject* obj, bool code_samples) {
   JSONArray samples(obj, "samples");
   auto* cache = new ProfileCodeInlinedFunctionsCache();
+  GrowableArray<ProfileFunction*> functions;
   for (intptr_t sample_index = 0; sample_index < samples_->length();
        sample_index++) {
     JSONObject sample_obj(&samples);
@@ -1703,7 +1706,11 @@ void Profile::PrintSamplesJSON(JSONObject* obj, bool code_samples) {
       for (intptr_t frame_index = 0; frame_index < sample->length();
            frame_index++) {
         ASSERT(sample->At(frame_index) != 0);
-        ProcessSampleFrameJSON(&stack, cache, sample, frame_index);
+        functions.Clear();
+        ProcessSampleFrame(cache, sample, frame_index, &functions);
+        for (ProfileFunction* function : functions) {
+          PrintFunctionFrameIndexJSON(&stack, function);
+        }
       }
     }
     if (code_samples) {
@@ -1777,6 +1784,190 @@ void Profile::PrintProfileJSON(JSONObject* obj,
   thread->CheckForSafepoint();
 }
 
+// Field numbers of the pprof profile proto, see
+// https://github.com/google/pprof/blob/main/proto/profile.proto.
+namespace pprof {
+static constexpr intptr_t kProfileSampleType = 1;
+static constexpr intptr_t kProfileSample = 2;
+static constexpr intptr_t kProfileLocation = 4;
+static constexpr intptr_t kProfileFunction = 5;
+static constexpr intptr_t kProfileStringTable = 6;
+static constexpr intptr_t kProfileTimeNanos = 9;
+static constexpr intptr_t kProfileDurationNanos = 10;
+static constexpr intptr_t kProfilePeriodType = 11;
+static constexpr intptr_t kProfilePeriod = 12;
+static constexpr intptr_t kValueTypeType = 1;
+static constexpr intptr_t kValueTypeUnit = 2;
+static constexpr intptr_t kSampleLocationId = 1;
+static constexpr intptr_t kSampleValue = 2;
+static constexpr intptr_t kSampleLabel = 3;
+static constexpr intptr_t kLabelKey = 1;
+static constexpr intptr_t kLabelStr = 2;
+static constexpr intptr_t kLabelNum = 3;
+static constexpr intptr_t kLocationId = 1;
+static constexpr intptr_t kLocationLine = 4;
+static constexpr intptr_t kLineFunctionId = 1;
+static constexpr intptr_t kFunctionId = 1;
+static constexpr intptr_t kFunctionName = 2;
+static constexpr intptr_t kFunctionFilename = 4;
+}  // namespace pprof
+
+// The string table of a pprof profile. Index 0 is the empty string.
+class PprofStringTable : public ValueObject {
+ public:
+  explicit PprofStringTable(ProtoWriter* profile)
+      : profile_(profile), indices_() {
+    Add("");
+  }
+
+  intptr_t Add(const char* str) {
+    if (str == nullptr) return 0;
+    intptr_t index = indices_.LookupValue(str);
+    if (index != CStringIntMapKeyValueTrait::kNoValue) {
+      return index;
+    }
+    index = indices_.Length();
+    indices_.Insert({str, index});
+    profile_->WriteString(pprof::kProfileStringTable, str);
+    return index;
+  }
+
+ private:
+  ProtoWriter* const profile_;
+  CStringIntMap indices_;
+
+  DISALLOW_COPY_AND_ASSIGN(PprofStringTable);
+};
+
+static void WritePprofValueType(ProtoWriter* profile,
+                                PprofStringTable* strings,
+                                intptr_t field,
+                                const char* type,
+                                const char* unit) {
+  ProtoWriter value_type;
+  value_type.WriteVarInt(pprof::kValueTypeType, strings->Add(type));
+  value_type.WriteVarInt(pprof::kValueTypeUnit, strings->Add(unit));
+  profile->WriteMessage(field, value_type);
+}
+
+static void WritePprofLabel(ProtoWriter* sample,
+                            PprofStringTable* strings,
+                            const char* key,
+                            const char* str) {
+  ProtoWriter label;
+  label.WriteVarInt(pprof::kLabelKey, strings->Add(key));
+  label.WriteVarInt(pprof::kLabelStr, strings->Add(str));
+  sample->WriteMessage(pprof::kSampleLabel, label);
+}
+
+static void WritePprofLabel(ProtoWriter* sample,
+                            PprofStringTable* strings,
+                            const char* key,
+                            int64_t num) {
+  ProtoWriter label;
+  label.WriteVarInt(pprof::kLabelKey, strings->Add(key));
+  label.WriteVarInt(pprof::kLabelNum, static_cast<uint64_t>(num));
+  sample->WriteMessage(pprof::kSampleLabel, label);
+}
+
+void Profile::PrintProfilePprof(ProtoWriter* profile) {
+  ScopeTimer sw("Profile::PrintProfilePprof", FLAG_trace_profiler);
+  Thread* thread = Thread::Current();
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  PprofStringTable strings(profile);
+  const int64_t period_nanos = FLAG_profile_period * kNanosecondsPerMicrosecond;
+
+  // Every sample has a value for each sample type: CPU samples count their
+  // time, allocation samples count one allocation and wait samples count the
+  // time spent off CPU.
+  WritePprofValueType(profile, &strings, pprof::kProfileSampleType, "samples",
+                      "count");
+  WritePprofValueType(profile, &strings, pprof::kProfileSampleType, "cpu",
+                      "nanoseconds");
+  WritePprofValueType(profile, &strings, pprof::kProfileSampleType,
+                      "allocations", "count");
+  WritePprofValueType(profile, &strings, pprof::kProfileSampleType, "wait",
+                      "nanoseconds");
+  WritePprofValueType(profile, &strings, pprof::kProfilePeriodType, "cpu",
+                      "nanoseconds");
+  profile->WriteVarInt(pprof::kProfilePeriod, period_nanos);
+
+  // Sample timestamps are monotonic, pprof expects the wall clock.
+  const int64_t wall_clock_offset =
+      OS::GetCurrentTimeMicros() - OS::GetCurrentMonotonicMicros();
+  profile->WriteVarInt(
+      pprof::kProfileTimeNanos,
+      (min_time() + wall_clock_offset) * kNanosecondsPerMicrosecond);
+  profile->WriteVarInt(pprof::kProfileDurationNanos,
+                       GetTimeSpan() * kNanosecondsPerMicrosecond);
+
+  auto* cache = new ProfileCodeInlinedFunctionsCache();
+  GrowableArray<ProfileFunction*> functions;
+  for (intptr_t sample_index = 0; sample_index < samples_->length();
+       sample_index++) {
+    ProcessedSample* sample = samples_->At(sample_index);
+    ProtoWriter sample_message;
+    // Each function is its own location, so location and function ids are
+    // both the index of the function in the table plus one.
+    for (intptr_t frame_index = 0; frame_index < sample->length();
+         frame_index++) {
+      functions.Clear();
+      ProcessSampleFrame(cache, sample, frame_index, &functions);
+      for (ProfileFunction* function : functions) {
+        sample_message.WriteVarInt(pprof::kSampleLocationId,
+                                   function->table_index() + 1);
+      }
+    }
+    const bool is_allocation = sample->IsAllocationSample();
+    const bool is_cpu = !is_allocation && !sample->IsWaitSample();
+    sample_message.WriteVarInt(pprof::kSampleValue, is_cpu ? 1 : 0);
+    sample_message.WriteVarInt(pprof::kSampleValue, is_cpu ? period_nanos : 0);
+    sample_message.WriteVarInt(pprof::kSampleValue, is_allocation ? 1 : 0);
+    sample_message.WriteVarInt(
+        pprof::kSampleValue,
+        sample->wait_micros() * kNanosecondsPerMicrosecond);
+    WritePprofLabel(&sample_message, &strings, "thread",
+                    OSThread::ThreadIdToIntPtr(sample->tid()));
+    WritePprofLabel(&sample_message, &strings, "vm tag",
+                    VMTag::TagName(sample->vm_tag()));
+    if (UserTags::IsUserTag(sample->user_tag())) {
+      WritePprofLabel(&sample_message, &strings, "user tag",
+                      UserTags::TagName(sample->user_tag()));
+    }
+    if (is_allocation) {
+      const intptr_t cid = sample->allocation_cid();
+      if (class_table->HasValidClassAt(cid)) {
+        const Class& cls = Class::Handle(class_table->At(cid));
+        WritePprofLabel(&sample_message, &strings, "class",
+                        cls.ScrubbedNameCString());
+      }
+    }
+    profile->WriteMessage(pprof::kProfileSample, sample_message);
+    thread->CheckForSafepoint();
+  }
+
+  for (intptr_t i = 0; i < functions_->length(); i++) {
+    ProfileFunction* function = functions_->At(i);
+    ASSERT(function != nullptr);
+    const intptr_t id = function->table_index() + 1;
+    ProtoWriter line;
+    line.WriteVarInt(pprof::kLineFunctionId, id);
+    ProtoWriter location;
+    location.WriteVarInt(pprof::kLocationId, id);
+    location.WriteMessage(pprof::kLocationLine, line);
+    profile->WriteMessage(pprof::kProfileLocation, location);
+
+    ProtoWriter function_message;
+    function_message.WriteVarInt(pprof::kFunctionId, id);
+    function_message.WriteVarInt(pprof::kFunctionName,
+                                 strings.Add(function->Name()));
+    function_message.WriteVarInt(pprof::kFunctionFilename,
+                                 strings.Add(function->ResolvedScriptUrl()));
+    profile->WriteMessage(pprof::kProfileFunction, function_message);
+    thread->CheckForSafepoint();
+  }
+}
+
 void ProfilerService::PrintJSONImpl(Thread* thread,
                                     JSONStream* stream,
                                     SampleFilter* filter,
@@ -1802,7 +1993,9 @@ class NoAllocationSampleFilter : public SampleFilter {
                      time_origin_micros,
                      time_extent_micros) {}
 
-  bool FilterSample(Sample* sample) { return !sample->is_allocation_sample(); }
+  bool FilterSample(Sample* sample) {
+    return !sample->is_allocation_sample() && !sample->is_wait_sample();
+  }
 };
 
 void ProfilerService::PrintJSON(JSONStream* stream,
@@ -1877,6 +2070,34 @@ void ProfilerService::PrintAllocationJSON(JSONStream* stream,
   PrintJSONImpl(thread, stream, &filter, Profiler::sample_block_buffer(), true);
 }
 
+void ProfilerService::WritePprof(Thread* thread, const char* filename) {
+  if (Profiler::sample_block_buffer() == nullptr) {
+    return;
+  }
+  if ((Dart::file_write_callback() == nullptr) ||
+      (Dart::file_open_callback() == nullptr) ||
+      (Dart::file_close_callback() == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return;
+  }
+  void* file = Dart::file_open_callback()(filename, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write pprof profile: %s\n", filename);
+    return;
+  }
+
+  StackZone zone(thread);
+  HandleScope handle_scope(thread);
+  SampleFilter filter(thread->isolate()->main_port(), Thread::kMutatorTask,
+                      /*time_origin_micros=*/-1, /*time_extent_micros=*/-1);
+  Profile profile;
+  profile.Build(thread, &filter, Profiler::sample_block_buffer());
+  ProtoWriter writer;
+  profile.PrintProfilePprof(&writer);
+  Dart::file_write_callback()(writer.data(), writer.length(), file);
+  Dart::file_close_callback()(file);
+}
+
 void ProfilerService::ClearSamples() {
   SampleBlockBuffer* sample_block_buffer = Profiler::sample_block_buffer();
   if (sample_block_buffer == nullptr) {
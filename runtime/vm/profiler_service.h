@@ -27,6 +27,7 @@ class Function;
 class JSONArray;
 class JSONStream;
 class ProfileFunctionTable;
+class ProtoWriter;
 class ProfileCodeTable;
 class SampleFilter;
 class ProcessedSample;
@@ -389,16 +390,20 @@ class Profile : public ValueObject {
                         bool include_code_samples,
                         bool is_event = false);
 
+  // Writes the samples as a pprof Profile message, see
+  // https://github.com/google/pprof/blob/main/proto/profile.proto.
+  void PrintProfilePprof(ProtoWriter* profile);
+
   ProfileFunction* FindFunction(const Function& function);
 
  private:
   void PrintHeaderJSON(JSONObject* obj);
-  void ProcessSampleFrameJSON(JSONArray* stack,
-                              ProfileCodeInlinedFunctionsCache* cache,
-                              ProcessedSample* sample,
-                              intptr_t frame_index);
-  void ProcessInlinedFunctionFrameJSON(JSONArray* stack,
-                                       const Function* inlined_function);
+  // Adds the visible functions of the frame, including the functions
+  // inlined at its pc, starting with the innermost one.
+  void ProcessSampleFrame(ProfileCodeInlinedFunctionsCache* cache,
+                          ProcessedSample* sample,
+                          intptr_t frame_index,
+                          GrowableArray<ProfileFunction*>* functions);
   void PrintFunctionFrameIndexJSON(JSONArray* stack, ProfileFunction* function);
   void PrintCodeFrameIndexJSON(JSONArray* stack,
                                ProcessedSample* sample,
@@ -440,6 +445,10 @@ class ProfilerService : public AllStatic {
 
   static void ClearSamples();
 
+  // Writes the CPU, allocation and wait samples of the current isolate to
+  // |filename| in the pprof format.
+  static void WritePprof(Thread* thread, const char* filename);
+
  private:
   static void PrintJSONImpl(Thread* thread,
                             JSONStream* stream,
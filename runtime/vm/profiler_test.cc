@@ -7,8 +7,10 @@
 #include "vm/dart_api_impl.h"
 #include "vm/dart_api_state.h"
 #include "vm/globals.h"
+#include "vm/heap/safepoint.h"
 #include "vm/profiler.h"
 #include "vm/profiler_service.h"
+#include "vm/proto_writer.h"
 #include "vm/source_report.h"
 #include "vm/symbols.h"
 #include "vm/unit_test.h"
@@ -528,6 +530,97 @@ ISOLATE_UNIT_TEST_CASE(Profiler_TrivialRecordAllocation) {
   }
 }
 
+static bool ContainsString(const ProtoWriter& writer, const char* str) {
+  const intptr_t length = strlen(str);
+  for (intptr_t i = 0; i + length <= writer.length(); i++) {
+    if (memcmp(writer.data() + i, str, length) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ISOLATE_UNIT_TEST_CASE(Profiler_PprofAllocation) {
+  EnableProfiler();
+  DisableNativeProfileScope dnps;
+  DisableBackgroundCompilationScope dbcs;
+  const char* kScript =
+      "class A {\n"
+      "  var a;\n"
+      "}\n"
+      "class B {\n"
+      "  static boo() {\n"
+      "    return new A();\n"
+      "  }\n"
+      "}\n"
+      "main() {\n"
+      "  return B.boo();\n"
+      "}\n";
+
+  const Library& root_library = Library::Handle(LoadTestScript(kScript));
+
+  const int64_t before_allocations_micros = Dart_TimelineGetMicros();
+  const Class& class_a = Class::Handle(GetClass(root_library, "A"));
+  EXPECT(!class_a.IsNull());
+  class_a.SetTraceAllocation(true);
+
+  Invoke(root_library, "main");
+
+  const int64_t allocation_extent_micros =
+      Dart_TimelineGetMicros() - before_allocations_micros;
+  {
+    Thread* thread = Thread::Current();
+    Isolate* isolate = thread->isolate();
+    StackZone zone(thread);
+    Profile profile;
+    AllocationFilter filter(isolate->main_port(), class_a.id(),
+                            before_allocations_micros,
+                            allocation_extent_micros);
+    profile.Build(thread, &filter, Profiler::sample_block_buffer());
+    EXPECT_EQ(1, profile.sample_count());
+
+    ProtoWriter writer;
+    profile.PrintProfilePprof(&writer);
+    EXPECT(ContainsString(writer, "allocations"));
+    EXPECT(ContainsString(writer, "B.boo"));
+    EXPECT(ContainsString(writer, "main"));
+  }
+}
+
+class WaitFilter : public SampleFilter {
+ public:
+  explicit WaitFilter(Dart_Port port)
+      : SampleFilter(port, Thread::kMutatorTask, -1, -1) {}
+
+  bool FilterSample(Sample* sample) { return sample->is_wait_sample(); }
+};
+
+ISOLATE_UNIT_TEST_CASE(Profiler_WaitSample) {
+  EnableProfiler();
+  DisableNativeProfileScope dnps;
+  SetFlagScope<int> sfs(&FLAG_profile_wait_threshold, 1000);
+  {
+    // Too short to be sampled.
+    TransitionVMToBlocked transition(thread);
+  }
+  {
+    TransitionVMToBlocked transition(thread);
+    OS::Sleep(10);
+  }
+  {
+    Isolate* isolate = thread->isolate();
+    StackZone zone(thread);
+    Profile profile;
+    WaitFilter filter(isolate->main_port());
+    profile.Build(thread, &filter, Profiler::sample_block_buffer());
+    EXPECT_EQ(1, profile.sample_count());
+    ProcessedSample* sample = profile.SampleAt(0);
+    EXPECT(sample->IsWaitSample());
+    EXPECT(!sample->IsAllocationSample());
+    EXPECT_LE(10 * kMicrosecondsPerMillisecond, sample->wait_micros());
+  }
+}
+
 ISOLATE_UNIT_TEST_CASE(Profiler_NullSampleBuffer) {
   Isolate* isolate = thread->isolate();
 
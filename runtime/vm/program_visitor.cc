@@ -8,6 +8,7 @@
 
 #include "vm/canonical_tables.h"
 #include "vm/closure_functions_cache.h"
+#include "vm/code_descriptors.h"
 #include "vm/code_patcher.h"
 #include "vm/deopt_instructions.h"
 #include "vm/hash_map.h"
@@ -704,17 +705,20 @@ void ProgramVisitor::NormalizeAndDedupCompressedStackMaps(Thread* thread) {
       MallocWriteStream new_payload(maps.payload_size());
       CompressedStackMaps::Iterator<CompressedStackMaps> it(maps,
                                                             old_global_table_);
+      CompressedStackMapsIndexBuilder index_builder;
       intptr_t last_offset = 0;
       while (it.MoveNext()) {
         StackMapEntry entry(zone_, it);
         const intptr_t entry_offset = entry_offsets_.LookupValue(&entry);
         const intptr_t pc_delta = it.pc_offset() - last_offset;
+        index_builder.AddEntry(new_payload, last_offset);
         new_payload.WriteLEB128(pc_delta);
         new_payload.WriteLEB128(entry_offset);
         last_offset = it.pc_offset();
       }
-      return CompressedStackMaps::NewUsingTable(new_payload.buffer(),
-                                                new_payload.bytes_written());
+      const bool has_index = index_builder.WriteTo(&new_payload);
+      return CompressedStackMaps::NewUsingTable(
+          new_payload.buffer(), new_payload.bytes_written(), has_index);
     }
 
     const CompressedStackMaps& old_global_table_;
@@ -0,0 +1,79 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_PROTO_WRITER_H_
+#define RUNTIME_VM_PROTO_WRITER_H_
+
+#include <string.h>
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+
+namespace dart {
+
+// Writes protobuf messages in the binary wire format, see
+// https://protobuf.dev/programming-guides/encoding/.
+class ProtoWriter : public ValueObject {
+ public:
+  ProtoWriter() : buffer_(64) {}
+
+  void WriteVarInt(intptr_t field, uint64_t value) {
+    WriteTag(field, kVarInt);
+    WriteRawVarInt(value);
+  }
+
+  void WriteFixed64(intptr_t field, uint64_t value) {
+    WriteTag(field, kFixed64);
+    for (intptr_t i = 0; i < 8; i++) {
+      buffer_.Add(static_cast<uint8_t>(value >> (8 * i)));
+    }
+  }
+
+  void WriteBytes(intptr_t field, const void* data, intptr_t length) {
+    WriteTag(field, kLengthDelimited);
+    WriteRawVarInt(length);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    for (intptr_t i = 0; i < length; i++) {
+      buffer_.Add(bytes[i]);
+    }
+  }
+
+  void WriteString(intptr_t field, const char* value) {
+    WriteBytes(field, value, strlen(value));
+  }
+
+  void WriteMessage(intptr_t field, const ProtoWriter& message) {
+    WriteBytes(field, message.data(), message.length());
+  }
+
+  const uint8_t* data() const { return buffer_.data(); }
+  intptr_t length() const { return buffer_.length(); }
+
+ private:
+  enum WireType {
+    kVarInt = 0,
+    kFixed64 = 1,
+    kLengthDelimited = 2,
+  };
+
+  void WriteTag(intptr_t field, WireType type) {
+    WriteRawVarInt((static_cast<uint64_t>(field) << 3) | type);
+  }
+
+  void WriteRawVarInt(uint64_t value) {
+    while (value >= 0x80) {
+      buffer_.Add(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    buffer_.Add(static_cast<uint8_t>(value));
+  }
+
+  MallocGrowableArray<uint8_t> buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtoWriter);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_PROTO_WRITER_H_
@@ -777,6 +777,10 @@ void UntaggedObject::RememberCard(CompressedObjectPtr const* slot) {
 }
 #endif
 
+void UntaggedObject::RememberAllCards() {
+  Page::Of(static_cast<ObjectPtr>(this))->RememberAllCards();
+}
+
 DEFINE_LEAF_RUNTIME_ENTRY(void,
                           RememberCard,
                           2,
@@ -337,7 +337,11 @@ class UntaggedObject {
 
   DART_FORCE_INLINE
   void EnsureInRememberedSet(Thread* thread) {
-    if (TryAcquireRememberedBit()) {
+    if (IsCardRemembered()) {
+      // Large arrays are remembered by card rather than as a whole, so the
+      // scavenger only revisits the parts that still hold new objects.
+      RememberAllCards();
+    } else if (TryAcquireRememberedBit()) {
       thread->StoreBufferAddObject(ObjectPtr(this));
     }
   }
@@ -740,6 +744,7 @@ class UntaggedObject {
 #if defined(DART_COMPRESSED_POINTERS)
   void RememberCard(CompressedObjectPtr const* slot);
 #endif
+  void RememberAllCards();
 
   friend class Array;
   friend class ByteBuffer;
@@ -2123,12 +2128,23 @@ class UntaggedCompressedStackMaps : public UntaggedObject {
     //
     // In all types of CSM, each unsigned integer is LEB128 encoded, as
     // generally they tend to fit in a single byte or two. Thus, entry headers
-    // are not a fixed length, and currently there is no random access of
-    // entries.  In addition, PC offsets are currently encoded as deltas, which
-    // also inhibits random access without accessing previous entries. That
-    // means to find an entry for a given PC offset, a linear search must be
-    // done where the payload is decoded up to the entry whose PC offset
-    // is greater or equal to the given PC.
+    // are not a fixed length, and there is no random access of entries. In
+    // addition, PC offsets are encoded as deltas, which also inhibits random
+    // access without accessing previous entries. That means to find an entry
+    // for a given PC offset, a linear search must be done where the payload
+    // is decoded up to the entry whose PC offset is greater or equal to the
+    // given PC.
+    //
+    // To bound that search, CSMs of the first two types with many entries
+    // have IndexBit set and end with a sparse index of every
+    // CompressedStackMaps::kIndexInterval-th entry (after the first):
+    //
+    //   * For each indexed entry, two uint32_t values: the PC offset of the
+    //     entry before it and the payload offset of its header.
+    //   * A uint32_t containing the number of indexed entries.
+    //
+    // A lookup binary searches the index and decodes entries from the last
+    // indexed entry whose predecessor has a smaller PC offset.
 
     uint8_t* data() {
       return reinterpret_cast<uint8_t*>(this) + sizeof(FlagsAndSizeHeader);
@@ -2155,12 +2171,16 @@ class UntaggedCompressedStackMaps : public UntaggedObject {
                                        bool,
                                        GlobalTableBit::kNextBit,
                                        1> {};
+  class IndexBit : public BitField<Payload::FlagsAndSizeHeader,
+                                   bool,
+                                   UsesTableBit::kNextBit,
+                                   1> {};
   class SizeField
       : public BitField<Payload::FlagsAndSizeHeader,
                         Payload::FlagsAndSizeHeader,
-                        UsesTableBit::kNextBit,
+                        IndexBit::kNextBit,
                         sizeof(Payload::FlagsAndSizeHeader) * kBitsPerByte -
-                            UsesTableBit::kNextBit> {};
+                            IndexBit::kNextBit> {};
 
   friend class Object;
   friend class ImageWriter;
@@ -3144,6 +3164,8 @@ class UntaggedArray : public UntaggedInstance {
   friend class Page;
   friend class FastObjectCopy;  // For initializing fields.
   friend void UpdateLengthField(intptr_t, ObjectPtr, ObjectPtr);  // length_
+  template <bool>
+  friend class MarkingVisitorBase;  // For scanning large arrays in slices.
 };
 
 class UntaggedImmutableArray : public UntaggedArray {
@@ -3424,7 +3446,9 @@ class UntaggedRegExp : public UntaggedInstance {
   COMPRESSED_POINTER_FIELD(ObjectPtr, two_byte_sticky)
   COMPRESSED_POINTER_FIELD(ObjectPtr, external_one_byte_sticky)
   COMPRESSED_POINTER_FIELD(ObjectPtr, external_two_byte_sticky)
-  VISIT_TO(external_two_byte_sticky)
+  // Program of the linear-time engine, see vm/regexp_linear.h.
+  COMPRESSED_POINTER_FIELD(ObjectPtr, linear_program)
+  VISIT_TO(linear_program)
   CompressedObjectPtr* to_snapshot(Snapshot::Kind kind) { return to(); }
 
   std::atomic<intptr_t> num_bracket_expressions_;
@@ -3449,6 +3473,10 @@ class UntaggedRegExp : public UntaggedInstance {
   // It is possible multiple compilers race to update the flags concurrently.
   // That should be safe since all updates update to the same values..
   AtomicBitFieldContainer<int8_t> type_flags_;
+
+  // Number of times the regexp ran in the bytecode interpreter, saturating at
+  // kMaxUint16. Used to decide when to compile it.
+  uint16_t interpreted_executions_;
 };
 
 class UntaggedWeakProperty : public UntaggedInstance {
@@ -207,6 +207,7 @@ namespace dart {
   F(RegExp, two_byte_sticky_)                                                  \
   F(RegExp, external_one_byte_sticky_)                                         \
   F(RegExp, external_two_byte_sticky_)                                         \
+  F(RegExp, linear_program_)                                                   \
   F(SuspendState, function_data_)                                              \
   F(SuspendState, then_callback_)                                              \
   F(SuspendState, error_callback_)                                             \
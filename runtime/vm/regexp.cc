@@ -2976,18 +2976,15 @@ void BoyerMooreLookahead::EmitSkipInstructions(RegExpMacroAssembler* masm) {
     return;
   }
 
+  // The first check is done inline, so that dense matches do not pay for
+  // the out-of-line scan that skips over the rest of the input.
   if (found_single_character) {
-    BlockLabel cont, again;
-    masm->BindBlock(&again);
+    const uint16_t mask = max_char_ > kSize ? RegExpMacroAssembler::kTableMask
+                                            : kMaxUint16;
+    BlockLabel cont;
     masm->LoadCurrentCharacter(max_lookahead, &cont, true);
-    if (max_char_ > kSize) {
-      masm->CheckCharacterAfterAnd(single_character,
-                                   RegExpMacroAssembler::kTableMask, &cont);
-    } else {
-      masm->CheckCharacter(single_character, &cont);
-    }
-    masm->AdvanceCurrentPosition(lookahead_width);
-    masm->GoTo(&again);
+    masm->CheckCharacterAfterAnd(single_character, mask, &cont);
+    masm->SkipUntilCharacterAfterAnd(max_lookahead, single_character, mask);
     masm->BindBlock(&cont);
     return;
   }
@@ -2999,14 +2996,11 @@ void BoyerMooreLookahead::EmitSkipInstructions(RegExpMacroAssembler* masm) {
       GetSkipTable(min_lookahead, max_lookahead, boolean_skip_table);
   ASSERT(skip_distance != 0);
 
-  BlockLabel cont, again;
+  BlockLabel cont;
 
-  masm->BindBlock(&again);
-  masm->CheckPreemption(/*is_backtrack=*/false);
   masm->LoadCurrentCharacter(max_lookahead, &cont, true);
   masm->CheckBitInTable(boolean_skip_table, &cont);
-  masm->AdvanceCurrentPosition(skip_distance);
-  masm->GoTo(&again);
+  masm->SkipUntilBitInTable(max_lookahead, boolean_skip_table, skip_distance);
   masm->BindBlock(&cont);
 
   return;
@@ -5416,7 +5410,6 @@ RegExpEngine::CompilationResult RegExpEngine::CompileBytecode(
     bool is_one_byte,
     bool is_sticky,
     Zone* zone) {
-  ASSERT(FLAG_interpret_irregexp);
   const String& pattern = String::Handle(zone, regexp.pattern());
 
   ASSERT(!regexp.IsNull());
@@ -5583,7 +5576,8 @@ RegExpPtr RegExpEngine::CreateRegExp(Thread* thread,
   regexp.set_is_complex();
   regexp.set_is_global();  // All dart regexps are global.
 
-  if (!FLAG_interpret_irregexp) {
+  if (!FLAG_interpret_irregexp && FLAG_regexp_compilation_threshold == 0 &&
+      !FLAG_linear_regexp) {
     const Library& lib = Library::Handle(zone, Library::CoreLibrary());
     const Class& owner =
         Class::Handle(zone, lib.LookupClass(Symbols::RegExp()));
@@ -5600,4 +5594,38 @@ RegExpPtr RegExpEngine::CreateRegExp(Thread* thread,
   return regexp.ptr();
 }
 
+void RegExpEngine::EnsureCompiled(Thread* thread,
+                                  const RegExp& regexp,
+                                  intptr_t cid,
+                                  bool sticky) {
+  ASSERT(!FLAG_interpret_irregexp);
+  if (regexp.IsCompiled(cid, sticky)) return;
+
+  // The interpreter keeps the bytecode for one-byte and two-byte subjects in
+  // the slots of the internal string functions, and uses it for external
+  // strings too. Replace both functions of the same width at once, so that
+  // the bytecode is only dropped once nothing runs it anymore.
+  const bool is_one_byte =
+      cid == kOneByteStringCid || cid == kExternalOneByteStringCid;
+  const intptr_t cids[] = {
+      is_one_byte ? kOneByteStringCid : kTwoByteStringCid,
+      is_one_byte ? kExternalOneByteStringCid : kExternalTwoByteStringCid};
+
+  Zone* zone = thread->zone();
+  const Library& lib = Library::Handle(zone, Library::CoreLibrary());
+  const Class& owner = Class::Handle(zone, lib.LookupClass(Symbols::RegExp()));
+
+  // The regexp is shared by all isolates of the group, which may be about to
+  // read its bytecode. Stopping them ensures none of them observes a slot
+  // changing between choosing the interpreter and running it.
+  thread->isolate_group()->RunWithStoppedMutators([&]() {
+    for (const intptr_t specialization_cid : cids) {
+      if (!regexp.IsCompiled(specialization_cid, sticky)) {
+        CreateSpecializedFunction(thread, zone, regexp, specialization_cid,
+                                  sticky, owner);
+      }
+    }
+  });
+}
+
 }  // namespace dart
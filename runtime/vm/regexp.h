@@ -1515,6 +1515,14 @@ class RegExpEngine : public AllStatic {
                                 const String& pattern,
                                 RegExpFlags flags);
 
+  // Creates the specialized functions used to match subjects of class [cid],
+  // unless they already exist. Until then, the regexp runs in the bytecode
+  // interpreter (see FLAG_regexp_compilation_threshold).
+  static void EnsureCompiled(Thread* thread,
+                             const RegExp& regexp,
+                             intptr_t cid,
+                             bool sticky);
+
   static void DotPrint(const char* label, RegExpNode* node, bool ignore_case);
 };
 
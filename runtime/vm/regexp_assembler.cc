@@ -4,6 +4,8 @@
 
 #include "vm/regexp_assembler.h"
 
+#include <string.h>
+
 #include "unicode/uchar.h"
 
 #include "platform/unicode.h"
@@ -11,6 +13,7 @@
 #include "vm/flags.h"
 #include "vm/regexp.h"
 #include "vm/runtime_entry.h"
+#include "vm/thread.h"
 #include "vm/unibrow-inl.h"
 
 namespace dart {
@@ -100,8 +103,9 @@ DEFINE_RAW_LEAF_RUNTIME_ENTRY(
 
 BlockLabel::BlockLabel() {
 #if !defined(DART_PRECOMPILED_RUNTIME)
-  if (!FLAG_interpret_irregexp) {
-    // Only needed by the compiled IR backend.
+  if (Thread::Current()->HasCompilerState()) {
+    // Only needed by the compiled IR backend. The bytecode assembler also runs
+    // in JIT mode, for regexps which have not been compiled yet.
     block_ =
         new JoinEntryInstr(-1, -1, CompilerState::Current().GetNextDeoptId());
   }
@@ -127,4 +131,99 @@ void RegExpMacroAssembler::CheckNotInSurrogatePair(intptr_t cp_offset,
   BindBlock(&ok);
 }
 
+static const uint8_t* FindByteAfterAnd(const uint8_t* start,
+                                       const uint8_t* end,
+                                       uint8_t c,
+                                       uint8_t and_with) {
+  if (and_with == 0xff) {
+    const void* found = memchr(start, c, end - start);
+    return found != nullptr ? static_cast<const uint8_t*>(found) : end;
+  }
+  // Look for a zero byte in (word & and_with) ^ c, a word at a time.
+  // (x - 0x01...01) & ~x & 0x80...80 is non-zero iff some byte of x is zero.
+  const uword kOnes = ~static_cast<uword>(0) / 0xff;
+  const uword kHighBits = kOnes << 7;
+  const uword and_word = kOnes * and_with;
+  const uword char_word = kOnes * c;
+  const uint8_t* p = start;
+  while (end - p >= kWordSize) {
+    uword word;
+    memcpy(&word, p, kWordSize);
+    const uword x = (word & and_word) ^ char_word;
+    if (((x - kOnes) & ~x & kHighBits) != 0) break;
+    p += kWordSize;
+  }
+  for (; p < end; p++) {
+    if ((*p & and_with) == c) return p;
+  }
+  return end;
+}
+
+static const uint16_t* FindTwoByteAfterAnd(const uint16_t* start,
+                                           const uint16_t* end,
+                                           uint16_t c,
+                                           uint16_t and_with) {
+  for (const uint16_t* p = start; p < end; p++) {
+    if ((*p & and_with) == c) return p;
+  }
+  return end;
+}
+
+intptr_t RegExpMacroAssembler::FindCharacterAfterAnd(const String& subject,
+                                                     intptr_t from,
+                                                     uint16_t c,
+                                                     uint16_t and_with) {
+  const intptr_t length = subject.Length();
+  if (from >= length) return from;
+  ASSERT(from >= 0);
+  if ((c & ~and_with) != 0) return length;
+  NoSafepointScope no_safepoint;
+  if (subject.IsOneByteString() || subject.IsExternalOneByteString()) {
+    if (c > 0xff) return length;
+    const uint8_t* data = subject.IsOneByteString()
+                              ? OneByteString::DataStart(subject)
+                              : ExternalOneByteString::DataStart(subject);
+    return FindByteAfterAnd(data + from, data + length, c, and_with & 0xff) -
+           data;
+  }
+  const uint16_t* data = subject.IsTwoByteString()
+                             ? TwoByteString::DataStart(subject)
+                             : ExternalTwoByteString::DataStart(subject);
+  return FindTwoByteAfterAnd(data + from, data + length, c, and_with) - data;
+}
+
+template <typename Char>
+static intptr_t FindBitInTableImpl(const Char* data,
+                                   intptr_t from,
+                                   intptr_t length,
+                                   intptr_t skip,
+                                   const uint8_t* table) {
+  intptr_t i = from;
+  for (; i < length; i += skip) {
+    if (table[data[i] & RegExpMacroAssembler::kTableMask] != 0) break;
+  }
+  return i;
+}
+
+intptr_t RegExpMacroAssembler::FindBitInTable(const String& subject,
+                                              intptr_t from,
+                                              intptr_t skip,
+                                              const uint8_t* table) {
+  ASSERT(skip > 0);
+  NoSafepointScope no_safepoint;
+  const intptr_t length = subject.Length();
+  if (subject.IsOneByteString()) {
+    return FindBitInTableImpl(OneByteString::DataStart(subject), from, length,
+                              skip, table);
+  } else if (subject.IsExternalOneByteString()) {
+    return FindBitInTableImpl(ExternalOneByteString::DataStart(subject), from,
+                              length, skip, table);
+  } else if (subject.IsTwoByteString()) {
+    return FindBitInTableImpl(TwoByteString::DataStart(subject), from, length,
+                              skip, table);
+  }
+  return FindBitInTableImpl(ExternalTwoByteString::DataStart(subject), from,
+                            length, skip, table);
+}
+
 }  // namespace dart
@@ -173,6 +173,20 @@ class RegExpMacroAssembler : public ZoneAllocated {
   virtual void CheckBitInTable(const TypedData& table,
                                BlockLabel* on_bit_set) = 0;
 
+  // Advances the current position until the character at [cp_offset] from it,
+  // and-ed with [and_with], is [c], or until that character is past the end of
+  // the input. Never advances further than a loop of single steps would.
+  virtual void SkipUntilCharacterAfterAnd(intptr_t cp_offset,
+                                          uint16_t c,
+                                          uint16_t and_with) = 0;
+
+  // Advances the current position in steps of [skip] until the character at
+  // [cp_offset] from it has its bit set in [table] (see CheckBitInTable), or
+  // until that character is past the end of the input.
+  virtual void SkipUntilBitInTable(intptr_t cp_offset,
+                                   const TypedData& table,
+                                   intptr_t skip) = 0;
+
   // Checks for preemption and serves as an OSR entry.
   virtual void CheckPreemption(bool is_backtrack) {}
 
@@ -234,6 +248,23 @@ class RegExpMacroAssembler : public ZoneAllocated {
   virtual void ClearRegisters(intptr_t reg_from, intptr_t reg_to) = 0;
   virtual void WriteStackPointerToRegister(intptr_t reg) = 0;
 
+  // Returns the first index at or after [from] in [subject] whose code unit,
+  // and-ed with [and_with], is [c]. Returns the length of [subject] if there is
+  // none, and [from] if it is already past the end. Scans one-byte strings a
+  // word at a time.
+  static intptr_t FindCharacterAfterAnd(const String& subject,
+                                        intptr_t from,
+                                        uint16_t c,
+                                        uint16_t and_with);
+
+  // Returns the first index [from] + k * [skip] in [subject] whose code unit
+  // has a non-zero entry in [table] (of kTableSize bytes, indexed by the code
+  // unit and-ed with kTableMask), or the first such index past the end.
+  static intptr_t FindBitInTable(const String& subject,
+                                 intptr_t from,
+                                 intptr_t skip,
+                                 const uint8_t* table);
+
   // Check that we are not in the middle of a surrogate pair.
   void CheckNotInSurrogatePair(intptr_t cp_offset, BlockLabel* on_failure);
 
@@ -335,6 +335,30 @@ void BytecodeRegExpMacroAssembler::CheckBitInTable(const TypedData& table,
   }
 }
 
+void BytecodeRegExpMacroAssembler::SkipUntilCharacterAfterAnd(
+    intptr_t cp_offset,
+    uint16_t c,
+    uint16_t and_with) {
+  ASSERT(cp_offset >= 0);
+  ASSERT(cp_offset <= kMaxCPOffset);
+  Emit(BC_SKIP_UNTIL_CHAR_AND, cp_offset);
+  Emit16(c);
+  Emit16(and_with);
+}
+
+void BytecodeRegExpMacroAssembler::SkipUntilBitInTable(intptr_t cp_offset,
+                                                       const TypedData& table,
+                                                       intptr_t skip) {
+  ASSERT(cp_offset >= 0);
+  ASSERT(cp_offset <= kMaxCPOffset);
+  ASSERT(skip > 0);
+  Emit(BC_SKIP_UNTIL_BIT_IN_TABLE, cp_offset);
+  Emit32(skip);
+  for (intptr_t i = 0; i < kTableSize; i++) {
+    Emit8(table.GetUint8(i) != 0 ? 1 : 0);
+  }
+}
+
 void BytecodeRegExpMacroAssembler::CheckNotBackReference(
     intptr_t start_reg,
     bool read_backward,
@@ -78,6 +78,12 @@ class BytecodeRegExpMacroAssembler : public RegExpMacroAssembler {
                                         uint16_t to,
                                         BlockLabel* on_not_in_range);
   virtual void CheckBitInTable(const TypedData& table, BlockLabel* on_bit_set);
+  virtual void SkipUntilCharacterAfterAnd(intptr_t cp_offset,
+                                          uint16_t c,
+                                          uint16_t and_with);
+  virtual void SkipUntilBitInTable(intptr_t cp_offset,
+                                   const TypedData& table,
+                                   intptr_t skip);
   virtual void CheckNotBackReference(intptr_t start_reg,
                                      bool read_backward,
                                      BlockLabel* on_no_match);
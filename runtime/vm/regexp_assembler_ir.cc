@@ -290,6 +290,7 @@ ArrayPtr IRRegExpMacroAssembler::Execute(const RegExp& regexp,
                                          bool sticky,
                                          Zone* zone) {
   const intptr_t cid = input.GetClassId();
+  RegExpEngine::EnsureCompiled(Thread::Current(), regexp, cid, sticky);
   const Function& fun = Function::Handle(regexp.function(cid, sticky));
   ASSERT(!fun.IsNull());
   // Create the argument list.
@@ -1189,6 +1190,58 @@ void IRRegExpMacroAssembler::CheckBitInTable(const TypedData& table,
   BranchOrBacktrack(Comparison(kNE, byte_def, zero_def), on_bit_set);
 }
 
+void IRRegExpMacroAssembler::SkipUntilCharacterAfterAnd(intptr_t cp_offset,
+                                                        uint16_t c,
+                                                        uint16_t and_with) {
+  TAG();
+  CallSkipFunction(Symbols::_skipUntilCharacter(), cp_offset,
+                   Bind(Uint64Constant(c)), Bind(Uint64Constant(and_with)));
+}
+
+void IRRegExpMacroAssembler::SkipUntilBitInTable(intptr_t cp_offset,
+                                                 const TypedData& table,
+                                                 intptr_t skip) {
+  TAG();
+  CallSkipFunction(Symbols::_skipUntilBitInTable(), cp_offset,
+                   Bind(new (Z) ConstantInstr(table)),
+                   Bind(Int64Constant(skip)));
+}
+
+void IRRegExpMacroAssembler::CallSkipFunction(const String& name,
+                                              intptr_t cp_offset,
+                                              Value* arg1,
+                                              Value* arg2) {
+  const Library& lib = Library::Handle(Z, Library::CoreLibrary());
+  const Class& regexp_class =
+      Class::Handle(Z, lib.LookupClassAllowPrivate(Symbols::_RegExp()));
+  const Function& skip_function =
+      Function::ZoneHandle(Z, regexp_class.LookupFunctionAllowPrivate(name));
+  ASSERT(!skip_function.IsNull());
+
+  // The current position is a negative offset from the end of the string,
+  // the native function works on indices.
+  Value* index_push =
+      Bind(Add(PushLocal(current_position_), PushLocal(string_param_length_)));
+  if (cp_offset != 0) {
+    index_push = Bind(Add(index_push, Bind(Int64Constant(cp_offset))));
+  }
+
+  InputsArray arguments(Z, 4);
+  arguments.Add(PushLocal(string_param_));
+  arguments.Add(index_push);
+  arguments.Add(arg1);
+  arguments.Add(arg2);
+  Value* result_push =
+      Bind(StaticCall(skip_function, std::move(arguments), ICData::kStatic));
+
+  Value* position_push =
+      Bind(Sub(result_push, PushLocal(string_param_length_)));
+  if (cp_offset != 0) {
+    position_push = Bind(Sub(position_push, Bind(Int64Constant(cp_offset))));
+  }
+  StoreLocal(current_position_, position_push);
+}
+
 bool IRRegExpMacroAssembler::CheckSpecialCharacterClass(
     uint16_t type,
     BlockLabel* on_no_match) {
@@ -84,6 +84,12 @@ class IRRegExpMacroAssembler : public RegExpMacroAssembler {
                                         uint16_t to,
                                         BlockLabel* on_not_in_range);
   virtual void CheckBitInTable(const TypedData& table, BlockLabel* on_bit_set);
+  virtual void SkipUntilCharacterAfterAnd(intptr_t cp_offset,
+                                          uint16_t c,
+                                          uint16_t and_with);
+  virtual void SkipUntilBitInTable(intptr_t cp_offset,
+                                   const TypedData& table,
+                                   intptr_t skip);
 
   // Checks whether the given offset from the current position is before
   // the end of the string.
@@ -274,6 +280,14 @@ class IRRegExpMacroAssembler : public RegExpMacroAssembler {
 
   Value* PushLocal(LocalVariable* local);
 
+  // Calls the static _RegExp function [name] with the subject string, the
+  // index of the character at [cp_offset] and [arg1], [arg2]. The call returns
+  // the index of the character to advance to.
+  void CallSkipFunction(const String& name,
+                        intptr_t cp_offset,
+                        Value* arg1,
+                        Value* arg2);
+
   Value* PushRegisterIndex(intptr_t reg);
   Value* LoadRegister(intptr_t reg);
   void StoreRegister(intptr_t reg, intptr_t value);
@@ -676,6 +676,23 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
           pc += BC_SET_CURRENT_POSITION_FROM_END_LENGTH;
           break;
         }
+        BYTECODE(SKIP_UNTIL_CHAR_AND) {
+          const intptr_t offset = insn >> BYTECODE_SHIFT;
+          const intptr_t pos = RegExpMacroAssembler::FindCharacterAfterAnd(
+              subject, current + offset, Load16Aligned(pc + 4),
+              Load16Aligned(pc + 6));
+          current = pos - offset;
+          pc += BC_SKIP_UNTIL_CHAR_AND_LENGTH;
+          break;
+        }
+        BYTECODE(SKIP_UNTIL_BIT_IN_TABLE) {
+          const intptr_t offset = insn >> BYTECODE_SHIFT;
+          const intptr_t pos = RegExpMacroAssembler::FindBitInTable(
+              subject, current + offset, Load32Aligned(pc + 4), pc + 8);
+          current = pos - offset;
+          pc += BC_SKIP_UNTIL_BIT_IN_TABLE_LENGTH;
+          break;
+        }
         default:
           UNREACHABLE();
           break;
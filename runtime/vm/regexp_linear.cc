@@ -0,0 +1,563 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/regexp_linear.h"
+
+#include "platform/unicode.h"
+#include "vm/exceptions.h"
+#include "vm/regexp.h"
+#include "vm/regexp_ast.h"
+#include "vm/regexp_parser.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+// A program is an Int32List holding a header, the instructions, each of
+// kInstructionSize words, and the character ranges they refer to.
+enum LinearOpcode : int32_t {
+  // Consumes a code unit in one of the [arg1] ranges starting at range
+  // [arg0].
+  kConsumeRanges,
+  // Continues at the next instruction and, with lower priority, at [arg0].
+  kFork,
+  // Continues at [arg0].
+  kJump,
+  // Sets register [arg0] to the current position.
+  kSetRegister,
+  // Resets registers [arg0] to [arg1] inclusive to -1.
+  kClearRegisters,
+  // Continues if RegExpAssertion::AssertionType [arg0] holds.
+  kAssertion,
+  // Reports a match.
+  kAccept,
+};
+
+static constexpr intptr_t kInstructionCountIndex = 0;
+static constexpr intptr_t kThreadCapacityIndex = 1;
+static constexpr intptr_t kHeaderSize = 2;
+static constexpr intptr_t kInstructionSize = 3;
+
+// Quantifiers with a bounded number of repetitions are compiled by repeating
+// their body, which grows exponentially with nesting. Larger programs are left
+// to the backtracking engine.
+static constexpr intptr_t kMaxInstructions = 10000;
+
+class LinearCompiler : public RegExpVisitor {
+ public:
+  explicit LinearCompiler(Zone* zone)
+      : zone_(zone), code_(zone, 64), ranges_(zone, 16) {}
+
+  bool supported() const { return supported_; }
+
+  intptr_t pc() const { return code_.length() / kInstructionSize; }
+
+  intptr_t Emit(LinearOpcode opcode, int32_t arg0 = 0, int32_t arg1 = 0) {
+    if (pc() >= kMaxInstructions) {
+      supported_ = false;
+    }
+    if (opcode == kConsumeRanges || opcode == kAccept) {
+      thread_capacity_++;
+    }
+    code_.Add(opcode);
+    code_.Add(arg0);
+    code_.Add(arg1);
+    return pc() - 1;
+  }
+
+  // Sets the target of the kFork or kJump at [at].
+  void PatchTarget(intptr_t at, intptr_t target) {
+    code_[at * kInstructionSize + 1] = target;
+  }
+
+  TypedDataPtr Finish() {
+    ASSERT(supported_);
+    const intptr_t length = kHeaderSize + code_.length() + ranges_.length();
+    const TypedData& program = TypedData::Handle(
+        zone_, TypedData::New(kTypedDataInt32ArrayCid, length, Heap::kOld));
+    program.SetInt32(kInstructionCountIndex * sizeof(int32_t), pc());
+    program.SetInt32(kThreadCapacityIndex * sizeof(int32_t), thread_capacity_);
+    intptr_t index = kHeaderSize;
+    for (intptr_t i = 0; i < code_.length(); i++) {
+      program.SetInt32(index++ * sizeof(int32_t), code_[i]);
+    }
+    for (intptr_t i = 0; i < ranges_.length(); i++) {
+      program.SetInt32(index++ * sizeof(int32_t), ranges_[i]);
+    }
+    return program.ptr();
+  }
+
+  virtual void* VisitDisjunction(RegExpDisjunction* node, void* data) {
+    ZoneGrowableArray<RegExpTree*>* alternatives = node->alternatives();
+    GrowableArray<intptr_t> exits(zone_, alternatives->length());
+    for (intptr_t i = 0; i < alternatives->length() && supported_; i++) {
+      if (i == alternatives->length() - 1) {
+        alternatives->At(i)->Accept(this, data);
+      } else {
+        const intptr_t fork = Emit(kFork);
+        alternatives->At(i)->Accept(this, data);
+        exits.Add(Emit(kJump));
+        PatchTarget(fork, pc());
+      }
+    }
+    for (intptr_t i = 0; i < exits.length(); i++) {
+      PatchTarget(exits[i], pc());
+    }
+    return nullptr;
+  }
+
+  virtual void* VisitAlternative(RegExpAlternative* node, void* data) {
+    ZoneGrowableArray<RegExpTree*>* nodes = node->nodes();
+    for (intptr_t i = 0; i < nodes->length() && supported_; i++) {
+      nodes->At(i)->Accept(this, data);
+    }
+    return nullptr;
+  }
+
+  virtual void* VisitAssertion(RegExpAssertion* node, void* data) {
+    Emit(kAssertion, node->assertion_type());
+    return nullptr;
+  }
+
+  virtual void* VisitCharacterClass(RegExpCharacterClass* node, void* data) {
+    ZoneGrowableArray<CharacterRange>* ranges = node->ranges();
+    CharacterRange::Canonicalize(ranges);
+    if (node->flags().IgnoreCase() && !node->is_standard()) {
+      CharacterRange::AddCaseEquivalents(ranges, /*is_one_byte=*/false, zone_);
+      CharacterRange::Canonicalize(ranges);
+    }
+    if (node->is_negated()) {
+      auto negated = new (zone_) ZoneGrowableArray<CharacterRange>(2);
+      CharacterRange::Negate(ranges, negated);
+      ranges = negated;
+    }
+    EmitConsume(ranges);
+    return nullptr;
+  }
+
+  virtual void* VisitAtom(RegExpAtom* node, void* data) {
+    ZoneGrowableArray<uint16_t>* chars = node->data();
+    for (intptr_t i = 0; i < chars->length() && supported_; i++) {
+      auto ranges = CharacterRange::List(
+          zone_, CharacterRange::Singleton(chars->At(i)));
+      if (node->ignore_case()) {
+        CharacterRange::AddCaseEquivalents(ranges, /*is_one_byte=*/false,
+                                           zone_);
+        CharacterRange::Canonicalize(ranges);
+      }
+      EmitConsume(ranges);
+    }
+    return nullptr;
+  }
+
+  virtual void* VisitQuantifier(RegExpQuantifier* node, void* data) {
+    RegExpTree* body = node->body();
+    // Iterations after the minimum must not match the empty string, which
+    // would need an extra check in the engine.
+    if (node->is_possessive() ||
+        (body->min_match() == 0 && node->max() > node->min())) {
+      supported_ = false;
+      return nullptr;
+    }
+    for (intptr_t i = 0; i < node->min() && supported_; i++) {
+      EmitIteration(body, data);
+    }
+    if (node->max() == RegExpTree::kInfinity) {
+      const intptr_t loop = pc();
+      const intptr_t fork = Emit(kFork);
+      if (node->is_greedy()) {
+        EmitIteration(body, data);
+        Emit(kJump, loop);
+        PatchTarget(fork, pc());
+      } else {
+        const intptr_t exit = Emit(kJump);
+        PatchTarget(fork, pc());
+        EmitIteration(body, data);
+        Emit(kJump, loop);
+        PatchTarget(exit, pc());
+      }
+      return nullptr;
+    }
+    GrowableArray<intptr_t> exits(zone_, 4);
+    for (intptr_t i = node->min(); i < node->max() && supported_; i++) {
+      const intptr_t fork = Emit(kFork);
+      if (node->is_greedy()) {
+        exits.Add(fork);
+      } else {
+        exits.Add(Emit(kJump));
+        PatchTarget(fork, pc());
+      }
+      EmitIteration(body, data);
+    }
+    for (intptr_t i = 0; i < exits.length(); i++) {
+      PatchTarget(exits[i], pc());
+    }
+    return nullptr;
+  }
+
+  virtual void* VisitCapture(RegExpCapture* node, void* data) {
+    Emit(kSetRegister, RegExpCapture::StartRegister(node->index()));
+    node->body()->Accept(this, data);
+    Emit(kSetRegister, RegExpCapture::EndRegister(node->index()));
+    return nullptr;
+  }
+
+  virtual void* VisitLookaround(RegExpLookaround* node, void* data) {
+    supported_ = false;
+    return nullptr;
+  }
+
+  virtual void* VisitBackReference(RegExpBackReference* node, void* data) {
+    supported_ = false;
+    return nullptr;
+  }
+
+  virtual void* VisitEmpty(RegExpEmpty* node, void* data) { return nullptr; }
+
+  virtual void* VisitText(RegExpText* node, void* data) {
+    GrowableArray<TextElement>* elements = node->elements();
+    for (intptr_t i = 0; i < elements->length() && supported_; i++) {
+      elements->At(i).tree()->Accept(this, data);
+    }
+    return nullptr;
+  }
+
+ private:
+  // Captures are reset at the start of each iteration.
+  void EmitIteration(RegExpTree* body, void* data) {
+    const Interval captures = body->CaptureRegisters();
+    if (!captures.is_empty()) {
+      Emit(kClearRegisters, captures.from(), captures.to());
+    }
+    body->Accept(this, data);
+  }
+
+  void EmitConsume(ZoneGrowableArray<CharacterRange>* ranges) {
+    // The engine matches code units, like the non-unicode backtracking one.
+    const intptr_t start = ranges_.length() / 2;
+    for (intptr_t i = 0; i < ranges->length(); i++) {
+      const CharacterRange& range = ranges->At(i);
+      if (range.from() > Utf16::kMaxCodeUnit) break;
+      ranges_.Add(range.from());
+      ranges_.Add(Utils::Minimum<int32_t>(range.to(), Utf16::kMaxCodeUnit));
+    }
+    Emit(kConsumeRanges, start, ranges_.length() / 2 - start);
+  }
+
+  Zone* zone_;
+  GrowableArray<int32_t> code_;
+  GrowableArray<int32_t> ranges_;
+  intptr_t thread_capacity_ = 0;
+  bool supported_ = true;
+
+  DISALLOW_COPY_AND_ASSIGN(LinearCompiler);
+};
+
+// Runs all the paths through the program in lockstep, one position of the
+// subject at a time. Paths which reach the same instruction at the same
+// position are merged, keeping the one the backtracking engine would have
+// tried first, so the work per position is bounded by the size of the program.
+class PikeVM : public ValueObject {
+ public:
+  PikeVM(Zone* zone,
+         const TypedData& program,
+         const String& subject,
+         intptr_t register_count)
+      : program_(program),
+        subject_(subject),
+        length_(subject.Length()),
+        register_count_(register_count),
+        instruction_count_(program.GetInt32(kInstructionCountIndex *
+                                            sizeof(int32_t))),
+        stack_(zone, 16) {
+    const intptr_t capacity =
+        program.GetInt32(kThreadCapacityIndex * sizeof(int32_t));
+    for (intptr_t i = 0; i < 2; i++) {
+      lists_[i].pcs = zone->Alloc<intptr_t>(capacity);
+      lists_[i].registers = zone->Alloc<int32_t>(capacity * register_count);
+      lists_[i].length = 0;
+    }
+    visited_ = zone->Alloc<intptr_t>(instruction_count_);
+    for (intptr_t i = 0; i < instruction_count_; i++) {
+      visited_[i] = -1;
+    }
+    scratch_ = zone->Alloc<int32_t>(register_count);
+    initial_ = zone->Alloc<int32_t>(register_count);
+    match_ = zone->Alloc<int32_t>(register_count);
+    for (intptr_t i = 0; i < register_count; i++) {
+      initial_[i] = -1;
+    }
+  }
+
+  const int32_t* match() const { return match_; }
+
+  // Returns True if there is a match, False if not, or an error raised while
+  // handling interrupts.
+  ObjectPtr Run(intptr_t start, bool sticky) {
+    Thread* thread = Thread::Current();
+    ThreadList* current = &lists_[0];
+    ThreadList* next = &lists_[1];
+    bool matched = false;
+    for (intptr_t position = start; position <= length_; position++) {
+      if (UNLIKELY(thread->HasScheduledInterrupts())) {
+        ErrorPtr error = thread->HandleInterrupts();
+        if (error != Object::null()) {
+          return error;
+        }
+      }
+      NoSafepointScope no_safepoint;
+      code_ = reinterpret_cast<const int32_t*>(program_.DataAddr(0));
+      if (!matched && (!sticky || position == start)) {
+        AddThread(current, 0, initial_, position);
+      }
+      if (current->length == 0) {
+        if (matched || sticky) break;
+        continue;
+      }
+      next->length = 0;
+      const int32_t code_unit =
+          position < length_ ? subject_.CharAt(position) : -1;
+      for (intptr_t i = 0; i < current->length; i++) {
+        const intptr_t pc = current->pcs[i];
+        const int32_t* registers = &current->registers[i * register_count_];
+        const int32_t* instruction = Instruction(pc);
+        if (instruction[0] == kAccept) {
+          // Paths after this one have lower priority.
+          memmove(match_, registers, register_count_ * sizeof(int32_t));
+          matched = true;
+          break;
+        }
+        ASSERT(instruction[0] == kConsumeRanges);
+        if (code_unit >= 0 && Consumes(instruction, code_unit)) {
+          AddThread(next, pc + 1, registers, position + 1);
+        }
+      }
+      ThreadList* swap = current;
+      current = next;
+      next = swap;
+    }
+    return Bool::Get(matched).ptr();
+  }
+
+ private:
+  struct ThreadList {
+    intptr_t* pcs;
+    int32_t* registers;
+    intptr_t length;
+  };
+
+  struct WorkItem {
+    enum Kind { kExplore, kRestore };
+    Kind kind;
+    // The pc to explore, or the register to restore.
+    intptr_t index;
+    int32_t value;
+  };
+
+  const int32_t* Instruction(intptr_t pc) const {
+    ASSERT(pc >= 0 && pc < instruction_count_);
+    return &code_[kHeaderSize + pc * kInstructionSize];
+  }
+
+  bool Consumes(const int32_t* instruction, int32_t code_unit) const {
+    const int32_t* ranges =
+        &code_[kHeaderSize + instruction_count_ * kInstructionSize +
+               instruction[1] * 2];
+    // The ranges are sorted and disjoint.
+    intptr_t low = 0;
+    intptr_t high = instruction[2] - 1;
+    while (low <= high) {
+      const intptr_t mid = low + (high - low) / 2;
+      if (code_unit < ranges[mid * 2]) {
+        high = mid - 1;
+      } else if (code_unit > ranges[mid * 2 + 1]) {
+        low = mid + 1;
+      } else {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static bool IsLineTerminator(int32_t c) {
+    return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+  }
+
+  static bool IsWordCharacter(int32_t c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '_';
+  }
+
+  bool Holds(intptr_t assertion, intptr_t position) const {
+    switch (assertion) {
+      case RegExpAssertion::START_OF_INPUT:
+        return position == 0;
+      case RegExpAssertion::END_OF_INPUT:
+        return position == length_;
+      case RegExpAssertion::START_OF_LINE:
+        return position == 0 || IsLineTerminator(subject_.CharAt(position - 1));
+      case RegExpAssertion::END_OF_LINE:
+        return position == length_ ||
+               IsLineTerminator(subject_.CharAt(position));
+      case RegExpAssertion::BOUNDARY:
+      case RegExpAssertion::NON_BOUNDARY: {
+        const bool before =
+            position > 0 && IsWordCharacter(subject_.CharAt(position - 1));
+        const bool after =
+            position < length_ && IsWordCharacter(subject_.CharAt(position));
+        return (before != after) == (assertion == RegExpAssertion::BOUNDARY);
+      }
+    }
+    UNREACHABLE();
+    return false;
+  }
+
+  // Follows the paths from [pc] which do not consume input, in priority
+  // order, and adds the instructions they reach which do to [list].
+  void AddThread(ThreadList* list,
+                 intptr_t pc,
+                 const int32_t* registers,
+                 intptr_t position) {
+    memmove(scratch_, registers, register_count_ * sizeof(int32_t));
+    stack_.Add({WorkItem::kExplore, pc, 0});
+    while (!stack_.is_empty()) {
+      const WorkItem item = stack_.RemoveLast();
+      if (item.kind == WorkItem::kRestore) {
+        scratch_[item.index] = item.value;
+        continue;
+      }
+      pc = item.index;
+      if (visited_[pc] == position) continue;
+      visited_[pc] = position;
+      const int32_t* instruction = Instruction(pc);
+      switch (instruction[0]) {
+        case kConsumeRanges:
+        case kAccept:
+          list->pcs[list->length] = pc;
+          memmove(&list->registers[list->length * register_count_], scratch_,
+                  register_count_ * sizeof(int32_t));
+          list->length++;
+          break;
+        case kFork:
+          stack_.Add({WorkItem::kExplore, instruction[1], 0});
+          stack_.Add({WorkItem::kExplore, pc + 1, 0});
+          break;
+        case kJump:
+          stack_.Add({WorkItem::kExplore, instruction[1], 0});
+          break;
+        case kSetRegister:
+          stack_.Add({WorkItem::kRestore, instruction[1],
+                      scratch_[instruction[1]]});
+          scratch_[instruction[1]] = position;
+          stack_.Add({WorkItem::kExplore, pc + 1, 0});
+          break;
+        case kClearRegisters:
+          for (intptr_t i = instruction[1]; i <= instruction[2]; i++) {
+            stack_.Add({WorkItem::kRestore, i, scratch_[i]});
+            scratch_[i] = -1;
+          }
+          stack_.Add({WorkItem::kExplore, pc + 1, 0});
+          break;
+        case kAssertion:
+          if (Holds(instruction[1], position)) {
+            stack_.Add({WorkItem::kExplore, pc + 1, 0});
+          }
+          break;
+        default:
+          UNREACHABLE();
+      }
+    }
+  }
+
+  const TypedData& program_;
+  const String& subject_;
+  const intptr_t length_;
+  const intptr_t register_count_;
+  const intptr_t instruction_count_;
+  const int32_t* code_ = nullptr;
+  ThreadList lists_[2];
+  // The position at which each instruction was last reached.
+  intptr_t* visited_;
+  int32_t* scratch_;
+  int32_t* initial_;
+  int32_t* match_;
+  GrowableArray<WorkItem> stack_;
+
+  DISALLOW_COPY_AND_ASSIGN(PikeVM);
+};
+
+TypedDataPtr LinearRegExp::Compile(RegExpTree* tree,
+                                   intptr_t capture_count,
+                                   RegExpFlags flags,
+                                   Zone* zone) {
+  // Unicode patterns match code points, which may span two code units.
+  if (flags.IsUnicode()) {
+    return TypedData::null();
+  }
+  LinearCompiler compiler(zone);
+  compiler.Emit(kSetRegister, RegExpCapture::StartRegister(0));
+  tree->Accept(&compiler, nullptr);
+  compiler.Emit(kSetRegister, RegExpCapture::EndRegister(0));
+  compiler.Emit(kAccept);
+  if (!compiler.supported()) {
+    return TypedData::null();
+  }
+  return compiler.Finish();
+}
+
+bool LinearRegExp::CanExecute(const RegExp& regexp, Zone* zone) {
+  Object& program = Object::Handle(zone, regexp.linear_program());
+  if (program.IsNull()) {
+    const String& pattern = String::Handle(zone, regexp.pattern());
+    RegExpCompileData* compile_data = new (zone) RegExpCompileData();
+
+    // Parsing failures are handled in the RegExp factory constructor.
+    RegExpParser::ParseRegExp(pattern, regexp.flags(), compile_data);
+
+    program = Compile(compile_data->tree, compile_data->capture_count,
+                      regexp.flags(), zone);
+    if (program.IsNull()) {
+      program = Object::sentinel().ptr();
+    } else {
+      regexp.set_num_bracket_expressions(compile_data->capture_count);
+      regexp.set_capture_name_map(compile_data->capture_name_map);
+      if (compile_data->simple) {
+        regexp.set_is_simple();
+      } else {
+        regexp.set_is_complex();
+      }
+    }
+    regexp.set_linear_program(program);
+  }
+  return program.ptr() != Object::sentinel().ptr();
+}
+
+ObjectPtr LinearRegExp::Execute(const RegExp& regexp,
+                                const String& subject,
+                                const Smi& start_index,
+                                bool sticky,
+                                Zone* zone) {
+  const TypedData& program =
+      TypedData::Handle(zone, TypedData::RawCast(regexp.linear_program()));
+  ASSERT(!program.IsNull());
+  const intptr_t register_count = (regexp.num_bracket_expressions() + 1) * 2;
+
+  PikeVM vm(zone, program, subject, register_count);
+  const Object& result =
+      Object::Handle(zone, vm.Run(start_index.Value(), sticky));
+  if (result.IsError()) {
+    Exceptions::PropagateError(Error::Cast(result));
+    UNREACHABLE();
+  }
+  if (result.ptr() != Bool::True().ptr()) {
+    return Object::null();
+  }
+
+  const TypedData& registers = TypedData::Handle(
+      zone, TypedData::New(kTypedDataInt32ArrayCid, register_count));
+  NoSafepointScope no_safepoint;
+  memmove(registers.DataAddr(0), vm.match(), register_count * sizeof(int32_t));
+  return registers.ptr();
+}
+
+}  // namespace dart
@@ -0,0 +1,44 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// A regexp engine whose running time is linear in the length of the subject,
+// in the style of RE2. It runs all the paths through the pattern in lockstep
+// (a Pike VM), so it cannot support backreferences or lookarounds.
+
+#ifndef RUNTIME_VM_REGEXP_LINEAR_H_
+#define RUNTIME_VM_REGEXP_LINEAR_H_
+
+#include "vm/allocation.h"
+#include "vm/object.h"
+
+namespace dart {
+
+class RegExpTree;
+
+class LinearRegExp : public AllStatic {
+ public:
+  // Whether the engine can run [regexp]. Compiles the program on first use
+  // and caches it on the regexp.
+  static bool CanExecute(const RegExp& regexp, Zone* zone);
+
+  // Matches [subject] from [start_index]. Returns the capture registers as an
+  // Int32List, or null if there is no match. [regexp] must have been accepted
+  // by CanExecute.
+  static ObjectPtr Execute(const RegExp& regexp,
+                           const String& subject,
+                           const Smi& start_index,
+                           bool sticky,
+                           Zone* zone);
+
+  // Compiles [tree] to a program, or returns null if the engine does not
+  // support it.
+  static TypedDataPtr Compile(RegExpTree* tree,
+                              intptr_t capture_count,
+                              RegExpFlags flags,
+                              Zone* zone);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_REGEXP_LINEAR_H_
@@ -7,7 +7,9 @@
 #include "vm/isolate.h"
 #include "vm/object.h"
 #include "vm/regexp.h"
+#include "vm/regexp_assembler_bytecode.h"
 #include "vm/regexp_assembler_ir.h"
+#include "vm/regexp_linear.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -112,4 +114,209 @@ ISOLATE_UNIT_TEST_CASE(RegExp_ExternalTwoByteString) {
   EXPECT_EQ(3, smi_2.Value());
 }
 
+
+ISOLATE_UNIT_TEST_CASE(RegExp_CompilesAfterInterpreting) {
+  if (FLAG_interpret_irregexp) return;
+  SetFlagScope<int> sfs(&FLAG_regexp_compilation_threshold, 2);
+
+  const String& pat =
+      String::Handle(Symbols::New(thread, String::Handle(String::New("bc"))));
+  const RegExp& regexp =
+      RegExp::Handle(RegExpEngine::CreateRegExp(thread, pat, RegExpFlags()));
+  EXPECT(!regexp.IsCompiled(kOneByteStringCid, /*sticky=*/false));
+
+  // The bytecode interpreter also works when regexps are compiled.
+  const String& str = String::Handle(String::New("abcba"));
+  const Smi& idx = Object::smi_zero();
+  const TypedData& interpreted =
+      TypedData::Cast(Object::Handle(BytecodeRegExpMacroAssembler::Interpret(
+          regexp, str, idx, /*sticky=*/false, thread->zone())));
+  EXPECT_EQ(2, interpreted.Length());
+  EXPECT_EQ(1, interpreted.GetInt32(0));
+  EXPECT_EQ(3, interpreted.GetInt32(sizeof(int32_t)));
+  EXPECT(!regexp.IsCompiled(kOneByteStringCid, /*sticky=*/false));
+  EXPECT_EQ(1, regexp.IncrementInterpretedExecutions());
+  EXPECT_EQ(2, regexp.IncrementInterpretedExecutions());
+
+  // Compiling for one-byte subjects replaces the one-byte bytecode, which is
+  // also used for external one-byte subjects.
+  const Array& compiled = Array::Handle(IRRegExpMacroAssembler::Execute(
+      regexp, str, idx, /*sticky=*/false, thread->zone()));
+  EXPECT_EQ(2, compiled.Length());
+  EXPECT(regexp.IsCompiled(kOneByteStringCid, /*sticky=*/false));
+  EXPECT(regexp.IsCompiled(kExternalOneByteStringCid, /*sticky=*/false));
+  EXPECT(!regexp.IsCompiled(kTwoByteStringCid, /*sticky=*/false));
+  EXPECT(!regexp.IsCompiled(kExternalTwoByteStringCid, /*sticky=*/false));
+  EXPECT(!regexp.IsCompiled(kOneByteStringCid, /*sticky=*/true));
+}
+
+
+static RegExpPtr NewRegExp(Thread* thread,
+                           const char* pattern,
+                           RegExpFlags flags = RegExpFlags()) {
+  const String& pat = String::Handle(
+      Symbols::New(thread, String::Handle(String::New(pattern))));
+  return RegExpEngine::CreateRegExp(thread, pat, flags);
+}
+
+static void ExpectLinearMatch(const char* pattern,
+                              const char* subject,
+                              std::initializer_list<int32_t> expected,
+                              RegExpFlags flags = RegExpFlags(),
+                              intptr_t start = 0,
+                              bool sticky = false) {
+  Thread* thread = Thread::Current();
+  const RegExp& regexp = RegExp::Handle(NewRegExp(thread, pattern, flags));
+  EXPECT(LinearRegExp::CanExecute(regexp, thread->zone()));
+  const String& str = String::Handle(String::New(subject));
+  const Object& result = Object::Handle(LinearRegExp::Execute(
+      regexp, str, Smi::Handle(Smi::New(start)), sticky, thread->zone()));
+  if (expected.size() == 0) {
+    EXPECT(result.IsNull());
+    return;
+  }
+  EXPECT(result.IsTypedData());
+  if (!result.IsTypedData()) return;
+  const TypedData& registers = TypedData::Cast(result);
+  EXPECT_EQ(static_cast<intptr_t>(expected.size()), registers.Length());
+  intptr_t i = 0;
+  for (int32_t value : expected) {
+    EXPECT_EQ(value, registers.GetInt32(i++ * sizeof(int32_t)));
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LinearMatches) {
+  ExpectLinearMatch("bc", "abcba", {1, 3});
+  ExpectLinearMatch("(\\w+)@(\\w+)\\.com", "mail bob@example.com now",
+                    {5, 20, 5, 8, 9, 16});
+  ExpectLinearMatch("x", "abc", {});
+  ExpectLinearMatch("^b", "ab", {});
+  ExpectLinearMatch("\\bb", "a b", {2, 3});
+  ExpectLinearMatch("[^a-c]+", "abcdefabc", {3, 6});
+  ExpectLinearMatch("a{2,3}", "aaaa", {0, 3});
+  ExpectLinearMatch("a{2,3}?", "aaaa", {0, 2});
+
+  RegExpFlags ignore_case;
+  ignore_case.SetIgnoreCase();
+  ExpectLinearMatch("ABC", "xabc", {1, 4}, ignore_case);
+
+  RegExpFlags multi_line;
+  multi_line.SetMultiLine();
+  ExpectLinearMatch("^b$", "a\nb\nc", {2, 3}, multi_line);
+
+  // Sticky matches only start at the start index.
+  ExpectLinearMatch("b", "abc", {}, RegExpFlags(), 0, /*sticky=*/true);
+  ExpectLinearMatch("b", "abc", {1, 2}, RegExpFlags(), 1, /*sticky=*/true);
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LinearMatchesLikeBacktracking) {
+  // Alternatives and quantifiers are tried in the same order.
+  ExpectLinearMatch("a|ab", "ab", {0, 1});
+  ExpectLinearMatch("(a|ab)(c|bcd)(d*)", "abcd", {0, 4, 0, 1, 1, 4, 4, 4});
+  ExpectLinearMatch("a*?b", "aab", {0, 3});
+  ExpectLinearMatch("(a+?)(a*)", "aaa", {0, 3, 0, 1, 1, 3});
+  // Captures are reset at the start of each iteration.
+  ExpectLinearMatch("(?:(a)|b)+", "ab", {0, 2, -1, -1});
+  ExpectLinearMatch("(?:(a)|(b))+", "ab", {0, 2, -1, -1, 1, 2});
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LinearPathological) {
+  // Takes exponential time in a backtracking engine.
+  const intptr_t kLength = 10000;
+  char* subject = thread->zone()->Alloc<char>(kLength + 1);
+  memset(subject, 'a', kLength);
+  subject[kLength] = '\0';
+  ExpectLinearMatch("(a+)+b", subject, {});
+  ExpectLinearMatch("(a|aa)+$", subject, {0, kLength, kLength - 1, kLength});
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LinearUnsupported) {
+  const char* const kPatterns[] = {
+      "(a)\\1", "(?=a)b", "(?<!a)b", "(a*)*", "(?:a|)+", "(a{100}){200}",
+  };
+  for (const char* pattern : kPatterns) {
+    const RegExp& regexp = RegExp::Handle(NewRegExp(thread, pattern));
+    EXPECT(!LinearRegExp::CanExecute(regexp, thread->zone()));
+    EXPECT(regexp.linear_program() == Object::sentinel().ptr());
+  }
+  RegExpFlags unicode;
+  unicode.SetUnicode();
+  const RegExp& regexp = RegExp::Handle(NewRegExp(thread, "a", unicode));
+  EXPECT(!LinearRegExp::CanExecute(regexp, thread->zone()));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_FindCharacterAfterAnd) {
+  const String& one_byte =
+      String::Handle(String::New("abcdefghijklmnopqrstuvwxyz"));
+  EXPECT_EQ(23, RegExpMacroAssembler::FindCharacterAfterAnd(one_byte, 0, 'x',
+                                                            0xffff));
+  EXPECT_EQ(23, RegExpMacroAssembler::FindCharacterAfterAnd(one_byte, 23, 'x',
+                                                            0xffff));
+  EXPECT_EQ(26, RegExpMacroAssembler::FindCharacterAfterAnd(one_byte, 24, 'x',
+                                                            0xffff));
+  EXPECT_EQ(30, RegExpMacroAssembler::FindCharacterAfterAnd(one_byte, 30, 'x',
+                                                            0xffff));
+  // Masked searches scan a word at a time.
+  EXPECT_EQ(23, RegExpMacroAssembler::FindCharacterAfterAnd(one_byte, 1, 'X',
+                                                            0xdf));
+  EXPECT_EQ(26, RegExpMacroAssembler::FindCharacterAfterAnd(one_byte, 1, 'x',
+                                                            0xdf));
+  EXPECT_EQ(26, RegExpMacroAssembler::FindCharacterAfterAnd(one_byte, 0, 0x100,
+                                                            0xffff));
+
+  const String& two_byte =
+      String::Handle(String::New("ab\xC4\x80"
+                                 "cd\xC4\x80"));
+  EXPECT(two_byte.IsTwoByteString());
+  EXPECT_EQ(2, RegExpMacroAssembler::FindCharacterAfterAnd(two_byte, 0, 0x100,
+                                                           0xffff));
+  EXPECT_EQ(5, RegExpMacroAssembler::FindCharacterAfterAnd(two_byte, 3, 0x100,
+                                                           0xffff));
+  EXPECT_EQ(4, RegExpMacroAssembler::FindCharacterAfterAnd(
+                   two_byte, 0, 'd', RegExpMacroAssembler::kTableMask));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_FindBitInTable) {
+  const String& str = String::Handle(String::New("abcdefghijklmnopqrstuvwxyz"));
+  uint8_t table[RegExpMacroAssembler::kTableSize] = {};
+  table['q'] = 1;
+  EXPECT_EQ(16, RegExpMacroAssembler::FindBitInTable(str, 0, 1, table));
+  EXPECT_EQ(16, RegExpMacroAssembler::FindBitInTable(str, 0, 2, table));
+  EXPECT_EQ(27, RegExpMacroAssembler::FindBitInTable(str, 1, 2, table));
+  EXPECT_EQ(30, RegExpMacroAssembler::FindBitInTable(str, 30, 1, table));
+}
+
+static void ExpectSkippedMatch(const char* pattern,
+                               const String& subject,
+                               intptr_t start,
+                               intptr_t end) {
+  Thread* thread = Thread::Current();
+  const RegExp& regexp = RegExp::Handle(NewRegExp(thread, pattern));
+  const Smi& idx = Object::smi_zero();
+  const TypedData& interpreted =
+      TypedData::Cast(Object::Handle(BytecodeRegExpMacroAssembler::Interpret(
+          regexp, subject, idx, /*sticky=*/false, thread->zone())));
+  EXPECT_EQ(start, interpreted.GetInt32(0));
+  EXPECT_EQ(end, interpreted.GetInt32(sizeof(int32_t)));
+
+  if (FLAG_interpret_irregexp) return;
+  const TypedData& compiled =
+      TypedData::Cast(Object::Handle(IRRegExpMacroAssembler::Execute(
+          regexp, subject, idx, /*sticky=*/false, thread->zone())));
+  EXPECT_EQ(start, compiled.GetInt32(0));
+  EXPECT_EQ(end, compiled.GetInt32(sizeof(int32_t)));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_SkipsToPossibleMatches) {
+  const intptr_t kLength = 1000;
+  char* chars = thread->zone()->Alloc<char>(kLength + 1);
+  memset(chars, 'x', kLength);
+  memcpy(chars + kLength - 10, "needle", 6);
+  chars[kLength] = '\0';
+  const String& subject = String::Handle(String::New(chars));
+  ExpectSkippedMatch("needle", subject, kLength - 10, kLength - 4);
+  ExpectSkippedMatch("n[aeiou]edle", subject, kLength - 10, kLength - 4);
+  ExpectSkippedMatch("needle|nail", subject, kLength - 10, kLength - 4);
+}
+
 }  // namespace dart
@@ -8,20 +8,20 @@
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/stub_code.h"
+#include "vm/thread.h"
 
 namespace dart {
 
-CodePtr ReversePc::FindCodeInGroup(IsolateGroup* group,
-                                   uword pc,
-                                   bool is_return_address) {
-#if defined(DART_PRECOMPILED_RUNTIME)
-  // This can run in the middle of GC and must not allocate handles.
-  NoSafepointScope no_safepoint;
-
-  if (is_return_address) {
-    pc--;
-  }
+static InstructionsTablePtr TableAt(IsolateGroup* group, intptr_t index) {
+  GrowableObjectArrayPtr tables = group->object_store()->instructions_tables();
+  return static_cast<InstructionsTablePtr>(
+      tables->untag()->data()->untag()->element(index));
+}
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+static intptr_t FindEntryInGroup(IsolateGroup* group,
+                                 uword pc,
+                                 intptr_t* table_index) {
   // This expected number of tables is low (one per loading unit), so we go
   // through them linearly. If this changes, would could sort the table list
   // during deserialization and binary search for the table.
@@ -30,50 +30,55 @@ CodePtr ReversePc::FindCodeInGroup(IsolateGroup* group,
   for (intptr_t i = 0; i < tables_length; i++) {
     InstructionsTablePtr table = static_cast<InstructionsTablePtr>(
         tables->untag()->data()->untag()->element(i));
-    CodePtr code = InstructionsTable::FindCode(table, pc);
-    if (code != Code::null()) {
-      return code;
+    const intptr_t entry_index = InstructionsTable::FindEntry(table, pc);
+    if (entry_index != -1) {
+      *table_index = i;
+      return entry_index;
     }
   }
-#endif  // defined(DART_PRECOMPILED_RUNTIME)
-  return Code::null();
+  return -1;
 }
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
 
-const UntaggedCompressedStackMaps::Payload* ReversePc::FindStackMapInGroup(
-    IsolateGroup* group,
-    uword pc,
-    bool is_return_address,
-    uword* code_start,
-    const UntaggedCompressedStackMaps::Payload** global_table) {
+intptr_t ReversePc::FindEntry(IsolateGroup* group,
+                              uword pc,
+                              InstructionsTablePtr* table,
+                              IsolateGroup** table_group) {
 #if defined(DART_PRECOMPILED_RUNTIME)
   // This can run in the middle of GC and must not allocate handles.
   NoSafepointScope no_safepoint;
 
-  if (is_return_address) {
-    pc--;
+  ReversePcCache* cache = nullptr;
+  Thread* thread = Thread::Current();
+  if (thread != nullptr) {
+    cache = thread->reverse_pc_cache();
   }
 
-  // This expected number of tables is low (one per loading unit), so we go
-  // through them linearly. If this changes, would could sort the table list
-  // during deserialization and binary search for the table.
-  GrowableObjectArrayPtr tables = group->object_store()->instructions_tables();
-  intptr_t tables_length = Smi::Value(tables->untag()->length());
-  for (intptr_t i = 0; i < tables_length; i++) {
-    InstructionsTablePtr table = static_cast<InstructionsTablePtr>(
-        tables->untag()->data()->untag()->element(i));
-    auto map = InstructionsTable::FindStackMap(table, pc, code_start);
-    if (map != nullptr) {
-      // Take global table from the first table.
-      table = static_cast<InstructionsTablePtr>(
-          tables->untag()->data()->untag()->element(0));
-      *global_table = InstructionsTable::GetCanonicalStackMap(table);
-      return map;
+  bool in_vm_isolate_group = false;
+  intptr_t table_index = -1;
+  intptr_t entry_index = -1;
+  if (cache == nullptr || !cache->Lookup(group, pc, &in_vm_isolate_group,
+                                         &table_index, &entry_index)) {
+    entry_index = FindEntryInGroup(group, pc, &table_index);
+    if (entry_index == -1) {
+      in_vm_isolate_group = true;
+      entry_index =
+          FindEntryInGroup(Dart::vm_isolate_group(), pc, &table_index);
+    }
+    if (entry_index == -1) {
+      return -1;
+    }
+    if (cache != nullptr) {
+      cache->Insert(group, pc, in_vm_isolate_group, table_index, entry_index);
     }
   }
-#endif  // defined(DART_PRECOMPILED_RUNTIME)
 
-  *code_start = 0;
-  return nullptr;
+  *table_group = in_vm_isolate_group ? Dart::vm_isolate_group() : group;
+  *table = TableAt(*table_group, table_index);
+  return entry_index;
+#else
+  return -1;
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
 }
 
 const UntaggedCompressedStackMaps::Payload* ReversePc::FindStackMap(
@@ -85,27 +90,21 @@ const UntaggedCompressedStackMaps::Payload* ReversePc::FindStackMap(
   ASSERT(FLAG_precompiled_mode);
   NoSafepointScope no_safepoint;
 
-  auto map = FindStackMapInGroup(group, pc, is_return_address, code_start,
-                                 global_table);
-  if (map == nullptr) {
-    map = FindStackMapInGroup(Dart::vm_isolate_group(), pc, is_return_address,
-                              code_start, global_table);
+  if (is_return_address) {
+    pc--;
   }
-  return map;
-}
-
-CodePtr ReversePc::FindCode(IsolateGroup* group,
-                            uword pc,
-                            bool is_return_address) {
-  ASSERT(FLAG_precompiled_mode);
-  NoSafepointScope no_safepoint;
 
-  auto code_descriptor = FindCodeInGroup(group, pc, is_return_address);
-  if (code_descriptor == Code::null()) {
-    code_descriptor =
-        FindCodeInGroup(Dart::vm_isolate_group(), pc, is_return_address);
+  InstructionsTablePtr table;
+  IsolateGroup* table_group;
+  const intptr_t entry_index = FindEntry(group, pc, &table, &table_group);
+  if (entry_index == -1) {
+    *code_start = 0;
+    return nullptr;
   }
-  return code_descriptor;
+  // Take global table from the first table.
+  *global_table =
+      InstructionsTable::GetCanonicalStackMap(TableAt(table_group, 0));
+  return InstructionsTable::StackMapAtEntry(table, entry_index, code_start);
 }
 
 CodePtr ReversePc::Lookup(IsolateGroup* group,
@@ -114,7 +113,17 @@ CodePtr ReversePc::Lookup(IsolateGroup* group,
   ASSERT(FLAG_precompiled_mode);
   NoSafepointScope no_safepoint;
 
-  return FindCode(group, pc, is_return_address);
+  if (is_return_address) {
+    pc--;
+  }
+
+  InstructionsTablePtr table;
+  IsolateGroup* table_group;
+  const intptr_t entry_index = FindEntry(group, pc, &table, &table_group);
+  if (entry_index == -1) {
+    return Code::null();
+  }
+  return InstructionsTable::CodeAtEntry(table, pc, entry_index);
 }
 
 }  // namespace dart
@@ -14,6 +14,73 @@ namespace dart {
 
 class IsolateGroup;
 
+// A small direct-mapped cache of recent reverse pc lookups, kept per thread.
+// Unwinding and stack walking tend to look up the same return addresses over
+// and over again, each of which otherwise costs a binary search through the
+// instructions tables.
+//
+// The cache records where a pc was found rather than the Code object itself,
+// because Code objects can be moved by the GC while instructions tables are
+// only ever appended to.
+class ReversePcCache {
+ public:
+  ReversePcCache() { Clear(); }
+
+  // Returns true and sets the location of the entry if |pc| was recently
+  // looked up in |group|.
+  bool Lookup(IsolateGroup* group,
+              uword pc,
+              bool* in_vm_isolate_group,
+              intptr_t* table_index,
+              intptr_t* entry_index) const {
+    const Entry& entry = entries_[IndexOf(pc)];
+    if (entry.pc != pc || entry.group != group) return false;
+    *in_vm_isolate_group = entry.in_vm_isolate_group;
+    *table_index = entry.table_index;
+    *entry_index = entry.entry_index;
+    return true;
+  }
+
+  void Insert(IsolateGroup* group,
+              uword pc,
+              bool in_vm_isolate_group,
+              intptr_t table_index,
+              intptr_t entry_index) {
+    Entry& entry = entries_[IndexOf(pc)];
+    entry.pc = pc;
+    entry.group = group;
+    entry.in_vm_isolate_group = in_vm_isolate_group;
+    entry.table_index = static_cast<int32_t>(table_index);
+    entry.entry_index = static_cast<int32_t>(entry_index);
+  }
+
+  void Clear() {
+    for (intptr_t i = 0; i < kNumEntries; i++) {
+      entries_[i].pc = 0;
+      entries_[i].group = nullptr;
+    }
+  }
+
+ private:
+  static constexpr intptr_t kNumEntries = 64;
+
+  struct Entry {
+    uword pc;
+    IsolateGroup* group;
+    int32_t table_index;
+    int32_t entry_index;
+    bool in_vm_isolate_group;
+  };
+
+  static intptr_t IndexOf(uword pc) {
+    return ((pc >> 2) ^ (pc >> 8)) & (kNumEntries - 1);
+  }
+
+  Entry entries_[kNumEntries];
+
+  DISALLOW_COPY_AND_ASSIGN(ReversePcCache);
+};
+
 // This class provides mechanism to find Code and CompressedStackMaps
 // objects corresponding to the given PC.
 // Can only be used in AOT runtime with bare instructions.
@@ -31,19 +98,13 @@ class ReversePc : public AllStatic {
       const UntaggedCompressedStackMaps::Payload** global_table);
 
  private:
-  static const UntaggedCompressedStackMaps::Payload* FindStackMapInGroup(
-      IsolateGroup* group,
-      uword pc,
-      bool is_return_address,
-      uword* code_start,
-      const UntaggedCompressedStackMaps::Payload** global_table);
-
-  static CodePtr FindCodeInGroup(IsolateGroup* group,
-                                 uword pc,
-                                 bool is_return_address);
-  static CodePtr FindCode(IsolateGroup* group,
-                          uword pc,
-                          bool is_return_address);
+  // Finds the instructions table entry containing |pc| in the given isolate
+  // |group| or the vm isolate group. Returns the index of the entry and sets
+  // |table| and |table_group|, or returns -1 if there is no such entry.
+  static intptr_t FindEntry(IsolateGroup* group,
+                            uword pc,
+                            InstructionsTablePtr* table,
+                            IsolateGroup** table_group);
 };
 
 }  // namespace dart
@@ -472,8 +472,12 @@ static void ThrowIfError(const Object& result) {
 DEFINE_RUNTIME_ENTRY(AllocateObject, 2) {
   const Class& cls = Class::CheckedHandle(zone, arguments.ArgAt(0));
   ASSERT(cls.is_allocate_finalized());
-  const Instance& instance = Instance::Handle(
-      zone, Instance::NewAlreadyFinalized(cls, SpaceForRuntimeAllocation()));
+  const Heap::Space space =
+      thread->heap()->pretenuring()->ShouldAllocateOld(cls.id())
+          ? Heap::kOld
+          : SpaceForRuntimeAllocation();
+  const Instance& instance =
+      Instance::Handle(zone, Instance::NewAlreadyFinalized(cls, space));
 
   arguments.SetReturn(instance);
   if (cls.NumTypeArguments() == 0) {
@@ -536,8 +540,9 @@ DEFINE_LEAF_RUNTIME_ENTRY(uword /*ObjectPtr*/,
 
   // For incremental write barrier elimination, we need to ensure that the
   // allocation ends up in the new space or else the object needs to added
-  // to deferred marking stack so it will be [re]scanned.
-  if (thread->is_marking()) {
+  // to deferred marking stack so it will be [re]scanned. Card-marked arrays
+  // keep their write barriers, so rescanning them would only repeat work.
+  if (thread->is_marking() && !object->untag()->IsCardRemembered()) {
     thread->DeferredMarkingStackAddObject(object);
   }
 
@@ -2962,11 +2967,21 @@ static void HandleOSRRequest(Thread* thread) {
                  function.usage_counter());
   }
 
-  // Since the code is referenced from the frame and the ZoneHandle,
-  // it cannot have been removed from the function.
-  const Object& result = Object::Handle(
-      Compiler::CompileOptimizedFunction(thread, function, osr_id));
-  ThrowIfError(result);
+  // Reuse the code compiled when this loop was entered before, e.g. by an
+  // earlier invocation which did not return through optimized code.
+  Object& result = Object::Handle(function.GetOsrCode(osr_id));
+  if (result.IsNull()) {
+    // Since the code is referenced from the frame and the ZoneHandle,
+    // it cannot have been removed from the function.
+    result = Compiler::CompileOptimizedFunction(thread, function, osr_id);
+    ThrowIfError(result);
+    if (!result.IsNull()) {
+      function.SetOsrCode(osr_id, Code::Cast(result));
+    }
+  } else if (FLAG_trace_osr) {
+    OS::PrintErr("Reusing OSR code for %s at id=%" Pd "\n",
+                 function.ToFullyQualifiedCString(), osr_id);
+  }
 
   if (!result.IsNull()) {
     const Code& code = Code::Cast(result);
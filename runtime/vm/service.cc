@@ -16,6 +16,7 @@
 #include "vm/base64.h"
 #include "vm/canonical_tables.h"
 #include "vm/closure_functions_cache.h"
+#include "vm/compilation_log.h"
 #include "vm/compiler/jit/compiler.h"
 #include "vm/cpu.h"
 #include "vm/dart_api_impl.h"
@@ -24,8 +25,11 @@
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
 #include "vm/heap/safepoint.h"
+#include "vm/heap/sampled_allocation_profile.h"
+#include "vm/heap/sampler.h"
 #include "vm/isolate.h"
 #include "vm/kernel_isolate.h"
+#include "vm/lock_contention.h"
 #include "vm/lockers.h"
 #include "vm/message.h"
 #include "vm/message_handler.h"
@@ -1599,6 +1603,19 @@ static void GetIsolateGroup(Thread* thread, JSONStream* js) {
   });
 }
 
+static const MethodParameter* const get_lock_contention_profile_params[] = {
+    NO_ISOLATE_PARAMETER,
+    new BoolParameter("reset", false),
+    nullptr,
+};
+
+static void GetLockContentionProfile(Thread* thread, JSONStream* js) {
+  LockContentionProfiler::PrintJSON(js);
+  if (BoolParameter::Parse(js->LookupParam("reset"), false)) {
+    LockContentionProfiler::Reset();
+  }
+}
+
 static const MethodParameter* const get_memory_usage_params[] = {
     ISOLATE_PARAMETER,
     nullptr,
@@ -2583,6 +2600,68 @@ static void GetRetainedSize(Thread* thread, JSONStream* js) {
   result.PrintJSON(js, true);
 }
 
+static const MethodParameter* const get_retained_sizes_by_class_params[] = {
+    RUNNABLE_ISOLATE_PARAMETER,
+    new BoolParameter("setBaseline", false),
+    nullptr,
+};
+
+// Reports the number, size and retained size of the instances of every class,
+// and how they changed since the baseline if one was set.
+static void GetRetainedSizesByClass(Thread* thread, JSONStream* js) {
+  IsolateGroup* isolate_group = thread->isolate_group();
+  std::unique_ptr<ClassRetainedSizes> sizes;
+  {
+    ObjectGraph graph(thread);
+    sizes.reset(graph.RetainedSizesByClass());
+  }
+  const ClassRetainedSizes* baseline = isolate_group->retained_sizes_baseline();
+  ClassTable* class_table = isolate_group->class_table();
+  Class& cls = Class::Handle(thread->zone());
+  {
+    JSONObject jsobj(js);
+    jsobj.AddProperty("type", "_RetainedSizesByClass");
+    jsobj.AddPropertyTimeMillis("timestamp", sizes->timestamp());
+    jsobj.AddProperty64("objects", sizes->object_count());
+    if (baseline != nullptr) {
+      jsobj.AddPropertyTimeMillis("baselineTimestamp", baseline->timestamp());
+    }
+    JSONArray members(&jsobj, "members");
+    const ClassRetainedSizes::Entry empty;
+    for (intptr_t cid = 1; cid < sizes->num_cids(); cid++) {
+      const ClassRetainedSizes::Entry& entry = sizes->At(cid);
+      const ClassRetainedSizes::Entry& old_entry =
+          (baseline != nullptr && cid < baseline->num_cids())
+              ? baseline->At(cid)
+              : empty;
+      if (entry.instances == 0 && old_entry.instances == 0) {
+        continue;
+      }
+      if (!class_table->HasValidClassAt(cid)) {
+        continue;
+      }
+      cls = class_table->At(cid);
+      JSONObject member(&members);
+      member.AddProperty("type", "_ClassRetainedSize");
+      member.AddProperty("class", cls);
+      member.AddProperty64("instances", entry.instances);
+      member.AddProperty64("shallowSize", entry.shallow_size);
+      member.AddProperty64("retainedSize", entry.retained_size);
+      if (baseline != nullptr) {
+        member.AddProperty64("instancesDelta",
+                             entry.instances - old_entry.instances);
+        member.AddProperty64("shallowSizeDelta",
+                             entry.shallow_size - old_entry.shallow_size);
+        member.AddProperty64("retainedSizeDelta",
+                             entry.retained_size - old_entry.retained_size);
+      }
+    }
+  }
+  if (BoolParameter::Parse(js->LookupParam("setBaseline"), false)) {
+    isolate_group->set_retained_sizes_baseline(sizes.release());
+  }
+}
+
 static const MethodParameter* const get_reachable_size_params[] = {
     RUNNABLE_ISOLATE_PARAMETER,
     new IdParameter("targetId", true),
@@ -3668,13 +3747,19 @@ static const char* const report_enum_names[] = {
     SourceReport::kPossibleBreakpointsStr, SourceReport::kProfileStr,
     SourceReport::kBranchCoverageStr,      nullptr,
 };
+#else
+// Code compiled with --aot_coverage can only report coverage.
+static const char* const report_enum_names[] = {
+    "Coverage",
+    nullptr,
+};
 #endif
 
 static const MethodParameter* const get_source_report_params[] = {
-#if !defined(DART_PRECOMPILED_RUNTIME)
     RUNNABLE_ISOLATE_PARAMETER,
     new EnumListParameter("reports", true, report_enum_names),
     new IdParameter("scriptId", false),
+#if !defined(DART_PRECOMPILED_RUNTIME)
     new UIntParameter("tokenPos", false),
     new UIntParameter("endTokenPos", false),
     new BoolParameter("forceCompile", false),
@@ -3682,9 +3767,55 @@ static const MethodParameter* const get_source_report_params[] = {
     nullptr,
 };
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+static void GetAotSourceReport(Thread* thread, JSONStream* js) {
+  if (!AotCoverage::IsAvailable(thread->isolate_group())) {
+    js->PrintError(kFeatureDisabled,
+                   "disabled in AOT mode unless the snapshot was compiled "
+                   "with --aot_coverage.");
+    return;
+  }
+  if (js->HasParam("tokenPos") || js->HasParam("endTokenPos") ||
+      BoolParameter::Parse(js->LookupParam("forceCompile"), false) ||
+      BoolParameter::Parse(js->LookupParam("reportLines"), false)) {
+    js->PrintError(kFeatureDisabled,
+                   "%s: only whole script coverage by token position is "
+                   "available in AOT mode.",
+                   js->method());
+    return;
+  }
+
+  Script& script = Script::Handle();
+  if (js->HasParam("scriptId")) {
+    const char* script_id_param = js->LookupParam("scriptId");
+    const Object& obj =
+        Object::Handle(LookupHeapObject(thread, script_id_param, nullptr));
+    if (obj.ptr() == Object::sentinel().ptr() || !obj.IsScript()) {
+      PrintInvalidParamError(js, "scriptId");
+      return;
+    }
+    script ^= obj.ptr();
+  }
+
+  const char* library_filters_param = js->LookupParam("libraryFilters");
+  GrowableObjectArray& library_filters = GrowableObjectArray::Handle();
+  if (library_filters_param != nullptr) {
+    library_filters = GrowableObjectArray::New();
+    intptr_t library_filters_length =
+        ParseJSONArray(thread, library_filters_param, library_filters);
+    if (library_filters_length < 0) {
+      PrintInvalidParamError(js, "library_filters");
+      return;
+    }
+  }
+
+  AotCoverage::PrintJSON(thread, js, script, library_filters);
+}
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
 static void GetSourceReport(Thread* thread, JSONStream* js) {
 #if defined(DART_PRECOMPILED_RUNTIME)
-  js->PrintError(kFeatureDisabled, "disabled in AOT mode and PRODUCT.");
+  GetAotSourceReport(thread, js);
 #else
   if (CheckCompilerDisabled(thread, js)) {
     return;
@@ -4452,6 +4583,54 @@ static void GetAllocationProfile(Thread* thread, JSONStream* js) {
   GetAllocationProfileImpl(thread, js, true);
 }
 
+static const MethodParameter* const enable_sampled_allocation_profile_params[] =
+    {
+        RUNNABLE_ISOLATE_PARAMETER,
+        new BoolParameter("enable", true),
+        new UIntParameter("samplingInterval", false),
+        nullptr,
+};
+
+static void EnableSampledAllocationProfile(Thread* thread, JSONStream* js) {
+  const bool enable =
+      BoolParameter::Parse(js->LookupParam("enable"), /*default_value=*/true);
+  if (!SampledAllocationProfile::Enable(enable)) {
+    js->PrintError(kFeatureDisabled,
+                   "Heap sampling callbacks are registered by the embedder.");
+    return;
+  }
+  if (js->HasParam("samplingInterval")) {
+    const intptr_t interval =
+        UIntParameter::Parse(js->LookupParam("samplingInterval"));
+    if (interval <= 0) {
+      PrintInvalidParamError(js, "samplingInterval");
+      return;
+    }
+    HeapProfileSampler::SetSamplingInterval(interval);
+  }
+  PrintSuccess(js);
+}
+
+static const MethodParameter* const get_sampled_allocation_profile_params[] = {
+    RUNNABLE_ISOLATE_PARAMETER,
+    new BoolParameter("reset", false),
+    new BoolParameter("gc", false),
+    nullptr,
+};
+
+static void GetSampledAllocationProfile(Thread* thread, JSONStream* js) {
+  auto isolate_group = thread->isolate_group();
+  if (BoolParameter::Parse(js->LookupParam("gc"), false)) {
+    isolate_group->heap()->CollectAllGarbage(GCReason::kDebugging);
+  }
+  SampledAllocationProfile* profile =
+      isolate_group->sampled_allocation_profile();
+  profile->PrintJSON(thread, js);
+  if (BoolParameter::Parse(js->LookupParam("reset"), false)) {
+    profile->ResetTotals();
+  }
+}
+
 static const MethodParameter* const collect_all_garbage_params[] = {
     RUNNABLE_ISOLATE_PARAMETER,
     nullptr,
@@ -5026,6 +5205,19 @@ static void GetClassList(Thread* thread, JSONStream* js) {
   table->PrintToJSONObject(&jsobj);
 }
 
+static const MethodParameter* const get_compilation_log_params[] = {
+    RUNNABLE_ISOLATE_PARAMETER,
+    nullptr,
+};
+
+static void GetCompilationLog(Thread* thread, JSONStream* js) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  js->PrintError(kFeatureDisabled, "Compilation log is disabled in AOT mode.");
+#else
+  thread->isolate_group()->compilation_log()->PrintJSON(js);
+#endif
+}
+
 static const MethodParameter* const get_type_arguments_list_params[] = {
     RUNNABLE_ISOLATE_PARAMETER,
     nullptr,
@@ -5498,6 +5690,7 @@ static void SetFlag(Thread* thread, JSONStream* js) {
       "pause_isolates_on_unhandled_exceptions",
       "profile_period",
       "profiler",
+      "profile_lock_contention",
   };
 
   bool allowed = false;
@@ -5741,6 +5934,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
   { "_compileExpression", CompileExpression, compile_expression_params },
   { "_enableProfiler", EnableProfiler,
     enable_profiler_params, },
+  { "_enableSampledAllocationProfile", EnableSampledAllocationProfile,
+    enable_sampled_allocation_profile_params, },
   { "evaluate", Evaluate,
     evaluate_params },
   { "evaluateInFrame", EvaluateInFrame,
@@ -5753,6 +5948,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
       get_allocation_traces_params },
   { "getClassList", GetClassList,
     get_class_list_params },
+  { "_getCompilationLog", GetCompilationLog,
+    get_compilation_log_params },
   { "getCpuSamples", GetCpuSamples,
     get_cpu_samples_params },
   { "getFlagList", GetFlagList,
@@ -5775,6 +5972,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_isolate_object_store_params },
   { "getIsolateGroup", GetIsolateGroup,
     get_isolate_group_params },
+  { "_getLockContentionProfile", GetLockContentionProfile,
+    get_lock_contention_profile_params },
   { "getMemoryUsage", GetMemoryUsage,
     get_memory_usage_params },
   { "getIsolateGroupMemoryUsage", GetIsolateGroupMemoryUsage,
@@ -5797,6 +5996,10 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_reachable_size_params },
   { "_getRetainedSize", GetRetainedSize,
     get_retained_size_params },
+  { "_getRetainedSizesByClass", GetRetainedSizesByClass,
+    get_retained_sizes_by_class_params },
+  { "_getSampledAllocationProfile", GetSampledAllocationProfile,
+    get_sampled_allocation_profile_params },
   { "lookupResolvedPackageUris", LookupResolvedPackageUris,
     lookup_resolved_package_uris_params },
   { "lookupPackageUris", LookupPackageUris,
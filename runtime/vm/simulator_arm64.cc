@@ -798,6 +798,11 @@ Simulator::Simulator() : exclusive_access_addr_(0), exclusive_access_value_(0) {
 
   pc_modified_ = false;
   icount_ = 0;
+  for (intptr_t i = 0; i < kDecodeCacheSize; i++) {
+    decode_cache_[i].pc = 0;
+    decode_cache_[i].instr_bits = 0;
+    decode_cache_[i].handler = nullptr;
+  }
   break_pc_ = nullptr;
   break_instr_ = 0;
   last_setjmp_buffer_ = nullptr;
@@ -1534,22 +1539,26 @@ void Simulator::DecodePCRel(Instr* instr) {
   }
 }
 
-void Simulator::DecodeDPImmediate(Instr* instr) {
+Simulator::DecodeFunction Simulator::ClassifyDPImmediate(Instr* instr) {
   if (instr->IsMoveWideOp()) {
-    DecodeMoveWide(instr);
+    return &Simulator::DecodeMoveWide;
   } else if (instr->IsAddSubImmOp()) {
-    DecodeAddSubImm(instr);
+    return &Simulator::DecodeAddSubImm;
   } else if (instr->IsBitfieldOp()) {
-    DecodeBitfield(instr);
+    return &Simulator::DecodeBitfield;
   } else if (instr->IsLogicalImmOp()) {
-    DecodeLogicalImm(instr);
+    return &Simulator::DecodeLogicalImm;
   } else if (instr->IsPCRelOp()) {
-    DecodePCRel(instr);
+    return &Simulator::DecodePCRel;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
+void Simulator::DecodeDPImmediate(Instr* instr) {
+  (this->*ClassifyDPImmediate(instr))(instr);
+}
+
 void Simulator::DecodeCompareAndBranch(Instr* instr) {
   const int op = instr->Bit(24);
   const Register rt = instr->RtField();
@@ -1894,26 +1903,30 @@ void Simulator::DecodeUnconditionalBranchReg(Instr* instr) {
   }
 }
 
-void Simulator::DecodeCompareBranch(Instr* instr) {
+Simulator::DecodeFunction Simulator::ClassifyCompareBranch(Instr* instr) {
   if (instr->IsCompareAndBranchOp()) {
-    DecodeCompareAndBranch(instr);
+    return &Simulator::DecodeCompareAndBranch;
   } else if (instr->IsConditionalBranchOp()) {
-    DecodeConditionalBranch(instr);
+    return &Simulator::DecodeConditionalBranch;
   } else if (instr->IsExceptionGenOp()) {
-    DecodeExceptionGen(instr);
+    return &Simulator::DecodeExceptionGen;
   } else if (instr->IsSystemOp()) {
-    DecodeSystem(instr);
+    return &Simulator::DecodeSystem;
   } else if (instr->IsTestAndBranchOp()) {
-    DecodeTestAndBranch(instr);
+    return &Simulator::DecodeTestAndBranch;
   } else if (instr->IsUnconditionalBranchOp()) {
-    DecodeUnconditionalBranch(instr);
+    return &Simulator::DecodeUnconditionalBranch;
   } else if (instr->IsUnconditionalBranchRegOp()) {
-    DecodeUnconditionalBranchReg(instr);
+    return &Simulator::DecodeUnconditionalBranchReg;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
+void Simulator::DecodeCompareBranch(Instr* instr) {
+  (this->*ClassifyCompareBranch(instr))(instr);
+}
+
 void Simulator::DecodeLoadStoreReg(Instr* instr) {
   // Calculate the address.
   const Register rn = instr->RnField();
@@ -2400,22 +2413,26 @@ void Simulator::DecodeAtomicMemory(Instr* instr) {
   }
 }
 
-void Simulator::DecodeLoadStore(Instr* instr) {
+Simulator::DecodeFunction Simulator::ClassifyLoadStore(Instr* instr) {
   if (instr->IsAtomicMemoryOp()) {
-    DecodeAtomicMemory(instr);
+    return &Simulator::DecodeAtomicMemory;
   } else if (instr->IsLoadStoreRegOp()) {
-    DecodeLoadStoreReg(instr);
+    return &Simulator::DecodeLoadStoreReg;
   } else if (instr->IsLoadStoreRegPairOp()) {
-    DecodeLoadStoreRegPair(instr);
+    return &Simulator::DecodeLoadStoreRegPair;
   } else if (instr->IsLoadRegLiteralOp()) {
-    DecodeLoadRegLiteral(instr);
+    return &Simulator::DecodeLoadRegLiteral;
   } else if (instr->IsLoadStoreExclusiveOp()) {
-    DecodeLoadStoreExclusive(instr);
+    return &Simulator::DecodeLoadStoreExclusive;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
+void Simulator::DecodeLoadStore(Instr* instr) {
+  (this->*ClassifyLoadStore(instr))(instr);
+}
+
 int64_t Simulator::ShiftOperand(uint8_t reg_size,
                                 int64_t value,
                                 Shift shift_type,
@@ -2936,26 +2953,30 @@ void Simulator::DecodeConditionalSelect(Instr* instr) {
   }
 }
 
-void Simulator::DecodeDPRegister(Instr* instr) {
+Simulator::DecodeFunction Simulator::ClassifyDPRegister(Instr* instr) {
   if (instr->IsAddSubShiftExtOp()) {
-    DecodeAddSubShiftExt(instr);
+    return &Simulator::DecodeAddSubShiftExt;
   } else if (instr->IsAddSubWithCarryOp()) {
-    DecodeAddSubWithCarry(instr);
+    return &Simulator::DecodeAddSubWithCarry;
   } else if (instr->IsLogicalShiftOp()) {
-    DecodeLogicalShift(instr);
+    return &Simulator::DecodeLogicalShift;
   } else if (instr->IsMiscDP1SourceOp()) {
-    DecodeMiscDP1Source(instr);
+    return &Simulator::DecodeMiscDP1Source;
   } else if (instr->IsMiscDP2SourceOp()) {
-    DecodeMiscDP2Source(instr);
+    return &Simulator::DecodeMiscDP2Source;
   } else if (instr->IsMiscDP3SourceOp()) {
-    DecodeMiscDP3Source(instr);
+    return &Simulator::DecodeMiscDP3Source;
   } else if (instr->IsConditionalSelectOp()) {
-    DecodeConditionalSelect(instr);
+    return &Simulator::DecodeConditionalSelect;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
+void Simulator::DecodeDPRegister(Instr* instr) {
+  (this->*ClassifyDPRegister(instr))(instr);
+}
+
 void Simulator::DecodeSIMDCopy(Instr* instr) {
   const int32_t Q = instr->Bit(30);
   const int32_t op = instr->Bit(29);
@@ -3429,18 +3450,22 @@ void Simulator::DecodeSIMDTwoReg(Instr* instr) {
   }
 }
 
-void Simulator::DecodeDPSimd1(Instr* instr) {
+Simulator::DecodeFunction Simulator::ClassifyDPSimd1(Instr* instr) {
   if (instr->IsSIMDCopyOp()) {
-    DecodeSIMDCopy(instr);
+    return &Simulator::DecodeSIMDCopy;
   } else if (instr->IsSIMDThreeSameOp()) {
-    DecodeSIMDThreeSame(instr);
+    return &Simulator::DecodeSIMDThreeSame;
   } else if (instr->IsSIMDTwoRegOp()) {
-    DecodeSIMDTwoReg(instr);
+    return &Simulator::DecodeSIMDTwoReg;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
+void Simulator::DecodeDPSimd1(Instr* instr) {
+  (this->*ClassifyDPSimd1(instr))(instr);
+}
+
 void Simulator::DecodeFPImm(Instr* instr) {
   if ((instr->Bit(31) != 0) || (instr->Bit(29) != 0) || (instr->Bit(23) != 0) ||
       (instr->Bits(5, 5) != 0)) {
@@ -3677,27 +3702,53 @@ void Simulator::DecodeFPCompare(Instr* instr) {
   }
 }
 
-void Simulator::DecodeFP(Instr* instr) {
+Simulator::DecodeFunction Simulator::ClassifyFP(Instr* instr) {
   if (instr->IsFPImmOp()) {
-    DecodeFPImm(instr);
+    return &Simulator::DecodeFPImm;
   } else if (instr->IsFPIntCvtOp()) {
-    DecodeFPIntCvt(instr);
+    return &Simulator::DecodeFPIntCvt;
   } else if (instr->IsFPOneSourceOp()) {
-    DecodeFPOneSource(instr);
+    return &Simulator::DecodeFPOneSource;
   } else if (instr->IsFPTwoSourceOp()) {
-    DecodeFPTwoSource(instr);
+    return &Simulator::DecodeFPTwoSource;
   } else if (instr->IsFPCompareOp()) {
-    DecodeFPCompare(instr);
+    return &Simulator::DecodeFPCompare;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
-void Simulator::DecodeDPSimd2(Instr* instr) {
+void Simulator::DecodeFP(Instr* instr) {
+  (this->*ClassifyFP(instr))(instr);
+}
+
+Simulator::DecodeFunction Simulator::ClassifyDPSimd2(Instr* instr) {
   if (instr->IsFPOp()) {
-    DecodeFP(instr);
+    return ClassifyFP(instr);
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
+  }
+}
+
+void Simulator::DecodeDPSimd2(Instr* instr) {
+  (this->*ClassifyDPSimd2(instr))(instr);
+}
+
+Simulator::DecodeFunction Simulator::ClassifyInstruction(Instr* instr) {
+  if (instr->IsDPImmediateOp()) {
+    return ClassifyDPImmediate(instr);
+  } else if (instr->IsCompareBranchOp()) {
+    return ClassifyCompareBranch(instr);
+  } else if (instr->IsLoadStoreOp()) {
+    return ClassifyLoadStore(instr);
+  } else if (instr->IsDPRegisterOp()) {
+    return ClassifyDPRegister(instr);
+  } else if (instr->IsDPSimd1Op()) {
+    return ClassifyDPSimd1(instr);
+  } else if (instr->IsDPSimd2Op()) {
+    return ClassifyDPSimd2(instr);
+  } else {
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
@@ -3715,21 +3766,19 @@ void Simulator::InstructionDecode(Instr* instr) {
     }
   }
 
-  if (instr->IsDPImmediateOp()) {
-    DecodeDPImmediate(instr);
-  } else if (instr->IsCompareBranchOp()) {
-    DecodeCompareBranch(instr);
-  } else if (instr->IsLoadStoreOp()) {
-    DecodeLoadStore(instr);
-  } else if (instr->IsDPRegisterOp()) {
-    DecodeDPRegister(instr);
-  } else if (instr->IsDPSimd1Op()) {
-    DecodeDPSimd1(instr);
-  } else if (instr->IsDPSimd2Op()) {
-    DecodeDPSimd2(instr);
-  } else {
-    UnimplementedInstruction(instr);
+  // The handler only depends on the instruction bits, so a cached handler
+  // stays valid until the instruction at this address is patched or the
+  // memory is reused for other code.
+  const uword pc = reinterpret_cast<uword>(instr);
+  const int32_t instr_bits = instr->InstructionBits();
+  DecodeCacheEntry* entry =
+      &decode_cache_[(pc >> Instr::kInstrSizeLog2) & (kDecodeCacheSize - 1)];
+  if ((entry->pc != pc) || (entry->instr_bits != instr_bits)) {
+    entry->pc = pc;
+    entry->instr_bits = instr_bits;
+    entry->handler = ClassifyInstruction(instr);
   }
+  (this->*entry->handler)(instr);
 
   if (!pc_modified_) {
     set_pc(reinterpret_cast<int64_t>(instr) + Instr::kInstrSize);
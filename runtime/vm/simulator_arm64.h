@@ -237,6 +237,28 @@ class Simulator {
   APPLY_OP_LIST(DECODE_OP)
 #undef DECODE_OP
 
+  // Returns the handler that executes [instr], without executing it.
+  typedef void (Simulator::*DecodeFunction)(Instr* instr);
+  DecodeFunction ClassifyInstruction(Instr* instr);
+  DecodeFunction ClassifyDPImmediate(Instr* instr);
+  DecodeFunction ClassifyCompareBranch(Instr* instr);
+  DecodeFunction ClassifyLoadStore(Instr* instr);
+  DecodeFunction ClassifyDPRegister(Instr* instr);
+  DecodeFunction ClassifyDPSimd1(Instr* instr);
+  DecodeFunction ClassifyDPSimd2(Instr* instr);
+  DecodeFunction ClassifyFP(Instr* instr);
+
+  // Handlers of recently executed instructions, indexed by address. An entry
+  // is only used if the instruction bits still match, so patched code gets
+  // decoded again.
+  struct DecodeCacheEntry {
+    uword pc;
+    int32_t instr_bits;
+    DecodeFunction handler;
+  };
+  static constexpr intptr_t kDecodeCacheSize = 4096;
+  DecodeCacheEntry decode_cache_[kDecodeCacheSize];
+
   // Executes ARM64 instructions until the PC reaches kEndSimulatingPC.
   void Execute();
 
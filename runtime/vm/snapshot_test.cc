@@ -323,6 +323,42 @@ ISOLATE_UNIT_TEST_CASE(SerializeFalse) {
   CheckEncodeDecodeMessage(scope.zone(), root);
 }
 
+ISOLATE_UNIT_TEST_CASE(SerializeApiScalarsWithoutSnapshot) {
+  ApiNativeScope scope;
+  Zone* zone = scope.zone();
+
+  Dart_CObject cobj;
+  cobj.type = Dart_CObject_kNull;
+  std::unique_ptr<Message> message =
+      WriteApiMessage(zone, &cobj, ILLEGAL_PORT, Message::kNormalPriority);
+  EXPECT(message->IsRaw());
+  EXPECT(message->raw_obj() == Object::null());
+
+  cobj.type = Dart_CObject_kBool;
+  cobj.value.as_bool = true;
+  message =
+      WriteApiMessage(zone, &cobj, ILLEGAL_PORT, Message::kNormalPriority);
+  EXPECT(message->IsRaw());
+  EXPECT(message->raw_obj() == Bool::True().ptr());
+  CheckEncodeDecodeMessage(zone, &cobj);
+
+  cobj.type = Dart_CObject_kInt32;
+  cobj.value.as_int32 = -42;
+  message =
+      WriteApiMessage(zone, &cobj, ILLEGAL_PORT, Message::kNormalPriority);
+  EXPECT(message->IsRaw());
+  EXPECT(message->raw_obj() == Smi::New(-42));
+  CheckEncodeDecodeMessage(zone, &cobj);
+
+  // Integers outside of the Smi range are still serialized.
+  cobj.type = Dart_CObject_kInt64;
+  cobj.value.as_int64 = kMaxInt64;
+  message =
+      WriteApiMessage(zone, &cobj, ILLEGAL_PORT, Message::kNormalPriority);
+  EXPECT(message->IsSnapshot());
+  CheckEncodeDecodeMessage(zone, &cobj);
+}
+
 ISOLATE_UNIT_TEST_CASE(SerializeCapability) {
   // Write snapshot with object content.
   const Capability& capability = Capability::Handle(Capability::New(12345));
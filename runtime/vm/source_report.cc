@@ -2,21 +2,26 @@
 // for details. All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #include "vm/globals.h"
-#if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+#if !defined(PRODUCT)
 #include "vm/source_report.h"
 
+#include "vm/isolate.h"
+#include "vm/json_stream.h"
+#include "vm/object.h"
+#include "vm/object_store.h"
+#if !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/bit_vector.h"
 #include "vm/closure_functions_cache.h"
 #include "vm/compiler/jit/compiler.h"
-#include "vm/isolate.h"
 #include "vm/kernel_loader.h"
-#include "vm/object.h"
-#include "vm/object_store.h"
 #include "vm/profiler.h"
 #include "vm/profiler_service.h"
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
 namespace dart {
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
 const char* SourceReport::kCallSitesStr = "_CallSites";
 const char* SourceReport::kCoverageStr = "Coverage";
 const char* SourceReport::kPossibleBreakpointsStr = "PossibleBreakpoints";
@@ -828,5 +833,129 @@ void SourceReport::CollectConstConstructorCoverageFromScripts(
   }
 }
 
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+bool AotCoverage::IsAvailable(IsolateGroup* isolate_group) {
+  return isolate_group->object_store()->aot_coverage_table() != Array::null();
+}
+
+static bool ShouldFiltersIncludeUrl(const GrowableObjectArray& library_filters,
+                                    const String& url,
+                                    String* filter) {
+  for (intptr_t i = 0; i < library_filters.Length(); ++i) {
+    *filter ^= library_filters.At(i);
+    if (url.StartsWith(*filter)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool ShouldFiltersIncludeScript(
+    Zone* zone,
+    const GrowableObjectArray& library_filters,
+    const Script& script) {
+  if (library_filters.IsNull()) return true;
+  String& filter = String::Handle(zone);
+  String& url = String::Handle(zone, script.url());
+  if (ShouldFiltersIncludeUrl(library_filters, url, &filter)) return true;
+  const Library& lib = Library::Handle(zone, script.FindLibrary());
+  if (lib.IsNull()) return false;
+  url = lib.url();
+  return ShouldFiltersIncludeUrl(library_filters, url, &filter);
+}
+
+static int CompareTokenPositions(const intptr_t* a, const intptr_t* b) {
+  if (*a == *b) return 0;
+  return *a < *b ? -1 : 1;
+}
+
+static void PrintTokenPositions(JSONObject* jsobj,
+                                const char* name,
+                                GrowableArray<intptr_t>* positions) {
+  positions->Sort(CompareTokenPositions);
+  JSONArray array(jsobj, name);
+  for (intptr_t i = 0; i < positions->length(); i++) {
+    array.AddValue(positions->At(i));
+  }
+}
+
+void AotCoverage::PrintJSON(Thread* thread,
+                            JSONStream* js,
+                            const Script& script_filter,
+                            const GrowableObjectArray& library_filters) {
+  Zone* zone = thread->zone();
+  const Array& table = Array::Handle(
+      zone, thread->isolate_group()->object_store()->aot_coverage_table());
+  Script& script = Script::Handle(zone);
+  Array& coverage = Array::Handle(zone);
+  GrowableArray<const Script*> scripts;
+  GrowableArray<intptr_t> hits;
+  GrowableArray<intptr_t> misses;
+
+  JSONObject report(js);
+  report.AddProperty("type", "SourceReport");
+  {
+    JSONArray ranges(&report, "ranges");
+    for (intptr_t i = 0; i < table.Length(); i += kEntrySize) {
+      script ^= table.At(i + kScriptIndex);
+      if (!script_filter.IsNull() && script.ptr() != script_filter.ptr()) {
+        continue;
+      }
+      // The functions of a script are mostly next to each other in the table,
+      // so look for the script from the end.
+      intptr_t script_index = -1;
+      for (intptr_t j = scripts.length() - 1; j >= 0; j--) {
+        if (scripts[j]->ptr() == script.ptr()) {
+          script_index = j;
+          break;
+        }
+      }
+      if (script_index < 0) {
+        if (!ShouldFiltersIncludeScript(zone, library_filters, script)) {
+          continue;
+        }
+        script_index = scripts.length();
+        scripts.Add(&Script::Handle(zone, script.ptr()));
+      }
+
+      hits.Clear();
+      misses.Clear();
+      coverage ^= table.At(i + kCoverageArrayIndex);
+      for (intptr_t j = 0; j < coverage.Length(); j += 2) {
+        bool is_branch_coverage;
+        const TokenPosition token_pos = TokenPosition::DecodeCoveragePosition(
+            Smi::Value(Smi::RawCast(coverage.At(j))), &is_branch_coverage);
+        if (is_branch_coverage) continue;
+        if (Smi::Value(Smi::RawCast(coverage.At(j + 1))) != 0) {
+          hits.Add(token_pos.Pos());
+        } else {
+          misses.Add(token_pos.Pos());
+        }
+      }
+
+      JSONObject range(&ranges);
+      range.AddProperty("scriptIndex", script_index);
+      range.AddProperty("startPos",
+                        TokenPosition::Deserialize(Smi::Value(
+                            Smi::RawCast(table.At(i + kStartPosIndex)))));
+      range.AddProperty("endPos",
+                        TokenPosition::Deserialize(Smi::Value(
+                            Smi::RawCast(table.At(i + kEndPosIndex)))));
+      range.AddProperty("compiled", true);
+      JSONObject cov(&range, "coverage");
+      PrintTokenPositions(&cov, "hits", &hits);
+      PrintTokenPositions(&cov, "misses", &misses);
+    }
+  }
+
+  JSONArray scripts_array(&report, "scripts");
+  for (intptr_t i = 0; i < scripts.length(); i++) {
+    scripts_array.AddValue(*scripts[i]);
+  }
+}
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
 }  // namespace dart
-#endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+#endif  // !defined(PRODUCT)
@@ -6,7 +6,7 @@
 #define RUNTIME_VM_SOURCE_REPORT_H_
 
 #include "vm/globals.h"
-#if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+#if !defined(PRODUCT)
 
 #include "vm/allocation.h"
 #include "vm/flags.h"
@@ -17,6 +17,40 @@
 
 namespace dart {
 
+class JSONStream;
+
+// Coverage recorded by code compiled with --aot_coverage.
+//
+// The precompiler cannot keep Functions alive just for coverage, since many of
+// them only survive inlined into others. Instead it stores, for each function
+// with coverage, its script, token range and coverage array in
+// ObjectStore::aot_coverage_table(). The coverage arrays have the same layout
+// as in the JIT.
+class AotCoverage : public AllStatic {
+ public:
+  enum {
+    kScriptIndex,
+    kStartPosIndex,
+    kEndPosIndex,
+    kCoverageArrayIndex,
+    kEntrySize,
+  };
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+  static bool IsAvailable(IsolateGroup* isolate_group);
+
+  // Prints a SourceReport holding a Coverage report for the functions of
+  // [script] (all scripts if null) whose URI starts with one of
+  // [library_filters] (all if null).
+  static void PrintJSON(Thread* thread,
+                        JSONStream* js,
+                        const Script& script,
+                        const GrowableObjectArray& library_filters);
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+};
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
 // A SourceReport object is used to generate reports about the program
 // source code, with information associated with source token
 // positions.  There are multiple possible kinds of reports.
@@ -156,7 +190,9 @@ class SourceReport {
   intptr_t late_error_class_id_ = ClassId::kIllegalCid;
 };
 
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 }  // namespace dart
 
-#endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+#endif  // !defined(PRODUCT)
 #endif  // RUNTIME_VM_SOURCE_REPORT_H_
@@ -366,6 +366,10 @@ CodePtr StackFrame::GetCodeObject() const {
   return static_cast<CodePtr>(pc_marker);
 }
 
+// Cached for frames whose pc is not covered by any handler, so that frames
+// an exception only passes through are not searched again on later throws.
+static constexpr uint32_t kNoHandlerPcOffset = kMaxUint32;
+
 bool StackFrame::FindExceptionHandler(Thread* thread,
                                       uword* handler_pc,
                                       bool* needs_stacktrace,
@@ -383,20 +387,23 @@ bool StackFrame::FindExceptionHandler(Thread* thread,
     return false;  // Stub frames do not have exception handlers.
   }
   start = code.PayloadStart();
-  handlers = code.exception_handlers();
-  descriptors = code.pc_descriptors();
   *is_optimized = code.is_optimized();
   HandlerInfoCache* cache = thread->isolate()->handler_info_cache();
   ExceptionHandlerInfo* info = cache->Lookup(pc());
   if (info != nullptr) {
+    if (info->handler_pc_offset == kNoHandlerPcOffset) {
+      return false;
+    }
     *handler_pc = start + info->handler_pc_offset;
     *needs_stacktrace = (info->needs_stacktrace != 0);
     *has_catch_all = (info->has_catch_all != 0);
     return true;
   }
 
+  handlers = code.exception_handlers();
   intptr_t try_index = -1;
   if (handlers.num_entries() != 0) {
+    descriptors = code.pc_descriptors();
     uword pc_offset = pc() - code.PayloadStart();
     PcDescriptors::Iterator iter(descriptors, UntaggedPcDescriptors::kAnyKind);
     while (iter.MoveNext()) {
@@ -414,6 +421,9 @@ bool StackFrame::FindExceptionHandler(Thread* thread,
       *has_catch_all = true;
       return true;
     }
+    ExceptionHandlerInfo no_handler_info = {};
+    no_handler_info.handler_pc_offset = kNoHandlerPcOffset;
+    cache->Insert(pc(), no_handler_info);
     return false;
   }
   ExceptionHandlerInfo handler_info;
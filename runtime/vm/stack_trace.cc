@@ -5,12 +5,19 @@
 #include "vm/stack_trace.h"
 
 #include "vm/dart_api_impl.h"
+#include "vm/flags.h"
 #include "vm/object_store.h"
 #include "vm/stack_frame.h"
 #include "vm/symbols.h"
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            max_async_stack_frames,
+            1000,
+            "Maximum number of awaiters collected for an async stack trace. "
+            "0 means no limit.");
+
 // Keep in sync with:
 // - sdk/lib/async/stream_controller.dart:_StreamController._STATE_SUBSCRIBED.
 const intptr_t k_StreamController__STATE_SUBSCRIBED = 1;
@@ -26,8 +33,11 @@ const intptr_t kNumArgsFutureListenerHandleValue = 1;
 
 // Instance caches library and field references.
 // This way we don't have to do the look-ups for every frame in the stack.
+// The look-ups are only done once an async frame is found, so collecting a
+// synchronous stack trace does not pay for them.
 CallerClosureFinder::CallerClosureFinder(Zone* zone)
-    : closure_(Closure::Handle(zone)),
+    : zone_(zone),
+      closure_(Closure::Handle(zone)),
       receiver_context_(Context::Handle(zone)),
       receiver_function_(Function::Handle(zone)),
       parent_function_(Function::Handle(zone)),
@@ -57,8 +67,14 @@ CallerClosureFinder::CallerClosureFinder(Zone* zone)
       state_field(Field::Handle(zone)),
       on_data_field(Field::Handle(zone)),
       state_data_field(Field::Handle(zone)),
-      has_value_field(Field::Handle(zone)) {
-  const auto& async_lib = Library::Handle(zone, Library::AsyncLibrary());
+      has_value_field(Field::Handle(zone)) {}
+
+void CallerClosureFinder::EnsureInitialized() {
+  if (initialized_) {
+    return;
+  }
+  initialized_ = true;
+  const auto& async_lib = Library::Handle(zone_, Library::AsyncLibrary());
   // Look up classes:
   // - async:
   future_impl_class = async_lib.LookupClassAllowPrivate(Symbols::FutureImpl());
@@ -123,6 +139,7 @@ CallerClosureFinder::CallerClosureFinder(Zone* zone)
 }
 
 ClosurePtr CallerClosureFinder::GetCallerInFutureImpl(const Object& future) {
+  EnsureInitialized();
   ASSERT(!future.IsNull());
   ASSERT(future.GetClassId() == future_impl_class.id());
   // Since this function is recursive, we have to keep a local ref.
@@ -135,6 +152,7 @@ ClosurePtr CallerClosureFinder::GetCallerInFutureImpl(const Object& future) {
 
 ClosurePtr CallerClosureFinder::FindCallerInAsyncStarStreamController(
     const Object& async_star_stream_controller) {
+  EnsureInitialized();
   ASSERT(async_star_stream_controller.IsInstance());
   ASSERT(async_star_stream_controller.GetClassId() ==
          async_star_stream_controller_class.id());
@@ -228,6 +246,7 @@ ClosurePtr CallerClosureFinder::GetCallerInFutureListener(
 
 ClosurePtr CallerClosureFinder::FindCallerFromSuspendState(
     const SuspendState& suspend_state) {
+  EnsureInitialized();
   context_entry_ = suspend_state.function_data();
   if (context_entry_.GetClassId() == future_impl_class.id()) {
     return GetCallerInFutureImpl(context_entry_);
@@ -296,6 +315,7 @@ ClosurePtr CallerClosureFinder::FindCaller(const Closure& receiver_closure) {
 }
 
 ObjectPtr CallerClosureFinder::GetFutureFutureListener(const Object& future) {
+  EnsureInitialized();
   ASSERT(future.GetClassId() == future_impl_class.id());
   auto& listener = Object::Handle(
       Instance::Cast(future).GetField(future_result_or_listeners_field));
@@ -308,6 +328,7 @@ ObjectPtr CallerClosureFinder::GetFutureFutureListener(const Object& future) {
 
 intptr_t CallerClosureFinder::GetFutureListenerState(
     const Object& future_listener) {
+  EnsureInitialized();
   ASSERT(future_listener.GetClassId() == future_listener_class.id());
   state_ =
       Instance::Cast(future_listener).GetField(future_listener_state_field);
@@ -316,6 +337,7 @@ intptr_t CallerClosureFinder::GetFutureListenerState(
 
 ClosurePtr CallerClosureFinder::GetFutureListenerCallback(
     const Object& future_listener) {
+  EnsureInitialized();
   ASSERT(future_listener.GetClassId() == future_listener_class.id());
   return Closure::RawCast(
       Instance::Cast(future_listener).GetField(callback_field));
@@ -323,11 +345,13 @@ ClosurePtr CallerClosureFinder::GetFutureListenerCallback(
 
 ObjectPtr CallerClosureFinder::GetFutureListenerResult(
     const Object& future_listener) {
+  EnsureInitialized();
   ASSERT(future_listener.GetClassId() == future_listener_class.id());
   return Instance::Cast(future_listener).GetField(future_listener_result_field);
 }
 
 bool CallerClosureFinder::HasCatchError(const Object& future_listener) {
+  EnsureInitialized();
   ASSERT(future_listener.GetClassId() == future_listener_class.id());
   listener_ = future_listener.ptr();
   Object& result = Object::Handle();
@@ -367,11 +391,10 @@ ClosurePtr StackTraceUtils::ClosureFromFrameFunction(
     CallerClosureFinder* caller_closure_finder,
     const DartFrameIterator& frames,
     StackFrame* frame,
+    const Function& frame_function,
     bool* skip_frame,
     bool* is_async) {
-  auto& function = Function::Handle(zone);
-
-  function = frame->LookupDartFunction();
+  auto& function = Function::Handle(zone, frame_function.ptr());
   if (function.IsNull()) {
     return Closure::null();
   }
@@ -442,9 +465,15 @@ void StackTraceUtils::UnwindAwaiterChain(
   code_array.Add(StubCode::AsynchronousGapMarker());
   pc_offset_array->Add(0);
 
-  // Traverse the trail of async futures all the way up.
+  // Traverse the trail of async futures all the way up, or until enough
+  // awaiters were collected. Deep chains would otherwise make every capture
+  // linear in the number of pending async calls.
+  intptr_t remaining_frames = FLAG_max_async_stack_frames;
   for (; !closure.IsNull();
        closure = caller_closure_finder->FindCaller(closure)) {
+    if (FLAG_max_async_stack_frames > 0 && remaining_frames-- == 0) {
+      break;
+    }
     function = closure.function();
     if (function.IsNull()) {
       continue;
@@ -499,6 +528,7 @@ void StackTraceUtils::CollectFrames(
   }
 
   auto& code = Code::Handle(zone);
+  auto& function = Function::Handle(zone);
   auto& closure = Closure::Handle(zone);
 
   CallerClosureFinder caller_closure_finder(zone);
@@ -512,15 +542,20 @@ void StackTraceUtils::CollectFrames(
 
     // If we encounter a known part of the async/Future mechanism, unwind the
     // awaiter chain from the closures.
+    // The code is looked up once and shared with ClosureFromFrameFunction,
+    // as finding it from the pc is the expensive part of collecting a frame.
+    code = frame->LookupDartCode();
+    function = (!code.IsNull() && code.IsFunctionCode()) ? code.function()
+                                                         : Function::null();
+
     bool skip_frame = false;
     bool is_async = false;
     closure = ClosureFromFrameFunction(zone, &caller_closure_finder, frames,
-                                       frame, &skip_frame, &is_async);
+                                       frame, function, &skip_frame, &is_async);
 
     // This isn't a special (async) frame we should skip.
     if (!skip_frame) {
       // Add the current synchronous frame.
-      code = frame->LookupDartCode();
       code_array.Add(code);
       const uword pc_offset = frame->pc() - code.PayloadStart();
       ASSERT(pc_offset > 0 && pc_offset <= code.Size());
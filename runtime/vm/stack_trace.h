@@ -69,6 +69,12 @@ class CallerClosureFinder {
                                      const Object& suspend_state_var);
 
  private:
+  // Looks up the async classes and fields on first use.
+  void EnsureInitialized();
+
+  Zone* zone_;
+  bool initialized_ = false;
+
   Closure& closure_;
   Context& receiver_context_;
   Function& receiver_function_;
@@ -114,6 +120,7 @@ class StackTraceUtils : public AllStatic {
       CallerClosureFinder* caller_closure_finder,
       const DartFrameIterator& frames,
       StackFrame* frame,
+      const Function& frame_function,
       bool* skip_frame,
       bool* is_async);
 
@@ -43,26 +43,33 @@ StringPtr StringFrom(const uint16_t* data, intptr_t len, Heap::Space space) {
   return String::FromUTF16(data, len, space);
 }
 
-StringPtr StringSlice::ToSymbol() const {
+StringPtr StringSlice::ToOldString() const {
   if (is_all() && str_.IsOld()) {
-    str_.SetCanonical();
     return str_.ptr();
-  } else {
-    String& result =
-        String::Handle(String::SubString(str_, begin_index_, len_, Heap::kOld));
-    result.SetCanonical();
-    result.SetHash(hash_);
-    return result.ptr();
   }
+  String& result =
+      String::Handle(String::SubString(str_, begin_index_, len_, Heap::kOld));
+  result.SetHash(hash_);
+  return result.ptr();
 }
 
-StringPtr ConcatString::ToSymbol() const {
-  String& result = String::Handle(String::Concat(str1_, str2_, Heap::kOld));
+StringPtr StringSlice::ToSymbol() const {
+  String& result = String::Handle(ToOldString());
   result.SetCanonical();
+  return result.ptr();
+}
+
+StringPtr ConcatString::ToOldString() const {
+  String& result = String::Handle(String::Concat(str1_, str2_, Heap::kOld));
   result.SetHash(hash_);
   return result.ptr();
 }
 
+StringPtr ConcatString::ToSymbol() const {
+  String& result = String::Handle(ToOldString());
+  result.SetCanonical();
+  return result.ptr();
+}
 
 const char* Symbols::Name(SymbolId symbol) {
   ASSERT((symbol > kIllegal) && (symbol < kNullCharId));
@@ -366,10 +373,21 @@ StringPtr Symbols::NewSymbol(Thread* thread, const StringType& str) {
     }
     // Otherwise we'll have to get exclusive access and get-or-insert it.
     if (symbol.IsNull()) {
+      // Allocating the string may take long or even need a GC, so it is done
+      // before taking the lock, which then only covers the probe and the
+      // insertion. If another thread inserts the same symbol first, the
+      // string is not used. It only becomes canonical once it is known to be
+      // new, since it may be the string passed in.
+      const String& candidate =
+          String::Handle(thread->zone(), str.ToOldString());
       SafepointMutexLocker ml(group->symbols_mutex());
       data = object_store->symbol_table();
       CanonicalStringSet table(&key, &value, &data);
-      symbol ^= table.InsertNewOrGet(str);
+      symbol ^= table.GetOrNull(candidate);
+      if (symbol.IsNull()) {
+        candidate.SetCanonical();
+        symbol ^= table.InsertOrGet(candidate);
+      }
       object_store->set_symbol_table(table.Release());
     }
   }
@@ -147,6 +147,7 @@ class ObjectPointerVisitor;
   V(FutureOr, "FutureOr")                                                      \
   V(FutureValue, "Future.value")                                               \
   V(GetCall, "get:call")                                                       \
+  V(GetHashCode, "get:hashCode")                                               \
   V(GetLength, "get:length")                                                   \
   V(GetRuntimeType, "get:runtimeType")                                         \
   V(GetterPrefix, "get:")                                                      \
@@ -236,6 +237,7 @@ class ObjectPointerVisitor;
   V(SubtypeTestCache, "SubtypeTestCache")                                      \
   V(SuspendStateVar, ":suspend_state_var")                                     \
   V(SwitchExpr, ":switch_expr")                                                \
+  V(SwitchHash, ":switch_hash")                                                \
   V(Symbol, "Symbol")                                                          \
   V(ThrowNew, "_throwNew")                                                     \
   V(ThrowNewInvocation, "_throwNewInvocation")                                 \
@@ -459,6 +461,8 @@ class ObjectPointerVisitor;
   V(_simpleInstanceOf, "_simpleInstanceOf")                                    \
   V(_simpleInstanceOfFalse, "_simpleInstanceOfFalse")                          \
   V(_simpleInstanceOfTrue, "_simpleInstanceOfTrue")                            \
+  V(_skipUntilBitInTable, "_skipUntilBitInTable")                              \
+  V(_skipUntilCharacter, "_skipUntilCharacter")                                \
   V(_stackTrace, "_stackTrace")                                                \
   V(_state, "_state")                                                          \
   V(_stateData, "_stateData")                                                  \
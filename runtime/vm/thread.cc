@@ -7,6 +7,7 @@
 #include "vm/cpu.h"
 #include "vm/dart_api_state.h"
 #include "vm/growable_array.h"
+#include "vm/heap/pretenuring.h"
 #include "vm/heap/safepoint.h"
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
@@ -18,6 +19,7 @@
 #include "vm/object_store.h"
 #include "vm/os_thread.h"
 #include "vm/profiler.h"
+#include "vm/reverse_pc_lookup_cache.h"
 #include "vm/runtime_entry.h"
 #include "vm/service.h"
 #include "vm/stub_code.h"
@@ -45,11 +47,17 @@ Thread::~Thread() {
   ASSERT(marking_stack_block_ == nullptr);
   // There should be no top api scopes at this point.
   ASSERT(api_top_scope() == nullptr);
-  // Delete the reusable api scope if there is one.
-  if (api_reusable_scope_ != nullptr) {
-    delete api_reusable_scope_;
-    api_reusable_scope_ = nullptr;
+  // Delete the reusable api scopes.
+  while (api_reusable_scope_ != nullptr) {
+    ApiLocalScope* scope = api_reusable_scope_;
+    api_reusable_scope_ = scope->previous();
+    delete scope;
   }
+  api_reusable_scope_count_ = 0;
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+  delete reverse_pc_cache_;
+#endif
 
   DO_IF_TSAN(delete tsan_utils_);
 }
@@ -265,6 +273,8 @@ const char* Thread::TaskKindToCString(TaskKind kind) {
       return "kSweeperTask";
     case kMarkerTask:
       return "kMarkerTask";
+    case kHeapVisitorTask:
+      return "kHeapVisitorTask";
     default:
       UNREACHABLE();
       return "";
@@ -286,6 +296,7 @@ bool Thread::EnterIsolate(Isolate* isolate, bool is_nested_reenter) {
     ASSERT(thread->isolate() == isolate);
     ASSERT(thread->isolate_group() == isolate->group());
     thread->FinishEntering(kMutatorTask);
+    thread->isolate_enter_cpu_micros_ = OS::GetCurrentThreadCPUMicros();
     return true;
   }
   return false;
@@ -302,6 +313,8 @@ void Thread::ExitIsolate(bool is_nested_exit) {
   thread->PrepareLeaving();
 
   Isolate* isolate = thread->isolate();
+  isolate->AddCpuTimeMicros(OS::GetCurrentThreadCPUMicros() -
+                            thread->isolate_enter_cpu_micros_);
   thread->set_vm_tag(isolate->is_runnable() ? VMTag::kIdleTagId
                                             : VMTag::kLoadWaitTagId);
   const bool kIsMutatorThread = true;
@@ -313,6 +326,12 @@ void Thread::ExitIsolate(bool is_nested_exit) {
                             kBypassSafepoint);
 }
 
+void Thread::AccountTLABAllocation(intptr_t bytes) {
+  if (isolate() != nullptr) {
+    isolate()->AddAllocatedBytes(bytes);
+  }
+}
+
 bool Thread::EnterIsolateAsHelper(Isolate* isolate,
                                   TaskKind kind,
                                   bool bypass_safepoint) {
@@ -449,6 +468,9 @@ ErrorPtr Thread::HandleInterrupts() {
       // occur that does promote them.
       heap()->CollectGarbage(this, GCType::kEvacuate, GCReason::kStoreBuffer);
     }
+    if (Pretenuring::IsEnabled()) {
+      heap()->pretenuring()->ApplyPendingChanges(this);
+    }
 
 #if !defined(PRODUCT)
     if (isolate()->TakeHasCompletedBlocks()) {
@@ -934,15 +956,20 @@ int Thread::ZoneSizeInBytes() const {
   return total;
 }
 
+// Enough for natives which enter nested scopes, e.g. around callbacks. The
+// zones of reusable scopes are reset, so they hold on to little memory.
+static constexpr intptr_t kMaxReusableApiScopes = 4;
+
 void Thread::EnterApiScope() {
   ASSERT(MayAllocateHandles());
-  ApiLocalScope* new_scope = api_reusable_scope();
+  ApiLocalScope* new_scope = api_reusable_scope_;
   if (new_scope == nullptr) {
     new_scope = new ApiLocalScope(api_top_scope(), top_exit_frame_info());
     ASSERT(new_scope != nullptr);
   } else {
+    api_reusable_scope_ = new_scope->previous();
+    api_reusable_scope_count_--;
     new_scope->Reinit(this, api_top_scope(), top_exit_frame_info());
-    set_api_reusable_scope(nullptr);
   }
   set_api_top_scope(new_scope);  // New scope is now the top scope.
 }
@@ -950,17 +977,27 @@ void Thread::EnterApiScope() {
 void Thread::ExitApiScope() {
   ASSERT(MayAllocateHandles());
   ApiLocalScope* scope = api_top_scope();
-  ApiLocalScope* reusable_scope = api_reusable_scope();
   set_api_top_scope(scope->previous());  // Reset top scope to previous.
-  if (reusable_scope == nullptr) {
+  if (api_reusable_scope_count_ < kMaxReusableApiScopes) {
+    ASSERT(api_reusable_scope_ != scope);
     scope->Reset(this);  // Reset the old scope which we just exited.
-    set_api_reusable_scope(scope);
+    scope->set_previous(api_reusable_scope_);
+    api_reusable_scope_ = scope;
+    api_reusable_scope_count_++;
   } else {
-    ASSERT(reusable_scope != scope);
     delete scope;
   }
 }
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+ReversePcCache* Thread::reverse_pc_cache() {
+  if (reverse_pc_cache_ == nullptr) {
+    reverse_pc_cache_ = new ReversePcCache();
+  }
+  return reverse_pc_cache_;
+}
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
 void Thread::UnwindScopes(uword stack_marker) {
   // Unwind all scopes using the same stack_marker, i.e. all scopes allocated
   // under the same top_exit_frame_info.
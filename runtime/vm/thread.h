@@ -56,6 +56,7 @@ class OSThread;
 class JSONObject;
 class NoActiveIsolateScope;
 class PcDescriptors;
+class ReversePcCache;
 class RuntimeEntry;
 class Smi;
 class StackResource;
@@ -343,6 +344,7 @@ class Thread : public ThreadState {
     kCompactorTask = 0x10,
     kScavengerTask = 0x20,
     kSampleBlockTask = 0x40,
+    kHeapVisitorTask = 0x80,
   };
   // Converts a TaskKind to its corresponding C-String name.
   static const char* TaskKindToCString(TaskKind kind);
@@ -497,12 +499,9 @@ class Thread : public ThreadState {
   // Monitor corresponding to this thread.
   Monitor* thread_lock() const { return &thread_lock_; }
 
-  // The reusable api local scope for this thread.
+  // The reusable api local scopes for this thread, chained through their
+  // previous scope.
   ApiLocalScope* api_reusable_scope() const { return api_reusable_scope_; }
-  void set_api_reusable_scope(ApiLocalScope* value) {
-    ASSERT(value == nullptr || api_reusable_scope_ == nullptr);
-    api_reusable_scope_ = value;
-  }
 
   // The api local scope for this thread, this where all local handles
   // are allocated.
@@ -688,8 +687,22 @@ class Thread : public ThreadState {
   void set_end(uword end) { end_ = end; }
   void set_true_end(uword true_end) { true_end_ = true_end; }
   static intptr_t top_offset() { return OFFSET_OF(Thread, top_); }
+
+  // The old-space allocation buffer boundaries. Not used by generated code;
+  // see PageSpace::TryAllocateThreadLocal.
+  uword old_top() const { return old_top_; }
+  uword old_end() const { return old_end_; }
+  void set_old_top(uword top) { old_top_ = top; }
+  void set_old_end(uword end) { old_end_ = end; }
   static intptr_t end_offset() { return OFFSET_OF(Thread, end_); }
 
+  // Charges the bytes allocated in a released TLAB to the isolate of |this|.
+  void AccountTLABAllocation(intptr_t bytes);
+
+  // The CPU time of this thread when it entered the isolate, see
+  // Isolate::CpuTimeMicros.
+  int64_t isolate_enter_cpu_micros() const { return isolate_enter_cpu_micros_; }
+
   int32_t no_safepoint_scope_depth() const {
 #if defined(DEBUG)
     return no_safepoint_scope_depth_;
@@ -1142,6 +1155,12 @@ class Thread : public ThreadState {
   HeapProfileSampler& heap_sampler() { return heap_sampler_; }
 #endif
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+  // The cache of recent ReversePc lookups done by this thread, allocated on
+  // first use.
+  ReversePcCache* reverse_pc_cache();
+#endif
+
   PendingDeopts& pending_deopts() { return pending_deopts_; }
 
   SafepointLevel current_safepoint_level() const {
@@ -1253,11 +1272,13 @@ class Thread : public ThreadState {
 
   Heap* heap_ = nullptr;
   uword true_end_ = 0;
+  int64_t isolate_enter_cpu_micros_ = 0;
   TaskKind task_kind_;
   TimelineStream* dart_stream_;
   StreamInfo* service_extension_stream_;
   mutable Monitor thread_lock_;
   ApiLocalScope* api_reusable_scope_;
+  intptr_t api_reusable_scope_count_ = 0;
   int32_t no_callback_scope_depth_;
   int32_t force_growth_scope_depth_ = 0;
   intptr_t no_reload_scope_depth_ = 0;
@@ -1337,6 +1358,9 @@ class Thread : public ThreadState {
   Thread* next_;  // Used to chain the thread structures in an isolate.
   bool is_mutator_thread_ = false;
 
+  uword old_top_ = 0;
+  uword old_end_ = 0;
+
   bool is_unwind_in_progress_ = false;
 
 #if defined(DEBUG)
@@ -1347,6 +1371,10 @@ class Thread : public ThreadState {
   HeapProfileSampler heap_sampler_;
 #endif
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+  ReversePcCache* reverse_pc_cache_ = nullptr;
+#endif
+
   explicit Thread(bool is_vm_isolate);
 
   void StoreBufferRelease(
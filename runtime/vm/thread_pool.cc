@@ -34,8 +34,30 @@ static int64_t ComputeTimeout(int64_t idle_start) {
   }
 }
 
-ThreadPool::ThreadPool(uintptr_t max_pool_size)
-    : all_workers_dead_(false), max_pool_size_(max_pool_size) {}
+Dart_PostTaskCallback ThreadPool::global_post_task_ = nullptr;
+void* ThreadPool::global_executor_data_ = nullptr;
+
+void ThreadPool::SetExecutor(Dart_PostTaskCallback post_task, void* data) {
+  global_post_task_ = post_task;
+  global_executor_data_ = data;
+}
+
+ThreadPool::ThreadPool(uintptr_t max_pool_size,
+                       Dart_TaskPriority default_priority)
+    : all_workers_dead_(false),
+      max_pool_size_(max_pool_size),
+      post_task_(global_post_task_),
+      executor_data_(global_executor_data_),
+      default_priority_(default_priority) {
+  num_local_queues_ = kMaxLocalQueues;
+  if (max_pool_size > 0 && max_pool_size < kMaxLocalQueues) {
+    // Blocked workers can temporarily push the pool above its maximum size,
+    // leave some room for them.
+    num_local_queues_ = Utils::Minimum(static_cast<intptr_t>(2 * max_pool_size),
+                                       kMaxLocalQueues);
+  }
+  local_queues_.reset(new LocalQueue[num_local_queues_]);
+}
 
 ThreadPool::~ThreadPool() {
   Shutdown();
@@ -48,7 +70,13 @@ void ThreadPool::Shutdown() {
     // Prevent scheduling of new tasks.
     shutting_down_ = true;
 
-    if (running_workers_.IsEmpty() && idle_workers_.IsEmpty()) {
+    if (post_task_ != nullptr) {
+      // There are no workers, only posted tasks the executor has yet to
+      // finish. The last one to finish sets [all_workers_dead_].
+      if (pending_tasks_ == 0) {
+        all_workers_dead_ = true;
+      }
+    } else if (count_workers_ == 0 && pending_tasks_ == 0) {
       // All workers have already died.
       all_workers_dead_ = true;
     } else {
@@ -66,9 +94,9 @@ void ThreadPool::Shutdown() {
     }
   }
   ASSERT(count_idle_ == 0);
-  ASSERT(count_running_ == 0);
-  ASSERT(idle_workers_.IsEmpty());
-  ASSERT(running_workers_.IsEmpty());
+  ASSERT(count_workers_ == 0);
+  ASSERT(pending_tasks_ == 0);
+  ASSERT(workers_.IsEmpty());
 
   WorkerList dead_workers_to_join;
   {
@@ -82,21 +110,225 @@ void ThreadPool::Shutdown() {
 }
 
 bool ThreadPool::RunImpl(std::unique_ptr<Task> task) {
+  // The task is counted before [shutting_down_] is checked: a worker only
+  // leaves a shutting down pool once no tasks are pending, so a task that
+  // gets past the check is guaranteed to run.
+  const intptr_t pending = ++pending_tasks_;
+  if (shutting_down_) {
+    if (post_task_ != nullptr) {
+      ExecutorTaskDone();
+    } else if (--pending_tasks_ == 0) {
+      // Shutdown may be waiting for the last worker to retire.
+      MonitorLocker ml(&pool_monitor_);
+      ml.NotifyAll();
+    }
+    return false;
+  }
+  if (post_task_ != nullptr) {
+    PostToExecutor(task.release());
+    return true;
+  }
+  EnqueueTask(task.release());
+  EnsureWorkerFor(pending);
+  return true;
+}
+
+// What the embedder's executor holds on to until it calls Dart_RunTask.
+struct ExecutorTask {
+  ThreadPool* pool;
+  ThreadPool::Task* task;
+};
+
+void ThreadPool::PostToExecutor(Task* task) {
+  const Dart_TaskPriority priority = task->priority(default_priority_);
+  auto posted = new ExecutorTask{this, task};
+  post_task_(executor_data_, reinterpret_cast<Dart_Task>(posted), priority);
+}
+
+void ThreadPool::RunExecutorTask(Dart_Task handle) {
+  auto posted = reinterpret_cast<ExecutorTask*>(handle);
+  ThreadPool* pool = posted->pool;
+  std::unique_ptr<Task> task(posted->task);
+  delete posted;
+
+  ASSERT(current_executor_pool_ == nullptr);
+  current_executor_pool_ = pool;
+  task->Run();
+  ASSERT(Isolate::Current() == nullptr);
+  task.reset();
+  current_executor_pool_ = nullptr;
+  pool->ExecutorTaskDone();
+}
+
+void ThreadPool::ExecutorTaskDone() {
+  if (--pending_tasks_ == 0 && shutting_down_) {
+    MonitorLocker eml(&exit_monitor_);
+    all_workers_dead_ = true;
+    eml.Notify();
+  }
+}
+
+void ThreadPool::EnqueueTask(Task* task) {
+  auto worker =
+      static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
+  if (worker != nullptr && worker->pool_ == this &&
+      worker->queue_index_ >= 0) {
+    LocalQueue* queue = &local_queues_[worker->queue_index_];
+    MutexLocker ml(&queue->mutex);
+    queue->tasks.Append(task);
+    queue->length++;
+    return;
+  }
+  Task* head = injected_tasks_.load(std::memory_order_relaxed);
+  do {
+    task->next_injected_ = head;
+  } while (!injected_tasks_.compare_exchange_weak(
+      head, task, std::memory_order_release, std::memory_order_relaxed));
+}
+
+ThreadPool::Task* ThreadPool::DequeueTask(Worker* worker) {
+  if (worker->queue_index_ >= 0) {
+    LocalQueue* queue = &local_queues_[worker->queue_index_];
+    if (queue->length > 0) {
+      MutexLocker ml(&queue->mutex);
+      if (!queue->tasks.IsEmpty()) {
+        queue->length--;
+        return queue->tasks.RemoveFirst();
+      }
+    }
+  }
+  if (injected_tasks_.load(std::memory_order_relaxed) != nullptr) {
+    Task* task = TakeInjectedTasks(worker);
+    if (task != nullptr) {
+      return task;
+    }
+  }
+  return StealTask(worker);
+}
+
+ThreadPool::Task* ThreadPool::TakeInjectedTasks(Worker* worker) {
+  // Taking the whole stack at once avoids the ABA problem of popping single
+  // entries.
+  Task* head = injected_tasks_.exchange(nullptr, std::memory_order_acquire);
+  if (head == nullptr) {
+    return nullptr;
+  }
+  // Reverse into scheduling order.
+  Task* first = nullptr;
+  intptr_t count = 0;
+  while (head != nullptr) {
+    Task* next = head->next_injected_;
+    head->next_injected_ = first;
+    first = head;
+    head = next;
+    count++;
+  }
+  Task* rest = first->next_injected_;
+  first->next_injected_ = nullptr;
+  if (rest == nullptr) {
+    return first;
+  }
+  if (worker->queue_index_ >= 0) {
+    // Keep the rest on our own queue where idle workers can steal them.
+    LocalQueue* queue = &local_queues_[worker->queue_index_];
+    MutexLocker ml(&queue->mutex);
+    while (rest != nullptr) {
+      Task* next = rest->next_injected_;
+      rest->next_injected_ = nullptr;
+      queue->tasks.Append(rest);
+      rest = next;
+    }
+    queue->length += count - 1;
+  } else {
+    // Without a queue of our own, put them back.
+    Task* last = rest;
+    while (last->next_injected_ != nullptr) {
+      last = last->next_injected_;
+    }
+    Task* top = injected_tasks_.load(std::memory_order_relaxed);
+    do {
+      last->next_injected_ = top;
+    } while (!injected_tasks_.compare_exchange_weak(
+        top, rest, std::memory_order_release, std::memory_order_relaxed));
+  }
+  return first;
+}
+
+ThreadPool::Task* ThreadPool::StealTask(Worker* worker) {
+  const intptr_t start = worker->queue_index_ >= 0 ? worker->queue_index_ : 0;
+  for (intptr_t i = 1; i <= num_local_queues_; i++) {
+    LocalQueue* queue = &local_queues_[(start + i) % num_local_queues_];
+    if (queue->length <= 0) {
+      continue;
+    }
+    // Steal the oldest task, which the owner would otherwise run next.
+    MutexLocker ml(&queue->mutex);
+    if (!queue->tasks.IsEmpty()) {
+      queue->length--;
+      return queue->tasks.RemoveFirst();
+    }
+  }
+  return nullptr;
+}
+
+void ThreadPool::EnsureWorkerFor(intptr_t pending_tasks) {
+  // Fast path: enough workers are idle (they re-check for tasks before
+  // sleeping), or the pool is at its maximum size and busy workers will get
+  // to the task when they are done.
+  if (count_idle_ >= pending_tasks ||
+      (max_pool_size_ > 0 &&
+       static_cast<uintptr_t>(count_workers_) >= max_pool_size_)) {
+    if (count_idle_ > 0) {
+      MonitorLocker ml(&pool_monitor_);
+      ml.Notify();
+    }
+    return;
+  }
+
   Worker* new_worker = nullptr;
   {
     MonitorLocker ml(&pool_monitor_);
-    if (shutting_down_) {
-      return false;
+    if (NeedsNewWorkerLocked(pending_tasks)) {
+      new_worker = AddWorkerLocked();
+    } else if (count_idle_ > 0) {
+      ml.Notify();
     }
-    new_worker = ScheduleTaskLocked(&ml, std::move(task));
   }
   if (new_worker != nullptr) {
     new_worker->StartThread();
   }
-  return true;
+}
+
+bool ThreadPool::NeedsNewWorkerLocked(intptr_t pending_tasks) {
+  if (count_idle_ >= pending_tasks) {
+    return false;
+  }
+  // If we have maxed out the number of threads running, we will not start a
+  // new one.
+  return max_pool_size_ == 0 ||
+         static_cast<uintptr_t>(count_workers_) < max_pool_size_;
+}
+
+ThreadPool::Worker* ThreadPool::AddWorkerLocked() {
+  auto new_worker = new Worker(this);
+  for (intptr_t i = 0; i < num_local_queues_; i++) {
+    if (!local_queues_[i].in_use) {
+      local_queues_[i].in_use = true;
+      new_worker->queue_index_ = i;
+      break;
+    }
+  }
+  workers_.Append(new_worker);
+  // New workers start out idle.
+  count_workers_++;
+  count_idle_++;
+  return new_worker;
 }
 
 bool ThreadPool::CurrentThreadIsWorker() {
+  if (current_executor_pool_ == this) {
+    return true;
+  }
   auto worker =
       static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
   return worker != nullptr && worker->pool_ == this;
@@ -115,11 +347,10 @@ void ThreadPool::MarkCurrentWorkerAsBlocked() {
       // This thread is blocked and therefore no longer usable as a worker.
       // If we have pending tasks and there are no idle workers, we will spawn a
       // new thread (temporarily allow exceeding the maximum pool size) to
-      // handle the pending tasks.
-      if (idle_workers_.IsEmpty() && pending_tasks_ > 0) {
-        new_worker = new Worker(this);
-        idle_workers_.Append(new_worker);
-        count_idle_++;
+      // handle the pending tasks. Tasks on the blocked worker's own queue
+      // are stolen by the others.
+      if (count_idle_ == 0 && pending_tasks_ > 0) {
+        new_worker = AddWorkerLocked();
       }
     }
   }
@@ -146,55 +377,64 @@ void ThreadPool::MarkCurrentWorkerAsUnBlocked() {
 void ThreadPool::WorkerLoop(Worker* worker) {
   WorkerList dead_workers_to_join;
 
+  // Workers are created idle. The idle state is only entered and left with
+  // [pool_monitor_] held, while running and scheduling tasks go through the
+  // worker queues without it.
+  //
+  // The idle count is incremented before [pending_tasks_] is checked when a
+  // worker goes idle, and [pending_tasks_] is incremented before the idle
+  // count is checked when a task is scheduled, so either the worker sees the
+  // task or the scheduler sees (and wakes) the idle worker.
   while (true) {
-    MonitorLocker ml(&pool_monitor_);
-
-    if (!tasks_.IsEmpty()) {
-      IdleToRunningLocked(worker);
-      while (!tasks_.IsEmpty()) {
-        std::unique_ptr<Task> task(tasks_.RemoveFirst());
-        pending_tasks_--;
-        MonitorLeaveScope mls(&ml);
-        task->Run();
-        ASSERT(Isolate::Current() == nullptr);
-        task.reset();
+    {
+      MonitorLocker ml(&pool_monitor_);
+      bool notified_idle = false;
+      bool done = false;
+      const int64_t idle_start = OS::GetCurrentMonotonicMicros();
+      while (true) {
+        if (pending_tasks_ > 0) {
+          count_idle_--;
+          break;
+        }
+
+        if (!notified_idle && count_idle_ == count_workers_) {
+          notified_idle = true;
+          OnEnterIdleLocked(&ml);
+          continue;
+        }
+
+        if (shutting_down_) {
+          if (TryIdleToDeadLocked(worker, &dead_workers_to_join)) {
+            done = true;
+            break;
+          }
+          continue;
+        }
+
+        // Sleep until we get a new task, we time out or we're shutdown.
+        const auto result = ml.WaitMicros(ComputeTimeout(idle_start));
+        if (result == Monitor::kTimedOut && pending_tasks_ == 0 &&
+            TryIdleToDeadLocked(worker, &dead_workers_to_join)) {
+          done = true;
+          break;
+        }
       }
-      RunningToIdleLocked(worker);
-    }
-
-    if (running_workers_.IsEmpty()) {
-      ASSERT(tasks_.IsEmpty());
-      OnEnterIdleLocked(&ml);
-      if (!tasks_.IsEmpty()) {
-        continue;
+      if (done) {
+        break;
       }
     }
 
-    if (shutting_down_) {
-      ObtainDeadWorkersLocked(&dead_workers_to_join);
-      IdleToDeadLocked(worker);
-      break;
+    // Run tasks until there are none left that we can find.
+    while (Task* raw_task = DequeueTask(worker)) {
+      pending_tasks_--;
+      std::unique_ptr<Task> task(raw_task);
+      task->Run();
+      ASSERT(Isolate::Current() == nullptr);
+      task.reset();
     }
 
-    // Sleep until we get a new task, we time out or we're shutdown.
-    const int64_t idle_start = OS::GetCurrentMonotonicMicros();
-    bool done = false;
-    while (!done) {
-      const auto result = ml.WaitMicros(ComputeTimeout(idle_start));
-
-      // We have to drain all pending tasks.
-      if (!tasks_.IsEmpty()) break;
-
-      if (shutting_down_ || result == Monitor::kTimedOut) {
-        done = true;
-        break;
-      }
-    }
-    if (done) {
-      ObtainDeadWorkersLocked(&dead_workers_to_join);
-      IdleToDeadLocked(worker);
-      break;
-    }
+    MonitorLocker ml(&pool_monitor_);
+    count_idle_++;
   }
 
   // Before we transitioned to dead we obtained the list of previously died dead
@@ -204,41 +444,38 @@ void ThreadPool::WorkerLoop(Worker* worker) {
   JoinDeadWorkersLocked(&dead_workers_to_join);
 }
 
-void ThreadPool::IdleToRunningLocked(Worker* worker) {
-  ASSERT(idle_workers_.ContainsForDebugging(worker));
-  idle_workers_.Remove(worker);
-  running_workers_.Append(worker);
-  count_idle_--;
-  count_running_++;
-}
+bool ThreadPool::TryIdleToDeadLocked(Worker* worker,
+                                     WorkerList* dead_workers_to_join) {
+  ASSERT(workers_.ContainsForDebugging(worker));
 
-void ThreadPool::RunningToIdleLocked(Worker* worker) {
-  ASSERT(tasks_.IsEmpty());
-
-  ASSERT(running_workers_.ContainsForDebugging(worker));
-  running_workers_.Remove(worker);
-  idle_workers_.Append(worker);
-  count_running_--;
-  count_idle_++;
-}
-
-void ThreadPool::IdleToDeadLocked(Worker* worker) {
-  ASSERT(tasks_.IsEmpty());
+  // Retire first, then check for tasks scheduled concurrently (see
+  // [WorkerLoop]). A scheduler which saw us as still alive is caught here.
+  count_idle_--;
+  count_workers_--;
+  if (pending_tasks_ > 0) {
+    count_idle_++;
+    count_workers_++;
+    return false;
+  }
 
-  ASSERT(idle_workers_.ContainsForDebugging(worker));
-  idle_workers_.Remove(worker);
+  if (worker->queue_index_ >= 0) {
+    LocalQueue* queue = &local_queues_[worker->queue_index_];
+    ASSERT(queue->length == 0);
+    queue->in_use = false;
+    worker->queue_index_ = -1;
+  }
+  ObtainDeadWorkersLocked(dead_workers_to_join);
+  workers_.Remove(worker);
   dead_workers_.Append(worker);
-  count_idle_--;
   count_dead_++;
 
   // Notify shutdown thread that the worker thread is about to finish.
-  if (shutting_down_) {
-    if (running_workers_.IsEmpty() && idle_workers_.IsEmpty()) {
-      all_workers_dead_ = true;
-      MonitorLocker eml(&exit_monitor_);
-      eml.Notify();
-    }
+  if (shutting_down_ && count_workers_ == 0) {
+    all_workers_dead_ = true;
+    MonitorLocker eml(&exit_monitor_);
+    eml.Notify();
   }
+  return true;
 }
 
 void ThreadPool::ObtainDeadWorkersLocked(WorkerList* dead_workers_to_join) {
@@ -259,36 +496,6 @@ void ThreadPool::JoinDeadWorkersLocked(WorkerList* dead_workers_to_join) {
   ASSERT(dead_workers_to_join->IsEmpty());
 }
 
-ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(MonitorLocker* ml,
-                                                   std::unique_ptr<Task> task) {
-  // Enqueue the new task.
-  tasks_.Append(task.release());
-  pending_tasks_++;
-  ASSERT(pending_tasks_ >= 1);
-
-  // Notify existing idle worker (if available).
-  if (count_idle_ >= pending_tasks_) {
-    ASSERT(!idle_workers_.IsEmpty());
-    ml->Notify();
-    return nullptr;
-  }
-
-  // If we have maxed out the number of threads running, we will not start a
-  // new one.
-  if (max_pool_size_ > 0 && (count_idle_ + count_running_) >= max_pool_size_) {
-    if (!idle_workers_.IsEmpty()) {
-      ml->Notify();
-    }
-    return nullptr;
-  }
-
-  // Otherwise start a new worker.
-  auto new_worker = new Worker(this);
-  idle_workers_.Append(new_worker);
-  count_idle_++;
-  return new_worker;
-}
-
 ThreadPool::Worker::Worker(ThreadPool* pool)
     : pool_(pool), join_id_(OSThread::kInvalidThreadJoinId) {}
 
@@ -323,7 +530,7 @@ void ThreadPool::Worker::Main(uword args) {
 #if defined(DEBUG)
   {
     MonitorLocker ml(&pool->pool_monitor_);
-    ASSERT(pool->idle_workers_.ContainsForDebugging(worker));
+    ASSERT(pool->workers_.ContainsForDebugging(worker));
   }
 #endif
 
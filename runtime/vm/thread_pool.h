@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 
+#include "include/dart_api.h"
 #include "vm/allocation.h"
 #include "vm/globals.h"
 #include "vm/intrusive_dlist.h"
@@ -30,11 +31,24 @@ class ThreadPool {
     // Override this to provide task-specific behavior.
     virtual void Run() = 0;
 
+    // The scheduling hint passed to the embedder's executor, if there is
+    // one. Tasks that don't override this get the default of their pool.
+    virtual Dart_TaskPriority priority(Dart_TaskPriority pool_default) const {
+      return pool_default;
+    }
+
    private:
+    friend class ThreadPool;
+
+    // Link used while the task sits on the lock-free injection stack.
+    Task* next_injected_ = nullptr;
+
     DISALLOW_COPY_AND_ASSIGN(Task);
   };
 
-  explicit ThreadPool(uintptr_t max_pool_size = 0);
+  explicit ThreadPool(
+      uintptr_t max_pool_size = 0,
+      Dart_TaskPriority default_priority = Dart_TaskPriority_Normal);
 
   // Prevent scheduling of new tasks, wait until all pending tasks are done
   // and join worker threads.
@@ -62,11 +76,39 @@ class ThreadPool {
   void Shutdown();
 
   // Exposed for unit test in thread_pool_test.cc
-  uint64_t workers_started() const { return count_idle_ + count_running_; }
+  uint64_t workers_started() const { return count_workers_; }
   // Exposed for unit test in thread_pool_test.cc
   uint64_t workers_stopped() const { return count_dead_; }
 
+  // Workers currently waiting for tasks. Racy; only a scheduling hint.
+  intptr_t idle_workers() const { return count_idle_; }
+
+  // Makes pools created afterwards post their tasks to [post_task] instead
+  // of starting worker threads (see Dart_InitializeParams.post_task).
+  static void SetExecutor(Dart_PostTaskCallback post_task, void* data);
+
+  // Runs and frees a task posted to the executor (see Dart_RunTask).
+  static void RunExecutorTask(Dart_Task task);
+
+  // Tasks not yet picked up by a worker. Racy; only for monitoring.
+  intptr_t pending_tasks() const { return pending_tasks_.load(); }
+
  private:
+  using TaskList = IntrusiveDList<Task>;
+
+  // A per-worker task queue. Tasks scheduled from a worker thread go to the
+  // worker's own queue; idle workers steal from the queues of busy ones.
+  //
+  // Queues are owned by the pool and never freed while it is alive, so
+  // thieves can look at any of them without synchronizing with worker
+  // startup and shutdown.
+  struct LocalQueue {
+    Mutex mutex;
+    TaskList tasks;
+    std::atomic<intptr_t> length = {0};
+    bool in_use = false;  // Guarded by [pool_monitor_].
+  };
+
   class Worker : public IntrusiveDListEntry<Worker> {
    public:
     explicit Worker(ThreadPool* pool);
@@ -87,6 +129,8 @@ class ThreadPool {
     ThreadJoinId join_id_;
     OSThread* os_thread_ = nullptr;
     bool is_blocked_ = false;
+    // Index of this worker's [LocalQueue], or -1 if all queues are taken.
+    intptr_t queue_index_ = -1;
 
     DISALLOW_COPY_AND_ASSIGN(Worker);
   };
@@ -102,38 +146,79 @@ class ThreadPool {
   bool ShuttingDownLocked() { return shutting_down_; }
 
   // Whether new tasks are ready to be run.
-  bool TasksWaitingToRunLocked() { return !tasks_.IsEmpty(); }
+  bool TasksWaitingToRunLocked() { return pending_tasks_ > 0; }
 
  private:
-  using TaskList = IntrusiveDList<Task>;
   using WorkerList = IntrusiveDList<Worker>;
 
+  // Upper bound on the number of per-worker queues. Workers started beyond
+  // this schedule and find their tasks through the injection stack only.
+  static constexpr intptr_t kMaxLocalQueues = 64;
+
   bool RunImpl(std::unique_ptr<Task> task);
+  void PostToExecutor(Task* task);
+  // Uncounts a task posted to the executor, waking up Shutdown if it was the
+  // last one.
+  void ExecutorTaskDone();
   void WorkerLoop(Worker* worker);
 
-  Worker* ScheduleTaskLocked(MonitorLocker* ml, std::unique_ptr<Task> task);
-
-  void IdleToRunningLocked(Worker* worker);
-  void RunningToIdleLocked(Worker* worker);
-  void IdleToDeadLocked(Worker* worker);
+  // Queues [task] on the current worker's local queue, or on the injection
+  // stack when called from outside the pool (or from a worker without one).
+  void EnqueueTask(Task* task);
+  // Finds the next task for [worker]: its own queue first, then the
+  // injection stack, then the other workers' queues.
+  Task* DequeueTask(Worker* worker);
+  Task* TakeInjectedTasks(Worker* worker);
+  Task* StealTask(Worker* worker);
+
+  // Makes sure a worker will pick up a newly enqueued task, waking an idle
+  // one or starting a new one as needed. [pending_tasks] is the count
+  // including that task.
+  void EnsureWorkerFor(intptr_t pending_tasks);
+  bool NeedsNewWorkerLocked(intptr_t pending_tasks);
+  Worker* AddWorkerLocked();
+  // Tries to retire an idle [worker], taking over previously retired workers
+  // to join. Fails if tasks came in concurrently.
+  bool TryIdleToDeadLocked(Worker* worker, WorkerList* dead_workers_to_join);
   void ObtainDeadWorkersLocked(WorkerList* dead_workers_to_join);
   void JoinDeadWorkersLocked(WorkerList* dead_workers_to_join);
 
+  // Guards worker startup/shutdown, idling and [shutting_down_]. Running and
+  // scheduling tasks only takes it to wake or start workers.
   Monitor pool_monitor_;
-  bool shutting_down_ = false;
-  uint64_t count_running_ = 0;
-  uint64_t count_idle_ = 0;
+  std::atomic<bool> shutting_down_ = {false};
+  // The counters are only modified with [pool_monitor_] held but are read
+  // without it on the scheduling fast path.
+  std::atomic<intptr_t> count_workers_ = {0};
+  std::atomic<intptr_t> count_idle_ = {0};
   uint64_t count_dead_ = 0;
-  WorkerList running_workers_;
-  WorkerList idle_workers_;
+  WorkerList workers_;
   WorkerList dead_workers_;
-  uint64_t pending_tasks_ = 0;
-  TaskList tasks_;
+
+  // Tasks that were scheduled but not yet taken by a worker.
+  std::atomic<intptr_t> pending_tasks_ = {0};
+  // Lock-free LIFO of tasks scheduled from outside the pool. Workers take
+  // the whole stack at once and move it, in FIFO order, to their own queue.
+  std::atomic<Task*> injected_tasks_ = {nullptr};
+  std::unique_ptr<LocalQueue[]> local_queues_;
+  intptr_t num_local_queues_ = 0;
 
   Monitor exit_monitor_;
   std::atomic<bool> all_workers_dead_;
 
-  uintptr_t max_pool_size_ = 0;
+  std::atomic<uintptr_t> max_pool_size_ = {0};
+
+  // The embedder's executor at the time the pool was created. With an
+  // executor there are no workers, and [pending_tasks_] counts the tasks
+  // posted but not yet finished.
+  const Dart_PostTaskCallback post_task_;
+  void* const executor_data_;
+  const Dart_TaskPriority default_priority_;
+
+  static Dart_PostTaskCallback global_post_task_;
+  static void* global_executor_data_;
+  // The pool whose posted task the current thread is running.
+  static inline thread_local ThreadPool* current_executor_pool_ = nullptr;
 
   DISALLOW_COPY_AND_ASSIGN(ThreadPool);
 };
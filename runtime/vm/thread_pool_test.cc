@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/thread_pool.h"
+#include "vm/growable_array.h"
 #include "vm/lockers.h"
 #include "vm/os.h"
 #include "vm/unit_test.h"
@@ -256,4 +257,123 @@ THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RecursiveSpawn) {
   EXPECT_EQ(kTotalTasks, done);
 }
 
+class WaitForChildTask : public ThreadPool::Task {
+ public:
+  WaitForChildTask(ThreadPool* pool, Monitor* sync, int* done)
+      : pool_(pool), sync_(sync), done_(done) {}
+
+  virtual void Run() {
+    // The child lands on this worker's own queue. Since we block until it
+    // has run, another worker has to steal it.
+    bool child_done = false;
+    pool_->Run<ChildTask>(sync_, &child_done);
+    {
+      MonitorLocker ml(sync_);
+      while (!child_done) {
+        ml.Wait();
+      }
+      (*done_)++;
+      ml.NotifyAll();
+    }
+  }
+
+ private:
+  class ChildTask : public ThreadPool::Task {
+   public:
+    ChildTask(Monitor* sync, bool* done) : sync_(sync), done_(done) {}
+
+    virtual void Run() {
+      MonitorLocker ml(sync_);
+      *done_ = true;
+      ml.NotifyAll();
+    }
+
+   private:
+    Monitor* sync_;
+    bool* done_;
+  };
+
+  ThreadPool* pool_;
+  Monitor* sync_;
+  int* done_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_StealFromBlockedWorker) {
+  const int kTaskCount = 4;
+  ThreadPool thread_pool(kTaskCount + 1);
+  Monitor sync;
+  int done = 0;
+  for (int i = 0; i < kTaskCount; i++) {
+    thread_pool.Run<WaitForChildTask>(&thread_pool, &sync, &done);
+  }
+  {
+    MonitorLocker ml(&sync);
+    while (done < kTaskCount) {
+      ml.Wait();
+    }
+  }
+  EXPECT_EQ(kTaskCount, done);
+}
+
+
+// Collects the posted tasks, to be run by the test.
+struct TestExecutor {
+  MallocGrowableArray<Dart_Task> tasks;
+  MallocGrowableArray<Dart_TaskPriority> priorities;
+};
+
+static void PostToTestExecutor(void* data,
+                               Dart_Task task,
+                               Dart_TaskPriority priority) {
+  auto executor = reinterpret_cast<TestExecutor*>(data);
+  executor->tasks.Add(task);
+  executor->priorities.Add(priority);
+}
+
+class ExecutorTestTask : public ThreadPool::Task {
+ public:
+  ExecutorTestTask(ThreadPool* pool, bool low_priority, int* ran_on_pool)
+      : pool_(pool), low_priority_(low_priority), ran_on_pool_(ran_on_pool) {}
+
+  virtual Dart_TaskPriority priority(Dart_TaskPriority pool_default) const {
+    return low_priority_ ? Dart_TaskPriority_Low : pool_default;
+  }
+
+  virtual void Run() {
+    if (pool_->CurrentThreadIsWorker()) {
+      (*ran_on_pool_)++;
+    }
+  }
+
+ private:
+  ThreadPool* pool_;
+  bool low_priority_;
+  int* ran_on_pool_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_Executor) {
+  TestExecutor executor;
+  ThreadPool::SetExecutor(PostToTestExecutor, &executor);
+  ThreadPool thread_pool(/*max_pool_size=*/0, Dart_TaskPriority_High);
+  ThreadPool::SetExecutor(nullptr, nullptr);
+
+  int ran_on_pool = 0;
+  EXPECT(thread_pool.Run<ExecutorTestTask>(&thread_pool, false, &ran_on_pool));
+  EXPECT(thread_pool.Run<ExecutorTestTask>(&thread_pool, true, &ran_on_pool));
+  EXPECT_EQ(2, executor.tasks.length());
+  EXPECT_EQ(Dart_TaskPriority_High, executor.priorities[0]);
+  EXPECT_EQ(Dart_TaskPriority_Low, executor.priorities[1]);
+  EXPECT_EQ(2, thread_pool.pending_tasks());
+  EXPECT(!thread_pool.CurrentThreadIsWorker());
+
+  for (intptr_t i = 0; i < executor.tasks.length(); i++) {
+    ThreadPool::RunExecutorTask(executor.tasks[i]);
+  }
+  EXPECT_EQ(2, ran_on_pool);
+  EXPECT_EQ(0, thread_pool.pending_tasks());
+  EXPECT(!thread_pool.CurrentThreadIsWorker());
+  // No worker threads were started.
+  EXPECT_EQ(0U, thread_pool.workers_started());
+}
+
 }  // namespace dart
@@ -5,6 +5,8 @@
 #include "platform/assert.h"
 #include "vm/heap/safepoint.h"
 #include "vm/isolate.h"
+#include "vm/json_stream.h"
+#include "vm/lock_contention.h"
 #include "vm/lockers.h"
 #include "vm/profiler.h"
 #include "vm/stack_frame.h"
@@ -1113,4 +1115,62 @@ ISOLATE_UNIT_TEST_CASE(SafepointMonitorUnlockScope) {
   }
 }
 
+#if !defined(PRODUCT)
+struct LockContentionTestParams {
+  Mutex* mutex;
+  Monitor* monitor;
+  ThreadJoinId join_id;
+};
+
+static void LockContentionTestMain(uword parameter) {
+  auto params = reinterpret_cast<LockContentionTestParams*>(parameter);
+  {
+    MonitorLocker ml(params->monitor);
+    params->join_id = OSThread::GetCurrentThreadJoinId(OSThread::Current());
+    ml.Notify();
+  }
+  // Blocks until the test thread releases the mutex.
+  MutexLocker locker(params->mutex);
+}
+
+TEST_CASE(LockContentionProfiler) {
+  const bool saved_flag = FLAG_profile_lock_contention;
+  FLAG_profile_lock_contention = true;
+  LockContentionProfiler::Reset();
+
+  Mutex mutex(NOT_IN_PRODUCT("LockContentionTest"));
+  Monitor monitor;
+  LockContentionTestParams params;
+  params.mutex = &mutex;
+  params.monitor = &monitor;
+  params.join_id = OSThread::kInvalidThreadJoinId;
+  {
+    MutexLocker locker(&mutex);
+    OSThread::Start("LockContentionTest", LockContentionTestMain,
+                    reinterpret_cast<uword>(&params));
+    {
+      MonitorLocker ml(&monitor);
+      while (params.join_id == OSThread::kInvalidThreadJoinId) {
+        ml.Wait();
+      }
+    }
+    // Give the helper time to block on the mutex.
+    OS::Sleep(100);
+  }
+  OSThread::Join(params.join_id);
+  FLAG_profile_lock_contention = saved_flag;
+
+  JSONStream js;
+  LockContentionProfiler::PrintJSON(&js);
+  const char* json = js.ToCString();
+  EXPECT_SUBSTRING("\"type\":\"_LockContentionProfile\"", json);
+  const char* lock = strstr(json, "\"name\":\"LockContentionTest\"");
+  EXPECT(lock != nullptr);
+  if (lock != nullptr) {
+    EXPECT_SUBSTRING("\"kind\":\"Mutex\"", lock);
+    EXPECT_SUBSTRING("\"acquisitions\":2,\"contentions\":1,", lock);
+  }
+}
+#endif  // !defined(PRODUCT)
+
 }  // namespace dart
@@ -20,6 +20,7 @@
 #include "vm/lockers.h"
 #include "vm/log.h"
 #include "vm/object.h"
+#include "vm/proto_writer.h"
 #include "vm/service.h"
 #include "vm/service_event.h"
 #include "vm/thread.h"
@@ -28,11 +29,11 @@ namespace dart {
 
 #if defined(PRODUCT)
 #define DEFAULT_TIMELINE_RECORDER "none"
-#define SUPPORTED_TIMELINE_RECORDERS "systrace, file, callback"
+#define SUPPORTED_TIMELINE_RECORDERS "systrace, file, perfettofile, callback"
 #else
 #define DEFAULT_TIMELINE_RECORDER "ring"
 #define SUPPORTED_TIMELINE_RECORDERS                                           \
-  "ring, endless, startup, systrace, file, callback"
+  "ring, endless, startup, systrace, file, perfettofile, callback"
 #endif
 
 DEFINE_FLAG(bool, complete_timeline, false, "Record the complete timeline");
@@ -106,8 +107,9 @@ DEFINE_FLAG(charp,
 std::atomic<RecorderSynchronizationLock::RecorderState>
     RecorderSynchronizationLock::recorder_state_ = {
         RecorderSynchronizationLock::kUnInitialized};
-std::atomic<intptr_t> RecorderSynchronizationLock::outstanding_event_writes_ = {
-    0};
+RecorderSynchronizationLock::Slot
+    RecorderSynchronizationLock::outstanding_event_writes_[kNumSlots] = {};
+std::atomic<intptr_t> RecorderSynchronizationLock::next_slot_index_ = {0};
 
 static TimelineEventRecorder* CreateDefaultTimelineRecorder() {
 #if defined(PRODUCT)
@@ -157,6 +159,14 @@ static TimelineEventRecorder* CreateTimelineRecorder() {
     return new TimelineEventFileRecorder(filename);
   }
 
+  if (Utils::StrStartsWith(flag, "perfettofile") &&
+      (flag[12] == '\0' || flag[12] == ':' || flag[12] == '=')) {
+    const char* filename =
+        flag[12] == '\0' ? "dart.perfetto-trace" : &flag[13];
+    FLAG_timeline_dir = nullptr;
+    return new TimelineEventPerfettoFileRecorder(filename);
+  }
+
   if (strcmp("callback", flag) == 0) {
     return new TimelineEventEmbedderCallbackRecorder();
   }
@@ -1241,6 +1251,17 @@ void TimelineEventRecorder::AddTrackMetadataBasedOnThread(
   }
 }
 
+char* TimelineEventRecorder::CopyTrackName(intptr_t trace_id) {
+  MutexLocker ml(&track_uuid_to_track_metadata_lock_);
+  SimpleHashMap::Entry* entry = track_uuid_to_track_metadata_.Lookup(
+      reinterpret_cast<void*>(trace_id), Utils::WordHash(trace_id), false);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  return Utils::StrDup(
+      static_cast<TimelineTrackMetadata*>(entry->value)->track_name());
+}
+
 TimelineEventFixedBufferRecorder::TimelineEventFixedBufferRecorder(
     intptr_t capacity)
     : memory_(nullptr),
@@ -1664,6 +1685,228 @@ void TimelineEventFileRecorder::DrainImpl(const TimelineEvent& event) {
   free(output);
 }
 
+// Field numbers and enum values of the Perfetto trace protos, see
+// https://perfetto.dev/docs/reference/trace-packet-proto.
+namespace perfetto {
+// Trace.
+static constexpr intptr_t kTracePacket = 1;
+// TracePacket.
+static constexpr intptr_t kTimestamp = 8;
+static constexpr intptr_t kTrustedPacketSequenceId = 10;
+static constexpr intptr_t kTrackEvent = 11;
+static constexpr intptr_t kSequenceFlags = 13;
+static constexpr intptr_t kTimestampClockId = 58;
+static constexpr intptr_t kTrackDescriptor = 60;
+// TracePacket.sequence_flags.
+static constexpr uint64_t kSeqIncrementalStateCleared = 1;
+// BuiltinClock.
+static constexpr uint64_t kClockMonotonic = 3;
+// TrackDescriptor.
+static constexpr intptr_t kTrackUuid = 1;
+static constexpr intptr_t kTrackName = 2;
+static constexpr intptr_t kTrackProcess = 3;
+static constexpr intptr_t kTrackThread = 4;
+static constexpr intptr_t kTrackParentUuid = 5;
+// ProcessDescriptor and ThreadDescriptor.
+static constexpr intptr_t kPid = 1;
+static constexpr intptr_t kTid = 2;
+static constexpr intptr_t kThreadName = 5;
+// TrackEvent.
+static constexpr intptr_t kDebugAnnotations = 4;
+static constexpr intptr_t kType = 9;
+static constexpr intptr_t kTrackEventTrackUuid = 11;
+static constexpr intptr_t kCategories = 22;
+static constexpr intptr_t kName = 23;
+static constexpr intptr_t kFlowIds = 47;
+// TrackEvent.Type.
+static constexpr uint64_t kSliceBegin = 1;
+static constexpr uint64_t kSliceEnd = 2;
+static constexpr uint64_t kInstant = 3;
+// DebugAnnotation.
+static constexpr intptr_t kStringValue = 6;
+static constexpr intptr_t kLegacyJsonValue = 9;
+static constexpr intptr_t kAnnotationName = 10;
+}  // namespace perfetto
+
+// Track uuids of the process and of async events are kept apart from the
+// thread ids used as uuids of thread tracks.
+static uint64_t PerfettoProcessTrackUuid() {
+  return (static_cast<uint64_t>(1) << 63) | OS::ProcessId();
+}
+
+static uint64_t PerfettoAsyncTrackUuid(int64_t async_id) {
+  return (static_cast<uint64_t>(1) << 62) ^ static_cast<uint64_t>(async_id);
+}
+
+static void WritePerfettoAnnotation(ProtoWriter* track_event,
+                                    const char* name,
+                                    intptr_t value_field,
+                                    const char* value) {
+  ProtoWriter annotation;
+  annotation.WriteString(perfetto::kAnnotationName, name);
+  annotation.WriteString(value_field, value);
+  track_event->WriteMessage(perfetto::kDebugAnnotations, annotation);
+}
+
+TimelineEventPerfettoFileRecorder::TimelineEventPerfettoFileRecorder(
+    const char* path)
+    : TimelineEventFileRecorderBase(path), thread_tracks_() {
+  ProtoWriter process;
+  process.WriteVarInt(perfetto::kPid, OS::ProcessId());
+  ProtoWriter track;
+  track.WriteVarInt(perfetto::kTrackUuid, PerfettoProcessTrackUuid());
+  track.WriteMessage(perfetto::kTrackProcess, process);
+  ProtoWriter packet;
+  packet.WriteVarInt(perfetto::kTrustedPacketSequenceId, 1);
+  packet.WriteVarInt(perfetto::kSequenceFlags,
+                     perfetto::kSeqIncrementalStateCleared);
+  packet.WriteMessage(perfetto::kTrackDescriptor, track);
+  WritePacket(packet);
+  OSThread::Start("TimelineEventPerfettoFileRecorder",
+                  TimelineEventFileRecorderBaseStart,
+                  reinterpret_cast<uword>(this));
+}
+
+TimelineEventPerfettoFileRecorder::~TimelineEventPerfettoFileRecorder() {
+  ShutDown();
+}
+
+void TimelineEventPerfettoFileRecorder::WritePacket(
+    const ProtoWriter& packet) const {
+  ProtoWriter trace;
+  trace.WriteMessage(perfetto::kTracePacket, packet);
+  Write(reinterpret_cast<const char*>(trace.data()), trace.length());
+}
+
+void TimelineEventPerfettoFileRecorder::WriteTrackDescriptor(
+    uint64_t uuid,
+    const char* name,
+    intptr_t tid) const {
+  ProtoWriter track;
+  track.WriteVarInt(perfetto::kTrackUuid, uuid);
+  track.WriteVarInt(perfetto::kTrackParentUuid, PerfettoProcessTrackUuid());
+  if (tid != 0) {
+    ProtoWriter thread;
+    thread.WriteVarInt(perfetto::kPid, OS::ProcessId());
+    thread.WriteVarInt(perfetto::kTid, tid);
+    if (name != nullptr) {
+      thread.WriteString(perfetto::kThreadName, name);
+    }
+    track.WriteMessage(perfetto::kTrackThread, thread);
+  } else if (name != nullptr) {
+    track.WriteString(perfetto::kTrackName, name);
+  }
+  ProtoWriter packet;
+  packet.WriteVarInt(perfetto::kTrustedPacketSequenceId, 1);
+  packet.WriteMessage(perfetto::kTrackDescriptor, track);
+  WritePacket(packet);
+}
+
+void TimelineEventPerfettoFileRecorder::WriteTrackEvent(
+    const TimelineEvent& event,
+    uint64_t track_uuid,
+    uint64_t type,
+    int64_t micros) const {
+  ProtoWriter track_event;
+  track_event.WriteVarInt(perfetto::kType, type);
+  track_event.WriteVarInt(perfetto::kTrackEventTrackUuid, track_uuid);
+  if (type != perfetto::kSliceEnd) {
+    track_event.WriteString(perfetto::kName, event.label());
+    if (event.stream() != nullptr) {
+      track_event.WriteString(perfetto::kCategories, event.stream()->name());
+    }
+  }
+  if (event.pre_serialized_args()) {
+    ASSERT(event.arguments_length() == 1);
+    WritePerfettoAnnotation(&track_event, "args", perfetto::kLegacyJsonValue,
+                            event.arguments()[0].value);
+  } else {
+    for (intptr_t i = 0; i < event.arguments_length(); i++) {
+      const TimelineEventArgument& arg = event.arguments()[i];
+      WritePerfettoAnnotation(&track_event, arg.name, perfetto::kStringValue,
+                              arg.value);
+    }
+  }
+  if (event.HasIsolateId()) {
+    const char* isolate_id = event.GetFormattedIsolateId();
+    WritePerfettoAnnotation(&track_event, "isolateId", perfetto::kStringValue,
+                            isolate_id);
+    free(const_cast<char*>(isolate_id));
+  }
+  if (event.HasIsolateGroupId()) {
+    const char* isolate_group_id = event.GetFormattedIsolateGroupId();
+    WritePerfettoAnnotation(&track_event, "isolateGroupId",
+                            perfetto::kStringValue, isolate_group_id);
+    free(const_cast<char*>(isolate_group_id));
+  }
+  switch (event.event_type()) {
+    case TimelineEvent::kFlowBegin:
+    case TimelineEvent::kFlowStep:
+    case TimelineEvent::kFlowEnd:
+      track_event.WriteFixed64(perfetto::kFlowIds, event.Id());
+      break;
+    default:
+      break;
+  }
+
+  ProtoWriter packet;
+  packet.WriteVarInt(perfetto::kTimestamp, micros * 1000);
+  packet.WriteVarInt(perfetto::kTimestampClockId, perfetto::kClockMonotonic);
+  packet.WriteVarInt(perfetto::kTrustedPacketSequenceId, 1);
+  packet.WriteMessage(perfetto::kTrackEvent, track_event);
+  WritePacket(packet);
+}
+
+void TimelineEventPerfettoFileRecorder::DrainImpl(const TimelineEvent& event) {
+  const intptr_t tid = OSThread::ThreadIdToIntPtr(event.thread());
+  if (!thread_tracks_.Contains(tid)) {
+    thread_tracks_.Add(tid);
+    char* name = CopyTrackName(tid);
+    WriteTrackDescriptor(tid, name, tid);
+    free(name);
+  }
+
+  switch (event.event_type()) {
+    case TimelineEvent::kBegin:
+      WriteTrackEvent(event, tid, perfetto::kSliceBegin, event.TimeOrigin());
+      break;
+    case TimelineEvent::kEnd:
+      WriteTrackEvent(event, tid, perfetto::kSliceEnd, event.TimeOrigin());
+      break;
+    case TimelineEvent::kDuration:
+      WriteTrackEvent(event, tid, perfetto::kSliceBegin, event.TimeOrigin());
+      WriteTrackEvent(event, tid, perfetto::kSliceEnd, event.timestamp1());
+      break;
+    case TimelineEvent::kAsyncBegin: {
+      const uint64_t uuid = PerfettoAsyncTrackUuid(event.Id());
+      WriteTrackDescriptor(uuid, event.label(), 0);
+      WriteTrackEvent(event, uuid, perfetto::kSliceBegin, event.TimeOrigin());
+      break;
+    }
+    case TimelineEvent::kAsyncInstant:
+      WriteTrackEvent(event, PerfettoAsyncTrackUuid(event.Id()),
+                      perfetto::kInstant, event.TimeOrigin());
+      break;
+    case TimelineEvent::kAsyncEnd:
+      WriteTrackEvent(event, PerfettoAsyncTrackUuid(event.Id()),
+                      perfetto::kSliceEnd, event.TimeOrigin());
+      break;
+    case TimelineEvent::kInstant:
+    case TimelineEvent::kCounter:
+    case TimelineEvent::kFlowBegin:
+    case TimelineEvent::kFlowStep:
+    case TimelineEvent::kFlowEnd:
+      // Counter values and flow ids are attached to instants.
+      WriteTrackEvent(event, tid, perfetto::kInstant, event.TimeOrigin());
+      break;
+    case TimelineEvent::kMetadata:
+      // Thread names are part of the track descriptors.
+      break;
+    default:
+      UNIMPLEMENTED();
+  }
+}
+
 TimelineEventEndlessRecorder::TimelineEventEndlessRecorder()
     : head_(nullptr), tail_(nullptr), block_index_(0) {}
 
@@ -48,6 +48,19 @@ class VirtualMemory {
 
   static void DontNeed(void* address, intptr_t size);
 
+  // Returns the number of bytes of heap memory currently backed by huge pages,
+  // or 0 if the platform does not report it.
+  static intptr_t HugePageBackedBytes();
+
+  // Returns the NUMA node of the CPU the current thread is running on, or -1
+  // if the platform does not report it.
+  static intptr_t CurrentNumaNode();
+
+  // Asks the OS to back pages of the range that are not yet populated with
+  // memory from |node|. This is advisory and silently ignored where NUMA
+  // placement is unsupported.
+  static void PreferNumaNode(void* address, intptr_t size, intptr_t node);
+
   // Reserves and commits a virtual memory segment with size. If a segment of
   // the requested size cannot be allocated, nullptr is returned.
   static VirtualMemory* Allocate(intptr_t size,
@@ -12,7 +12,16 @@
 namespace dart {
 
 #if defined(DART_COMPRESSED_POINTERS)
+// A compressed pointer is the low 32 bits of a tagged address and is
+// decompressed by adding the upper bits of the heap base, so all isolate
+// groups share a single 4GB region. The same 32-bit slots also hold Smis,
+// which are only sign-extended, and the heap object tag lives in bit 0 of the
+// address, so scaling compressed values by the object alignment to reach a
+// larger heap would need a different tagging scheme, not just a different
+// reservation here.
 static constexpr intptr_t kCompressedHeapSize = 4 * GB;
+static_assert(kCompressedHeapSize == (static_cast<intptr_t>(1) << 32),
+              "compressed pointers are 32-bit offsets into the heap");
 static constexpr intptr_t kCompressedHeapAlignment = 4 * GB;
 static constexpr intptr_t kCompressedPageSize = kPageSize;
 static constexpr intptr_t kCompressedHeapNumPages =
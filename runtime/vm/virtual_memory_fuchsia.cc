@@ -299,6 +299,18 @@ void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
   }
 }
 
+intptr_t VirtualMemory::HugePageBackedBytes() {
+  return 0;
+}
+
+intptr_t VirtualMemory::CurrentNumaNode() {
+  return -1;
+}
+
+void VirtualMemory::PreferNumaNode(void* address,
+                                   intptr_t size,
+                                   intptr_t node) {}
+
 void VirtualMemory::DontNeed(void* address, intptr_t size) {
   uword start_address = reinterpret_cast<uword>(address);
   uword end_address = start_address + size;
@@ -51,6 +51,16 @@ DECLARE_FLAG(bool, generate_perf_events_symbols);
 DECLARE_FLAG(bool, generate_perf_jitdump);
 #endif
 
+#if defined(DART_HOST_OS_LINUX)
+DEFINE_FLAG(bool,
+            use_transparent_huge_pages,
+            false,
+            "Align large heap and code reservations to 2MB and ask the kernel "
+            "to back heap memory with transparent huge pages.");
+
+static constexpr intptr_t kHugePageSize = 2 * MB;
+#endif
+
 uword VirtualMemory::page_size_ = 0;
 VirtualMemory* VirtualMemory::compressed_heap_ = nullptr;
 
@@ -107,6 +117,19 @@ static void* GenericMapAligned(void* hint,
   return reinterpret_cast<void*>(aligned_base);
 }
 
+// Best effort: the kernel may have THP disabled or only enabled for madvised
+// regions, and an earlier kernel may not know MADV_HUGEPAGE at all.
+static void AdviseHugePages(void* address, intptr_t size) {
+#if defined(DART_HOST_OS_LINUX) && defined(MADV_HUGEPAGE)
+  if (FLAG_use_transparent_huge_pages) {
+    if (madvise(address, size, MADV_HUGEPAGE) != 0) {
+      LOG_INFO("madvise(%p, 0x%" Px ", MADV_HUGEPAGE) failed\n", address,
+               size);
+    }
+  }
+#endif
+}
+
 intptr_t VirtualMemory::CalculatePageSize() {
   const intptr_t page_size = getpagesize();
   ASSERT(page_size != 0);
@@ -353,10 +376,22 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
       return nullptr;
     }
     Commit(region.pointer(), region.size());
+    // Committing replaces the mapping, so the advice has to be repeated. The
+    // kernel merges neighboring commits, letting consecutive pages of the
+    // compressed heap share huge pages.
+    AdviseHugePages(region.pointer(), region.size());
     return new VirtualMemory(region, region);
   }
 #endif  // defined(DART_COMPRESSED_POINTERS)
 
+#if defined(DART_HOST_OS_LINUX)
+  // Only reservations that can contain a whole huge page benefit from the
+  // stronger alignment; smaller ones would just fragment the address space.
+  if (FLAG_use_transparent_huge_pages && (size >= kHugePageSize)) {
+    alignment = Utils::Maximum(alignment, kHugePageSize);
+  }
+#endif
+
   const intptr_t allocated_size = size + alignment - PageSize();
 #if defined(DUAL_MAPPING_SUPPORTED)
   const bool dual_mapping =
@@ -421,6 +456,7 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
     if (region_ptr == nullptr) {
       return nullptr;
     }
+    AdviseHugePages(region_ptr, size);
     MemoryRegion region(region_ptr, size);
     return new VirtualMemory(region, region);
   }
@@ -451,6 +487,7 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
 #if defined(DART_HOST_OS_ANDROID)
   prctl(PR_SET_VMA, PR_SET_VMA_ANON_NAME, address, size, name);
 #endif
+  AdviseHugePages(address, size);
 
   MemoryRegion region(reinterpret_cast<void*>(address), size);
   return new VirtualMemory(region, region);
@@ -571,6 +608,74 @@ void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
            end_address - page_address, prot);
 }
 
+intptr_t VirtualMemory::HugePageBackedBytes() {
+#if defined(DART_HOST_OS_LINUX)
+  FILE* fp = fopen("/proc/self/smaps", "r");
+  if (fp == nullptr) {
+    return 0;
+  }
+  // Without compressed pointers heap pages are spread over the whole address
+  // space and every mapping counts.
+  uword heap_start = 0;
+  uword heap_end = kUwordMax;
+#if defined(DART_COMPRESSED_POINTERS)
+  if (compressed_heap_ != nullptr) {
+    heap_start = compressed_heap_->start();
+    heap_end = compressed_heap_->end();
+  }
+#endif  // defined(DART_COMPRESSED_POINTERS)
+  intptr_t total_kb = 0;
+  bool in_heap = false;
+  char line[1024];
+  while (fgets(line, sizeof(line), fp) != nullptr) {
+    unsigned long start = 0;  // NOLINT
+    unsigned long end = 0;    // NOLINT
+    long kb = 0;              // NOLINT
+    if (sscanf(line, "%lx-%lx ", &start, &end) == 2) {
+      in_heap = (start >= heap_start) && (end <= heap_end);
+    } else if (in_heap) {
+      if ((sscanf(line, "AnonHugePages: %ld kB", &kb) == 1) ||
+          (sscanf(line, "ShmemPmdMapped: %ld kB", &kb) == 1)) {
+        total_kb += kb;
+      }
+    }
+  }
+  fclose(fp);
+  return total_kb * KB;
+#else
+  return 0;
+#endif
+}
+
+intptr_t VirtualMemory::CurrentNumaNode() {
+#if defined(DART_HOST_OS_LINUX) && defined(SYS_getcpu)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return -1;
+}
+
+void VirtualMemory::PreferNumaNode(void* address,
+                                   intptr_t size,
+                                   intptr_t node) {
+#if defined(DART_HOST_OS_LINUX) && defined(SYS_mbind)
+  // The kernel ignores the last bit of the mask.
+  if ((node < 0) || (node >= kBitsPerWord - 1)) {
+    return;
+  }
+  const int kMpolPreferred = 1;  // From <numaif.h>, which may be absent.
+  uword nodemask = static_cast<uword>(1) << node;
+  if (syscall(SYS_mbind, address, size, kMpolPreferred, &nodemask,
+              kBitsPerWord, 0) != 0) {
+    LOG_INFO("mbind(0x%" Px ", 0x%" Px ", %" Pd ") failed\n",
+             reinterpret_cast<uword>(address), size, node);
+  }
+#endif
+}
+
 void VirtualMemory::DontNeed(void* address, intptr_t size) {
   uword start_address = reinterpret_cast<uword>(address);
   uword end_address = start_address + size;
@@ -89,4 +89,22 @@ VM_UNIT_TEST_CASE(FreeVirtualMemory) {
   }
 }
 
+VM_UNIT_TEST_CASE(PreferNumaNodeVirtualMemory) {
+  const intptr_t node = VirtualMemory::CurrentNumaNode();
+  EXPECT(node >= -1);
+  const intptr_t kVirtualMemoryBlockSize = 1 * MB;
+  VirtualMemory* vm =
+      VirtualMemory::Allocate(kVirtualMemoryBlockSize, false, false, "test");
+  EXPECT(vm != nullptr);
+  // Placement is advisory; the memory must stay usable either way.
+  VirtualMemory::PreferNumaNode(vm->address(), vm->size(),
+                                node >= 0 ? node : 0);
+  char* buf = reinterpret_cast<char*>(vm->address());
+  buf[0] = 'a';
+  buf[kVirtualMemoryBlockSize - 1] = 'z';
+  EXPECT_EQ('a', buf[0]);
+  EXPECT_EQ('z', buf[kVirtualMemoryBlockSize - 1]);
+  delete vm;
+}
+
 }  // namespace dart
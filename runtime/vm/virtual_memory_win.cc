@@ -243,6 +243,18 @@ void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 
 void VirtualMemory::DontNeed(void* address, intptr_t size) {}
 
+intptr_t VirtualMemory::HugePageBackedBytes() {
+  return 0;
+}
+
+intptr_t VirtualMemory::CurrentNumaNode() {
+  return -1;
+}
+
+void VirtualMemory::PreferNumaNode(void* address,
+                                   intptr_t size,
+                                   intptr_t node) {}
+
 }  // namespace dart
 
 #endif  // defined(DART_HOST_OS_WINDOWS)
@@ -55,6 +55,52 @@ static Mutex* segment_cache_mutex = nullptr;
 static VirtualMemory* segment_cache[kSegmentCacheCapacity] = {nullptr};
 static intptr_t segment_cache_size = 0;
 
+// Large segments come in all sizes, so a cached one is reused for any request
+// it can hold without wasting more than half of it. Only segments up to
+// kLargeSegmentCacheMaxSize are kept, and at most kLargeSegmentCacheMaxBytes
+// in total.
+static constexpr intptr_t kLargeSegmentCacheCapacity = 8;
+static constexpr intptr_t kLargeSegmentCacheMaxSize = 1 * MB;
+static constexpr intptr_t kLargeSegmentCacheMaxBytes = 4 * MB;
+static VirtualMemory* large_segment_cache[kLargeSegmentCacheCapacity] = {
+    nullptr};
+static intptr_t large_segment_cache_size = 0;
+static intptr_t large_segment_cache_bytes = 0;
+
+static VirtualMemory* TakeCachedLargeSegment(intptr_t size) {
+  ASSERT(segment_cache_mutex->IsOwnedByCurrentThread());
+  intptr_t best = -1;
+  for (intptr_t i = 0; i < large_segment_cache_size; i++) {
+    const intptr_t cached_size = large_segment_cache[i]->size();
+    if ((cached_size >= size) && (cached_size / 2 <= size) &&
+        ((best == -1) ||
+         (cached_size < large_segment_cache[best]->size()))) {
+      best = i;
+    }
+  }
+  if (best == -1) {
+    return nullptr;
+  }
+  VirtualMemory* memory = large_segment_cache[best];
+  large_segment_cache[best] =
+      large_segment_cache[--large_segment_cache_size];
+  large_segment_cache_bytes -= memory->size();
+  return memory;
+}
+
+static bool CacheLargeSegment(VirtualMemory* memory) {
+  ASSERT(segment_cache_mutex->IsOwnedByCurrentThread());
+  const intptr_t size = memory->size();
+  if ((size > kLargeSegmentCacheMaxSize) ||
+      (large_segment_cache_size == kLargeSegmentCacheCapacity) ||
+      (large_segment_cache_bytes + size > kLargeSegmentCacheMaxBytes)) {
+    return false;
+  }
+  large_segment_cache[large_segment_cache_size++] = memory;
+  large_segment_cache_bytes += size;
+  return true;
+}
+
 void Zone::Init() {
   ASSERT(segment_cache_mutex == nullptr);
   segment_cache_mutex = new Mutex(NOT_IN_PRODUCT("segment_cache_mutex"));
@@ -71,8 +117,16 @@ void Zone::ClearCache() {
   ASSERT(segment_cache_size >= 0);
   ASSERT(segment_cache_size <= kSegmentCacheCapacity);
   while (segment_cache_size > 0) {
-    delete segment_cache[--segment_cache_size];
+    VirtualMemory* memory = segment_cache[--segment_cache_size];
+    total_size_.fetch_sub(memory->size());
+    delete memory;
   }
+  while (large_segment_cache_size > 0) {
+    VirtualMemory* memory = large_segment_cache[--large_segment_cache_size];
+    total_size_.fetch_sub(memory->size());
+    delete memory;
+  }
+  large_segment_cache_bytes = 0;
 }
 
 Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
@@ -85,6 +139,12 @@ Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
     if (segment_cache_size > 0) {
       memory = segment_cache[--segment_cache_size];
     }
+  } else if (size <= kLargeSegmentCacheMaxSize) {
+    MutexLocker ml(segment_cache_mutex);
+    memory = TakeCachedLargeSegment(size);
+    if (memory != nullptr) {
+      size = memory->size();
+    }
   }
   if (memory == nullptr) {
     bool executable = false;
@@ -130,6 +190,11 @@ void Zone::Segment::DeleteSegmentList(Segment* head) {
         segment_cache[segment_cache_size++] = memory;
         memory = nullptr;
       }
+    } else if (size <= kLargeSegmentCacheMaxSize) {
+      MutexLocker ml(segment_cache_mutex);
+      if (CacheLargeSegment(memory)) {
+        memory = nullptr;
+      }
     }
     if (memory != nullptr) {
       total_size_.fetch_sub(size);
@@ -249,6 +249,23 @@ ISOLATE_UNIT_TEST_CASE(StressMallocThroughZones) {
 #endif  // !defined(PRODUCT)
 }
 
+ISOLATE_UNIT_TEST_CASE(ZoneReusesLargeSegments) {
+  Zone::ClearCache();
+  {
+    StackZone stack_zone(thread);
+    stack_zone.GetZone()->Alloc<uint8_t>(200 * KB);
+  }
+  // The large segment is cached instead of unmapped, and a smaller request
+  // reuses it.
+  const intptr_t size_with_cached_segment = Zone::Size();
+  {
+    StackZone stack_zone(thread);
+    stack_zone.GetZone()->Alloc<uint8_t>(150 * KB);
+    EXPECT_EQ(size_with_cached_segment, Zone::Size());
+  }
+  Zone::ClearCache();
+}
+
 #if defined(DART_COMPRESSED_POINTERS)
 ISOLATE_UNIT_TEST_CASE(ZonesNotLimitedByCompressedHeap) {
   StackZone stack_zone(Thread::Current());
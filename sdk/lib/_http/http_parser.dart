@@ -543,7 +543,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
             if (byte == _CharCode.CR || byte == _CharCode.LF) {
               throw HttpException("Invalid request, unexpected $byte in URI");
             }
-            _addWithValidation(_uriOrReasonPhrase, byte);
+            _addRunWithValidation(_uriOrReasonPhrase, byte, true);
           }
           break;
 
@@ -612,7 +612,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
             _state = _State.RESPONSE_LINE_ENDING;
             _index = _index - 1; // Make the new state see the LF again.
           } else {
-            _addWithValidation(_uriOrReasonPhrase, byte);
+            _addRunWithValidation(_uriOrReasonPhrase, byte, false);
           }
           break;
 
@@ -658,8 +658,8 @@ class _HttpParser extends Stream<_HttpIncoming> {
             _state = _State.HEADER_VALUE_FOLD_OR_END;
           } else if (byte != _CharCode.SP && byte != _CharCode.HT) {
             // Start of new header value.
-            _addWithValidation(_headerValue, byte);
             _state = _State.HEADER_VALUE;
+            _addRunWithValidation(_headerValue, byte, false);
           }
           break;
 
@@ -669,7 +669,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
           } else if (byte == _CharCode.LF) {
             _state = _State.HEADER_VALUE_FOLD_OR_END;
           } else {
-            _addWithValidation(_headerValue, byte);
+            _addRunWithValidation(_headerValue, byte, false);
           }
           break;
 
@@ -1065,6 +1065,34 @@ class _HttpParser extends Stream<_HttpIncoming> {
     }
   }
 
+  // Adds [byte] and the bytes following it in the buffer to [list], up to
+  // the next CR or LF, or SP if [stopAtSpace], and consumes them. Header
+  // values and URIs are mostly long runs of such bytes, which this adds
+  // without going through the state machine for every byte.
+  void _addRunWithValidation(List<int> list, int byte, bool stopAtSpace) {
+    final buffer = _buffer!;
+    final start = _index;
+    int end = start;
+    while (end < buffer.length) {
+      final next = buffer[end];
+      if (next == _CharCode.CR ||
+          next == _CharCode.LF ||
+          (stopAtSpace && next == _CharCode.SP)) {
+        break;
+      }
+      end++;
+    }
+    _headersReceivedSize += end - start + 1;
+    if (_headersReceivedSize >= _headerTotalSizeLimit) {
+      _reportSizeLimitError();
+    }
+    list.add(byte);
+    for (int i = start; i < end; i++) {
+      list.add(buffer[i]);
+    }
+    _index = end;
+  }
+
   void _reportSizeLimitError() {
     String method = "";
     switch (_state) {
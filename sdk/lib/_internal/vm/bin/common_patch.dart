@@ -27,6 +27,8 @@ import "dart:convert" show Encoding, utf8;
 
 import "dart:developer" show registerExtension;
 
+import "dart:ffi" show FfiNative, Handle, Int64, IntPtr, Pointer, Void;
+
 import "dart:isolate" show RawReceivePort, ReceivePort, SendPort;
 
 import "dart:math" show min;
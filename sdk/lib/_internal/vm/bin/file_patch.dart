@@ -85,8 +85,9 @@ base class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   external void _setPointer(int pointer);
   @pragma("vm:external-name", "File_GetPointer")
   external int getPointer();
-  @pragma("vm:external-name", "File_GetFD")
-  external int get fd;
+  int get fd => _getFD();
+  @FfiNative<IntPtr Function(Pointer<Void>)>("File_GetFD", isLeaf: true)
+  external int _getFD();
   @pragma("vm:external-name", "File_Close")
   external int close();
   @pragma("vm:external-name", "File_ReadByte")
@@ -99,18 +100,20 @@ base class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   external writeByte(int value);
   @pragma("vm:external-name", "File_WriteFrom")
   external writeFrom(List<int> buffer, int start, int? end);
-  @pragma("vm:external-name", "File_Position")
-  external position();
-  @pragma("vm:external-name", "File_SetPosition")
-  external setPosition(int position);
+  @FfiNative<Handle Function(Pointer<Void>)>("File_Position")
+  external Object position();
+  @FfiNative<Handle Function(Pointer<Void>, Int64)>("File_SetPosition")
+  external Object setPosition(int position);
   @pragma("vm:external-name", "File_Truncate")
   external truncate(int length);
-  @pragma("vm:external-name", "File_Length")
-  external length();
+  @FfiNative<Handle Function(Pointer<Void>)>("File_Length")
+  external Object length();
   @pragma("vm:external-name", "File_Flush")
   external flush();
   @pragma("vm:external-name", "File_Lock")
   external lock(int lock, int start, int end);
+  @pragma("vm:external-name", "File_Map")
+  external map(int start, int length, bool sequential);
 }
 
 class _WatcherPath {
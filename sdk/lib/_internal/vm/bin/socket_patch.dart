@@ -1088,7 +1088,9 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
         // If count is null, read as many bytes as possible.
         // Loop here to ensure bytes that arrived while this read was
         // issued are also read.
-        BytesBuilder builder = BytesBuilder();
+        // The lists returned by [nativeRead] are not used elsewhere, so the
+        // builder doesn't need to copy them. A single list is returned as is.
+        BytesBuilder builder = BytesBuilder(copy: false);
         do {
           assert(available > 0);
           list = nativeRead(available);
@@ -1101,7 +1103,7 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
         if (builder.isEmpty) {
           list = null;
         } else {
-          list = builder.toBytes();
+          list = builder.takeBytes();
         }
       }
       if (!const bool.fromEnvironment("dart.vm.product")) {
@@ -1202,6 +1204,10 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
       // know if we'll receive an event. It's better to just retry.
       if (result >= 0 && result < bytes) {
         writeAvailable = false;
+        if (!const bool.fromEnvironment("dart.vm.product")) {
+          _SocketProfile.collectStatistic(
+              nativeGetSocketId(), _SocketProfileType.blockedWrite);
+        }
       }
       // Negate the result, as stated above.
       if (result < 0) result = -result;
@@ -1679,7 +1685,7 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
 
   @pragma("vm:external-name", "Socket_SetSocketId")
   external void nativeSetSocketId(int id, int typeFlags);
-  @pragma("vm:external-name", "Socket_Available")
+  @FfiNative<IntPtr Function(Pointer<Void>)>("Socket_Available", isLeaf: true)
   external int nativeAvailable();
   @pragma("vm:external-name", "Socket_AvailableDatagram")
   external bool nativeAvailableDatagram();
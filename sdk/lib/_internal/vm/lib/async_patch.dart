@@ -224,6 +224,10 @@ class _SuspendState {
   void _awaitCompletedFuture(_Future future) {
     assert(future._isComplete);
     final zone = Zone._current;
+    if (identical(zone, _rootZone) && identical(future._zone, _rootZone)) {
+      _awaitCompletedFutureInRootZone(future);
+      return;
+    }
     if (future._hasError) {
       @pragma("vm:invisible")
       void run() {
@@ -253,10 +257,45 @@ class _SuspendState {
     }
   }
 
+  // Awaiting in the root zone is the common case. The continuation can then be
+  // queued and run directly, without going through the zone to schedule the
+  // microtask and to run the callback in it.
+  @pragma("vm:invisible")
+  void _awaitCompletedFutureInRootZone(_Future future) {
+    if (future._hasError) {
+      @pragma("vm:invisible")
+      void run() {
+        final AsyncError asyncError =
+            unsafeCast<AsyncError>(future._resultOrListeners);
+        unsafeCast<dynamic Function(Object, StackTrace)>(_errorCallback)(
+            asyncError.error, asyncError.stackTrace);
+      }
+
+      _scheduleAsyncCallback(run);
+    } else {
+      @pragma("vm:invisible")
+      void run() {
+        unsafeCast<dynamic Function(dynamic)>(_thenCallback)(
+            future._resultOrListeners);
+      }
+
+      _scheduleAsyncCallback(run);
+    }
+  }
+
   @pragma("vm:invisible")
   @pragma("vm:prefer-inline")
   void _awaitNotFuture(Object? object) {
     final zone = Zone._current;
+    if (identical(zone, _rootZone)) {
+      @pragma("vm:invisible")
+      void run() {
+        unsafeCast<dynamic Function(dynamic)>(_thenCallback)(object);
+      }
+
+      _scheduleAsyncCallback(run);
+      return;
+    }
     @pragma("vm:invisible")
     void run() {
       zone.runUnary(
@@ -153,6 +153,182 @@ external dynamic _nativeCallbackFunction<NS extends Function>(
 external Pointer<NS> _pointerFromFunction<NS extends NativeFunction>(
     dynamic function);
 
+@patch
+R withPinnedTypedData<R>(
+    TypedData data, R Function(Pointer<Uint8> bytes) action) {
+  final address = _pinTypedData(data);
+  try {
+    return action(Pointer<Uint8>.fromAddress(address));
+  } finally {
+    _unpinTypedData(data, address);
+  }
+}
+
+@pragma("vm:external-name", "Ffi_pinTypedData")
+external int _pinTypedData(TypedData data);
+
+@pragma("vm:external-name", "Ffi_unpinTypedData")
+external void _unpinTypedData(TypedData data, int address);
+
+@patch
+@pragma("vm:external-name", "Ffi_callNativeBatch")
+external void callNativeBatch<T extends Function>(
+    Pointer<NativeFunction<T>> function,
+    Pointer<IntPtr> arguments,
+    Pointer<IntPtr> results,
+    int count);
+
+@patch
+abstract final class NativeCallbackListener<T extends Function> {
+  @patch
+  factory NativeCallbackListener(Function callback) =>
+      _NativeCallbackListener<T>(callback);
+}
+
+// Native calls are queued by the runtime, which sends a message to [_port]
+// when the queue becomes non-empty. The handler then delivers all queued
+// calls, so a burst of calls costs a single message.
+final class _NativeCallbackListener<T extends Function>
+    implements NativeCallbackListener<T> {
+  final Function _callback;
+  final RawReceivePort _port;
+  int? _slot;
+
+  _NativeCallbackListener(this._callback)
+      : _port = RawReceivePort(null, 'NativeCallbackListener') {
+    try {
+      _slot = _createCallbackListener<T>(_port.sendPort.nativePort);
+    } catch (_) {
+      _port.close();
+      rethrow;
+    }
+    _port.handler = (_) => _deliver();
+  }
+
+  Pointer<NativeFunction<T>> get nativeFunction {
+    final slot = _slot;
+    if (slot == null) {
+      throw StateError('NativeCallbackListener is closed.');
+    }
+    return _callbackListenerFunction(slot).cast<NativeFunction<T>>();
+  }
+
+  void _deliver() {
+    final slot = _slot;
+    if (slot == null) return;
+    for (final arguments in _drainCallbackListener(slot)) {
+      Function.apply(_callback, arguments);
+      // The callback may have closed the listener.
+      if (_slot == null) return;
+    }
+  }
+
+  void close() {
+    final slot = _slot;
+    if (slot == null) return;
+    _slot = null;
+    _port.close();
+    _closeCallbackListener(slot);
+  }
+}
+
+@pragma("vm:external-name", "Ffi_createCallbackListener")
+external int _createCallbackListener<T extends Function>(int port);
+
+@pragma("vm:external-name", "Ffi_callbackListenerFunction")
+external Pointer<Void> _callbackListenerFunction(int slot);
+
+@pragma("vm:external-name", "Ffi_drainCallbackListener")
+external List<Object?> _drainCallbackListener(int slot);
+
+@pragma("vm:external-name", "Ffi_closeCallbackListener")
+external void _closeCallbackListener(int slot);
+
+@patch
+abstract final class IsolateGroupCallback<T extends Function> {
+  @patch
+  factory IsolateGroupCallback(Function callback) =>
+      _IsolateGroupCallback<T>(callback);
+}
+
+final class _IsolateGroupCallback<T extends Function>
+    implements IsolateGroupCallback<T> {
+  int? _slot;
+
+  _IsolateGroupCallback(Function callback)
+      : _slot = _createIsolateGroupCallback<T>(callback);
+
+  Pointer<NativeFunction<T>> get nativeFunction {
+    final slot = _slot;
+    if (slot == null) {
+      throw StateError('IsolateGroupCallback is closed.');
+    }
+    return _isolateGroupCallbackFunction(slot).cast<NativeFunction<T>>();
+  }
+
+  void close() {
+    final slot = _slot;
+    if (slot == null) return;
+    _slot = null;
+    _closeIsolateGroupCallback(slot);
+  }
+}
+
+@pragma("vm:external-name", "Ffi_createIsolateGroupCallback")
+external int _createIsolateGroupCallback<T extends Function>(
+    Function callback);
+
+@pragma("vm:external-name", "Ffi_isolateGroupCallbackFunction")
+external Pointer<Void> _isolateGroupCallbackFunction(int slot);
+
+@pragma("vm:external-name", "Ffi_closeIsolateGroupCallback")
+external void _closeIsolateGroupCallback(int slot);
+
+@patch
+abstract final class NativeArena implements Allocator {
+  @patch
+  factory NativeArena() => _NativeArena();
+}
+
+// The arena itself lives in native memory and is deleted by a finalizer
+// attached to this object. Holding it in a [Pointer] keeps this object from
+// being sent to other isolates.
+final class _NativeArena implements NativeArena {
+  late final Pointer<Void> _arena = _createNativeArena(this);
+
+  static const int _maxAlignment = 16;
+
+  Pointer<T> allocate<T extends NativeType>(int byteCount, {int? alignment}) {
+    if (alignment != null && alignment > _maxAlignment) {
+      throw ArgumentError.value(
+          alignment, 'alignment', 'Must be at most $_maxAlignment');
+    }
+    return _nativeArenaAllocate(this, _arena, byteCount).cast<T>();
+  }
+
+  void free(Pointer pointer) {
+    _nativeArenaFree(this, _arena, pointer);
+  }
+
+  void releaseAll() {
+    _nativeArenaReleaseAll(this, _arena);
+  }
+}
+
+@pragma("vm:external-name", "Ffi_createNativeArena")
+external Pointer<Void> _createNativeArena(Object owner);
+
+@pragma("vm:external-name", "Ffi_nativeArenaAllocate")
+external Pointer<Void> _nativeArenaAllocate(
+    Object owner, Pointer<Void> arena, int byteCount);
+
+@pragma("vm:external-name", "Ffi_nativeArenaFree")
+external void _nativeArenaFree(
+    Object owner, Pointer<Void> arena, Pointer pointer);
+
+@pragma("vm:external-name", "Ffi_nativeArenaReleaseAll")
+external void _nativeArenaReleaseAll(Object owner, Pointer<Void> arena);
+
 @patch
 @pragma("vm:entry-point")
 final class Pointer<T extends NativeType> {
@@ -259,6 +259,15 @@ class _GrowableList<T> extends ListBase<T> {
   @pragma("vm:external-name", "GrowableList_setData")
   external void _setData(_List array);
 
+  // Grows the backing array to [capacity] without moving it, if it was the
+  // last object allocated. Returns false if the backing array is unchanged.
+  @pragma("vm:external-name", "GrowableList_tryGrowDataInPlace")
+  external bool _tryGrowDataInPlace(int capacity);
+
+  // Shrinks the backing array to [capacity] without moving it.
+  @pragma("vm:external-name", "GrowableList_truncateData")
+  external void _truncateData(int capacity);
+
   @pragma("vm:recognized", "graph-intrinsic")
   @pragma("vm:external-name", "GrowableList_getIndexed")
   external T operator [](int index);
@@ -372,7 +381,14 @@ class _GrowableList<T> extends ListBase<T> {
   // Grow from 0 to 3, and then double + 1.
   int _nextCapacity(int old_capacity) => (old_capacity * 2) | 3;
 
+  // Smaller backing arrays are cheaper to copy than to try growing in place.
+  static const int _minCapacityToGrowInPlace = 64;
+
   void _grow(int new_capacity) {
+    if (_capacity >= _minCapacityToGrowInPlace &&
+        _tryGrowDataInPlace(_adjustedCapacity(new_capacity))) {
+      return;
+    }
     var newData = _allocateData(new_capacity);
     // This is a workaround for dartbug.com/30090: array-bound-check
     // generalization causes excessive deoptimizations because it
@@ -397,6 +413,19 @@ class _GrowableList<T> extends ListBase<T> {
   }
 
   void _shrink(int new_capacity, int new_length) {
+    if (new_capacity > 0) {
+      // Cut the backing array short instead of copying the remaining
+      // elements. Only the slot rounding the capacity up can still hold an
+      // element past the new length.
+      final capacity = _adjustedCapacity(new_capacity);
+      if (capacity > new_length) {
+        _setIndexed(new_length, null);
+      }
+      if (capacity < _capacity) {
+        _truncateData(capacity);
+      }
+      return;
+    }
     var newData = _allocateData(new_capacity);
     // This is a workaround for dartbug.com/30090. See the comment in _grow.
     if (new_length > 0) {
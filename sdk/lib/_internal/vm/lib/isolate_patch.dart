@@ -705,4 +705,11 @@ final class _TransferableTypedDataImpl implements TransferableTypedData {
 
   @pragma("vm:external-name", "TransferableTypedData_materialize")
   external Uint8List _materializeIntoUint8List();
+
+  ByteBuffer materializeUnmodifiable() {
+    return _materializeIntoUnmodifiableUint8List().buffer;
+  }
+
+  @pragma("vm:external-name", "TransferableTypedData_materializeUnmodifiable")
+  external Uint8List _materializeIntoUnmodifiableUint8List();
 }
@@ -297,6 +297,19 @@ class _RegExp implements RegExp {
   @pragma("vm:external-name", "RegExp_ExecuteMatchSticky")
   external List<int>? _ExecuteMatchSticky(String str, int start_index);
 
+  // Used by the generated code to skip ahead to the next possible match.
+  // Returns the first index at or after [index] in [str] whose code unit,
+  // and-ed with [mask], is [char].
+  @pragma("vm:external-name", "RegExp_skipUntilCharacter")
+  external static int _skipUntilCharacter(
+      String str, int index, int char, int mask);
+
+  // Returns the first index [index] + k * [skip] in [str] whose code unit
+  // has a non-zero entry in [table].
+  @pragma("vm:external-name", "RegExp_skipUntilBitInTable")
+  external static int _skipUntilBitInTable(
+      String str, int index, Uint8List table, int skip);
+
   static Int32List _getRegisters(int registers_count) {
     var registers = _registers;
     if (registers == null || registers.length < registers_count) {
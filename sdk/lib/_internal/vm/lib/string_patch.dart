@@ -353,9 +353,13 @@ abstract final class _StringBase implements String {
     if (pattern is String) {
       String other = pattern;
       int maxIndex = this.length - other.length;
+      if (other.isEmpty) return start;
       // TODO: Use an efficient string search (e.g. BMH).
+      // Only compare the whole pattern where its first code unit matches.
+      final otherCu0 = other.codeUnitAt(0);
       for (int index = start; index <= maxIndex; index++) {
-        if (_substringMatches(index, other)) {
+        if (this.codeUnitAt(index) == otherCu0 &&
+            _substringMatches(index, other)) {
           return index;
         }
       }
@@ -379,8 +383,12 @@ abstract final class _StringBase implements String {
       String other = pattern;
       int maxIndex = this.length - other.length;
       if (maxIndex < start) start = maxIndex;
+      if (other.isEmpty) return start;
+      // Only compare the whole pattern where its first code unit matches.
+      final otherCu0 = other.codeUnitAt(0);
       for (int index = start; index >= 0; index--) {
-        if (_substringMatches(index, other)) {
+        if (this.codeUnitAt(index) == otherCu0 &&
+            _substringMatches(index, other)) {
           return index;
         }
       }
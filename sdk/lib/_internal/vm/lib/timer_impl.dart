@@ -228,7 +228,11 @@ class _Timer implements Timer {
     if (!_isInHeap) return;
     bool update = _heap.isFirst(this);
     _heap.remove(this);
-    if (update) {
+    // While other timers are pending, keep the wakeup scheduled for this one.
+    // Waking up early finds no expired timers and schedules the next wakeup,
+    // which saves a message to the event handler for every canceled timer
+    // when timeouts are reset over and over, e.g. on every read.
+    if (update && _heap.isEmpty) {
       _notifyEventHandler();
     }
   }
@@ -115,6 +115,14 @@ abstract final class _TypedListBase {
   @pragma("vm:external-name", "TypedDataBase_setRange")
   external bool _setRange(int startInBytes, int lengthInBytes,
       _TypedListBase from, int startFromInBytes, int toCid, int fromCid);
+
+  // Stores [count] elements of [from], starting at [skipCount], into this
+  // list starting at [start], converting them to the element type of this
+  // list like the [] operator does. Both lists must be integer lists or
+  // both must be floating point lists.
+  @pragma("vm:external-name", "TypedDataBase_setConvertedRange")
+  external void _setConvertedRange(
+      int start, int count, _TypedListBase from, int skipCount);
 }
 
 mixin _IntListMixin implements List<int> {
@@ -431,18 +439,10 @@ mixin _TypedIntListMixin<SpawnedType extends List<int>> on _IntListMixin
             ClassID.getID(from))) {
           return;
         }
-      } else if (fromAsTypedList.buffer == this.buffer) {
-        // Different element sizes, but same buffer means that we need
-        // an intermediate structure.
-        // TODO(srdjan): Optimize to skip copying if the range does not overlap.
-        final fromAsList = from as List<int>;
-        final tempBuffer = _createList(count);
-        for (var i = 0; i < count; i++) {
-          tempBuffer[i] = fromAsList[skipCount + i];
-        }
-        for (var i = start; i < end; i++) {
-          this[i] = tempBuffer[i - start];
-        }
+      } else if ((count >= 10) || (fromAsTypedList.buffer == this.buffer)) {
+        // Different element sizes. The native conversion also handles
+        // overlapping ranges in the same buffer.
+        _setConvertedRange(start, count, fromAsTypedList, skipCount);
         return;
       }
     }
@@ -789,18 +789,10 @@ mixin _TypedDoubleListMixin<SpawnedType extends List<double>>
             ClassID.getID(from))) {
           return;
         }
-      } else if (fromAsTypedList.buffer == this.buffer) {
-        // Different element sizes, but same buffer means that we need
-        // an intermediate structure.
-        // TODO(srdjan): Optimize to skip copying if the range does not overlap.
-        final fromAsList = from as List<double>;
-        final tempBuffer = _createList(count);
-        for (var i = 0; i < count; i++) {
-          tempBuffer[i] = fromAsList[skipCount + i];
-        }
-        for (var i = start; i < end; i++) {
-          this[i] = tempBuffer[i - start];
-        }
+      } else if ((count >= 10) || (fromAsTypedList.buffer == this.buffer)) {
+        // Different element sizes. The native conversion also handles
+        // overlapping ranges in the same buffer.
+        _setConvertedRange(start, count, fromAsTypedList, skipCount);
         return;
       }
     }
@@ -1216,11 +1216,23 @@ class _BigIntImpl implements BigInt {
   /// Multiplication operator.
   _BigIntImpl operator *(BigInt bigInt) {
     final other = _ensureSystemBigInt(bigInt, 'bigInt');
+    return _absMulSetSign(other, _isNegative != other._isNegative);
+  }
+
+  /// Factors with at least this many digits are multiplied with
+  /// [_absMulKaratsubaSetSign].
+  static const int _karatsubaThreshold = 64;
+
+  /// Returns `abs(this) * abs(other)` with sign set according to [isNegative].
+  _BigIntImpl _absMulSetSign(_BigIntImpl other, bool isNegative) {
     var used = _used;
     var otherUsed = other._used;
     if (used == 0 || otherUsed == 0) {
       return zero;
     }
+    if (used >= _karatsubaThreshold && otherUsed >= _karatsubaThreshold) {
+      return _absMulKaratsubaSetSign(other, isNegative);
+    }
     var resultUsed = used + otherUsed;
     var digits = _digits;
     var otherDigits = other._digits;
@@ -1229,8 +1241,63 @@ class _BigIntImpl implements BigInt {
     while (i < otherUsed) {
       i += _mulAdd(otherDigits, i, digits, 0, resultDigits, i, used);
     }
+    return new _BigIntImpl._(isNegative, resultUsed, resultDigits);
+  }
+
+  /// Returns `abs(this) * abs(other)` with sign set according to [isNegative],
+  /// using three multiplications of half the size instead of four.
+  ///
+  /// With `B = 2^(half*_digitBits)`, `abs(this) = x1*B + x0` and
+  /// `abs(other) = y1*B + y0`, the product is `z2*B^2 + z1*B + z0` where
+  /// `z2 = x1*y1`, `z0 = x0*y0` and `z1 = (x1 + x0)*(y1 + y0) - z2 - z0`.
+  _BigIntImpl _absMulKaratsubaSetSign(_BigIntImpl other, bool isNegative) {
+    final used = _used;
+    final otherUsed = other._used;
+    final half = (_max(used, otherUsed) + 1) >> 1;
+    if (_min(used, otherUsed) <= half) {
+      // Splitting the shorter factor would leave its high half empty, so
+      // only split the longer one.
+      final longer = used > otherUsed ? this : other;
+      final shorter = used > otherUsed ? other : this;
+      final high = longer._highDigits(half)._absMulSetSign(shorter, false);
+      final low = longer._lowDigits(half)._absMulSetSign(shorter, false);
+      return high._dlShift(half)._absAddSetSign(low, isNegative);
+    }
+    final x1 = _highDigits(half);
+    final x0 = _lowDigits(half);
+    final y1 = other._highDigits(half);
+    final y0 = other._lowDigits(half);
+    final z2 = x1._absMulSetSign(y1, false);
+    final z0 = x0._absMulSetSign(y0, false);
+    final z1 = x1
+        ._absAddSetSign(x0, false)
+        ._absMulSetSign(y1._absAddSetSign(y0, false), false)
+        ._absSubSetSign(z2, false)
+        ._absSubSetSign(z0, false);
+    return z2
+        ._dlShift(half)
+        ._absAddSetSign(z1, false)
+        ._dlShift(half)
+        ._absAddSetSign(z0, isNegative);
+  }
+
+  /// Returns the non-negative number made of the lowest [n] digits of this.
+  ///
+  /// Requires `n < _used`.
+  _BigIntImpl _lowDigits(int n) {
+    assert(n < _used);
+    return new _BigIntImpl._(false, n, _cloneDigits(_digits, 0, n, n));
+  }
+
+  /// Returns the non-negative number made of the digits of this above the
+  /// lowest [n] digits.
+  ///
+  /// Requires `n < _used`.
+  _BigIntImpl _highDigits(int n) {
+    assert(n < _used);
+    final resultUsed = _used - n;
     return new _BigIntImpl._(
-        _isNegative != other._isNegative, resultUsed, resultDigits);
+        false, resultUsed, _cloneDigits(_digits, n, _used, resultUsed));
   }
 
   // resultDigits[0..resultUsed-1] =
@@ -163,6 +163,10 @@ mixin _HashBase on _HashAbstractBase {
   static const int _UNINITIALIZED_HASH_MASK = 0;
 
   // Unused and deleted entries are marked by 0 and 1, respectively.
+  // Hash patterns are non-zero multiples of the maximal number of entries, so
+  // xor-ing either marker with a hash pattern never yields a valid entry.
+  // Lookups therefore only need to test for the unused marker, which ends
+  // the probe sequence.
   static const int _UNUSED_PAIR = 0;
   static const int _DELETED_PAIR = 1;
 
@@ -483,18 +487,14 @@ mixin _LinkedHashMapMixin<K, V> on _HashBase, _EqualsAndHashCode {
     int firstDeleted = -1;
     int pair = index[i];
     while (pair != _HashBase._UNUSED_PAIR) {
-      if (pair == _HashBase._DELETED_PAIR) {
-        if (firstDeleted < 0) {
-          firstDeleted = i;
-        }
-      } else {
-        final int entry = hashPattern ^ pair;
-        if (entry < maxEntries) {
-          final int d = entry << 1;
-          if (_equals(key, _data[d])) {
-            return d + 1;
-          }
+      final int entry = hashPattern ^ pair;
+      if (entry < maxEntries) {
+        final int d = entry << 1;
+        if (_equals(key, _data[d])) {
+          return d + 1;
         }
+      } else if (pair == _HashBase._DELETED_PAIR && firstDeleted < 0) {
+        firstDeleted = i;
       }
       i = _HashBase._nextProbe(i, sizeMask);
       pair = index[i];
@@ -548,25 +548,24 @@ mixin _LinkedHashMapMixin<K, V> on _HashBase, _EqualsAndHashCode {
     final int maxEntries = size >> 1;
     final int fullHash = _hashCode(key);
     final int hashPattern = _HashBase._hashPattern(fullHash, _hashMask, size);
+    final Uint32List index = _index;
     int i = _HashBase._firstProbe(fullHash, sizeMask);
-    int pair = _index[i];
+    int pair = index[i];
     while (pair != _HashBase._UNUSED_PAIR) {
-      if (pair != _HashBase._DELETED_PAIR) {
-        final int entry = hashPattern ^ pair;
-        if (entry < maxEntries) {
-          final int d = entry << 1;
-          if (_equals(key, _data[d])) {
-            _index[i] = _HashBase._DELETED_PAIR;
-            _HashBase._setDeletedAt(_data, d);
-            V value = _data[d + 1] as V;
-            _HashBase._setDeletedAt(_data, d + 1);
-            ++_deletedKeys;
-            return value;
-          }
+      final int entry = hashPattern ^ pair;
+      if (entry < maxEntries) {
+        final int d = entry << 1;
+        if (_equals(key, _data[d])) {
+          index[i] = _HashBase._DELETED_PAIR;
+          _HashBase._setDeletedAt(_data, d);
+          V value = _data[d + 1] as V;
+          _HashBase._setDeletedAt(_data, d + 1);
+          ++_deletedKeys;
+          return value;
         }
       }
       i = _HashBase._nextProbe(i, sizeMask);
-      pair = _index[i];
+      pair = index[i];
     }
     return null;
   }
@@ -578,20 +577,19 @@ mixin _LinkedHashMapMixin<K, V> on _HashBase, _EqualsAndHashCode {
     final int maxEntries = size >> 1;
     final int fullHash = _hashCode(key);
     final int hashPattern = _HashBase._hashPattern(fullHash, _hashMask, size);
+    final Uint32List index = _index;
     int i = _HashBase._firstProbe(fullHash, sizeMask);
-    int pair = _index[i];
+    int pair = index[i];
     while (pair != _HashBase._UNUSED_PAIR) {
-      if (pair != _HashBase._DELETED_PAIR) {
-        final int entry = hashPattern ^ pair;
-        if (entry < maxEntries) {
-          final int d = entry << 1;
-          if (_equals(key, _data[d])) {
-            return _data[d + 1];
-          }
+      final int entry = hashPattern ^ pair;
+      if (entry < maxEntries) {
+        final int d = entry << 1;
+        if (_equals(key, _data[d])) {
+          return _data[d + 1];
         }
       }
       i = _HashBase._nextProbe(i, sizeMask);
-      pair = _index[i];
+      pair = index[i];
     }
     return _data;
   }
@@ -852,15 +850,13 @@ mixin _LinkedHashSetMixin<E> on _HashBase, _EqualsAndHashCode {
     int firstDeleted = -1;
     int pair = _index[i];
     while (pair != _HashBase._UNUSED_PAIR) {
-      if (pair == _HashBase._DELETED_PAIR) {
-        if (firstDeleted < 0) {
-          firstDeleted = i;
-        }
-      } else {
-        final int d = hashPattern ^ pair;
-        if (d < maxEntries && _equals(key, _data[d])) {
+      final int d = hashPattern ^ pair;
+      if (d < maxEntries) {
+        if (_equals(key, _data[d])) {
           return false;
         }
+      } else if (pair == _HashBase._DELETED_PAIR && firstDeleted < 0) {
+        firstDeleted = i;
       }
       i = _HashBase._nextProbe(i, sizeMask);
       pair = _index[i];
@@ -885,17 +881,16 @@ mixin _LinkedHashSetMixin<E> on _HashBase, _EqualsAndHashCode {
     final int maxEntries = size >> 1;
     final int fullHash = _hashCode(key);
     final int hashPattern = _HashBase._hashPattern(fullHash, _hashMask, size);
+    final Uint32List index = _index;
     int i = _HashBase._firstProbe(fullHash, sizeMask);
-    int pair = _index[i];
+    int pair = index[i];
     while (pair != _HashBase._UNUSED_PAIR) {
-      if (pair != _HashBase._DELETED_PAIR) {
-        final int d = hashPattern ^ pair;
-        if (d < maxEntries && _equals(key, _data[d])) {
-          return _data[d]; // Note: Must return the existing key.
-        }
+      final int d = hashPattern ^ pair;
+      if (d < maxEntries && _equals(key, _data[d])) {
+        return _data[d]; // Note: Must return the existing key.
       }
       i = _HashBase._nextProbe(i, sizeMask);
-      pair = _index[i];
+      pair = index[i];
     }
     return _data;
   }
@@ -913,20 +908,19 @@ mixin _LinkedHashSetMixin<E> on _HashBase, _EqualsAndHashCode {
     final int maxEntries = size >> 1;
     final int fullHash = _hashCode(key);
     final int hashPattern = _HashBase._hashPattern(fullHash, _hashMask, size);
+    final Uint32List index = _index;
     int i = _HashBase._firstProbe(fullHash, sizeMask);
-    int pair = _index[i];
+    int pair = index[i];
     while (pair != _HashBase._UNUSED_PAIR) {
-      if (pair != _HashBase._DELETED_PAIR) {
-        final int d = hashPattern ^ pair;
-        if (d < maxEntries && _equals(key, _data[d])) {
-          _index[i] = _HashBase._DELETED_PAIR;
-          _HashBase._setDeletedAt(_data, d);
-          ++_deletedKeys;
-          return true;
-        }
+      final int d = hashPattern ^ pair;
+      if (d < maxEntries && _equals(key, _data[d])) {
+        index[i] = _HashBase._DELETED_PAIR;
+        _HashBase._setDeletedAt(_data, d);
+        ++_deletedKeys;
+        return true;
       }
       i = _HashBase._nextProbe(i, sizeMask);
-      pair = _index[i];
+      pair = index[i];
     }
     return false;
   }
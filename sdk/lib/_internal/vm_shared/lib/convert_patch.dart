@@ -28,6 +28,12 @@ import "dart:typed_data" show Uint8List, Uint16List;
 @patch
 dynamic _parseJson(
     String source, Object? Function(Object? key, Object? value)? reviver) {
+  if (reviver == null) {
+    final result = _parseJsonNative(source);
+    // The native parser returns the source itself for input it does not
+    // accept, including malformed input, which the parser below reports.
+    if (!identical(result, source)) return result;
+  }
   _JsonListener listener = new _JsonListener(reviver);
   var parser = new _JsonStringParser(listener);
   parser.chunk = source;
@@ -37,6 +43,12 @@ dynamic _parseJson(
   return listener.result;
 }
 
+/// Parses [source] directly into the objects [_JsonListener] would create.
+///
+/// Returns [source] itself if it cannot parse it.
+@pragma("vm:external-name", "Json_parse")
+external Object? _parseJsonNative(String source);
+
 @patch
 class Utf8Decoder {
   @patch
@@ -1541,6 +1553,11 @@ class _JsonUtf8Parser extends _ChunkedJsonParser<List<int>> {
   }
 
   double parseDouble(int start, int end) {
+    final chunk = this.chunk;
+    if (chunk is Uint8List) {
+      // Parse the bytes in place instead of creating a string first.
+      return _parseDoubleBytes(chunk, start, end);
+    }
     String string = getString(start, end, 0x7f);
     return _parseDouble(string, 0, string.length);
   }
@@ -1549,6 +1566,9 @@ class _JsonUtf8Parser extends _ChunkedJsonParser<List<int>> {
 @pragma("vm:external-name", "Double_parse")
 external double _parseDouble(String source, int start, int end);
 
+@pragma("vm:external-name", "Double_parseBytes")
+external double _parseDoubleBytes(Uint8List bytes, int start, int end);
+
 /**
  * Implements the chunked conversion from a UTF-8 encoding of JSON
  * to its corresponding object.
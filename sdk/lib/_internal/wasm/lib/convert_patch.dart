@@ -3,7 +3,15 @@
 // BSD-style license that can be found in the LICENSE file.
 
 import "dart:_internal" show patch;
+import "dart:typed_data" show Uint8List;
 
 @patch
 double _parseDouble(String source, int start, int end) =>
     double.parse(source.substring(start, end));
+
+@patch
+double _parseDoubleBytes(Uint8List bytes, int start, int end) =>
+    double.parse(String.fromCharCodes(bytes, start, end));
+
+@patch
+Object? _parseJsonNative(String source) => source;
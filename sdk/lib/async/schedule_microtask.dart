@@ -6,24 +6,30 @@ part of dart.async;
 
 typedef void _AsyncCallback();
 
-class _AsyncCallbackEntry {
-  final _AsyncCallback callback;
-  _AsyncCallbackEntry? next;
-  _AsyncCallbackEntry(this.callback);
-}
+/// Pending callbacks in the order they run, stored in a circular buffer.
+///
+/// The length of the buffer is always a power of two, so that positions can
+/// wrap around with a mask. A buffer avoids allocating a list entry for each
+/// scheduled callback. It is empty until the first callback is scheduled.
+List<_AsyncCallback?> _callbacks = const <_AsyncCallback?>[];
+
+const int _initialCallbacksCapacity = 16;
 
-/// Head of single linked list of pending callbacks.
-_AsyncCallbackEntry? _nextCallback;
+/// Buffers larger than this are released when the queue becomes empty.
+const int _maxRetainedCallbacksCapacity = 1024;
 
-/// Tail of single linked list of pending callbacks.
-_AsyncCallbackEntry? _lastCallback;
+/// Position in [_callbacks] of the next callback to run.
+int _callbacksHead = 0;
 
-/// Tail of priority callbacks added by the currently executing callback.
+/// Number of pending callbacks.
+int _callbacksLength = 0;
+
+/// Number of priority callbacks added by the currently executing callback.
 ///
 /// Priority callbacks are put at the beginning of the
 /// callback queue, so that if one callback schedules more than one
 /// priority callback, they are still enqueued in scheduling order.
-_AsyncCallbackEntry? _lastPriorityCallback;
+int _priorityCallbacksLength = 0;
 
 /// Whether we are currently inside the callback loop.
 ///
@@ -32,12 +38,19 @@ _AsyncCallbackEntry? _lastPriorityCallback;
 bool _isInCallbackLoop = false;
 
 void _microtaskLoop() {
-  for (var entry = _nextCallback; entry != null; entry = _nextCallback) {
-    _lastPriorityCallback = null;
-    var next = entry.next;
-    _nextCallback = next;
-    if (next == null) _lastCallback = null;
-    (entry.callback)();
+  while (_callbacksLength > 0) {
+    _priorityCallbacksLength = 0;
+    final callbacks = _callbacks;
+    final head = _callbacksHead;
+    final callback = callbacks[head]!;
+    callbacks[head] = null;
+    _callbacksHead = (head + 1) & (callbacks.length - 1);
+    _callbacksLength--;
+    callback();
+  }
+  if (_callbacks.length > _maxRetainedCallbacksCapacity) {
+    _callbacks = const <_AsyncCallback?>[];
+    _callbacksHead = 0;
   }
 }
 
@@ -48,29 +61,39 @@ void _startMicrotaskLoop() {
     // good optimization.
     _microtaskLoop();
   } finally {
-    _lastPriorityCallback = null;
+    _priorityCallbacksLength = 0;
     _isInCallbackLoop = false;
-    if (_nextCallback != null) {
+    if (_callbacksLength > 0) {
       _AsyncRun._scheduleImmediate(_startMicrotaskLoop);
     }
   }
 }
 
+/// Doubles the capacity of [_callbacks], moving the pending callbacks to the
+/// start of the new buffer.
+void _growCallbacks() {
+  final callbacks = _callbacks;
+  final capacity = callbacks.length;
+  final grown = List<_AsyncCallback?>.filled(
+      capacity == 0 ? _initialCallbacksCapacity : capacity * 2, null);
+  final head = _callbacksHead;
+  grown.setRange(0, capacity - head, callbacks, head);
+  grown.setRange(capacity - head, capacity, callbacks);
+  _callbacks = grown;
+  _callbacksHead = 0;
+}
+
 /// Schedules a callback to be called as a microtask.
 ///
 /// The microtask is called after all other currently scheduled
 /// microtasks, but as part of the current system event.
 void _scheduleAsyncCallback(_AsyncCallback callback) {
-  _AsyncCallbackEntry newEntry = new _AsyncCallbackEntry(callback);
-  _AsyncCallbackEntry? lastCallback = _lastCallback;
-  if (lastCallback == null) {
-    _nextCallback = _lastCallback = newEntry;
-    if (!_isInCallbackLoop) {
-      _AsyncRun._scheduleImmediate(_startMicrotaskLoop);
-    }
-  } else {
-    lastCallback.next = newEntry;
-    _lastCallback = newEntry;
+  if (_callbacksLength == _callbacks.length) _growCallbacks();
+  final callbacks = _callbacks;
+  callbacks[(_callbacksHead + _callbacksLength) & (callbacks.length - 1)] =
+      callback;
+  if (_callbacksLength++ == 0 && !_isInCallbackLoop) {
+    _AsyncRun._scheduleImmediate(_startMicrotaskLoop);
   }
 }
 
@@ -81,25 +104,22 @@ void _scheduleAsyncCallback(_AsyncCallback callback) {
 ///
 /// Is always run in the root zone.
 void _schedulePriorityAsyncCallback(_AsyncCallback callback) {
-  if (_nextCallback == null) {
+  if (_callbacksLength == 0) {
     _scheduleAsyncCallback(callback);
-    _lastPriorityCallback = _lastCallback;
+    _priorityCallbacksLength = 1;
     return;
   }
-  _AsyncCallbackEntry entry = new _AsyncCallbackEntry(callback);
-  _AsyncCallbackEntry? lastPriorityCallback = _lastPriorityCallback;
-  if (lastPriorityCallback == null) {
-    entry.next = _nextCallback;
-    _nextCallback = _lastPriorityCallback = entry;
-  } else {
-    var next = lastPriorityCallback.next;
-    entry.next = next;
-    lastPriorityCallback.next = entry;
-    _lastPriorityCallback = entry;
-    if (next == null) {
-      _lastCallback = entry;
-    }
+  if (_callbacksLength == _callbacks.length) _growCallbacks();
+  final callbacks = _callbacks;
+  final mask = callbacks.length - 1;
+  final head = _callbacksHead;
+  // Move the callbacks after the earlier priority callbacks one place back.
+  for (var i = _callbacksLength; i > _priorityCallbacksLength; i--) {
+    callbacks[(head + i) & mask] = callbacks[(head + i - 1) & mask];
   }
+  callbacks[(head + _priorityCallbacksLength) & mask] = callback;
+  _callbacksLength++;
+  _priorityCallbacksLength++;
 }
 
 /// Runs a function asynchronously.
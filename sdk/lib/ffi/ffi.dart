@@ -22,6 +22,9 @@ part 'allocation.dart';
 part 'annotations.dart';
 part 'c_type.dart';
 part 'dynamic_library.dart';
+part 'isolate_group_callback.dart';
+part 'native_arena.dart';
+part 'native_callback_listener.dart';
 part 'struct.dart';
 part 'union.dart';
 
@@ -36,6 +39,52 @@ external int sizeOf<T extends NativeType>();
 /// a pointer with address 0.
 final Pointer<Never> nullptr = Pointer.fromAddress(0);
 
+/// Calls [action] with a pointer to the bytes of [data].
+///
+/// The pointer stays valid until [action] returns, also across garbage
+/// collections, so it may be passed to native functions which are not leaf
+/// calls and may call back into Dart. Native code may read and write the
+/// bytes through it. It must not keep the pointer after [action] returns.
+///
+/// The bytes of external typed data, and of typed data the garbage collector
+/// has already moved out of the young generation, are passed without
+/// copying. The latter are pinned until [action] returns. This includes any
+/// typed data too large for the young generation. The bytes of other typed
+/// data are copied to native memory before [action] is called, and copied
+/// back afterwards.
+///
+/// If [action] is asynchronous, the pointer is only valid until it returns
+/// its future, not until the future completes.
+@Since('3.0')
+external R withPinnedTypedData<R>(
+    TypedData data, R Function(Pointer<Uint8> bytes) action);
+
+/// Calls the native [function] [count] times, leaving Dart only once.
+///
+/// Every call from Dart to native code has to switch the thread into a state
+/// where the garbage collector can run without it, and back. For very small
+/// native functions, such as per-pixel operations, this switch can cost more
+/// than the function itself. This function switches once for all [count]
+/// calls.
+///
+/// The arguments of call `i` are read from [arguments] at indices
+/// `i * n` to `i * n + n - 1`, where `n` is the number of parameters of
+/// [T]. Its result is stored to `results[i]`, converted to the [IntPtr]
+/// representation of the return type of [T]. [results] is not used, and may
+/// be [nullptr], if [T] returns [Void].
+///
+/// [T] must take at most 6 parameters. Parameters and result must be
+/// integers, [Bool] or [Pointer], except for [Int64] and [Uint64] on 32-bit
+/// architectures. Other signatures throw an [ArgumentError].
+///
+/// The [function] must not call back into Dart.
+@Since('3.0')
+external void callNativeBatch<T extends Function>(
+    Pointer<NativeFunction<T>> function,
+    Pointer<IntPtr> arguments,
+    Pointer<IntPtr> results,
+    int count);
+
 /// Represents a pointer into the native C memory. Cannot be extended.
 @pragma('vm:entry-point')
 @pragma("wasm:entry-point")
@@ -0,0 +1,65 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+part of dart.ffi;
+
+/// A native callback which runs a Dart function synchronously on any thread.
+///
+/// The function returned by [Pointer.fromFunction] may only be called on the
+/// thread currently running the isolate which created it. [nativeFunction]
+/// may be called by native code on any thread, including many threads at
+/// once, until [close] is called.
+///
+/// A call from a thread which is not running any isolate runs the callback
+/// in a helper isolate of the isolate group of the creator. Helper isolates
+/// share the code of the group, but not its state: each has its own static
+/// and top-level variables, and they can only communicate with other
+/// isolates through ports. Helper isolates are reused by later calls, so
+/// a native thread pool keeps running the callback in the same few isolates.
+/// A call from a native function which was called by Dart code runs the
+/// callback in the isolate which called that native function.
+///
+/// The callback must be a static or top-level function, and is called
+/// synchronously. Asynchronous work it starts in a helper isolate may never
+/// complete. If the callback throws, the error is printed and the native
+/// function returns zero.
+///
+/// The native signature [T] must take at most 6 arguments, each of which
+/// must be a fixed size integer type such as [Int32], [Bool] or a [Pointer].
+/// It must return [Void] or one of those types. [Int64] and [Uint64] are
+/// only supported on 64-bit architectures. Pointers are passed to the
+/// callback as `Pointer<Never>`.
+///
+/// ```dart
+/// int square(int x) => x * x;
+///
+/// final callback = IsolateGroupCallback<Int64 Function(Int64)>(square);
+/// nativeThreadPoolMap(callback.nativeFunction, input, output, length);
+/// callback.close();
+/// ```
+@Since('3.0')
+abstract final class IsolateGroupCallback<T extends Function> {
+  /// Creates a native function which calls [callback] with its arguments.
+  ///
+  /// The [callback] must be a static or top-level function which accepts the
+  /// Dart representation of the arguments of [T], positionally, and returns
+  /// the Dart representation of its result.
+  ///
+  /// Throws an [ArgumentError] if [callback] is not a static function, if [T]
+  /// is not a supported native signature, or if too many callbacks with the
+  /// same number of arguments are open.
+  external factory IsolateGroupCallback(Function callback);
+
+  /// The native function which calls the callback.
+  ///
+  /// Calling it after [close] is a fatal error.
+  Pointer<NativeFunction<T>> get nativeFunction;
+
+  /// Releases [nativeFunction].
+  ///
+  /// Waits for calls in progress on other threads to complete. Must not be
+  /// called from the callback itself. Native code must not call
+  /// [nativeFunction] after this returns.
+  void close();
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+part of dart.ffi;
+
+/// An [Allocator] for many small, short-lived native allocations.
+///
+/// Blocks of up to 2048 bytes are rounded up to a power of two and carved out
+/// of larger chunks of native memory. Freed blocks are reused by later
+/// allocations of the same size, without returning memory to the system.
+/// Larger blocks are allocated individually.
+///
+/// All memory of the arena is released at once by [releaseAll], or when the
+/// arena is garbage collected. Pointers returned by [allocate] must not be
+/// used after either. The native memory held by an arena counts towards the
+/// external memory of the isolate, so that the garbage collector runs when
+/// unreachable arenas hold a lot of it.
+///
+/// ```dart
+/// final arena = NativeArena();
+/// for (final name in names) {
+///   final nativeName = name.toNativeUtf8(allocator: arena);
+///   nativeFunction(nativeName);
+///   arena.free(nativeName);
+/// }
+/// arena.releaseAll();
+/// ```
+///
+/// An arena belongs to the isolate which created it and cannot be sent to
+/// other isolates. It must not be used from native code.
+@Since('3.0')
+abstract final class NativeArena implements Allocator {
+  /// Creates an empty arena.
+  external factory NativeArena();
+
+  /// Allocates [byteCount] bytes of native memory from this arena.
+  ///
+  /// The memory is not initialized. The [alignment] may be at most 16, which
+  /// is also the alignment used if it is omitted.
+  ///
+  /// Throws an [ArgumentError] if [alignment] is larger than 16.
+  Pointer<T> allocate<T extends NativeType>(int byteCount, {int? alignment});
+
+  /// Returns [pointer] to this arena for reuse by later allocations.
+  ///
+  /// The [pointer] must have been returned by [allocate] of this arena since
+  /// the last [releaseAll], and must not have been freed already.
+  void free(Pointer pointer);
+
+  /// Releases all native memory of this arena.
+  ///
+  /// All pointers allocated from this arena become invalid. The arena can be
+  /// used for further allocations.
+  void releaseAll();
+}
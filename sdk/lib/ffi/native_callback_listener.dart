@@ -0,0 +1,57 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+part of dart.ffi;
+
+/// A native callback which can be invoked from any thread.
+///
+/// Unlike the function returned by [Pointer.fromFunction], which may only be
+/// called on the thread currently running the isolate, [nativeFunction] may
+/// be called by native code on any thread, at any time, until [close] is
+/// called.
+///
+/// Calling [nativeFunction] does not run Dart code. It records the arguments
+/// and returns immediately. The calls are then delivered to the callback
+/// passed to the constructor, in the order they were made, by the event loop
+/// of the isolate which created the listener. Calls that arrive while the
+/// isolate is busy are delivered together once it next handles events.
+///
+/// The native signature [T] must return [Void] and take at most 6 arguments,
+/// each of which must be a fixed size integer type such as [Int32], [Bool]
+/// or a [Pointer]. [Int64] and [Uint64] arguments are only supported on
+/// 64-bit architectures. Pointers are passed to the callback as
+/// `Pointer<Never>`.
+///
+/// ```dart
+/// final listener = NativeCallbackListener<Void Function(Int32)>(
+///     (int status) => print('status: $status'));
+/// startNativeWork(listener.nativeFunction);
+/// // Later, once native code no longer calls the function:
+/// listener.close();
+/// ```
+///
+/// A listener keeps the isolate alive until it is closed.
+@Since('3.0')
+abstract final class NativeCallbackListener<T extends Function> {
+  /// Creates a listener which calls [callback] with the arguments of each
+  /// call to [nativeFunction].
+  ///
+  /// The [callback] must accept the Dart representation of the arguments of
+  /// [T], positionally.
+  ///
+  /// Throws an [ArgumentError] if [T] is not a supported native signature, or
+  /// if too many listeners with the same number of arguments are open.
+  external factory NativeCallbackListener(Function callback);
+
+  /// The native function which queues a call to the callback.
+  ///
+  /// Calling it after [close] has undefined behavior.
+  Pointer<NativeFunction<T>> get nativeFunction;
+
+  /// Stops delivering calls and releases [nativeFunction].
+  ///
+  /// Calls which have not been delivered yet are dropped. Native code must
+  /// not call [nativeFunction] after this returns.
+  void close();
+}
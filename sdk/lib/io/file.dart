@@ -653,6 +653,31 @@ abstract interface class RandomAccessFile {
   /// Throws a [FileSystemException] if the operation fails.
   int readIntoSync(List<int> buffer, [int start = 0, int? end]);
 
+  /// Synchronously maps the bytes from [start] to [end] of the file into
+  /// memory.
+  ///
+  /// The [start] must be non-negative and no greater than the length of the
+  /// file. If [end] is omitted, it defaults to the length of the file.
+  /// Otherwise [end] must be no less than [start]
+  /// and no greater than the length of the file.
+  ///
+  /// Returns an unmodifiable list backed by the mapping. The bytes are not
+  /// copied into the Dart heap but loaded from the file when first accessed.
+  /// The mapping stays valid after this file is closed and is removed once
+  /// the list is garbage collected. On Windows, the bytes are read into
+  /// memory when the file is mapped.
+  ///
+  /// If [sequential] is `true`, the operating system is told that the bytes
+  /// will be accessed in order, so that it can read ahead of the accesses.
+  ///
+  /// Changes to the file may or may not be visible through the list.
+  /// Accessing bytes past the end of a file that was truncated after it was
+  /// mapped may crash the process.
+  ///
+  /// Throws a [FileSystemException] if the operation fails.
+  @Since("3.0")
+  Uint8List mapSync({int start = 0, int? end, bool sequential = false});
+
   /// Writes a single byte to the file.
   ///
   /// Returns a `Future<RandomAccessFile>` that completes with this
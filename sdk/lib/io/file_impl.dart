@@ -7,6 +7,9 @@ part of dart.io;
 // Read the file in blocks of size 64k.
 const int _blockSize = 64 * 1024;
 
+// File streams grow their blocks up to 1MB while reads return full blocks.
+const int _maxStreamBlockSize = 1024 * 1024;
+
 // The maximum number of bytes to read in a single call to `read`.
 //
 // On Windows and macOS, it is an error to call
@@ -44,6 +47,9 @@ class _FileStream extends Stream<List<int>> {
 
   bool _atEnd = false;
 
+  // The number of bytes to request by the next read.
+  int _readSize = _blockSize;
+
   _FileStream(this._path, int? position, this._end) : _position = position ?? 0;
 
   _FileStream.forStdin() : _position = 0;
@@ -89,7 +95,7 @@ class _FileStream extends Stream<List<int>> {
       return;
     }
     _readInProgress = true;
-    int readBytes = _blockSize;
+    int readBytes = _readSize;
     final end = _end;
     if (end != null) {
       readBytes = min(readBytes, end - _position);
@@ -117,6 +123,11 @@ class _FileStream extends Stream<List<int>> {
       // See https://man7.org/linux/man-pages/man2/read.2.html
       if (block.length == 0 || (_end != null && _position == _end)) {
         _atEnd = true;
+      } else if (block.length == readBytes && _readSize < _maxStreamBlockSize) {
+        // Regular files return full blocks until their end, so read them in
+        // larger chunks to save round trips to the IO service. Pipes and
+        // terminals return what is available and keep the small blocks.
+        _readSize *= 2;
       }
       if (!_atEnd && !_controller.isPaused) {
         _readBlock();
@@ -168,6 +179,11 @@ class _FileStream extends Stream<List<int>> {
       _closeCompleter.complete();
     }
 
+    Future<RandomAccessFile> adviseSequential(RandomAccessFile file) {
+      if (file is! _RandomAccessFile) return Future.value(file);
+      return file._adviseSequential().then((_) => file);
+    }
+
     final path = _path;
     final openedFile = _openedFile;
     if (openedFile != null) {
@@ -175,6 +191,7 @@ class _FileStream extends Stream<List<int>> {
     } else if (path != null) {
       new File(path)
           .open(mode: FileMode.read)
+          .then(adviseSequential)
           .then(onOpenFile, onError: openFailed);
     } else {
       try {
@@ -187,6 +204,9 @@ class _FileStream extends Stream<List<int>> {
 }
 
 class _FileStreamConsumer extends StreamConsumer<List<int>> {
+  // The stream is paused while more than this many bytes wait for a write.
+  static const int _maxPendingBytes = 64 * 1024;
+
   File? _file;
   Future<RandomAccessFile> _openFuture;
 
@@ -204,23 +224,47 @@ class _FileStreamConsumer extends StreamConsumer<List<int>> {
     Completer<File?> completer = new Completer<File?>.sync();
     _openFuture.then((openedFile) {
       late StreamSubscription<List<int>> _subscription;
+      // Data that arrives while a write is in progress is written by the
+      // next write, so that many small chunks, such as log lines, only need
+      // a few writes.
+      var pending = new BytesBuilder(copy: false);
+      var writing = false;
+      var done = false;
       void error(e, StackTrace stackTrace) {
         _subscription.cancel();
         openedFile.close();
         completer.completeError(e, stackTrace);
       }
 
-      _subscription = stream.listen((d) {
-        _subscription.pause();
+      void writePending() {
+        if (completer.isCompleted) return;
+        if (pending.isEmpty) {
+          writing = false;
+          if (done) completer.complete(_file);
+          return;
+        }
+        writing = true;
+        var data = pending.takeBytes();
+        if (_subscription.isPaused) _subscription.resume();
         try {
           openedFile
-              .writeFrom(d, 0, d.length)
-              .then((_) => _subscription.resume(), onError: error);
+              .writeFrom(data, 0, data.length)
+              .then((_) => writePending(), onError: error);
         } catch (e, stackTrace) {
           error(e, stackTrace);
         }
+      }
+
+      _subscription = stream.listen((d) {
+        pending.add(d);
+        if (!writing) {
+          writePending();
+        } else if (pending.length >= _maxPendingBytes) {
+          _subscription.pause();
+        }
       }, onDone: () {
-        completer.complete(_file);
+        done = true;
+        if (!writing) completer.complete(_file);
       }, onError: error, cancelOnError: true);
     }).catchError(completer.completeError);
     return completer.future;
@@ -700,6 +744,7 @@ abstract class _RandomAccessFileOps {
   length();
   flush();
   lock(int lock, int start, int end);
+  map(int start, int length, bool sequential);
 }
 
 @pragma("vm:entry-point")
@@ -837,6 +882,19 @@ class _RandomAccessFile implements RandomAccessFile {
     return result;
   }
 
+  Uint8List mapSync({int start = 0, int? end, bool sequential = false}) {
+    _checkAvailable();
+    end = RangeError.checkValidRange(start, end, lengthSync());
+    if (end == start) {
+      return new Uint8List(0);
+    }
+    var result = _ops.map(start, end - start, sequential);
+    if (result is OSError) {
+      throw new FileSystemException("mapSync failed", path, result);
+    }
+    return result as Uint8List;
+  }
+
   Future<RandomAccessFile> writeByte(int value) {
     // TODO(40614): Remove once non-nullability is sound.
     ArgumentError.checkNotNull(value, "value");
@@ -1069,6 +1127,13 @@ class _RandomAccessFile implements RandomAccessFile {
     }
   }
 
+  // Tells the OS that the file is going to be read sequentially. This is only
+  // a hint, so failures are ignored.
+  Future<void> _adviseSequential() {
+    return _dispatch(_IOService.fileAdviseSequential, [null])
+        .then((_) {}, onError: (_) {});
+  }
+
   bool closed = false;
 
   int get fd => _ops.fd;
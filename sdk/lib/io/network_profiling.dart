@@ -253,13 +253,18 @@ abstract class _SocketProfile {
       case _SocketProfileType.readBytes:
         if (object == null) return;
         stats.readBytes += object as int;
+        stats.readCount++;
         stats.lastReadTime = Timeline.now;
         break;
       case _SocketProfileType.writeBytes:
         if (object == null) return;
         stats.writeBytes += object as int;
+        stats.writeCount++;
         stats.lastWriteTime = Timeline.now;
         break;
+      case _SocketProfileType.blockedWrite:
+        stats.blockedWriteCount++;
+        break;
       default:
         throw ArgumentError('type ${type} does not exist');
     }
@@ -291,7 +296,9 @@ enum _SocketProfileType {
   port,
   socketType,
   readBytes,
-  writeBytes
+  writeBytes,
+  // A write that could not write all data because the send buffer is full.
+  blockedWrite
 }
 
 /// Socket statistic
@@ -304,6 +311,9 @@ class _SocketStatistic {
   String? socketType;
   int readBytes = 0;
   int writeBytes = 0;
+  int readCount = 0;
+  int writeCount = 0;
+  int blockedWriteCount = 0;
   int? lastWriteTime;
   int? lastReadTime;
 
@@ -320,6 +330,9 @@ class _SocketStatistic {
     _setIfNotNull(map, 'socketType', socketType);
     _setIfNotNull(map, 'readBytes', readBytes);
     _setIfNotNull(map, 'writeBytes', writeBytes);
+    _setIfNotNull(map, 'readCount', readCount);
+    _setIfNotNull(map, 'writeCount', writeCount);
+    _setIfNotNull(map, 'blockedWriteCount', blockedWriteCount);
     _setIfNotNull(map, 'lastWriteTime', lastWriteTime);
     _setIfNotNull(map, 'lastReadTime', lastReadTime);
     return map;
@@ -373,6 +373,9 @@ enum _RawSocketOptions {
   IPV6_MULTICAST_IF, // 4
   IPPROTO_TCP, // 5
   IPPROTO_UDP, // 6
+  TCP_CORK, // 7
+  TCP_NOTSENT_LOWAT, // 8
+  SO_BUSY_POLL, // 9
 }
 
 /// The [RawSocketOption] is used as a parameter to [Socket.setRawOption] and
@@ -461,6 +464,36 @@ final class RawSocketOption {
   static int get levelUdp =>
       _getOptionValue(_RawSocketOptions.IPPROTO_UDP.index);
 
+  /// Socket option for `TCP_CORK` at level [levelTcp].
+  ///
+  /// While set, partial frames are not sent, so that several writes can be
+  /// sent as full frames. Clearing the option sends any pending data.
+  ///
+  /// The value is -1 on platforms that do not support the option.
+  @Since("3.0")
+  static int get tcpCork => _getOptionValue(_RawSocketOptions.TCP_CORK.index);
+
+  /// Socket option for `TCP_NOTSENT_LOWAT` at level [levelTcp].
+  ///
+  /// Limits the amount of unsent data buffered by the kernel, which keeps
+  /// the latency of newly written data low.
+  ///
+  /// The value is -1 on platforms that do not support the option.
+  @Since("3.0")
+  static int get tcpNotSentLowWatermark =>
+      _getOptionValue(_RawSocketOptions.TCP_NOTSENT_LOWAT.index);
+
+  /// Socket option for `SO_BUSY_POLL` at level [levelSocket].
+  ///
+  /// The number of microseconds to busy poll the device queue for incoming
+  /// data when there is none. Raising the value usually needs elevated
+  /// privileges.
+  ///
+  /// The value is -1 on platforms that do not support the option.
+  @Since("3.0")
+  static int get socketBusyPoll =>
+      _getOptionValue(_RawSocketOptions.SO_BUSY_POLL.index);
+
   external static int _getOptionValue(int key);
 }
 
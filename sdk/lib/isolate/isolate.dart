@@ -978,6 +978,18 @@ abstract final class TransferableTypedData {
   /// This method must not be called more than once on the same underlying
   /// transferable bytes, even if the calls occur in different isolates.
   ByteBuffer materialize();
+
+  /// Creates a new unmodifiable [ByteBuffer] containing the bytes stored in
+  /// this [TransferableTypedData].
+  ///
+  /// As the bytes can no longer change, the returned buffer and views on it
+  /// may be sent to other isolates without copying the bytes, where
+  /// supported. This allows many isolates to read the same data at once.
+  ///
+  /// Like [materialize], this method must not be called more than once on
+  /// the same underlying transferable bytes.
+  @Since("3.0")
+  ByteBuffer materializeUnmodifiable();
 }
 
 /// Parameter object used by [Isolate.run].
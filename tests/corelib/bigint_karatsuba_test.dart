@@ -0,0 +1,61 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Testing multiplication of large Bigints with and without intrinsics.
+// VMOptions=--intrinsify --no-enable-asserts
+// VMOptions=--intrinsify --enable-asserts
+// VMOptions=--no-intrinsify --enable-asserts
+// VMOptions=--no-intrinsify --no-enable-asserts
+
+import "dart:math";
+
+import "package:expect/expect.dart";
+
+final random = Random(42);
+
+BigInt randomBigInt(int bits) {
+  var result = BigInt.zero;
+  for (var i = 0; i < bits; i += 30) {
+    result = (result << 30) | BigInt.from(random.nextInt(1 << 30));
+  }
+  return result >> (result.bitLength - bits).clamp(0, bits);
+}
+
+// Multiplies by splitting [b] into 32-bit chunks, which keeps every product
+// small enough for schoolbook multiplication.
+BigInt productByChunks(BigInt a, BigInt b) {
+  final mask = (BigInt.one << 32) - BigInt.one;
+  var result = BigInt.zero;
+  var shift = 0;
+  while (b != BigInt.zero) {
+    result += (a * (b & mask)) << shift;
+    b >>= 32;
+    shift += 32;
+  }
+  return result;
+}
+
+void testProduct(BigInt a, BigInt b) {
+  final expected = productByChunks(a, b);
+  Expect.equals(expected, a * b);
+  Expect.equals(expected, b * a);
+  Expect.equals(-expected, -a * b);
+  Expect.equals(-expected, a * -b);
+  Expect.equals(expected, -a * -b);
+}
+
+main() {
+  for (final bits in [2000, 2048, 2049, 4096, 5000, 8191, 16384]) {
+    testProduct(randomBigInt(bits), randomBigInt(bits));
+    testProduct(randomBigInt(bits), randomBigInt(bits ~/ 2 + 100));
+    testProduct(randomBigInt(bits), randomBigInt(2100));
+  }
+  // Factors with many zero digits and all-ones digits.
+  final power = BigInt.one << 4096;
+  final ones = power - BigInt.one;
+  testProduct(power, ones);
+  testProduct(ones, ones);
+  testProduct(power + BigInt.one, power - BigInt.one);
+  Expect.equals(ones * ones, ones.pow(2));
+}
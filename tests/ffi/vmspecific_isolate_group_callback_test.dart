@@ -0,0 +1,86 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for testing IsolateGroupCallback called from native
+// threads.
+//
+// SharedObjects=ffi_test_functions
+
+import 'dart:ffi';
+
+import 'package:expect/expect.dart';
+
+import 'dylib_utils.dart';
+
+final testLibrary = dlopenPlatformSpecific("ffi_test_functions");
+
+typedef SquareNative = Int64 Function(Int64);
+
+typedef CallGroupCallbackFromThreadsNative = Int64 Function(
+    Pointer<NativeFunction<SquareNative>>, Int32, Int32);
+typedef CallGroupCallbackFromThreads = int Function(
+    Pointer<NativeFunction<SquareNative>>, int, int);
+
+final callGroupCallbackFromThreads =
+    testLibrary.lookupFunction<CallGroupCallbackFromThreadsNative,
+        CallGroupCallbackFromThreads>("CallGroupCallbackFromThreads");
+
+int calls = 0;
+
+int squareInIsolate(int x) {
+  // Counts the calls in the isolate running the callback.
+  calls++;
+  return x * x;
+}
+
+const threads = 4;
+const count = 1000;
+
+void testCallsFromThreads() {
+  final callback = IsolateGroupCallback<SquareNative>(squareInIsolate);
+  int expected = 0;
+  for (int i = 0; i < count; i++) {
+    expected += threads * i * i;
+  }
+  Expect.equals(expected,
+      callGroupCallbackFromThreads(callback.nativeFunction, threads, count));
+  // The calls ran in helper isolates, which have their own statics.
+  Expect.equals(0, calls);
+  callback.close();
+}
+
+void testCallFromDart() {
+  final callback = IsolateGroupCallback<SquareNative>(squareInIsolate);
+  final function = callback.nativeFunction.asFunction<int Function(int)>();
+  Expect.equals(49, function(7));
+  // Called from Dart, the callback runs in this isolate.
+  Expect.equals(1, calls);
+  callback.close();
+}
+
+void testUnsupportedCallbacks() {
+  int local(int x) => x;
+  Expect.throwsArgumentError(() => IsolateGroupCallback<SquareNative>(local));
+  Expect.throwsArgumentError(
+      () => IsolateGroupCallback<Double Function(Double)>(squareInIsolate));
+  Expect.throwsArgumentError(
+      () => IsolateGroupCallback<Int64 Function(Int64, Int64)>(
+          squareInIsolate));
+}
+
+void testClose() {
+  final callback = IsolateGroupCallback<SquareNative>(squareInIsolate);
+  Expect.notEquals(0, callback.nativeFunction.address);
+  callback.close();
+  Expect.throwsStateError(() => callback.nativeFunction);
+  // Closing twice is allowed.
+  callback.close();
+}
+
+void main() {
+  testUnsupportedCallbacks();
+  testClose();
+  testCallsFromThreads();
+  testCallFromDart();
+}
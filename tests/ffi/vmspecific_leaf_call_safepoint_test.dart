@@ -0,0 +1,66 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for long running leaf calls which return early when a
+// safepoint is requested, using Dart_IsSafepointRequested.
+//
+// SharedObjects=ffi_test_functions
+
+import 'dart:ffi';
+import 'dart:isolate';
+
+import 'package:expect/expect.dart';
+import 'package:ffi/ffi.dart';
+
+import 'dylib_utils.dart';
+
+final testLibrary = dlopenPlatformSpecific("ffi_test_functions");
+
+final initializeApi = testLibrary.lookupFunction<IntPtr Function(Pointer<Void>),
+    int Function(Pointer<Void>)>("InitDartApiDL");
+
+final sumUntilSafepoint = testLibrary.lookupFunction<
+    IntPtr Function(Pointer<Int64>, IntPtr, IntPtr, Pointer<Int64>),
+    int Function(Pointer<Int64>, int, int, Pointer<Int64>)>(
+  "SumUntilSafepoint",
+  isLeaf: true,
+);
+
+const length = 1 << 24;
+
+void allocate(_) {
+  // Triggers garbage collections, which need a safepoint of the whole group.
+  for (int i = 0; i < 100; i++) {
+    List<int>.filled(1 << 16, i);
+  }
+}
+
+void main() async {
+  Expect.isTrue(NativeApi.minorVersion >= 4);
+  Expect.equals(0, initializeApi(NativeApi.initializeApiDLData));
+
+  final values = calloc<Int64>(length);
+  final sum = calloc<Int64>();
+  for (int i = 0; i < length; i++) {
+    values[i] = i;
+  }
+
+  final exit = ReceivePort();
+  await Isolate.spawn(allocate, null, onExit: exit.sendPort);
+  for (int round = 0; round < 4; round++) {
+    sum.value = 0;
+    int calls = 0;
+    int next = 0;
+    while (next < length) {
+      next = sumUntilSafepoint(values, next, length, sum);
+      calls++;
+    }
+    Expect.equals(length * (length - 1) ~/ 2, sum.value);
+    Expect.isTrue(calls >= 1);
+  }
+  await exit.first;
+
+  calloc.free(values);
+  calloc.free(sum);
+}
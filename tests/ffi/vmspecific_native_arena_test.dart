@@ -0,0 +1,77 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for testing NativeArena.
+
+import 'dart:ffi';
+
+import 'package:expect/expect.dart';
+
+void testAllocate() {
+  final arena = NativeArena();
+  final pointers = <Pointer<Uint8>>[];
+  for (final size in [0, 1, 15, 16, 17, 100, 2048, 2049, 100000]) {
+    final pointer = arena.allocate<Uint8>(size);
+    Expect.equals(0, pointer.address % 16);
+    for (int i = 0; i < size; i++) {
+      pointer[i] = size + i;
+    }
+    pointers.add(pointer);
+  }
+  Expect.equals(pointers.length, pointers.toSet().length);
+  for (final pointer in pointers) {
+    arena.free(pointer);
+  }
+  arena.releaseAll();
+}
+
+void testReuse() {
+  final arena = NativeArena();
+  final first = arena<Int64>(4);
+  arena.free(first);
+  final second = arena<Int64>(3);
+  // Both round up to the same size class.
+  Expect.equals(first, second);
+  arena.free(second);
+  arena.releaseAll();
+}
+
+void testReleaseAll() {
+  final arena = NativeArena();
+  for (int i = 0; i < 10000; i++) {
+    arena<Int32>(i % 100 + 1).value = i;
+  }
+  arena.releaseAll();
+  // The arena can be used again.
+  final pointer = arena<Int32>();
+  pointer.value = 42;
+  Expect.equals(42, pointer.value);
+  arena.releaseAll();
+}
+
+void testAlignment() {
+  final arena = NativeArena();
+  Expect.equals(0, arena.allocate<Double>(8, alignment: 8).address % 8);
+  Expect.equals(0, arena.allocate<Double>(8, alignment: 16).address % 16);
+  Expect.throwsArgumentError(() => arena.allocate<Double>(8, alignment: 32));
+  Expect.throwsRangeError(() => arena.allocate<Uint8>(-1));
+  arena.releaseAll();
+}
+
+void testUnreachableArenas() {
+  // Arenas which are not released are reclaimed by the garbage collector.
+  for (int i = 0; i < 1000; i++) {
+    NativeArena().allocate<Uint8>(1 << 20);
+  }
+}
+
+void main() {
+  for (int i = 0; i < 10; i++) {
+    testAllocate();
+    testReuse();
+    testReleaseAll();
+    testAlignment();
+  }
+  testUnreachableArenas();
+}
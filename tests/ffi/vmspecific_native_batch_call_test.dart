@@ -0,0 +1,95 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for callNativeBatch.
+//
+// SharedObjects=ffi_test_functions
+
+import 'dart:ffi';
+
+import 'package:expect/expect.dart';
+import 'package:ffi/ffi.dart';
+
+import 'dylib_utils.dart';
+
+final testLibrary = dlopenPlatformSpecific("ffi_test_functions");
+
+typedef TakeMaxUint8Native = IntPtr Function(Uint8);
+typedef SumSmallNumbersNative = Int64 Function(
+    Int8, Int16, Int32, Uint8, Uint16, Uint32);
+
+void testArgumentTruncation() {
+  final function = testLibrary.lookup<NativeFunction<TakeMaxUint8Native>>(
+      "TakeMaxUint8");
+  final arguments = calloc<IntPtr>(3);
+  final results = calloc<IntPtr>(3);
+  arguments[0] = 0xff;
+  arguments[1] = 0xfe;
+  // Only the low 8 bits are passed.
+  arguments[2] = 0xabcdff;
+  callNativeBatch(function, arguments, results, 3);
+  Expect.equals(1, results[0]);
+  Expect.equals(0, results[1]);
+  Expect.equals(1, results[2]);
+  calloc.free(arguments);
+  calloc.free(results);
+}
+
+void testResultExtension() {
+  final function = testLibrary
+      .lookup<NativeFunction<Int8 Function()>>("ReturnMinInt8v2");
+  final results = calloc<IntPtr>(2);
+  callNativeBatch(function, nullptr, results, 2);
+  Expect.equals(-0x80, results[0]);
+  Expect.equals(-0x80, results[1]);
+  calloc.free(results);
+}
+
+void testManyArguments() {
+  if (sizeOf<IntPtr>() != 8) {
+    Expect.throwsArgumentError(() => callNativeBatch(
+        testLibrary.lookup<NativeFunction<SumSmallNumbersNative>>(
+            "SumSmallNumbers"),
+        nullptr,
+        nullptr,
+        0));
+    return;
+  }
+  final function = testLibrary
+      .lookup<NativeFunction<SumSmallNumbersNative>>("SumSmallNumbers");
+  const count = 100;
+  final arguments = calloc<IntPtr>(count * 6);
+  final results = calloc<IntPtr>(count);
+  for (int i = 0; i < count; i++) {
+    for (int j = 0; j < 6; j++) {
+      arguments[i * 6 + j] = i;
+    }
+  }
+  callNativeBatch(function, arguments, results, count);
+  for (int i = 0; i < count; i++) {
+    Expect.equals(6 * i, results[i]);
+  }
+  calloc.free(arguments);
+  calloc.free(results);
+}
+
+void testUnsupportedSignatures() {
+  Expect.throwsArgumentError(() => callNativeBatch(
+      Pointer<NativeFunction<Double Function()>>.fromAddress(1),
+      nullptr,
+      nullptr,
+      0));
+  Expect.throwsArgumentError(() => callNativeBatch(
+      Pointer<NativeFunction<Void Function(Float)>>.fromAddress(1),
+      nullptr,
+      nullptr,
+      0));
+}
+
+void main() {
+  testArgumentTruncation();
+  testResultExtension();
+  testManyArguments();
+  testUnsupportedSignatures();
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for testing NativeCallbackListener called from native
+// threads.
+//
+// SharedObjects=ffi_test_functions
+
+import 'dart:async';
+import 'dart:ffi';
+
+import 'package:expect/expect.dart';
+
+import 'dylib_utils.dart';
+
+final testLibrary = dlopenPlatformSpecific("ffi_test_functions");
+
+typedef ListenerNative = Void Function(Int32, Int32, Pointer<Void>);
+
+typedef CallListenerFromThreadsNative = Void Function(
+    Pointer<NativeFunction<ListenerNative>>, Int32, Int32);
+typedef CallListenerFromThreads = void Function(
+    Pointer<NativeFunction<ListenerNative>>, int, int);
+
+final callListenerFromThreads =
+    testLibrary.lookupFunction<CallListenerFromThreadsNative,
+        CallListenerFromThreads>("CallListenerFromThreads");
+
+const threads = 4;
+const count = 1000;
+
+Future<void> testCallsFromThreads() async {
+  final done = Completer<void>();
+  final next = List<int>.filled(threads, 0);
+  int received = 0;
+  late NativeCallbackListener<ListenerNative> listener;
+  listener = NativeCallbackListener<ListenerNative>(
+      (int thread, int index, Pointer<Void> pointer) {
+    // Calls of one thread arrive in order.
+    Expect.equals(next[thread], index);
+    next[thread]++;
+    Expect.equals(thread + 1, pointer.address);
+    if (++received == threads * count) {
+      listener.close();
+      done.complete();
+    }
+  });
+
+  // Returns once all calls are queued. None of them can have been delivered
+  // yet, since this isolate has not returned to the event loop.
+  callListenerFromThreads(listener.nativeFunction, threads, count);
+  Expect.equals(0, received);
+
+  await done.future;
+  Expect.listEquals(List<int>.filled(threads, count), next);
+}
+
+void testUnsupportedSignatures() {
+  Expect.throwsArgumentError(
+      () => NativeCallbackListener<Int32 Function()>(() => 0));
+  Expect.throwsArgumentError(
+      () => NativeCallbackListener<Void Function(Double)>((double x) {}));
+  Expect.throwsArgumentError(() =>
+      NativeCallbackListener<
+              Void Function(Int8, Int8, Int8, Int8, Int8, Int8, Int8)>(
+          (int a, int b, int c, int d, int e, int f, int g) {}));
+}
+
+void testClose() {
+  final listener = NativeCallbackListener<Void Function()>(() {});
+  Expect.notEquals(0, listener.nativeFunction.address);
+  listener.close();
+  Expect.throwsStateError(() => listener.nativeFunction);
+  // Closing twice is allowed.
+  listener.close();
+}
+
+void main() async {
+  testUnsupportedSignatures();
+  testClose();
+  await testCallsFromThreads();
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for passing typed data to non-leaf calls with
+// withPinnedTypedData.
+//
+// VMOptions=
+// VMOptions=--use-compactor
+// SharedObjects=ffi_test_functions
+
+import 'dart:ffi';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+import 'dylib_utils.dart';
+import 'ffi_test_helpers.dart';
+
+final testLibrary = dlopenPlatformSpecific("ffi_test_functions");
+
+typedef DoubleBytesAfterCallbackNative = Int64 Function(
+    Pointer<Uint8>, IntPtr, Pointer<NativeFunction<Void Function()>>);
+typedef DoubleBytesAfterCallback = int Function(
+    Pointer<Uint8>, int, Pointer<NativeFunction<Void Function()>>);
+
+final doubleBytesAfterCallback = testLibrary.lookupFunction<
+    DoubleBytesAfterCallbackNative,
+    DoubleBytesAfterCallback>("DoubleBytesAfterCallback");
+
+void collectGarbage() {
+  // Allocate so the typed data gets promoted when it is in new space.
+  for (int i = 0; i < 1000; i++) {
+    List<int>.filled(100, i);
+  }
+  triggerGc();
+}
+
+final callback = Pointer.fromFunction<Void Function()>(collectGarbage);
+
+void testBytes(TypedData data, int length) {
+  final bytes = data.buffer.asUint8List(data.offsetInBytes, length);
+  for (int i = 0; i < length; i++) {
+    bytes[i] = i % 100;
+  }
+  int expectedSum = 0;
+  for (int i = 0; i < length; i++) {
+    expectedSum += i % 100;
+  }
+  final sum = withPinnedTypedData(
+      data, (bytes) => doubleBytesAfterCallback(bytes, length, callback));
+  Expect.equals(expectedSum, sum);
+  for (int i = 0; i < length; i++) {
+    Expect.equals((i % 100) * 2, bytes[i]);
+  }
+}
+
+void main() {
+  // Small typed data starts in new space and is copied.
+  testBytes(Uint8List(100), 100);
+  // Large typed data is allocated in old space and pinned.
+  testBytes(Uint8List(1024 * 1024), 1024 * 1024);
+  // Views pin or copy the bytes of the typed data they view.
+  testBytes(Uint8List(1024 * 1024).buffer.asUint8List(16, 1000), 1000);
+  testBytes(ByteData(64), 64);
+
+  // The pointer is released when the action throws.
+  Expect.throws(() => withPinnedTypedData(Uint8List(8), (_) => throw 'error'),
+      (e) => e == 'error');
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Checks that microtasks run in scheduling order while the queue grows,
+// wraps around and is released again.
+
+import 'dart:async';
+import 'package:async_helper/async_helper.dart';
+import 'package:expect/expect.dart';
+
+Future<void> runBatch(int count) {
+  final completer = Completer<void>();
+  final order = <int>[];
+  var scheduled = 0;
+  void schedule() {
+    final id = scheduled++;
+    scheduleMicrotask(() {
+      order.add(id);
+      // Keep the queue partially drained so that it wraps around, and let it
+      // grow on even ids.
+      if (scheduled < count) schedule();
+      if (id.isEven && scheduled < count) schedule();
+      if (order.length == count) completer.complete();
+    });
+  }
+
+  do {
+    schedule();
+  } while (scheduled < count ~/ 3);
+  return completer.future.then((_) {
+    Expect.equals(count, order.length);
+    for (var i = 1; i < order.length; i++) {
+      Expect.isTrue(order[i - 1] < order[i], 'out of order at $i');
+    }
+  });
+}
+
+main() async {
+  asyncStart();
+  for (final count in [1, 15, 16, 17, 100, 5000, 20, 3]) {
+    await runBatch(count);
+  }
+  asyncEnd();
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/expect.dart";
+
+void testMapWholeFile(File file, Uint8List contents) {
+  final raf = file.openSync();
+  final mapped = raf.mapSync();
+  raf.closeSync();
+  // The mapping outlives the file.
+  Expect.listEquals(contents, mapped);
+  Expect.throwsUnsupportedError(() => mapped[0] = 1);
+}
+
+void testMapRange(File file, Uint8List contents) {
+  final raf = file.openSync();
+  // Ranges that are not page aligned.
+  for (final range in [
+    [1, 2],
+    [4095, 4097],
+    [12345, contents.length],
+    [0, contents.length - 1],
+  ]) {
+    final start = range[0];
+    final end = range[1];
+    final mapped = raf.mapSync(start: start, end: end, sequential: true);
+    Expect.listEquals(contents.sublist(start, end), mapped);
+  }
+  Expect.equals(0, raf.mapSync(start: 10, end: 10).length);
+  raf.closeSync();
+}
+
+void testMapInvalidRange(File file, Uint8List contents) {
+  final raf = file.openSync();
+  Expect.throwsRangeError(() => raf.mapSync(start: -1));
+  Expect.throwsRangeError(() => raf.mapSync(end: contents.length + 1));
+  Expect.throwsRangeError(() => raf.mapSync(start: 2, end: 1));
+  raf.closeSync();
+  Expect.throws<FileSystemException>(() => raf.mapSync());
+}
+
+void main() {
+  final temp = Directory.systemTemp.createTempSync('dart_file_map');
+  try {
+    final file = new File("${temp.path}/file");
+    final contents = new Uint8List(3 * 4096 + 12345);
+    for (int i = 0; i < contents.length; i++) {
+      contents[i] = i % 253;
+    }
+    file.writeAsBytesSync(contents);
+
+    testMapWholeFile(file, contents);
+    testMapRange(file, contents);
+    testMapInvalidRange(file, contents);
+  } finally {
+    temp.deleteSync(recursive: true);
+  }
+}
@@ -28,6 +28,31 @@ void testOpenOutputStreamSync() {
   });
 }
 
+void testManySmallWrites() {
+  Directory tempDirectory =
+      Directory.systemTemp.createTempSync('dart_file_output_stream');
+
+  asyncStart();
+  File file = new File("${tempDirectory.path}/test");
+  IOSink x = file.openWrite();
+  var expected = new StringBuffer();
+  // Enough lines to exceed the amount of data buffered between writes.
+  for (int i = 0; i < 20000; i++) {
+    x.writeln("line $i");
+    expected.writeln("line $i");
+  }
+  x.flush().then((_) {
+    Expect.equals(expected.toString(), file.readAsStringSync());
+    x.write("end");
+    return x.close();
+  }).then((_) {
+    Expect.equals("${expected}end", file.readAsStringSync());
+    tempDirectory.deleteSync(recursive: true);
+    asyncEnd();
+  });
+}
+
 main() {
   testOpenOutputStreamSync();
+  testManySmallWrites();
 }
@@ -4,6 +4,7 @@
 
 import "dart:async";
 import "dart:io";
+import "dart:typed_data";
 
 import "package:async_helper/async_helper.dart";
 import "package:expect/expect.dart";
@@ -77,8 +78,36 @@ Future<void> testStreamAppendedToAfterOpen() async {
   asyncEnd();
 }
 
+Future<void> testLargeFileChunks() async {
+  asyncStart();
+  final d = Directory.systemTemp.createTempSync('dart_file_stream');
+  final file = new File("${d.path}/file");
+  final contents = new Uint8List(5 * 1024 * 1024 + 17);
+  for (int i = 0; i < contents.length; i++) {
+    contents[i] = i % 251;
+  }
+  file.writeAsBytesSync(contents);
+
+  // Full blocks make the stream read larger chunks, which must still add up
+  // to the contents of the file.
+  final chunks = await file.openRead().toList();
+  Expect.isTrue(chunks.length < contents.length ~/ (64 * 1024));
+  Expect.listEquals(contents, chunks.expand((chunk) => chunk).toList());
+
+  // A range starting and ending past the block boundaries.
+  final start = 100 * 1024 + 3;
+  final end = contents.length - 5;
+  final range = await file.openRead(start, end).toList();
+  Expect.listEquals(contents.sublist(start, end),
+      range.expand((chunk) => chunk).toList());
+
+  d.deleteSync(recursive: true);
+  asyncEnd();
+}
+
 void main() async {
   testPauseResumeCancelStream();
   testStreamIsEmpty();
   await testStreamAppendedToAfterOpen();
+  await testLargeFileChunks();
 }
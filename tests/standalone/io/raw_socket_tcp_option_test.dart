@@ -0,0 +1,54 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/expect.dart";
+
+int getIntOption(RawSocket socket, int level, int option) {
+  final value = new Uint8List(4);
+  socket.getRawOption(new RawSocketOption(level, option, value));
+  return value.buffer.asByteData().getInt32(0, Endian.host);
+}
+
+Future<void> main() async {
+  if (Platform.isLinux || Platform.isAndroid) {
+    Expect.notEquals(-1, RawSocketOption.tcpCork);
+    Expect.notEquals(-1, RawSocketOption.socketBusyPoll);
+  }
+  if (Platform.isLinux || Platform.isAndroid || Platform.isMacOS) {
+    Expect.notEquals(-1, RawSocketOption.tcpNotSentLowWatermark);
+  }
+  if (Platform.isWindows) {
+    Expect.equals(-1, RawSocketOption.tcpCork);
+    Expect.equals(-1, RawSocketOption.socketBusyPoll);
+  }
+
+  final server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((client) => client.close());
+  final socket = await RawSocket.connect(server.address, server.port);
+
+  if (RawSocketOption.tcpCork != -1) {
+    socket.setRawOption(RawSocketOption.fromBool(
+        RawSocketOption.levelTcp, RawSocketOption.tcpCork, true));
+    Expect.equals(
+        1,
+        getIntOption(
+            socket, RawSocketOption.levelTcp, RawSocketOption.tcpCork));
+    socket.setRawOption(RawSocketOption.fromBool(
+        RawSocketOption.levelTcp, RawSocketOption.tcpCork, false));
+  }
+  if (RawSocketOption.tcpNotSentLowWatermark != -1) {
+    socket.setRawOption(RawSocketOption.fromInt(RawSocketOption.levelTcp,
+        RawSocketOption.tcpNotSentLowWatermark, 16384));
+    Expect.equals(
+        16384,
+        getIntOption(socket, RawSocketOption.levelTcp,
+            RawSocketOption.tcpNotSentLowWatermark));
+  }
+
+  await socket.close();
+  await server.close();
+}